@@ -236,6 +236,7 @@ void RenderScene(Renderer& renderer) {
     
     // 渲染当前网格
     if (currentMeshIndex < static_cast<int>(meshes.size())) {
+        meshes[currentMeshIndex]->ApplyVertexLayoutUniforms(uniformMgr);
         meshes[currentMeshIndex]->Draw();
     }
     
@@ -288,6 +288,7 @@ int main() {
         Matrix4 mvp = projMatrix * viewMatrix * cubeModel;
         sceneUniforms->SetMatrix4("uMVP", mvp);
         sceneUniforms->SetColor("uColor", Color(1.0f, 0.5f, 0.3f, 1.0f));
+        cube->ApplyVertexLayoutUniforms(sceneUniforms);
         cube->Draw();
         
         // 绘制球体
@@ -298,6 +299,7 @@ int main() {
         mvp = projMatrix * viewMatrix * sphereModel;
         sceneUniforms->SetMatrix4("uMVP", mvp);
         sceneUniforms->SetColor("uColor", Color(0.3f, 0.7f, 1.0f, 1.0f));
+        sphere->ApplyVertexLayoutUniforms(sceneUniforms);
         sphere->Draw();
         
         // 绘制地面（放在底部）
@@ -307,6 +309,7 @@ int main() {
         mvp = projMatrix * viewMatrix * planeModel;
         sceneUniforms->SetMatrix4("uMVP", mvp);
         sceneUniforms->SetColor("uColor", Color(0.6f, 0.6f, 0.6f, 1.0f));
+        plane->ApplyVertexLayoutUniforms(sceneUniforms);
         plane->Draw();
         
         targetFramebuffer->Unbind();
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file 65_material_bind_benchmark.cpp
+ * @brief 材质绑定开销微基准：字符串查找 vs 预解析句柄
+ *
+ * - 字符串路径：复刻旧版 Material::Bind 的 HasUniform(name) + SetXxx(name) 序列
+ * - 句柄路径：同一组 uniform 预先解析为 UniformHandle 后逐个下发
+ * - Material::Bind：当前实现（句柄表 + 管线状态对象）的整体开销
+ */
+
+#include <render/renderer.h>
+#include <render/material.h>
+#include <render/shader.h>
+#include <render/shader_cache.h>
+#include <render/uniform_manager.h>
+#include <render/logger.h>
+#include <render/types.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Render;
+
+namespace {
+
+constexpr int kIterations = 200000;
+
+struct BenchParams {
+    Color ambient{0.2f, 0.2f, 0.2f, 1.0f};
+    Color diffuse{0.8f, 0.6f, 0.4f, 1.0f};
+    Color specular{1.0f, 1.0f, 1.0f, 1.0f};
+    float shininess = 32.0f;
+    int extraColorSetCount = 2;
+    int extraUVSetCount = 1;
+    std::vector<Color> extraColorSets{Color(1.0f, 0.9f, 0.9f, 1.0f), Color(0.9f, 1.0f, 0.9f, 1.0f)};
+    std::vector<Vector2> extraUVScales{Vector2(1.0f, 1.0f)};
+};
+
+/// 旧版 Material::Bind 中 uniform 部分的等价序列（每个参数一次字符串查找 + 一次设置）
+void BindByName(UniformManager& mgr, const BenchParams& params) {
+    const char* colorNames[] = {"uAmbientColor", "uDiffuseColor", "uSpecularColor",
+                                "material.ambient", "material.diffuse", "material.specular",
+                                "material.emissive", "uColor"};
+    const Color* colorValues[] = {&params.ambient, &params.diffuse, &params.specular,
+                                  &params.ambient, &params.diffuse, &params.specular,
+                                  &params.ambient, &params.diffuse};
+    for (size_t i = 0; i < std::size(colorNames); ++i) {
+        if (mgr.HasUniform(colorNames[i])) {
+            mgr.SetColor(colorNames[i], *colorValues[i]);
+        }
+    }
+
+    const char* floatNames[] = {"uShininess", "material.shininess", "material.opacity",
+                                "material.metallic", "material.roughness"};
+    for (const char* name : floatNames) {
+        if (mgr.HasUniform(name)) {
+            mgr.SetFloat(name, params.shininess);
+        }
+    }
+
+    const char* boolNames[] = {"uUseTexture", "uUseVertexColor", "hasDiffuseMap", "hasNormalMap"};
+    for (const char* name : boolNames) {
+        if (mgr.HasUniform(name)) {
+            mgr.SetBool(name, false);
+        }
+    }
+
+    if (mgr.HasUniform("uExtraColorSetCount")) {
+        mgr.SetInt("uExtraColorSetCount", params.extraColorSetCount);
+    }
+    if (mgr.HasUniform("uExtraUVSetCount")) {
+        mgr.SetInt("uExtraUVSetCount", params.extraUVSetCount);
+    }
+    if (mgr.HasUniform("uExtraColorSets")) {
+        mgr.SetColorArray("uExtraColorSets", params.extraColorSets.data(),
+                          static_cast<uint32_t>(params.extraColorSets.size()));
+    }
+    if (mgr.HasUniform("uExtraUVSetScales")) {
+        mgr.SetVector2Array("uExtraUVSetScales", params.extraUVScales.data(),
+                            static_cast<uint32_t>(params.extraUVScales.size()));
+    }
+}
+
+struct HandleSet {
+    std::vector<std::pair<UniformHandle, const Color*>> colors;
+    std::vector<std::pair<UniformHandle, float>> floats;
+    std::vector<UniformHandle> bools;
+    UniformHandle extraColorSetCount;
+    UniformHandle extraUVSetCount;
+    UniformHandle extraColorSets;
+    UniformHandle extraUVScales;
+};
+
+HandleSet ResolveHandles(const UniformManager& mgr, const BenchParams& params) {
+    HandleSet set;
+    auto addColor = [&](const char* name, const Color& value) {
+        if (UniformHandle handle = mgr.GetHandle(name); handle.IsValid()) {
+            set.colors.emplace_back(handle, &value);
+        }
+    };
+    addColor("uAmbientColor", params.ambient);
+    addColor("uDiffuseColor", params.diffuse);
+    addColor("uSpecularColor", params.specular);
+    addColor("material.ambient", params.ambient);
+    addColor("material.diffuse", params.diffuse);
+    addColor("material.specular", params.specular);
+    addColor("material.emissive", params.ambient);
+    addColor("uColor", params.diffuse);
+
+    for (const char* name : {"uShininess", "material.shininess", "material.opacity",
+                             "material.metallic", "material.roughness"}) {
+        if (UniformHandle handle = mgr.GetHandle(name); handle.IsValid()) {
+            set.floats.emplace_back(handle, params.shininess);
+        }
+    }
+    for (const char* name : {"uUseTexture", "uUseVertexColor", "hasDiffuseMap", "hasNormalMap"}) {
+        if (UniformHandle handle = mgr.GetHandle(name); handle.IsValid()) {
+            set.bools.push_back(handle);
+        }
+    }
+    set.extraColorSetCount = mgr.GetHandle("uExtraColorSetCount");
+    set.extraUVSetCount = mgr.GetHandle("uExtraUVSetCount");
+    set.extraColorSets = mgr.GetHandle("uExtraColorSets");
+    set.extraUVScales = mgr.GetHandle("uExtraUVSetScales");
+    return set;
+}
+
+void BindByHandle(UniformManager& mgr, const HandleSet& set, const BenchParams& params) {
+    for (const auto& entry : set.colors) {
+        mgr.SetColor(entry.first, *entry.second);
+    }
+    for (const auto& entry : set.floats) {
+        mgr.SetFloat(entry.first, entry.second);
+    }
+    for (UniformHandle handle : set.bools) {
+        mgr.SetBool(handle, false);
+    }
+    mgr.SetInt(set.extraColorSetCount, params.extraColorSetCount);
+    mgr.SetInt(set.extraUVSetCount, params.extraUVSetCount);
+    mgr.SetColorArray(set.extraColorSets, params.extraColorSets.data(),
+                      static_cast<uint32_t>(params.extraColorSets.size()));
+    mgr.SetVector2Array(set.extraUVScales, params.extraUVScales.data(),
+                        static_cast<uint32_t>(params.extraUVScales.size()));
+}
+
+double MeasureNsPerIteration(const std::function<void()>& body) {
+    // 预热
+    for (int i = 0; i < kIterations / 10; ++i) {
+        body();
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        body();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kIterations;
+}
+
+} // namespace
+
+int main() {
+    Logger::GetInstance().InfoFormat("[MaterialBindBenchmark] === Material Bind Benchmark ===");
+
+    Renderer* renderer = Renderer::Create();
+    if (!renderer->Initialize("Material Bind Benchmark", 320, 240)) {
+        Logger::GetInstance().ErrorFormat("[MaterialBindBenchmark] Failed to initialize renderer");
+        Renderer::Destroy(renderer);
+        return 1;
+    }
+
+    auto shader = ShaderCache::GetInstance().LoadShader(
+        "bench_phong", "shaders/material_phong.vert", "shaders/material_phong.frag");
+    if (!shader || !shader->IsValid() || !shader->GetUniformManager()) {
+        Logger::GetInstance().ErrorFormat("[MaterialBindBenchmark] Failed to load shader");
+        Renderer::Destroy(renderer);
+        return 1;
+    }
+
+    BenchParams params;
+    UniformManager& mgr = *shader->GetUniformManager();
+    shader->Use();
+
+    const double nameNs = MeasureNsPerIteration([&]() { BindByName(mgr, params); });
+
+    const HandleSet handles = ResolveHandles(mgr, params);
+    const double handleNs = MeasureNsPerIteration([&]() { BindByHandle(mgr, handles, params); });
+
+    auto material = std::make_shared<Material>();
+    material->SetShader(shader);
+    material->SetAmbientColor(params.ambient);
+    material->SetDiffuseColor(params.diffuse);
+    material->SetSpecularColor(params.specular);
+    material->SetShininess(params.shininess);
+    material->SetInt("uExtraColorSetCount", params.extraColorSetCount);
+    material->SetInt("uExtraUVSetCount", params.extraUVSetCount);
+    material->SetColorArray("uExtraColorSets", params.extraColorSets);
+    material->SetVector2Array("uExtraUVSetScales", params.extraUVScales);
+
+    auto renderState = renderer->GetRenderState();
+    const double materialNs = MeasureNsPerIteration([&]() { material->Bind(renderState.get()); });
+
+    Logger::GetInstance().InfoFormat(
+        "[MaterialBindBenchmark] iterations=%d | string lookup=%.1f ns | handles=%.1f ns (%.2fx) | "
+        "Material::Bind=%.1f ns",
+        kIterations, nameNs, handleNs, handleNs > 0.0 ? nameNs / handleNs : 0.0, materialNs);
+
+    Renderer::Destroy(renderer);
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file 66_frustum_cull_benchmark.cpp
+ * @brief 视锥体裁剪微基准：逐个 IntersectsSphere vs 批量 CullSpheres（100 万个包围球）
+ *
+ * - 逐个：对每个球体调用 Frustum::IntersectsSphere
+ * - 批量：SoA 数组一次调用 Frustum::CullSpheres（AVX2 时每次测试 8 个）
+ * - 批量 + 平面缓存：同上，并复用上一帧的剔除平面（场景静止时大多数被剔除对象只需测试 1 个平面）
+ * - AABB：逐个 IntersectsAABB vs 批量 CullAABBs
+ *
+ * 无需窗口或 GL 上下文。
+ */
+
+#include <render/camera.h>
+#include <render/logger.h>
+#include <render/types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace Render;
+
+namespace {
+
+constexpr size_t kObjectCount = 1000000;
+constexpr int kFrames = 20;
+
+double MeasureMsPerFrame(const std::function<void()>& body) {
+    body();  // 预热
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kFrames; ++i) {
+        body();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+}
+
+size_t CountVisible(const std::vector<uint8_t>& visible) {
+    size_t count = 0;
+    for (uint8_t v : visible) {
+        count += v;
+    }
+    return count;
+}
+
+} // namespace
+
+int main() {
+    Logger::GetInstance().InfoFormat("[FrustumCullBenchmark] === Frustum Cull Benchmark (%zu objects) ===",
+                                     kObjectCount);
+
+    Camera camera;
+    camera.SetPerspective(60.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+    camera.SetPosition(Vector3(0.0f, 10.0f, 0.0f));
+    camera.LookAt(Vector3(100.0f, 0.0f, 100.0f));
+    const Frustum& frustum = camera.GetFrustum();
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> rad(0.5f, 5.0f);
+
+    std::vector<float> cx(kObjectCount), cy(kObjectCount), cz(kObjectCount), r(kObjectCount);
+    std::vector<float> minX(kObjectCount), minY(kObjectCount), minZ(kObjectCount);
+    std::vector<float> maxX(kObjectCount), maxY(kObjectCount), maxZ(kObjectCount);
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        cx[i] = pos(rng);
+        cy[i] = pos(rng) * 0.05f;
+        cz[i] = pos(rng);
+        r[i] = rad(rng);
+        minX[i] = cx[i] - r[i];
+        minY[i] = cy[i] - r[i];
+        minZ[i] = cz[i] - r[i];
+        maxX[i] = cx[i] + r[i];
+        maxY[i] = cy[i] + r[i];
+        maxZ[i] = cz[i] + r[i];
+    }
+
+    std::vector<uint8_t> visible(kObjectCount, 0);
+    std::vector<uint8_t> planeCache(kObjectCount, 0);
+
+    const double scalarSphereMs = MeasureMsPerFrame([&]() {
+        for (size_t i = 0; i < kObjectCount; ++i) {
+            visible[i] = frustum.IntersectsSphere(Vector3(cx[i], cy[i], cz[i]), r[i]) ? 1 : 0;
+        }
+    });
+    const size_t scalarVisible = CountVisible(visible);
+
+    const double batchSphereMs = MeasureMsPerFrame([&]() {
+        frustum.CullSpheres(cx.data(), cy.data(), cz.data(), r.data(), kObjectCount, visible.data());
+    });
+    const size_t batchVisible = CountVisible(visible);
+
+    const double cachedSphereMs = MeasureMsPerFrame([&]() {
+        frustum.CullSpheres(cx.data(), cy.data(), cz.data(), r.data(), kObjectCount,
+                            visible.data(), planeCache.data());
+    });
+
+    const double scalarAABBMs = MeasureMsPerFrame([&]() {
+        for (size_t i = 0; i < kObjectCount; ++i) {
+            const AABB aabb(Vector3(minX[i], minY[i], minZ[i]), Vector3(maxX[i], maxY[i], maxZ[i]));
+            visible[i] = frustum.IntersectsAABB(aabb) ? 1 : 0;
+        }
+    });
+
+    std::fill(planeCache.begin(), planeCache.end(), 0);
+    const double batchAABBMs = MeasureMsPerFrame([&]() {
+        frustum.CullAABBs(minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data(),
+                          kObjectCount, visible.data(), planeCache.data());
+    });
+
+    Logger::GetInstance().InfoFormat(
+        "[FrustumCullBenchmark] spheres: scalar=%.2f ms | batch=%.2f ms (%.2fx) | batch+cache=%.2f ms (%.2fx) | visible=%zu/%zu%s",
+        scalarSphereMs, batchSphereMs, batchSphereMs > 0.0 ? scalarSphereMs / batchSphereMs : 0.0,
+        cachedSphereMs, cachedSphereMs > 0.0 ? scalarSphereMs / cachedSphereMs : 0.0,
+        batchVisible, kObjectCount, batchVisible == scalarVisible ? "" : " (MISMATCH)");
+    Logger::GetInstance().InfoFormat(
+        "[FrustumCullBenchmark] AABBs: scalar=%.2f ms | batch+cache=%.2f ms (%.2fx)",
+        scalarAABBMs, batchAABBMs, batchAABBMs > 0.0 ? scalarAABBMs / batchAABBMs : 0.0);
+
+    return 0;
+}
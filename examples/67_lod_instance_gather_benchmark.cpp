@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file 67_lod_instance_gather_benchmark.cpp
+ * @brief LOD 实例收集微基准：逐个 AddInstance vs 并行收集桶（100 万个实例）
+ *
+ * - AddInstance：每个实例复制网格/材质 shared_ptr 和 InstanceData 进入待处理队列，
+ *   再由 ProcessInstanceBatch 按 GroupKey 分组（现有路径）
+ * - 并行收集：每个任务向自己的 InstanceGatherBucket 追加 64 字节紧凑记录，EndGather 无锁合并
+ *
+ * 只测量 CPU 端收集与分组，不上传、不绘制（需要 GL 上下文以构造 LODInstancedRenderer）。
+ */
+
+#include <render/renderer.h>
+#include <render/lod_instanced_renderer.h>
+#include <render/mesh_loader.h>
+#include <render/material.h>
+#include <render/task_scheduler.h>
+#include <render/logger.h>
+#include <render/types.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Render;
+
+namespace {
+
+constexpr size_t kInstanceCount = 1000000;
+constexpr size_t kMeshCount = 4;
+constexpr int kFrames = 10;
+
+double MeasureMsPerFrame(const std::function<void()>& body) {
+    body();  // 预热
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kFrames; ++i) {
+        body();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+}
+
+} // namespace
+
+int main() {
+    Logger::GetInstance().InfoFormat("[InstanceGatherBenchmark] === LOD Instance Gather Benchmark (%zu instances) ===",
+                                     kInstanceCount);
+
+    TaskScheduler::GetInstance().Initialize();
+
+    Renderer* renderer = Renderer::Create();
+    if (!renderer->Initialize("LOD Instance Gather Benchmark", 320, 240)) {
+        Logger::GetInstance().ErrorFormat("[InstanceGatherBenchmark] Failed to initialize renderer");
+        Renderer::Destroy(renderer);
+        return 1;
+    }
+
+    // 4 个网格 × 4 个 LOD 级别 = 16 个组
+    std::vector<Ref<Mesh>> meshes;
+    std::vector<Ref<Material>> materials;
+    for (size_t i = 0; i < kMeshCount; ++i) {
+        meshes.push_back(MeshLoader::CreateCube(1.0f + static_cast<float>(i)));
+        materials.push_back(std::make_shared<Material>());
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> posDist(-500.0f, 500.0f);
+    std::uniform_int_distribution<uint32_t> meshDist(0, kMeshCount - 1);
+    std::uniform_int_distribution<uint32_t> lodDist(0, 3);
+
+    std::vector<Matrix4> worldMatrices(kInstanceCount);
+    std::vector<uint32_t> meshIndices(kInstanceCount);
+    std::vector<LODLevel> lodLevels(kInstanceCount);
+    for (size_t i = 0; i < kInstanceCount; ++i) {
+        Matrix4 matrix = Matrix4::Identity();
+        matrix.block<3, 1>(0, 3) = Vector3(posDist(rng), posDist(rng), posDist(rng));
+        worldMatrices[i] = matrix;
+        meshIndices[i] = meshDist(rng);
+        lodLevels[i] = static_cast<LODLevel>(lodDist(rng));
+    }
+
+    LODInstancedRenderer lodRenderer;
+    lodRenderer.SetMaxInstancesPerFrame(kInstanceCount);
+    lodRenderer.SetEstimatedInstanceCount(kInstanceCount);
+    lodRenderer.SetEstimatedGroupCount(kMeshCount * 4);
+
+    size_t addInstanceGrouped = 0;
+    const double addInstanceMs = MeasureMsPerFrame([&]() {
+        for (size_t i = 0; i < kInstanceCount; ++i) {
+            const uint32_t m = meshIndices[i];
+            lodRenderer.AddInstance(ECS::EntityID{static_cast<uint32_t>(i), 0}, meshes[m], materials[m],
+                                    worldMatrices[i], lodLevels[i]);
+        }
+        lodRenderer.ProcessPendingInstances();
+        addInstanceGrouped = kInstanceCount - lodRenderer.GetPendingInstanceCount();
+        lodRenderer.Clear();
+    });
+
+    const size_t bucketCount = std::max<size_t>(1, TaskScheduler::GetInstance().GetWorkerCount());
+    size_t gathered = 0;
+    const double gatherMs = MeasureMsPerFrame([&]() {
+        // 组索引表：meshIndex * 4 + lodLevel
+        std::vector<uint32_t> groupIndices(kMeshCount * 4);
+        for (size_t m = 0; m < kMeshCount; ++m) {
+            for (int lod = 0; lod < 4; ++lod) {
+                groupIndices[m * 4 + lod] =
+                    lodRenderer.RegisterGatherGroup(meshes[m], materials[m], static_cast<LODLevel>(lod));
+            }
+        }
+
+        lodRenderer.BeginGather(bucketCount);
+        const size_t chunk = (kInstanceCount + bucketCount - 1) / bucketCount;
+        std::vector<std::shared_ptr<TaskHandle>> handles;
+        handles.reserve(bucketCount);
+        for (size_t b = 0; b < bucketCount; ++b) {
+            const size_t begin = b * chunk;
+            const size_t end = std::min(begin + chunk, kInstanceCount);
+            InstanceGatherBucket& bucket = lodRenderer.GetGatherBucket(b);
+            handles.push_back(TaskScheduler::GetInstance().SubmitLambda(
+                [&, begin, end]() {
+                    for (size_t i = begin; i < end; ++i) {
+                        const uint32_t group = groupIndices[meshIndices[i] * 4 + static_cast<uint32_t>(lodLevels[i])];
+                        bucket.Append(group, worldMatrices[i], 0xFFFFFFFFu, static_cast<uint32_t>(i));
+                    }
+                },
+                TaskPriority::High,
+                "GatherBenchmark"
+            ));
+        }
+        TaskScheduler::GetInstance().WaitForAll(handles);
+        gathered = lodRenderer.EndGather();
+        lodRenderer.Clear();
+    });
+
+    Logger::GetInstance().InfoFormat(
+        "[InstanceGatherBenchmark] AddInstance=%.2f ms (%zu grouped) | parallel gather=%.2f ms (%zu instances, %zu buckets, %.2fx) | "
+        "record=%zu bytes vs InstanceData=%zu bytes",
+        addInstanceMs, addInstanceGrouped, gatherMs, gathered, bucketCount,
+        gatherMs > 0.0 ? addInstanceMs / gatherMs : 0.0, sizeof(CompactInstanceData), sizeof(InstanceData));
+
+    Renderer::Destroy(renderer);
+    TaskScheduler::GetInstance().Shutdown();
+    return 0;
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file 68_meshlet_cull_benchmark.cpp
+ * @brief Meshlet 簇级剔除基准：整对象视锥体裁剪 vs 簇级（视锥体 + 法线锥）剔除
+ *
+ * 依次尝试加载 models/ 下的模型（也可通过命令行参数指定模型路径），找不到时使用程序生成的
+ * 高细分建筑网格。把网格在相机周围摆成网格阵列，统计两种方式提交的三角形数以及
+ * MeshletCuller::CullBatch 单线程/多线程耗时。
+ *
+ * 只在 CPU 端构建和剔除，不上传、不绘制，无需窗口或 GL 上下文。
+ */
+
+#include <render/camera.h>
+#include <render/logger.h>
+#include <render/mesh_loader.h>
+#include <render/meshlet.h>
+#include <render/task_scheduler.h>
+#include <render/types.h>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace Render;
+
+namespace {
+
+constexpr int kGridSize = 12;          // 每个网格摆放 kGridSize × kGridSize 个实例
+constexpr float kGridSpacing = 40.0f;
+constexpr int kFrames = 20;
+
+double MeasureMsPerFrame(const std::function<void()>& body) {
+    body();  // 预热
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kFrames; ++i) {
+        body();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+}
+
+/**
+ * @brief 生成高细分建筑网格：每个立面细分为 segments × segments 的四边形网格
+ */
+Ref<Mesh> CreateBuildingMesh(float width, float height, float depth, int segments) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    const Vector3 halfSize(width * 0.5f, height * 0.5f, depth * 0.5f);
+    const Vector3 normals[6] = {
+        Vector3::UnitX(), -Vector3::UnitX(), Vector3::UnitY(),
+        -Vector3::UnitY(), Vector3::UnitZ(), -Vector3::UnitZ()
+    };
+    for (const Vector3& n : normals) {
+        const Vector3 u = std::abs(n.y()) > 0.5f ? Vector3::UnitX() : Vector3::UnitY();
+        const Vector3 v = n.cross(u);
+        const uint32_t base = static_cast<uint32_t>(vertices.size());
+        for (int y = 0; y <= segments; ++y) {
+            for (int x = 0; x <= segments; ++x) {
+                const float s = static_cast<float>(x) / segments * 2.0f - 1.0f;
+                const float t = static_cast<float>(y) / segments * 2.0f - 1.0f;
+                Vertex vertex(Vector3(n + u * s + v * t).cwiseProduct(halfSize) + Vector3(0.0f, halfSize.y(), 0.0f));
+                vertex.normal = n;
+                vertices.push_back(vertex);
+            }
+        }
+        const uint32_t stride = static_cast<uint32_t>(segments + 1);
+        for (int y = 0; y < segments; ++y) {
+            for (int x = 0; x < segments; ++x) {
+                const uint32_t a = base + y * stride + x;
+                indices.insert(indices.end(), {a, a + 1, a + stride + 1, a, a + stride + 1, a + stride});
+            }
+        }
+    }
+    return CreateRef<Mesh>(vertices, indices);
+}
+
+std::vector<Ref<Mesh>> LoadBenchmarkMeshes(int argc, char** argv) {
+    std::vector<std::string> candidates;
+    if (argc > 1) {
+        candidates.push_back(argv[1]);
+    }
+    for (const char* prefix : {"", "../", "../../"}) {
+        candidates.push_back(std::string(prefix) + "models/miku/v4c5.0.pmx");
+        candidates.push_back(std::string(prefix) + "models/miku/v4c5.0short.pmx");
+        candidates.push_back(std::string(prefix) + "models/test.obj");
+    }
+    
+    for (const auto& path : candidates) {
+        if (!std::filesystem::exists(path)) {
+            continue;
+        }
+        auto meshes = MeshLoader::LoadFromFile(path, true, false);
+        if (!meshes.empty()) {
+            Logger::GetInstance().InfoFormat("[MeshletCullBenchmark] Loaded %zu meshes from %s", meshes.size(), path.c_str());
+            return meshes;
+        }
+    }
+    
+    Logger::GetInstance().InfoFormat("[MeshletCullBenchmark] No bundled model found, using procedural building mesh");
+    return {CreateBuildingMesh(12.0f, 30.0f, 12.0f, 96)};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Logger::GetInstance().InfoFormat("[MeshletCullBenchmark] === Meshlet Cull Benchmark ===");
+
+    TaskScheduler::GetInstance().Initialize();
+
+    std::vector<Ref<Mesh>> meshes = LoadBenchmarkMeshes(argc, argv);
+
+    // 构建 meshlet
+    size_t meshletCount = 0;
+    size_t meshTriangles = 0;
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    for (const auto& mesh : meshes) {
+        if (MeshletBuilder::BuildForMesh(mesh)) {
+            meshletCount += mesh->GetMeshlets()->GetMeshletCount();
+            meshTriangles += mesh->GetTriangleCount();
+        }
+    }
+    const double buildMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - buildStart).count();
+    Logger::GetInstance().InfoFormat("[MeshletCullBenchmark] build: %zu meshlets for %zu triangles in %.1f ms",
+                                     meshletCount, meshTriangles, buildMs);
+
+    // 场景：每个网格摆成 kGridSize × kGridSize 阵列，相机位于阵列中心
+    Camera camera;
+    camera.SetPerspective(60.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    camera.SetPosition(Vector3(0.0f, 15.0f, 0.0f));
+    camera.LookAt(Vector3(100.0f, 10.0f, 60.0f));
+    const Frustum& frustum = camera.GetFrustum();
+    const Vector3 cameraPos = camera.GetPosition();
+
+    std::vector<MeshletCuller::Object> objects;
+    std::vector<const Mesh*> objectMeshes;
+    for (const auto& mesh : meshes) {
+        auto meshlets = mesh->GetMeshlets();
+        if (!meshlets) {
+            continue;
+        }
+        for (int z = 0; z < kGridSize; ++z) {
+            for (int x = 0; x < kGridSize; ++x) {
+                MeshletCuller::Object object;
+                object.meshlets = meshlets.get();
+                object.model.block<3, 1>(0, 3) = Vector3((x - kGridSize / 2) * kGridSpacing, 0.0f,
+                                                         (z - kGridSize / 2) * kGridSpacing);
+                objects.push_back(object);
+                objectMeshes.push_back(mesh.get());
+            }
+        }
+    }
+
+    // 基线：整对象包围球裁剪，可见对象提交全部三角形
+    size_t wholeObjectTriangles = 0;
+    const double wholeObjectMs = MeasureMsPerFrame([&]() {
+        wholeObjectTriangles = 0;
+        for (size_t i = 0; i < objects.size(); ++i) {
+            const AABB bounds = objectMeshes[i]->CalculateBounds();
+            const Vector3 center = bounds.GetCenter() + objects[i].model.block<3, 1>(0, 3);
+            if (frustum.IntersectsSphere(center, bounds.GetExtents().norm())) {
+                wholeObjectTriangles += objects[i].meshlets->triangleCount;
+            }
+        }
+    });
+
+    std::vector<uint32_t> indices;
+    std::vector<MeshletCuller::ObjectRange> ranges;
+    MeshletCullStats stats;
+    const double singleThreadMs = MeasureMsPerFrame([&]() {
+        indices.clear();
+        stats.Reset();
+        for (const auto& object : objects) {
+            MeshletCuller::Cull(*object.meshlets, object.model, frustum, cameraPos, indices, &stats);
+        }
+    });
+    const double batchMs = MeasureMsPerFrame([&]() {
+        stats.Reset();
+        MeshletCuller::CullBatch(objects, frustum, cameraPos, indices, ranges, &stats);
+    });
+
+    size_t sceneTriangles = 0;
+    for (const auto& object : objects) {
+        sceneTriangles += object.meshlets->triangleCount;
+    }
+    Logger::GetInstance().InfoFormat(
+        "[MeshletCullBenchmark] objects=%zu | scene triangles=%zu | whole-object cull: %zu triangles (%.2f ms)",
+        objects.size(), sceneTriangles, wholeObjectTriangles, wholeObjectMs);
+    Logger::GetInstance().InfoFormat(
+        "[MeshletCullBenchmark] meshlet cull: %zu triangles (%.1f%% of whole-object) | frustum-culled=%zu backface-culled=%zu of %zu meshlets",
+        stats.trianglesSubmitted,
+        wholeObjectTriangles > 0 ? 100.0 * stats.trianglesSubmitted / wholeObjectTriangles : 0.0,
+        stats.meshletsFrustumCulled, stats.meshletsBackfaceCulled, stats.meshletsTested);
+    Logger::GetInstance().InfoFormat(
+        "[MeshletCullBenchmark] cull time: single-thread=%.2f ms | CullBatch=%.2f ms (%.2fx)",
+        singleThreadMs, batchMs, batchMs > 0.0 ? singleThreadMs / batchMs : 0.0);
+
+    TaskScheduler::GetInstance().Shutdown();
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file 69_mesh_cache_benchmark.cpp
+ * @brief 二进制网格缓存冷启动基准：Assimp 导入 vs 内存映射缓存加载
+ *
+ * 通过命令行参数指定模型路径；未指定时在临时目录生成一个高细分 OBJ 地形网格。
+ * 分别测量：不使用缓存的 Assimp 导入、首次导入并写入缓存（未命中）、缓存命中加载，
+ * 并校验命中结果与 Assimp 导入的顶点/索引数量一致。
+ *
+ * 只在 CPU 端加载（autoUpload = false），不上传、不绘制，无需窗口或 GL 上下文。
+ */
+
+#include <render/file_utils.h>
+#include <render/logger.h>
+#include <render/mesh_cache.h>
+#include <render/mesh_loader.h>
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace Render;
+
+namespace {
+
+constexpr int kRuns = 5;
+constexpr int kTerrainSegments = 512;   // 生成的地形为 kTerrainSegments² 个四边形
+
+double MeasureMs(const std::function<void()>& body) {
+    auto start = std::chrono::high_resolution_clock::now();
+    body();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double MeasureAverageMs(const std::function<void()>& body) {
+    double total = 0.0;
+    for (int i = 0; i < kRuns; ++i) {
+        total += MeasureMs(body);
+    }
+    return total / kRuns;
+}
+
+/**
+ * @brief 生成带法线与 UV 的起伏地形 OBJ 文件
+ */
+bool WriteTerrainObj(const std::string& path, int segments) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    const int stride = segments + 1;
+    for (int z = 0; z <= segments; ++z) {
+        for (int x = 0; x <= segments; ++x) {
+            const float fx = static_cast<float>(x) / segments;
+            const float fz = static_cast<float>(z) / segments;
+            const float height = 4.0f * std::sin(fx * 12.0f) * std::cos(fz * 9.0f);
+            out << "v " << fx * 200.0f << ' ' << height << ' ' << fz * 200.0f << '\n';
+            out << "vt " << fx << ' ' << fz << '\n';
+            const Vector3 normal = Vector3(-std::cos(fx * 12.0f) * 0.24f, 1.0f, std::sin(fz * 9.0f) * 0.18f).normalized();
+            out << "vn " << normal.x() << ' ' << normal.y() << ' ' << normal.z() << '\n';
+        }
+    }
+    for (int z = 0; z < segments; ++z) {
+        for (int x = 0; x < segments; ++x) {
+            const int a = z * stride + x + 1;  // OBJ 索引从 1 开始
+            const int b = a + 1;
+            const int c = a + stride;
+            const int d = c + 1;
+            out << "f " << a << '/' << a << '/' << a << ' ' << c << '/' << c << '/' << c << ' '
+                << b << '/' << b << '/' << b << '\n';
+            out << "f " << b << '/' << b << '/' << b << ' ' << c << '/' << c << '/' << c << ' '
+                << d << '/' << d << '/' << d << '\n';
+        }
+    }
+    return out.good();
+}
+
+double FileSizeMB(const std::string& path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    return ec ? 0.0 : static_cast<double>(size) / (1024.0 * 1024.0);
+}
+
+void CountGeometry(const std::vector<MeshImportResult>& results, size_t& vertices, size_t& indices) {
+    vertices = 0;
+    indices = 0;
+    for (const auto& result : results) {
+        vertices += result.mesh ? result.mesh->GetVertexCount() : 0;
+        indices += result.mesh ? result.mesh->GetIndexCount() : 0;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Logger::GetInstance().InfoFormat("[MeshCacheBenchmark] === Mesh Cache Benchmark ===");
+
+    const std::filesystem::path workDir = std::filesystem::temp_directory_path() / "render_mesh_cache_benchmark";
+    std::filesystem::create_directories(workDir);
+
+    std::string modelPath;
+    if (argc > 1) {
+        modelPath = argv[1];
+    } else {
+        modelPath = (workDir / "terrain.obj").string();
+        if (!WriteTerrainObj(modelPath, kTerrainSegments)) {
+            Logger::GetInstance().ErrorFormat("[MeshCacheBenchmark] Failed to write %s", modelPath.c_str());
+            return 1;
+        }
+    }
+    Logger::GetInstance().InfoFormat("[MeshCacheBenchmark] Model: %s (%.1f MB)", modelPath.c_str(),
+                                     FileSizeMB(modelPath));
+
+    auto& cache = MeshCache::GetInstance();
+    cache.SetCacheDirectory((workDir / "cache").string());
+    cache.ClearDiskCache();
+    cache.ResetStats();
+
+    MeshImportOptions options;
+    options.autoUpload = false;
+
+    // 基线：每次都走 Assimp 导入与后处理
+    std::vector<MeshImportResult> imported;
+    const double importMs = MeasureAverageMs([&]() {
+        imported = MeshLoader::LoadDetailedFromFile(modelPath, options);
+    });
+    if (imported.empty()) {
+        Logger::GetInstance().ErrorFormat("[MeshCacheBenchmark] Failed to import %s", modelPath.c_str());
+        return 1;
+    }
+
+    // 首次加载：未命中，导入后写入缓存
+    options.useBinaryCache = true;
+    const double missMs = MeasureMs([&]() {
+        MeshLoader::LoadDetailedFromFile(modelPath, options);
+    });
+
+    // 冷启动：缓存命中（包含源文件哈希与内存映射读取）
+    std::vector<MeshImportResult> cached;
+    const double hitMs = MeasureAverageMs([&]() {
+        cached = MeshLoader::LoadDetailedFromFile(modelPath, options);
+    });
+
+    size_t importedVertices = 0, importedIndices = 0;
+    size_t cachedVertices = 0, cachedIndices = 0;
+    CountGeometry(imported, importedVertices, importedIndices);
+    CountGeometry(cached, cachedVertices, cachedIndices);
+    const bool consistent = imported.size() == cached.size() &&
+                            importedVertices == cachedVertices && importedIndices == cachedIndices;
+
+    const MeshCache::Stats stats = cache.GetStats();
+    const std::string cachePath = cache.GetCachePath(
+        MeshCache::BuildKey(FileUtils::HashFile(modelPath), options));
+
+    Logger::GetInstance().InfoFormat("[MeshCacheBenchmark] meshes: %zu, vertices: %zu, triangles: %zu",
+                                     imported.size(), importedVertices, importedIndices / 3);
+    Logger::GetInstance().InfoFormat("[MeshCacheBenchmark] Assimp import:      %8.2f ms", importMs);
+    Logger::GetInstance().InfoFormat("[MeshCacheBenchmark] import + store:     %8.2f ms", missMs);
+    Logger::GetInstance().InfoFormat("[MeshCacheBenchmark] cache hit (mmap):   %8.2f ms (%.1fx faster, %.1f MB file)",
+                                     hitMs, hitMs > 0.0 ? importMs / hitMs : 0.0,
+                                     FileSizeMB(cachePath));
+    Logger::GetInstance().InfoFormat("[MeshCacheBenchmark] cache stats: %zu hits, %zu misses, %zu writes; results %s",
+                                     stats.hits, stats.misses, stats.writes,
+                                     consistent ? "match" : "MISMATCH");
+
+    cache.ClearDiskCache();
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file 70_texture_compression_benchmark.cpp
+ * @brief 纹理块压缩基准：CPU 编码耗时、质量（PSNR）、体积与压缩缓存加载
+ *
+ * 通过命令行参数指定图像路径（经 TextureLoader 解码为 RGBA8）；未指定时生成 1024x1024 的
+ * 程序化纹理（平滑渐变 + 噪声 + 半透明区域）。对每种块压缩格式测量：
+ * - 生成完整 mip 链并编码的耗时
+ * - 基础级别解码回 RGBA8 后的 PSNR
+ * - 含 mip 链的数据大小相对 RGBA8 + mip 链（即 glGenerateMipmap 路径的显存占用）的比例
+ * 最后测量 TextureCache 命中加载耗时。
+ *
+ * 只在 CPU 端编码/解码，不上传，无需窗口或 GL 上下文。
+ */
+
+#include <render/logger.h>
+#include <render/texture_cache.h>
+#include <render/texture_compression.h>
+#include <render/texture_loader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace Render;
+
+namespace {
+
+constexpr int kRuns = 3;
+constexpr int kProceduralSize = 1024;
+
+double MeasureMs(const std::function<void()>& body) {
+    auto start = std::chrono::high_resolution_clock::now();
+    body();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double MeasureAverageMs(const std::function<void()>& body) {
+    double total = 0.0;
+    for (int i = 0; i < kRuns; ++i) {
+        total += MeasureMs(body);
+    }
+    return total / kRuns;
+}
+
+/**
+ * @brief 生成程序化 RGBA8 纹理（左半不透明，右半 Alpha 渐变）
+ */
+std::vector<uint8_t> MakeProceduralImage(int size) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(size) * size * 4);
+    uint32_t noise = 0x12345678u;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            noise = noise * 1664525u + 1013904223u;
+            const float u = static_cast<float>(x) / size;
+            const float v = static_cast<float>(y) / size;
+            const float wave = 0.5f + 0.5f * std::sin(u * 20.0f) * std::cos(v * 14.0f);
+            const int jitter = static_cast<int>((noise >> 24) & 15) - 8;
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * size + x) * 4];
+            p[0] = static_cast<uint8_t>(std::clamp(static_cast<int>(220.0f * wave) + jitter, 0, 255));
+            p[1] = static_cast<uint8_t>(std::clamp(static_cast<int>(180.0f * v + 40.0f * wave) + jitter, 0, 255));
+            p[2] = static_cast<uint8_t>(std::clamp(static_cast<int>(255.0f * (1.0f - u)) + jitter, 0, 255));
+            p[3] = x < size / 2 ? 255 : static_cast<uint8_t>(255.0f * v);
+        }
+    }
+    return rgba;
+}
+
+double ComputePSNR(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int channelCount) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        for (int c = 0; c < channelCount; ++c) {
+            const double diff = static_cast<double>(a[i + c]) - b[i + c];
+            sum += diff * diff;
+            count++;
+        }
+    }
+    const double mse = sum / static_cast<double>(count);
+    return mse <= 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+struct FormatCase {
+    TextureFormat format;
+    const char* name;
+    int channelCount;   ///< 参与 PSNR 计算的通道数
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Logger::GetInstance().InfoFormat("[TextureCompressionBenchmark] === Texture Compression Benchmark ===");
+
+    std::vector<uint8_t> image;
+    int width = 0;
+    int height = 0;
+    if (argc > 1) {
+        TextureLoader::TextureStagingData staging;
+        std::string error;
+        if (!TextureLoader::GetInstance().DecodeTextureToStaging(argv[1], false, &staging, &error)) {
+            Logger::GetInstance().ErrorFormat("[TextureCompressionBenchmark] Failed to decode %s: %s",
+                                              argv[1], error.c_str());
+            return 1;
+        }
+        image = std::move(staging.pixels);
+        width = staging.width;
+        height = staging.height;
+    } else {
+        width = height = kProceduralSize;
+        image = MakeProceduralImage(kProceduralSize);
+    }
+    Logger::GetInstance().InfoFormat("[TextureCompressionBenchmark] Image: %dx%d, opaque: %s",
+                                     width, height,
+                                     TextureCompressor::IsOpaque(image.data(), width, height) ? "yes" : "no");
+
+    // 基线：RGBA8 + 完整 mip 链（与 glGenerateMipmap 路径的显存占用一致）
+    std::vector<uint8_t> mipPixels;
+    std::vector<TextureMipLevel> mipLevels;
+    const double mipMs = MeasureAverageMs([&]() {
+        TextureCompressor::GenerateMipChain(image.data(), width, height, mipPixels, mipLevels);
+    });
+    const double rgbaMB = static_cast<double>(mipPixels.size()) / (1024.0 * 1024.0);
+    Logger::GetInstance().InfoFormat("[TextureCompressionBenchmark] RGBA8 + mips: %zu levels, %.2f MB, mip generation %.2f ms",
+                                     mipLevels.size(), rgbaMB, mipMs);
+
+    const FormatCase cases[] = {
+        {TextureFormat::BC1, "BC1", 3},
+        {TextureFormat::BC3, "BC3", 4},
+        {TextureFormat::BC4, "BC4", 1},
+        {TextureFormat::BC5, "BC5", 2},
+        {TextureFormat::BC7, "BC7", 4},
+    };
+
+    std::vector<uint8_t> decoded(image.size());
+    for (const auto& formatCase : cases) {
+        std::vector<uint8_t> data;
+        std::vector<TextureMipLevel> levels;
+        const double encodeMs = MeasureAverageMs([&]() {
+            TextureCompressor::Compress(image.data(), width, height, formatCase.format, true, data, levels);
+        });
+        TextureCompressor::DecodeLevel(formatCase.format, data.data(), width, height, decoded.data());
+        const double psnr = ComputePSNR(image, decoded, formatCase.channelCount);
+        const double sizeMB = static_cast<double>(data.size()) / (1024.0 * 1024.0);
+        const double megapixels = static_cast<double>(width) * height / 1.0e6;
+
+        Logger::GetInstance().InfoFormat(
+            "[TextureCompressionBenchmark] %s: encode %8.2f ms (%.1f MP/s), PSNR %5.2f dB, %.2f MB (%.1f%% of RGBA8)",
+            formatCase.name, encodeMs, encodeMs > 0.0 ? megapixels / (encodeMs / 1000.0) : 0.0,
+            psnr, sizeMB, rgbaMB > 0.0 ? 100.0 * sizeMB / rgbaMB : 0.0);
+    }
+
+    // 缓存命中：内存映射读取预编码数据，替代解码 + mip 生成 + 编码
+    auto& cache = TextureCache::GetInstance();
+    const std::filesystem::path workDir = std::filesystem::temp_directory_path() / "render_texture_compression_benchmark";
+    cache.SetCacheDirectory(workDir.string());
+    cache.ClearDiskCache();
+
+    std::vector<uint8_t> data;
+    std::vector<TextureMipLevel> levels;
+    TextureCompressor::Compress(image.data(), width, height, TextureFormat::BC7, true, data, levels);
+    const uint64_t key = 0x70u;
+    if (!cache.Store(key, TextureFormat::BC7, data, levels)) {
+        Logger::GetInstance().ErrorFormat("[TextureCompressionBenchmark] Failed to store cache file");
+        return 1;
+    }
+    TextureFormat cachedFormat = TextureFormat::RGBA;
+    std::vector<uint8_t> cachedData;
+    std::vector<TextureMipLevel> cachedLevels;
+    const double hitMs = MeasureAverageMs([&]() {
+        cache.Load(key, cachedFormat, cachedData, cachedLevels);
+    });
+    const bool consistent = cachedData == data && cachedLevels.size() == levels.size();
+    Logger::GetInstance().InfoFormat("[TextureCompressionBenchmark] BC7 cache hit (mmap): %.2f ms; results %s",
+                                     hitMs, consistent ? "match" : "MISMATCH");
+
+    cache.ClearDiskCache();
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file 71_mesh_import_benchmark.cpp
+ * @brief 多网格模型导入基准：串行 vs TaskScheduler 并行的逐网格后处理
+ *
+ * 通过命令行参数指定模型路径；未指定时依次尝试仓库自带的 MMD 模型（models/miku），
+ * 都不存在时在临时目录生成一个包含多个对象的 OBJ 场景。
+ * - 导入：MeshLoader::LoadDetailedFromFile（不使用二进制缓存、不上传、不加载材质），
+ *   先在 TaskScheduler 未初始化时测量（逐网格串行），再初始化后测量（逐网格并行）
+ * - 切线内核：原逐顶点 Eigen 实现 vs MeshKernels::ComputeTangents（AVX2 批量）
+ *
+ * 无需窗口或 GL 上下文。
+ */
+
+#include <render/logger.h>
+#include <render/mesh_kernels.h>
+#include <render/mesh_loader.h>
+#include <render/task_scheduler.h>
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace Render;
+
+namespace {
+
+constexpr int kRuns = 5;
+constexpr int kObjectCount = 48;       // 生成场景中的对象数
+constexpr int kObjectSegments = 96;    // 每个对象为 kObjectSegments² 个四边形
+
+double MeasureMs(const std::function<void()>& body) {
+    auto start = std::chrono::high_resolution_clock::now();
+    body();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double MeasureAverageMs(const std::function<void()>& body) {
+    body();  // 预热（文件缓存）
+    double total = 0.0;
+    for (int i = 0; i < kRuns; ++i) {
+        total += MeasureMs(body);
+    }
+    return total / kRuns;
+}
+
+/**
+ * @brief 生成包含多个起伏地块对象的 OBJ 场景（每个对象导入为一个网格）
+ */
+bool WriteMultiObjectObj(const std::string& path, int objectCount, int segments) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    const int stride = segments + 1;
+    int vertexBase = 1;  // OBJ 索引从 1 开始
+    for (int object = 0; object < objectCount; ++object) {
+        out << "o tile_" << object << '\n';
+        const float offsetX = static_cast<float>(object % 8) * 60.0f;
+        const float offsetZ = static_cast<float>(object / 8) * 60.0f;
+        for (int z = 0; z <= segments; ++z) {
+            for (int x = 0; x <= segments; ++x) {
+                const float fx = static_cast<float>(x) / segments;
+                const float fz = static_cast<float>(z) / segments;
+                const float height = 3.0f * std::sin(fx * 9.0f + object) * std::cos(fz * 7.0f);
+                out << "v " << offsetX + fx * 50.0f << ' ' << height << ' ' << offsetZ + fz * 50.0f << '\n';
+                out << "vt " << fx << ' ' << fz << '\n';
+            }
+        }
+        for (int z = 0; z < segments; ++z) {
+            for (int x = 0; x < segments; ++x) {
+                const int a = vertexBase + z * stride + x;
+                const int b = a + 1;
+                const int c = a + stride;
+                const int d = c + 1;
+                out << "f " << a << '/' << a << ' ' << c << '/' << c << ' ' << b << '/' << b << '\n';
+                out << "f " << b << '/' << b << ' ' << c << '/' << c << ' ' << d << '/' << d << '\n';
+            }
+        }
+        vertexBase += stride * stride;
+    }
+    return out.good();
+}
+
+/// 原 Mesh::RecalculateTangents 的逐顶点实现（对照组）
+void ScalarTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    const float EPSILON = 1e-6f;
+    for (auto& vertex : vertices) {
+        vertex.tangent = Vector3::Zero();
+        vertex.bitangent = Vector3::Zero();
+    }
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const uint32_t i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+        Vector3 edge1 = vertices[i1].position - vertices[i0].position;
+        Vector3 edge2 = vertices[i2].position - vertices[i0].position;
+        Vector2 deltaUV1 = vertices[i1].texCoord - vertices[i0].texCoord;
+        Vector2 deltaUV2 = vertices[i2].texCoord - vertices[i0].texCoord;
+        float determinant = deltaUV1.x() * deltaUV2.y() - deltaUV2.x() * deltaUV1.y();
+        if (std::abs(determinant) < EPSILON) {
+            continue;
+        }
+        float r = 1.0f / determinant;
+        Vector3 tangent = (edge1 * deltaUV2.y() - edge2 * deltaUV1.y()) * r;
+        Vector3 bitangent = (edge2 * deltaUV1.x() - edge1 * deltaUV2.x()) * r;
+        for (uint32_t index : {i0, i1, i2}) {
+            vertices[index].tangent += tangent;
+            vertices[index].bitangent += bitangent;
+        }
+    }
+    for (auto& vertex : vertices) {
+        Vector3 normal = vertex.normal.squaredNorm() < EPSILON ? Vector3::UnitY() : vertex.normal.normalized();
+        Vector3 tangent = vertex.tangent.squaredNorm() < EPSILON ? Vector3::UnitX() : vertex.tangent;
+        tangent = tangent - normal * normal.dot(tangent);
+        float length = tangent.norm();
+        tangent = length < EPSILON ? Vector3::UnitX() : Vector3(tangent / length);
+        float handedness = 1.0f;
+        if (vertex.bitangent.squaredNorm() >= EPSILON) {
+            handedness = (normal.cross(tangent).dot(vertex.bitangent) < 0.0f) ? -1.0f : 1.0f;
+        }
+        vertex.normal = normal;
+        vertex.tangent = tangent;
+        vertex.bitangent = normal.cross(tangent) * handedness;
+    }
+}
+
+void CountGeometry(const std::vector<MeshImportResult>& results, size_t& vertices, size_t& indices) {
+    vertices = 0;
+    indices = 0;
+    for (const auto& result : results) {
+        vertices += result.mesh ? result.mesh->GetVertexCount() : 0;
+        indices += result.mesh ? result.mesh->GetIndexCount() : 0;
+    }
+}
+
+bool RunImportBenchmark(const std::string& modelPath) {
+    MeshImportOptions options;
+    options.autoUpload = false;
+    options.useBinaryCache = false;
+    options.loadMaterials = false;
+    
+    auto& scheduler = TaskScheduler::GetInstance();
+    scheduler.Shutdown();
+    
+    std::vector<MeshImportResult> serial;
+    const double serialMs = MeasureAverageMs([&]() {
+        serial = MeshLoader::LoadDetailedFromFile(modelPath, options);
+    });
+    if (serial.empty()) {
+        Logger::GetInstance().ErrorFormat("[MeshImportBenchmark] Failed to import %s", modelPath.c_str());
+        return false;
+    }
+    
+    scheduler.Initialize();
+    std::vector<MeshImportResult> parallel;
+    const double parallelMs = MeasureAverageMs([&]() {
+        parallel = MeshLoader::LoadDetailedFromFile(modelPath, options);
+    });
+    
+    size_t serialVertices = 0, serialIndices = 0;
+    size_t parallelVertices = 0, parallelIndices = 0;
+    CountGeometry(serial, serialVertices, serialIndices);
+    CountGeometry(parallel, parallelVertices, parallelIndices);
+    bool consistent = serial.size() == parallel.size() &&
+                      serialVertices == parallelVertices && serialIndices == parallelIndices;
+    for (size_t i = 0; consistent && i < serial.size(); ++i) {
+        consistent = serial[i].name == parallel[i].name;
+    }
+    
+    Logger::GetInstance().InfoFormat("[MeshImportBenchmark] %s", modelPath.c_str());
+    Logger::GetInstance().InfoFormat("[MeshImportBenchmark]   meshes: %zu, vertices: %zu, triangles: %zu",
+                                     serial.size(), serialVertices, serialIndices / 3);
+    Logger::GetInstance().InfoFormat("[MeshImportBenchmark]   serial:   %8.2f ms", serialMs);
+    Logger::GetInstance().InfoFormat("[MeshImportBenchmark]   parallel: %8.2f ms (%zu workers, %.2fx); results %s",
+                                     parallelMs, scheduler.GetWorkerCount(),
+                                     parallelMs > 0.0 ? serialMs / parallelMs : 0.0,
+                                     consistent ? "match" : "MISMATCH");
+    return consistent;
+}
+
+void RunTangentBenchmark() {
+    constexpr int size = 512;
+    std::vector<Vertex> vertices(static_cast<size_t>(size) * size);
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            Vertex& vertex = vertices[static_cast<size_t>(z) * size + x];
+            vertex.position = Vector3(static_cast<float>(x), std::sin(x * 0.1f) * std::cos(z * 0.07f), static_cast<float>(z));
+            vertex.texCoord = Vector2(x / float(size - 1), z / float(size - 1));
+            vertex.normal = Vector3::UnitY();
+        }
+    }
+    std::vector<uint32_t> indices;
+    indices.reserve(static_cast<size_t>(size - 1) * (size - 1) * 6);
+    for (int z = 0; z + 1 < size; ++z) {
+        for (int x = 0; x + 1 < size; ++x) {
+            const uint32_t i = static_cast<uint32_t>(z * size + x);
+            indices.insert(indices.end(), {i, i + size, i + 1, i + 1, i + size, i + size + 1});
+        }
+    }
+    
+    std::vector<Vertex> scalar = vertices;
+    const double scalarMs = MeasureAverageMs([&]() { ScalarTangents(scalar, indices); });
+    std::vector<Vertex> kernel = vertices;
+    const double kernelMs = MeasureAverageMs([&]() {
+        MeshKernels::ComputeTangents(kernel.data(), kernel.size(), indices.data(), indices.size());
+    });
+    
+    float maxError = 0.0f;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        maxError = std::max(maxError, (scalar[i].tangent - kernel[i].tangent).cwiseAbs().maxCoeff());
+    }
+    Logger::GetInstance().InfoFormat("[MeshImportBenchmark] tangents (%zu vertices, %zu triangles):",
+                                     vertices.size(), indices.size() / 3);
+    Logger::GetInstance().InfoFormat("[MeshImportBenchmark]   scalar (Eigen AoS): %8.2f ms", scalarMs);
+    Logger::GetInstance().InfoFormat("[MeshImportBenchmark]   MeshKernels:        %8.2f ms (%.2fx, max diff %.2e)",
+                                     kernelMs, kernelMs > 0.0 ? scalarMs / kernelMs : 0.0, maxError);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Logger::GetInstance().InfoFormat("[MeshImportBenchmark] === Mesh Import Benchmark ===");
+    
+    std::vector<std::string> modelPaths;
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            modelPaths.emplace_back(argv[i]);
+        }
+    } else {
+        for (const char* bundled : {"models/miku/v4c5.0.pmx", "models/miku/v4c5.0short.pmx"}) {
+            if (std::filesystem::exists(bundled)) {
+                modelPaths.emplace_back(bundled);
+            }
+        }
+    }
+    if (modelPaths.empty()) {
+        const std::filesystem::path workDir = std::filesystem::temp_directory_path() / "render_mesh_import_benchmark";
+        std::filesystem::create_directories(workDir);
+        const std::string generated = (workDir / "tiles.obj").string();
+        if (!WriteMultiObjectObj(generated, kObjectCount, kObjectSegments)) {
+            Logger::GetInstance().ErrorFormat("[MeshImportBenchmark] Failed to write %s", generated.c_str());
+            return 1;
+        }
+        modelPaths.push_back(generated);
+    }
+    
+    bool ok = true;
+    for (const auto& path : modelPaths) {
+        ok = RunImportBenchmark(path) && ok;
+    }
+    RunTangentBenchmark();
+    
+    TaskScheduler::GetInstance().Shutdown();
+    return ok ? 0 : 1;
+}
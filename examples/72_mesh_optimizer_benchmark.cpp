@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file 72_mesh_optimizer_benchmark.cpp
+ * @brief 网格优化基准：报告 MeshOptimizer 前后的 ACMR / ATVR / overfetch
+ *
+ * - 生成几何体：MeshLoader::Create*，分别关闭 / 开启 SetOptimizeGeneratedMeshes
+ * - 导入模型：命令行参数指定路径；未指定时依次尝试仓库自带的 MMD 模型（models/miku），
+ *   都不存在时在临时目录生成三角形顺序被打乱的 OBJ。对比三种配置：不做缓存优化、
+ *   仅 Assimp aiProcess_ImproveCacheLocality、MeshOptimizer
+ * - LOD：LODGenerator 简化结果，分别关闭 / 开启 SimplifyOptions::optimizeMesh
+ *
+ * ACMR 以 16 项 FIFO 顶点缓存统计（越低越好，理想 ~0.5）；ATVR、overfetch 理想值为 1。
+ * 生成几何体会上传到 GPU，因此需要创建一个小窗口以获得 GL 上下文。
+ */
+
+#include <render/logger.h>
+#include <render/lod_generator.h>
+#include <render/mesh_loader.h>
+#include <render/mesh_optimizer.h>
+#include <render/renderer.h>
+#include <render/task_scheduler.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Render;
+
+namespace {
+
+constexpr int kObjectCount = 16;       // 生成场景中的对象数
+constexpr int kObjectSegments = 64;    // 每个对象为 kObjectSegments² 个四边形
+
+/**
+ * @brief 多个网格的汇总统计（ACMR 按三角形数加权，ATVR / overfetch 按顶点数加权）
+ */
+struct AggregateStats {
+    double transformed = 0.0;
+    double fetched = 0.0;
+    size_t vertices = 0;
+    size_t triangles = 0;
+    
+    void Add(const Mesh& mesh) {
+        const MeshOptimizeStats stats = MeshOptimizer::Analyze(mesh);
+        const size_t vertexCount = mesh.GetVertexCount();
+        const size_t triangleCount = mesh.GetIndexCount() / 3;
+        transformed += static_cast<double>(stats.acmr) * triangleCount;
+        fetched += static_cast<double>(stats.overfetch) * vertexCount;
+        vertices += vertexCount;
+        triangles += triangleCount;
+    }
+    
+    void Merge(const AggregateStats& other) {
+        transformed += other.transformed;
+        fetched += other.fetched;
+        vertices += other.vertices;
+        triangles += other.triangles;
+    }
+    
+    double Acmr() const { return triangles ? transformed / triangles : 0.0; }
+    double Atvr() const { return vertices ? transformed / vertices : 0.0; }
+    double Overfetch() const { return vertices ? fetched / vertices : 0.0; }
+};
+
+void LogStats(const char* label, const AggregateStats& stats) {
+    Logger::GetInstance().InfoFormat("[MeshOptimizerBenchmark]   %-22s ACMR %.3f  ATVR %.3f  overfetch %.3f  (%zu vertices, %zu triangles)",
+                                     label, stats.Acmr(), stats.Atvr(), stats.Overfetch(),
+                                     stats.vertices, stats.triangles);
+}
+
+double MeasureMs(const std::function<void()>& body) {
+    auto start = std::chrono::high_resolution_clock::now();
+    body();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @brief 生成包含多个起伏地块对象的 OBJ 场景，每个对象的三角形顺序被打乱
+ */
+bool WriteShuffledObj(const std::string& path, int objectCount, int segments) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    std::mt19937 rng(42u);
+    const int stride = segments + 1;
+    int vertexBase = 1;  // OBJ 索引从 1 开始
+    for (int object = 0; object < objectCount; ++object) {
+        out << "o tile_" << object << '\n';
+        const float offsetX = static_cast<float>(object % 4) * 60.0f;
+        const float offsetZ = static_cast<float>(object / 4) * 60.0f;
+        for (int z = 0; z <= segments; ++z) {
+            for (int x = 0; x <= segments; ++x) {
+                const float fx = static_cast<float>(x) / segments;
+                const float fz = static_cast<float>(z) / segments;
+                const float height = 3.0f * std::sin(fx * 9.0f + object) * std::cos(fz * 7.0f);
+                out << "v " << offsetX + fx * 50.0f << ' ' << height << ' ' << offsetZ + fz * 50.0f << '\n';
+                out << "vt " << fx << ' ' << fz << '\n';
+            }
+        }
+        std::vector<std::array<int, 3>> faces;
+        for (int z = 0; z < segments; ++z) {
+            for (int x = 0; x < segments; ++x) {
+                const int a = vertexBase + z * stride + x;
+                const int b = a + 1;
+                const int c = a + stride;
+                const int d = c + 1;
+                faces.push_back({a, c, b});
+                faces.push_back({b, c, d});
+            }
+        }
+        std::shuffle(faces.begin(), faces.end(), rng);
+        for (const auto& face : faces) {
+            out << "f " << face[0] << '/' << face[0] << ' ' << face[1] << '/' << face[1] << ' '
+                << face[2] << '/' << face[2] << '\n';
+        }
+        vertexBase += stride * stride;
+    }
+    return out.good();
+}
+
+void RunGeneratedBenchmark() {
+    const std::vector<std::pair<const char*, std::function<Ref<Mesh>()>>> generators = {
+        {"plane 64x64", []() { return MeshLoader::CreatePlane(10.0f, 10.0f, 64, 64); }},
+        {"cube", []() { return MeshLoader::CreateCube(); }},
+        {"sphere 64x32", []() { return MeshLoader::CreateSphere(0.5f, 64, 32); }},
+        {"cylinder 64", []() { return MeshLoader::CreateCylinder(0.5f, 0.5f, 1.0f, 64); }},
+        {"cone 64", []() { return MeshLoader::CreateCone(0.5f, 1.0f, 64); }},
+        {"torus 64x32", []() { return MeshLoader::CreateTorus(1.0f, 0.3f, 64, 32); }},
+        {"capsule 64x16", []() { return MeshLoader::CreateCapsule(0.5f, 1.0f, 64, 16); }},
+    };
+    
+    Logger::GetInstance().InfoFormat("[MeshOptimizerBenchmark] generated meshes:");
+    AggregateStats totalBefore, totalAfter;
+    for (const auto& [name, create] : generators) {
+        MeshLoader::SetOptimizeGeneratedMeshes(false);
+        AggregateStats before;
+        before.Add(*create());
+        MeshLoader::SetOptimizeGeneratedMeshes(true);
+        AggregateStats after;
+        after.Add(*create());
+        
+        Logger::GetInstance().InfoFormat("[MeshOptimizerBenchmark]   %-14s ACMR %.3f -> %.3f  ATVR %.3f -> %.3f",
+                                         name, before.Acmr(), after.Acmr(), before.Atvr(), after.Atvr());
+        totalBefore.Merge(before);
+        totalAfter.Merge(after);
+    }
+    LogStats("all (before)", totalBefore);
+    LogStats("all (MeshOptimizer)", totalAfter);
+}
+
+bool RunImportBenchmark(const std::string& modelPath) {
+    struct Config {
+        const char* label;
+        bool improveCacheLocality;
+        bool runMeshOptimizer;
+    };
+    const Config configs[] = {
+        {"no reordering", false, false},
+        {"Assimp cache locality", true, false},
+        {"MeshOptimizer", false, true},
+    };
+    
+    Logger::GetInstance().InfoFormat("[MeshOptimizerBenchmark] %s", modelPath.c_str());
+    for (const Config& config : configs) {
+        MeshImportOptions options;
+        options.autoUpload = false;
+        options.useBinaryCache = false;
+        options.loadMaterials = false;
+        options.improveCacheLocality = config.improveCacheLocality;
+        options.runMeshOptimizer = config.runMeshOptimizer;
+        
+        std::vector<MeshImportResult> results;
+        const double loadMs = MeasureMs([&]() {
+            results = MeshLoader::LoadDetailedFromFile(modelPath, options);
+        });
+        if (results.empty()) {
+            Logger::GetInstance().ErrorFormat("[MeshOptimizerBenchmark] Failed to import %s", modelPath.c_str());
+            return false;
+        }
+        
+        AggregateStats stats;
+        for (const auto& result : results) {
+            if (result.mesh) {
+                stats.Add(*result.mesh);
+            }
+        }
+        LogStats(config.label, stats);
+        Logger::GetInstance().InfoFormat("[MeshOptimizerBenchmark]   %-22s import %.2f ms (%zu meshes)",
+                                         "", loadMs, results.size());
+    }
+    return true;
+}
+
+void RunLODBenchmark() {
+    MeshLoader::SetOptimizeGeneratedMeshes(true);
+    Ref<Mesh> source = MeshLoader::CreateSphere(0.5f, 128, 64);
+    
+    Logger::GetInstance().InfoFormat("[MeshOptimizerBenchmark] LOD (sphere 128x64):");
+    for (int level = 1; level <= 3; ++level) {
+        LODGenerator::SimplifyOptions options;
+        options.uploadToGPU = false;
+        
+        options.optimizeMesh = false;
+        AggregateStats before;
+        if (Ref<Mesh> lod = LODGenerator::GenerateLODLevel(source, level, options)) {
+            before.Add(*lod);
+        }
+        options.optimizeMesh = true;
+        AggregateStats after;
+        if (Ref<Mesh> lod = LODGenerator::GenerateLODLevel(source, level, options)) {
+            after.Add(*lod);
+        }
+        Logger::GetInstance().InfoFormat("[MeshOptimizerBenchmark]   LOD%d %6zu tris  ACMR %.3f -> %.3f  ATVR %.3f -> %.3f",
+                                         level, after.triangles, before.Acmr(), after.Acmr(),
+                                         before.Atvr(), after.Atvr());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Logger::GetInstance().InfoFormat("[MeshOptimizerBenchmark] === Mesh Optimizer Benchmark ===");
+    
+    TaskScheduler::GetInstance().Initialize();
+    
+    Renderer* renderer = Renderer::Create();
+    if (!renderer->Initialize("Mesh Optimizer Benchmark", 320, 240)) {
+        Logger::GetInstance().ErrorFormat("[MeshOptimizerBenchmark] Failed to initialize renderer");
+        Renderer::Destroy(renderer);
+        return 1;
+    }
+    
+    std::vector<std::string> modelPaths;
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            modelPaths.emplace_back(argv[i]);
+        }
+    } else {
+        for (const char* bundled : {"models/miku/v4c5.0.pmx", "models/miku/v4c5.0short.pmx"}) {
+            if (std::filesystem::exists(bundled)) {
+                modelPaths.emplace_back(bundled);
+            }
+        }
+    }
+    if (modelPaths.empty()) {
+        const std::filesystem::path workDir = std::filesystem::temp_directory_path() / "render_mesh_optimizer_benchmark";
+        std::filesystem::create_directories(workDir);
+        const std::string generated = (workDir / "shuffled_tiles.obj").string();
+        if (!WriteShuffledObj(generated, kObjectCount, kObjectSegments)) {
+            Logger::GetInstance().ErrorFormat("[MeshOptimizerBenchmark] Failed to write %s", generated.c_str());
+        } else {
+            modelPaths.push_back(generated);
+        }
+    }
+    
+    RunGeneratedBenchmark();
+    
+    bool ok = true;
+    for (const auto& path : modelPaths) {
+        ok = RunImportBenchmark(path) && ok;
+    }
+    
+    RunLODBenchmark();
+    
+    Renderer::Destroy(renderer);
+    TaskScheduler::GetInstance().Shutdown();
+    return ok ? 0 : 1;
+}
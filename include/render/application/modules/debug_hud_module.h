@@ -77,6 +77,21 @@ public:
      * @brief 获取是否显示Uniform/材质状态
      */
     bool GetShowUniformMaterialInfo() const { return m_showUniformMaterialInfo; }
+    
+    /**
+     * @brief 设置是否显示帧分析器（耗时最高的作用域）
+     */
+    void SetShowProfilerInfo(bool show) { m_showProfilerInfo = show; }
+    
+    /**
+     * @brief 获取是否显示帧分析器
+     */
+    bool GetShowProfilerInfo() const { return m_showProfilerInfo; }
+    
+    /**
+     * @brief 设置帧分析器面板显示的作用域数量
+     */
+    void SetProfilerTopN(size_t count) { m_profilerTopN = count; }
 
 private:
     void DrawHUD(const FrameUpdateArgs& frame, AppContext& ctx);
@@ -85,6 +100,7 @@ private:
     void DestroyTextObjects();
     void UpdateLayerInfoText(const FrameUpdateArgs& frame, AppContext& ctx);
     void UpdateUniformMaterialInfoText(const FrameUpdateArgs& frame, AppContext& ctx);
+    void UpdateProfilerInfoText(const FrameUpdateArgs& frame, AppContext& ctx);
     
     // 辅助函数：创建和更新右对齐文本对象
     void CreateRightAlignedTextObjects(
@@ -100,7 +116,8 @@ private:
         const std::vector<std::string>& lines,
         std::vector<TextPtr>& textObjects,
         std::vector<std::unique_ptr<TextRenderable>>& textRenderables,
-        AppContext& ctx);
+        AppContext& ctx,
+        float topMargin = 20.0f);
 
     bool m_registered = false;
     float m_accumulatedTime = 0.0f;
@@ -112,6 +129,8 @@ private:
     // 调试功能开关
     bool m_showLayerInfo = false;              // 是否显示渲染层级信息
     bool m_showUniformMaterialInfo = false;    // 是否显示Uniform/材质状态
+    bool m_showProfilerInfo = false;           // 是否显示帧分析器
+    size_t m_profilerTopN = 8;                 // 帧分析器显示的作用域数量
     
     // 文本对象
     FontPtr m_font;
@@ -126,6 +145,10 @@ private:
     std::vector<TextPtr> m_uniformMaterialTextObjects;
     std::vector<std::unique_ptr<TextRenderable>> m_uniformMaterialTextRenderables;
     
+    // 帧分析器文本对象（动态创建）
+    std::vector<TextPtr> m_profilerTextObjects;
+    std::vector<std::unique_ptr<TextRenderable>> m_profilerTextRenderables;
+    
     // 统计信息缓存
     struct StatsCache {
         float fps = 0.0f;
@@ -138,12 +161,18 @@ private:
         uint32_t batchedDrawCalls = 0;
         uint32_t instancedDrawCalls = 0;
         uint32_t instancedInstances = 0;
+        uint32_t visibleMeshes = 0;
+        uint32_t culledMeshes = 0;
+        uint32_t occludedMeshes = 0;
+        uint32_t occluders = 0;
         size_t textureCount = 0;
         size_t meshCount = 0;
         size_t materialCount = 0;
         size_t shaderCount = 0;
         size_t textureMemory = 0;
         size_t meshMemory = 0;
+        size_t meshCPUMemory = 0;
+        size_t meshGPUMemory = 0;
         size_t totalMemory = 0;
     } m_statsCache;
     
@@ -26,7 +26,9 @@
 #include "render/material.h"
 #include "render/model_loader.h"
 #include "render/texture_loader.h"
+#include "render/texture_upload_queue.h"
 #include "render/task_scheduler.h"
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <functional>
@@ -35,11 +37,13 @@
 #include <atomic>
 #include <vector>
 #include <chrono>
+#include <unordered_map>
 
 namespace Render {
 
 // 前向声明
 class Shader;
+struct LODSimplifyOptions;
 
 /**
  * @brief 异步资源类型
@@ -48,7 +52,8 @@ enum class AsyncResourceType {
     Mesh,       // 网格
     Texture,    // 纹理
     Material,   // 材质
-    Model       // 模型（包含多个网格和材质）
+    Model,      // 模型（包含多个网格和材质）
+    LOD         // LOD 网格生成（简化或从磁盘缓存读取）
 };
 
 /**
@@ -102,6 +107,26 @@ struct ModelLoadResult : LoadResult<Model> {
     std::vector<std::string> materialResourceNames;
 };
 
+/**
+ * @brief LOD 生成结果
+ * 
+ * resource 为源网格（LOD0）
+ */
+struct LODGenerateResult : LoadResult<Mesh> {
+    std::vector<Ref<Mesh>> lodMeshes;        ///< [LOD0, LOD1, LOD2, LOD3]，失败的级别为 nullptr
+    std::vector<float> geometricErrors;      ///< 对应几何误差（LOD0 为 0，失败为 -1）
+    bool fromCache = false;                  ///< 是否命中磁盘缓存
+};
+
+/**
+ * @brief 加载请求标识
+ * 
+ * 每次 Load*Async 调用对应一个请求；合并的重复请求共享任务，但各自持有自己的标识，
+ * 用于 LoadTaskBase::CancelRequest 只撤销自己的请求
+ */
+using LoadRequestId = uint64_t;
+constexpr LoadRequestId kInvalidLoadRequest = 0;
+
 /**
  * @brief 加载任务基类
  */
@@ -114,6 +139,11 @@ struct LoadTaskBase {
     float priority = 0.0f;                      // 优先级（越高越优先）
     std::atomic<bool> cancelled{false};         // 是否已取消
     std::chrono::steady_clock::time_point submitTime; // 提交时间（用于相同优先级排序）
+    std::string requestKey;                     // 进行中请求表的键（空表示未登记，例如 LOD 任务）
+    LoadRequestId requestId = NewRequestId();   // 创建本任务的请求
+    std::mutex requestMutex;                    // 保护 requestIds/cancelledRequestIds
+    std::vector<LoadRequestId> requestIds{requestId};  // 附着到本任务的请求（含合并的重复请求）
+    std::vector<LoadRequestId> cancelledRequestIds;    // 已撤销的请求（其回调不再调用）
     
     // 重试相关
     size_t retryCount = 0;                      // 当前重试次数
@@ -125,15 +155,62 @@ struct LoadTaskBase {
     virtual void ExecuteUpload() = 0;            // 主线程：GPU上传
     
     /**
-     * @brief 取消任务
+     * @brief 主线程：ExecuteUpload 之后轮询分帧上传是否结束
+     * @return 上传已结束（成功或失败）时返回 true；返回 false 的任务在之后的帧继续轮询
      */
-    void Cancel() {
-        cancelled = true;
-        status = LoadStatus::Failed;
-        errorType = LoadErrorType::Cancelled;
-        if (errorMessage.empty()) {
-            errorMessage = "Task cancelled by user";
+    virtual bool PollUpload() { return true; }
+    
+    /**
+     * @brief 附着一个合并的重复请求
+     * @param id 重复请求的标识
+     * @return 任务已取消时返回 false（调用者应提交新任务）
+     */
+    bool AttachRequest(LoadRequestId id) {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        if (cancelled.load()) {
+            return false;
+        }
+        requestIds.push_back(id);
+        return true;
+    }
+    
+    /**
+     * @brief 撤销单个请求
+     * 
+     * 该请求的回调不再调用；附着的请求全部撤销后才取消加载，其余请求照常完成。
+     * 同一请求重复撤销只生效一次
+     * @param id Load*Async 通过 outRequestId 返回的请求标识
+     * @return 请求属于本任务且此前未撤销时返回 true
+     */
+    bool CancelRequest(LoadRequestId id) {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        if (std::find(requestIds.begin(), requestIds.end(), id) == requestIds.end() ||
+            std::find(cancelledRequestIds.begin(), cancelledRequestIds.end(), id) != cancelledRequestIds.end()) {
+            return false;
         }
+        cancelledRequestIds.push_back(id);
+        if (cancelledRequestIds.size() == requestIds.size()) {
+            MarkCancelled();
+        }
+        return true;
+    }
+    
+    /**
+     * @brief 检查请求是否已撤销
+     */
+    bool IsRequestCancelled(LoadRequestId id) {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        return std::find(cancelledRequestIds.begin(), cancelledRequestIds.end(), id) != cancelledRequestIds.end();
+    }
+    
+    /**
+     * @brief 取消整个任务（包括所有合并的请求，不调用任何回调）
+     * 
+     * 只撤销自己的请求时使用 CancelRequest
+     */
+    void Cancel() {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        MarkCancelled();
     }
     
     /**
@@ -152,6 +229,25 @@ struct LoadTaskBase {
                errorType != LoadErrorType::Cancelled &&
                errorType != LoadErrorType::FileNotFound; // 文件不存在不重试
     }
+
+private:
+    static LoadRequestId NewRequestId() {
+        static std::atomic<LoadRequestId> nextId{1};
+        return nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // 调用方须持有 requestMutex
+    void MarkCancelled() {
+        if (cancelled.load()) {
+            return;
+        }
+        cancelled = true;
+        status = LoadStatus::Failed;
+        errorType = LoadErrorType::Cancelled;
+        if (errorMessage.empty()) {
+            errorMessage = "Task cancelled by user";
+        }
+    }
 };
 
 /**
@@ -165,6 +261,7 @@ struct MeshLoadTask : public LoadTaskBase {
     LoadFunc loadFunc;              // 加载函数（工作线程）
     UploadFunc uploadFunc;          // 上传函数（主线程）
     CallbackFunc callback;          // 完成回调
+    std::vector<std::pair<LoadRequestId, CallbackFunc>> coalescedCallbacks;  // 合并到本任务的重复请求及其回调（AsyncResourceLoader 加锁追加）
     
     Ref<Mesh> result;              // 加载结果
     
@@ -205,15 +302,31 @@ struct MeshLoadTask : public LoadTaskBase {
  */
 struct TextureLoadTask : public LoadTaskBase {
     using LoadFunc = std::function<std::unique_ptr<TextureLoader::TextureStagingData>()>;
-    using UploadFunc = std::function<Ref<Texture>(TextureLoader::TextureStagingData&&)>;
+    /// 返回纹理；ticket 有效时纹理内容由 TextureUploadQueue 分帧写入
+    using UploadFunc = std::function<Ref<Texture>(TextureLoader::TextureStagingData&&, TextureUploadTicket&)>;
+    /// 分帧上传完成后调用（例如加入 TextureLoader 缓存），返回最终纹理
+    using FinishFunc = std::function<Ref<Texture>(Ref<Texture>)>;
     using CallbackFunc = std::function<void(const TextureLoadResult&)>;
     
     LoadFunc loadFunc;
     UploadFunc uploadFunc;
+    FinishFunc finishFunc;
     CallbackFunc callback;
+    std::vector<std::pair<LoadRequestId, CallbackFunc>> coalescedCallbacks;  // 合并到本任务的重复请求及其回调（AsyncResourceLoader 加锁追加）
     
     std::unique_ptr<TextureLoader::TextureStagingData> stagingData;
     Ref<Texture> result;
+    TextureUploadTicket uploadTicket = kInvalidUploadTicket;  ///< 分帧上传票据
+    
+    ~TextureLoadTask() override {
+        // 未上传就被丢弃（取消、清空队列）时归还 PBO 并取消未完成的分帧上传
+        if (stagingData) {
+            TextureUploadQueue::GetInstance().ReleaseStagingBuffer(stagingData->pixelBuffer);
+        }
+        if (uploadTicket != kInvalidUploadTicket) {
+            TextureUploadQueue::GetInstance().Cancel(uploadTicket);
+        }
+    }
     
     void ExecuteLoad() override {
         try {
@@ -255,13 +368,15 @@ struct TextureLoadTask : public LoadTaskBase {
 
             auto data = std::move(*stagingData);
             stagingData.reset();
-            result = uploadFunc(std::move(data));
+            result = uploadFunc(std::move(data), uploadTicket);
             if (!result) {
                 status = LoadStatus::Failed;
                 errorType = LoadErrorType::GPUUploadFailed;
                 if (errorMessage.empty()) {
                     errorMessage = "Upload failed: texture creation returned null";
                 }
+            } else if (uploadTicket == kInvalidUploadTicket && finishFunc) {
+                result = finishFunc(result);
             }
         } catch (const std::exception& e) {
             errorMessage = "Upload failed: " + std::string(e.what());
@@ -269,6 +384,40 @@ struct TextureLoadTask : public LoadTaskBase {
             errorType = LoadErrorType::GPUUploadFailed;
         }
     }
+    
+    bool PollUpload() override {
+        if (uploadTicket == kInvalidUploadTicket) {
+            return true;
+        }
+        
+        auto& queue = TextureUploadQueue::GetInstance();
+        if (IsCancelled()) {
+            queue.Cancel(uploadTicket);
+            uploadTicket = kInvalidUploadTicket;
+            result.reset();
+            return true;
+        }
+        
+        const TextureUploadState state = queue.Poll(uploadTicket);
+        if (state == TextureUploadState::Pending) {
+            return false;
+        }
+        
+        uploadTicket = kInvalidUploadTicket;
+        if (state == TextureUploadState::Completed) {
+            if (finishFunc) {
+                result = finishFunc(result);
+            }
+        } else {
+            result.reset();
+            status = LoadStatus::Failed;
+            errorType = LoadErrorType::GPUUploadFailed;
+            if (errorMessage.empty()) {
+                errorMessage = "Upload failed: sliced texture upload did not complete";
+            }
+        }
+        return true;
+    }
 };
 
 struct ModelLoadTask : public LoadTaskBase {
@@ -279,6 +428,7 @@ struct ModelLoadTask : public LoadTaskBase {
     LoadFunc loadFunc;
     UploadFunc uploadFunc;
     CallbackFunc callback;
+    std::vector<std::pair<LoadRequestId, CallbackFunc>> coalescedCallbacks;  // 合并到本任务的重复请求及其回调（AsyncResourceLoader 加锁追加）
 
     ModelLoadOptions requestedOptions;
     std::string filepath;
@@ -318,6 +468,62 @@ struct ModelLoadTask : public LoadTaskBase {
     }
 };
 
+/**
+ * @brief LOD 生成任务
+ * 
+ * 工作线程：查询 LODCache，未命中时调用 LODGenerator 简化（不上传 GPU）并写回缓存
+ * 主线程：上传生成的网格
+ */
+struct LODGenerateTask : public LoadTaskBase {
+    struct Output {
+        std::vector<Ref<Mesh>> lodMeshes;    ///< [LOD0, LOD1, LOD2, LOD3]
+        std::vector<float> geometricErrors;
+        bool fromCache = false;
+    };
+    
+    using LoadFunc = std::function<Output()>;
+    using CallbackFunc = std::function<void(const LODGenerateResult&)>;
+    
+    LoadFunc loadFunc;
+    CallbackFunc callback;
+    
+    Ref<Mesh> sourceMesh;
+    Output result;
+    
+    void ExecuteLoad() override {
+        try {
+            if (loadFunc) {
+                result = loadFunc();
+                if (result.lodMeshes.empty()) {
+                    status = LoadStatus::Failed;
+                    errorType = LoadErrorType::ParseError;
+                    if (errorMessage.empty()) {
+                        errorMessage = "LOD generation returned no meshes";
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            errorMessage = e.what();
+            status = LoadStatus::Failed;
+            errorType = LoadErrorType::ParseError;
+        }
+    }
+    
+    void ExecuteUpload() override {
+        try {
+            for (const auto& mesh : result.lodMeshes) {
+                if (mesh && !mesh->IsUploaded()) {
+                    mesh->Upload();
+                }
+            }
+        } catch (const std::exception& e) {
+            errorMessage = "Upload failed: " + std::string(e.what());
+            status = LoadStatus::Failed;
+            errorType = LoadErrorType::GPUUploadFailed;
+        }
+    }
+};
+
 /**
  * @brief 异步资源加载器（单例）
  * 
@@ -331,9 +537,20 @@ struct ModelLoadTask : public LoadTaskBase {
  * 1. 主线程提交加载任务（LoadMeshAsync）
  * 2. 工作线程执行文件加载和数据解析
  * 3. 主线程轮询并处理完成的任务（ProcessCompletedTasks）
- * 4. 主线程执行GPU上传
+ * 4. 主线程执行GPU上传（纹理经 TextureUploadQueue 的 PBO 分帧上传，可能跨越多帧）
  * 5. 调用完成回调（如果提供）
  * 
+ * 请求合并（网格/纹理/模型）：
+ * - 请求键 = 资源类型 + 规范化路径（FileUtils::NormalizePath）+ 资源名 + 加载选项
+ * - 同键任务仍在进行中时不再提交新任务：返回已有任务句柄，回调追加到该任务，完成时按提交顺序依次调用
+ * - 资源已在 ResourceManager 中（网格需已上传）时直接返回已完成的任务，不占用工作线程；
+ *   回调仍在下一次 ProcessCompletedTasks 中调用，保证回调总在主线程执行
+ * - 合并的请求共享同一任务，但各有自己的请求标识（outRequestId）：CancelRequest(id) 只撤销该请求
+ *   并丢弃其回调，所有请求都撤销后才取消加载，之后的同键请求会重新提交；Cancel() 取消整个任务；
+ *   优先级以首个请求为准
+ * - 纹理缓存按名称索引：同名纹理的 mip 状态与 generateMipmap 不一致时不复用，
+ *   改用带选项后缀的缓存名（name#mip / name#nomip）单独加载
+ * 
  * 线程安全：
  * - ✅ 所有公共方法都是线程安全的
  * - ✅ 使用任务队列和条件变量同步
@@ -384,13 +601,15 @@ public:
      * @param name 资源名称（用于ResourceManager注册）
      * @param callback 完成回调（可选）
      * @param priority 优先级（默认0，越高越优先）
-     * @return 任务句柄（可用于查询状态）
+     * @param outRequestId 输出本次请求的标识（可选），用于 CancelRequest 只撤销本次请求
+     * @return 任务句柄（可用于查询状态；同一请求进行中时返回已有任务）
      */
     std::shared_ptr<MeshLoadTask> LoadMeshAsync(
         const std::string& filepath,
         const std::string& name = "",
         std::function<void(const MeshLoadResult&)> callback = nullptr,
-        float priority = 0.0f
+        float priority = 0.0f,
+        LoadRequestId* outRequestId = nullptr
     );
     
     /**
@@ -400,22 +619,66 @@ public:
      * @param generateMipmap 是否生成mipmap
      * @param callback 完成回调（可选）
      * @param priority 优先级
-     * @return 任务句柄
+     * @param outRequestId 输出本次请求的标识（可选），用于 CancelRequest 只撤销本次请求
+     * @return 任务句柄（同一请求进行中时返回已有任务）
+     * 
+     * ResourceManager 或 TextureLoader 缓存中已有同名且 mip 状态一致的纹理时直接返回已完成任务
      */
     std::shared_ptr<TextureLoadTask> LoadTextureAsync(
         const std::string& filepath,
         const std::string& name = "",
         bool generateMipmap = true,
         std::function<void(const TextureLoadResult&)> callback = nullptr,
-        float priority = 0.0f
+        float priority = 0.0f,
+        LoadRequestId* outRequestId = nullptr
     );
 
+    /**
+     * @brief 异步加载模型
+     * @param filepath 文件路径
+     * @param name 模型资源名
+     * @param options 加载选项（参与请求键）
+     * @param callback 完成回调（可选）
+     * @param priority 优先级
+     * @param outRequestId 输出本次请求的标识（可选），用于 CancelRequest 只撤销本次请求
+     * @return 任务句柄（同一请求进行中时返回已有任务）
+     * 
+     * 同一请求此前已完成并注册（options.registerModel）、且模型仍在 ResourceManager 中时直接返回已完成任务，
+     * 结果中的网格/材质资源名沿用首次加载的记录
+     */
     std::shared_ptr<ModelLoadTask> LoadModelAsync(
         const std::string& filepath,
         const std::string& name = "",
         const ModelLoadOptions& options = {},
         std::function<void(const ModelLoadResult&)> callback = nullptr,
-        float priority = 0.0f
+        float priority = 0.0f,
+        LoadRequestId* outRequestId = nullptr
+    );
+    
+    /**
+     * @brief 后台生成 LOD1-LOD3
+     * 
+     * 工作线程先按 (sourceHash, options) 查询 LODCache，命中则直接内存映射读取；
+     * 未命中时执行网格简化并写回缓存。生成的网格在 ProcessCompletedTasks 中上传，
+     * 随后调用 callback。生成完成之前，调用方应继续使用 LOD0 渲染。
+     * 
+     * @param sourceMesh 源网格（LOD0），生成期间不得修改其顶点数据
+     * @param options 简化选项（uploadToGPU 会被强制为 false）
+     * @param sourceHash 源数据哈希；为 0 时在工作线程用 LODCache::HashSource(sourceFilePath, sourceMesh) 计算
+     * @param useDiskCache 是否读写磁盘缓存
+     * @param callback 完成回调（主线程）
+     * @param priority 优先级
+     * @param sourceFilePath 源文件路径（可选），由工作线程哈希并与网格哈希组合作为缓存键，避免在提交线程读取整个文件
+     * @return 任务句柄，源网格为空时返回 nullptr
+     */
+    std::shared_ptr<LODGenerateTask> GenerateLODAsync(
+        Ref<Mesh> sourceMesh,
+        const LODSimplifyOptions& options,
+        uint64_t sourceHash = 0,
+        bool useDiskCache = true,
+        std::function<void(const LODGenerateResult&)> callback = nullptr,
+        float priority = 0.0f,
+        const std::string& sourceFilePath = ""
     );
     
     // ========================================================================
@@ -424,8 +687,11 @@ public:
     
     /**
      * @brief 处理已完成的加载任务（执行GPU上传）
-     * @param maxTasks 本帧最多处理的任务数（默认10，避免帧率下降）
-     * @return 处理的任务数
+     * @param maxTasks 本帧最多开始上传的任务数（默认10，避免帧率下降）
+     * @return 本帧结束（完成或失败）的任务数
+     * 
+     * 每次调用先推进 TextureUploadQueue 一帧（按字节预算发出 PBO 切片），
+     * 分帧上传的纹理任务在 fence 触发后才调用回调。
      * 
      * 注意：必须在主线程（渲染循环）中调用
      */
@@ -453,10 +719,25 @@ public:
     size_t GetLoadingTaskCount() const;
     
     /**
-     * @brief 获取等待上传的任务数
+     * @brief 获取等待上传的任务数（含分帧上传中的纹理任务）
      */
     size_t GetWaitingUploadCount() const;
     
+    /**
+     * @brief 获取合并到进行中任务的重复请求数
+     */
+    size_t GetCoalescedRequestCount() const { return m_coalescedRequests.load(); }
+    
+    /**
+     * @brief 获取直接从 ResourceManager（纹理含 TextureLoader 缓存）返回的请求数
+     */
+    size_t GetResourceHitCount() const { return m_resourceHits.load(); }
+    
+    /**
+     * @brief 获取进行中请求表的条目数
+     */
+    size_t GetInflightRequestCount() const;
+    
     /**
      * @brief 打印加载统计信息
      */
@@ -470,17 +751,72 @@ private:
     AsyncResourceLoader(const AsyncResourceLoader&) = delete;
     AsyncResourceLoader& operator=(const AsyncResourceLoader&) = delete;
     
+    /**
+     * @brief 结束任务：更新状态与统计并调用完成回调
+     */
+    void FinishTask(const std::shared_ptr<LoadTaskBase>& task);
+    
+    /**
+     * @brief 调用任务的完成回调与所有合并请求的回调
+     */
+    void InvokeCallbacks(const std::shared_ptr<LoadTaskBase>& task);
+    
+    /**
+     * @brief 组合请求键：类型 + 规范化路径 + 资源名 + 选项
+     */
+    static std::string BuildRequestKey(AsyncResourceType type,
+                                       const std::string& filepath,
+                                       const std::string& name,
+                                       const std::string& options);
+    
+    /**
+     * @brief 登记进行中任务
+     * 
+     * 同键任务仍在进行中（未取消）时追加回调并返回已有任务，否则登记并返回 task
+     */
+    template<typename TaskT>
+    std::shared_ptr<TaskT> RegisterInflight(const std::shared_ptr<TaskT>& task);
+    
+    /**
+     * @brief 任务结束（完成、失败或取消）后从进行中请求表移除
+     */
+    void ReleaseInflight(const std::shared_ptr<LoadTaskBase>& task);
+    
+    /**
+     * @brief 将直接由已有资源满足的任务放入完成队列（回调在主线程调用）
+     */
+    void EnqueueResolved(const std::shared_ptr<LoadTaskBase>& task);
+    
+    /**
+     * @brief 已注册模型的资源名记录（请求键 → 注册结果），用于从 ResourceManager 直接返回模型
+     */
+    struct ModelRegistration {
+        std::string modelName;
+        std::vector<std::string> meshResourceNames;
+        std::vector<std::string> materialResourceNames;
+    };
+    
     // 已完成任务队列（等待主线程上传）
     std::queue<std::shared_ptr<LoadTaskBase>> m_completedTasks;
     
+    // 正在分帧上传的任务（主线程轮询 PollUpload）
+    std::vector<std::shared_ptr<LoadTaskBase>> m_uploadingTasks;
+    
     // 线程同步（只需保护完成队列）
     mutable std::mutex m_completedMutex;
     
+    // 进行中请求表（请求键 → 任务）与已注册模型记录，同时保护各任务的 coalescedCallbacks
+    std::unordered_map<std::string, std::shared_ptr<LoadTaskBase>> m_inflightTasks;
+    std::unordered_map<std::string, ModelRegistration> m_registeredModels;
+    mutable std::mutex m_inflightMutex;
+    
     // 统计信息
     std::atomic<size_t> m_totalTasks{0};
     std::atomic<size_t> m_completedCount{0};
     std::atomic<size_t> m_failedTasks{0};
     std::atomic<size_t> m_loadingCount{0};
+    std::atomic<size_t> m_coalescedRequests{0};
+    std::atomic<size_t> m_resourceHits{0};
     
     // ✅ 注意：不再维护独立的工作线程池
     // 所有异步任务都通过TaskScheduler提交
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "types.h"
+#include "camera.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief BVH 查询统计（可选输出，用于分析遍历开销）
+ */
+struct BVHQueryStats {
+    size_t nodesVisited = 0;       ///< 访问的节点数
+    size_t primitivesTested = 0;   ///< 逐个测试的图元数（整棵子树被接受时不计）
+};
+
+/**
+ * @brief 包围体层次结构（CPU，AABB 图元）
+ *
+ * - Build() 使用分桶 SAH 构建扁平节点数组，子节点总位于父节点之后，Refit() 逆序遍历即可自底向上更新
+ * - Update() 只修改图元包围盒，需在查询前调用 Refit()；NeedsRebuild() 在树质量退化、
+ *   待插入图元或已删除图元过多时返回 true
+ * - 构建后插入的图元先放入待插入列表（查询时线性测试），下次 Build() 时并入树中
+ * - 视锥体查询携带平面掩码：节点完全位于某平面内侧后子树不再测试该平面，
+ *   完全位于视锥体内的子树直接整体接受，因此开销与可见数量而非场景规模相关
+ *
+ * 查询结果以 Insert() 传入的 userData 追加到输出数组。非线程安全：修改与查询需在同一线程，
+ * 或由调用方同步；多个线程可同时执行 const 查询。
+ */
+class BVH {
+public:
+    static constexpr uint32_t kInvalidProxy = 0xFFFFFFFFu;
+    static constexpr uint32_t kMaxLeafPrimitives = 4;
+
+    /**
+     * @brief 射线窄相回调
+     *
+     * 参数为图元的 userData 与射线进入其包围盒的距离；回调可将距离改为精确命中距离，
+     * 返回 false 表示未命中
+     */
+    using RayNarrowPhase = std::function<bool(uint32_t userData, float& distance)>;
+
+    BVH() = default;
+
+    /**
+     * @brief 插入图元
+     * @return 代理 ID（用于 Update/Remove）
+     */
+    uint32_t Insert(const AABB& bounds, uint32_t userData);
+
+    /**
+     * @brief 更新图元包围盒（树中的图元需 Refit() 后生效）
+     */
+    void Update(uint32_t proxy, const AABB& bounds);
+
+    /**
+     * @brief 删除图元（树中的图元标记删除，下次 Build() 时回收）
+     */
+    void Remove(uint32_t proxy);
+
+    /**
+     * @brief 使用分桶 SAH 重新构建（包含待插入图元，回收已删除图元）
+     */
+    void Build();
+
+    /**
+     * @brief 自底向上更新节点包围盒（仅在有图元更新时执行）
+     */
+    void Refit();
+
+    /**
+     * @brief 是否建议重建（树质量退化、待插入或已删除图元过多）
+     */
+    [[nodiscard]] bool NeedsRebuild() const;
+
+    void Clear();
+
+    [[nodiscard]] bool IsValidProxy(uint32_t proxy) const;
+    [[nodiscard]] const AABB& GetProxyBounds(uint32_t proxy) const { return m_proxies[proxy].bounds; }
+    [[nodiscard]] uint32_t GetProxyUserData(uint32_t proxy) const { return m_proxies[proxy].userData; }
+
+    [[nodiscard]] size_t GetPrimitiveCount() const { return m_liveCount; }
+    [[nodiscard]] size_t GetNodeCount() const { return m_nodes.size(); }
+    [[nodiscard]] size_t GetPendingCount() const { return m_pending.size(); }
+
+    // ========================================================================
+    // 查询（结果追加到 out）
+    // ========================================================================
+
+    /**
+     * @brief 查询与视锥体相交的图元（判定与 Frustum::IntersectsAABB 一致）
+     */
+    void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& out,
+                      BVHQueryStats* stats = nullptr) const;
+
+    /**
+     * @brief 查询与 AABB 重叠的图元
+     */
+    void QueryAABB(const AABB& bounds, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief 查询与球体重叠的图元
+     */
+    void QuerySphere(const Vector3& center, float radius, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief 射线拾取最近图元（按节点距离由近到远遍历）
+     * @param ray 射线（方向需归一化）
+     * @param maxDistance 最大距离
+     * @param outUserData 命中图元的 userData
+     * @param outDistance 命中距离（无窄相时为进入包围盒的距离）
+     * @param narrowPhase 可选的精确相交回调
+     * @return 是否命中
+     */
+    bool Raycast(const Ray& ray, float maxDistance, uint32_t& outUserData, float& outDistance,
+                 const RayNarrowPhase& narrowPhase = nullptr) const;
+
+private:
+    struct Node {
+        AABB bounds;
+        uint32_t first = 0;   ///< 叶子：图元起始下标；内部节点：左子节点（右子节点为 first + 1）
+        uint32_t count = 0;   ///< 叶子图元数，0 表示内部节点
+    };
+
+    struct Proxy {
+        AABB bounds;
+        uint32_t userData = 0;
+        uint32_t pendingSlot = kInvalidProxy;  ///< 在待插入列表中的位置
+        bool alive = false;
+        bool inTree = false;
+    };
+
+    void Subdivide(uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t depth,
+                   const std::vector<Vector3>& centroids);
+    void CollectSubtree(uint32_t nodeIndex, std::vector<uint32_t>& out) const;
+    float ComputeNodeAreaSum() const;
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_primIndices;    ///< 叶子引用的代理 ID
+    std::vector<Proxy> m_proxies;
+    std::vector<uint32_t> m_freeProxies;
+    std::vector<uint32_t> m_deferredFree;   ///< 已删除但仍被叶子引用，Build() 后回收
+    std::vector<uint32_t> m_pending;        ///< 构建后插入、尚未进入树的代理
+
+    size_t m_liveCount = 0;
+    size_t m_treePrimitiveCount = 0;        ///< 最近一次构建时树中的图元数
+    size_t m_removedInTree = 0;
+    float m_builtAreaSum = 0.0f;            ///< 构建时所有节点表面积之和（衡量 Refit 后的退化）
+    float m_currentAreaSum = 0.0f;
+    bool m_needsRefit = false;
+};
+
+/**
+ * @brief 场景级可见性加速结构：静态树 + 动态树
+ *
+ * 以调用方提供的 ID（通常为实体索引）管理对象。首次 Set() 的对象进入静态树（SAH 构建、很少重建）；
+ * 包围盒发生变化的对象迁移到动态树，动态树每次 Commit() 时 Refit，退化后重建。
+ * 对象迁移到动态树后不会回迁。
+ */
+class SceneBVH {
+public:
+    /**
+     * @brief 插入或更新对象包围盒（包围盒未变化时不做任何事）
+     */
+    void Set(uint32_t id, const AABB& bounds);
+
+    void Remove(uint32_t id);
+
+    [[nodiscard]] bool Contains(uint32_t id) const;
+    [[nodiscard]] bool IsDynamic(uint32_t id) const;
+
+    /**
+     * @brief 提交本帧修改：按需重建或 Refit 两棵树（查询前调用）
+     */
+    void Commit();
+
+    void Clear();
+
+    [[nodiscard]] size_t GetStaticCount() const { return m_staticTree.GetPrimitiveCount(); }
+    [[nodiscard]] size_t GetDynamicCount() const { return m_dynamicTree.GetPrimitiveCount(); }
+    [[nodiscard]] const BVH& GetStaticTree() const { return m_staticTree; }
+    [[nodiscard]] const BVH& GetDynamicTree() const { return m_dynamicTree; }
+
+    void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& out,
+                      BVHQueryStats* stats = nullptr) const;
+    void QueryAABB(const AABB& bounds, std::vector<uint32_t>& out) const;
+    void QuerySphere(const Vector3& center, float radius, std::vector<uint32_t>& out) const;
+    bool Raycast(const Ray& ray, float maxDistance, uint32_t& outId, float& outDistance,
+                 const BVH::RayNarrowPhase& narrowPhase = nullptr) const;
+
+private:
+    struct Entry {
+        uint32_t proxy = BVH::kInvalidProxy;
+        bool dynamic = false;
+    };
+
+    std::vector<Entry> m_entries;   ///< 以 ID 为下标
+    BVH m_staticTree;
+    BVH m_dynamicTree;
+};
+
+} // namespace Render
@@ -71,6 +71,42 @@ struct Frustum {
      * @return 如果相交返回 true
      */
     bool IntersectsAABB(const AABB& aabb) const;
+
+    // ========================================================================
+    // 批量裁剪（SoA 布局）
+    // ========================================================================
+
+    /**
+     * @brief 批量检测球体与视锥体是否相交
+     *
+     * 输入为结构体数组拆分后的 SoA 数据，AVX2 可用时每次迭代测试 8 个球体，
+     * 结果与逐个调用 IntersectsSphere 一致。
+     *
+     * @param cx,cy,cz 球心坐标数组
+     * @param r 半径数组
+     * @param count 球体数量
+     * @param outVisible 输出数组，可见为 1，剔除为 0
+     * @param planeCache 可选的平面一致性缓存（每个对象 1 字节，取值 0-5）：
+     *        先测试上一帧剔除该对象的平面，剔除时写回新的剔除平面；
+     *        调用方需在帧间保持同一对象的下标稳定，初始值填 0 即可
+     */
+    void CullSpheres(const float* cx, const float* cy, const float* cz, const float* r,
+                     size_t count, uint8_t* outVisible, uint8_t* planeCache = nullptr) const;
+
+    /**
+     * @brief 批量检测 AABB 与视锥体是否相交
+     *
+     * 与 CullSpheres 相同的 SoA 约定，结果与逐个调用 IntersectsAABB 一致。
+     *
+     * @param minX,minY,minZ 包围盒最小点数组
+     * @param maxX,maxY,maxZ 包围盒最大点数组
+     * @param count 包围盒数量
+     * @param outVisible 输出数组，可见为 1，剔除为 0
+     * @param planeCache 可选的平面一致性缓存，含义同 CullSpheres
+     */
+    void CullAABBs(const float* minX, const float* minY, const float* minZ,
+                   const float* maxX, const float* maxY, const float* maxZ,
+                   size_t count, uint8_t* outVisible, uint8_t* planeCache = nullptr) const;
 };
 
 /**
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief 单个作用域在一帧内的聚合结果
+ *
+ * path 为以 '/' 连接的完整层级路径（例如 "Renderer.Flush/LOD.Cull"），
+ * 同一路径在一帧内的多次调用会合并。
+ */
+struct ProfilerScopeStats {
+    std::string path;
+    const char* name = "";      ///< 作用域名称（字符串字面量）
+    uint32_t depth = 0;         ///< 嵌套深度，0 为顶层
+    uint32_t callCount = 0;
+    double totalMs = 0.0;       ///< 包含子作用域的总耗时
+    double selfMs = 0.0;        ///< 扣除直接子作用域后的耗时
+    double maxMs = 0.0;         ///< 单次调用最大耗时
+};
+
+/**
+ * @brief 一帧的分析结果
+ */
+struct ProfilerFrame {
+    uint64_t frameIndex = 0;
+    double frameMs = 0.0;                       ///< BeginFrame 到 EndFrame 的 CPU 时间
+    std::vector<ProfilerScopeStats> cpuScopes;  ///< 按首次出现顺序（即层级顺序）排列
+    std::vector<ProfilerScopeStats> gpuScopes;  ///< GPU 查询结果（通常延迟 1-3 帧到达）
+    uint32_t droppedEvents = 0;                 ///< 环形缓冲区满时丢弃的事件数
+};
+
+/**
+ * @brief 分层帧分析器
+ *
+ * - CPU：RAII 作用域（PROFILE_SCOPE）写入各线程独占的无锁环形缓冲区（单生产者/单消费者），
+ *   EndFrame 时由主线程统一取出并按层级聚合。
+ * - GPU：PROFILE_GPU_SCOPE 使用 GL 时间戳查询，仅在 SetGpuTimingAvailable(true) 后生效，
+ *   且必须在 GL 线程调用；结果在查询完成的帧回填到对应帧记录。
+ * - 最近若干帧保存在历史中，可通过 DumpToFile 导出为 CSV，便于分析无界面基准测试。
+ *
+ * 作用域名称必须是静态生命周期的字符串（通常为字面量）。
+ */
+class Profiler {
+public:
+    static Profiler& GetInstance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // ------------------------------------------------------------------------
+    // 开关与配置
+    // ------------------------------------------------------------------------
+
+    void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 声明当前是否存在可用的 GL 上下文（由 Renderer 初始化/关闭时设置）
+     */
+    void SetGpuTimingAvailable(bool available);
+    bool IsGpuTimingAvailable() const { return m_gpuAvailable.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 设置保留的历史帧数量（默认 240）
+     */
+    void SetHistorySize(size_t frames);
+
+    // ------------------------------------------------------------------------
+    // 帧边界
+    // ------------------------------------------------------------------------
+
+    void BeginFrame();
+
+    /**
+     * @brief 结束当前帧：取出所有线程的事件并聚合，轮询已完成的 GPU 查询
+     */
+    void EndFrame();
+
+    // ------------------------------------------------------------------------
+    // 事件记录（通常通过宏调用）
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief 进入 CPU 作用域，返回开始时间戳（纳秒），分析器关闭时返回 0
+     */
+    uint64_t BeginCpuScope();
+
+    /**
+     * @brief 结束 CPU 作用域，写入当前线程的环形缓冲区
+     */
+    void EndCpuScope(const char* name, uint64_t beginNs);
+
+    /**
+     * @brief 开始 GPU 作用域，返回查询对索引（不可用时返回 -1）
+     */
+    int32_t BeginGpuScope(const char* name);
+    void EndGpuScope(int32_t scopeIndex);
+
+    /**
+     * @brief 释放 GPU 查询对象（需在 GL 线程、上下文销毁前调用）
+     */
+    void ReleaseGpuResources();
+
+    // ------------------------------------------------------------------------
+    // 查询与导出
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief 最近一次完成的帧（无数据时返回空帧）
+     */
+    ProfilerFrame GetLastFrame() const;
+
+    /**
+     * @brief 最近一帧中按总耗时排序的前 N 个 CPU 作用域
+     */
+    std::vector<ProfilerScopeStats> GetTopScopes(size_t count) const;
+
+    /**
+     * @brief 复制历史帧（从旧到新）
+     */
+    std::vector<ProfilerFrame> GetHistory() const;
+
+    /**
+     * @brief 将历史帧以 CSV 导出
+     *
+     * 列：frame,source,path,depth,calls,total_ms,self_ms,max_ms,frame_ms
+     * @return 写入成功返回 true
+     */
+    bool DumpToFile(const std::string& path) const;
+
+    /**
+     * @brief 清空历史与所有未处理事件
+     */
+    void Reset();
+
+    static uint64_t NowNs();
+
+    /// 每个线程环形缓冲区的容量（事件数）
+    static constexpr size_t kThreadBufferCapacity = 8192;
+
+private:
+    Profiler();
+    ~Profiler();
+
+    struct CpuEvent {
+        const char* name = nullptr;
+        uint64_t beginNs = 0;
+        uint64_t endNs = 0;
+        uint32_t depth = 0;
+    };
+
+    /// 单生产者（所属线程）/ 单消费者（EndFrame）环形缓冲区
+    struct ThreadBuffer {
+        std::array<CpuEvent, kThreadBufferCapacity> events{};
+        std::atomic<uint64_t> head{0};      ///< 生产者写入位置
+        std::atomic<uint64_t> tail{0};      ///< 消费者读取位置
+        std::atomic<uint32_t> dropped{0};
+        uint32_t depth = 0;                 ///< 当前嵌套深度（仅所属线程访问）
+    };
+
+    struct GpuScope {
+        const char* name = nullptr;
+        uint32_t depth = 0;
+        uint32_t beginQuery = 0;
+        uint32_t endQuery = 0;
+    };
+
+    struct GpuFrame {
+        uint64_t frameIndex = 0;
+        std::vector<GpuScope> scopes;
+    };
+
+    ThreadBuffer* GetThreadBuffer();
+    void DrainCpuEvents(std::vector<std::vector<CpuEvent>>& perThread, uint32_t& dropped);
+    void ResolveGpuFrames();
+    uint32_t AcquireQuery();
+    void AttachGpuResults(uint64_t frameIndex, std::vector<ProfilerScopeStats>&& scopes);
+
+    std::atomic<bool> m_enabled{true};
+    std::atomic<bool> m_gpuAvailable{false};
+
+    mutable std::mutex m_threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+
+    mutable std::mutex m_frameMutex;
+    std::deque<ProfilerFrame> m_history;
+    size_t m_historySize = 240;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_frameBeginNs = 0;
+    bool m_inFrame = false;
+
+    // GPU 查询（仅 GL 线程访问）
+    GpuFrame m_currentGpuFrame;
+    std::deque<GpuFrame> m_pendingGpuFrames;
+    std::vector<uint32_t> m_freeQueries;
+    std::vector<uint32_t> m_allQueries;
+    uint32_t m_gpuDepth = 0;
+};
+
+/**
+ * @brief RAII CPU 作用域
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : m_name(name)
+        , m_beginNs(Profiler::GetInstance().BeginCpuScope()) {
+    }
+
+    ~ProfileScope() {
+        if (m_beginNs != 0) {
+            Profiler::GetInstance().EndCpuScope(m_name, m_beginNs);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_beginNs;
+};
+
+/**
+ * @brief RAII GPU 作用域（GL 时间戳查询）
+ */
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name)
+        : m_index(Profiler::GetInstance().BeginGpuScope(name)) {
+    }
+
+    ~GpuProfileScope() {
+        if (m_index >= 0) {
+            Profiler::GetInstance().EndGpuScope(m_index);
+        }
+    }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    int32_t m_index;
+};
+
+} // namespace Render
+
+#define RENDER_PROFILE_CONCAT_INNER(a, b) a##b
+#define RENDER_PROFILE_CONCAT(a, b) RENDER_PROFILE_CONCAT_INNER(a, b)
+
+/// CPU 作用域计时：PROFILE_SCOPE("LOD.Cull");
+#define PROFILE_SCOPE(name) \
+    ::Render::ProfileScope RENDER_PROFILE_CONCAT(_renderProfileScope, __LINE__)(name)
+
+/// GPU 作用域计时（需在 GL 线程）：PROFILE_GPU_SCOPE("Renderer.Flush");
+#define PROFILE_GPU_SCOPE(name) \
+    ::Render::GpuProfileScope RENDER_PROFILE_CONCAT(_renderGpuProfileScope, __LINE__)(name)
@@ -49,8 +49,9 @@ public:
     /**
      * @brief 移除指定实体的组件
      * @param entity 实体 ID
+     * @return 实体原本是否拥有该组件
      */
-    virtual void RemoveEntity(EntityID entity) = 0;
+    virtual bool RemoveEntity(EntityID entity) = 0;
     
     /**
      * @brief 获取组件数量
@@ -131,10 +132,11 @@ public:
     /**
      * @brief 移除组件
      * @param entity 实体 ID
+     * @return 实体原本是否拥有该组件
      */
-    void Remove(EntityID entity) {
+    bool Remove(EntityID entity) {
         std::unique_lock lock(m_mutex);
-        m_components.erase(entity);
+        return m_components.erase(entity) > 0;
     }
     
     /**
@@ -180,9 +182,10 @@ public:
     /**
      * @brief 移除实体的组件（实现 IComponentArray 接口）
      * @param entity 实体 ID
+     * @return 实体原本是否拥有该组件
      */
-    void RemoveEntity(EntityID entity) override {
-        Remove(entity);
+    bool RemoveEntity(EntityID entity) override {
+        return Remove(entity);
     }
     
     /**
@@ -324,6 +327,7 @@ public:
     template<typename T>
     void AddComponent(EntityID entity, const T& component) {
         GetComponentArrayInternal<T>()->Add(entity, component);
+        NotifyComponentLifecycle(entity, std::type_index(typeid(T)), ComponentLifecycleEvent::Added);
     }
     
     /**
@@ -336,6 +340,7 @@ public:
     void AddComponent(EntityID entity, T&& component) {
         using ComponentType = std::remove_reference_t<T>;
         GetComponentArrayInternal<ComponentType>()->Add(entity, std::move(component));
+        NotifyComponentLifecycle(entity, std::type_index(typeid(ComponentType)), ComponentLifecycleEvent::Added);
     }
     
     /**
@@ -345,7 +350,9 @@ public:
      */
     template<typename T>
     void RemoveComponent(EntityID entity) {
-        GetComponentArrayInternal<T>()->Remove(entity);
+        if (GetComponentArrayInternal<T>()->Remove(entity)) {
+            NotifyComponentLifecycle(entity, std::type_index(typeid(T)), ComponentLifecycleEvent::Removed);
+        }
     }
     
     /**
@@ -393,11 +400,19 @@ public:
      * @param entity 实体 ID
      */
     void RemoveAllComponents(EntityID entity) {
-        std::shared_lock lock(m_mutex);
-        size_t count = 0;
-        for (auto& [typeIndex, array] : m_componentArrays) {
-            array->RemoveEntity(entity);
-            count++;
+        std::vector<std::type_index> removedTypes;
+        {
+            std::shared_lock lock(m_mutex);
+            for (auto& [typeIndex, array] : m_componentArrays) {
+                if (array->RemoveEntity(entity)) {
+                    removedTypes.push_back(typeIndex);
+                }
+            }
+        }
+        
+        // 释放注册表锁后再通知，回调中可以安全地查询组件
+        for (const auto& typeIndex : removedTypes) {
+            NotifyComponentLifecycle(entity, typeIndex, ComponentLifecycleEvent::Removed);
         }
     }
     
@@ -573,7 +588,46 @@ public:
     template<typename T>
     void OnComponentChanged(EntityID entity, const T& component);
     
+    // ==================== 组件生命周期事件 ====================
+    
+    /**
+     * @brief 组件生命周期事件类型
+     */
+    enum class ComponentLifecycleEvent {
+        Added,      ///< 组件被添加（或被整体替换）
+        Removed     ///< 组件被移除（包括销毁实体时的移除）
+    };
+    
+    /**
+     * @brief 组件生命周期回调函数类型
+     */
+    using ComponentLifecycleCallback = std::function<void(EntityID, ComponentLifecycleEvent)>;
+    
+    /**
+     * @brief 注册组件生命周期回调
+     * @tparam T 组件类型
+     * @param callback 回调函数 void(EntityID, ComponentLifecycleEvent)
+     * @return 回调ID（用于取消注册）
+     * 
+     * @note 回调在组件数组与注册表的锁释放后调用，可以在回调中查询组件
+     * @note 回调可能在任意调用 AddComponent/RemoveComponent/DestroyEntity 的线程上执行
+     * @note 用于增量维护派生数据（如场景 BVH），避免逐帧扫描全部实体
+     */
+    template<typename T>
+    uint64_t RegisterComponentLifecycleCallback(ComponentLifecycleCallback callback);
+    
+    /**
+     * @brief 取消注册组件生命周期回调
+     * @param callbackId 回调ID（由RegisterComponentLifecycleCallback返回）
+     */
+    void UnregisterComponentLifecycleCallback(uint64_t callbackId);
+    
 private:
+    /**
+     * @brief 触发组件生命周期事件（没有注册回调时只有一次原子读取）
+     */
+    void NotifyComponentLifecycle(EntityID entity, std::type_index type, ComponentLifecycleEvent event);
+    
     /**
      * @brief 获取指定类型的组件数组（内部方法，返回裸指针）
      * @tparam T 组件类型
@@ -669,6 +723,21 @@ private:
     std::vector<ComponentChangeCallbackRecord> m_componentChangeCallbacks;  ///< 回调列表
     mutable std::mutex m_callbackMutex;                 ///< 回调列表的互斥锁
     
+    /**
+     * @brief 组件生命周期回调记录
+     */
+    struct ComponentLifecycleCallbackRecord {
+        uint64_t id;                                    ///< 回调ID
+        std::type_index componentType;                 ///< 组件类型
+        ComponentLifecycleCallback callback;            ///< 回调函数
+        
+        ComponentLifecycleCallbackRecord(uint64_t id, std::type_index type, ComponentLifecycleCallback cb)
+            : id(id), componentType(type), callback(std::move(cb)) {}
+    };
+    
+    std::vector<ComponentLifecycleCallbackRecord> m_lifecycleCallbacks;  ///< 生命周期回调列表（受 m_callbackMutex 保护）
+    std::atomic<size_t> m_lifecycleCallbackCount{0};    ///< 生命周期回调数量（无回调时跳过加锁）
+    
     std::unordered_map<std::type_index, std::unique_ptr<IComponentArray>> m_componentArrays;
     mutable std::shared_mutex m_mutex;
 };
@@ -717,6 +786,64 @@ inline void ComponentRegistry::UnregisterComponentChangeCallback(uint64_t callba
     m_componentChangeCallbacks.erase(it, m_componentChangeCallbacks.end());
 }
 
+template<typename T>
+uint64_t ComponentRegistry::RegisterComponentLifecycleCallback(ComponentLifecycleCallback callback) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    
+    uint64_t callbackId = m_nextCallbackId.fetch_add(1);
+    m_lifecycleCallbacks.emplace_back(callbackId, std::type_index(typeid(T)), std::move(callback));
+    m_lifecycleCallbackCount.store(m_lifecycleCallbacks.size(), std::memory_order_release);
+    return callbackId;
+}
+
+inline void ComponentRegistry::UnregisterComponentLifecycleCallback(uint64_t callbackId) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    
+    auto it = std::remove_if(
+        m_lifecycleCallbacks.begin(),
+        m_lifecycleCallbacks.end(),
+        [callbackId](const ComponentLifecycleCallbackRecord& record) {
+            return record.id == callbackId;
+        }
+    );
+    m_lifecycleCallbacks.erase(it, m_lifecycleCallbacks.end());
+    m_lifecycleCallbackCount.store(m_lifecycleCallbacks.size(), std::memory_order_release);
+}
+
+inline void ComponentRegistry::NotifyComponentLifecycle(EntityID entity, std::type_index type,
+                                                        ComponentLifecycleEvent event) {
+    if (m_lifecycleCallbackCount.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+    
+    // 复制匹配的回调后再调用（不在持有锁的情况下调用，避免死锁）
+    std::vector<ComponentLifecycleCallback> callbacksToInvoke;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        for (const auto& record : m_lifecycleCallbacks) {
+            if (record.componentType == type && record.callback) {
+                callbacksToInvoke.push_back(record.callback);
+            }
+        }
+    }
+    
+    for (const auto& callback : callbacksToInvoke) {
+        try {
+            callback(entity, event);
+        } catch (const std::exception& e) {
+            Logger::GetInstance().WarningFormat(
+                "[ComponentRegistry] Exception in lifecycle callback for entity %u: %s",
+                entity.index, e.what()
+            );
+        } catch (...) {
+            Logger::GetInstance().WarningFormat(
+                "[ComponentRegistry] Unknown exception in lifecycle callback for entity %u",
+                entity.index
+            );
+        }
+    }
+}
+
 template<typename T>
 void ComponentRegistry::OnComponentChanged(EntityID entity, const T& component) {
     std::type_index typeIndex = std::type_index(typeid(T));
@@ -32,6 +32,7 @@
 #include <optional>  // C++17 std::optional
 #include <unordered_map>
 #include <functional>
+#include <algorithm>
 #include <sstream>  // std::ostringstream
 #include "render/sprite/sprite_nineslice.h"
 
@@ -317,6 +318,10 @@ struct MeshRenderComponent {
     uint32_t layerID = Layers::World::Midground.value;        ///< 渲染层级（默认 WORLD_MIDGROUND）
     int32_t renderPriority = 0;    ///< 渲染优先级
     
+    // ==================== 软件遮挡剔除 ====================
+    bool occluder = false;         ///< 是否作为遮挡体写入遮挡深度缓冲（适合墙体、地形等大型不透明物体）
+    Ref<Mesh> occluderMesh;        ///< 遮挡用的简化网格（可选，为空时使用 LOD3/LOD2 网格或 mesh）
+    
     // ==================== 材质属性覆盖 ====================
     // 这些属性会在渲染时覆盖材质的默认值
     
@@ -383,6 +388,74 @@ struct MeshRenderComponent {
     void ClearMaterialOverrides() { materialOverride = MaterialOverride{}; }
 };
 
+// ============================================================
+// 世界空间包围体组件
+// ============================================================
+
+/**
+ * @brief 世界空间包围体组件
+ * 
+ * 缓存网格的世界空间 AABB 与包围球，供视锥体裁剪使用。
+ * 由 MeshRenderSystem 自动添加并维护：仅当世界矩阵或网格（指针/包围盒版本）变化时重新计算，
+ * 避免每帧遍历顶点。
+ */
+struct WorldBoundsComponent {
+    AABB localBounds;                          ///< 网格局部空间包围盒
+    AABB worldBounds;                          ///< 世界空间 AABB
+    Vector3 sphereCenter = Vector3::Zero();    ///< 世界空间包围球球心
+    float sphereRadius = 0.0f;                 ///< 世界空间包围球半径
+    bool valid = false;                        ///< 网格为空时为 false
+    uint8_t cullPlaneHint = 0;                 ///< 上次剔除该包围球的视锥体平面（Frustum::CullSpheres 平面一致性缓存）
+    
+    // ==================== 变化检测 ====================
+    const Mesh* sourceMesh = nullptr;          ///< 上次计算使用的网格
+    uint64_t sourceBoundsVersion = 0;          ///< 上次计算时的网格包围盒版本
+    Matrix4 sourceWorldMatrix = Matrix4::Identity();  ///< 上次计算时的世界矩阵
+    
+    WorldBoundsComponent() = default;
+    
+    /**
+     * @brief 按需刷新包围体
+     * @return 是否发生了重新计算
+     */
+    bool Refresh(const Ref<Mesh>& mesh, const Matrix4& worldMatrix) {
+        const uint64_t boundsVersion = mesh ? mesh->GetBoundsVersion() : 0;
+        const bool meshChanged = mesh.get() != sourceMesh || boundsVersion != sourceBoundsVersion;
+        if (!meshChanged && worldMatrix == sourceWorldMatrix) {
+            return false;
+        }
+        
+        if (meshChanged) {
+            sourceMesh = mesh.get();
+            sourceBoundsVersion = boundsVersion;
+            valid = mesh && mesh->GetVertexCount() > 0;
+            localBounds = valid ? mesh->CalculateBounds() : AABB();
+        }
+        sourceWorldMatrix = worldMatrix;
+        
+        if (!valid) {
+            worldBounds = AABB();
+            sphereCenter = worldMatrix.block<3, 1>(0, 3);
+            sphereRadius = 0.0f;
+            return true;
+        }
+        
+        // 变换中心点，并以线性部分的绝对值变换半长（Arvo 方法）
+        const Matrix3 linear = worldMatrix.block<3, 3>(0, 0);
+        const Vector3 localCenter = localBounds.GetCenter();
+        const Vector3 localExtents = localBounds.GetExtents();
+        const Vector3 center = linear * localCenter + worldMatrix.block<3, 1>(0, 3);
+        const Vector3 extents = linear.cwiseAbs() * localExtents;
+        worldBounds = AABB(center - extents, center + extents);
+        
+        // 包围球：局部半长对角线乘以最大轴缩放
+        const float maxScale = std::max({linear.col(0).norm(), linear.col(1).norm(), linear.col(2).norm()});
+        sphereCenter = center;
+        sphereRadius = localExtents.norm() * maxScale;
+        return true;
+    }
+};
+
 // ============================================================
 // Model 渲染组件
 // ============================================================
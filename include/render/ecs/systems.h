@@ -30,9 +30,14 @@
 #include "render/camera.h"
 #include "render/types.h"
 #include "render/lod_instanced_renderer.h"  // LOD 实例化渲染器
+#include "render/bvh.h"
+#include "render/occlusion_culler.h"
 #include "render/object_pool.h"
+#include "render/std140_layout.h"
+#include "render/uniform_buffer.h"
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace Render {
@@ -45,6 +50,7 @@ namespace ECS {
 // 前向声明
 class CameraSystem;
 struct GeometryComponent;
+struct WorldBoundsComponent;
 
 // ============================================================
 // Transform 更新系统（维护变换层级）
@@ -236,6 +242,8 @@ public:
         size_t visibleMeshes = 0;    ///< 可见网格数量
         size_t culledMeshes = 0;     ///< 被裁剪的网格数量
         size_t drawCalls = 0;        ///< 绘制调用数量
+        size_t occludedMeshes = 0;   ///< 被软件遮挡剔除的网格数量（不计入 culledMeshes）
+        size_t occluderCount = 0;    ///< 光栅化的遮挡体数量
         
         // LOD 统计信息
         size_t lodEnabledEntities = 0;      ///< 启用 LOD 的实体数量
@@ -243,7 +251,17 @@ public:
         size_t lod1Count = 0;               ///< 使用 LOD1 的实体数量
         size_t lod2Count = 0;               ///< 使用 LOD2 的实体数量
         size_t lod3Count = 0;               ///< 使用 LOD3 的实体数量
+        size_t impostorCount = 0;           ///< 使用 Impostor 的实体数量
         size_t lodCulledCount = 0;          ///< 被 LOD 剔除的实体数量
+        size_t lodEvaluated = 0;            ///< 本帧重新计算 LOD 的实体数量
+        size_t lodDeferred = 0;             ///< 本帧因分帧更新沿用上次 LOD 的实体数量
+        size_t lodTriangleBudget = 0;       ///< 三角形预算（0 表示未启用）
+        size_t lodSelectedTriangles = 0;    ///< 预算模式下所选 LOD 的三角形总数
+        
+        // Meshlet 剔除统计
+        size_t meshletTestedMeshes = 0;     ///< 做了 meshlet 剔除的网格数量
+        size_t meshletPartialMeshes = 0;    ///< 只提交部分 meshlet 的网格数量
+        size_t meshletTrianglesCulled = 0;  ///< 被 meshlet 剔除的三角形数量
     };
     
     /**
@@ -252,6 +270,17 @@ public:
      */
     [[nodiscard]] const RenderStats& GetStats() const { return m_stats; }
     
+    /**
+     * @brief 设置 LOD 选择参数（远处实体分帧更新、全局三角形预算）
+     * @param options 选择参数
+     */
+    void SetLODSelectionOptions(const LODSelectionOptions& options) { m_lodSelectionOptions = options; }
+    
+    /**
+     * @brief 获取 LOD 选择参数
+     */
+    [[nodiscard]] const LODSelectionOptions& GetLODSelectionOptions() const { return m_lodSelectionOptions; }
+    
     /**
      * @brief 设置是否启用 LOD 实例化渲染
      * 
@@ -290,6 +319,74 @@ public:
      */
     [[nodiscard]] bool IsLODFrustumCullingEnabled() const { return m_lodFrustumCullingEnabled; }
     
+    /**
+     * @brief 设置是否使用场景 BVH 加速视锥体裁剪
+     * 
+     * 启用后把实体的保守裁剪包围盒同步到 SceneBVH（静止实体位于静态树，移动过的实体迁移到动态树），
+     * SubmitRenderables 只处理 BVH 查询返回的候选实体，之后仍执行原有的逐实体裁剪，
+     * 因此最终可见结果与线性遍历一致，而裁剪开销随可见数量而非场景规模增长。
+     * 
+     * BVH 由事件增量维护：Transform 变化事件与 Transform/MeshRender 组件的添加、移除事件
+     * 只刷新相关实体的包围体；此外每帧只复查尚无包围体的实体、有父变换的实体（父变换移动不发子实体事件），
+     * 以及轮转的一小段已跟踪实体（兜底直接替换 MeshRenderComponent::mesh 等不发事件的修改）。
+     * 启用期间 Update 不再逐帧刷新全部实体的 WorldBoundsComponent。
+     * 
+     * @param enabled 是否启用（禁用时释放 BVH）
+     */
+    void SetBVHCullingEnabled(bool enabled);
+    
+    /**
+     * @brief 获取是否启用场景 BVH 裁剪
+     */
+    [[nodiscard]] bool IsBVHCullingEnabled() const { return m_bvhCullingEnabled; }
+    
+    /**
+     * @brief 获取场景 BVH（ID 为实体索引，包围盒为裁剪用的保守包围盒，可用于拾取/范围查询的粗筛）
+     */
+    [[nodiscard]] const SceneBVH& GetSceneBVH() const { return m_sceneBVH; }
+    
+    /**
+     * @brief 设置是否启用 CPU 软件遮挡剔除
+     * 
+     * 启用后每帧在视锥体裁剪之后，把 MeshRenderComponent::occluder 为 true 的可见实体
+     * （优先使用 occluderMesh，其次 LOD3/LOD2 网格）光栅化到低分辨率深度缓冲，
+     * 再用 WorldBoundsComponent 的包围盒测试其余实体，被遮挡的实体不再提交。
+     * 
+     * @param enabled 是否启用
+     */
+    void SetOcclusionCullingEnabled(bool enabled) { m_occlusionCullingEnabled = enabled; }
+    
+    /**
+     * @brief 获取是否启用软件遮挡剔除
+     */
+    [[nodiscard]] bool IsOcclusionCullingEnabled() const { return m_occlusionCullingEnabled; }
+    
+    /**
+     * @brief 获取软件遮挡剔除器（可调整分辨率或读取深度缓冲/统计用于调试）
+     */
+    [[nodiscard]] OcclusionCuller& GetOcclusionCuller() { return m_occlusionCuller; }
+    
+    /**
+     * @brief 设置是否启用 meshlet（簇级）剔除
+     * 
+     * 启用后，逐实体渲染路径中已构建 meshlet（MeshletBuilder::BuildForMesh）且三角形数不少于
+     * 阈值的网格，每帧按簇做视锥体与法线锥背面测试，只通过 Mesh::DrawMeshletRanges 提交可见簇；
+     * 全部可见时照常绘制（仍可合批），全部不可见时跳过。双面材质（CullFace::None）不做 meshlet 剔除。
+     * 
+     * @param enabled 是否启用
+     */
+    void SetMeshletCullingEnabled(bool enabled) { m_meshletCullingEnabled = enabled; }
+    
+    /**
+     * @brief 获取是否启用 meshlet 剔除
+     */
+    [[nodiscard]] bool IsMeshletCullingEnabled() const { return m_meshletCullingEnabled; }
+    
+    /**
+     * @brief 设置参与 meshlet 剔除的最少三角形数（小网格整体绘制更划算，默认 4096）
+     */
+    void SetMeshletCullingMinTriangles(size_t triangles) { m_meshletMinTriangles = triangles; }
+    
     /**
      * @brief 设置LOD实例化渲染的分批处理参数
      * 
@@ -382,6 +479,57 @@ private:
                            const Vector3& cameraPosition, 
                            uint64_t frameId);
     
+    /**
+     * @brief 刷新世界空间包围体（缺失时自动添加 WorldBoundsComponent）
+     * @param entities 具有 Transform 与 MeshRender 组件的实体
+     */
+    void UpdateWorldBounds(const std::vector<EntityID>& entities);
+    
+    /**
+     * @brief 刷新单个实体的世界空间包围体
+     * @return 包围体组件；网格或变换缺失时返回 nullptr
+     */
+    const WorldBoundsComponent* RefreshWorldBounds(EntityID entity);
+    
+    /**
+     * @brief 处理本帧的 BVH 事件与复查列表，只刷新受影响实体的包围体并提交 BVH
+     */
+    void SyncSceneBVH();
+    
+    /**
+     * @brief 同步单个实体到场景 BVH（实体已销毁或失去组件时从 BVH 移除）
+     */
+    void SyncBVHEntity(EntityID entity);
+    
+    /**
+     * @brief 注册驱动 BVH 增量更新的组件事件回调（首次注册后安排一次全量同步）
+     */
+    void RegisterBVHCallbacks();
+    
+    /**
+     * @brief 取消注册 BVH 事件回调并丢弃未处理的事件
+     */
+    void UnregisterBVHCallbacks();
+    
+    /**
+     * @brief 通过场景 BVH 收集可能可见的实体（视锥体查询 + 相机近距离保护范围）
+     * @param candidates 输出候选实体（按实体索引排序）
+     * @return 无可用相机时返回 false，调用方应回退到全部实体
+     */
+    bool CollectBVHCandidates(std::vector<EntityID>& candidates);
+    
+    /**
+     * @brief 光栅化遮挡体并移除被遮挡的实体
+     * @param entities 待提交的实体（原地移除被遮挡者）
+     */
+    void ApplyOcclusionCulling(std::vector<EntityID>& entities);
+    
+    /**
+     * @brief 按包围球的屏幕投影尺寸请求流式纹理的 mip 级别（TextureStreamer）
+     * @param entities 待提交的实体
+     */
+    void RequestTextureResidency(const std::vector<EntityID>& entities);
+    
     /**
      * @brief 获取主相机位置
      * @return 相机位置，如果无法获取返回零向量
@@ -408,6 +556,31 @@ private:
     
     // 阶段3.3：LOD 视锥体裁剪优化
     bool m_lodFrustumCullingEnabled = false;    ///< 是否启用 LOD 视锥体裁剪优化
+    LODSelectionOptions m_lodSelectionOptions;  ///< LOD 分帧更新与三角形预算参数
+    
+    // 场景 BVH 裁剪
+    bool m_bvhCullingEnabled = false;           ///< 是否启用场景 BVH 裁剪
+    SceneBVH m_sceneBVH;                        ///< 以实体索引为 ID 的静态/动态 BVH
+    std::vector<EntityID> m_bvhEntities;        ///< 实体索引 -> 实体 ID（含版本，未跟踪为 Invalid）
+    std::vector<uint64_t> m_bvhSyncFrame;       ///< 实体索引 -> 最近一次同步的帧 ID（同帧去重）
+    std::vector<EntityID> m_bvhUnbounded;       ///< 尚无有效包围体的实体（始终作为候选，每帧复查）
+    std::vector<EntityID> m_bvhParented;        ///< 有父变换的实体（每帧复查）
+    std::vector<EntityID> m_bvhTouched;         ///< 本帧需要同步的实体缓冲
+    std::vector<uint32_t> m_bvhQueryScratch;    ///< BVH 查询结果缓冲
+    size_t m_bvhRevalidateCursor = 0;           ///< 轮转复查的实体索引游标
+    bool m_bvhNeedsFullSync = true;             ///< 下一次同步是否遍历全部实体
+    std::vector<uint64_t> m_bvhCallbackIds;     ///< 组件变化回调 ID（首项）与生命周期回调 ID
+    std::mutex m_bvhEventMutex;                 ///< 保护 m_bvhPendingEntities（事件可能来自任意线程）
+    std::vector<EntityID> m_bvhPendingEntities; ///< 事件回调收集的待同步实体
+    
+    // 软件遮挡剔除
+    bool m_occlusionCullingEnabled = false;     ///< 是否启用软件遮挡剔除
+    OcclusionCuller m_occlusionCuller;          ///< 低分辨率深度缓冲
+    
+    // Meshlet 剔除
+    bool m_meshletCullingEnabled = false;       ///< 是否启用 meshlet 剔除
+    size_t m_meshletMinTriangles = 4096;        ///< 参与 meshlet 剔除的最少三角形数
+    std::vector<MeshletDrawRange> m_meshletRanges;  ///< 本实体可见 meshlet 区间缓冲
 };
 
 // ============================================================
@@ -433,6 +606,7 @@ public:
         size_t lod1Count = 0;               ///< 使用 LOD1 的实体数量
         size_t lod2Count = 0;               ///< 使用 LOD2 的实体数量
         size_t lod3Count = 0;               ///< 使用 LOD3 的实体数量
+        size_t impostorCount = 0;           ///< 使用 Impostor 的实体数量
         size_t lodCulledCount = 0;          ///< 被 LOD 剔除的实体数量
     };
 
@@ -700,6 +874,13 @@ private:
     void SetLightUniforms();
     void SetTimeUniforms();
     
+    /**
+     * @brief 打包并上传帧数据 UBO，绑定到 kFrameUniformBinding
+     *
+     * 声明了 FrameData 块的着色器只依赖该 UBO，不再逐着色器上传相机/光照/时间 uniform。
+     */
+    void UploadFrameUniforms();
+    
     Renderer* m_renderer;                    ///< 渲染器指针
     CameraSystem* m_cameraSystem = nullptr;  ///< 缓存的相机系统
     LightSystem* m_lightSystem = nullptr;    ///< 缓存的光源系统
@@ -707,6 +888,10 @@ private:
     bool m_enabled = true;                   ///< 是否启用自动管理
     float m_time = 0.0f;                     ///< 累计时间
     Vector3 m_lastCameraPosition = Vector3::Zero(); ///< 最近一次相机位置缓存
+    
+    FrameUniformData m_frameData;            ///< 本帧待上传的帧数据
+    std::unique_ptr<Std140Writer> m_frameWriter;        ///< 帧数据打包缓冲（复用）
+    std::unique_ptr<UniformBuffer> m_frameUniformBuffer; ///< 帧数据 UBO
 };
 
 // ============================================================
@@ -20,6 +20,8 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -79,6 +81,75 @@ public:
      * @return 组合后的路径
      */
     static std::string CombinePaths(const std::string& base, const std::string& relative);
+    
+    /**
+     * @brief 规范化路径（词法处理，不访问文件系统）
+     * 
+     * 折叠 "." / ".." 与重复分隔符，统一使用 '/'，用于判断两个路径字符串是否指向同一文件
+     * （例如 "models/./a.obj" 与 "models//a.obj"）
+     * @param filepath 文件路径
+     * @return 规范化后的路径
+     */
+    static std::string NormalizePath(const std::string& filepath);
+    
+    /**
+     * @brief FNV-1a 64 位哈希（按 8 字节分组处理以提高大数据吞吐）
+     * @param data 数据指针
+     * @param size 字节数
+     * @param seed 初始值（用于串联多段数据，默认为 FNV 偏移基数）
+     */
+    static uint64_t HashBytes(const void* data, size_t size, uint64_t seed = kHashSeed);
+    
+    /**
+     * @brief 计算文件内容哈希（内存映射读取，FNV-1a 64 位）
+     * @return 哈希值，文件无法读取时返回 0
+     */
+    static uint64_t HashFile(const std::string& filepath);
+    
+    static constexpr uint64_t kHashSeed = 1469598103934665603ull;
+};
+
+/**
+ * @brief 只读内存映射文件
+ * 
+ * 将整个文件映射到进程地址空间（POSIX mmap / Windows MapViewOfFile），
+ * 用于快速读取二进制缓存，避免先整体拷贝到 std::vector。
+ * 
+ * @note 仅支持只读映射；对象析构时自动解除映射
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    /**
+     * @brief 映射文件
+     * @param filepath 文件路径
+     * @return 成功返回 true；文件不存在、为空或映射失败返回 false
+     */
+    bool Open(const std::string& filepath);
+    
+    /**
+     * @brief 解除映射
+     */
+    void Close();
+    
+    [[nodiscard]] bool IsOpen() const { return m_data != nullptr; }
+    [[nodiscard]] const uint8_t* GetData() const { return m_data; }
+    [[nodiscard]] size_t GetSize() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
 };
 
 } // namespace Render
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/hdri_converter.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace Render {
+
+/**
+ * @brief HDRI 立方体贴图磁盘缓存
+ * 
+ * 保存 HDRIConverter::Convert 的结果（立方体贴图 RGBA32F 各级别 + 辐照度球谐），缓存键由
+ * 源 .hdr 文件内容哈希、分辨率与预过滤/球谐选项共同决定。再次加载同一 HDRI 时通过内存映射
+ * 读取，跳过 RGBE 解码、投影转换与预过滤。
+ * 
+ * **文件格式**（本机字节序，扩展名 .envc）：
+ * - 文件头：魔数 "RENV"、版本、缓存键、基础分辨率、级别数、标志（预过滤/球谐）
+ * - 27 个浮点数：辐照度球谐系数（无球谐时为 0）
+ * - 数据区：各级别 6 个面的 RGBA32F 像素（从大到小连续排列，级别 i 分辨率为 max(1, 基础分辨率 >> i)）
+ * 
+ * @note 线程安全：Load/Store 可在任意线程调用；写入通过临时文件 + 重命名保证原子性
+ */
+class HDRICache {
+public:
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats {
+        size_t hits = 0;      ///< 命中次数
+        size_t misses = 0;    ///< 未命中次数
+        size_t writes = 0;    ///< 成功写入次数
+    };
+    
+    static HDRICache& GetInstance();
+    
+    /**
+     * @brief 设置缓存目录（默认 "cache/environment"，不存在时在首次写入时创建）
+     */
+    void SetCacheDirectory(const std::string& directory);
+    [[nodiscard]] std::string GetCacheDirectory() const;
+    
+    /**
+     * @brief 启用/禁用缓存（禁用时 Load 总是未命中，Store 不写入）
+     */
+    void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 组合源文件哈希与转换选项得到缓存键
+     * 
+     * useDiskCache 不影响转换结果，不参与计算
+     */
+    static uint64_t BuildKey(uint64_t sourceHash, const HDRCubemapOptions& options);
+    
+    /**
+     * @brief 获取缓存键对应的文件路径
+     */
+    [[nodiscard]] std::string GetCachePath(uint64_t key) const;
+    
+    /**
+     * @brief 从缓存加载转换结果
+     * @return 命中且数据有效返回 true
+     */
+    bool Load(uint64_t key, HDRCubemapData& outData);
+    
+    /**
+     * @brief 写入缓存
+     * @return 写入成功返回 true
+     */
+    bool Store(uint64_t key, const HDRCubemapData& data);
+    
+    /**
+     * @brief 删除缓存目录下所有 .envc 文件
+     * @return 删除的文件数
+     */
+    size_t ClearDiskCache();
+    
+    [[nodiscard]] Stats GetStats() const;
+    void ResetStats();
+
+private:
+    HDRICache() = default;
+    ~HDRICache() = default;
+    HDRICache(const HDRICache&) = delete;
+    HDRICache& operator=(const HDRICache&) = delete;
+    
+    mutable std::mutex m_directoryMutex;
+    std::string m_directory = "cache/environment";
+    std::atomic<bool> m_enabled{true};
+    
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+    std::atomic<size_t> m_writes{0};
+};
+
+} // namespace Render
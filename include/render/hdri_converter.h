@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/types.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief 浮点 HDR 图像（RGBA32F，行优先，第 0 行为图像顶部）
+ */
+struct HDRImage {
+    int width = 0;
+    int height = 0;
+    std::vector<float> pixels;    ///< width * height * 4 个浮点数（Alpha 恒为 1）
+    
+    [[nodiscard]] bool IsValid() const {
+        return width > 0 && height > 0 &&
+               pixels.size() == static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    }
+};
+
+/**
+ * @brief HDRI 转立方体贴图选项
+ */
+struct HDRCubemapOptions {
+    int resolution = 512;              ///< 立方体贴图每面分辨率
+    uint32_t specularMipLevels = 0;    ///< 预过滤镜面反射 mip 级数（0 = 不预过滤，只输出基础级别）
+    uint32_t specularSampleCount = 64; ///< 预过滤时每个像素的 GGX 重要性采样数
+    bool computeIrradianceSH = true;   ///< 是否计算漫反射辐照度球谐系数（3 阶，9 个系数）
+    bool useDiskCache = true;          ///< 是否查找/写入 HDRICache（不影响转换结果）
+};
+
+/**
+ * @brief 立方体贴图 mip 级别（6 个面按 +X, -X, +Y, -Y, +Z, -Z 顺序连续存放）
+ */
+struct HDRCubemapLevel {
+    int resolution = 0;    ///< 该级别每面分辨率
+    size_t offset = 0;     ///< 在 HDRCubemapData::pixels 中的起始位置（浮点数个数）
+};
+
+/**
+ * @brief HDRI 转换结果（RGBA32F）
+ * 
+ * 未预过滤时只有基础级别；预过滤时第 i 级对应粗糙度 i / (levels.size() - 1)。
+ */
+struct HDRCubemapData {
+    int resolution = 0;
+    bool prefiltered = false;                     ///< levels 是否为预过滤镜面反射 mip 链
+    bool hasIrradianceSH = false;
+    std::array<Vector3, 9> irradianceSH{};        ///< 辐照度球谐系数（已与余弦核卷积，E(n) = Σ c_i·Y_i(n)）
+    std::vector<HDRCubemapLevel> levels;
+    std::vector<float> pixels;
+    
+    /**
+     * @brief 获取指定级别与面的像素起始指针（resolution * resolution * 4 个浮点数）
+     */
+    [[nodiscard]] const float* GetFace(size_t level, int face) const {
+        const HDRCubemapLevel& l = levels[level];
+        return pixels.data() + l.offset + static_cast<size_t>(face) * l.resolution * l.resolution * 4;
+    }
+    
+    [[nodiscard]] bool IsValid() const { return resolution > 0 && !levels.empty() && !pixels.empty(); }
+};
+
+/**
+ * @brief HDRI 解码与等距柱状投影 → 立方体贴图转换（纯 CPU）
+ * 
+ * - 解码 Radiance .hdr（RGBE，支持新式逐通道游程编码与未压缩扫描线）
+ * - 等距柱状投影转立方体贴图：按「面 × 行」拆分到 TaskScheduler::ParallelFor，
+ *   双线性采样在 SSE 下一次处理一个 RGBA 像素（无 SSE 时回退到标量实现）
+ * - 可选：GGX 重要性采样预过滤镜面反射 mip 链（采样源按样本立体角选择降采样级别）
+ * - 可选：3 阶球谐投影得到漫反射辐照度
+ * 
+ * 面方向与 OpenGL 立方体贴图约定一致，结果可直接交给 TextureCubemap::CreateFromHDRData 上传。
+ * 
+ * **使用示例**：
+ * @code
+ * HDRCubemapOptions options;
+ * options.resolution = 256;
+ * options.specularMipLevels = 5;
+ * HDRCubemapData data;
+ * if (HDRIConverter::LoadFromFile("environments/sunset.hdr", options, data)) {  // 可在工作线程调用
+ *     cubemap->CreateFromHDRData(data);                                       // GL 线程
+ * }
+ * @endcode
+ * 
+ * @note 线程安全：所有函数均为无状态静态函数，可在任意线程调用
+ */
+class HDRIConverter {
+public:
+    /**
+     * @brief 从内存解码 Radiance .hdr
+     * @param error 可选，失败时写入原因
+     */
+    static bool DecodeRadiance(const uint8_t* data, size_t size, HDRImage& outImage, std::string* error = nullptr);
+    
+    /**
+     * @brief 从文件解码 Radiance .hdr（内存映射读取）
+     */
+    static bool LoadRadianceFile(const std::string& filepath, HDRImage& outImage, std::string* error = nullptr);
+    
+    /**
+     * @brief 将图像编码为 Radiance .hdr（宽度 8~32767 时使用游程编码）
+     */
+    static std::vector<uint8_t> EncodeRadiance(const HDRImage& image);
+    
+    /**
+     * @brief 方向 → 等距柱状投影坐标（u 水平环绕，v = 0 对应 +Y）
+     */
+    static void DirectionToEquirect(const Vector3& direction, float& u, float& v);
+    
+    /**
+     * @brief 立方体贴图面像素中心 → 单位方向（OpenGL 约定）
+     */
+    static Vector3 CubemapTexelDirection(int face, int x, int y, int resolution);
+    
+    /**
+     * @brief 双线性采样等距柱状投影图像（水平环绕，垂直钳制）
+     * @param outRGBA 输出 4 个浮点数
+     */
+    static void SampleBilinear(const HDRImage& image, float u, float v, float* outRGBA);
+    
+    /**
+     * @brief 等距柱状投影转立方体贴图基础级别
+     * @param outPixels 输出 6 * resolution * resolution * 4 个浮点数
+     */
+    static void ConvertToCubemap(const HDRImage& image, int resolution, std::vector<float>& outPixels);
+    
+    /**
+     * @brief 计算漫反射辐照度球谐系数（按像素立体角加权投影后与余弦核卷积）
+     * @param facePixels 立方体贴图基础级别（ConvertToCubemap 的输出）
+     */
+    static std::array<Vector3, 9> ComputeIrradianceSH(const std::vector<float>& facePixels, int resolution);
+    
+    /**
+     * @brief 在方向 n 上求值辐照度球谐
+     */
+    static Vector3 EvaluateIrradianceSH(const std::array<Vector3, 9>& sh, const Vector3& normal);
+    
+    /**
+     * @brief Convert 实际输出的级数：specularMipLevels 钳制到 [1, 完整 mip 链长度]，大于 1 时才预过滤
+     */
+    static uint32_t GetSpecularLevelCount(const HDRCubemapOptions& options);
+    
+    /**
+     * @brief 完整转换：立方体贴图基础级别 + 可选预过滤 mip 链 + 可选辐照度球谐
+     */
+    static bool Convert(const HDRImage& image, const HDRCubemapOptions& options, HDRCubemapData& outData);
+    
+    /**
+     * @brief 从 .hdr 文件加载并转换，优先读取 HDRICache，未命中时转换后写入缓存
+     */
+    static bool LoadFromFile(const std::string& filepath, const HDRCubemapOptions& options,
+                             HDRCubemapData& outData, std::string* error = nullptr);
+};
+
+} // namespace Render
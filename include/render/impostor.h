@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/types.h"
+#include "render/mesh.h"
+#include "render/material.h"
+#include "render/texture.h"
+#include <cstdint>
+#include <vector>
+
+namespace Render {
+
+struct LODConfig;
+
+/**
+ * @brief 替身图集烘焙后端
+ */
+enum class ImpostorBakeBackend {
+    Auto,   ///< 当前线程为已注册的 GL 线程时使用 GPU，否则使用 CPU
+    GPU,    ///< 离屏 Framebuffer 渲染（需要 GL 上下文）
+    CPU     ///< 软件光栅化（无需 GL，可用于工具链和测试）
+};
+
+/**
+ * @brief 替身图集烘焙选项
+ */
+struct ImpostorBakeOptions {
+    int framesPerAxis = 8;          ///< 八面体网格每轴帧数（总帧数为其平方）
+    int atlasSize = 2048;           ///< 图集边长（像素），需能被 framesPerAxis 整除
+    ImpostorBakeBackend backend = ImpostorBakeBackend::Auto;
+    Vector3 lightDirection{-0.4f, -1.0f, -0.3f};  ///< CPU 烘焙的方向光方向（光线传播方向）
+    float ambient = 0.35f;          ///< CPU 烘焙的环境光强度
+    int dilationPixels = 2;         ///< 向透明像素扩展边缘颜色的像素数（减少 Mipmap 黑边）
+};
+
+/**
+ * @brief 八面体替身图集
+ * 
+ * 从覆盖整个球面的 N×N 个方向（八面体映射，y 轴向上）对网格做正交渲染，
+ * 结果排列为一张 RGBA8 图集。运行时使用 impostor 着色器将远处实例绘制为
+ * 四边形：着色器根据相机到实例的局部方向选出最接近的帧，并让四边形朝向该帧的观察方向，
+ * 因此替身可直接走 LODInstancedRenderer 的实例化路径。
+ * 
+ * **使用示例**：
+ * @code
+ * auto atlas = ImpostorAtlas::Bake(treeMesh, treeMaterial, options);
+ * if (atlas.UploadToGPU()) {
+ *     atlas.ConfigureLOD(lodComp.config, 3000.0f);  // LOD3 阈值之后到 3000 使用替身
+ * }
+ * @endcode
+ * 
+ * @note 像素行 0 对应纹理坐标 v = 0（与 glReadPixels/glTexImage2D 一致）
+ */
+class ImpostorAtlas {
+public:
+    ImpostorAtlas() = default;
+    
+    /**
+     * @brief 烘焙替身图集
+     * @param mesh 源网格（CPU 后端需要顶点数据）
+     * @param material 源材质（可为空；CPU 后端仅使用漫反射颜色）
+     * @param options 烘焙选项
+     * @return 图集；失败时 IsValid() 为 false
+     */
+    static ImpostorAtlas Bake(const Ref<Mesh>& mesh, const Ref<Material>& material,
+                              const ImpostorBakeOptions& options = {});
+    
+    /**
+     * @brief 使用软件光栅化烘焙（不需要 GL 上下文）
+     */
+    static ImpostorAtlas BakeCPU(const Ref<Mesh>& mesh, const Ref<Material>& material,
+                                 const ImpostorBakeOptions& options = {});
+    
+    /**
+     * @brief 使用离屏 Framebuffer 烘焙（必须在 GL 线程调用）
+     */
+    static ImpostorAtlas BakeGPU(const Ref<Mesh>& mesh, const Ref<Material>& material,
+                                 const ImpostorBakeOptions& options = {});
+    
+    // ==================== 八面体映射 ====================
+    
+    /**
+     * @brief 单位方向编码到八面体坐标 [-1, 1]²
+     */
+    static Vector2 OctahedralEncode(const Vector3& direction);
+    
+    /**
+     * @brief 八面体坐标 [-1, 1]² 解码为单位方向
+     */
+    static Vector3 OctahedralDecode(const Vector2& encoded);
+    
+    /**
+     * @brief 获取帧 (x, y) 的观察方向（从中心指向相机，取网格单元中心）
+     */
+    static Vector3 GetFrameDirection(int frameX, int frameY, int framesPerAxis);
+    
+    /**
+     * @brief 选择最接近给定方向的帧
+     * @param direction 从中心指向相机的局部空间方向
+     * @param[out] frameX 帧列
+     * @param[out] frameY 帧行
+     */
+    static void SelectFrame(const Vector3& direction, int framesPerAxis, int& frameX, int& frameY);
+    
+    /**
+     * @brief 获取帧的屏幕基向量（与 impostor.vert 一致）
+     * @param direction 帧观察方向
+     * @param[out] right 屏幕右方向
+     * @param[out] up 屏幕上方向
+     */
+    static void GetFrameBasis(const Vector3& direction, Vector3& right, Vector3& up);
+    
+    // ==================== 数据访问 ====================
+    
+    [[nodiscard]] bool IsValid() const { return m_atlasSize > 0 && !m_pixels.empty(); }
+    [[nodiscard]] int GetFramesPerAxis() const { return m_framesPerAxis; }
+    [[nodiscard]] int GetAtlasSize() const { return m_atlasSize; }
+    [[nodiscard]] int GetFrameSize() const { return m_framesPerAxis > 0 ? m_atlasSize / m_framesPerAxis : 0; }
+    [[nodiscard]] const Vector3& GetCenter() const { return m_center; }
+    [[nodiscard]] float GetRadius() const { return m_radius; }
+    
+    /**
+     * @brief RGBA8 像素数据（atlasSize × atlasSize × 4）
+     */
+    [[nodiscard]] const std::vector<uint8_t>& GetPixels() const { return m_pixels; }
+    
+    /**
+     * @brief 统计某一帧中不透明像素数
+     */
+    [[nodiscard]] size_t CountFrameCoverage(int frameX, int frameY) const;
+    
+    // ==================== GPU 资源 ====================
+    
+    /**
+     * @brief 创建图集纹理、替身四边形网格和替身材质（必须在 GL 线程调用）
+     * @return 是否成功
+     */
+    bool UploadToGPU();
+    
+    [[nodiscard]] Ref<Texture> GetTexture() const { return m_texture; }
+    [[nodiscard]] Ref<Mesh> GetQuadMesh() const { return m_quadMesh; }
+    [[nodiscard]] Ref<Material> GetMaterial() const { return m_material; }
+    
+    /**
+     * @brief 将替身写入 LOD 配置
+     * 
+     * 设置 impostorMesh / impostorMaterial，并把第 5 个距离阈值设为 impostorEndDistance
+     * （LOD3 阈值到该距离之间使用替身，之后剔除）。需先调用 UploadToGPU()。
+     * 
+     * @param config LOD 配置
+     * @param impostorEndDistance 替身结束距离（不大于 LOD3 阈值时取 LOD3 阈值的 4 倍）
+     * @return 是否成功
+     */
+    bool ConfigureLOD(LODConfig& config, float impostorEndDistance) const;
+    
+private:
+    static bool PrepareBake(const Ref<Mesh>& mesh, const ImpostorBakeOptions& options, ImpostorAtlas& atlas);
+    void DilateFrames(int iterations);
+    
+    int m_framesPerAxis = 0;
+    int m_atlasSize = 0;
+    Vector3 m_center = Vector3::Zero();
+    float m_radius = 0.0f;
+    std::vector<uint8_t> m_pixels;
+    
+    Ref<Texture> m_texture;
+    Ref<Mesh> m_quadMesh;
+    Ref<Material> m_material;
+};
+
+} // namespace Render
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/types.h"
+#include "render/mesh.h"
+#include "render/lod_generator.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief LOD 磁盘缓存
+ * 
+ * 将 LODGenerator 生成的 LOD1-LOD3 网格以紧凑二进制格式写入缓存目录，
+ * 缓存键由源数据哈希（源文件内容或网格数据）与 SimplifyOptions 共同决定。
+ * 读取时通过内存映射直接解析，避免重复简化以及 OBJ 文本解析的开销。
+ * 
+ * **文件格式**（本机字节序，扩展名 .lodc）：
+ * - 文件头：魔数 "RLOD"、版本、缓存键、级别数
+ * - 每个级别：顶点数、索引数、几何误差、数据偏移
+ * - 数据区：顶点（每顶点 18 个 float）与 uint32 索引
+ * 
+ * **使用示例**：
+ * @code
+ * auto& cache = LODCache::GetInstance();
+ * cache.SetCacheDirectory("cache/lod");
+ * 
+ * uint64_t key = LODCache::BuildKey(LODCache::HashFile("models/tree.obj"), options);
+ * std::vector<Ref<Mesh>> lods;
+ * std::vector<float> errors;
+ * if (!cache.Load(key, lods, errors)) {
+ *     lods = LODGenerator::GenerateLODLevels(sourceMesh, options, &errors);
+ *     cache.Store(key, lods, errors);
+ * }
+ * @endcode
+ * 
+ * @note 从缓存加载的网格未上传到 GPU，需在主线程调用 Mesh::Upload()
+ * @note 线程安全：Load/Store 可在任意线程调用；同一键的并发写入通过临时文件 + 重命名保证原子性
+ */
+class LODCache {
+public:
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats {
+        size_t hits = 0;      ///< 命中次数
+        size_t misses = 0;    ///< 未命中次数
+        size_t writes = 0;    ///< 成功写入次数
+    };
+    
+    static LODCache& GetInstance();
+    
+    /**
+     * @brief 设置缓存目录（默认 "cache/lod"，不存在时在首次写入时创建）
+     */
+    void SetCacheDirectory(const std::string& directory);
+    [[nodiscard]] std::string GetCacheDirectory() const;
+    
+    /**
+     * @brief 启用/禁用缓存（禁用时 Load 总是未命中，Store 不写入）
+     */
+    void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 计算文件内容哈希（FNV-1a 64 位）
+     * @return 哈希值，文件无法读取时返回 0
+     */
+    static uint64_t HashFile(const std::string& filepath);
+    
+    /**
+     * @brief 计算网格顶点与索引数据的哈希（用于没有源文件的程序化网格）
+     * @return 哈希值，网格为空时返回 0
+     */
+    static uint64_t HashMesh(const Ref<Mesh>& mesh);
+    
+    /**
+     * @brief 计算 LOD 源数据哈希：文件内容哈希与网格数据哈希的组合
+     * 
+     * 同一文件的不同子网格、以及加载后被修改过的网格（顶点缓存优化、紧凑布局等）得到不同的哈希；
+     * filepath 为空或无法读取时只使用网格哈希
+     * @return 哈希值，文件与网格都无法哈希时返回 0
+     */
+    static uint64_t HashSource(const std::string& filepath, const Ref<Mesh>& mesh);
+    
+    /**
+     * @brief 计算影响简化结果的 SimplifyOptions 字段哈希
+     * 
+     * uploadToGPU 不影响生成结果，不参与计算
+     */
+    static uint64_t HashOptions(const LODGenerator::SimplifyOptions& options);
+    
+    /**
+     * @brief 组合源数据哈希与简化选项得到缓存键
+     */
+    static uint64_t BuildKey(uint64_t sourceHash, const LODGenerator::SimplifyOptions& options);
+    
+    /**
+     * @brief 获取缓存键对应的文件路径
+     */
+    [[nodiscard]] std::string GetCachePath(uint64_t key) const;
+    
+    /**
+     * @brief 从缓存加载 LOD 网格
+     * @param key 缓存键
+     * @param outLODMeshes 输出 [LOD1, LOD2, LOD3]（生成失败的级别为 nullptr）
+     * @param outGeometricErrors 输出对应几何误差（失败的级别为 -1）
+     * @return 命中且数据有效返回 true
+     */
+    bool Load(uint64_t key,
+              std::vector<Ref<Mesh>>& outLODMeshes,
+              std::vector<float>& outGeometricErrors);
+    
+    /**
+     * @brief 写入缓存
+     * @param key 缓存键
+     * @param lodMeshes [LOD1, LOD2, LOD3]
+     * @param geometricErrors 对应几何误差（可为空，视为未知）
+     * @return 写入成功返回 true
+     */
+    bool Store(uint64_t key,
+               const std::vector<Ref<Mesh>>& lodMeshes,
+               const std::vector<float>& geometricErrors);
+    
+    /**
+     * @brief 删除缓存目录下所有 .lodc 文件
+     * @return 删除的文件数
+     */
+    size_t ClearDiskCache();
+    
+    [[nodiscard]] Stats GetStats() const;
+    void ResetStats();
+
+private:
+    LODCache() = default;
+    ~LODCache() = default;
+    LODCache(const LODCache&) = delete;
+    LODCache& operator=(const LODCache&) = delete;
+    
+    mutable std::mutex m_directoryMutex;
+    std::string m_directory = "cache/lod";
+    std::atomic<bool> m_enabled{true};
+    
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+    std::atomic<size_t> m_writes{0};
+};
+
+} // namespace Render
@@ -33,6 +33,83 @@ struct meshopt_Stream;
 
 namespace Render {
 
+/**
+ * @brief LOD 简化配置
+ * 
+ * 定义在命名空间作用域（通过 LODGenerator::SimplifyOptions 访问），
+ * 以便 LODGenerator 的默认参数可以使用 SimplifyOptions{}，其他头文件也可以前向声明
+ */
+struct LODSimplifyOptions {
+    /**
+     * @brief 简化模式
+     */
+    enum class Mode {
+        TargetTriangleCount,  ///< 目标三角形数量（推荐）
+        TargetError          ///< 目标误差（相对网格范围）
+    };
+    
+    Mode mode = Mode::TargetTriangleCount;
+    
+    /**
+     * @brief 目标三角形数量（用于 TargetTriangleCount 模式）
+     * 
+     * LOD1: 通常保留 50-70% 的三角形
+     * LOD2: 通常保留 20-40% 的三角形
+     * LOD3: 通常保留 10-20% 的三角形
+     * 
+     * 如果某个级别为 0，表示自动计算（使用默认比例）
+     */
+    struct TriangleCounts {
+        size_t lod1 = 0;  ///< LOD1 目标三角形数量（0 = 自动，默认 50%）
+        size_t lod2 = 0;  ///< LOD2 目标三角形数量（0 = 自动，默认 25%）
+        size_t lod3 = 0;  ///< LOD3 目标三角形数量（0 = 自动，默认 10%）
+    } triangleCounts;
+    
+    /**
+     * @brief 目标误差（用于 TargetError 模式，范围 [0..1]）
+     * 
+     * 例如：0.01 = 1% 变形误差
+     */
+    struct TargetErrors {
+        float lod1 = 0.01f;  ///< LOD1 目标误差（1%）
+        float lod2 = 0.03f;  ///< LOD2 目标误差（3%）
+        float lod3 = 0.05f;  ///< LOD3 目标误差（5%）
+    } targetErrors;
+    
+    /**
+     * @brief 简化选项标志
+     */
+    enum SimplifyFlags {
+        LockBorder = 1 << 0,      ///< 锁定边界顶点（不移动）
+        Sparse = 1 << 1,          ///< 稀疏简化（更快但质量稍低）
+        Regularize = 1 << 2,      ///< 正则化（更平滑）
+        Permissive = 1 << 3       ///< 允许跨属性不连续边折叠
+    };
+    
+    unsigned int flags = 0;  ///< 标志位组合
+    
+    /**
+     * @brief 属性权重（用于保留顶点属性）
+     */
+    struct AttributeWeights {
+        float normal = 1.0f;      ///< 法线权重
+        float texCoord = 1.0f;    ///< 纹理坐标权重
+        float color = 0.5f;       ///< 颜色权重（通常较低）
+    } attributeWeights;
+    
+    bool recalculateNormals = true;    ///< 是否重新计算法线（简化后）
+    bool recalculateTangents = false;  ///< 是否重新计算切线（简化后）
+    bool optimizeMesh = true;          ///< 是否对简化结果做顶点缓存 / overdraw / 顶点获取优化（MeshOptimizer）
+    
+    /**
+     * @brief 生成后是否立即上传到 GPU
+     * 
+     * 在后台线程生成时必须为 false（OpenGL 调用只能在主线程进行），
+     * 由主线程稍后调用 Mesh::Upload()。该字段不参与 LOD 缓存键计算。
+     */
+    bool uploadToGPU = true;
+};
+
 /**
  * @brief LOD 网格生成器
  * 
@@ -51,70 +128,7 @@ namespace Render {
  */
 class LODGenerator {
 public:
-    /**
-     * @brief LOD 简化配置
-     */
-    struct SimplifyOptions {
-        /**
-         * @brief 简化模式
-         */
-        enum class Mode {
-            TargetTriangleCount,  ///< 目标三角形数量（推荐）
-            TargetError          ///< 目标误差（相对网格范围）
-        };
-        
-        Mode mode = Mode::TargetTriangleCount;
-        
-        /**
-         * @brief 目标三角形数量（用于 TargetTriangleCount 模式）
-         * 
-         * LOD1: 通常保留 50-70% 的三角形
-         * LOD2: 通常保留 20-40% 的三角形
-         * LOD3: 通常保留 10-20% 的三角形
-         * 
-         * 如果某个级别为 0，表示自动计算（使用默认比例）
-         */
-        struct TriangleCounts {
-            size_t lod1 = 0;  ///< LOD1 目标三角形数量（0 = 自动，默认 50%）
-            size_t lod2 = 0;  ///< LOD2 目标三角形数量（0 = 自动，默认 25%）
-            size_t lod3 = 0;  ///< LOD3 目标三角形数量（0 = 自动，默认 10%）
-        } triangleCounts;
-        
-        /**
-         * @brief 目标误差（用于 TargetError 模式，范围 [0..1]）
-         * 
-         * 例如：0.01 = 1% 变形误差
-         */
-        struct TargetErrors {
-            float lod1 = 0.01f;  ///< LOD1 目标误差（1%）
-            float lod2 = 0.03f;  ///< LOD2 目标误差（3%）
-            float lod3 = 0.05f;  ///< LOD3 目标误差（5%）
-        } targetErrors;
-        
-        /**
-         * @brief 简化选项标志
-         */
-        enum SimplifyFlags {
-            LockBorder = 1 << 0,      ///< 锁定边界顶点（不移动）
-            Sparse = 1 << 1,          ///< 稀疏简化（更快但质量稍低）
-            Regularize = 1 << 2,      ///< 正则化（更平滑）
-            Permissive = 1 << 3       ///< 允许跨属性不连续边折叠
-        };
-        
-        unsigned int flags = 0;  ///< 标志位组合
-        
-        /**
-         * @brief 属性权重（用于保留顶点属性）
-         */
-        struct AttributeWeights {
-            float normal = 1.0f;      ///< 法线权重
-            float texCoord = 1.0f;    ///< 纹理坐标权重
-            float color = 0.5f;       ///< 颜色权重（通常较低）
-        } attributeWeights;
-        
-        bool recalculateNormals = true;    ///< 是否重新计算法线（简化后）
-        bool recalculateTangents = false;  ///< 是否重新计算切线（简化后）
-    };
+    using SimplifyOptions = LODSimplifyOptions;
     
     /**
      * @brief 生成单个网格的 LOD 级别
@@ -123,6 +137,7 @@ public:
      * 
      * @param sourceMesh 源网格（LOD0）
      * @param options 简化选项
+     * @param outGeometricErrors 可选输出：各级别的几何误差 [LOD1, LOD2, LOD3]（网格局部空间单位，失败的级别为 -1）
      * @return std::vector<Ref<Mesh>> LOD 网格数组 [LOD1, LOD2, LOD3]
      * 
      * @note 如果某个级别简化失败，对应位置为 nullptr
@@ -143,7 +158,8 @@ public:
      */
     static std::vector<Ref<Mesh>> GenerateLODLevels(
         Ref<Mesh> sourceMesh,
-        const SimplifyOptions& options = SimplifyOptions{}
+        const SimplifyOptions& options = SimplifyOptions{},
+        std::vector<float>* outGeometricErrors = nullptr
     );
     
     /**
@@ -152,6 +168,8 @@ public:
      * @param sourceMesh 源网格
      * @param lodLevel 目标 LOD 级别（1, 2, 或 3）
      * @param options 简化选项
+     * @param outGeometricError 可选输出：简化后的几何误差（网格局部空间单位，由 meshoptimizer 的相对误差
+     *                          乘以网格尺度得到；未简化时为 0，失败时为 -1）
      * @return Ref<Mesh> 简化后的网格，失败返回 nullptr
      * 
      * @note 返回的网格已经调用 Upload()，可以直接使用
@@ -168,13 +186,16 @@ public:
     static Ref<Mesh> GenerateLODLevel(
         Ref<Mesh> sourceMesh,
         int lodLevel,
-        const SimplifyOptions& options = SimplifyOptions{}
+        const SimplifyOptions& options = SimplifyOptions{},
+        float* outGeometricError = nullptr
     );
     
     /**
      * @brief 自动配置 LODConfig
      * 
-     * 从源网格生成所有 LOD 级别并自动配置到 LODConfig
+     * 从源网格生成所有 LOD 级别并自动配置到 LODConfig：
+     * config.lodMeshes 为 [源网格, LOD1, LOD2, LOD3]（索引与 LOD 级别一致），
+     * config.lodGeometricErrors 为对应的几何误差（供 useScreenSpaceError 使用）
      * 
      * @param sourceMesh 源网格
      * @param config 要配置的 LODConfig（会被修改）
@@ -189,7 +210,7 @@ public:
      * config.distanceThresholds = {50.0f, 150.0f, 500.0f, 1000.0f};
      * 
      * if (LODGenerator::AutoConfigureLOD(sourceMesh, config)) {
-     *     // config.lodMeshes 已经包含了 LOD1-LOD3 的网格
+     *     // config.lodMeshes 已经包含了 LOD0-LOD3 的网格
      *     LODComponent lodComp;
      *     lodComp.config = config;
      *     world->AddComponent<LODComponent>(entity, lodComp);
@@ -209,7 +230,9 @@ public:
      * @param options 简化选项
      * @return std::vector<std::vector<Ref<Mesh>>> 每个网格的 LOD 级别数组
      * 
-     * @note 返回的网格已经调用 Upload()，可以直接使用
+     * @note 返回的网格已经调用 Upload()，可以直接使用（options.uploadToGPU = false 时除外）
+     * @note TaskScheduler 已初始化时各网格在工作线程并行简化，本函数阻塞等待，
+     *       因此不要在 TaskScheduler 工作线程中调用
      * 
      * **使用示例**：
      * @code
@@ -580,7 +603,8 @@ private:
     static Ref<Mesh> SimplifyMeshInternal(
         Ref<Mesh> sourceMesh,
         int lodLevel,
-        const SimplifyOptions& options
+        const SimplifyOptions& options,
+        float* outGeometricError = nullptr
     );
 };
 
@@ -96,6 +96,145 @@ struct InstanceData {
     {}
 };
 
+/**
+ * @brief 紧凑实例记录（64 字节，恰好一个缓存行）
+ * 
+ * 并行收集路径（InstanceGatherBucket）使用：只保存世界矩阵的前三行和打包颜色，
+ * 上传时展开为与 InstanceData 相同的 GPU 布局（mat4 + vec4 颜色 + vec4 参数，参数为 0）
+ */
+struct alignas(64) CompactInstanceData {
+    float rows[3][4];           ///< 世界矩阵前三行（行主序，第 4 列为平移），第 4 行固定为 (0, 0, 0, 1)
+    uint32_t packedColor;       ///< RGBA8 颜色（R 位于最低字节）
+    uint32_t entityIndex;       ///< 实体索引（用于调试）
+    uint32_t padding[2];        ///< 填充到 64 字节
+    
+    /**
+     * @brief 默认构造函数（不初始化成员，批量 resize 时不产生额外写入）
+     */
+    CompactInstanceData() {}
+    
+    /**
+     * @brief 使用矩阵构造
+     * @param matrix 世界变换矩阵（仿射）
+     * @param color 打包颜色（见 PackColor）
+     * @param entity 实体索引
+     */
+    CompactInstanceData(const Matrix4& matrix, uint32_t color, uint32_t entity)
+        : packedColor(color)
+        , entityIndex(entity)
+        , padding{0, 0}
+    {
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                rows[r][c] = matrix(r, c);
+            }
+        }
+    }
+    
+    /**
+     * @brief 展开为 4x4 矩阵
+     */
+    [[nodiscard]] Matrix4 ToMatrix4() const {
+        Matrix4 matrix;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                matrix(r, c) = rows[r][c];
+            }
+        }
+        matrix.row(3) << 0.0f, 0.0f, 0.0f, 1.0f;
+        return matrix;
+    }
+    
+    /**
+     * @brief 将颜色打包为 RGBA8
+     */
+    [[nodiscard]] static uint32_t PackColor(const Color& color) {
+        auto toByte = [](float v) {
+            return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+        };
+        return toByte(color.r) | (toByte(color.g) << 8) | (toByte(color.b) << 16) | (toByte(color.a) << 24);
+    }
+    
+    /**
+     * @brief 解包 RGBA8 颜色
+     */
+    [[nodiscard]] static Vector4 UnpackColor(uint32_t packed) {
+        constexpr float kInv255 = 1.0f / 255.0f;
+        return Vector4(static_cast<float>(packed & 0xFFu) * kInv255,
+                       static_cast<float>((packed >> 8) & 0xFFu) * kInv255,
+                       static_cast<float>((packed >> 16) & 0xFFu) * kInv255,
+                       static_cast<float>(packed >> 24) * kInv255);
+    }
+};
+
+static_assert(sizeof(CompactInstanceData) == 64, "CompactInstanceData must be 64 bytes");
+
+/**
+ * @brief 单个线程的实例收集桶
+ * 
+ * 按组索引（LODInstancedRenderer::RegisterGatherGroup 返回）保存紧凑实例记录。
+ * 每个桶只能由一个线程写入，因此追加不需要任何同步；桶按缓存行对齐，避免线程间伪共享。
+ * 桶的内存在帧间复用，稳定后追加不再分配。
+ */
+class alignas(64) InstanceGatherBucket {
+public:
+    static constexpr uint32_t kInvalidGroup = 0xFFFFFFFFu;
+    
+    /**
+     * @brief 追加实例
+     * @param groupIndex 组索引（kInvalidGroup 时忽略）
+     * @param worldMatrix 世界变换矩阵
+     * @param packedColor 打包颜色（默认白色）
+     * @param entityIndex 实体索引
+     */
+    void Append(uint32_t groupIndex, const Matrix4& worldMatrix,
+                uint32_t packedColor = 0xFFFFFFFFu, uint32_t entityIndex = 0) {
+        if (groupIndex == kInvalidGroup) {
+            return;
+        }
+        if (groupIndex >= m_records.size()) {
+            m_records.resize(groupIndex + 1);
+        }
+        m_records[groupIndex].emplace_back(worldMatrix, packedColor, entityIndex);
+        m_instanceCount++;
+    }
+    
+    /**
+     * @brief 追加已构建的紧凑记录
+     */
+    void Append(uint32_t groupIndex, const CompactInstanceData& instance) {
+        if (groupIndex == kInvalidGroup) {
+            return;
+        }
+        if (groupIndex >= m_records.size()) {
+            m_records.resize(groupIndex + 1);
+        }
+        m_records[groupIndex].push_back(instance);
+        m_instanceCount++;
+    }
+    
+    /**
+     * @brief 获取本桶收集的实例数
+     */
+    [[nodiscard]] size_t GetInstanceCount() const { return m_instanceCount; }
+    
+private:
+    friend class LODInstancedRenderer;
+    
+    /**
+     * @brief 清空记录（保留容量）
+     */
+    void Reset() {
+        for (auto& records : m_records) {
+            records.clear();
+        }
+        m_instanceCount = 0;
+    }
+    
+    std::vector<std::vector<CompactInstanceData>> m_records;  ///< 按组索引存放的记录
+    size_t m_instanceCount = 0;
+};
+
 /**
  * @brief LOD 实例化渲染组
  * 
@@ -111,6 +250,7 @@ struct LODInstancedGroup {
     // 实例数据
     std::vector<InstanceData> instances;  ///< 所有实例的数据
     std::vector<ECS::EntityID> entities;  ///< 对应的实体 ID（用于调试）
+    std::vector<CompactInstanceData> compactInstances;  ///< 并行收集路径合并的紧凑记录（排在 instances 之后上传）
     
     // ✅ 脏标记系统
     bool isDirty = true;           ///< 数据是否已改变
@@ -121,7 +261,7 @@ struct LODInstancedGroup {
      * @return 实例数量
      */
     [[nodiscard]] size_t GetInstanceCount() const {
-        return instances.size();
+        return instances.size() + compactInstances.size();
     }
     
     /**
@@ -129,7 +269,7 @@ struct LODInstancedGroup {
      * @return 如果为空返回 true
      */
     [[nodiscard]] bool IsEmpty() const {
-        return instances.empty();
+        return instances.empty() && compactInstances.empty();
     }
     
     /**
@@ -138,6 +278,7 @@ struct LODInstancedGroup {
     void Clear() {
         instances.clear();
         entities.clear();
+        compactInstances.clear();
         isDirty = true;  // ✅ 清空后标记为脏
     }
     
@@ -153,7 +294,7 @@ struct LODInstancedGroup {
      * @return 如果需要上传返回 true
      */
     [[nodiscard]] bool NeedsUpload() const {
-        return isDirty || (lastUploadedCount != instances.size());
+        return isDirty || (lastUploadedCount != GetInstanceCount());
     }
     
     /**
@@ -161,7 +302,7 @@ struct LODInstancedGroup {
      */
     void MarkUploaded() {
         isDirty = false;
-        lastUploadedCount = instances.size();
+        lastUploadedCount = GetInstanceCount();
     }
 };
 
@@ -189,6 +330,16 @@ struct LODInstancedGroup {
  * // 渲染所有实例
  * renderer.RenderAll(rendererPtr, renderStatePtr);
  * @endcode
+ * 
+ * **并行收集路径**（大量实例时使用，避免逐实例复制 shared_ptr 和 100+ 字节的 InstanceData）：
+ * @code
+ * uint32_t group = renderer.RegisterGatherGroup(mesh, material, LODLevel::LOD0);  // 主线程
+ * renderer.BeginGather(workerCount);
+ * // 每个工作线程 i 只写入自己的桶
+ * renderer.GetGatherBucket(i).Append(group, worldMatrix);
+ * renderer.EndGather();  // 合并到构建缓冲区（无锁）
+ * renderer.RenderAll(rendererPtr, renderStatePtr);
+ * @endcode
  */
 class LODInstancedRenderer {
 public:
@@ -252,11 +403,55 @@ public:
      */
     void RenderAll(Renderer* renderer, RenderState* renderState = nullptr);
     
+    /**
+     * @brief 处理待处理队列（AddInstance 添加的实例），分组到构建缓冲区
+     * 
+     * RenderAll 开始时会自动调用；每次最多处理 GetMaxInstancesPerFrame() 个实例
+     */
+    void ProcessPendingInstances();
+    
     /**
      * @brief 清空所有组
+     * 
+     * 同时清空收集组注册表，之前返回的组索引失效
      */
     void Clear();
     
+    // ==================== 并行收集路径 ====================
+    
+    /**
+     * @brief 注册收集组（仅主线程，不可与收集并发调用）
+     * 
+     * 相同网格、材质、LOD 级别返回相同索引，索引在 Clear() 之前保持有效
+     * 
+     * @param mesh 网格（已选择 LOD 级别）
+     * @param material 材质
+     * @param lodLevel LOD 级别
+     * @return 组索引；mesh 或 material 为空时返回 InstanceGatherBucket::kInvalidGroup
+     */
+    uint32_t RegisterGatherGroup(Ref<Mesh> mesh, Ref<Material> material, LODLevel lodLevel);
+    
+    /**
+     * @brief 开始收集：准备 bucketCount 个空桶（仅主线程）
+     * @param bucketCount 桶数量（通常等于参与收集的线程/任务数，至少为 1）
+     */
+    void BeginGather(size_t bucketCount);
+    
+    /**
+     * @brief 获取收集桶（每个桶同一时间只能由一个线程写入）
+     * @param bucketIndex 桶索引（小于 BeginGather 的 bucketCount）
+     */
+    InstanceGatherBucket& GetGatherBucket(size_t bucketIndex);
+    
+    /**
+     * @brief 结束收集：将所有桶的记录按组合并到构建缓冲区（仅主线程，在 RenderAll 之前调用）
+     * 
+     * 先计算每个（组，桶）的目标偏移，再并行执行互不重叠的内存拷贝，不使用锁
+     * 
+     * @return 合并的实例数
+     */
+    size_t EndGather();
+    
     /**
      * @brief 获取统计信息
      */
@@ -270,6 +465,7 @@ public:
         size_t lod1Instances = 0;    ///< LOD1 实例数
         size_t lod2Instances = 0;    ///< LOD2 实例数
         size_t lod3Instances = 0;    ///< LOD3 实例数
+        size_t impostorInstances = 0; ///< 替身实例数
         size_t culledCount = 0;      ///< 剔除数量
         
         // ✅ 新增性能指标
@@ -283,6 +479,10 @@ public:
         // ✅ 内存统计
         size_t totalAllocatedMemory = 0;  ///< 总分配内存(bytes)
         size_t peakInstanceCount = 0;     ///< 峰值实例数
+        
+        // ✅ 并行收集路径
+        size_t gatheredInstances = 0;     ///< 最近一次 EndGather 合并的实例数
+        float gatherMergeTimeMs = 0.0f;   ///< 最近一次 EndGather 的耗时(ms)
     };
     
     /**
@@ -448,10 +648,12 @@ private:
      * 包括：变换矩阵、颜色、自定义参数等
      * 
      * @param instances 实例数据列表
+     * @param compactInstances 紧凑实例记录（展开后排在 instances 之后）
      * @param mesh 网格（用于设置实例化属性）
      */
     void UploadInstanceData(
         const std::vector<InstanceData>& instances,
+        const std::vector<CompactInstanceData>& compactInstances,
         Ref<Mesh> mesh
     );
     
@@ -606,6 +808,12 @@ private:
         LODLevel lodLevel;
     };
 
+    // ✅ 并行收集路径
+    std::vector<GroupKey> m_gatherGroupKeys;              ///< 组索引 -> 分组键
+    std::map<GroupKey, uint32_t> m_gatherGroupIndices;    ///< 分组键 -> 组索引
+    std::vector<InstanceGatherBucket> m_gatherBuckets;    ///< 收集桶（帧间复用）
+    size_t m_activeGatherBuckets = 0;                     ///< 当前收集使用的桶数量
+
     // 分批处理队列
     std::deque<PendingInstance> m_pendingInstances;  ///< ✅ 改为deque：待处理的实例队列
     size_t m_maxInstancesPerFrame = 100;              ///< 每帧最大处理实例数（默认100）
@@ -25,6 +25,7 @@
 #include "render/model.h"
 #include "render/lod_system.h"
 #include "render/lod_generator.h"
+#include "render/async_resource_loader.h"
 #include "render/file_utils.h"
 #include "render/logger.h"
 #include <string>
@@ -110,10 +111,19 @@ struct LODLoadOptions {
         /**
          * @brief 是否异步加载
          * 
-         * 当前版本暂不支持异步加载，保留用于未来扩展
+         * 仅对自动生成模式（autoGenerateLOD = true）生效，配合 LODLoader::LoadLODConfigAsync 使用：
+         * 简化在后台线程执行，完成前实体使用 LOD0 渲染
          */
         bool asyncLoad = false;
         
+        /**
+         * @brief 是否使用 LOD 磁盘缓存（见 LODCache）
+         * 
+         * 为 true 时，自动生成的 LOD1-LOD3 以 (源数据哈希, simplifyOptions) 为键写入缓存目录，
+         * 后续运行直接内存映射读取，跳过网格简化
+         */
+        bool useDiskCache = false;
+        
         /**
          * @brief 如果某个 LOD 级别文件不存在，是否使用自动生成作为回退
          * 
@@ -196,6 +206,55 @@ public:
         const LODLoadOptions& options
     );
     
+    /**
+     * @brief 异步加载 LOD 配置
+     * 
+     * 立即返回仅包含 LOD0 的配置（GetLODMesh 对缺失级别回退到 LOD0），
+     * 并在后台生成 LOD1-LOD3。生成完成且上传后，在主线程
+     * （AsyncResourceLoader::ProcessCompletedTasks）中以完整配置调用 onReady。
+     * 
+     * 若 options.autoGenerateLOD 为 false 或 loadStrategy.asyncLoad 为 false，
+     * 退化为同步的 LoadLODConfig 并立即调用 onReady。
+     * 
+     * @param baseMesh 基础网格（LOD0）
+     * @param options 加载选项
+     * @param onReady 完整配置就绪回调（主线程）
+     * @param priority 后台任务优先级
+     * @return LODConfig 初始配置（异步模式下只含 LOD0）
+     * 
+     * **使用示例**：
+     * @code
+     * LODLoadOptions options(mesh);
+     * options.basePath = "models/tree.obj";       // 用于计算源文件哈希
+     * options.loadStrategy.asyncLoad = true;
+     * options.loadStrategy.useDiskCache = true;
+     * 
+     * LODComponent lodComp;
+     * lodComp.config = LODLoader::LoadLODConfigAsync(mesh, options,
+     *     [world, entity](const LODConfig& config) {
+     *         if (world->IsValidEntity(entity) && world->HasComponent<LODComponent>(entity)) {
+     *             auto& lod = world->GetComponent<LODComponent>(entity);
+     *             lod.config.lodMeshes = config.lodMeshes;
+     *             lod.config.lodGeometricErrors = config.lodGeometricErrors;
+     *         }
+     *     });
+     * world->AddComponent<LODComponent>(entity, lodComp);
+     * @endcode
+     */
+    static LODConfig LoadLODConfigAsync(
+        Ref<Mesh> baseMesh,
+        const LODLoadOptions& options,
+        std::function<void(const LODConfig&)> onReady,
+        float priority = 0.0f
+    );
+    
+    /**
+     * @brief 计算 LOD 缓存使用的源数据哈希
+     * 
+     * 网格数据哈希；basePath 指向存在的文件时再与文件内容哈希组合（见 LODCache::HashSource）
+     */
+    static uint64_t ComputeSourceHash(Ref<Mesh> baseMesh, const LODLoadOptions& options);
+    
     /**
      * @brief 从文件加载 LOD 网格
      * 
@@ -220,6 +279,7 @@ public:
      * 
      * @param baseMesh 基础网格（LOD0），必须提供
      * @param options 加载选项（使用 simplifyOptions）
+     * @param outGeometricErrors 可选输出：几何误差 [LOD0, LOD1, LOD2, LOD3]（LOD0 为 0，失败的级别为 -1）
      * @return std::vector<Ref<Mesh>> LOD 网格数组 [LOD0, LOD1, LOD2, LOD3]
      * 
      * @note LOD0 返回 baseMesh（不进行简化）
@@ -227,7 +287,8 @@ public:
      */
     static std::vector<Ref<Mesh>> GenerateLODMeshes(
         Ref<Mesh> baseMesh,
-        const LODLoadOptions& options
+        const LODLoadOptions& options,
+        std::vector<float>* outGeometricErrors = nullptr
     );
     
     /**
@@ -37,6 +37,7 @@
 #include <functional>
 #include <limits>
 #include <map>
+#include <queue>
 
 namespace Render {
 
@@ -62,7 +63,8 @@ enum class LODLevel {
     LOD1 = 1,  ///< 中等细节
     LOD2 = 2,  ///< 低细节
     LOD3 = 3,  ///< 最低细节（最远）
-    Culled = 4 ///< 剔除（超出范围）
+    Impostor = 4, ///< 替身（八面体图集四边形，需配置 impostorMesh/impostorMaterial）
+    Culled = 5 ///< 剔除（超出范围）
 };
 
 /**
@@ -109,6 +111,9 @@ struct LODConfig {
      * - 150 <= 距离 < 500: LOD2
      * - 500 <= 距离 < 1000: LOD3
      * - 距离 >= 1000: Culled
+     * 
+     * 配置了替身（HasImpostor()）时可追加第 5 个阈值，LOD3 之后到该阈值之间使用 Impostor；
+     * 未配置替身时第 5 个及之后的阈值被忽略
      */
     std::vector<float> distanceThresholds{50.0f, 150.0f, 500.0f, 1000.0f};
     
@@ -141,6 +146,20 @@ struct LODConfig {
      */
     std::vector<Ref<Material>> lodMaterials;
     
+    // ==================== 替身（Impostor）====================
+    
+    /**
+     * @brief 替身四边形网格（可选）
+     * 
+     * 由 ImpostorAtlas::UploadToGPU 创建，每个图集独立一份（实例化 VBO 按网格区分）
+     */
+    Ref<Mesh> impostorMesh;
+    
+    /**
+     * @brief 替身材质（可选，使用 impostor 着色器并绑定八面体图集）
+     */
+    Ref<Material> impostorMaterial;
+    
     // ==================== LOD 纹理 ====================
     
     /**
@@ -164,10 +183,26 @@ struct LODConfig {
      * @brief LOD 切换的平滑过渡距离（避免频繁切换）
      * 
      * 单位：世界单位
-     * 例如：transitionDistance = 10.0f 表示距离变化超过 10 单位才切换 LOD
+     * 启用 useHysteresis 时作为默认滞后带宽：例如 transitionDistance = 10.0f 表示
+     * 距离需越过阈值 10 单位后才切换 LOD
      */
     float transitionDistance = 10.0f;
     
+    /**
+     * @brief 是否启用阈值滞后（hysteresis）
+     * 
+     * 启用后，距离仍位于当前级别区间向两侧各扩展滞后带宽后的范围内时保持当前级别，
+     * 避免相机在阈值附近移动时 LOD 来回跳变
+     */
+    bool useHysteresis = false;
+    
+    /**
+     * @brief 每个距离阈值的滞后带宽（可选，与 distanceThresholds 一一对应）
+     * 
+     * 为空或缺少对应项时使用 transitionDistance
+     */
+    std::vector<float> hysteresisBands;
+    
     /**
      * @brief 包围盒缩放因子（用于距离计算，考虑对象大小）
      * 
@@ -217,9 +252,49 @@ struct LODConfig {
      * 默认值：2（降低2级）
      */
     int frustumOutLODReduction = 2;
-    
+
+    // ==================== 屏幕空间误差 ====================
+
+    /**
+     * @brief 每个 LOD 级别的几何误差（网格局部空间单位，可选）
+     *
+     * 索引对应 LOD 级别：0=LOD0, 1=LOD1, 2=LOD2, 3=LOD3，LOD0 通常为 0。
+     * 由 LODGenerator::AutoConfigureLOD / LODLoader::LoadLODConfig（自动生成模式）填充；
+     * 缺少对应项或值小于 0 表示该级别误差未知，不参与屏幕空间误差选择
+     */
+    std::vector<float> lodGeometricErrors;
+
+    /**
+     * @brief 是否按屏幕空间误差选择 LOD
+     *
+     * 启用后将各级别的几何误差按相机视场角和视口高度投影为像素，选择误差不超过
+     * maxScreenSpaceError 的最粗级别；距离阈值仅用于判定 Culled。
+     * 需要 LODSelectionOptions 提供视场角和视口高度，否则回退到距离阈值
+     */
+    bool useScreenSpaceError = false;
+
+    /**
+     * @brief 屏幕空间误差容差（像素）
+     */
+    float maxScreenSpaceError = 1.0f;
+
     // ==================== 辅助方法 ====================
     
+    /**
+     * @brief 是否配置了替身级别
+     */
+    [[nodiscard]] bool HasImpostor() const {
+        return impostorMesh && impostorMaterial;
+    }
+    
+    /**
+     * @brief 距离阈值可划分的级别数（LOD0-LOD3，配置替身时再加 Impostor）
+     */
+    [[nodiscard]] size_t GetDistanceLevelCount() const {
+        const size_t levelCount = HasImpostor() ? 5 : 4;
+        return std::min(distanceThresholds.size(), levelCount);
+    }
+    
     /**
      * @brief 根据距离计算 LOD 级别
      * @param distance 到相机的距离（世界单位）
@@ -230,7 +305,8 @@ struct LODConfig {
             return LODLevel::LOD0;
         }
         
-        for (size_t i = 0; i < distanceThresholds.size(); ++i) {
+        const size_t levelCount = GetDistanceLevelCount();
+        for (size_t i = 0; i < levelCount; ++i) {
             if (distance < distanceThresholds[i]) {
                 return static_cast<LODLevel>(i);
             }
@@ -238,13 +314,113 @@ struct LODConfig {
         return LODLevel::Culled;
     }
     
+    /**
+     * @brief 获取距离阈值的滞后带宽
+     * @param thresholdIndex 阈值下标
+     * @return 带宽（世界单位，非负）
+     */
+    [[nodiscard]] float GetHysteresisBand(size_t thresholdIndex) const {
+        if (thresholdIndex < hysteresisBands.size()) {
+            return std::max(0.0f, hysteresisBands[thresholdIndex]);
+        }
+        return std::max(0.0f, transitionDistance);
+    }
+    
+    /**
+     * @brief 根据距离和当前 LOD 级别计算 LOD 级别（带滞后）
+     * 
+     * 当前级别的距离区间向两侧各扩展对应阈值的滞后带宽，距离仍在扩展后的区间内时保持当前级别，
+     * 否则返回 CalculateLOD(distance)。未启用 useHysteresis 时等同于 CalculateLOD(distance)。
+     * 
+     * @param distance 到相机的距离（世界单位）
+     * @param currentLOD 当前 LOD 级别
+     * @return LOD 级别
+     */
+    [[nodiscard]] LODLevel CalculateLOD(float distance, LODLevel currentLOD) const {
+        const LODLevel target = CalculateLOD(distance);
+        if (!enabled || !useHysteresis || target == currentLOD) {
+            return target;
+        }
+        
+        // 当前级别在阈值表中的区间下标（Culled 对应最后一个有效阈值之后）
+        const size_t thresholdCount = GetDistanceLevelCount();
+        if (currentLOD == LODLevel::Impostor && !HasImpostor()) {
+            return target;
+        }
+        const size_t slot = (currentLOD == LODLevel::Culled) ? thresholdCount : static_cast<size_t>(currentLOD);
+        if (slot > thresholdCount) {
+            // 阈值少于 4 个时可能出现无对应区间的级别（例如视锥体外降级得到的 LOD3）
+            return target;
+        }
+        
+        const float lower = (slot == 0)
+            ? -std::numeric_limits<float>::infinity()
+            : distanceThresholds[slot - 1] - GetHysteresisBand(slot - 1);
+        const float upper = (slot < thresholdCount)
+            ? distanceThresholds[slot] + GetHysteresisBand(slot)
+            : std::numeric_limits<float>::infinity();
+        
+        return (distance >= lower && distance < upper) ? currentLOD : target;
+    }
+
+    /**
+     * @brief 获取指定 LOD 级别的几何误差
+     * @param level LOD 级别
+     * @return 几何误差（网格局部空间单位）；未知时返回 -1
+     */
+    [[nodiscard]] float GetLODGeometricError(LODLevel level) const {
+        const size_t index = static_cast<size_t>(level);
+        if (level >= LODLevel::Impostor || index >= lodGeometricErrors.size()) {
+            return -1.0f;
+        }
+        return lodGeometricErrors[index];
+    }
+
+    /**
+     * @brief 根据屏幕空间误差计算 LOD 级别
+     *
+     * 像素误差 = 几何误差 × errorToPixelScale / 距离。从 LOD3 向 LOD0 查找第一个配置了网格、
+     * 误差已知且像素误差不超过 maxScreenSpaceError 的级别；都不满足时返回 LOD0。
+     * 距离超过最后一个阈值时仍返回 Culled，落在替身区间时仍返回 Impostor。
+     *
+     * @param distance 到相机的距离（世界单位）
+     * @param errorToPixelScale 局部空间误差到像素的比例（视口高度 / (2·tan(fovY/2)) × 实体最大缩放）
+     * @return LOD 级别
+     */
+    [[nodiscard]] LODLevel CalculateLODFromScreenError(float distance, float errorToPixelScale) const {
+        if (!enabled) {
+            return LODLevel::LOD0;
+        }
+        const LODLevel distanceLOD = CalculateLOD(distance);
+        if (distanceLOD == LODLevel::Culled || distanceLOD == LODLevel::Impostor) {
+            return distanceLOD;
+        }
+
+        const float pixelsPerUnit = errorToPixelScale / std::max(distance, 1e-3f);
+        for (int level = static_cast<int>(LODLevel::LOD3); level > 0; --level) {
+            const size_t index = static_cast<size_t>(level);
+            if (index >= lodMeshes.size() || !lodMeshes[index]) {
+                continue;
+            }
+            const float error = GetLODGeometricError(static_cast<LODLevel>(level));
+            if (error >= 0.0f && error * pixelsPerUnit <= maxScreenSpaceError) {
+                return static_cast<LODLevel>(level);
+            }
+        }
+        return LODLevel::LOD0;
+    }
+
     /**
      * @brief 获取指定 LOD 级别的网格
      * @param level LOD 级别
      * @param defaultMesh 默认网格（LOD0 或未配置时使用）
-     * @return 网格指针
+     * @return 网格指针（Impostor 级别返回替身四边形，未配置时回退到 LOD3）
      */
     [[nodiscard]] Ref<Mesh> GetLODMesh(LODLevel level, Ref<Mesh> defaultMesh) const {
+        if (level == LODLevel::Impostor) {
+            return impostorMesh ? impostorMesh : GetLODMesh(LODLevel::LOD3, defaultMesh);
+        }
+        
         if (lodMeshes.empty()) {
             return defaultMesh;
         }
@@ -278,9 +454,13 @@ struct LODConfig {
      * @brief 获取指定 LOD 级别的材质
      * @param level LOD 级别
      * @param defaultMaterial 默认材质（LOD0 或未配置时使用）
-     * @return 材质指针
+     * @return 材质指针（Impostor 级别返回替身材质，未配置时回退到 LOD3）
      */
     [[nodiscard]] Ref<Material> GetLODMaterial(LODLevel level, Ref<Material> defaultMaterial) const {
+        if (level == LODLevel::Impostor) {
+            return impostorMaterial ? impostorMaterial : GetLODMaterial(LODLevel::LOD3, defaultMaterial);
+        }
+        
         if (lodMaterials.empty()) {
             return defaultMaterial;
         }
@@ -305,7 +485,8 @@ struct LODConfig {
             return;
         }
         
-        if (!material) {
+        // 替身材质只采样图集
+        if (!material || level == LODLevel::Impostor) {
             return;
         }
         
@@ -453,6 +634,7 @@ struct LODComponent {
             case LODLevel::LOD1: return "LOD1";
             case LODLevel::LOD2: return "LOD2";
             case LODLevel::LOD3: return "LOD3";
+            case LODLevel::Impostor: return "Impostor";
             case LODLevel::Culled: return "Culled";
             default: return "Unknown";
         }
@@ -461,6 +643,57 @@ struct LODComponent {
 
 } // namespace ECS
 
+/**
+ * @brief LOD 选择参数
+ * 
+ * 控制 LODSelector 每帧的计算量：远处实体分帧轮流更新，或按全局三角形预算选择 LOD
+ */
+struct LODSelectionOptions {
+    /**
+     * @brief 远处实体的重新计算间隔（帧）
+     * 
+     * 上次计算的距离不小于 nearUpdateDistance 的实体按实体索引轮流，每 farUpdateInterval 帧重新计算一次；
+     * 1 表示每帧计算所有实体
+     */
+    uint32_t farUpdateInterval = 1;
+    
+    /**
+     * @brief 每帧更新的距离范围（世界单位）
+     */
+    float nearUpdateDistance = 50.0f;
+    
+    /**
+     * @brief 全局三角形预算（0 表示不启用）
+     * 
+     * 启用后忽略距离阈值对 LOD0-LOD3 的划分（仍用于判定 Culled），按屏幕空间误差为所有实体
+     * 选择 LOD，使总三角形数不超过预算
+     */
+    size_t triangleBudget = 0;
+    
+    /**
+     * @brief 相机垂直视场角（度），用于 LODConfig::useScreenSpaceError
+     */
+    float fovYDegrees = 0.0f;
+    
+    /**
+     * @brief 视口高度（像素），用于 LODConfig::useScreenSpaceError
+     * 
+     * fovYDegrees 或 viewportHeight 不大于 0 时，启用屏幕空间误差的实体回退到距离阈值
+     */
+    float viewportHeight = 0.0f;
+};
+
+/**
+ * @brief LOD 选择统计（每次调用累加）
+ */
+struct LODSelectionStats {
+    size_t evaluated = 0;           ///< 重新计算 LOD 的实体数
+    size_t deferred = 0;            ///< 因分帧更新沿用上次结果的实体数
+    size_t switches = 0;            ///< LOD 级别发生变化的实体数
+    size_t triangleBudget = 0;      ///< 三角形预算（0 表示未启用）
+    size_t selectedTriangles = 0;   ///< 预算模式下所选 LOD 的三角形总数
+};
+
 /**
  * @brief LOD 选择器
  * 
@@ -523,6 +756,38 @@ public:
         return std::max(0.0f, adjustedDistance);
     }
     
+    /**
+     * @brief 计算单位几何误差在单位距离处的像素大小
+     * @param fovYDegrees 垂直视场角（度）
+     * @param viewportHeight 视口高度（像素）
+     * @return viewportHeight / (2·tan(fovY/2))；参数无效时返回 0
+     */
+    [[nodiscard]] static float CalculateErrorToPixelScale(float fovYDegrees, float viewportHeight) {
+        if (fovYDegrees <= 0.0f || fovYDegrees >= 180.0f || viewportHeight <= 0.0f) {
+            return 0.0f;
+        }
+        const float halfFovRadians = fovYDegrees * 0.5f * 3.14159265358979f / 180.0f;
+        return viewportHeight / (2.0f * std::tan(halfFovRadians));
+    }
+    
+    /**
+     * @brief 将几何误差投影为屏幕像素
+     * @param geometricError 世界空间几何误差
+     * @param distance 到相机的距离（世界单位）
+     * @param fovYDegrees 垂直视场角（度）
+     * @param viewportHeight 视口高度（像素）
+     * @return 像素误差
+     */
+    [[nodiscard]] static float ProjectErrorToPixels(
+        float geometricError,
+        float distance,
+        float fovYDegrees,
+        float viewportHeight
+    ) {
+        return geometricError * CalculateErrorToPixelScale(fovYDegrees, viewportHeight) /
+               std::max(distance, 1e-3f);
+    }
+    
     /**
      * @brief 批量计算 LOD 级别
      * 
@@ -532,22 +797,30 @@ public:
      * @param entities 实体列表（应该已经包含 LODComponent 和 TransformComponent）
      * @param world ECS World 对象指针
      * @param cameraPosition 相机世界位置
-     * @param frameId 当前帧 ID（用于避免重复计算）
+     * @param frameId 当前帧 ID（用于分帧轮流更新）
+     * @param options 选择参数（使用 farUpdateInterval / nearUpdateDistance / fovYDegrees / viewportHeight，
+     *                预算模式见 SelectLODWithTriangleBudget）
+     * @param stats 可选的统计输出
      * 
      * @note 此方法会修改实体的 LODComponent，更新 currentLOD 和统计信息
      * @note 如果实体没有 LODComponent 或 TransformComponent，会被跳过
-     * @note 使用 transitionDistance 实现平滑过渡，避免频繁切换
+     * @note config.useHysteresis 启用时按滞后带宽切换，避免在阈值附近频繁切换
+     * @note config.useScreenSpaceError 启用且 options 提供视场角和视口高度时按屏幕空间误差选择（不使用滞后）
      */
     static void BatchCalculateLOD(
         const std::vector<ECS::EntityID>& entities,
         ECS::World* world,
         const Vector3& cameraPosition,
-        uint64_t frameId
+        uint64_t frameId,
+        const LODSelectionOptions& options = LODSelectionOptions{},
+        LODSelectionStats* stats = nullptr
     ) {
         if (!world) {
             return;
         }
         
+        const float errorToPixelScale = CalculateErrorToPixelScale(options.fovYDegrees, options.viewportHeight);
+        
         for (ECS::EntityID entity : entities) {
             // 检查是否有 LOD 组件
             if (!world->HasComponent<ECS::LODComponent>(entity)) {
@@ -569,22 +842,40 @@ public:
                 continue;
             }
             
+            // 第一次计算时（lastDistance为0），直接更新LOD级别
+            bool isFirstUpdate = (lodComp.lastDistance == 0.0f);
+            
+            // 分帧更新：远处实体沿用上次结果，按实体索引轮流重新计算
+            if (!isFirstUpdate && !ShouldEvaluate(entity, lodComp, options, frameId)) {
+                if (stats) {
+                    stats->deferred++;
+                }
+                continue;
+            }
+            
             // ✅ 计算距离：使用与远距离剔除相同的位置获取方式
             // 使用 GetPosition() 获取位置（与远距离剔除的 ShouldCull 保持一致）
             // 这样可以确保距离计算与远距离剔除使用相同的坐标系统
             Vector3 entityPos = transformComp.GetPosition();
             float distance = CalculateDistance(entityPos, cameraPosition);
             
-            // 计算 LOD 级别
-            LODLevel newLOD = lodComp.config.CalculateLOD(distance);
-            
-            // ✅ 平滑过渡：避免频繁切换（与远距离剔除的实时性保持一致）
-            // 第一次计算时（lastDistance为0），直接更新LOD级别
-            bool isFirstUpdate = (lodComp.lastDistance == 0.0f);
+            // 计算 LOD 级别（屏幕空间误差优先；距离阈值模式启用滞后时在阈值附近保持当前级别）
+            LODLevel newLOD;
+            if (lodComp.config.useScreenSpaceError && errorToPixelScale > 0.0f) {
+                // 几何误差为网格局部空间单位，按实体最大缩放换算到世界空间
+                const Vector3 scale = transformComp.transform->GetWorldScale().cwiseAbs();
+                const float maxScale = std::max({scale.x(), scale.y(), scale.z()});
+                newLOD = lodComp.config.CalculateLODFromScreenError(distance, errorToPixelScale * maxScale);
+            } else {
+                newLOD = lodComp.config.CalculateLOD(distance, lodComp.currentLOD);
+            }
             
             // ✅ 强制更新逻辑：第一次更新时总是更新，后续更新直接切换
-            // 如果newLOD与currentLOD不同，说明距离已经跨过了阈值，应该立即切换
+            // 如果newLOD与currentLOD不同，说明距离已经跨过了阈值（及滞后带宽），应该立即切换
             if (isFirstUpdate || newLOD != lodComp.currentLOD) {
+                if (stats && newLOD != lodComp.currentLOD) {
+                    stats->switches++;
+                }
                 lodComp.currentLOD = newLOD;
                 lodComp.lodSwitchCount++;
                 lodComp.lastLOD = lodComp.currentLOD;
@@ -592,6 +883,158 @@ public:
             
             lodComp.lastDistance = distance;
             lodComp.lastUpdateFrame = frameId;
+            if (stats) {
+                stats->evaluated++;
+            }
+        }
+    }
+    
+    /**
+     * @brief 按全局三角形预算选择 LOD（屏幕空间误差驱动）
+     * 
+     * 所有参与的实体先取 LOD3，然后反复细化当前屏幕空间误差最大的实体
+     * （误差 = 包围球半径 / 距离 × 2^LOD 级别），直到无法在预算内继续细化。
+     * 距离超过最后一个阈值的实体仍为 Culled；提供视锥体时，视锥体外的实体固定为 LOD3 且不计入预算。
+     * 三角形数取自 MeshRenderComponent 的网格及 LODConfig::lodMeshes。
+     * 
+     * @param entities 实体列表（需包含 LODComponent、TransformComponent、MeshRenderComponent，否则跳过）
+     * @param world ECS World 对象指针
+     * @param cameraPosition 相机世界位置
+     * @param frameId 当前帧 ID
+     * @param triangleBudget 三角形预算
+     * @param frustum 可选的视锥体
+     * @param stats 可选的统计输出
+     * 
+     * @note 预算小于所有实体 LOD3 的三角形总数时，所有实体保持 LOD3
+     */
+    static void SelectLODWithTriangleBudget(
+        const std::vector<ECS::EntityID>& entities,
+        ECS::World* world,
+        const Vector3& cameraPosition,
+        uint64_t frameId,
+        size_t triangleBudget,
+        const Frustum* frustum = nullptr,
+        LODSelectionStats* stats = nullptr
+    ) {
+        if (!world) {
+            return;
+        }
+        
+        struct BudgetEntry {
+            ECS::LODComponent* lodComp = nullptr;
+            size_t triangles[4] = {0, 0, 0, 0};  ///< LOD0-LOD3 的三角形数
+            float screenSize = 0.0f;             ///< 包围球半径 / 距离
+            int level = static_cast<int>(LODLevel::LOD3);
+        };
+        
+        std::vector<BudgetEntry> budgetEntries;
+        budgetEntries.reserve(entities.size());
+        size_t totalTriangles = 0;
+        
+        for (ECS::EntityID entity : entities) {
+            if (!world->HasComponent<ECS::LODComponent>(entity) ||
+                !world->HasComponent<ECS::TransformComponent>(entity) ||
+                !world->HasComponent<ECS::MeshRenderComponent>(entity)) {
+                continue;
+            }
+            
+            auto& lodComp = world->GetComponent<ECS::LODComponent>(entity);
+            auto& transformComp = world->GetComponent<ECS::TransformComponent>(entity);
+            if (!lodComp.config.enabled || !transformComp.transform) {
+                continue;
+            }
+            const auto& meshComp = world->GetComponent<ECS::MeshRenderComponent>(entity);
+            
+            Vector3 center = transformComp.GetPosition();
+            float radius = 1.0f;
+            if (world->HasComponent<ECS::WorldBoundsComponent>(entity)) {
+                const auto& boundsComp = world->GetComponent<ECS::WorldBoundsComponent>(entity);
+                if (boundsComp.valid) {
+                    center = boundsComp.sphereCenter;
+                    radius = boundsComp.sphereRadius;
+                }
+            }
+            
+            // 距离与 BatchCalculateLOD 一致，以实体位置计算
+            const float distance = CalculateDistance(transformComp.GetPosition(), cameraPosition);
+            lodComp.lastDistance = distance;
+            lodComp.lastUpdateFrame = frameId;
+            if (stats) {
+                stats->evaluated++;
+            }
+            
+            LODLevel newLOD = LODLevel::LOD3;
+            const LODLevel distanceLOD = lodComp.config.CalculateLOD(distance);
+            if (distanceLOD == LODLevel::Culled || distanceLOD == LODLevel::Impostor) {
+                // 替身区间固定使用替身，不参与预算细化
+                newLOD = distanceLOD;
+            } else if (!frustum || frustum->IntersectsSphere(center, radius)) {
+                BudgetEntry budgetEntry;
+                budgetEntry.lodComp = &lodComp;
+                for (int level = 0; level < 4; ++level) {
+                    Ref<Mesh> levelMesh = lodComp.config.GetLODMesh(static_cast<LODLevel>(level), meshComp.mesh);
+                    budgetEntry.triangles[level] = levelMesh ? levelMesh->GetTriangleCount() : 0;
+                }
+                budgetEntry.screenSize = radius / std::max(distance, 1e-3f);
+                totalTriangles += budgetEntry.triangles[budgetEntry.level];
+                budgetEntries.push_back(budgetEntry);
+                continue;
+            }
+            
+            if (newLOD != lodComp.currentLOD) {
+                if (stats) {
+                    stats->switches++;
+                }
+                lodComp.currentLOD = newLOD;
+                lodComp.lodSwitchCount++;
+                lodComp.lastLOD = newLOD;
+            }
+        }
+        
+        // 贪心细化：每次细化误差最大的实体一级
+        auto levelError = [](const BudgetEntry& budgetEntry) {
+            return budgetEntry.screenSize * static_cast<float>(1 << budgetEntry.level);
+        };
+        std::priority_queue<std::pair<float, uint32_t>> refineQueue;
+        for (uint32_t i = 0; i < budgetEntries.size(); ++i) {
+            refineQueue.emplace(levelError(budgetEntries[i]), i);
+        }
+        while (!refineQueue.empty()) {
+            const uint32_t index = refineQueue.top().second;
+            refineQueue.pop();
+            
+            BudgetEntry& budgetEntry = budgetEntries[index];
+            const size_t current = budgetEntry.triangles[budgetEntry.level];
+            const size_t finer = budgetEntry.triangles[budgetEntry.level - 1];
+            const size_t added = finer > current ? finer - current : 0;
+            if (added > 0 && totalTriangles + added > triangleBudget) {
+                continue;  // 该实体无法再细化，继续尝试误差更小的实体
+            }
+            
+            totalTriangles += added;
+            totalTriangles -= current > finer ? current - finer : 0;
+            budgetEntry.level--;
+            if (budgetEntry.level > 0) {
+                refineQueue.emplace(levelError(budgetEntry), index);
+            }
+        }
+        
+        for (const BudgetEntry& budgetEntry : budgetEntries) {
+            const LODLevel newLOD = static_cast<LODLevel>(budgetEntry.level);
+            ECS::LODComponent& lodComp = *budgetEntry.lodComp;
+            if (newLOD != lodComp.currentLOD) {
+                if (stats) {
+                    stats->switches++;
+                }
+                lodComp.currentLOD = newLOD;
+                lodComp.lodSwitchCount++;
+                lodComp.lastLOD = newLOD;
+            }
+        }
+        
+        if (stats) {
+            stats->triangleBudget = triangleBudget;
+            stats->selectedTriangles += totalTriangles;
         }
     }
     
@@ -658,8 +1101,8 @@ public:
                 distance = CalculateDistance(entityPos, cameraPosition);
             }
             
-            // 计算 LOD 级别
-            LODLevel newLOD = lodComp.config.CalculateLOD(distance);
+            // 计算 LOD 级别（启用滞后时在阈值附近保持当前级别）
+            LODLevel newLOD = lodComp.config.CalculateLOD(distance, lodComp.currentLOD);
             
             // ✅ 平滑过渡：避免频繁切换（与远距离剔除的实时性保持一致）
             // 第一次计算时（lastDistance为0），直接更新LOD级别
@@ -684,6 +1127,22 @@ public:
             lodComp.lastUpdateFrame = frameId;
         }
     }
+    
+private:
+    /**
+     * @brief 判断本帧是否需要重新计算实体的 LOD（按上次计算的距离区分远近）
+     */
+    [[nodiscard]] static bool ShouldEvaluate(
+        ECS::EntityID entity,
+        const ECS::LODComponent& lodComp,
+        const LODSelectionOptions& options,
+        uint64_t frameId
+    ) {
+        if (options.farUpdateInterval <= 1 || lodComp.lastDistance < options.nearUpdateDistance) {
+            return true;
+        }
+        return (static_cast<uint64_t>(entity.index) + frameId) % options.farUpdateInterval == 0;
+    }
 };
 
 /**
@@ -794,6 +1253,9 @@ public:
      * @param world ECS World 对象指针
      * @param camera 相机对象（用于获取视锥体和位置）
      * @param frameId 当前帧 ID（用于避免重复计算）
+     * @param useSelectedLOD 为 true 时直接使用 LODComponent::currentLOD（已由 LODSelector 选择，
+     *                       例如分帧更新或三角形预算模式），不再按距离重新计算；视锥体外的降级只体现在返回结果中，
+     *                       不写回组件
      * @return 按 LOD 级别分组的可见实体列表
      * 
      * @note 如果实体没有 LODComponent，会被归类到 LODLevel::LOD0
@@ -809,7 +1271,8 @@ public:
         const std::vector<ECS::EntityID>& entities,
         ECS::World* world,
         const Camera* camera,
-        uint64_t frameId
+        uint64_t frameId,
+        bool useSelectedLOD = false
     ) {
         std::map<LODLevel, std::vector<ECS::EntityID>> result;
         
@@ -821,7 +1284,31 @@ public:
         const Frustum& frustum = camera->GetFrustum();
         Vector3 cameraPos = camera->GetPosition();
         
-        // 遍历所有实体
+        // 单个实体在裁剪阶段收集的数据
+        struct CullCandidate {
+            ECS::EntityID entity;
+            Vector3 entityPos;
+            ECS::LODComponent* lodComp = nullptr;
+            ECS::WorldBoundsComponent* boundsComp = nullptr;
+            bool affectedByCulling = true;
+            LODConfig::FrustumOutBehavior frustumOutBehavior = LODConfig::FrustumOutBehavior::Cull;
+            int frustumOutLODReduction = 2;
+            int cullSlot = -1;  // 在 SoA 包围球数组中的下标，-1 表示跳过视锥体裁剪
+        };
+        
+        std::vector<CullCandidate> candidates;
+        candidates.reserve(entities.size());
+        
+        // SoA 包围球数组，交给 Frustum::CullSpheres 批量测试
+        std::vector<float> sphereX, sphereY, sphereZ, sphereR;
+        std::vector<uint8_t> planeHints;
+        sphereX.reserve(entities.size());
+        sphereY.reserve(entities.size());
+        sphereZ.reserve(entities.size());
+        sphereR.reserve(entities.size());
+        planeHints.reserve(entities.size());
+        
+        // ==================== 第一遍：收集需要视锥体裁剪的包围球 ====================
         for (ECS::EntityID entity : entities) {
             // 检查是否有 Transform 组件
             if (!world->HasComponent<ECS::TransformComponent>(entity)) {
@@ -833,82 +1320,79 @@ public:
                 continue;
             }
             
+            CullCandidate candidate;
+            candidate.entity = entity;
+            
             // 获取实体位置和包围球半径
-            Vector3 entityPos = transformComp.GetPosition();
+            candidate.entityPos = transformComp.GetPosition();
             
-            // 尝试获取包围球半径（从 MeshRenderComponent 或使用默认值）
+            // 使用缓存的世界空间包围球（由 MeshRenderSystem::UpdateWorldBounds 维护，与其保持一致）
+            // LOD 距离仍以实体位置计算，与 LODSelector 一致
+            Vector3 cullCenter = candidate.entityPos;
             float radius = 1.0f;  // 默认半径
-            if (world->HasComponent<ECS::MeshRenderComponent>(entity)) {
-                auto& meshComp = world->GetComponent<ECS::MeshRenderComponent>(entity);
-                if (meshComp.mesh) {
-                    // 尝试从网格获取包围盒
-                    AABB bounds = meshComp.mesh->CalculateBounds();
-                    // 检查包围盒是否有效（min <= max）
-                    if (bounds.min.x() <= bounds.max.x() && 
-                        bounds.min.y() <= bounds.max.y() && 
-                        bounds.min.z() <= bounds.max.z()) {
-                        Vector3 boundsSize = bounds.GetSize();
-                        // 使用包围盒对角线的一半作为半径（与 MeshRenderSystem 保持一致）
-                        radius = boundsSize.norm() * 0.5f;
-                        
-                        // 考虑Transform的缩放（与 MeshRenderSystem 保持一致）
-                        if (transformComp.transform) {
-                            Vector3 scale = transformComp.transform->GetScale();
-                            float maxScale = std::max(std::max(scale.x(), scale.y()), scale.z());
-                            radius *= maxScale;
-                        }
-                    }
+            if (world->HasComponent<ECS::WorldBoundsComponent>(entity)) {
+                auto& boundsComp = world->GetComponent<ECS::WorldBoundsComponent>(entity);
+                if (boundsComp.valid) {
+                    cullCenter = boundsComp.sphereCenter;
+                    radius = boundsComp.sphereRadius;
+                    candidate.boundsComp = &boundsComp;
                 }
             }
             
-            // ==================== 近距离保护：相机附近的物体永不剔除 ====================
-            // 与 MeshRenderSystem::ShouldCull 保持一致
-            Vector3 cameraPos = camera->GetPosition();
-            float distanceToCamera = (entityPos - cameraPos).norm();
-            const float noCullRadius = 5.0f;  // 5米内的物体不剔除
-            
-            bool skipFrustumCull = false;
-            if (distanceToCamera < noCullRadius + radius) {
-                // 物体在相机附近，跳过视锥体裁剪，直接处理LOD选择
-                skipFrustumCull = true;
-            }
-            
-            // ==================== 视锥体裁剪 ====================
-            bool isInFrustum = true;
-            bool shouldCull = false;
-            
-            // 检查是否受视锥体裁剪影响
-            bool affectedByCulling = true;
-            LODConfig::FrustumOutBehavior frustumOutBehavior = LODConfig::FrustumOutBehavior::Cull;
-            int frustumOutLODReduction = 2;
-            
             if (world->HasComponent<ECS::LODComponent>(entity)) {
                 auto& lodComp = world->GetComponent<ECS::LODComponent>(entity);
-                affectedByCulling = lodComp.affectedByFrustumCulling;
-                frustumOutBehavior = lodComp.config.frustumOutBehavior;
-                frustumOutLODReduction = lodComp.config.frustumOutLODReduction;
+                candidate.lodComp = &lodComp;
+                candidate.affectedByCulling = lodComp.affectedByFrustumCulling;
+                candidate.frustumOutBehavior = lodComp.config.frustumOutBehavior;
+                candidate.frustumOutLODReduction = lodComp.config.frustumOutLODReduction;
             }
             
-            if (!skipFrustumCull && affectedByCulling) {
+            // ==================== 近距离保护：相机附近的物体永不剔除 ====================
+            // 与 MeshRenderSystem::ShouldCull 保持一致
+            float distanceToCamera = (cullCenter - cameraPos).norm();
+            const float noCullRadius = 5.0f;  // 5米内的物体不剔除
+            bool skipFrustumCull = distanceToCamera < noCullRadius + radius;
+            
+            if (!skipFrustumCull && candidate.affectedByCulling) {
                 // 扩大包围球半径以避免过度剔除（与 MeshRenderSystem 保持一致）
-                // 增加更大的安全边距，避免边缘物体被过度剔除
                 // 注意：从1.5倍增加到2.5倍，提供更大的安全边距，避免下边和左右两边的物体被过度剔除
-                float expandedRadius = radius * 2.5f;  // 增加到2.5倍，提供更大的安全边距
-                
-                isInFrustum = frustum.IntersectsSphere(entityPos, expandedRadius);
+                float expandedRadius = radius * 2.5f;
                 
-                if (!isInFrustum) {
-                    // 实体不在视锥体内
-                    // 根据配置决定如何处理
-                    if (frustumOutBehavior == LODConfig::FrustumOutBehavior::Cull) {
-                        // 完全剔除，跳过
-                        shouldCull = true;
-                    }
-                    // 否则继续处理，使用降低的LOD级别
+                candidate.cullSlot = static_cast<int>(sphereX.size());
+                sphereX.push_back(cullCenter.x());
+                sphereY.push_back(cullCenter.y());
+                sphereZ.push_back(cullCenter.z());
+                sphereR.push_back(expandedRadius);
+                planeHints.push_back(candidate.boundsComp ? candidate.boundsComp->cullPlaneHint : 0);
+            }
+            
+            candidates.push_back(candidate);
+        }
+        
+        // ==================== 视锥体裁剪（SoA 批量） ====================
+        std::vector<uint8_t> sphereVisible(sphereX.size(), 1);
+        frustum.CullSpheres(sphereX.data(), sphereY.data(), sphereZ.data(), sphereR.data(),
+                            sphereX.size(), sphereVisible.data(), planeHints.data());
+        
+        // ==================== 第二遍：处理裁剪结果与 LOD 选择 ====================
+        for (const CullCandidate& candidate : candidates) {
+            const ECS::EntityID entity = candidate.entity;
+            const Vector3& entityPos = candidate.entityPos;
+            const bool affectedByCulling = candidate.affectedByCulling;
+            const LODConfig::FrustumOutBehavior frustumOutBehavior = candidate.frustumOutBehavior;
+            const int frustumOutLODReduction = candidate.frustumOutLODReduction;
+            
+            bool isInFrustum = true;
+            if (candidate.cullSlot >= 0) {
+                isInFrustum = sphereVisible[candidate.cullSlot] != 0;
+                if (candidate.boundsComp) {
+                    // 保存剔除平面，下一帧优先测试
+                    candidate.boundsComp->cullPlaneHint = planeHints[candidate.cullSlot];
                 }
             }
             
-            if (shouldCull) {
+            // 不在视锥体内且配置为完全剔除时跳过，否则继续处理，使用降低的LOD级别
+            if (!isInFrustum && frustumOutBehavior == LODConfig::FrustumOutBehavior::Cull) {
                 continue;
             }
             
@@ -916,18 +1400,19 @@ public:
             LODLevel lodLevel = LODLevel::LOD0;  // 默认 LOD0
             bool useReducedLOD = false;  // 是否使用降低的LOD级别
             
-            if (world->HasComponent<ECS::LODComponent>(entity)) {
-                auto& lodComp = world->GetComponent<ECS::LODComponent>(entity);
+            if (candidate.lodComp) {
+                auto& lodComp = *candidate.lodComp;
                 
                 if (lodComp.config.enabled) {
                     // 计算距离
                     float distance = LODSelector::CalculateDistance(entityPos, cameraPos);
                     
-                    // 计算 LOD 级别
-                    lodLevel = lodComp.config.CalculateLOD(distance);
+                    // 计算 LOD 级别（启用滞后时在阈值附近保持当前级别）
+                    lodLevel = useSelectedLOD ? lodComp.currentLOD
+                                              : lodComp.config.CalculateLOD(distance, lodComp.currentLOD);
                     
                     // 如果不在视锥体内，根据配置降低LOD级别
-                    if (!isInFrustum && affectedByCulling) {
+                    if (!isInFrustum && affectedByCulling && lodLevel != LODLevel::Impostor) {
                         if (frustumOutBehavior == LODConfig::FrustumOutBehavior::UseLowerLOD) {
                             // 降低指定的LOD级别数
                             int currentLODIndex = static_cast<int>(lodLevel);
@@ -949,17 +1434,19 @@ public:
                     }
                     
                     // 更新 LOD 组件（与 LODSelector::BatchCalculateLOD 保持一致）
-                    // 第一次计算时（lastDistance为0），直接更新LOD级别
-                    bool isFirstUpdate = (lodComp.lastDistance == 0.0f);
-                    
-                    if (isFirstUpdate || lodLevel != lodComp.currentLOD) {
-                        lodComp.currentLOD = lodLevel;
-                        lodComp.lodSwitchCount++;
-                        lodComp.lastLOD = lodComp.currentLOD;
+                    if (!useSelectedLOD) {
+                        // 第一次计算时（lastDistance为0），直接更新LOD级别
+                        bool isFirstUpdate = (lodComp.lastDistance == 0.0f);
+                        
+                        if (isFirstUpdate || lodLevel != lodComp.currentLOD) {
+                            lodComp.currentLOD = lodLevel;
+                            lodComp.lodSwitchCount++;
+                            lodComp.lastLOD = lodComp.currentLOD;
+                        }
+                        
+                        lodComp.lastDistance = distance;
+                        lodComp.lastUpdateFrame = frameId;
                     }
-                    
-                    lodComp.lastDistance = distance;
-                    lodComp.lastUpdateFrame = frameId;
                 }
             } else if (!isInFrustum && affectedByCulling) {
                 // 没有LODComponent但不在视锥体内，根据默认行为处理
@@ -1153,7 +1640,7 @@ public:
                     lodLevel = lodComp.config.CalculateLOD(distance);
                     
                     // 如果不在视锥体内，根据配置降低LOD级别
-                    if (!isVisible && affectedByCulling) {
+                    if (!isVisible && affectedByCulling && lodLevel != LODLevel::Impostor) {
                         if (frustumOutBehavior == LODConfig::FrustumOutBehavior::UseLowerLOD) {
                             // 降低指定的LOD级别数
                             int currentLODIndex = static_cast<int>(lodLevel);
@@ -22,6 +22,7 @@
 
 #include "render/types.h"
 #include "render/render_state.h"
+#include "render/uniform_manager.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -34,6 +35,7 @@ namespace Render {
 // 前向声明
 class Shader;
 class Texture;
+class UniformBuffer;
 
 /**
  * @brief 材质类 - 管理渲染材质属性、纹理和着色器
@@ -446,6 +448,33 @@ public:
     uint32_t GetStableID() const noexcept { return m_stableID; }
     
 private:
+    /**
+     * @brief 按着色器程序预解析的 uniform 句柄表
+     *
+     * 只保留着色器中存在的 uniform，绑定时按句柄顺序下发，不做字符串查找。
+     */
+    struct UniformTable {
+        uint32_t program = 0;                        ///< 解析时的程序 ID
+        const UniformManager* manager = nullptr;     ///< 解析时的 UniformManager（着色器重载后会变化）
+
+        // 材质属性（先于纹理下发）
+        std::vector<std::pair<UniformHandle, Color>> propertyColors;
+        std::vector<std::pair<UniformHandle, float>> propertyFloats;
+        std::vector<std::pair<UniformHandle, int>> propertyInts;
+        UniformHandle hasDiffuseMap;
+        UniformHandle hasNormalMap;
+
+        // 自定义参数（后于纹理下发，可覆盖同名属性）
+        std::vector<std::pair<UniformHandle, int>> ints;
+        std::vector<std::pair<UniformHandle, float>> floats;
+        std::vector<std::pair<UniformHandle, Vector2>> vector2s;
+        std::vector<std::pair<UniformHandle, Vector3>> vector3s;
+        std::vector<std::pair<UniformHandle, Vector4>> vector4s;
+        std::vector<std::pair<UniformHandle, Matrix4>> matrix4s;
+        std::vector<std::pair<UniformHandle, size_t>> vector2Arrays;  ///< 值为快照中数组参数的下标
+        std::vector<std::pair<UniformHandle, size_t>> colorArrays;
+    };
+
     struct CachedState {
         std::shared_ptr<Shader> shader;
         Color ambientColor;
@@ -469,6 +498,11 @@ private:
         CullFace cullFace = CullFace::Back;
         bool depthTest = true;
         bool depthWrite = true;
+        PipelineStateId pipelineState = 0;   ///< 混合/深度/剔除/程序组合对应的管线状态对象
+        uint32_t pipelineProgram = 0;        ///< 构建 pipelineState 时的程序 ID（用于检测着色器重载）
+        std::vector<uint8_t> uniformBlock;   ///< 按 std140 打包的 MaterialData 块
+        uint64_t generation = 0;             ///< 快照版本号，用于判断 UBO 是否需要重新上传
+        std::shared_ptr<UniformTable> uniformTable;  ///< 句柄表（仅在 GL 线程的 Bind 中读写）
         std::string name;
     };
 
@@ -513,9 +547,17 @@ private:
     mutable std::mutex m_mutex;             ///< 互斥锁，保护所有成员变量
     mutable std::shared_ptr<CachedState> m_cachedState;
     mutable bool m_cacheDirty = true;
+    uint64_t m_snapshotGeneration = 0;      ///< 每次重建快照递增
+
+    std::unique_ptr<UniformBuffer> m_uniformBuffer;  ///< MaterialData UBO（按需创建）
+    uint64_t m_uniformBufferGeneration = 0;          ///< UBO 中数据对应的快照版本
 
     void InvalidateCacheLocked();
     std::shared_ptr<CachedState> EnsureCachedStateLocked();
+    void BindUniformBlock(const CachedState& snapshot, RenderState* renderState);
+    static std::shared_ptr<UniformTable> BuildUniformTable(const CachedState& snapshot,
+                                                           const UniformManager& uniformMgr,
+                                                           uint32_t program);
 };
 
 // 类型别名
@@ -21,14 +21,19 @@
 #pragma once
 
 #include "types.h"
+#include "vertex_layout.h"
 #include <glad/glad.h>
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <functional>
 
 namespace Render {
 
+struct MeshletData;
+class UniformManager;
+
 /**
  * @brief 顶点数据结构
  * 
@@ -76,6 +81,15 @@ struct Vertex {
         , bitangent(Vector3::UnitZ()) {}
 };
 
+/**
+ * @brief Meshlet 绘制区间（按簇排序的索引缓冲区中的一段连续索引）
+ * @see MeshletCuller::CullRanges, Mesh::DrawMeshletRanges
+ */
+struct MeshletDrawRange {
+    uint32_t indexOffset = 0;  ///< 起始索引
+    uint32_t indexCount = 0;   ///< 索引数
+};
+
 /**
  * @brief 网格绘制模式
  */
@@ -101,6 +115,18 @@ enum class UploadState {
     Failed          // 上传失败
 };
 
+/**
+ * @brief 网格 CPU 数据驻留策略
+ * 
+ * 控制 Upload() 成功后 CPU 端保留多少数据。释放后的数据可通过 Mesh::SetCPUDataSource
+ * 设置的数据源（例如二进制网格缓存文件）按需重新读取。
+ */
+enum class MeshCPUResidency : uint8_t {
+    Keep,           // 保留完整顶点与索引（默认）
+    PositionsOnly,  // 上传后仅保留紧凑位置数组与索引（碰撞、包围盒、拾取、遮挡剔除）
+    Release         // 上传后释放全部顶点与索引
+};
+
 /**
  * @brief 网格类
  * 
@@ -121,10 +147,10 @@ public:
     
     /**
      * @brief 构造函数（带数据）
-     * @param vertices 顶点数据
-     * @param indices 索引数据
+     * @param vertices 顶点数据（传入右值时直接接管，避免拷贝）
+     * @param indices 索引数据（传入右值时直接接管，避免拷贝）
      */
-    Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+    Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices);
     
     /**
      * @brief 析构函数
@@ -184,6 +210,17 @@ public:
      * @param mode 绘制模式（默认为三角形）
      */
     void DrawInstanced(uint32_t instanceCount, DrawMode mode = DrawMode::Triangles) const;
+    
+    /**
+     * @brief 只绘制可见 meshlet 的三角形
+     * 
+     * 首次调用时按 meshlet 顺序展开索引并上传到独立的 EBO（之后复用，直到 SetMeshlets 替换数据），
+     * 再用一次 glMultiDrawElements 提交所有区间。未构建 meshlet 时退化为 Draw()。
+     * 
+     * @param ranges 由 MeshletCuller::CullRanges 输出的区间
+     * @param mode 绘制模式（默认为三角形）
+     */
+    void DrawMeshletRanges(const std::vector<MeshletDrawRange>& ranges, DrawMode mode = DrawMode::Triangles) const;
 
     /**
      * @brief 获取底层 VAO 标识（供高级渲染流程使用）
@@ -201,8 +238,14 @@ public:
      */
     [[deprecated("Use AccessVertices() or LockVertices() instead")]]
     std::vector<Vertex> GetVertices() const { 
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_Vertices;  // 返回副本以保证线程安全
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        if (!m_verticesReleased) {
+            return m_Vertices;  // 返回副本以保证线程安全
+        }
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        LoadReleasedCPUData(lock, vertices, indices);
+        return vertices;
     }
     
     /**
@@ -211,8 +254,14 @@ public:
      */
     [[deprecated("Use AccessIndices() or LockIndices() instead")]]
     std::vector<uint32_t> GetIndices() const { 
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_Indices;  // 返回副本以保证线程安全
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        if (!m_indicesReleased) {
+            return m_Indices;  // 返回副本以保证线程安全
+        }
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        LoadReleasedCPUData(lock, vertices, indices);
+        return indices;
     }
     
     /**
@@ -220,6 +269,10 @@ public:
      * 
      * 使用回调方式在锁保护下访问顶点数据，避免数据竞争
      * 
+     * CPU 数据已按驻留策略释放时，在锁外从数据源读取一份临时副本交给回调，
+     * 读取期间不阻塞 Draw 等其他调用；没有可用数据源时回调收到空数组
+     * （可用 IsCPUDataResident() 预先判断）。
+     * 
      * @param func 回调函数，接受 const std::vector<Vertex>& 参数
      * 
      * @example
@@ -231,8 +284,15 @@ public:
      */
     template<typename Func>
     void AccessVertices(Func&& func) const {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        func(m_Vertices);
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        if (!m_verticesReleased) {
+            func(m_Vertices);
+            return;
+        }
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        LoadReleasedCPUData(lock, vertices, indices);
+        func(static_cast<const std::vector<Vertex>&>(vertices));
     }
     
     /**
@@ -240,6 +300,8 @@ public:
      * 
      * 使用回调方式在锁保护下访问索引数据，避免数据竞争
      * 
+     * 索引已释放时与 AccessVertices 相同，回调收到锁外读取的临时副本。
+     * 
      * @param func 回调函数，接受 const std::vector<uint32_t>& 参数
      * 
      * @example
@@ -251,52 +313,133 @@ public:
      */
     template<typename Func>
     void AccessIndices(Func&& func) const {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        func(m_Indices);
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        if (!m_indicesReleased) {
+            func(m_Indices);
+            return;
+        }
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        LoadReleasedCPUData(lock, vertices, indices);
+        func(static_cast<const std::vector<uint32_t>&>(indices));
+    }
+    
+    /**
+     * @brief 顶点位置只读视图（按跨步访问完整 Vertex 数组或紧凑位置副本）
+     */
+    class PositionView {
+    public:
+        PositionView() = default;
+        PositionView(const Vector3* first, size_t stride, size_t count)
+            : m_data(reinterpret_cast<const uint8_t*>(first)), m_stride(stride), m_count(count) {}
+        
+        const Vector3& operator[](size_t i) const {
+            return *reinterpret_cast<const Vector3*>(m_data + i * m_stride);
+        }
+        size_t size() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+        
+    private:
+        const uint8_t* m_data = nullptr;
+        size_t m_stride = 0;
+        size_t m_count = 0;
+    };
+    
+    /**
+     * @brief 通过回调访问顶点位置
+     * 
+     * 碰撞、包围盒、拾取等只需要位置的代码应使用此方法：PositionsOnly 策略下直接读取
+     * 紧凑位置副本，不会触发从数据源重新读取完整顶点。
+     * 
+     * @param func 回调函数，接受 const Mesh::PositionView& 参数
+     */
+    template<typename Func>
+    void AccessPositions(Func&& func) const {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        if (m_verticesReleased && !m_positions.empty()) {
+            func(PositionView(m_positions.data(), sizeof(Vector3), m_positions.size()));
+            return;
+        }
+        if (!m_verticesReleased) {
+            func(m_Vertices.empty() ? PositionView()
+                                    : PositionView(&m_Vertices[0].position, sizeof(Vertex), m_Vertices.size()));
+            return;
+        }
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        LoadReleasedCPUData(lock, vertices, indices);
+        func(vertices.empty() ? PositionView()
+                              : PositionView(&vertices[0].position, sizeof(Vertex), vertices.size()));
     }
     
     /**
      * @brief RAII 顶点数据守卫（方法2）
      * 
-     * 在对象生命周期内持有锁，允许安全访问顶点数据
+     * CPU 顶点数据常驻时，在对象生命周期内持有锁，Get() 返回网格内部数据的引用；
+     * 顶点按 MeshCPUResidency 在上传后释放时不持有任何锁，Get() 返回构造时从数据源
+     * 读取的快照，之后对网格的修改不会反映到快照中。
      */
     class VertexGuard {
     public:
         VertexGuard(const Mesh& mesh) 
-            : m_mesh(mesh), m_lock(mesh.m_Mutex) {}
+            : m_mesh(mesh), m_lock(mesh.m_Mutex) {
+            if (mesh.m_verticesReleased) {
+                std::vector<uint32_t> indices;
+                mesh.LoadReleasedCPUData(m_lock, m_loadedVertices, indices);
+                m_loaded = true;
+            }
+        }
         
+        /**
+         * @brief 顶点数据：常驻时为锁保护下的内部数据，已释放时为快照
+         */
         const std::vector<Vertex>& Get() const { 
-            return m_mesh.m_Vertices; 
+            return m_loaded ? m_loadedVertices : m_mesh.m_Vertices; 
         }
         
     private:
         const Mesh& m_mesh;
-        std::lock_guard<std::mutex> m_lock;
+        std::unique_lock<std::mutex> m_lock;
+        bool m_loaded = false;                  // 是否使用从数据源读取的临时副本
+        std::vector<Vertex> m_loadedVertices;
     };
     
     /**
      * @brief RAII 索引数据守卫（方法2）
      * 
-     * 在对象生命周期内持有锁，允许安全访问索引数据
+     * CPU 索引数据常驻时，在对象生命周期内持有锁，Get() 返回网格内部数据的引用；
+     * 索引按 MeshCPUResidency 在上传后释放时不持有任何锁，Get() 返回构造时从数据源
+     * 读取的快照，之后对网格的修改不会反映到快照中。
      */
     class IndexGuard {
     public:
         IndexGuard(const Mesh& mesh) 
-            : m_mesh(mesh), m_lock(mesh.m_Mutex) {}
+            : m_mesh(mesh), m_lock(mesh.m_Mutex) {
+            if (mesh.m_indicesReleased) {
+                std::vector<Vertex> vertices;
+                mesh.LoadReleasedCPUData(m_lock, vertices, m_loadedIndices);
+                m_loaded = true;
+            }
+        }
         
+        /**
+         * @brief 索引数据：常驻时为锁保护下的内部数据，已释放时为快照
+         */
         const std::vector<uint32_t>& Get() const { 
-            return m_mesh.m_Indices; 
+            return m_loaded ? m_loadedIndices : m_mesh.m_Indices; 
         }
         
     private:
         const Mesh& m_mesh;
-        std::lock_guard<std::mutex> m_lock;
+        std::unique_lock<std::mutex> m_lock;
+        bool m_loaded = false;                  // 是否使用从数据源读取的临时副本
+        std::vector<uint32_t> m_loadedIndices;
     };
     
     /**
      * @brief 获取顶点数据的锁保护访问（方法2）
      * 
-     * 返回 RAII 守卫对象，在其生命周期内持有锁
+     * 返回 RAII 守卫对象；CPU 顶点数据常驻时在其生命周期内持有锁，已释放时不持有锁并返回快照
      * 
      * @return VertexGuard 守卫对象
      * 
@@ -316,7 +459,7 @@ public:
     /**
      * @brief 获取索引数据的锁保护访问（方法2）
      * 
-     * 返回 RAII 守卫对象，在其生命周期内持有锁
+     * 返回 RAII 守卫对象；CPU 索引数据常驻时在其生命周期内持有锁，已释放时不持有锁并返回快照
      * 
      * @return IndexGuard 守卫对象
      * 
@@ -338,7 +481,7 @@ public:
      */
     size_t GetVertexCount() const { 
         std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_Vertices.size(); 
+        return VertexCountNoLock(); 
     }
     
     /**
@@ -346,7 +489,7 @@ public:
      */
     size_t GetIndexCount() const { 
         std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_Indices.size(); 
+        return IndexCountNoLock(); 
     }
     
     /**
@@ -354,7 +497,7 @@ public:
      */
     size_t GetTriangleCount() const { 
         std::lock_guard<std::mutex> lock(m_Mutex);
-        return m_Indices.size() / 3; 
+        return IndexCountNoLock() / 3; 
     }
     
     /**
@@ -382,10 +525,28 @@ public:
     }
     
     /**
-     * @brief 计算包围盒
+     * @brief 获取局部空间包围盒
+     * 
+     * 结果会被缓存，仅在顶点数据变化（SetVertices/SetData/UpdateVertices）后的
+     * 首次调用时重新遍历顶点，可在裁剪等每帧路径中直接调用
      */
     AABB CalculateBounds() const;
     
+    /**
+     * @brief 预先提供局部包围盒（例如来自二进制网格缓存），跳过首次 CalculateBounds 的顶点遍历
+     * @note 调用者保证包围盒与当前顶点一致；顶点变化后自动失效
+     */
+    void SetCachedBounds(const AABB& bounds);
+    
+    /**
+     * @brief 获取包围盒版本号（线程安全，无锁）
+     * 
+     * 顶点数据每次变化时更新为全局唯一的新值，用于外部缓存（如 WorldBoundsComponent）判断是否需要刷新
+     */
+    uint64_t GetBoundsVersion() const {
+        return m_boundsVersion.load(std::memory_order_acquire);
+    }
+    
     /**
      * @brief 重新计算法线（基于三角形）
      */
@@ -398,24 +559,198 @@ public:
     void RecalculateTangents();
 
     /**
-     * @brief 获取网格内存使用量（字节）
+     * @brief 获取 CPU 端常驻内存（字节，随驻留策略释放而减少）
      */
     size_t GetMemoryUsage() const;
+    
+    /**
+     * @brief 获取 GPU 端内存使用量（字节，按当前顶点布局与索引格式计算）
+     */
+    size_t GetGPUMemoryUsage() const;
+    
+    /**
+     * @brief CPU 数据源回调：重新读取完整顶点与索引，成功返回 true
+     */
+    using CPUDataSource = std::function<bool(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)>;
+    
+    /**
+     * @brief 设置 CPU 数据驻留策略
+     * 
+     * 在下次 Upload() 成功后生效；网格已上传时立即生效。放宽策略时（如 Release → Keep）
+     * 会尝试从数据源重新读取。释放前会先计算并缓存包围盒，CalculateBounds 不受影响。
+     */
+    void SetCPUResidency(MeshCPUResidency residency);
+    
+    /**
+     * @brief 获取 CPU 数据驻留策略
+     */
+    MeshCPUResidency GetCPUResidency() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_cpuResidency;
+    }
+    
+    /**
+     * @brief 设置 CPU 数据源（例如 MeshCache 缓存文件中的对应网格）
+     * 
+     * 释放后的数据在 AccessVertices/LockVertices 等访问、重新上传或修改顶点时按需重新读取。
+     * 通过 SetVertices/SetData/UpdateVertices 等修改数据后数据源自动失效。
+     */
+    void SetCPUDataSource(CPUDataSource source);
+    
+    /**
+     * @brief 完整顶点数据是否驻留在 CPU
+     */
+    bool IsCPUDataResident() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return !m_verticesReleased && !m_indicesReleased;
+    }
+    
+    /**
+     * @brief 释放的数据能否重新读取（已驻留或设置了数据源）
+     */
+    bool CanRestoreCPUData() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return (!m_verticesReleased && !m_indicesReleased) || static_cast<bool>(m_cpuDataSource);
+    }
+    
+    /**
+     * @brief 设置 GPU 顶点布局
+     * 
+     * CPU 端仍保存完整的 Vertex 数据，仅在上传时按布局编码。布局变化后需重新调用 Upload()。
+     * 使用八面体法线/切线或量化位置时，着色器需声明 uVertexLayoutFlags / uVertexDequant
+     * 并解码（内置的 basic、material_phong、normal_map 着色器已支持）。
+     * 
+     * @param layout 顶点布局（默认 VertexLayout::Full()，与 Vertex 结构体一致）
+     */
+    void SetVertexLayout(const VertexLayout& layout);
+    
+    /**
+     * @brief 获取 GPU 顶点布局
+     */
+    VertexLayout GetVertexLayout() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_vertexLayout;
+    }
+    
+    /**
+     * @brief 获取位置量化参数（仅在布局使用 SNorm16 位置且已上传时有意义）
+     */
+    VertexQuantization GetVertexQuantization() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_vertexQuantization;
+    }
+    
+    /**
+     * @brief 获取 GPU 索引缓冲格式
+     * 
+     * 存在 EBO 时返回其实际使用的格式（上传时顶点数 ≤ 65536 则为 UInt16）；否则返回下次上传将选用的格式。
+     */
+    IndexFormat GetIndexFormat() const;
+    
+    /**
+     * @brief 获取绘制调用使用的索引类型（GL_UNSIGNED_SHORT / GL_UNSIGNED_INT）
+     * @note 直接绑定 Mesh EBO 自行发起 glDrawElements* 的渲染器必须使用此类型
+     */
+    GLenum GetGLIndexType() const {
+        return GetIndexFormat() == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+    
+    /**
+     * @brief 设置顶点布局解码 uniform（uVertexLayoutFlags / uVertexDequant）
+     * 
+     * 着色器未声明这些 uniform 时不做任何事；完整布局会把标志重置为 0，
+     * 避免同一着色器上一次绘制的压缩网格状态残留。
+     */
+    void ApplyVertexLayoutUniforms(UniformManager* uniforms) const;
+    
+    /**
+     * @brief 设置 meshlet（簇）数据（通常由 MeshletBuilder::BuildForMesh 调用）
+     * @note 顶点或索引数据变化（SetVertices/SetIndices/SetData/UpdateVertices）时自动清除
+     */
+    void SetMeshlets(std::shared_ptr<const MeshletData> meshlets);
+    
+    /**
+     * @brief 获取 meshlet 数据（未构建时返回 nullptr）
+     */
+    std::shared_ptr<const MeshletData> GetMeshlets() const;
+    
+    /**
+     * @brief 是否已构建 meshlet
+     */
+    bool HasMeshlets() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_meshlets != nullptr;
+    }
 
 private:
     /**
-     * @brief 设置顶点属性指针
+     * @brief 按顶点布局设置顶点属性指针
      */
-    void SetupVertexAttributes();
+    static void SetupVertexAttributes(const VertexLayout& layout);
+    
+    /**
+     * @brief 为布局中未存储的属性设置常量默认值（法线 +Y、白色），绘制前调用
+     */
+    static void ApplyMissingAttributeDefaults(const VertexLayout& layout);
+    
+    /**
+     * @brief 把 CPU 顶点 [offset, offset+count) 按已上传布局写入已绑定的 VBO（调用者需持有 m_Mutex）
+     * 
+     * 压缩布局下负责编码；量化位置超出当前量化范围时重新量化并整体重写缓冲。
+     */
+    void WriteVertexBufferNoLock(size_t offset, size_t count);
     
     /**
      * @brief DrawMode 转换为 OpenGL 绘制模式
      */
     GLenum ConvertDrawMode(DrawMode mode) const;
+    
+    /**
+     * @brief 标记包围盒失效（调用者需持有 m_Mutex）
+     */
+    void InvalidateBoundsNoLock();
+    
+    /**
+     * @brief 分配全局唯一的包围盒版本号（避免网格释放后地址复用导致误判）
+     */
+    static uint64_t NextBoundsVersion();
+    
+    /**
+     * @brief 顶点/索引数量（数据已释放时返回释放前的数量，调用者需持有 m_Mutex）
+     */
+    size_t VertexCountNoLock() const { return m_verticesReleased ? m_releasedVertexCount : m_Vertices.size(); }
+    size_t IndexCountNoLock() const { return m_indicesReleased ? m_releasedIndexCount : m_Indices.size(); }
+    
+    /**
+     * @brief 从数据源重新读取已释放的 CPU 数据（调用者需持有 m_Mutex）
+     * @return 实际重新读取了数据返回 true（调用者用完后应调用 ApplyCPUResidencyNoLock 再次释放）
+     */
+    bool RestoreCPUDataNoLock() const;
+    
+    /**
+     * @brief 为只读访问从数据源读取已释放的 CPU 数据副本
+     * 
+     * 调用时 lock 需持有 m_Mutex；读取数据源期间释放锁，返回时锁处于释放状态。
+     * 读取结果不写回网格，失败时输出为空并只记录一次警告。
+     */
+    bool LoadReleasedCPUData(std::unique_lock<std::mutex>& lock,
+                             std::vector<Vertex>& vertices,
+                             std::vector<uint32_t>& indices) const;
+    
+    /**
+     * @brief 按驻留策略释放已上传网格的 CPU 数据（调用者需持有 m_Mutex）
+     */
+    void ApplyCPUResidencyNoLock() const;
+    
+    /**
+     * @brief 修改顶点前确保完整 CPU 数据可用（调用者需持有 m_Mutex）
+     */
+    bool EnsureCPUDataForWriteNoLock(const char* caller);
 
 private:
-    std::vector<Vertex> m_Vertices;     // 顶点数据
-    std::vector<uint32_t> m_Indices;    // 索引数据
+    // 驻留策略释放/重新读取数据不改变网格的逻辑内容，因此 const 访问器也可修改
+    mutable std::vector<Vertex> m_Vertices;     // 顶点数据
+    mutable std::vector<uint32_t> m_Indices;    // 索引数据
     
     GLuint m_VAO;   // 顶点数组对象
     GLuint m_VBO;   // 顶点缓冲对象
@@ -424,6 +759,29 @@ private:
     bool m_Uploaded;    // 是否已上传到 GPU（向后兼容）
     std::atomic<UploadState> m_uploadState;  // 上传状态（用于两阶段上传优化）
     
+    mutable AABB m_cachedBounds;                 // 缓存的局部包围盒
+    mutable bool m_boundsDirty = true;           // 包围盒是否需要重新计算
+    std::atomic<uint64_t> m_boundsVersion{NextBoundsVersion()};  // 包围盒版本号（全局唯一，顶点变化时更新）
+    
+    std::shared_ptr<const MeshletData> m_meshlets;  // meshlet 数据（可选，数据变化时清除）
+    mutable GLuint m_meshletEBO = 0;                 // 按 meshlet 顺序排列的索引缓冲区（DrawMeshletRanges 懒创建）
+    mutable IndexFormat m_meshletIndexFormat = IndexFormat::UInt32;
+    mutable bool m_meshletEBODirty = true;           // meshlet 数据已替换，EBO 需要重建
+    
+    VertexLayout m_vertexLayout;                 // 请求的 GPU 顶点布局（下次 Upload 生效）
+    VertexLayout m_uploadedVertexLayout;         // 当前 VBO 实际使用的布局
+    VertexQuantization m_vertexQuantization;     // 位置量化参数（上传时根据包围盒计算）
+    IndexFormat m_uploadedIndexFormat = IndexFormat::UInt32;  // 当前 EBO 实际使用的索引格式
+    
+    MeshCPUResidency m_cpuResidency = MeshCPUResidency::Keep;  // CPU 数据驻留策略
+    CPUDataSource m_cpuDataSource;               // 已释放数据的重新读取来源（可为空）
+    mutable std::vector<Vector3> m_positions;    // PositionsOnly 策略下的紧凑位置副本
+    mutable bool m_verticesReleased = false;     // m_Vertices 已按策略释放
+    mutable bool m_indicesReleased = false;      // m_Indices 已按策略释放
+    mutable bool m_restoreFailureLogged = false; // 重新读取失败的警告只记录一次
+    mutable size_t m_releasedVertexCount = 0;    // 释放前的顶点数
+    mutable size_t m_releasedIndexCount = 0;     // 释放前的索引数
+    
     mutable std::mutex m_Mutex;  // 互斥锁，保护所有成员变量
 };
 
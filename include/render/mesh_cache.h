@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/types.h"
+#include "render/mesh_loader.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief 二进制网格缓存
+ * 
+ * 将 MeshLoader::LoadDetailedFromFile 的导入结果（顶点/索引、包围盒、节点变换、
+ * 多 UV/颜色通道、蒙皮数据与材质描述）写入紧凑二进制文件，缓存键由源文件内容哈希与
+ * MeshImportOptions 共同决定。再次加载同一模型时通过内存映射读取，顶点与索引块按
+ * GPU 布局直接拷贝进网格，跳过 Assimp 解析与后处理。
+ * 
+ * **文件格式**（本机字节序，扩展名 .meshc）：
+ * - 文件头：魔数 "RMSH"、版本、缓存键、网格数、顶点步长
+ * - 每个网格记录：顶点数、索引数、顶点/索引/元数据偏移、元数据大小、包围盒
+ * - 数据区（8 字节对齐）：Vertex 数组（与 Mesh::Upload 上传的布局一致）、uint32 索引、
+ *   元数据（名称、变换、附加通道、蒙皮、材质描述）
+ * 
+ * **使用示例**：
+ * @code
+ * MeshImportOptions options;
+ * options.useBinaryCache = true;   // 由 MeshLoader 自动查找/写入缓存
+ * auto results = MeshLoader::LoadDetailedFromFile("models/character.fbx", options);
+ * @endcode
+ * 
+ * @note 缓存只保存材质描述（颜色、参数、纹理相对路径），命中时由 MeshLoader 重新创建 Material
+ * @note 线程安全：Load/Store 可在任意线程调用；同一键的并发写入通过临时文件 + 重命名保证原子性
+ */
+class MeshCache {
+public:
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats {
+        size_t hits = 0;      ///< 命中次数
+        size_t misses = 0;    ///< 未命中次数
+        size_t writes = 0;    ///< 成功写入次数
+    };
+    
+    static MeshCache& GetInstance();
+    
+    /**
+     * @brief 设置缓存目录（默认 "cache/mesh"，不存在时在首次写入时创建）
+     */
+    void SetCacheDirectory(const std::string& directory);
+    [[nodiscard]] std::string GetCacheDirectory() const;
+    
+    /**
+     * @brief 启用/禁用缓存（禁用时 Load 总是未命中，Store 不写入）
+     */
+    void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 计算影响导入结果的 MeshImportOptions 字段哈希
+     * 
+     * autoUpload、loadMaterials、useBinaryCache 与 cpuResidency 不影响缓存内容，不参与计算
+     */
+    static uint64_t HashOptions(const MeshImportOptions& options);
+    
+    /**
+     * @brief 组合源文件哈希与导入选项得到缓存键
+     */
+    static uint64_t BuildKey(uint64_t sourceHash, const MeshImportOptions& options);
+    
+    /**
+     * @brief 获取缓存键对应的文件路径
+     */
+    [[nodiscard]] std::string GetCachePath(uint64_t key) const;
+    
+    /**
+     * @brief 从缓存加载导入结果
+     * @param key 缓存键
+     * @param outResults 输出网格（未上传）、名称与额外数据；material 为空
+     * @param outMaterials 输出与 outResults 一一对应的材质描述
+     * @return 命中且数据有效返回 true
+     */
+    bool Load(uint64_t key,
+              std::vector<MeshImportResult>& outResults,
+              std::vector<MeshMaterialDesc>& outMaterials);
+    
+    /**
+     * @brief 只读取缓存文件中单个网格的顶点与索引（不计入命中统计）
+     * 
+     * 用于重新读取按 MeshCPUResidency 释放的 CPU 数据，仅映射目标网格的数据块。
+     * @param meshIndex 网格在导入结果中的序号
+     * @return 文件存在且数据有效返回 true
+     */
+    bool LoadMeshData(uint64_t key, uint32_t meshIndex,
+                      std::vector<Vertex>& outVertices,
+                      std::vector<uint32_t>& outIndices) const;
+    
+    /**
+     * @brief 创建从缓存文件读取指定网格的 Mesh 数据源（见 Mesh::SetCPUDataSource）
+     */
+    static Mesh::CPUDataSource MakeCPUDataSource(uint64_t key, uint32_t meshIndex);
+    
+    /**
+     * @brief 写入缓存
+     * @param key 缓存键
+     * @param results 导入结果（pendingTextureRequests 与 material 不写入）
+     * @param materials 对应材质描述（可为空，视为无材质）
+     * @return 写入成功返回 true
+     */
+    bool Store(uint64_t key,
+               const std::vector<MeshImportResult>& results,
+               const std::vector<MeshMaterialDesc>& materials);
+    
+    /**
+     * @brief 删除缓存目录下所有 .meshc 文件
+     * @return 删除的文件数
+     */
+    size_t ClearDiskCache();
+    
+    [[nodiscard]] Stats GetStats() const;
+    void ResetStats();
+
+private:
+    MeshCache() = default;
+    ~MeshCache() = default;
+    MeshCache(const MeshCache&) = delete;
+    MeshCache& operator=(const MeshCache&) = delete;
+    
+    mutable std::mutex m_directoryMutex;
+    std::string m_directory = "cache/mesh";
+    std::atomic<bool> m_enabled{true};
+    
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+    std::atomic<size_t> m_writes{0};
+};
+
+} // namespace Render
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/mesh.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Render {
+
+struct VertexBoneWeight;
+
+/**
+ * @brief 网格导入后处理内核（纯 CPU，可在任意线程调用）
+ * 
+ * 切线内核直接从 Vertex 数组读取位置 / UV，累加到每线程复用的紧凑缓冲，按 8 个三角形 / 8 个顶点
+ * 一组计算（AVX2 可用时使用 gather + 8 宽运算，否则逐元素回退）。累加顺序与 Mesh::RecalculateTangents
+ * 原有的逐顶点实现相同，但 AVX2 路径使用 FMA，结果只在舍入误差内一致，不保证逐位相同。
+ * 骨骼权重内核使用扁平数组（CSR）保存每个顶点的权重，避免逐顶点的小向量分配。
+ */
+namespace MeshKernels {
+
+/**
+ * @brief 由位置与 UV 重新计算切线空间（累加三角形切线后做 Gram-Schmidt 正交化）
+ * @param vertices 顶点数组（法线同时被归一化）
+ * @param vertexCount 顶点数
+ * @param indices 三角形索引；为空时每 3 个顶点组成一个三角形
+ * @param indexCount 索引数
+ * 
+ * 越界索引的三角形和 UV 退化的三角形被跳过；没有有效切线的顶点使用 X 轴
+ */
+void ComputeTangents(Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount);
+
+/**
+ * @brief 对已有切线做 Gram-Schmidt 正交化（导入的切线），副切线由法线与切线叉乘得到并保留手性
+ */
+void OrthonormalizeTangents(Vertex* vertices, size_t vertexCount);
+
+/**
+ * @brief 限制并归一化每个顶点的骨骼权重（原地压缩 CSR 数组）
+ * @param offsets 顶点 v 的权重位于 weights[offsets[v], offsets[v+1])，长度为顶点数 + 1
+ * @param weights 所有顶点的权重；超过 maxWeights 时按权重降序保留前 maxWeights 个
+ * @param maxWeights 每个顶点的最大权重数（0 表示不限制）
+ * @param normalize 是否把每个顶点的权重之和归一化为 1
+ * 
+ * 未超过限制的顶点保持原有顺序
+ */
+void LimitBoneWeights(std::vector<uint32_t>& offsets,
+                      std::vector<VertexBoneWeight>& weights,
+                      uint32_t maxWeights,
+                      bool normalize);
+
+} // namespace MeshKernels
+
+} // namespace Render
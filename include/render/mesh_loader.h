@@ -118,6 +118,35 @@ struct MeshExtraData {
     std::vector<MaterialTextureRequest> pendingTextureRequests; ///< 延迟加载的纹理请求
 };
 
+/**
+ * @brief 材质引用的纹理（相对于模型目录的路径）
+ */
+struct MeshMaterialTextureRef {
+    std::string slotName;      ///< 材质槽位（diffuseMap / specularMap / normalMap / aoMap / emissiveMap）
+    std::string relativePath;  ///< 模型文件中记录的纹理路径
+};
+
+/**
+ * @brief 与导入器无关的材质描述
+ * 
+ * 导入时从 Assimp 材质提取，再由 MeshLoader 创建 Material；二进制网格缓存（MeshCache）
+ * 保存此描述，缓存命中时无需 Assimp 即可重建材质。未设置的属性保持 Material 默认值。
+ */
+struct MeshMaterialDesc {
+    bool valid = false;                     ///< 网格是否引用了材质
+    uint32_t materialIndex = 0;             ///< 源文件中的材质索引
+    std::string name;                       ///< 材质名称
+    std::optional<Color> ambientColor;
+    std::optional<Color> diffuseColor;
+    std::optional<Color> specularColor;
+    std::optional<Color> emissiveColor;
+    std::optional<float> shininess;
+    std::optional<float> opacity;
+    std::optional<float> metallic;
+    std::optional<float> roughness;
+    std::vector<MeshMaterialTextureRef> textures;
+};
+
 /**
  * @brief 导入选项
  */
@@ -125,6 +154,8 @@ struct MeshImportOptions {
     bool flipUVs = true;                       ///< 是否翻转UV（OpenGL约定）
     bool autoUpload = true;                    ///< 是否自动上传到GPU
     bool loadMaterials = false;                ///< 是否加载材质和纹理
+    bool useBinaryCache = false;               ///< 使用二进制网格缓存（MeshCache）：首次导入后写入，之后内存映射加载
+    MeshCPUResidency cpuResidency = MeshCPUResidency::Keep;  ///< 上传后的 CPU 数据驻留策略（启用缓存时释放的数据可从缓存文件重新读取）
 
     // Assimp 后处理配置
     bool triangulate = true;
@@ -140,6 +171,9 @@ struct MeshImportOptions {
     bool findInvalidData = true;
     bool populateArmatureData = true;
 
+    // 网格优化：顶点缓存 / overdraw / 顶点获取顺序（MeshOptimizer，启用时跳过 improveCacheLocality）
+    bool runMeshOptimizer = true;
+
     // 数据采集配置
     bool gatherAdditionalUVs = true;
     bool gatherVertexColors = true;
@@ -201,11 +235,14 @@ public:
      * - 法线会自动生成（如果文件中不包含）
      * 
      * ⭐ v0.12.0 新增autoUpload参数，支持异步资源加载
+     * 
+     * @param useBinaryCache 是否使用二进制网格缓存（见 MeshCache），命中时跳过 Assimp 导入
      */
     static std::vector<Ref<Mesh>> LoadFromFile(
         const std::string& filepath,
         bool flipUVs = true,
-        bool autoUpload = true
+        bool autoUpload = true,
+        bool useBinaryCache = false
     );
     
     /**
@@ -257,6 +294,10 @@ public:
      * @param basePath 纹理搜索路径（可选）
      * @param shader 材质绑定的着色器（可选，仅当 options.loadMaterials=true 时使用）
      * @return 包含额外导入数据的网格结果列表
+     * 
+     * options.useBinaryCache 为 true 时，先按源文件内容哈希与导入选项查找 MeshCache，
+     * 命中则直接从内存映射的缓存文件构建网格（含蒙皮、多 UV/颜色通道与材质引用）；
+     * 未命中时正常导入并写入缓存。
      */
     static std::vector<MeshImportResult> LoadDetailedFromFile(
         const std::string& filepath,
@@ -312,6 +353,18 @@ public:
     // ========================================================================
     // 基本几何形状生成
     // ========================================================================
+    /**
+     * @brief 设置生成的几何体是否经过 MeshOptimizer 优化（默认开启）
+     * 
+     * 优化会重排三角形与顶点顺序；需要按生成顺序访问顶点（如按行列修改平面顶点）时可关闭
+     */
+    static void SetOptimizeGeneratedMeshes(bool enabled);
+    
+    /**
+     * @brief 生成的几何体是否经过 MeshOptimizer 优化
+     */
+    static bool IsOptimizeGeneratedMeshesEnabled();
+    
     /**
      * @brief 创建平面（Plane）
      * @param width 宽度
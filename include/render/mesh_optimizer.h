@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/types.h"
+#include "render/mesh.h"
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief 网格优化选项
+ */
+struct MeshOptimizeOptions {
+    bool vertexCache = true;          ///< 重排三角形以提高顶点缓存命中（meshopt_optimizeVertexCache）
+    bool overdraw = true;             ///< 在缓存效率允许的范围内按朝向重排以减少 overdraw
+    float overdrawThreshold = 1.05f;  ///< 允许 ACMR 变差的比例上限（1.05 = 最多变差 5%）
+    bool vertexFetch = true;          ///< 按首次使用顺序重排顶点并丢弃未引用的顶点
+};
+
+/**
+ * @brief 顶点缓存 / 顶点获取统计
+ */
+struct MeshOptimizeStats {
+    float acmr = 0.0f;       ///< 平均每个三角形变换的顶点数（理想值 ~0.5，最差 3）
+    float atvr = 0.0f;       ///< 变换顶点数 / 顶点总数（理想值 1）
+    float overfetch = 0.0f;  ///< 读取字节数 / 顶点缓冲大小（理想值 1）
+};
+
+/**
+ * @brief 网格顶点 / 索引顺序优化
+ * 
+ * 使用 meshoptimizer 依次执行顶点缓存优化、overdraw 优化与顶点获取优化。只修改 CPU 端数组，
+ * 不改变几何形状，可在任意线程调用。MeshLoader 的导入与几何体生成、LODGenerator 的简化结果
+ * 在创建 Mesh 前都会经过此步骤。
+ * 
+ * **使用示例**：
+ * @code
+ * MeshOptimizeStats before = MeshOptimizer::Analyze(vertices, indices);
+ * MeshOptimizer::Optimize(vertices, indices);
+ * MeshOptimizeStats after = MeshOptimizer::Analyze(vertices, indices);
+ * @endcode
+ */
+class MeshOptimizer {
+public:
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t kAnalyzeCacheSize = 16;  ///< 统计时模拟的 FIFO 顶点缓存大小
+    
+    /**
+     * @brief 优化顶点与索引顺序
+     * @param vertexRemap 非空且执行了顶点获取优化时，输出 旧顶点下标 -> 新顶点下标
+     *                    （未被引用的顶点为 kInvalidIndex），用于同步重排其他逐顶点数据；否则清空
+     * @return 是否执行了优化（索引数不是 3 的倍数或存在越界索引时返回 false，数据保持不变）
+     */
+    static bool Optimize(std::vector<Vertex>& vertices,
+                         std::vector<uint32_t>& indices,
+                         const MeshOptimizeOptions& options = {},
+                         std::vector<uint32_t>* vertexRemap = nullptr);
+    
+    /**
+     * @brief 统计 ACMR / ATVR / overfetch
+     * @return 输入无效时返回全 0
+     */
+    static MeshOptimizeStats Analyze(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+    
+    /**
+     * @brief 统计网格 CPU 端数据
+     */
+    static MeshOptimizeStats Analyze(const Mesh& mesh);
+    
+    /**
+     * @brief 按 Optimize 输出的重映射表重排逐顶点数据（UV / 颜色通道、蒙皮权重等）
+     * @param newVertexCount 优化后的顶点数
+     */
+    template <typename T, typename Allocator>
+    static void RemapVertexAttribute(std::vector<T, Allocator>& values,
+                                     const std::vector<uint32_t>& vertexRemap,
+                                     size_t newVertexCount) {
+        if (vertexRemap.empty() || values.size() != vertexRemap.size()) {
+            return;
+        }
+        std::vector<T, Allocator> remapped(newVertexCount);
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (vertexRemap[i] != kInvalidIndex) {
+                remapped[vertexRemap[i]] = std::move(values[i]);
+            }
+        }
+        values.swap(remapped);
+    }
+};
+
+} // namespace Render
+
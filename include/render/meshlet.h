@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/types.h"
+#include "render/mesh.h"
+#include <cstdint>
+#include <vector>
+
+namespace Render {
+
+struct Frustum;
+
+/**
+ * @brief Meshlet 构建选项
+ */
+struct MeshletBuildOptions {
+    size_t maxVertices = 64;     ///< 每个 meshlet 最大顶点数（≤ 255）
+    size_t maxTriangles = 124;   ///< 每个 meshlet 最大三角形数（≤ 512，向下取整到 4 的倍数）
+    float coneWeight = 0.25f;    ///< 法线锥权重（0-1，越大簇越紧凑朝向越一致，背面剔除率越高）
+    bool optimize = true;        ///< 是否对每个 meshlet 内部做顶点缓存重排
+};
+
+/**
+ * @brief 单个 meshlet（与 meshopt_Meshlet 布局一致）
+ */
+struct Meshlet {
+    uint32_t vertexOffset = 0;    ///< 在 MeshletData::vertices 中的起始位置
+    uint32_t triangleOffset = 0;  ///< 在 MeshletData::triangles 中的起始位置（字节）
+    uint32_t vertexCount = 0;     ///< 顶点数
+    uint32_t triangleCount = 0;   ///< 三角形数
+};
+
+/**
+ * @brief Meshlet 包围球与法线锥（网格局部空间）
+ */
+struct MeshletBounds {
+    Vector3 center = Vector3::Zero();    ///< 包围球中心
+    float radius = 0.0f;                 ///< 包围球半径
+    Vector3 coneApex = Vector3::Zero();  ///< 法线锥顶点
+    Vector3 coneAxis = Vector3::UnitZ(); ///< 法线锥轴
+    float coneCutoff = 1.0f;             ///< 法线锥截断值（≥ 1 表示锥体退化，不做背面剔除）
+};
+
+/**
+ * @brief 网格的 meshlet（簇）数据
+ * 
+ * 每个 meshlet 引用至多 maxVertices 个网格顶点（vertices 中为网格顶点索引），
+ * 三角形以 meshlet 内的 8 位局部索引存储在 triangles 中
+ */
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<MeshletBounds> bounds;   ///< 与 meshlets 一一对应
+    std::vector<uint32_t> vertices;      ///< meshlet 局部顶点 → 网格顶点索引
+    std::vector<uint8_t> triangles;      ///< 每个三角形 3 个局部索引
+    std::vector<uint32_t> indexOffsets;  ///< 每个 meshlet 在按簇排序的索引缓冲区中的起始索引（见 Mesh::DrawMeshletRanges）
+    size_t triangleCount = 0;            ///< 源网格三角形数
+    
+    [[nodiscard]] size_t GetMeshletCount() const { return meshlets.size(); }
+    [[nodiscard]] bool IsEmpty() const { return meshlets.empty(); }
+    [[nodiscard]] size_t GetMemoryUsage() const {
+        return meshlets.size() * sizeof(Meshlet) + bounds.size() * sizeof(MeshletBounds) +
+               vertices.size() * sizeof(uint32_t) + triangles.size() +
+               indexOffsets.size() * sizeof(uint32_t);
+    }
+};
+
+/**
+ * @brief Meshlet 构建器
+ * 
+ * 使用 meshoptimizer（meshopt_buildMeshlets / meshopt_computeMeshletBounds）把网格划分为
+ * 顶点与三角形数受限的簇，并计算每簇的包围球和法线锥，供 MeshletCuller 做簇级剔除。
+ * 
+ * **使用示例**：
+ * @code
+ * MeshletBuilder::BuildForMesh(buildingMesh);   // 结果保存在 Mesh 上
+ * auto meshlets = buildingMesh->GetMeshlets();
+ * @endcode
+ * 
+ * @note 构建只读取 CPU 端数据，可在任意线程调用
+ */
+class MeshletBuilder {
+public:
+    /**
+     * @brief 从顶点与索引数据构建 meshlet
+     * @return meshlet 数据；输入无效时返回 nullptr
+     */
+    static Ref<MeshletData> Build(const std::vector<Vertex>& vertices,
+                                  const std::vector<uint32_t>& indices,
+                                  const MeshletBuildOptions& options = {});
+    
+    /**
+     * @brief 为网格构建 meshlet 并通过 Mesh::SetMeshlets 保存
+     * @return 是否成功
+     */
+    static bool BuildForMesh(const Ref<Mesh>& mesh, const MeshletBuildOptions& options = {});
+};
+
+/**
+ * @brief Meshlet 剔除统计
+ */
+struct MeshletCullStats {
+    size_t objectsTested = 0;          ///< 测试的对象数
+    size_t meshletsTested = 0;         ///< 测试的 meshlet 数
+    size_t meshletsFrustumCulled = 0;  ///< 被视锥体剔除的 meshlet 数
+    size_t meshletsBackfaceCulled = 0; ///< 被法线锥（背面）剔除的 meshlet 数
+    size_t trianglesTotal = 0;         ///< 测试对象的三角形总数
+    size_t trianglesSubmitted = 0;     ///< 输出的三角形数
+    
+    void Reset() { *this = MeshletCullStats{}; }
+    
+    void Accumulate(const MeshletCullStats& other) {
+        objectsTested += other.objectsTested;
+        meshletsTested += other.meshletsTested;
+        meshletsFrustumCulled += other.meshletsFrustumCulled;
+        meshletsBackfaceCulled += other.meshletsBackfaceCulled;
+        trianglesTotal += other.trianglesTotal;
+        trianglesSubmitted += other.trianglesSubmitted;
+    }
+};
+
+/**
+ * @brief CPU 簇级剔除
+ * 
+ * 对每个 meshlet 做视锥体（包围球）和背面（法线锥）测试，把可见 meshlet 的三角形展开为
+ * 网格顶点索引，输出紧凑的索引列表，可直接作为该对象本帧的索引缓冲区提交。
+ * 
+ * **背面测试**（世界空间）：dot(normalize(apex - cameraPosition), axis) >= cutoff 时整簇背向相机。
+ * 法线锥按模型矩阵的逆转置变换，非均匀缩放下为近似结果。
+ * 
+ * @note 线程安全：所有方法只读输入数据，可并发调用
+ */
+class MeshletCuller {
+public:
+    /**
+     * @brief 批量剔除的输入对象
+     */
+    struct Object {
+        const MeshletData* meshlets = nullptr;  ///< 对象网格的 meshlet 数据
+        Matrix4 model = Matrix4::Identity();    ///< 模型矩阵
+    };
+    
+    /**
+     * @brief 对象在输出索引列表中的区间
+     */
+    struct ObjectRange {
+        uint32_t indexOffset = 0;
+        uint32_t indexCount = 0;   ///< 0 表示对象完全被剔除
+    };
+    
+    /**
+     * @brief 剔除单个对象
+     * @param data meshlet 数据
+     * @param model 模型矩阵
+     * @param frustum 世界空间视锥体
+     * @param cameraPosition 相机世界坐标
+     * @param outIndices 输出：可见三角形的网格顶点索引（追加到末尾）
+     * @param stats 可选统计（累加）
+     * @return 追加的索引数
+     */
+    static size_t Cull(const MeshletData& data, const Matrix4& model, const Frustum& frustum,
+                       const Vector3& cameraPosition, std::vector<uint32_t>& outIndices,
+                       MeshletCullStats* stats = nullptr);
+    
+    /**
+     * @brief 剔除单个对象，输出可见 meshlet 的绘制区间
+     * 
+     * 区间指向 Mesh 按簇排序的索引缓冲区（indexOffsets），相邻的可见 meshlet 合并为一个区间，
+     * 结果可直接交给 Mesh::DrawMeshletRanges，无需逐帧展开和上传索引。
+     * 
+     * @param data meshlet 数据
+     * @param model 模型矩阵
+     * @param frustum 世界空间视锥体
+     * @param cameraPosition 相机世界坐标
+     * @param outRanges 输出：合并后的绘制区间（先清空）
+     * @param stats 可选统计（累加）
+     * @return 可见索引总数
+     */
+    static size_t CullRanges(const MeshletData& data, const Matrix4& model, const Frustum& frustum,
+                             const Vector3& cameraPosition, std::vector<MeshletDrawRange>& outRanges,
+                             MeshletCullStats* stats = nullptr);
+    
+    /**
+     * @brief 并行剔除多个对象
+     * 
+     * 两遍处理：先按块（可并行）测试 meshlet 并统计每个对象的索引数，前缀和确定区间后
+     * 再按块把可见 meshlet 直接展开到最终位置。TaskScheduler 已初始化且对象数较多时并行。
+     * 
+     * @param objects 输入对象
+     * @param frustum 世界空间视锥体
+     * @param cameraPosition 相机世界坐标
+     * @param outIndices 输出：所有对象的紧凑索引（先清空）
+     * @param outRanges 输出：每个对象的索引区间（与 objects 一一对应）
+     * @param stats 可选统计（累加）
+     */
+    static void CullBatch(const std::vector<Object>& objects, const Frustum& frustum,
+                          const Vector3& cameraPosition, std::vector<uint32_t>& outIndices,
+                          std::vector<ObjectRange>& outRanges, MeshletCullStats* stats = nullptr);
+    
+private:
+    /**
+     * @brief 测试对象的所有 meshlet，把可见 meshlet 下标追加到 outVisible
+     * @return 可见 meshlet 的索引总数
+     */
+    static size_t ClassifyMeshlets(const MeshletData& data, const Matrix4& model, const Frustum& frustum,
+                                   const Vector3& cameraPosition, std::vector<uint32_t>& outVisible,
+                                   MeshletCullStats& stats);
+};
+
+} // namespace Render
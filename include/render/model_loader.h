@@ -33,6 +33,8 @@ namespace Render {
 struct ModelLoadOptions {
     bool flipUVs = true;
     bool autoUpload = true;
+    bool useBinaryCache = false;                             // 见 MeshImportOptions::useBinaryCache
+    MeshCPUResidency cpuResidency = MeshCPUResidency::Keep;  // 见 MeshImportOptions::cpuResidency
 
     bool registerModel = true;
     bool registerMeshes = true;
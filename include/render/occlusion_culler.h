@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Render {
+
+class Mesh;
+
+/**
+ * @brief 软件遮挡剔除统计（每次 BeginFrame 重置）
+ */
+struct OcclusionStats {
+    size_t occluders = 0;              ///< 光栅化的遮挡体数量
+    size_t trianglesRasterized = 0;    ///< 光栅化的三角形数量
+    size_t trianglesSkipped = 0;       ///< 跨越近平面、退化或位于屏幕外而跳过的三角形数量
+    size_t occludeesTested = 0;        ///< 测试的包围盒数量
+    size_t occludeesOccluded = 0;      ///< 判定被遮挡的包围盒数量
+};
+
+/**
+ * @brief CPU 软件遮挡剔除器
+ *
+ * 每帧流程：BeginFrame(viewProjection) → RasterizeMesh/RasterizeTriangles（遮挡体）→ Finalize() → IsVisible(AABB)。
+ *
+ * - 深度缓冲为低分辨率（默认 256x128），保存 NDC 深度映射到 [0, 1] 后的最近值，清除值为 1（远平面）
+ * - 光栅化按行计算边函数，AVX2 可用时每次处理 8 个像素
+ * - Finalize() 生成 8x8 分块的最远深度，IsVisible 先用分块层快速判定，仅对不确定的分块逐像素比较
+ * - 结果是保守的：跨越近平面的遮挡三角形被跳过，跨越近平面或位于屏幕外的包围盒视为可见
+ *
+ * 完全在 CPU 上运行，不依赖 GL 上下文。非线程安全。
+ */
+class OcclusionCuller {
+public:
+    static constexpr uint32_t kTileSize = 8;
+
+    explicit OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+
+    /**
+     * @brief 设置深度缓冲分辨率（会清除当前帧数据）
+     */
+    void SetResolution(uint32_t width, uint32_t height);
+    [[nodiscard]] uint32_t GetWidth() const { return m_width; }
+    [[nodiscard]] uint32_t GetHeight() const { return m_height; }
+
+    /**
+     * @brief 开始新的一帧：清除深度缓冲并重置统计
+     * @param viewProjection 相机的视图投影矩阵
+     */
+    void BeginFrame(const Matrix4& viewProjection);
+
+    /**
+     * @brief 光栅化三角形列表形式的遮挡体
+     * @param positions 局部空间顶点位置
+     * @param vertexCount 顶点数量
+     * @param indices 三角形索引（每 3 个一组，越界的三角形被忽略）
+     * @param indexCount 索引数量
+     * @param worldMatrix 世界矩阵
+     */
+    void RasterizeTriangles(const Vector3* positions, size_t vertexCount,
+                            const uint32_t* indices, size_t indexCount,
+                            const Matrix4& worldMatrix);
+
+    /**
+     * @brief 光栅化网格（使用 CPU 端顶点/索引数据，无索引时按顺序每 3 个顶点组成三角形）
+     */
+    void RasterizeMesh(const Mesh& mesh, const Matrix4& worldMatrix);
+
+    /**
+     * @brief 结束遮挡体光栅化并生成分块深度，之后才能调用 IsVisible
+     */
+    void Finalize();
+
+    /**
+     * @brief 测试世界空间包围盒是否可能可见
+     * @return 被遮挡返回 false；未 Finalize 时总是返回 true
+     */
+    bool IsVisible(const AABB& worldBounds);
+
+    /**
+     * @brief 读取深度缓冲（调试/测试用）
+     */
+    [[nodiscard]] float GetDepth(uint32_t x, uint32_t y) const { return m_depth[y * m_stride + x]; }
+
+    [[nodiscard]] const OcclusionStats& GetStats() const { return m_stats; }
+
+private:
+    void RasterizeClipTriangles(const uint32_t* indices, size_t indexCount);
+    void RasterizeTriangle(const Vector4& c0, const Vector4& c1, const Vector4& c2);
+    bool IsRectVisibleInTile(uint32_t tileX, uint32_t tileY, int x0, int y0, int x1, int y1,
+                             float minDepth) const;
+
+    Matrix4 m_viewProjection = Matrix4::Identity();
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_stride = 0;          ///< 行跨度（按 8 像素对齐，便于 SIMD 整行处理）
+    uint32_t m_tilesX = 0;
+    uint32_t m_tilesY = 0;
+    std::vector<float> m_depth;
+    std::vector<float> m_tileMaxDepth;
+    std::vector<Vector4> m_clipScratch;
+    std::vector<uint32_t> m_indexScratch;
+    OcclusionStats m_stats;
+    bool m_finalized = false;
+};
+
+} // namespace Render
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/render_state.h"
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Render {
+
+/// 无效的管线状态对象 ID（PipelineStateId 定义见 render_state.h）
+constexpr PipelineStateId kInvalidPipelineState = 0;
+
+/**
+ * @brief 管线状态对象所接管的状态分组
+ *
+ * 未包含在掩码中的分组保持当前 GL 状态不变（例如材质不设置深度函数，
+ * 以免覆盖渲染层的 depthFunc 设置）。
+ */
+enum PipelineStateFields : uint32_t {
+    PipelineStateFields_None       = 0,
+    PipelineStateFields_DepthTest  = 1u << 0,
+    PipelineStateFields_DepthFunc  = 1u << 1,
+    PipelineStateFields_DepthWrite = 1u << 2,
+    PipelineStateFields_Blend      = 1u << 3,
+    PipelineStateFields_CullFace   = 1u << 4,
+    PipelineStateFields_Program    = 1u << 5,
+
+    PipelineStateFields_FixedFunction = PipelineStateFields_DepthTest |
+                                        PipelineStateFields_DepthFunc |
+                                        PipelineStateFields_DepthWrite |
+                                        PipelineStateFields_Blend |
+                                        PipelineStateFields_CullFace,
+    PipelineStateFields_All = PipelineStateFields_FixedFunction | PipelineStateFields_Program
+};
+
+/**
+ * @brief 不可变管线状态描述（混合/深度/剔除/着色器程序组合）
+ */
+struct PipelineStateDesc {
+    uint32_t fields = PipelineStateFields_None;   ///< 接管的状态分组（PipelineStateFields）
+    bool depthTest = true;
+    DepthFunc depthFunc = DepthFunc::Less;
+    bool depthWrite = true;
+    BlendMode blendMode = BlendMode::None;
+    uint32_t blendSrcFactor = 0x0302;  // GL_SRC_ALPHA
+    uint32_t blendDstFactor = 0x0303;  // GL_ONE_MINUS_SRC_ALPHA
+    CullFace cullFace = CullFace::Back;
+    uint32_t program = 0;
+
+    /**
+     * @brief 返回规范化副本：未接管的分组重置为默认值，保证相同语义得到相同哈希
+     */
+    PipelineStateDesc Normalized() const noexcept;
+
+    bool operator==(const PipelineStateDesc& other) const noexcept;
+    bool operator!=(const PipelineStateDesc& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+struct PipelineStateDescHasher {
+    std::size_t operator()(const PipelineStateDesc& desc) const noexcept;
+};
+
+/**
+ * @brief 计算从 current 切换到 target 时需要实际修改的状态分组
+ *
+ * 仅比较 target 接管的分组；返回值为 PipelineStateFields 位掩码。
+ * 纯 CPU 逻辑，RenderState::ApplyPipelineState 使用相同规则。
+ */
+uint32_t DiffPipelineState(const PipelineStateDesc& current, const PipelineStateDesc& target) noexcept;
+
+/**
+ * @brief 统计掩码中包含的状态分组数量
+ */
+uint32_t CountPipelineStateFields(uint32_t fields) noexcept;
+
+/**
+ * @brief 管线状态对象注册表
+ *
+ * 将状态组合驻留（intern）为稳定 ID。对象创建后不可修改，也不会被释放，
+ * 因此 Find() 返回的指针在程序生命周期内有效。
+ *
+ * 线程安全：所有公共方法都是线程安全的（读写锁）。
+ */
+class PipelineStateRegistry {
+public:
+    static PipelineStateRegistry& GetInstance();
+
+    /**
+     * @brief 获取（必要时创建）状态组合对应的 ID
+     */
+    PipelineStateId Acquire(const PipelineStateDesc& desc);
+
+    /**
+     * @brief 按 ID 查找状态描述，ID 无效时返回 nullptr
+     */
+    const PipelineStateDesc* Find(PipelineStateId id) const;
+
+    /**
+     * @brief 已注册的状态对象数量
+     */
+    size_t GetCount() const;
+
+private:
+    PipelineStateRegistry() = default;
+
+    mutable std::shared_mutex m_mutex;
+    std::deque<PipelineStateDesc> m_states;  ///< 下标 + 1 即 ID；deque 保证元素地址稳定
+    std::unordered_map<PipelineStateDesc, PipelineStateId, PipelineStateDescHasher> m_lookup;
+};
+
+} // namespace Render
@@ -223,6 +223,7 @@ private:
     std::vector<BatchableItem> m_items;
     std::vector<Vertex> m_cpuVertices;
     std::vector<uint32_t> m_cpuIndices;
+    std::vector<size_t> m_directDrawItems;  // CPU 数据未常驻的网格：不参与 CPU 合并，在批次内逐个绘制
     uint32_t m_indexCount = 0;
     bool m_gpuResourcesReady = false;
     uint32_t m_drawVertexCount = 0;
@@ -72,6 +72,14 @@ enum class BufferTarget {
     ShaderStorageBuffer // SSBO
 };
 
+/**
+ * @brief 管线状态对象 ID
+ *
+ * 由 PipelineStateRegistry 分配（见 pipeline_state.h），0 表示无效。
+ * 相同的状态组合总是得到相同的 ID，因此绘制之间的状态比较只需要一次整数比较。
+ */
+using PipelineStateId = uint32_t;
+
 /**
  * @brief 渲染状态管理类
  * 
@@ -343,6 +351,47 @@ public:
      * @brief 检查投影矩阵是否已设置
      */
     bool IsProjectionMatrixSet() const;
+    
+    // ========================================================================
+    // 管线状态对象
+    // ========================================================================
+    
+    /**
+     * @brief 状态切换计数
+     * 
+     * applied：实际下发到 OpenGL 的状态分组数；skipped：因缓存命中而省略的分组数
+     */
+    struct StateChangeCounters {
+        uint32_t applied = 0;
+        uint32_t skipped = 0;
+    };
+    
+    /**
+     * @brief 应用管线状态对象
+     * 
+     * 与当前管线状态 ID 相同时直接跳过（一次整数比较）；
+     * 否则只对与缓存值不同的状态分组调用 OpenGL。
+     * 
+     * @param id PipelineStateRegistry 分配的 ID
+     */
+    void ApplyPipelineState(PipelineStateId id);
+    
+    /**
+     * @brief 获取最近一次应用且仍然有效的管线状态 ID
+     * 
+     * 通过单项 Setter 修改状态后返回 kInvalidPipelineState
+     */
+    PipelineStateId GetCurrentPipelineState() const;
+    
+    /**
+     * @brief 获取状态切换计数
+     */
+    StateChangeCounters GetStateChangeCounters() const;
+    
+    /**
+     * @brief 重置状态切换计数（通常在每帧开始时调用）
+     */
+    void ResetStateChangeCounters();
 
 private:
     void ApplyDepthTest();
@@ -351,6 +400,9 @@ private:
     void ApplyBlendMode();
     void ApplyCullFace();
     
+    /// 记录一次单项状态设置的结果（调用时需持有写锁）
+    void RecordStateChange(bool applied);
+    
     uint32_t GetGLBufferTarget(BufferTarget target) const;
     
     // ========================================================================
@@ -393,6 +445,13 @@ private:
     // ========================================================================
     uint32_t m_currentProgram;
     
+    // ========================================================================
+    // 管线状态对象
+    // ========================================================================
+    PipelineStateId m_currentPipelineState;
+    uint64_t m_programBindEpoch;  ///< 上次同步时的 Shader::GetBindEpoch()，用于检测绕过缓存的 glUseProgram
+    StateChangeCounters m_stateChangeCounters;
+    
     // ========================================================================
     // 相机矩阵状态
     // ========================================================================
@@ -428,6 +428,26 @@ public:
      */
     [[nodiscard]] bool GetReceiveShadows() const;
     
+    // ==================== Meshlet 剔除 ====================
+    
+    /**
+     * @brief 设置本帧可见的 meshlet 绘制区间（由 MeshRenderSystem 的 meshlet 剔除写入）
+     * 
+     * 非空时 Render 通过 Mesh::DrawMeshletRanges 只绘制这些区间，且对象不参与合批/实例化。
+     * @param ranges MeshletCuller::CullRanges 的输出
+     */
+    void SetMeshletRanges(const std::vector<MeshletDrawRange>& ranges);
+    
+    /**
+     * @brief 清除 meshlet 绘制区间（恢复绘制完整网格）
+     */
+    void ClearMeshletRanges();
+    
+    /**
+     * @brief 是否设置了 meshlet 绘制区间
+     */
+    [[nodiscard]] bool HasMeshletRanges() const;
+    
     // ==================== 包围盒 ====================
     
     [[nodiscard]] AABB GetBoundingBox() const override;
@@ -438,6 +458,7 @@ private:
     MaterialOverride m_materialOverride;  ///< 材质属性覆盖
     bool m_castShadows = true;            ///< 是否投射阴影
     bool m_receiveShadows = true;         ///< 是否接收阴影
+    std::vector<MeshletDrawRange> m_meshletRanges;  ///< 可见 meshlet 区间（空表示绘制完整网格）
 };
 
 /**
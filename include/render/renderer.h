@@ -61,8 +61,14 @@ struct RenderStats {
     float workerWaitTimeMs = 0.0f;
     uint32_t materialSwitchesOriginal = 0;
     uint32_t materialSwitchesSorted = 0;
+    uint32_t stateChangesApplied = 0;     ///< 实际下发到 OpenGL 的渲染状态分组数
+    uint32_t stateChangesSkipped = 0;     ///< 因状态缓存/管线状态 ID 命中而省略的分组数
     uint32_t materialSortKeyReady = 0;
     uint32_t materialSortKeyMissing = 0;
+    uint32_t visibleMeshes = 0;           ///< MeshRenderSystem 提交的可见网格数
+    uint32_t culledMeshes = 0;            ///< 视锥体/距离剔除的网格数
+    uint32_t occludedMeshes = 0;          ///< 软件遮挡剔除的网格数（不计入 culledMeshes）
+    uint32_t occluders = 0;               ///< 光栅化到遮挡深度缓冲的遮挡体数
     
     void Reset() {
         drawCalls = 0;
@@ -82,8 +88,14 @@ struct RenderStats {
         workerWaitTimeMs = 0.0f;
         materialSwitchesOriginal = 0;
         materialSwitchesSorted = 0;
+        stateChangesApplied = 0;
+        stateChangesSkipped = 0;
         materialSortKeyReady = 0;
         materialSortKeyMissing = 0;
+        visibleMeshes = 0;
+        culledMeshes = 0;
+        occludedMeshes = 0;
+        occluders = 0;
     }
 };
 
@@ -380,6 +392,18 @@ public:
      */
     void UpdateLODInstancingStats(const LODInstancingStats& stats);
     
+    /**
+     * @brief 累加本帧的剔除统计（由 MeshRenderSystem 调用）
+     * @param visibleMeshes 可见网格数
+     * @param culledMeshes 视锥体/距离剔除的网格数
+     * @param occludedMeshes 遮挡剔除的网格数
+     * @param occluders 遮挡体数
+     * 
+     * @note 计数写入当前帧的 RenderStats，在 BeginFrame 时清零，EndFrame 后可通过 GetStats() 读取
+     */
+    void AddCullingStats(uint32_t visibleMeshes, uint32_t culledMeshes,
+                         uint32_t occludedMeshes, uint32_t occluders);
+    
     /**
      * @brief 检查 LOD 实例化渲染是否可用
      * 
@@ -69,7 +69,9 @@ struct ResourceStats {
     size_t totalCount = 0;
     
     size_t textureMemory = 0;    // 纹理内存（字节）
-    size_t meshMemory = 0;        // 网格内存（字节）
+    size_t meshMemory = 0;        // 网格内存（字节，CPU + GPU）
+    size_t meshCPUMemory = 0;     // 网格 CPU 端常驻数据（字节，受 MeshCPUResidency 影响）
+    size_t meshGPUMemory = 0;     // 网格 GPU 缓冲（字节）
     size_t totalMemory = 0;       // 总内存（字节）
 };
 
@@ -40,7 +40,8 @@ class Shader;
  */
 struct ResourceMemoryStats {
     size_t textureMemory = 0;      ///< 纹理占用内存（字节）
-    size_t meshMemory = 0;         ///< 网格占用内存（字节）
+    size_t meshMemory = 0;         ///< 网格 GPU 缓冲占用内存（字节）
+    size_t meshCPUMemory = 0;      ///< 网格 CPU 端常驻数据（字节，随 MeshCPUResidency 释放而减少，不计入 totalMemory）
     size_t shaderMemory = 0;       ///< 着色器占用内存（字节）
     size_t bufferMemory = 0;       ///< GPU 缓冲占用内存（字节）
     size_t totalMemory = 0;        ///< 总内存占用（字节）
@@ -53,6 +54,7 @@ struct ResourceMemoryStats {
     void Reset() {
         textureMemory = 0;
         meshMemory = 0;
+        meshCPUMemory = 0;
         shaderMemory = 0;
         bufferMemory = 0;
         totalMemory = 0;
@@ -72,7 +74,8 @@ struct ResourceMemoryStats {
  */
 struct ResourceInfo {
     std::string name;              ///< 资源名称/路径
-    size_t memorySize = 0;         ///< 内存占用（字节）
+    size_t memorySize = 0;         ///< 内存占用（字节；网格为 GPU 缓冲）
+    size_t cpuMemorySize = 0;      ///< CPU 端常驻内存（字节，仅网格）
     uint32_t width = 0;            ///< 宽度（纹理）
     uint32_t height = 0;           ///< 高度（纹理）
     uint32_t vertexCount = 0;      ///< 顶点数（网格）
@@ -159,6 +162,8 @@ public:
     
     /**
      * @brief 获取所有网格信息
+     * 
+     * 内存按查询时的网格状态计算（上传或按驻留策略释放 CPU 数据后会变化）
      * @return 网格信息列表
      */
     std::vector<ResourceInfo> GetMeshInfoList() const;
@@ -94,6 +94,14 @@ public:
      */
     void Unuse() const;
     
+    /**
+     * @brief 获取程序绑定纪元号
+     * 
+     * 每次 Use()/Unuse() 直接调用 glUseProgram 时递增，
+     * RenderState 据此判断其缓存的程序绑定是否仍然有效
+     */
+    static uint64_t GetBindEpoch();
+    
     /**
      * @brief 检查着色器是否有效
      */
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief std140 布局支持的成员类型
+ */
+enum class Std140Type : uint8_t {
+    Int,
+    Bool,    ///< GLSL bool 在 std140 中占 4 字节
+    Float,
+    Vec2,
+    Vec3,
+    Vec4,
+    IVec4,
+    Mat3,    ///< 3 列 vec3，每列按 vec4 对齐（48 字节）
+    Mat4
+};
+
+/**
+ * @brief std140 布局中的一个成员
+ */
+struct Std140Member {
+    std::string name;
+    Std140Type type = Std140Type::Float;
+    uint32_t arraySize = 0;     ///< 0 表示非数组
+    uint32_t offset = 0;        ///< 相对块起始的字节偏移
+    uint32_t arrayStride = 0;   ///< 数组元素步长（非数组为 0）
+    uint32_t size = 0;          ///< 成员占用的总字节数
+};
+
+/**
+ * @brief std140 布局计算器（纯 CPU）
+ *
+ * 按 GLSL std140 规则依次追加成员并计算偏移：
+ * - 标量 4 字节对齐，vec2 8 字节，vec3/vec4 16 字节
+ * - 数组元素与矩阵列的对齐和步长向上取整到 16 字节
+ * - 块总大小向上取整到 16 字节
+ */
+class Std140Layout {
+public:
+    /**
+     * @brief 追加成员
+     * @param arraySize 数组长度，0 表示非数组
+     * @return 成员索引（供 Std140Writer 使用）
+     */
+    uint32_t Add(const std::string& name, Std140Type type, uint32_t arraySize = 0);
+
+    /**
+     * @brief 按名称查找成员索引，未找到返回 -1
+     */
+    int32_t Find(const std::string& name) const;
+
+    const Std140Member& GetMember(uint32_t index) const { return m_members[index]; }
+    const std::vector<Std140Member>& GetMembers() const { return m_members; }
+
+    /**
+     * @brief 块大小（已按 16 字节取整，可直接作为缓冲大小）
+     */
+    uint32_t GetSize() const;
+
+    /**
+     * @brief 类型的基础对齐（数组元素会额外向上取整到 16）
+     */
+    static uint32_t GetBaseAlignment(Std140Type type);
+
+    /**
+     * @brief 单个元素占用的字节数
+     */
+    static uint32_t GetTypeSize(Std140Type type);
+
+private:
+    std::vector<Std140Member> m_members;
+    uint32_t m_cursor = 0;
+};
+
+/**
+ * @brief 按 std140 布局把数据写入字节缓冲
+ *
+ * 写入时会校验成员类型与数组下标，不匹配的写入被忽略。
+ */
+class Std140Writer {
+public:
+    explicit Std140Writer(const Std140Layout& layout);
+
+    void SetInt(uint32_t member, int value, uint32_t arrayIndex = 0);
+    void SetBool(uint32_t member, bool value, uint32_t arrayIndex = 0);
+    void SetFloat(uint32_t member, float value, uint32_t arrayIndex = 0);
+    void SetVector2(uint32_t member, const Vector2& value, uint32_t arrayIndex = 0);
+    void SetVector3(uint32_t member, const Vector3& value, uint32_t arrayIndex = 0);
+    void SetVector4(uint32_t member, const Vector4& value, uint32_t arrayIndex = 0);
+    void SetIVector4(uint32_t member, int x, int y, int z, int w, uint32_t arrayIndex = 0);
+    void SetColor(uint32_t member, const Color& value, uint32_t arrayIndex = 0);
+    void SetMatrix3(uint32_t member, const Matrix3& value, uint32_t arrayIndex = 0);
+    void SetMatrix4(uint32_t member, const Matrix4& value, uint32_t arrayIndex = 0);
+
+    /**
+     * @brief 将缓冲清零
+     */
+    void Clear();
+
+    const uint8_t* GetData() const { return m_data.data(); }
+    size_t GetSize() const { return m_data.size(); }
+    const std::vector<uint8_t>& GetBuffer() const { return m_data; }
+
+private:
+    uint8_t* Locate(uint32_t member, Std140Type expected, uint32_t arrayIndex);
+
+    const Std140Layout& m_layout;
+    std::vector<uint8_t> m_data;
+};
+
+// ============================================================================
+// 帧数据块（FrameData，绑定点 0）
+// ============================================================================
+
+/// 帧数据块中各类光源的数量上限（与 material_phong 系列着色器保持一致）
+constexpr uint32_t kFrameMaxDirectionalLights = 4;
+constexpr uint32_t kFrameMaxPointLights = 8;
+constexpr uint32_t kFrameMaxSpotLights = 4;
+constexpr uint32_t kFrameMaxAmbientLights = 4;
+
+/**
+ * @brief 每帧只上传一次的相机/时间/光照数据
+ *
+ * 对应的 GLSL 声明见 shaders/material_phong_ubo.vert：
+ * @code
+ * layout(std140, binding = 0) uniform FrameData {
+ *     mat4  uView;
+ *     mat4  uProjection;
+ *     mat4  uViewProjection;
+ *     vec4  uCameraPosition;         // xyz = 相机位置
+ *     vec4  uTimeParams;             // x = 累计时间, y = 帧间隔
+ *     ivec4 uLightCounts;            // 方向光/点光/聚光/环境光数量
+ *     ivec4 uCulledLightCounts;      // 被剔除的光源数量
+ *     vec4  uDirectionalDirections[4];
+ *     vec4  uDirectionalColors[4];   // rgb = 颜色, a = 强度
+ *     vec4  uPointPositions[8];      // w = 范围
+ *     vec4  uPointColors[8];
+ *     vec4  uPointAttenuation[8];    // xyz = 常数/线性/二次衰减
+ *     vec4  uSpotPositions[4];       // w = 范围
+ *     vec4  uSpotColors[4];
+ *     vec4  uSpotDirections[4];      // w = 外锥角余弦
+ *     vec4  uSpotAttenuation[4];     // xyz = 衰减, w = 内锥角余弦
+ *     vec4  uAmbientColors[4];
+ *     vec4  uLegacyLightPosition;
+ *     vec4  uLegacyLightColor;       // a = 强度
+ *     vec4  uLegacyAmbientColor;
+ * };
+ * @endcode
+ */
+struct FrameUniformData {
+    Matrix4 view = Matrix4::Identity();
+    Matrix4 projection = Matrix4::Identity();
+    Vector3 cameraPosition = Vector3::Zero();
+    float time = 0.0f;
+    float deltaTime = 0.0f;
+
+    uint32_t directionalCount = 0;
+    uint32_t pointCount = 0;
+    uint32_t spotCount = 0;
+    uint32_t ambientCount = 0;
+
+    uint32_t culledDirectional = 0;
+    uint32_t culledPoint = 0;
+    uint32_t culledSpot = 0;
+    uint32_t culledAmbient = 0;
+
+    std::array<Vector4, kFrameMaxDirectionalLights> directionalDirections{};
+    std::array<Vector4, kFrameMaxDirectionalLights> directionalColors{};
+    std::array<Vector4, kFrameMaxPointLights> pointPositions{};
+    std::array<Vector4, kFrameMaxPointLights> pointColors{};
+    std::array<Vector4, kFrameMaxPointLights> pointAttenuation{};
+    std::array<Vector4, kFrameMaxSpotLights> spotPositions{};
+    std::array<Vector4, kFrameMaxSpotLights> spotColors{};
+    std::array<Vector4, kFrameMaxSpotLights> spotDirections{};
+    std::array<Vector4, kFrameMaxSpotLights> spotAttenuation{};
+    std::array<Vector4, kFrameMaxAmbientLights> ambientColors{};
+
+    Vector3 legacyLightPosition = Vector3::Zero();
+    Color legacyLightColor = Color::Black();
+    float legacyLightIntensity = 0.0f;
+    Color legacyAmbientColor = Color::Black();
+};
+
+/**
+ * @brief 帧数据块布局（进程内唯一）
+ */
+const Std140Layout& GetFrameUniformLayout();
+
+/**
+ * @brief 将帧数据打包为 std140 字节流（writer 必须使用 GetFrameUniformLayout() 构造）
+ */
+void PackFrameUniforms(const FrameUniformData& data, Std140Writer& writer);
+
+// ============================================================================
+// 材质数据块（MaterialData，绑定点 1）
+// ============================================================================
+
+/**
+ * @brief 材质常量，材质属性变化时重新打包
+ *
+ * 对应的 GLSL 声明：
+ * @code
+ * layout(std140, binding = 1) uniform MaterialData {
+ *     vec4 uMatAmbient;
+ *     vec4 uMatDiffuse;
+ *     vec4 uMatSpecular;
+ *     vec4 uMatEmissive;
+ *     vec4 uMatParams;   // x = shininess, y = opacity, z = metallic, w = roughness
+ * };
+ * @endcode
+ */
+struct MaterialUniformData {
+    Color ambient;
+    Color diffuse;
+    Color specular;
+    Color emissive = Color::Black();
+    float shininess = 32.0f;
+    float opacity = 1.0f;
+    float metallic = 0.0f;
+    float roughness = 0.5f;
+};
+
+/**
+ * @brief 材质数据块布局（进程内唯一）
+ */
+const Std140Layout& GetMaterialUniformLayout();
+
+/**
+ * @brief 将材质常量打包为 std140 字节流（writer 必须使用 GetMaterialUniformLayout() 构造）
+ */
+void PackMaterialUniforms(const MaterialUniformData& data, Std140Writer& writer);
+
+} // namespace Render
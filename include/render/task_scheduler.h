@@ -230,6 +230,24 @@ public:
      */
     void WaitForAll(const std::vector<std::shared_ptr<TaskHandle>>& handles);
     
+    /**
+     * @brief 并行执行 body(0..count-1)，返回时全部完成
+     * @param count 迭代次数
+     * @param body 迭代函数（各迭代之间不得有依赖）
+     * @param priority 辅助任务优先级
+     * @param name 任务名称（用于调试）
+     * 
+     * 调用线程也参与执行并只等待迭代完成（不等待辅助任务被调度），
+     * 因此可以在工作线程内部调用而不会死锁；未初始化或 count <= 1 时在调用线程串行执行。
+     * 
+     * 任一迭代抛出异常（任意类型）时，尚未开始的迭代被跳过，等待已开始的迭代结束后
+     * 在调用线程重新抛出第一个异常，与串行执行的行为一致。
+     */
+    void ParallelFor(size_t count,
+                     const std::function<void(size_t)>& body,
+                     TaskPriority priority = TaskPriority::Normal,
+                     const char* name = "ParallelFor");
+    
     /**
      * @brief 获取工作线程数量
      */
@@ -23,6 +23,8 @@
 #include <string>
 #include <memory>
 #include <mutex>
+#include <vector>
+#include <cstddef>
 #include <glad/glad.h>
 
 namespace Render {
@@ -55,7 +57,26 @@ enum class TextureFormat {
     RED,            // 单通道红色
     RG,             // 双通道
     Depth,          // 深度格式
-    DepthStencil    // 深度模板格式
+    DepthStencil,   // 深度模板格式
+
+    // 块压缩格式（4x4 像素为一块，由 TextureCompressor 在 CPU 端编码）
+    BC1,            // RGB，8 字节/块（DXT1，不透明）
+    BC3,            // RGBA，16 字节/块（DXT5，BC4 编码 Alpha）
+    BC4,            // 单通道，8 字节/块（RGTC1）
+    BC5,            // 双通道，16 字节/块（RGTC2，适合法线贴图 XY）
+    BC7             // RGBA，16 字节/块（BPTC）
+};
+
+/**
+ * @brief 预生成 mip 链中的单个级别
+ * 
+ * offset/size 指向同一块连续数据（级别按从大到小顺序排列）
+ */
+struct TextureMipLevel {
+    int width = 0;
+    int height = 0;
+    size_t offset = 0;   ///< 在数据块中的字节偏移
+    size_t size = 0;     ///< 字节数
 };
 
 /**
@@ -118,6 +139,65 @@ public:
      */
     bool CreateEmpty(int width, int height, TextureFormat format = TextureFormat::RGBA);
 
+    /**
+     * @brief 从预生成的 mip 链创建纹理（不调用 glGenerateMipmap）
+     * @param data 所有级别的连续数据；为 nullptr 时只分配各级别存储（内容未定义，随后由 UploadSubImage 填充）
+     * @param levels 各级别尺寸与偏移（levels[0] 为基础级别）
+     * @param format 纹理格式；块压缩格式通过 glCompressedTexImage2D 上传，其余按 RGBA8 等逐级上传
+     * @param storageBaseLevel 最精细的分配级别；更精细的级别定义为 0x0 不占显存，采样基础级别同时设为该值
+     * @return 是否创建成功（压缩格式不受当前 GL 支持时返回 false，见 IsFormatSupported）
+     */
+    bool CreateFromMipLevels(const void* data,
+                             const std::vector<TextureMipLevel>& levels,
+                             TextureFormat format,
+                             int storageBaseLevel = 0);
+
+    /**
+     * @brief 更新某个级别的整行区间（glTexSubImage2D / glCompressedTexSubImage2D）
+     * @param level mip 级别
+     * @param y 起始像素行（块压缩格式须为 4 的倍数）
+     * @param width 区间宽度（通常为级别宽度）
+     * @param height 像素行数
+     * @param data 区间数据；绑定 GL_PIXEL_UNPACK_BUFFER 时为缓冲内的字节偏移
+     * @param size 区间字节数（块压缩格式使用）
+     * @return 无 OpenGL 错误时返回 true
+     */
+    bool UploadSubImage(int level, int y, int width, int height, const void* data, size_t size);
+
+    /**
+     * @brief 限制采样使用的最精细级别（GL_TEXTURE_BASE_LEVEL 与 GL_TEXTURE_MIN_LOD）
+     * 
+     * 只修改采样参数，不重新分配存储，纹理 ID 与 GetWidth/GetHeight 保持不变。
+     * 用于 mip 流式加载：更精细的级别写入完成之前不被采样。
+     * @param level 基础级别（限制在 [0, GetMipLevelCount() - 1]）
+     * @return 纹理有效时返回 true
+     */
+    bool SetBaseLevel(int level);
+
+    /**
+     * @brief 调整已分配存储的最精细级别（仅限 CreateFromMipLevels 创建的纹理）
+     * 
+     * 降低时为新增级别分配存储（内容未定义，随后由 UploadSubImage 填充）；提高时把
+     * 更精细的级别重定义为 0x0 释放显存。不修改采样基础级别，调用方须保证
+     * SetBaseLevel 不低于该级别。纹理 ID 与 GetWidth/GetHeight 保持不变，
+     * GetMemoryUsage 只统计已分配的级别。
+     * @param level 最精细的分配级别（限制在 [0, GetMipLevelCount() - 1]）
+     * @return 无 OpenGL 错误时返回 true
+     */
+    bool SetStorageBaseLevel(int level);
+
+    /**
+     * @brief 获取已分配存储的最精细级别（未释放级别时为 0）
+     */
+    int GetStorageBaseLevel() const;
+
+    /**
+     * @brief 检查当前 OpenGL 上下文是否支持该格式（未压缩格式总是返回 true）
+     * 
+     * 根据 glad 加载时记录的扩展与版本判断，上下文初始化后可在任意线程调用
+     */
+    static bool IsFormatSupported(TextureFormat format);
+
     /**
      * @brief 绑定纹理到指定纹理单元
      * @param unit 纹理单元索引（0-31）
@@ -179,10 +259,15 @@ public:
     bool IsValid() const { return m_textureID != 0; }
 
     /**
-     * @brief 获取纹理内存使用量（估算，字节）
+     * @brief 获取纹理内存使用量（估算，字节；块压缩格式按块大小计算）
      */
     size_t GetMemoryUsage() const;
 
+    /**
+     * @brief 获取纹理的 mip 级别数（无 mip 时为 1）
+     */
+    int GetMipLevelCount() const;
+
 private:
     /**
      * @brief 转换纹理格式到 OpenGL 格式
@@ -210,6 +295,8 @@ private:
     int m_height;                ///< 纹理高度
     TextureFormat m_format;      ///< 纹理格式
     bool m_hasMipmap;            ///< 是否有 Mipmap
+    int m_mipLevelCount;         ///< 预生成 mip 链的级别数（0 表示由 GL 生成或无 mip）
+    int m_storageBaseLevel;      ///< 已分配存储的最精细级别（更精细的级别为 0x0）
     mutable std::mutex m_mutex;  ///< 线程安全互斥锁
 };
 
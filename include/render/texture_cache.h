@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/texture.h"
+#include "render/texture_compression.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief 压缩纹理磁盘缓存
+ * 
+ * 保存 TextureCompressor 的编码结果（块压缩数据 + 预生成 mip 链），缓存键由源图像文件
+ * 内容哈希、目标格式与 mip 选项共同决定。再次加载同一纹理时通过内存映射读取，跳过图像
+ * 解码、mip 生成与块编码，数据可直接交给 Texture::CreateFromMipLevels 上传。
+ * 
+ * **文件格式**（本机字节序，扩展名 .texc）：
+ * - 文件头：魔数 "RTEX"、版本、缓存键、格式、基础级别尺寸、级别数
+ * - 每个级别记录：宽、高、数据偏移、数据大小
+ * - 数据区：各级别压缩数据（从大到小连续排列）
+ * 
+ * **使用示例**：
+ * @code
+ * TextureCompressionOptions options;
+ * options.enabled = true;          // 由 TextureLoader 自动查找/写入缓存
+ * TextureLoader::GetInstance().SetCompressionOptions(options);
+ * @endcode
+ * 
+ * @note 线程安全：Load/Store 可在任意线程调用（通常在异步加载工作线程）；写入通过临时文件 + 重命名保证原子性
+ */
+class TextureCache {
+public:
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats {
+        size_t hits = 0;      ///< 命中次数
+        size_t misses = 0;    ///< 未命中次数
+        size_t writes = 0;    ///< 成功写入次数
+    };
+    
+    static TextureCache& GetInstance();
+    
+    /**
+     * @brief 设置缓存目录（默认 "cache/texture"，不存在时在首次写入时创建）
+     */
+    void SetCacheDirectory(const std::string& directory);
+    [[nodiscard]] std::string GetCacheDirectory() const;
+    
+    /**
+     * @brief 启用/禁用缓存（禁用时 Load 总是未命中，Store 不写入）
+     */
+    void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 组合源文件哈希与压缩选项得到缓存键
+     * 
+     * enabled 与 useDiskCache 不影响编码结果，不参与计算
+     */
+    static uint64_t BuildKey(uint64_t sourceHash, const TextureCompressionOptions& options, bool generateMipmap);
+    
+    /**
+     * @brief 获取缓存键对应的文件路径
+     */
+    [[nodiscard]] std::string GetCachePath(uint64_t key) const;
+    
+    /**
+     * @brief 从缓存加载压缩纹理
+     * @param outFormat 输出块压缩格式
+     * @param outData 输出所有级别的连续数据
+     * @param outLevels 输出各级别尺寸与偏移
+     * @return 命中且数据有效返回 true
+     */
+    bool Load(uint64_t key,
+              TextureFormat& outFormat,
+              std::vector<uint8_t>& outData,
+              std::vector<TextureMipLevel>& outLevels);
+    
+    /**
+     * @brief 写入缓存
+     * @return 写入成功返回 true
+     */
+    bool Store(uint64_t key,
+               TextureFormat format,
+               const std::vector<uint8_t>& data,
+               const std::vector<TextureMipLevel>& levels);
+    
+    /**
+     * @brief 删除缓存目录下所有 .texc 文件
+     * @return 删除的文件数
+     */
+    size_t ClearDiskCache();
+    
+    [[nodiscard]] Stats GetStats() const;
+    void ResetStats();
+
+private:
+    TextureCache() = default;
+    ~TextureCache() = default;
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+    
+    mutable std::mutex m_directoryMutex;
+    std::string m_directory = "cache/texture";
+    std::atomic<bool> m_enabled{true};
+    
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+    std::atomic<size_t> m_writes{0};
+};
+
+} // namespace Render
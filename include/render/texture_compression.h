@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/texture.h"
+#include <cstdint>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief 纹理压缩选项（TextureLoader 加载文件时使用）
+ */
+struct TextureCompressionOptions {
+    bool enabled = false;                        ///< 是否在加载时转换为块压缩格式
+    TextureFormat format = TextureFormat::BC7;   ///< 目标格式（BC1/BC3/BC4/BC5/BC7）
+    bool autoSelectFormat = true;                ///< 目标为 BC3/BC7 且图像完全不透明时改用 BC1（体积减半）
+    bool useDiskCache = true;                    ///< 将编码结果写入 TextureCache，后续加载直接读取
+};
+
+/**
+ * @brief 纹理块压缩编码器
+ * 
+ * 在 CPU 端将 RGBA8 图像编码为 BC1/BC3/BC4/BC5/BC7 块数据，并预生成 mip 链，
+ * 上传时通过 glCompressedTexImage2D 直接提交，显存占用为 RGBA8 的 1/8（BC1/BC4）或 1/4。
+ * 
+ * 编码策略（偏向速度，适合首次加载时在工作线程执行）：
+ * - BC1/BC3 颜色端点：主成分方向上的投影范围，再做一次最小二乘端点优化
+ * - BC4/BC5/BC3 Alpha：8 级插值模式，端点取块内最小/最大值
+ * - BC7：仅使用 mode 6（单子集 RGBA，7 位端点 + P 位，4 位索引）
+ * 
+ * 所有函数都是纯 CPU 实现，无 OpenGL 调用，可在任意线程使用。
+ * 
+ * @note Decode 用于单元测试与 GPU 不支持对应格式时的回退；BC7 仅支持解码 mode 6（即本编码器的输出）
+ */
+class TextureCompressor {
+public:
+    /**
+     * @brief 是否为块压缩格式
+     */
+    static bool IsBlockCompressed(TextureFormat format);
+    
+    /**
+     * @brief 每个 4x4 块的字节数（非压缩格式返回 0）
+     */
+    static size_t GetBytesPerBlock(TextureFormat format);
+    
+    /**
+     * @brief 计算单个级别的数据大小（压缩格式按块向上取整，非压缩格式按像素计算）
+     */
+    static size_t GetLevelSize(TextureFormat format, int width, int height);
+    
+    /**
+     * @brief 计算完整 mip 链的级别数（直到 1x1）
+     */
+    static int GetMipLevelCount(int width, int height);
+    
+    /**
+     * @brief 生成 RGBA8 mip 链（2x2 盒式滤波，奇数尺寸时边缘像素复用）
+     * @param rgba 基础级别像素（width * height * 4 字节）
+     * @param outPixels 输出所有级别的连续像素（包含基础级别）
+     * @param outLevels 输出各级别的尺寸与偏移
+     */
+    static void GenerateMipChain(const uint8_t* rgba, int width, int height,
+                                 std::vector<uint8_t>& outPixels,
+                                 std::vector<TextureMipLevel>& outLevels);
+    
+    /**
+     * @brief 编码单个级别
+     * @param out 输出缓冲，至少 GetLevelSize(format, width, height) 字节
+     * @return format 不是块压缩格式时返回 false
+     */
+    static bool EncodeLevel(TextureFormat format, const uint8_t* rgba, int width, int height, uint8_t* out);
+    
+    /**
+     * @brief 解码单个级别为 RGBA8
+     * @param outRgba 输出缓冲，至少 width * height * 4 字节
+     * @return 不支持的格式或 BC7 非 mode 6 块返回 false（对应块输出为品红色）
+     */
+    static bool DecodeLevel(TextureFormat format, const uint8_t* data, int width, int height, uint8_t* outRgba);
+    
+    /**
+     * @brief 检查图像是否完全不透明（所有 Alpha 为 255）
+     */
+    static bool IsOpaque(const uint8_t* rgba, int width, int height);
+    
+    /**
+     * @brief 根据选项与图像内容确定最终压缩格式
+     */
+    static TextureFormat SelectFormat(const TextureCompressionOptions& options,
+                                      const uint8_t* rgba, int width, int height);
+    
+    /**
+     * @brief 生成 mip 链（可选）并编码所有级别
+     * @param rgba 基础级别 RGBA8 像素
+     * @param format 块压缩格式
+     * @param generateMipmaps 是否生成完整 mip 链（否则只编码基础级别）
+     * @param outData 输出所有级别的连续压缩数据
+     * @param outLevels 输出各级别的尺寸与偏移
+     * @return format 不是块压缩格式或尺寸无效时返回 false
+     */
+    static bool Compress(const uint8_t* rgba, int width, int height,
+                         TextureFormat format, bool generateMipmaps,
+                         std::vector<uint8_t>& outData,
+                         std::vector<TextureMipLevel>& outLevels);
+
+private:
+    TextureCompressor() = delete;
+};
+
+} // namespace Render
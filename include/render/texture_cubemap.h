@@ -21,6 +21,8 @@
 #pragma once
 
 #include "render/texture.h"
+#include "render/hdri_converter.h"
+#include <array>
 #include <string>
 #include <memory>
 #include <mutex>
@@ -65,9 +67,16 @@ enum class CubemapFace {
  *     "textures/skybox/back.png"     // -Z
  * });
  * 
- * // 从HDRI加载
+ * // 从HDRI加载（CPU 转换，结果写入 HDRICache，下次启动直接读取）
  * cubemap->LoadFromHDRI("environments/sunset.hdr");
  * 
+ * // 从HDRI加载预过滤镜面反射 mip 链与辐照度球谐
+ * HDRCubemapOptions options;
+ * options.resolution = 256;
+ * options.specularMipLevels = 5;
+ * specular->LoadFromHDRI("environments/sunset.hdr", options);
+ * auto sh = specular->GetIrradianceSH();
+ * 
  * // 绑定使用
  * cubemap->Bind(0);
  * @endcode
@@ -110,15 +119,32 @@ public:
 
     /**
      * @brief 从HDRI文件加载并转换为立方体贴图
-     * @param hdriPath HDRI文件路径（.hdr格式）
+     * @param hdriPath HDRI文件路径（Radiance .hdr 格式）
      * @param resolution 立方体贴图每面的分辨率（默认512）
      * @param generateMipmap 是否生成 Mipmap
      * @return 是否加载成功
      * 
-     * @note 需要stb_image库支持HDR格式
+     * @note 等价于 resolution 之外使用默认 HDRCubemapOptions（不预过滤，计算辐照度球谐）
      */
     bool LoadFromHDRI(const std::string& hdriPath, int resolution = 512, bool generateMipmap = true);
 
+    /**
+     * @brief 按转换选项从HDRI文件加载
+     * @param generateMipmap 未预过滤时是否调用 glGenerateMipmap（预过滤时直接使用预过滤 mip 链）
+     * 
+     * 解码与转换在调用线程完成（TaskScheduler 并行），命中 HDRICache 时只读取缓存文件；
+     * 需要避免阻塞渲染线程时，可在工作线程调用 HDRIConverter::LoadFromFile，再在 GL 线程调用 CreateFromHDRData。
+     */
+    bool LoadFromHDRI(const std::string& hdriPath, const HDRCubemapOptions& options, bool generateMipmap = true);
+
+    /**
+     * @brief 从 HDRIConverter 的转换结果创建浮点立方体贴图（GL_RGBA16F）
+     * @param data 转换结果（prefiltered 时上传全部级别并限制 GL_TEXTURE_MAX_LEVEL）
+     * @param generateMipmap 未预过滤时是否生成 Mipmap
+     * @return 是否创建成功
+     */
+    bool CreateFromHDRData(const HDRCubemapData& data, bool generateMipmap = true);
+
     /**
      * @brief 从内存数据创建立方体贴图面
      * @param face 立方体贴图面
@@ -190,6 +216,21 @@ public:
      */
     TextureFormat GetFormat() const { return m_format; }
 
+    /**
+     * @brief 是否为浮点（HDR）立方体贴图
+     */
+    bool IsHDR() const;
+
+    /**
+     * @brief 是否带有辐照度球谐系数（由 LoadFromHDRI/CreateFromHDRData 填充）
+     */
+    bool HasIrradianceSH() const;
+
+    /**
+     * @brief 获取辐照度球谐系数（已与余弦核卷积，可用 HDRIConverter::EvaluateIrradianceSH 求值）
+     */
+    std::array<Vector3, 9> GetIrradianceSH() const;
+
     /**
      * @brief 检查立方体贴图是否有效
      */
@@ -241,6 +282,9 @@ private:
     int m_resolution;                      ///< 立方体贴图分辨率（每面的宽度/高度）
     TextureFormat m_format;                 ///< 纹理格式
     bool m_hasMipmap;                      ///< 是否有 Mipmap
+    bool m_isHDR;                          ///< 是否为浮点立方体贴图（GL_RGBA16F）
+    bool m_hasIrradianceSH;                ///< 是否带有辐照度球谐系数
+    std::array<Vector3, 9> m_irradianceSH; ///< 辐照度球谐系数
     std::vector<bool> m_faceLoaded;        ///< 标记每个面是否已加载（6个元素）
     mutable std::mutex m_mutex;            ///< 线程安全互斥锁
 };
@@ -21,6 +21,8 @@
 #pragma once
 
 #include "render/texture.h"
+#include "render/texture_compression.h"
+#include "render/texture_upload_queue.h"
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -53,6 +55,8 @@ public:
      *
      * 拆分纹理解码与 GPU 上传，以便在工作线程完成文件 IO，
      * 并在拥有 OpenGL 上下文的线程执行最终上传。
+     * 启用纹理压缩时 pixels 保存所有级别的块压缩数据，mipLevels 描述各级别。
+     * 经 StageToPixelBuffer 写入 PBO 后 pixels 为空，数据位于 pixelBuffer。
      */
     struct TextureStagingData {
         std::vector<std::uint8_t> pixels;
@@ -60,9 +64,11 @@ public:
         int height = 0;
         TextureFormat format = TextureFormat::RGBA;
         bool generateMipmap = true;
+        std::vector<TextureMipLevel> mipLevels;   ///< 预生成的 mip 链（为空时按 pixels 上传并由 GL 生成 mip）
+        TextureStagingBuffer pixelBuffer;         ///< 工作线程已写入的 PBO（有效时 pixels 为空）
 
         bool IsValid() const {
-            return width > 0 && height > 0 && !pixels.empty();
+            return width > 0 && height > 0 && (!pixels.empty() || pixelBuffer.IsValid());
         }
     };
 
@@ -82,6 +88,17 @@ public:
                           const std::string& filepath,
                           bool generateMipmap = true);
     
+    /**
+     * @brief 加载或获取流式纹理（同步，必须在 GL 线程调用）
+     * @param name 纹理名称（用于缓存键）
+     * @param filepath 纹理文件路径
+     * @return 纹理指针，失败返回 nullptr
+     * 
+     * 在 CPU 端生成完整 mip 链（启用压缩时使用压缩选项与 TextureCache），注册到 TextureStreamer，
+     * 初始只上传低精度级别，更精细的级别由渲染时的屏幕空间请求按显存预算流入。
+     */
+    TexturePtr LoadStreamingTexture(const std::string& name, const std::string& filepath);
+    
     /**
      * @brief 从内存数据创建或获取纹理
      * @param name 纹理名称
@@ -172,10 +189,24 @@ public:
      */
     size_t GetTotalMemoryUsage() const;
 
+    /**
+     * @brief 设置从文件加载纹理时的压缩选项
+     * 
+     * 启用后 DecodeTextureToStaging 在工作线程生成 mip 链并编码为块压缩格式，
+     * 结果写入 TextureCache；之后再加载同一文件时直接读取缓存，跳过图像解码与编码。
+     * 只影响之后的加载，已缓存的纹理不变。
+     */
+    void SetCompressionOptions(const TextureCompressionOptions& options);
+    
+    /**
+     * @brief 获取当前压缩选项
+     */
+    TextureCompressionOptions GetCompressionOptions() const;
+
     /**
      * @brief 将纹理文件解码为 staging 数据（无 OpenGL 调用）
      * @param filepath 纹理文件路径
-     * @param generateMipmap 是否在上传阶段生成 Mipmap
+     * @param generateMipmap 是否生成 Mipmap（启用压缩时在此处预生成，否则在上传阶段由 GL 生成）
      * @param outData 输出的 staging 数据
      * @param errorMessage 若失败，填充错误描述
      * @return 成功返回 true
@@ -190,10 +221,42 @@ public:
      * @param name 纹理名称（用于缓存；为空则不缓存）
      * @param stagingData 预处理数据（上传后被清空）
      * @return 纹理指针，失败返回 nullptr
+     * 
+     * @note 压缩格式不受当前 GPU 支持时在 CPU 端解码为 RGBA8 后上传（保留预生成的 mip 链）
      */
     TexturePtr UploadStagedTexture(const std::string& name,
                                    TextureStagingData&& stagingData);
 
+    /**
+     * @brief 将 staging 数据复制到 TextureUploadQueue 的 PBO（工作线程，无 OpenGL 调用）
+     * @param stagingData 预处理数据；成功后 pixels 被释放，数据位于 pixelBuffer
+     * @return 取得 PBO 并完成复制时返回 true；否则数据保留在 pixels 中
+     * 
+     * 未压缩且需要 mipmap 时先在 CPU 端生成 mip 链（无论是否取得 PBO），
+     * 使 GL 线程只需分帧发出 glTexSubImage2D，不再调用 glGenerateMipmap
+     */
+    bool StageToPixelBuffer(TextureStagingData& stagingData);
+
+    /**
+     * @brief 开始分帧上传 staging 纹理（GL 线程）
+     * @param name 纹理名称（缓存命中时直接返回已有纹理）
+     * @param stagingData 预处理数据（上传后被清空）
+     * @param outTicket 输出 TextureUploadQueue 票据；返回的纹理已可用时为 kInvalidUploadTicket
+     * @return 纹理对象（票据完成前内容未定义）；失败返回 nullptr
+     * 
+     * 没有预生成 mip 链且未写入 PBO 的数据回退为 UploadStagedTexture 同步上传；
+     * 票据完成后调用 FinishStagedUpload 加入缓存
+     */
+    TexturePtr BeginStagedUpload(const std::string& name,
+                                 TextureStagingData&& stagingData,
+                                 TextureUploadTicket& outTicket);
+
+    /**
+     * @brief 分帧上传完成后把纹理加入缓存
+     * @return 缓存中的纹理（上传期间同名纹理已被缓存时返回已有纹理）
+     */
+    TexturePtr FinishStagedUpload(const std::string& name, const TexturePtr& texture);
+
 private:
     TextureLoader() = default;
     ~TextureLoader() = default;
@@ -209,6 +272,9 @@ private:
     
     std::unordered_map<std::string, TexturePtr> m_textures;  ///< 纹理缓存
     mutable std::mutex m_mutex;                              ///< 线程安全互斥锁
+    
+    TextureCompressionOptions m_compressionOptions;          ///< 文件加载时的压缩选项
+    mutable std::mutex m_optionsMutex;                       ///< 保护 m_compressionOptions（工作线程读取）
 };
 
 } // namespace Render
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/texture.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Render {
+
+/// 驻留管理器中的纹理句柄
+using TextureResidencyHandle = uint32_t;
+constexpr TextureResidencyHandle kInvalidResidencyHandle = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief mip 驻留策略参数
+ */
+struct TextureResidencyOptions {
+    size_t budgetBytes = 256ull * 1024 * 1024;          ///< 全局显存预算（不含始终驻留的低精度级别）
+    size_t uploadBytesPerUpdate = 16ull * 1024 * 1024;  ///< 每次 Update 允许提升的上传字节数（至少处理一个纹理）
+    int alwaysResidentSize = 64;                        ///< 最大边长不超过该值的级别始终驻留（纹理的初始状态）
+    uint32_t evictionDelayFrames = 60;                  ///< 更精细的级别连续多少帧未被请求后才降级（防止边界抖动）
+};
+
+/**
+ * @brief 单个纹理的驻留级别变化（由 TextureStreamer 在 GL 线程执行）
+ */
+struct TextureResidencyChange {
+    TextureResidencyHandle handle = kInvalidResidencyHandle;
+    int fromMip = 0;          ///< 变化前最精细的驻留级别
+    int toMip = 0;            ///< 变化后最精细的驻留级别（小于 fromMip 为提升，大于为降级）
+    size_t uploadBytes = 0;   ///< 提升时需要上传的字节数，即级别 [toMip, fromMip) 之和（降级为 0）
+};
+
+/**
+ * @brief 纹理 mip 驻留决策（纯 CPU，无 OpenGL 调用）
+ * 
+ * 每个纹理的驻留状态用"最精细的驻留级别" residentMip 表示：级别 residentMip..末级驻留显存。
+ * 渲染时按屏幕空间纹素密度调用 Request() 报告所需级别，每帧调用一次 Update()：
+ * 1. 所需级别：取本帧请求的最精细级别；更粗的请求或无请求时，保持原级别直到 evictionDelayFrames 帧后才降级
+ * 2. 预算：所有纹理目标级别的总字节数超过 budgetBytes 时，反复降低"本帧未请求且当前最精细级别最大"的纹理，
+ *    使各纹理的清晰度均匀下降，而不是某个纹理完全失去细节
+ * 3. 降级立即生效（释放显存）；提升按本帧请求优先、级别差距大优先排序，受 uploadBytesPerUpdate 限制分帧执行
+ * 
+ * 最大边长不超过 alwaysResidentSize 的级别（floorMip 及之后）始终驻留，不计入预算判断。
+ * 
+ * @note 非线程安全：Request/Update 应在同一线程（通常为渲染线程）调用，TextureStreamer 负责加锁
+ */
+class TextureResidencyManager {
+public:
+    /**
+     * @brief 驻留统计
+     */
+    struct Stats {
+        size_t textureCount = 0;        ///< 已注册纹理数
+        size_t residentBytes = 0;       ///< 当前驻留字节数（含始终驻留级别）
+        size_t requestedBytes = 0;      ///< 不考虑预算时所需的字节数
+        size_t promotions = 0;          ///< 本次 Update 提升的纹理数
+        size_t demotions = 0;           ///< 本次 Update 降级的纹理数
+        size_t deferredPromotions = 0;  ///< 因上传限制推迟到后续帧的提升数
+        size_t budgetLimited = 0;       ///< 因预算未达到所需级别的纹理数
+    };
+    
+    TextureResidencyManager() = default;
+    explicit TextureResidencyManager(const TextureResidencyOptions& options) : m_options(options) {}
+    
+    void SetOptions(const TextureResidencyOptions& options) { m_options = options; }
+    [[nodiscard]] const TextureResidencyOptions& GetOptions() const { return m_options; }
+    
+    /**
+     * @brief 注册纹理
+     * @param levels 完整 mip 链（levels[0] 为基础级别，size 为该级别显存字节数）
+     * @return 句柄；levels 为空时返回 kInvalidResidencyHandle
+     * 
+     * 初始驻留级别为 floorMip（只有低精度级别驻留）
+     */
+    TextureResidencyHandle Register(const std::vector<TextureMipLevel>& levels);
+    
+    /**
+     * @brief 注销纹理（句柄之后可能被复用）
+     */
+    void Unregister(TextureResidencyHandle handle);
+    
+    /**
+     * @brief 报告本帧渲染该纹理所需的最精细级别（同一帧多次调用取最精细值）
+     */
+    void Request(TextureResidencyHandle handle, int mip);
+    
+    /**
+     * @brief 根据屏幕空间覆盖计算所需级别
+     * @param width 纹理基础级别宽度
+     * @param height 纹理基础级别高度
+     * @param screenPixels 纹理 [0,1] UV 范围在屏幕上覆盖的像素数（边长）
+     * @param bias 级别偏移（正值偏向更粗的级别）
+     * @return 所需级别（纹素与像素约 1:1 的级别）；screenPixels <= 0 时返回最粗级别
+     */
+    static int ComputeDesiredMip(int width, int height, float screenPixels, float bias = 0.0f);
+    
+    /**
+     * @brief 执行一帧的驻留决策
+     * @param frameIndex 单调递增的帧序号
+     * @return 本帧需要执行的驻留变化（降级在前、提升在后）；调用方执行后状态即视为生效
+     */
+    const std::vector<TextureResidencyChange>& Update(uint64_t frameIndex);
+    
+    [[nodiscard]] int GetResidentMip(TextureResidencyHandle handle) const;
+    [[nodiscard]] int GetTargetMip(TextureResidencyHandle handle) const;
+    [[nodiscard]] int GetFloorMip(TextureResidencyHandle handle) const;
+    
+    /**
+     * @brief 计算从 mip 到末级的驻留字节数
+     */
+    [[nodiscard]] size_t GetChainBytes(TextureResidencyHandle handle, int mip) const;
+    
+    [[nodiscard]] size_t GetResidentBytes() const { return m_residentBytes; }
+    [[nodiscard]] const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Slot {
+        bool active = false;
+        std::vector<size_t> chainBytes;        ///< chainBytes[i] = 级别 i..末级的字节数
+        int floorMip = 0;                      ///< 始终驻留的最精细级别
+        int residentMip = 0;                   ///< 当前最精细的驻留级别
+        int desiredMip = 0;                    ///< 考虑延迟降级后所需的级别
+        int targetMip = 0;                     ///< 预算约束后的目标级别
+        int requestedMip = std::numeric_limits<int>::max();  ///< 本帧请求（未请求为 INT_MAX）
+        uint64_t desiredFrame = 0;             ///< desiredMip 最近一次被请求的帧
+    };
+    
+    [[nodiscard]] const Slot* GetSlot(TextureResidencyHandle handle) const;
+    
+    TextureResidencyOptions m_options;
+    std::vector<Slot> m_slots;
+    std::vector<TextureResidencyHandle> m_freeHandles;
+    std::vector<TextureResidencyChange> m_changes;
+    size_t m_residentBytes = 0;
+    Stats m_stats;
+};
+
+} // namespace Render
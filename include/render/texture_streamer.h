@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/texture.h"
+#include "render/texture_residency.h"
+#include "render/texture_upload_queue.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Render {
+
+/**
+ * @brief 纹理 mip 流式加载
+ * 
+ * 保存流式纹理的完整 mip 链（CPU 内存，作为再次提升时的上传来源），显存中只保留
+ * TextureResidencyManager 决定的级别：注册时只分配并上传低精度级别（最大边长不超过
+ * alwaysResidentSize），渲染时根据屏幕空间纹素密度请求更精细的级别，Update() 在 GL 线程
+ * 按预算与上传限制提升或降低驻留级别。
+ * 
+ * 纹理 ID 与尺寸按完整 mip 链固定，显存只为驻留级别分配（Texture::SetStorageBaseLevel）：
+ * 提升时先分配新驻留的级别，再经 TextureUploadQueue 在其每帧字节预算内分片上传，全部写入后
+ * 才通过 Texture::SetBaseLevel 放开采样；降级先提高采样基础级别，再释放更精细级别的显存。
+ * 
+ * 提升依赖 TextureUploadQueue::Update() 每帧推进（AsyncResourceLoader::ProcessCompletedTasks 会调用）。
+ * 
+ * **使用示例**：
+ * @code
+ * auto texture = TextureLoader::GetInstance().LoadStreamingTexture("albedo", "textures/albedo.png");
+ * material->SetTexture("diffuseMap", texture);
+ * // MeshRenderSystem 每帧自动请求可见材质的纹理级别并调用 Update()
+ * @endcode
+ * 
+ * @note 线程安全：Register/Request 可在任意线程调用；Update 必须在 GL 线程调用
+ */
+class TextureStreamer {
+public:
+    /**
+     * @brief 流式加载统计
+     */
+    struct Stats {
+        size_t textureCount = 0;        ///< 流式纹理数
+        size_t residentBytes = 0;       ///< 实际分配的显存字节数（含上传中的级别）
+        size_t requestedBytes = 0;      ///< 不考虑预算时所需的字节数
+        size_t cpuBytes = 0;            ///< CPU 端保存的完整 mip 链字节数
+        size_t promotions = 0;          ///< 累计提升次数
+        size_t demotions = 0;           ///< 累计降级次数
+        size_t deferredPromotions = 0;  ///< 最近一次 Update 推迟的提升数
+        size_t budgetLimited = 0;       ///< 最近一次 Update 受预算限制的纹理数
+        size_t uploadedBytes = 0;       ///< 累计上传字节数
+    };
+    
+    static TextureStreamer& GetInstance();
+    
+    void SetOptions(const TextureResidencyOptions& options);
+    [[nodiscard]] TextureResidencyOptions GetOptions() const;
+    
+    /**
+     * @brief 启用/禁用流式加载（禁用时 Update 不改变驻留级别）
+     */
+    void SetEnabled(bool enabled);
+    [[nodiscard]] bool IsEnabled() const;
+    
+    /**
+     * @brief 注册流式纹理并上传低精度级别（必须在 GL 线程调用）
+     * @param texture 目标纹理对象
+     * @param data 完整 mip 链数据
+     * @param levels 各级别尺寸与偏移（levels[0] 为基础级别）
+     * @param format 数据格式（RGBA 或块压缩格式，须为当前上下文支持的格式）
+     * @return 上传成功返回 true
+     */
+    bool Register(const TexturePtr& texture,
+                  std::vector<uint8_t> data,
+                  std::vector<TextureMipLevel> levels,
+                  TextureFormat format);
+    
+    /**
+     * @brief 注销流式纹理（纹理保持当前驻留级别）
+     */
+    void Unregister(const Texture* texture);
+    
+    /**
+     * @brief 报告纹理在屏幕上的覆盖尺寸
+     * @param screenPixels 纹理 [0,1] UV 范围在屏幕上覆盖的像素数（边长）
+     */
+    void RequestTexture(const Texture* texture, float screenPixels);
+    
+    /**
+     * @brief 直接请求指定级别
+     */
+    void RequestMip(const Texture* texture, int mip);
+    
+    /**
+     * @brief 执行驻留决策并上传/释放级别（每帧一次，必须在 GL 线程调用）
+     * 
+     * 同时清理已被释放的纹理
+     */
+    void Update();
+    
+    [[nodiscard]] bool IsStreaming(const Texture* texture) const;
+    [[nodiscard]] int GetResidentMip(const Texture* texture) const;
+    [[nodiscard]] size_t GetTextureCount() const;
+    [[nodiscard]] Stats GetStats() const;
+    
+    /**
+     * @brief 注销所有流式纹理
+     */
+    void Clear();
+
+private:
+    TextureStreamer() = default;
+    ~TextureStreamer() = default;
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+    
+    struct Entry {
+        std::weak_ptr<Texture> texture;
+        TextureResidencyHandle handle = kInvalidResidencyHandle;
+        std::vector<uint8_t> data;
+        std::vector<TextureMipLevel> levels;
+        TextureFormat format = TextureFormat::RGBA;
+        int uploadedMip = 0;     ///< levels[uploadedMip..] 已写入显存（即采样基础级别）
+        int requestedMip = 0;    ///< 已提交上传的最精细级别（上传中或上传失败时小于 uploadedMip）
+        TextureUploadTicket ticket = kInvalidUploadTicket;  ///< 进行中的上传
+        size_t ticketBytes = 0;  ///< 进行中上传的字节数
+    };
+    
+    /**
+     * @brief 同步上传 [firstMip, 末级]（只用于注册时的低精度级别）
+     */
+    static bool UploadLevelsNow(Texture& texture, const Entry& entry, int firstMip);
+    
+    /**
+     * @brief 经 TextureUploadQueue 提交 [firstMip, endMip) 的分帧上传
+     */
+    static TextureUploadTicket SubmitLevels(const TexturePtr& texture, const Entry& entry,
+                                            int firstMip, int endMip, size_t& outBytes);
+    
+    /**
+     * @brief 取消条目进行中的上传
+     */
+    static void CancelUpload(Entry& entry);
+    
+    mutable std::mutex m_mutex;
+    TextureResidencyManager m_residency;
+    std::unordered_map<const Texture*, Entry> m_entries;
+    std::unordered_map<TextureResidencyHandle, const Texture*> m_handleToTexture;
+    uint64_t m_frameIndex = 0;
+    bool m_enabled = true;
+    Stats m_stats;
+};
+
+} // namespace Render
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/texture.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Render {
+
+/// 上传计划中的任务 ID（由调用方分配）
+using TextureUploadJobId = uint32_t;
+
+/**
+ * @brief 单次 glTexSubImage2D 上传的行区间
+ * 
+ * 区间总是覆盖级别的整行宽度；块压缩格式以 4 像素行（一行块）为单位切分
+ */
+struct TextureUploadSlice {
+    int level = 0;       ///< mip 级别
+    int y = 0;           ///< 起始像素行
+    int width = 0;       ///< 级别宽度
+    int height = 0;      ///< 像素行数（块压缩格式为 4 的倍数或到达级别底部）
+    size_t offset = 0;   ///< 在数据块中的字节偏移
+    size_t size = 0;     ///< 字节数
+};
+
+/**
+ * @brief 本帧需要执行的一次切片上传
+ */
+struct TextureUploadDispatch {
+    TextureUploadJobId job = 0;
+    TextureUploadSlice slice;
+    bool lastSlice = false;   ///< 是否为该任务的最后一个切片（执行后应插入 fence）
+};
+
+/**
+ * @brief 纹理分帧上传计划（纯 CPU，无 OpenGL 调用）
+ * 
+ * BuildSlices() 把 mip 链切分为不超过 maxSliceBytes 的行区间；Enqueue() 按提交顺序排队，
+ * 每帧调用一次 NextFrame() 取出累计字节数不超过 bytesPerFrame 的切片。
+ * 队首切片即使单独超出预算也会发出，保证每帧至少推进一个切片。
+ * 
+ * @note 非线程安全：由 TextureUploadQueue 在 GL 线程加锁使用
+ */
+class TextureUploadPlanner {
+public:
+    /**
+     * @brief 上传统计
+     */
+    struct Stats {
+        size_t pendingJobs = 0;       ///< 仍有切片未发出的任务数
+        size_t pendingBytes = 0;      ///< 未发出的字节数
+        size_t frameSlices = 0;       ///< 最近一次 NextFrame 发出的切片数
+        size_t frameBytes = 0;        ///< 最近一次 NextFrame 发出的字节数
+        size_t totalSlices = 0;       ///< 累计发出的切片数
+        size_t totalBytes = 0;        ///< 累计发出的字节数
+    };
+    
+    TextureUploadPlanner() = default;
+    explicit TextureUploadPlanner(size_t bytesPerFrame) : m_bytesPerFrame(bytesPerFrame) {}
+    
+    void SetBytesPerFrame(size_t bytesPerFrame) { m_bytesPerFrame = bytesPerFrame; }
+    [[nodiscard]] size_t GetBytesPerFrame() const { return m_bytesPerFrame; }
+    
+    /**
+     * @brief 切分的行粒度（非压缩格式 1，块压缩格式 4）
+     */
+    static int GetRowGranularity(TextureFormat format);
+    
+    /**
+     * @brief 一个行粒度单位的字节数（非压缩格式为一行像素，块压缩格式为一行块）
+     */
+    static size_t GetRowPitch(TextureFormat format, int width);
+    
+    /**
+     * @brief 把 mip 链切分为上传切片
+     * @param levels 各级别尺寸与偏移（offset 相对于同一数据块）
+     * @param maxSliceBytes 单个切片的字节上限（至少包含一个行粒度单位）
+     * @param firstLevel levels[0] 对应的纹理 mip 级别（只上传 mip 链的一段时使用）
+     * @return 按级别、行顺序排列的切片；级别尺寸无效时跳过该级别
+     */
+    static std::vector<TextureUploadSlice> BuildSlices(const std::vector<TextureMipLevel>& levels,
+                                                       TextureFormat format,
+                                                       size_t maxSliceBytes,
+                                                       int firstLevel = 0);
+    
+    /**
+     * @brief 排队上传任务（slices 为空时忽略）
+     */
+    void Enqueue(TextureUploadJobId job, std::vector<TextureUploadSlice> slices);
+    
+    /**
+     * @brief 移除任务尚未发出的切片
+     * @return 任务仍在队列中时返回 true
+     */
+    bool Cancel(TextureUploadJobId job);
+    
+    [[nodiscard]] bool IsQueued(TextureUploadJobId job) const;
+    
+    /**
+     * @brief 取出本帧要执行的切片（按提交顺序，受 bytesPerFrame 限制）
+     */
+    const std::vector<TextureUploadDispatch>& NextFrame();
+    
+    [[nodiscard]] size_t GetPendingJobCount() const { return m_jobs.size(); }
+    [[nodiscard]] size_t GetPendingBytes() const { return m_pendingBytes; }
+    [[nodiscard]] const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Job {
+        TextureUploadJobId id = 0;
+        std::vector<TextureUploadSlice> slices;
+        size_t next = 0;              ///< 下一个未发出的切片
+    };
+    
+    size_t m_bytesPerFrame = 8ull * 1024 * 1024;
+    std::deque<Job> m_jobs;
+    std::vector<TextureUploadDispatch> m_dispatches;
+    size_t m_pendingBytes = 0;
+    Stats m_stats;
+};
+
+} // namespace Render
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "render/texture.h"
+#include "render/texture_upload_planner.h"
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Render {
+
+/// 上传队列中的任务票据（0 表示无效）
+using TextureUploadTicket = TextureUploadJobId;
+constexpr TextureUploadTicket kInvalidUploadTicket = 0;
+
+/**
+ * @brief 分帧上传任务状态
+ */
+enum class TextureUploadState {
+    Pending,     ///< 仍有切片未发出或 fence 未触发
+    Completed,   ///< 所有切片已被 GPU 消费
+    Failed       ///< 上传出错、已取消或票据未知
+};
+
+/**
+ * @brief 分帧纹理上传参数
+ */
+struct TextureUploadOptions {
+    bool usePixelBuffers = true;                    ///< 是否经 PBO 上传（禁用时 AsyncResourceLoader 回退为同步上传）
+    size_t bytesPerFrame = 8ull * 1024 * 1024;      ///< 每帧发出的上传字节数（至少一个切片）
+    size_t maxSliceBytes = 2ull * 1024 * 1024;      ///< 单次 glTexSubImage2D 的字节上限
+    size_t poolBudgetBytes = 256ull * 1024 * 1024;  ///< PBO 池总容量上限
+    size_t minBufferBytes = 4ull * 1024 * 1024;     ///< 新建 PBO 的最小容量
+};
+
+/**
+ * @brief 工作线程写入的已映射 PBO 区域
+ */
+struct TextureStagingBuffer {
+    uint32_t slot = std::numeric_limits<uint32_t>::max();
+    uint32_t generation = 0;   ///< 取得时的池代数（Shutdown 后旧区域失效）
+    uint8_t* data = nullptr;   ///< 映射地址（只写）
+    size_t size = 0;           ///< 已写入的字节数
+    
+    bool IsValid() const { return data != nullptr; }
+};
+
+/**
+ * @brief 经像素缓冲对象（PBO）的分帧纹理上传
+ * 
+ * 维护一组 GL_PIXEL_UNPACK_BUFFER，每次使用都经历一次普通的映射/解除映射（不是持久映射）：
+ * 1. 空闲缓冲由 GL 线程预先映射；工作线程调用 AcquireStagingBuffer() 取得映射地址，
+ *    memcpy 解码结果后调用 FinishStagingWrite()
+ * 2. GL 线程 Submit() 解除映射并按 TextureUploadPlanner 切分为行区间
+ * 3. 每帧 Update() 在 bytesPerFrame 预算内发出以 PBO 为源的 glTexSubImage2D，
+ *    任务最后一个切片之后插入 fence，fence 触发时任务完成、缓冲重新映射回池中
+ * 
+ * 没有可用缓冲时（池为空、容量不足或超出 poolBudgetBytes）AcquireStagingBuffer 返回无效区域，
+ * 并记录需求，下一次 Update() 按需求新建缓冲；此时 Submit() 从 CPU 内存按同样的预算分帧上传。
+ * 
+ * **使用示例**：
+ * @code
+ * // 工作线程
+ * auto staging = TextureUploadQueue::GetInstance().AcquireStagingBuffer(bytes);
+ * if (staging.IsValid()) {
+ *     std::memcpy(staging.data, pixels, bytes);
+ *     TextureUploadQueue::GetInstance().FinishStagingWrite(staging);
+ * }
+ * // GL 线程
+ * texture->CreateFromMipLevels(nullptr, levels, format);
+ * auto ticket = queue.Submit(texture, {}, levels, format, staging);
+ * // 每帧
+ * queue.Update();
+ * if (queue.Poll(ticket) == TextureUploadState::Completed) { ... }
+ * @endcode
+ * 
+ * @note 线程安全：AcquireStagingBuffer/FinishStagingWrite/ReleaseStagingBuffer/Poll/Cancel 可在任意线程调用；
+ *       Submit/Update/Prewarm/Shutdown 必须在 GL 线程调用
+ */
+class TextureUploadQueue {
+public:
+    /**
+     * @brief 上传统计
+     */
+    struct Stats {
+        size_t bufferCount = 0;           ///< PBO 数
+        size_t poolBytes = 0;             ///< PBO 总容量
+        size_t buffersInUse = 0;          ///< 被工作线程或上传任务占用的 PBO 数
+        size_t pendingUploads = 0;        ///< 未完成的上传任务数
+        size_t pendingBytes = 0;          ///< 尚未发出的字节数
+        size_t lastFrameBytes = 0;        ///< 最近一次 Update 发出的字节数
+        size_t uploadedBytes = 0;         ///< 累计发出的字节数
+        size_t pixelBufferUploads = 0;    ///< 累计经 PBO 完成的任务数
+        size_t clientMemoryUploads = 0;   ///< 累计从 CPU 内存完成的任务数
+        size_t stagingMisses = 0;         ///< 工作线程未取得 PBO 的次数
+    };
+    
+    static TextureUploadQueue& GetInstance();
+    
+    void SetOptions(const TextureUploadOptions& options);
+    [[nodiscard]] TextureUploadOptions GetOptions() const;
+    
+    /**
+     * @brief 取得容量不小于 bytes 的已映射 PBO（任意线程）
+     * @return 无可用缓冲或未启用 PBO 时返回无效区域（并记录需求供下一次 Update 扩容）
+     */
+    TextureStagingBuffer AcquireStagingBuffer(size_t bytes);
+    
+    /**
+     * @brief 工作线程写完映射内存后调用（任意线程）；Shutdown 会等待仍在写入的缓冲
+     */
+    void FinishStagingWrite(const TextureStagingBuffer& buffer);
+    
+    /**
+     * @brief 归还未提交的 PBO（任意线程，例如任务取消时；Shutdown 之前取得的区域直接丢弃）
+     */
+    void ReleaseStagingBuffer(TextureStagingBuffer& buffer);
+    
+    /**
+     * @brief 提交分帧上传（GL 线程）
+     * @param texture 已通过 CreateFromMipLevels(nullptr, ...) 分配存储的纹理
+     * @param pixels CPU 数据（staging 有效时忽略，可为空）
+     * @param levels 各级别尺寸与偏移（相对于 staging 或 pixels）
+     * @param staging AcquireStagingBuffer 取得并已写入数据的 PBO
+     * @param firstLevel levels[0] 对应的纹理 mip 级别（TextureStreamer 只上传新驻留的级别时使用）
+     * @return 票据；参数无效、staging 已被 Shutdown 释放或解除映射失败时返回 kInvalidUploadTicket（staging 被回收）
+     */
+    TextureUploadTicket Submit(const TexturePtr& texture,
+                               std::vector<uint8_t> pixels,
+                               std::vector<TextureMipLevel> levels,
+                               TextureFormat format,
+                               TextureStagingBuffer staging = {},
+                               int firstLevel = 0);
+    
+    /**
+     * @brief 推进一帧（GL 线程）：回收已触发 fence 的任务、按需扩容 PBO 池、在预算内发出切片
+     */
+    void Update();
+    
+    /**
+     * @brief 查询任务状态；返回 Completed/Failed 后票据失效
+     */
+    TextureUploadState Poll(TextureUploadTicket ticket);
+    
+    /**
+     * @brief 取消任务（未发出的切片被丢弃，已发出的切片完成后回收缓冲）
+     */
+    void Cancel(TextureUploadTicket ticket);
+    
+    /**
+     * @brief 预先创建 PBO（GL 线程），适用于已知纹理尺寸的场景，避免首批纹理回退到 CPU 内存上传
+     */
+    void Prewarm(size_t bufferBytes, size_t count);
+    
+    /**
+     * @brief 释放所有 PBO 与 fence，丢弃未完成的任务（GL 线程）
+     * 
+     * 先拒绝新的 AcquireStagingBuffer，并等待工作线程完成正在进行的写入（FinishStagingWrite）；
+     * 超时仍在写入的缓冲保持映射、不删除（随上下文销毁），避免工作线程写入已释放的内存。
+     * 之前取得的 staging 区域全部失效：ReleaseStagingBuffer 忽略它们，Submit 返回无效票据。
+     */
+    void Shutdown();
+    
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    TextureUploadQueue() = default;
+    ~TextureUploadQueue() = default;
+    TextureUploadQueue(const TextureUploadQueue&) = delete;
+    TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+    
+    struct PixelBuffer {
+        GLuint id = 0;               ///< 0 表示空槽
+        size_t capacity = 0;
+        uint8_t* mapped = nullptr;   ///< 映射地址（解除映射后为 nullptr）
+        bool inUse = false;          ///< 被工作线程或上传任务占用
+        bool writing = false;        ///< 工作线程正在写入映射内存（AcquireStagingBuffer 到 FinishStagingWrite 之间）
+    };
+    
+    struct Job {
+        std::weak_ptr<Texture> texture;
+        std::vector<uint8_t> pixels;                      ///< 无 PBO 时的 CPU 数据
+        uint32_t bufferSlot = std::numeric_limits<uint32_t>::max();
+        size_t bytes = 0;
+        GLsync fence = nullptr;                           ///< 最后一个切片之后插入
+        bool failed = false;
+        bool cancelled = false;
+    };
+    
+    bool CreateBufferLocked(size_t capacity);
+    bool MapBufferLocked(PixelBuffer& buffer);
+    PixelBuffer* FindStagingLocked(const TextureStagingBuffer& staging);
+    void DestroyBufferLocked(PixelBuffer& buffer);
+    void RecycleBufferLocked(uint32_t slot);
+    void FinishJobLocked(TextureUploadTicket ticket, Job& job, TextureUploadState state);
+    size_t GetPoolBytesLocked() const;
+    
+    mutable std::mutex m_mutex;
+    std::condition_variable m_writeDone;     ///< 工作线程结束写入时通知 Shutdown
+    TextureUploadOptions m_options;
+    TextureUploadPlanner m_planner;
+    std::vector<PixelBuffer> m_buffers;
+    std::unordered_map<TextureUploadTicket, Job> m_jobs;
+    std::unordered_map<TextureUploadTicket, TextureUploadState> m_finished;
+    TextureUploadTicket m_nextTicket = 1;
+    size_t m_pendingDemand = 0;      ///< 工作线程未满足的最大缓冲需求
+    uint32_t m_generation = 1;       ///< 每次 Shutdown 递增，使之前取得的 staging 区域失效
+    bool m_shuttingDown = false;     ///< Shutdown 等待写入结束期间拒绝新的 AcquireStagingBuffer
+    Stats m_stats;
+};
+
+} // namespace Render
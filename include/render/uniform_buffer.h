@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Render {
+
+class RenderState;
+
+/// 帧数据块名称与固定绑定点（布局见 std140_layout.h）
+constexpr const char* kFrameUniformBlockName = "FrameData";
+constexpr uint32_t kFrameUniformBinding = 0;
+
+/// 材质数据块名称与固定绑定点
+constexpr const char* kMaterialUniformBlockName = "MaterialData";
+constexpr uint32_t kMaterialUniformBinding = 1;
+
+/**
+ * @brief Uniform Buffer Object 封装
+ *
+ * 内容由 Std140Writer 打包后整体上传；大小不变时使用 glBufferSubData 原地更新，
+ * 内容与上次上传完全一致时跳过上传。
+ *
+ * 线程安全：公共方法互斥保护，但 GL 调用必须在 GL 线程执行。
+ */
+class UniformBuffer {
+public:
+    UniformBuffer() = default;
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    /**
+     * @brief 上传数据（必要时创建/扩容缓冲）
+     * @param renderState 可选，用于保持缓冲绑定缓存一致
+     * @return 是否实际发生了上传
+     */
+    bool Upload(const void* data, size_t size, RenderState* renderState = nullptr);
+
+    /**
+     * @brief 绑定到指定的 uniform 块绑定点
+     */
+    void BindBase(uint32_t bindingPoint) const;
+
+    /**
+     * @brief 释放 GL 缓冲
+     */
+    void Release();
+
+    uint32_t GetID() const;
+    size_t GetSize() const;
+
+private:
+    mutable std::mutex m_mutex;
+    uint32_t m_bufferID = 0;
+    size_t m_size = 0;
+    uint64_t m_contentHash = 0;   ///< 上次上传内容的哈希，用于跳过重复上传
+};
+
+} // namespace Render
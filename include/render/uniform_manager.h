@@ -28,6 +28,20 @@
 
 namespace Render {
 
+/**
+ * @brief 预解析的 uniform 句柄
+ *
+ * 由 UniformManager::GetHandle 解析一次，之后按句柄设置 uniform 不再做字符串哈希。
+ * 句柄只对解析它的着色器程序有效；着色器重新链接（程序 ID 变化）后需要重新解析。
+ */
+struct UniformHandle {
+    int32_t location = -1;
+
+    bool IsValid() const { return location >= 0; }
+    bool operator==(const UniformHandle& other) const { return location == other.location; }
+    bool operator!=(const UniformHandle& other) const { return location != other.location; }
+};
+
 /**
  * @brief Uniform 变量管理器
  * 
@@ -123,6 +137,24 @@ public:
      * @brief 检查 uniform 是否存在
      */
     bool HasUniform(const std::string& name) const;
+    
+    /**
+     * @brief 解析 uniform 句柄（结果缓存，uniform 不存在时返回无效句柄且不发出警告）
+     */
+    UniformHandle GetHandle(const std::string& name) const;
+    
+    // 按句柄设置 uniform：无字符串查找，无效句柄直接忽略（需在 GL 线程调用）
+    void SetInt(UniformHandle handle, int value);
+    void SetFloat(UniformHandle handle, float value);
+    void SetBool(UniformHandle handle, bool value);
+    void SetVector2(UniformHandle handle, const Vector2& value);
+    void SetVector3(UniformHandle handle, const Vector3& value);
+    void SetVector4(UniformHandle handle, const Vector4& value);
+    void SetMatrix3(UniformHandle handle, const Matrix3& value);
+    void SetMatrix4(UniformHandle handle, const Matrix4& value);
+    void SetColor(UniformHandle handle, const Color& value);
+    void SetVector2Array(UniformHandle handle, const Vector2* values, uint32_t count);
+    void SetColorArray(UniformHandle handle, const Color* values, uint32_t count);
 
     /**
      * @brief 注册纹理采样器 uniform 并绑定到指定纹理单元
@@ -149,6 +181,17 @@ public:
      */
     void ClearCache();
     
+    /**
+     * @brief 检查 uniform 块是否存在（结果缓存）
+     */
+    bool HasUniformBlock(const std::string& blockName) const;
+    
+    /**
+     * @brief 将 uniform 块绑定到指定绑定点
+     * @return 块不存在时返回 false
+     */
+    bool BindUniformBlock(const std::string& blockName, uint32_t bindingPoint);
+    
     /**
      * @brief 获取所有 uniform 名称
      */
@@ -166,6 +209,7 @@ private:
     mutable std::unordered_map<std::string, int> m_uniformLocationCache;
     mutable std::mutex m_cacheMutex;  // 保护缓存的互斥锁
     mutable std::unordered_map<std::string, int> m_textureUnits; // 已注册的纹理单元
+    mutable std::unordered_map<std::string, uint32_t> m_uniformBlockIndexCache; // uniform 块索引缓存
     
     /**
      * @brief 获取或查找 uniform 位置
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Render {
+
+struct Vertex;
+
+/**
+ * @brief 位置属性格式
+ */
+enum class VertexPositionFormat : uint8_t {
+    Float3,     // 3×float（12 字节）
+    SNorm16     // 4×int16 归一化，按网格 scale/offset 反量化（8 字节）
+};
+
+/**
+ * @brief 纹理坐标属性格式
+ */
+enum class VertexTexCoordFormat : uint8_t {
+    None,       // 不存储
+    Float2,     // 2×float（8 字节）
+    Half2       // 2×half（4 字节）
+};
+
+/**
+ * @brief 法线属性格式
+ */
+enum class VertexNormalFormat : uint8_t {
+    None,       // 不存储（着色器读到默认值 (0,1,0)）
+    Float3,     // 3×float（12 字节）
+    Oct16       // 八面体编码 2×int16 归一化（4 字节）
+};
+
+/**
+ * @brief 切线空间属性格式
+ */
+enum class VertexTangentFormat : uint8_t {
+    None,               // 不存储
+    Float3Bitangent,    // 切线 + 副切线 6×float（24 字节）
+    Oct16Sign           // 八面体编码切线 + 手性符号 4×int16 归一化（8 字节），副切线在着色器中重建
+};
+
+/**
+ * @brief 顶点颜色属性格式
+ */
+enum class VertexColorFormat : uint8_t {
+    None,       // 不存储（着色器读到白色）
+    Float4,     // 4×float（16 字节）
+    UNorm8      // 4×uint8 归一化（4 字节）
+};
+
+/**
+ * @brief 着色器解码标志（uVertexLayoutFlags）
+ */
+enum VertexLayoutShaderFlags : uint32_t {
+    VertexLayoutFlag_None = 0,
+    VertexLayoutFlag_QuantizedPosition = 1u << 0,   // aPosition 需乘 scale 加 offset
+    VertexLayoutFlag_OctNormal = 1u << 1,           // aNormal.xy 为八面体编码
+    VertexLayoutFlag_OctTangent = 1u << 2           // aTangent.xy 为八面体编码，aTangent.z 为手性符号
+};
+
+/**
+ * @brief GPU 索引缓冲格式
+ * 
+ * CPU 端索引始终为 uint32_t；上传时若顶点数不超过 65536，则自动打包为 16 位索引，
+ * 索引缓冲大小与顶点拉取带宽减半。
+ */
+enum class IndexFormat : uint8_t {
+    UInt16,     // GL_UNSIGNED_SHORT
+    UInt32      // GL_UNSIGNED_INT
+};
+
+/**
+ * @brief 单个属性在交错顶点缓冲中的位置
+ */
+struct VertexAttributeSlot {
+    bool enabled = false;
+    uint32_t offset = 0;    // 字节偏移
+};
+
+/**
+ * @brief 每个网格的顶点布局
+ * 
+ * 描述 GPU 顶点缓冲中存储哪些属性以及各自的格式。属性按 Vertex 的字段顺序交错排列，
+ * 着色器 location 保持不变（0 位置、1 UV、2 法线、3 颜色、4 切线、5 副切线），
+ * 因此未使用压缩格式的着色器仍可直接绘制 Float/Half/UNorm8 属性。
+ * 
+ * 默认值等价于 Vertex 结构体本身（72 字节），此时上传路径不做任何转换。
+ */
+struct VertexLayout {
+    VertexPositionFormat position = VertexPositionFormat::Float3;
+    VertexTexCoordFormat texCoord = VertexTexCoordFormat::Float2;
+    VertexNormalFormat normal = VertexNormalFormat::Float3;
+    VertexColorFormat color = VertexColorFormat::Float4;
+    VertexTangentFormat tangent = VertexTangentFormat::Float3Bitangent;
+    
+    /**
+     * @brief 完整布局（与 Vertex 结构体一致，72 字节）
+     */
+    static VertexLayout Full() { return VertexLayout(); }
+    
+    /**
+     * @brief 紧凑布局：half UV、八面体法线/切线、UNorm8 颜色
+     * @param quantizePositions 是否把位置量化为 16 位（需着色器支持 uVertexDequant）
+     */
+    static VertexLayout Compact(bool quantizePositions = false);
+    
+    /**
+     * @brief 无光照布局（UI 面片、纯色道具）：float 位置、half UV、UNorm8 颜色
+     */
+    static VertexLayout Unlit();
+    
+    /**
+     * @brief 是否与 Vertex 结构体内存布局完全一致
+     */
+    bool IsFull() const { return *this == VertexLayout(); }
+    
+    /**
+     * @brief 每个顶点的字节数
+     */
+    uint32_t GetStride() const;
+    
+    /**
+     * @brief 各属性槽位（location 0-5）
+     */
+    VertexAttributeSlot GetPositionSlot() const;
+    VertexAttributeSlot GetTexCoordSlot() const;
+    VertexAttributeSlot GetNormalSlot() const;
+    VertexAttributeSlot GetColorSlot() const;
+    VertexAttributeSlot GetTangentSlot() const;
+    VertexAttributeSlot GetBitangentSlot() const;
+    
+    /**
+     * @brief 着色器解码标志（VertexLayoutShaderFlags 组合）
+     */
+    uint32_t GetShaderFlags() const;
+    
+    /**
+     * @brief 布局描述字符串（调试/报告用），例如 "pos:snorm16 uv:half2 n:oct16 c:unorm8 t:oct16s (28B)"
+     */
+    std::string ToString() const;
+    
+    bool operator==(const VertexLayout& other) const {
+        return position == other.position && texCoord == other.texCoord &&
+               normal == other.normal && color == other.color && tangent == other.tangent;
+    }
+    bool operator!=(const VertexLayout& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief 16 位位置量化参数
+ * 
+ * 解码：position = snorm * scale + offset。使用统一缩放（包围盒最大半边长），
+ * 反量化等价于一个均匀缩放 + 平移，不影响法线方向。
+ */
+struct VertexQuantization {
+    Vector3 offset = Vector3::Zero();   // 包围盒中心
+    float scale = 1.0f;                 // 包围盒最大半边长
+    
+    /**
+     * @brief 根据包围盒计算量化参数
+     */
+    static VertexQuantization FromBounds(const AABB& bounds);
+    
+    /**
+     * @brief 位置是否在可无损截断的量化范围内
+     */
+    bool Contains(const Vector3& position) const;
+    
+    /**
+     * @brief 着色器 uniform 打包（xyz = offset，w = scale）
+     */
+    Vector4 ToVector4() const { return Vector4(offset.x(), offset.y(), offset.z(), scale); }
+};
+
+/**
+ * @brief 顶点压缩编解码（CPU 端）
+ * 
+ * 编码结果与 Mesh::SetupVertexAttributes 的属性指针一一对应；解码用于测试和工具链校验。
+ */
+class VertexCodec {
+public:
+    /**
+     * @brief float → IEEE half（就近舍入，溢出饱和到 Inf）
+     */
+    static uint16_t FloatToHalf(float value);
+    
+    /**
+     * @brief IEEE half → float
+     */
+    static float HalfToFloat(uint16_t value);
+    
+    /**
+     * @brief 单位向量八面体编码到 2×int16（snorm）
+     */
+    static void OctEncode(const Vector3& direction, int16_t& outX, int16_t& outY);
+    
+    /**
+     * @brief 八面体解码（返回单位向量）
+     */
+    static Vector3 OctDecode(int16_t x, int16_t y);
+    
+    /**
+     * @brief float [-1,1] → snorm16
+     */
+    static int16_t FloatToSNorm16(float value);
+    
+    /**
+     * @brief snorm16 → float [-1,1]（与 OpenGL 归一化规则一致）
+     */
+    static float SNorm16ToFloat(int16_t value);
+    
+    /**
+     * @brief 颜色打包为 RGBA8（内存顺序 r,g,b,a）
+     */
+    static uint32_t PackColorUNorm8(const Color& color);
+    
+    /**
+     * @brief RGBA8 解包为颜色
+     */
+    static Color UnpackColorUNorm8(uint32_t packed);
+    
+    /**
+     * @brief 按布局编码顶点
+     * @param vertices 源顶点
+     * @param count 顶点数
+     * @param layout 目标布局
+     * @param quantization 位置量化参数（仅 SNorm16 位置使用）
+     * @param out 输出缓冲，大小至少 count * layout.GetStride()
+     */
+    static void Encode(const Vertex* vertices, size_t count, const VertexLayout& layout,
+                       const VertexQuantization& quantization, uint8_t* out);
+    
+    /**
+     * @brief 解码单个顶点（未存储的属性取着色器默认值）
+     */
+    static Vertex Decode(const uint8_t* data, const VertexLayout& layout,
+                         const VertexQuantization& quantization);
+};
+
+/**
+ * @brief 索引格式选择与打包（CPU 端）
+ */
+class IndexCodec {
+public:
+    static constexpr size_t kMaxUInt16Vertices = 65536;   // 16 位索引可寻址的最大顶点数
+    
+    /**
+     * @brief 根据顶点数选择索引格式（≤ 65536 → UInt16，否则 UInt32）
+     */
+    static IndexFormat SelectFormat(size_t vertexCount) {
+        return vertexCount <= kMaxUInt16Vertices ? IndexFormat::UInt16 : IndexFormat::UInt32;
+    }
+    
+    /**
+     * @brief 单个索引的字节数
+     */
+    static size_t GetIndexSize(IndexFormat format) {
+        return format == IndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+    
+    /**
+     * @brief 32 位索引截断为 16 位
+     * @note 调用者保证所有索引 < 65536（即按 SelectFormat 选出 UInt16）
+     * @param out 输出缓冲，大小至少 count
+     */
+    static void PackUInt16(const uint32_t* indices, size_t count, uint16_t* out);
+};
+
+} // namespace Render
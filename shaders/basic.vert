@@ -22,7 +22,22 @@ uniform mat4 uView;
 uniform mat4 uProjection;
 uniform bool uHasInstanceData;
 
+// 顶点布局解码（见 render/vertex_layout.h）：bit0 量化位置，bit1 八面体法线，bit2 八面体切线
+uniform int uVertexLayoutFlags;
+uniform vec4 uVertexDequant;    // xyz = offset, w = scale
+
+vec3 OctDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0);
+    v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));
+    return normalize(v);
+}
+
 void main() {
+    // 解码压缩顶点属性
+    vec3 position = (uVertexLayoutFlags & 1) != 0 ? aPosition * uVertexDequant.w + uVertexDequant.xyz : aPosition;
+    vec3 normal = (uVertexLayoutFlags & 2) != 0 ? OctDecode(aNormal.xy) : aNormal;
+    
     mat4 instanceModel = mat4(1.0);
     if (uHasInstanceData) {
         instanceModel = mat4(aInstanceRow0, aInstanceRow1, aInstanceRow2, aInstanceRow3);
@@ -31,11 +46,11 @@ void main() {
     mat4 modelMatrix = uModel * instanceModel;
 
     // 计算世界空间位置
-    vec4 worldPos = modelMatrix * vec4(aPosition, 1.0);
+    vec4 worldPos = modelMatrix * vec4(position, 1.0);
     FragPos = worldPos.xyz;
 
     // 变换法线到世界空间
-    Normal = mat3(transpose(inverse(modelMatrix))) * aNormal;
+    Normal = mat3(transpose(inverse(modelMatrix))) * normal;
 
     // 传递纹理坐标和顶点颜色
     TexCoord = aTexCoord;
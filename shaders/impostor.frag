@@ -0,0 +1,19 @@
+#version 450 core
+
+// 输入
+in vec2 TexCoord;
+
+// 输出
+out vec4 FragColor;
+
+// Uniforms
+uniform sampler2D uImpostorAtlas;
+uniform float uAlphaCutoff;
+
+void main() {
+    vec4 color = texture(uImpostorAtlas, TexCoord);
+    if (color.a < uAlphaCutoff) {
+        discard;
+    }
+    FragColor = vec4(color.rgb, 1.0);
+}
@@ -0,0 +1,70 @@
+#version 450 core
+
+// 顶点属性（单位四边形，xy ∈ [-0.5, 0.5]）
+layout(location = 0) in vec3 aPosition;
+layout(location = 4) in vec4 aInstanceRow0;
+layout(location = 5) in vec4 aInstanceRow1;
+layout(location = 6) in vec4 aInstanceRow2;
+layout(location = 7) in vec4 aInstanceRow3;
+
+// 输出到片段着色器
+out vec2 TexCoord;
+
+// Uniforms
+uniform mat4 uModel;
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform bool uHasInstanceData;
+
+uniform int uImpostorFramesPerAxis;
+uniform vec3 uImpostorCenter;
+uniform float uImpostorRadius;
+
+// 八面体映射（y 轴向上，与 ImpostorAtlas::OctahedralEncode/Decode 一致）
+vec2 SignNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec2 OctahedralEncode(vec3 n) {
+    n /= (abs(n.x) + abs(n.y) + abs(n.z));
+    vec2 p = n.xz;
+    if (n.y < 0.0) {
+        p = (1.0 - abs(p.yx)) * SignNotZero(p);
+    }
+    return p;
+}
+
+vec3 OctahedralDecode(vec2 p) {
+    vec3 n = vec3(p.x, 1.0 - abs(p.x) - abs(p.y), p.y);
+    if (n.y < 0.0) {
+        n.xz = (1.0 - abs(n.zx)) * SignNotZero(n.xz);
+    }
+    return normalize(n);
+}
+
+void main() {
+    mat4 instanceModel = mat4(1.0);
+    if (uHasInstanceData) {
+        instanceModel = mat4(aInstanceRow0, aInstanceRow1, aInstanceRow2, aInstanceRow3);
+    }
+    mat4 modelMatrix = uModel * instanceModel;
+
+    // 相机位置变换到实例局部空间，得到从替身中心指向相机的方向
+    vec3 cameraPosWS = -transpose(mat3(uView)) * uView[3].xyz;
+    vec3 cameraPosLocal = (inverse(modelMatrix) * vec4(cameraPosWS, 1.0)).xyz;
+    vec3 toCamera = cameraPosLocal - uImpostorCenter;
+    toCamera = dot(toCamera, toCamera) > 0.0 ? normalize(toCamera) : vec3(0.0, 0.0, 1.0);
+
+    // 选择最接近的帧，四边形朝向该帧的观察方向（与烘焙时的相机基一致）
+    float frames = float(uImpostorFramesPerAxis);
+    vec2 frame = clamp(floor((OctahedralEncode(toCamera) * 0.5 + 0.5) * frames), 0.0, frames - 1.0);
+    vec3 frameDir = OctahedralDecode((frame + 0.5) / frames * 2.0 - 1.0);
+    vec3 upHint = abs(frameDir.y) > 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+    vec3 right = normalize(cross(upHint, frameDir));
+    vec3 up = cross(frameDir, right);
+
+    vec3 localPos = uImpostorCenter + (right * aPosition.x + up * aPosition.y) * (2.0 * uImpostorRadius);
+    TexCoord = (frame + aPosition.xy + 0.5) / frames;
+
+    gl_Position = uProjection * uView * modelMatrix * vec4(localPos, 1.0);
+}
@@ -34,7 +34,28 @@ const int MAX_EXTRA_UV_SETS = 4;
 uniform int uExtraUVSetCount;
 uniform vec2 uExtraUVSetScales[MAX_EXTRA_UV_SETS];
 
+// 顶点布局解码（见 render/vertex_layout.h）：bit0 量化位置，bit1 八面体法线，bit2 八面体切线
+uniform int uVertexLayoutFlags;
+uniform vec4 uVertexDequant;    // xyz = offset, w = scale
+
+vec3 OctDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0);
+    v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));
+    return normalize(v);
+}
+
 void main() {
+    // 解码压缩顶点属性
+    vec3 position = (uVertexLayoutFlags & 1) != 0 ? aPosition * uVertexDequant.w + uVertexDequant.xyz : aPosition;
+    vec3 normal = (uVertexLayoutFlags & 2) != 0 ? OctDecode(aNormal.xy) : aNormal;
+    vec3 tangent = aTangent;
+    vec3 bitangent = aBitangent;
+    if ((uVertexLayoutFlags & 4) != 0) {
+        tangent = OctDecode(aTangent.xy);
+        bitangent = cross(normal, tangent) * (aTangent.z < 0.0 ? -1.0 : 1.0);
+    }
+    
     // 构建实例变换矩阵
     mat4 instanceModel = mat4(1.0);
     if (uHasInstanceData) {
@@ -45,7 +66,7 @@ void main() {
     mat4 modelMatrix = uModel * instanceModel;
     
     // 世界空间位置
-    FragPos = vec3(modelMatrix * vec4(aPosition, 1.0));
+    FragPos = vec3(modelMatrix * vec4(position, 1.0));
     
     // ✅ 法线矩阵计算：提取3x3矩阵的上部分（旋转+缩放）
     // 使用 transpose(inverse()) 来正确处理非均匀缩放
@@ -54,9 +75,9 @@ void main() {
     mat3 normalMatrix = transpose(inverse(model3x3));
     
     // 世界空间法线与切线空间
-    Normal = normalize(normalMatrix * aNormal);
-    Tangent = normalize(normalMatrix * aTangent);
-    Bitangent = normalize(normalMatrix * aBitangent);
+    Normal = normalize(normalMatrix * normal);
+    Tangent = normalize(normalMatrix * tangent);
+    Bitangent = normalize(normalMatrix * bitangent);
     
     // 传递纹理坐标（支持多个额外缩放集合）
     vec2 adjustedUV = aTexCoord;
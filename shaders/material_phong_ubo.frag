@@ -0,0 +1,204 @@
+#version 450 core
+
+const int MAX_DIRECTIONAL = 4;
+const int MAX_POINT = 8;
+const int MAX_SPOT = 4;
+const int MAX_AMBIENT = 4;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec3 Tangent;
+in vec3 Bitangent;
+in vec2 TexCoord;
+in vec4 VertexColor;
+
+out vec4 FragColor;
+
+// 帧数据块（与顶点着色器声明一致）
+layout(std140, binding = 0) uniform FrameData {
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uCameraPosition;
+    vec4 uTimeParams;
+    ivec4 uLightCounts;
+    ivec4 uCulledLightCounts;
+    vec4 uDirectionalDirections[MAX_DIRECTIONAL];
+    vec4 uDirectionalColors[MAX_DIRECTIONAL];
+    vec4 uPointPositions[MAX_POINT];
+    vec4 uPointColors[MAX_POINT];
+    vec4 uPointAttenuation[MAX_POINT];
+    vec4 uSpotPositions[MAX_SPOT];
+    vec4 uSpotColors[MAX_SPOT];
+    vec4 uSpotDirections[MAX_SPOT];
+    vec4 uSpotAttenuation[MAX_SPOT];
+    vec4 uAmbientColors[MAX_AMBIENT];
+    vec4 uLegacyLightPosition;
+    vec4 uLegacyLightColor;
+    vec4 uLegacyAmbientColor;
+};
+
+// 材质数据块：材质属性变化时重新上传
+layout(std140, binding = 1) uniform MaterialData {
+    vec4 uMatAmbient;
+    vec4 uMatDiffuse;
+    vec4 uMatSpecular;
+    vec4 uMatEmissive;
+    vec4 uMatParams;   // x = shininess, y = opacity, z = metallic, w = roughness
+};
+
+uniform sampler2D diffuseMap;
+uniform bool hasDiffuseMap;
+uniform sampler2D normalMap;
+uniform bool hasNormalMap;
+uniform bool uUseVertexColor;
+
+const int MAX_EXTRA_COLOR_SETS = 4;
+uniform int uExtraColorSetCount;
+uniform vec4 uExtraColorSets[MAX_EXTRA_COLOR_SETS];
+
+float Shininess() {
+    return uMatParams.x;
+}
+
+vec3 EvaluateDirectionalLight(int index, vec3 norm, vec3 viewDir, vec3 baseDiffuse) {
+    vec3 direction = normalize(-uDirectionalDirections[index].xyz);
+    vec3 lightColor = uDirectionalColors[index].rgb * uDirectionalColors[index].a;
+
+    float diff = max(dot(norm, direction), 0.0);
+    vec3 diffuse = diff * baseDiffuse * lightColor;
+
+    vec3 reflectDir = reflect(-direction, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), Shininess());
+    vec3 specular = spec * uMatSpecular.rgb * lightColor;
+
+    return diffuse + specular;
+}
+
+vec3 EvaluatePointLight(int index, vec3 norm, vec3 viewDir, vec3 baseDiffuse) {
+    vec3 position = uPointPositions[index].xyz;
+    float range = uPointPositions[index].w;
+    vec3 lightVector = position - FragPos;
+    float distance = length(lightVector);
+    vec3 lightDir = distance > 0.0 ? lightVector / distance : vec3(0.0);
+
+    vec3 attenuation = uPointAttenuation[index].xyz;
+    float denom = attenuation.x + attenuation.y * distance + attenuation.z * distance * distance;
+    float att = denom > 0.0001 ? 1.0 / denom : 1.0;
+    if (range > 0.0) {
+        att *= clamp(1.0 - distance / range, 0.0, 1.0);
+    }
+
+    vec3 lightColor = uPointColors[index].rgb * uPointColors[index].a;
+
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * baseDiffuse * lightColor;
+
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), Shininess());
+    vec3 specular = spec * uMatSpecular.rgb * lightColor;
+
+    return (diffuse + specular) * att;
+}
+
+vec3 EvaluateSpotLight(int index, vec3 norm, vec3 viewDir, vec3 baseDiffuse) {
+    vec3 position = uSpotPositions[index].xyz;
+    float range = uSpotPositions[index].w;
+    vec3 lightVector = position - FragPos;
+    float distance = length(lightVector);
+    vec3 lightDir = distance > 0.0 ? lightVector / distance : vec3(0.0);
+
+    vec3 spotDirection = normalize(uSpotDirections[index].xyz);
+    float outerCos = uSpotDirections[index].w;
+    float innerCos = uSpotAttenuation[index].w;
+
+    float theta = dot(-lightDir, spotDirection);
+    float epsilon = max(innerCos - outerCos, 1e-4);
+    float intensity = clamp((theta - outerCos) / epsilon, 0.0, 1.0);
+    if (theta <= outerCos || intensity <= 0.0) {
+        return vec3(0.0);
+    }
+
+    vec3 attenuation = uSpotAttenuation[index].xyz;
+    float denom = attenuation.x + attenuation.y * distance + attenuation.z * distance * distance;
+    float att = denom > 0.0001 ? 1.0 / denom : 1.0;
+    if (range > 0.0) {
+        att *= clamp(1.0 - distance / range, 0.0, 1.0);
+    }
+    att *= intensity;
+
+    vec3 lightColor = uSpotColors[index].rgb * uSpotColors[index].a;
+
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * baseDiffuse * lightColor;
+
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), Shininess());
+    vec3 specular = spec * uMatSpecular.rgb * lightColor;
+
+    return (diffuse + specular) * att;
+}
+
+vec3 EvaluateLegacyLight(vec3 norm, vec3 viewDir, vec3 baseDiffuse) {
+    vec3 lightDir = normalize(uLegacyLightPosition.xyz - FragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * baseDiffuse;
+
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), Shininess());
+    vec3 specular = spec * uMatSpecular.rgb;
+
+    return diffuse + specular;
+}
+
+void main() {
+    vec3 norm = normalize(Normal);
+    if (hasNormalMap) {
+        vec3 T = normalize(Tangent);
+        vec3 B = normalize(Bitangent);
+        vec3 N = normalize(norm);
+        mat3 TBN = mat3(T, B, N);
+        vec3 sampledNormal = texture(normalMap, TexCoord).xyz * 2.0 - 1.0;
+        norm = normalize(TBN * sampledNormal);
+    }
+
+    vec4 baseColor = uMatDiffuse;
+    if (hasDiffuseMap) {
+        vec4 texColor = texture(diffuseMap, TexCoord);
+        baseColor = texColor * uMatDiffuse;
+        baseColor.rgb = clamp(baseColor.rgb, 0.0, 1.0);
+    }
+    if (uUseVertexColor) {
+        baseColor *= VertexColor;
+    }
+    for (int i = 0; i < uExtraColorSetCount && i < MAX_EXTRA_COLOR_SETS; ++i) {
+        baseColor *= uExtraColorSets[i];
+    }
+
+    vec3 result = uMatAmbient.rgb * baseColor.rgb;
+    vec3 viewDir = normalize(uCameraPosition.xyz - FragPos);
+
+    int lightTotal = uLightCounts.x + uLightCounts.y + uLightCounts.z + uLightCounts.w;
+    if (lightTotal > 0) {
+        for (int i = 0; i < uLightCounts.w && i < MAX_AMBIENT; ++i) {
+            vec3 ambientColor = uAmbientColors[i].rgb * uAmbientColors[i].a;
+            result += ambientColor * baseColor.rgb;
+        }
+
+        for (int i = 0; i < uLightCounts.x && i < MAX_DIRECTIONAL; ++i) {
+            result += EvaluateDirectionalLight(i, norm, viewDir, baseColor.rgb);
+        }
+
+        for (int i = 0; i < uLightCounts.y && i < MAX_POINT; ++i) {
+            result += EvaluatePointLight(i, norm, viewDir, baseColor.rgb);
+        }
+
+        for (int i = 0; i < uLightCounts.z && i < MAX_SPOT; ++i) {
+            result += EvaluateSpotLight(i, norm, viewDir, baseColor.rgb);
+        }
+    } else {
+        result += EvaluateLegacyLight(norm, viewDir, baseColor.rgb);
+    }
+
+    FragColor = vec4(result + uMatEmissive.rgb, baseColor.a * uMatParams.y);
+}
@@ -0,0 +1,126 @@
+#version 450 core
+
+// 顶点属性
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec3 aNormal;
+layout(location = 3) in vec4 aColor;
+layout(location = 4) in vec3 aTangent;
+layout(location = 5) in vec3 aBitangent;
+
+// 实例化属性
+layout(location = 6) in vec4 aInstanceRow0;
+layout(location = 7) in vec4 aInstanceRow1;
+layout(location = 8) in vec4 aInstanceRow2;
+layout(location = 9) in vec4 aInstanceRow3;
+layout(location = 10) in vec4 aInstanceColor;
+layout(location = 11) in vec4 aInstanceParams;
+
+// 输出到片段着色器
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out vec4 VertexColor;
+out vec3 Tangent;
+out vec3 Bitangent;
+
+// 帧数据块：每帧由 UniformSystem 上传一次（布局见 render/std140_layout.h）
+const int MAX_DIRECTIONAL = 4;
+const int MAX_POINT = 8;
+const int MAX_SPOT = 4;
+const int MAX_AMBIENT = 4;
+
+layout(std140, binding = 0) uniform FrameData {
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uCameraPosition;
+    vec4 uTimeParams;
+    ivec4 uLightCounts;
+    ivec4 uCulledLightCounts;
+    vec4 uDirectionalDirections[MAX_DIRECTIONAL];
+    vec4 uDirectionalColors[MAX_DIRECTIONAL];
+    vec4 uPointPositions[MAX_POINT];
+    vec4 uPointColors[MAX_POINT];
+    vec4 uPointAttenuation[MAX_POINT];
+    vec4 uSpotPositions[MAX_SPOT];
+    vec4 uSpotColors[MAX_SPOT];
+    vec4 uSpotDirections[MAX_SPOT];
+    vec4 uSpotAttenuation[MAX_SPOT];
+    vec4 uAmbientColors[MAX_AMBIENT];
+    vec4 uLegacyLightPosition;
+    vec4 uLegacyLightColor;
+    vec4 uLegacyAmbientColor;
+};
+
+// Uniforms
+uniform mat4 uModel;
+uniform bool uHasInstanceData;
+
+const int MAX_EXTRA_UV_SETS = 4;
+uniform int uExtraUVSetCount;
+uniform vec2 uExtraUVSetScales[MAX_EXTRA_UV_SETS];
+
+// 顶点布局解码（见 render/vertex_layout.h）：bit0 量化位置，bit1 八面体法线，bit2 八面体切线
+uniform int uVertexLayoutFlags;
+uniform vec4 uVertexDequant;    // xyz = offset, w = scale
+
+vec3 OctDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0);
+    v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));
+    return normalize(v);
+}
+
+void main() {
+    // 解码压缩顶点属性
+    vec3 position = (uVertexLayoutFlags & 1) != 0 ? aPosition * uVertexDequant.w + uVertexDequant.xyz : aPosition;
+    vec3 normal = (uVertexLayoutFlags & 2) != 0 ? OctDecode(aNormal.xy) : aNormal;
+    vec3 tangent = aTangent;
+    vec3 bitangent = aBitangent;
+    if ((uVertexLayoutFlags & 4) != 0) {
+        tangent = OctDecode(aTangent.xy);
+        bitangent = cross(normal, tangent) * (aTangent.z < 0.0 ? -1.0 : 1.0);
+    }
+    
+    // 构建实例变换矩阵
+    mat4 instanceModel = mat4(1.0);
+    if (uHasInstanceData) {
+        instanceModel = mat4(aInstanceRow0, aInstanceRow1, aInstanceRow2, aInstanceRow3);
+    }
+    
+    // 组合模型矩阵和实例矩阵
+    mat4 modelMatrix = uModel * instanceModel;
+    
+    // 世界空间位置
+    FragPos = vec3(modelMatrix * vec4(position, 1.0));
+    
+    // ✅ 法线矩阵计算：提取3x3矩阵的上部分（旋转+缩放）
+    // 使用 transpose(inverse()) 来正确处理非均匀缩放
+    // 注意：对于均匀缩放，这仍然正确，只是稍微低效
+    mat3 model3x3 = mat3(modelMatrix);
+    mat3 normalMatrix = transpose(inverse(model3x3));
+    
+    // 世界空间法线与切线空间
+    Normal = normalize(normalMatrix * normal);
+    Tangent = normalize(normalMatrix * tangent);
+    Bitangent = normalize(normalMatrix * bitangent);
+    
+    // 传递纹理坐标（支持多个额外缩放集合）
+    vec2 adjustedUV = aTexCoord;
+    for (int i = 0; i < uExtraUVSetCount && i < MAX_EXTRA_UV_SETS; ++i) {
+        adjustedUV *= uExtraUVSetScales[i];
+    }
+    TexCoord = adjustedUV;
+    
+    // 传递顶点颜色（如果使用实例颜色，则混合）
+    if (uHasInstanceData) {
+        VertexColor = aColor * aInstanceColor;
+    } else {
+        VertexColor = aColor;
+    }
+    
+    // 计算最终位置
+    gl_Position = uViewProjection * vec4(FragPos, 1.0);
+}
+
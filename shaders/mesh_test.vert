@@ -13,12 +13,26 @@ out vec4 VertexColor;
 // Uniforms
 uniform mat4 uMVP;
 
+// 顶点布局解码（见 render/vertex_layout.h）：bit0 量化位置，bit1 八面体法线
+uniform int uVertexLayoutFlags;
+uniform vec4 uVertexDequant;    // xyz = offset, w = scale
+
+vec3 OctDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0);
+    v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));
+    return normalize(v);
+}
+
 void main() {
+    // 解码压缩顶点属性
+    vec3 position = (uVertexLayoutFlags & 1) != 0 ? aPosition * uVertexDequant.w + uVertexDequant.xyz : aPosition;
+    vec3 normal = (uVertexLayoutFlags & 2) != 0 ? OctDecode(aNormal.xy) : aNormal;
+    
     // 传递法线和顶点颜色
-    Normal = aNormal;
+    Normal = normal;
     VertexColor = aColor;
     
     // 计算最终位置
-    gl_Position = uMVP * vec4(aPosition, 1.0);
+    gl_Position = uMVP * vec4(position, 1.0);
 }
-
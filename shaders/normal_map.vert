@@ -11,6 +11,17 @@ uniform mat4 uModel;
 uniform mat4 uView;
 uniform mat4 uProjection;
 
+// 顶点布局解码（见 render/vertex_layout.h）：bit0 量化位置，bit1 八面体法线，bit2 八面体切线
+uniform int uVertexLayoutFlags;
+uniform vec4 uVertexDequant;    // xyz = offset, w = scale
+
+vec3 OctDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0);
+    v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));
+    return normalize(v);
+}
+
 out vec3 FragPos;
 out vec2 TexCoord;
 out vec3 Normal;
@@ -19,13 +30,23 @@ out vec3 Bitangent;
 out vec4 VertexColor;
 
 void main() {
+    // 解码压缩顶点属性
+    vec3 position = (uVertexLayoutFlags & 1) != 0 ? aPosition * uVertexDequant.w + uVertexDequant.xyz : aPosition;
+    vec3 normal = (uVertexLayoutFlags & 2) != 0 ? OctDecode(aNormal.xy) : aNormal;
+    vec3 tangent = aTangent;
+    vec3 bitangent = aBitangent;
+    if ((uVertexLayoutFlags & 4) != 0) {
+        tangent = OctDecode(aTangent.xy);
+        bitangent = cross(normal, tangent) * (aTangent.z < 0.0 ? -1.0 : 1.0);
+    }
+    
     mat3 normalMatrix = mat3(transpose(inverse(uModel)));
 
-    vec3 T = normalize(normalMatrix * aTangent);
-    vec3 B = normalize(normalMatrix * aBitangent);
-    vec3 N = normalize(normalMatrix * aNormal);
+    vec3 T = normalize(normalMatrix * tangent);
+    vec3 B = normalize(normalMatrix * bitangent);
+    vec3 N = normalize(normalMatrix * normal);
 
-    FragPos = vec3(uModel * vec4(aPosition, 1.0));
+    FragPos = vec3(uModel * vec4(position, 1.0));
     TexCoord = aTexCoord;
     Normal = N;
     Tangent = T;
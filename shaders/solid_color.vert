@@ -6,7 +6,12 @@ uniform mat4 uModel;
 uniform mat4 uView;
 uniform mat4 uProjection;
 
+// 顶点布局解码（见 render/vertex_layout.h）：bit0 量化位置（法线与切线不使用）
+uniform int uVertexLayoutFlags;
+uniform vec4 uVertexDequant;    // xyz = offset, w = scale
+
 void main() {
-    gl_Position = uProjection * uView * uModel * vec4(aPosition, 1.0);
+    vec3 position = (uVertexLayoutFlags & 1) != 0 ? aPosition * uVertexDequant.w + uVertexDequant.xyz : aPosition;
+    gl_Position = uProjection * uView * uModel * vec4(position, 1.0);
 }
 
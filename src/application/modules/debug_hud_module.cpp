@@ -35,6 +35,7 @@
 #include "render/math_utils.h"
 #include "render/material_sort_key.h"
 #include "render/render_layer.h"
+#include "render/debug/profiler.h"
 #include <sstream>
 #include <iomanip>
 
@@ -271,12 +272,18 @@ void DebugHUDModule::UpdateTextContent(const FrameUpdateArgs&, AppContext& ctx)
     m_statsCache.batchedDrawCalls = renderStats.batchedDrawCalls;
     m_statsCache.instancedDrawCalls = renderStats.instancedDrawCalls;
     m_statsCache.instancedInstances = renderStats.instancedInstances;
+    m_statsCache.visibleMeshes = renderStats.visibleMeshes;
+    m_statsCache.culledMeshes = renderStats.culledMeshes;
+    m_statsCache.occludedMeshes = renderStats.occludedMeshes;
+    m_statsCache.occluders = renderStats.occluders;
     m_statsCache.textureCount = resourceStats.textureCount;
     m_statsCache.meshCount = resourceStats.meshCount;
     m_statsCache.materialCount = resourceStats.materialCount;
     m_statsCache.shaderCount = resourceStats.shaderCount;
     m_statsCache.textureMemory = resourceStats.textureMemory;
     m_statsCache.meshMemory = resourceStats.meshMemory;
+    m_statsCache.meshCPUMemory = resourceStats.meshCPUMemory;
+    m_statsCache.meshGPUMemory = resourceStats.meshGPUMemory;
     m_statsCache.totalMemory = resourceStats.totalMemory;
 
     // 格式化并更新文本内容
@@ -297,6 +304,10 @@ void DebugHUDModule::UpdateTextContent(const FrameUpdateArgs&, AppContext& ctx)
     lines.push_back(std::string("Batches: ") + std::to_string(m_statsCache.batchCount));
     lines.push_back(std::string("Triangles: ") + std::to_string(m_statsCache.triangles));
     lines.push_back(std::string("Vertices: ") + std::to_string(m_statsCache.vertices));
+    lines.push_back(std::string("Visible: ") + std::to_string(m_statsCache.visibleMeshes) +
+                    " Culled: " + std::to_string(m_statsCache.culledMeshes));
+    lines.push_back(std::string("  Occluded: ") + std::to_string(m_statsCache.occludedMeshes) +
+                    " (" + std::to_string(m_statsCache.occluders) + " occluders)");
     
     // 资源统计
     lines.push_back("=== Resources ===");
@@ -313,7 +324,9 @@ void DebugHUDModule::UpdateTextContent(const FrameUpdateArgs&, AppContext& ctx)
     float meshMemMB = static_cast<float>(m_statsCache.meshMemory) / (1024.0f * 1024.0f);
     lines.push_back(std::string("Memory: ") + std::to_string(totalMemMB) + " MB");
     lines.push_back(std::string("  Textures: ") + std::to_string(textureMemMB) + " MB");
-    lines.push_back(std::string("  Meshes: ") + std::to_string(meshMemMB) + " MB");
+    lines.push_back(std::string("  Meshes: ") + std::to_string(meshMemMB) + " MB (CPU " +
+                    std::to_string(static_cast<float>(m_statsCache.meshCPUMemory) / (1024.0f * 1024.0f)) + " / GPU " +
+                    std::to_string(static_cast<float>(m_statsCache.meshGPUMemory) / (1024.0f * 1024.0f)) + ")");
 
     // 更新文本对象并重新计算位置（确保左对齐和文本不超出窗口）
     const float screenWidth = static_cast<float>(ctx.renderer->GetWidth());
@@ -412,6 +425,11 @@ void DebugHUDModule::DrawHUD(const FrameUpdateArgs& frame, AppContext& ctx) {
     if (m_showUniformMaterialInfo) {
         UpdateUniformMaterialInfoText(frame, ctx);
     }
+    
+    // 更新帧分析器信息（如果启用）
+    if (m_showProfilerInfo) {
+        UpdateProfilerInfoText(frame, ctx);
+    }
 
     // 提交所有文本渲染对象
     for (auto& renderable : m_textRenderables) {
@@ -437,6 +455,15 @@ void DebugHUDModule::DrawHUD(const FrameUpdateArgs& frame, AppContext& ctx) {
             }
         }
     }
+    
+    // 提交帧分析器文本对象
+    if (m_showProfilerInfo) {
+        for (auto& renderable : m_profilerTextRenderables) {
+            if (renderable && renderable->IsVisible()) {
+                renderable->SubmitToRenderer(ctx.renderer);
+            }
+        }
+    }
 }
 
 // 辅助函数：创建右对齐的文本对象
@@ -506,7 +533,8 @@ void DebugHUDModule::UpdateRightAlignedTextObjects(
     const std::vector<std::string>& lines,
     std::vector<TextPtr>& textObjects,
     std::vector<std::unique_ptr<TextRenderable>>& textRenderables,
-    AppContext& ctx) {
+    AppContext& ctx,
+    float topMargin) {
     
     if (!ctx.renderer || textObjects.size() != textRenderables.size()) {
         return;
@@ -514,7 +542,6 @@ void DebugHUDModule::UpdateRightAlignedTextObjects(
     
     const float screenWidth = static_cast<float>(ctx.renderer->GetWidth());
     const float rightMargin = 20.0f;
-    const float topMargin = 20.0f;
     const float lineHeight = 20.0f;
     
     // 更新文本内容并获取实际尺寸
@@ -641,7 +668,9 @@ void DebugHUDModule::UpdateUniformMaterialInfoText(const FrameUpdateArgs&, AppCo
     memStream << "  Texture: " << textureMemMB << " MB";
     lines.push_back(memStream.str());
     memStream.str("");
-    memStream << "  Mesh: " << meshMemMB << " MB";
+    memStream << "  Mesh: " << meshMemMB << " MB (CPU "
+              << static_cast<float>(stats.meshCPUMemory) / (1024.0f * 1024.0f) << " / GPU "
+              << static_cast<float>(stats.meshGPUMemory) / (1024.0f * 1024.0f) << ")";
     lines.push_back(memStream.str());
     memStream.str("");
     memStream << "  Total: " << totalMemMB << " MB";
@@ -726,6 +755,78 @@ void DebugHUDModule::UpdateUniformMaterialInfoText(const FrameUpdateArgs&, AppCo
     }
 }
 
-} // namespace Render::Application
-
+void DebugHUDModule::UpdateProfilerInfoText(const FrameUpdateArgs&, AppContext& ctx) {
+    if (!ctx.renderer || !m_font) {
+        return;
+    }
+    
+    const auto& profiler = Profiler::GetInstance();
+    const ProfilerFrame lastFrame = profiler.GetLastFrame();
+    const auto topScopes = profiler.GetTopScopes(m_profilerTopN);
+    
+    // 构建文本内容
+    std::vector<std::string> lines;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    
+    ss << "=== Profiler (frame " << lastFrame.frameIndex << ", " << lastFrame.frameMs << " ms) ===";
+    lines.push_back(ss.str());
+    
+    if (!profiler.IsEnabled()) {
+        lines.push_back("(disabled)");
+    }
+    
+    for (const auto& scope : topScopes) {
+        ss.str("");
+        ss << scope.path << "  " << scope.totalMs << " ms (self " << scope.selfMs
+           << ", x" << scope.callCount << ")";
+        lines.push_back(ss.str());
+    }
+    
+    // GPU 结果通常延迟数帧，显示最近一次已解析的帧
+    if (profiler.IsGpuTimingAvailable()) {
+        const auto history = profiler.GetHistory();
+        for (auto it = history.rbegin(); it != history.rend(); ++it) {
+            if (it->gpuScopes.empty()) {
+                continue;
+            }
+            for (const auto& scope : it->gpuScopes) {
+                ss.str("");
+                ss << "GPU " << scope.path << "  " << scope.totalMs << " ms";
+                lines.push_back(ss.str());
+            }
+            break;
+        }
+    }
+    
+    if (lastFrame.droppedEvents > 0) {
+        lines.push_back("Dropped events: " + std::to_string(lastFrame.droppedEvents));
+    }
+    
+    // 动态创建文本对象（如果数量变化）
+    if (m_profilerTextObjects.size() != lines.size()) {
+        CreateRightAlignedTextObjects(
+            m_profilerTextObjects,
+            m_profilerTextRenderables,
+            lines.size(),
+            ctx,
+            3000,
+            Color(1.0f, 1.0f, 0.0f, 1.0f),  // 黄色标题
+            Color(1.0f, 0.85f, 0.7f, 1.0f)  // 浅橙色文本
+        );
+    }
+    
+    // 位于层级信息与 Uniform/材质信息下方
+    const float lineHeight = 20.0f;
+    float topMargin = 20.0f;
+    if (m_showLayerInfo && !m_layerInfoTextObjects.empty()) {
+        topMargin += static_cast<float>(m_layerInfoTextObjects.size()) * lineHeight + 40.0f;
+    }
+    if (m_showUniformMaterialInfo && !m_uniformMaterialTextObjects.empty()) {
+        topMargin += static_cast<float>(m_uniformMaterialTextObjects.size()) * lineHeight + 40.0f;
+    }
+    
+    UpdateRightAlignedTextObjects(lines, m_profilerTextObjects, m_profilerTextRenderables, ctx, topMargin);
+}
 
+} // namespace Render::Application
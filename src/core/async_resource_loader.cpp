@@ -21,11 +21,16 @@
 #include "render/async_resource_loader.h"
 #include "render/mesh_loader.h"
 #include "render/texture_loader.h"
+#include "render/texture_upload_queue.h"
 #include "render/model_loader.h"
 #include "render/logger.h"
 #include "render/gl_thread_checker.h"
 #include "render/error.h"
 #include "render/task_scheduler.h"
+#include "render/lod_cache.h"
+#include "render/lod_generator.h"
+#include "render/file_utils.h"
+#include "render/resource_manager.h"
 #include <algorithm>
 #include <chrono>
 #include <unordered_set>
@@ -38,6 +43,70 @@ AsyncResourceLoader& AsyncResourceLoader::GetInstance() {
     return instance;
 }
 
+// ============================================================================
+// 请求合并
+// ============================================================================
+
+std::string AsyncResourceLoader::BuildRequestKey(AsyncResourceType type,
+                                                 const std::string& filepath,
+                                                 const std::string& name,
+                                                 const std::string& options) {
+    std::string key = std::to_string(static_cast<int>(type));
+    key += '|';
+    key += FileUtils::NormalizePath(filepath);
+    key += '|';
+    key += name;
+    key += '|';
+    key += options;
+    return key;
+}
+
+template<typename TaskT>
+std::shared_ptr<TaskT> AsyncResourceLoader::RegisterInflight(const std::shared_ptr<TaskT>& task) {
+    std::lock_guard<std::mutex> lock(m_inflightMutex);
+    
+    auto it = m_inflightTasks.find(task->requestKey);
+    if (it != m_inflightTasks.end() && it->second->status != LoadStatus::Failed) {
+        // AttachRequest 与 Cancel 同锁：已取消的任务不会再附着新请求
+        if (auto existing = std::dynamic_pointer_cast<TaskT>(it->second);
+            existing && existing->AttachRequest(task->requestId)) {
+            if (task->callback) {
+                existing->coalescedCallbacks.emplace_back(task->requestId, std::move(task->callback));
+            }
+            m_coalescedRequests++;
+            Logger::GetInstance().DebugFormat(
+                "AsyncResourceLoader: 合并重复请求 %s（已合并 %zu 个回调）",
+                existing->name.c_str(),
+                existing->coalescedCallbacks.size());
+            return existing;
+        }
+    }
+    
+    // 已取消/失败的旧任务被新任务替换
+    m_inflightTasks[task->requestKey] = task;
+    return task;
+}
+
+void AsyncResourceLoader::ReleaseInflight(const std::shared_ptr<LoadTaskBase>& task) {
+    if (!task || task->requestKey.empty()) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_inflightMutex);
+    auto it = m_inflightTasks.find(task->requestKey);
+    if (it != m_inflightTasks.end() && it->second == task) {
+        m_inflightTasks.erase(it);
+    }
+}
+
+void AsyncResourceLoader::EnqueueResolved(const std::shared_ptr<LoadTaskBase>& task) {
+    task->status = LoadStatus::Completed;
+    m_resourceHits++;
+    
+    std::lock_guard<std::mutex> lock(m_completedMutex);
+    m_completedTasks.push(task);
+}
+
 AsyncResourceLoader::AsyncResourceLoader() {
     Logger::GetInstance().Info("AsyncResourceLoader: 构造");
 }
@@ -77,6 +146,11 @@ void AsyncResourceLoader::Shutdown() {
     // ✅ 清空完成队列
     ClearAllPendingTasks();
     
+    // 释放 PBO 池（只能在 GL 线程执行；其他线程关闭时由持有上下文的一方负责）
+    if (GLThreadChecker::GetInstance().IsGLThread()) {
+        TextureUploadQueue::GetInstance().Shutdown();
+    }
+    
     // ✅ 打印统计
     PrintStatistics();
     
@@ -93,10 +167,16 @@ void AsyncResourceLoader::ClearAllPendingTasks() {
     // 清空已完成队列（这些任务的回调将不会被执行）
     {
         std::lock_guard<std::mutex> lock(m_completedMutex);
-        completedCleared = m_completedTasks.size();
+        completedCleared = m_completedTasks.size() + m_uploadingTasks.size();
         while (!m_completedTasks.empty()) {
             m_completedTasks.pop();
         }
+        m_uploadingTasks.clear();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_inflightMutex);
+        m_inflightTasks.clear();
     }
     
     if (completedCleared > 0) {
@@ -115,15 +195,35 @@ std::shared_ptr<MeshLoadTask> AsyncResourceLoader::LoadMeshAsync(
     const std::string& filepath,
     const std::string& name,
     std::function<void(const MeshLoadResult&)> callback,
-    float priority)
+    float priority,
+    LoadRequestId* outRequestId)
 {
+    const std::string resourceName = name.empty() ? filepath : name;
+    
+    // 已注册且已上传的网格直接返回，不再解析文件
+    if (auto mesh = ResourceManager::GetInstance().GetMesh(resourceName); mesh && mesh->IsUploaded()) {
+        auto resolved = std::make_shared<MeshLoadTask>();
+        resolved->name = resourceName;
+        resolved->type = AsyncResourceType::Mesh;
+        resolved->priority = priority;
+        resolved->callback = std::move(callback);
+        resolved->submitTime = std::chrono::steady_clock::now();
+        resolved->result = mesh;
+        if (outRequestId) {
+            *outRequestId = resolved->requestId;
+        }
+        EnqueueResolved(resolved);
+        return resolved;
+    }
+    
     auto task = std::make_shared<MeshLoadTask>();
-    task->name = name.empty() ? filepath : name;
+    task->name = resourceName;
     task->type = AsyncResourceType::Mesh;
     task->priority = priority;
     task->callback = callback;
     task->submitTime = std::chrono::steady_clock::now();
     task->maxRetries = 3;
+    task->requestKey = BuildRequestKey(AsyncResourceType::Mesh, filepath, name, "");
     
     // 定义加载函数（在工作线程执行）
     task->loadFunc = [filepath]() -> Ref<Mesh> {
@@ -172,6 +272,15 @@ std::shared_ptr<MeshLoadTask> AsyncResourceLoader::LoadMeshAsync(
         }
     };
     
+    if (outRequestId) {
+        *outRequestId = task->requestId;
+    }
+    
+    // 同一请求进行中：回调合并到已有任务
+    if (auto inflight = RegisterInflight(task); inflight != task) {
+        return inflight;
+    }
+    
     // ✅ 提交任务到TaskScheduler
     m_totalTasks++;
     m_loadingCount++;
@@ -194,6 +303,7 @@ std::shared_ptr<MeshLoadTask> AsyncResourceLoader::LoadMeshAsync(
                 m_loadingCount--;
                 
                 if (task->IsCancelled()) {
+                    ReleaseInflight(task);
                     return;
                 }
                 
@@ -205,6 +315,7 @@ std::shared_ptr<MeshLoadTask> AsyncResourceLoader::LoadMeshAsync(
                     m_completedTasks.push(task);
                 } else {
                     m_failedTasks++;
+                    ReleaseInflight(task);
                 }
             } catch (const std::exception& e) {
                 Logger::GetInstance().ErrorFormat(
@@ -215,6 +326,7 @@ std::shared_ptr<MeshLoadTask> AsyncResourceLoader::LoadMeshAsync(
                 task->errorMessage = e.what();
                 m_failedTasks++;
                 m_loadingCount--;
+                ReleaseInflight(task);
             }
         },
         taskPriority,
@@ -235,15 +347,58 @@ std::shared_ptr<TextureLoadTask> AsyncResourceLoader::LoadTextureAsync(
     const std::string& name,
     bool generateMipmap,
     std::function<void(const TextureLoadResult&)> callback,
-    float priority)
+    float priority,
+    LoadRequestId* outRequestId)
 {
+    const std::string resourceName = name.empty() ? filepath : name;
+    
+    // 1x1 纹理有无 mip 等价
+    const auto mipStateMatches = [generateMipmap](const Ref<Texture>& texture) {
+        if (texture->GetWidth() <= 1 && texture->GetHeight() <= 1) {
+            return true;
+        }
+        return (texture->GetMipLevelCount() > 1) == generateMipmap;
+    };
+    
+    // 已注册到 ResourceManager 或已在 TextureLoader 缓存中的纹理直接返回
+    std::string cacheName = resourceName;
+    Ref<Texture> existing = ResourceManager::GetInstance().GetTexture(resourceName);
+    if (!existing && TextureLoader::GetInstance().HasTexture(resourceName)) {
+        existing = TextureLoader::GetInstance().GetTexture(resourceName);
+    }
+    if (existing && !mipStateMatches(existing)) {
+        // 缓存按名称索引，同名纹理的 mip 状态不同：使用带选项后缀的缓存名单独加载
+        cacheName = resourceName + (generateMipmap ? "#mip" : "#nomip");
+        existing = TextureLoader::GetInstance().HasTexture(cacheName)
+            ? TextureLoader::GetInstance().GetTexture(cacheName)
+            : nullptr;
+        Logger::GetInstance().DebugFormat(
+            "AsyncResourceLoader: 纹理 %s 的 mip 状态与请求不一致，使用缓存名 %s",
+            resourceName.c_str(), cacheName.c_str());
+    }
+    if (existing) {
+        auto resolved = std::make_shared<TextureLoadTask>();
+        resolved->name = resourceName;
+        resolved->type = AsyncResourceType::Texture;
+        resolved->priority = priority;
+        resolved->callback = std::move(callback);
+        resolved->submitTime = std::chrono::steady_clock::now();
+        resolved->result = existing;
+        if (outRequestId) {
+            *outRequestId = resolved->requestId;
+        }
+        EnqueueResolved(resolved);
+        return resolved;
+    }
+    
     auto task = std::make_shared<TextureLoadTask>();
-    task->name = name.empty() ? filepath : name;
+    task->name = resourceName;
     task->type = AsyncResourceType::Texture;
     task->priority = priority;
     task->callback = callback;
     task->submitTime = std::chrono::steady_clock::now();
     task->maxRetries = 3;
+    task->requestKey = BuildRequestKey(AsyncResourceType::Texture, filepath, name, generateMipmap ? "mip" : "nomip");
     
     // 定义加载函数（工作线程）
     task->loadFunc = [filepath, generateMipmap]() -> std::unique_ptr<TextureLoader::TextureStagingData> {
@@ -262,20 +417,30 @@ std::shared_ptr<TextureLoadTask> AsyncResourceLoader::LoadTextureAsync(
             throw std::runtime_error(errorMessage);
         }
 
+        // 在工作线程生成 mip 链并直接写入 PBO，主线程只需分帧发出 glTexSubImage2D
+        TextureLoader::GetInstance().StageToPixelBuffer(*staging);
         return staging;
     };
     
     // 定义上传函数（主线程）
-    const std::string resolvedName = task->name;
-    task->uploadFunc = [resolvedName, filepath](TextureLoader::TextureStagingData&& staging)
-        -> Ref<Texture> {
-        std::string cacheName = resolvedName.empty() ? filepath : resolvedName;
-        auto texture = TextureLoader::GetInstance().UploadStagedTexture(cacheName, std::move(staging));
+    task->uploadFunc = [cacheName](TextureLoader::TextureStagingData&& staging,
+                                   TextureUploadTicket& ticket) -> Ref<Texture> {
+        auto texture = TextureLoader::GetInstance().BeginStagedUpload(cacheName, std::move(staging), ticket);
         if (!texture) {
             throw std::runtime_error("主线程：上传纹理失败 " + cacheName);
         }
         return texture;
     };
+    task->finishFunc = [cacheName](Ref<Texture> texture) -> Ref<Texture> {
+        return TextureLoader::GetInstance().FinishStagedUpload(cacheName, texture);
+    };
+    
+    if (outRequestId) {
+        *outRequestId = task->requestId;
+    }
+    if (auto inflight = RegisterInflight(task); inflight != task) {
+        return inflight;
+    }
     
     // ✅ 提交任务到TaskScheduler
     m_totalTasks++;
@@ -297,6 +462,7 @@ std::shared_ptr<TextureLoadTask> AsyncResourceLoader::LoadTextureAsync(
                     m_completedTasks.push(task);
                 } else {
                     m_failedTasks++;
+                    ReleaseInflight(task);
                 }
             } catch (const std::exception& e) {
                 Logger::GetInstance().ErrorFormat(
@@ -307,6 +473,7 @@ std::shared_ptr<TextureLoadTask> AsyncResourceLoader::LoadTextureAsync(
                 task->errorMessage = e.what();
                 m_failedTasks++;
                 m_loadingCount--;
+                ReleaseInflight(task);
             }
         },
         taskPriority,
@@ -323,8 +490,64 @@ std::shared_ptr<ModelLoadTask> AsyncResourceLoader::LoadModelAsync(
     const std::string& name,
     const ModelLoadOptions& options,
     std::function<void(const ModelLoadResult&)> callback,
-    float priority)
+    float priority,
+    LoadRequestId* outRequestId)
 {
+    // 影响加载结果或注册方式的选项都参与请求键
+    std::string optionsKey;
+    optionsKey += options.flipUVs ? '1' : '0';
+    optionsKey += options.autoUpload ? '1' : '0';
+    optionsKey += options.useBinaryCache ? '1' : '0';
+    optionsKey += options.registerModel ? '1' : '0';
+    optionsKey += options.registerMeshes ? '1' : '0';
+    optionsKey += options.registerMaterials ? '1' : '0';
+    optionsKey += options.updateDependencyGraph ? '1' : '0';
+    optionsKey += std::to_string(static_cast<int>(options.cpuResidency));
+    optionsKey += '|' + FileUtils::NormalizePath(options.basePath);
+    optionsKey += '|' + options.resourcePrefix;
+    optionsKey += '|' + std::to_string(reinterpret_cast<uintptr_t>(options.shaderOverride.get()));
+    const std::string requestKey = BuildRequestKey(AsyncResourceType::Model, filepath, name, optionsKey);
+    
+    // 同一请求此前已注册且模型仍在 ResourceManager 中：直接返回
+    if (options.registerModel) {
+        ModelRegistration registration;
+        bool recorded = false;
+        {
+            std::lock_guard<std::mutex> lock(m_inflightMutex);
+            if (auto it = m_registeredModels.find(requestKey); it != m_registeredModels.end()) {
+                registration = it->second;
+                recorded = true;
+            }
+        }
+        
+        ModelPtr model = recorded ? ResourceManager::GetInstance().GetModel(registration.modelName) : nullptr;
+        if (model) {
+            auto resolved = std::make_shared<ModelLoadTask>();
+            resolved->name = name.empty() ? filepath : name;
+            resolved->type = AsyncResourceType::Model;
+            resolved->priority = priority;
+            resolved->callback = std::move(callback);
+            resolved->requestedOptions = options;
+            resolved->filepath = filepath;
+            resolved->overrideName = name;
+            resolved->submitTime = std::chrono::steady_clock::now();
+            resolved->result.model = model;
+            resolved->result.modelName = registration.modelName;
+            resolved->result.meshResourceNames = std::move(registration.meshResourceNames);
+            resolved->result.materialResourceNames = std::move(registration.materialResourceNames);
+            if (outRequestId) {
+                *outRequestId = resolved->requestId;
+            }
+            EnqueueResolved(resolved);
+            return resolved;
+        }
+        if (recorded) {
+            // 模型已被卸载，记录失效
+            std::lock_guard<std::mutex> lock(m_inflightMutex);
+            m_registeredModels.erase(requestKey);
+        }
+    }
+    
     auto task = std::make_shared<ModelLoadTask>();
     task->name = name.empty() ? filepath : name;
     task->type = AsyncResourceType::Model;
@@ -335,6 +558,7 @@ std::shared_ptr<ModelLoadTask> AsyncResourceLoader::LoadModelAsync(
     task->overrideName = name;
     task->submitTime = std::chrono::steady_clock::now();
     task->maxRetries = 3;
+    task->requestKey = requestKey;
 
     ModelLoadOptions workerOptions = options;
     workerOptions.autoUpload = false;
@@ -440,6 +664,13 @@ std::shared_ptr<ModelLoadTask> AsyncResourceLoader::LoadModelAsync(
         }
     };
 
+    if (outRequestId) {
+        *outRequestId = task->requestId;
+    }
+    if (auto inflight = RegisterInflight(task); inflight != task) {
+        return inflight;
+    }
+    
     // ✅ 提交任务到TaskScheduler
     m_totalTasks++;
     m_loadingCount++;
@@ -460,6 +691,7 @@ std::shared_ptr<ModelLoadTask> AsyncResourceLoader::LoadModelAsync(
                     m_completedTasks.push(task);
                 } else {
                     m_failedTasks++;
+                    ReleaseInflight(task);
                 }
             } catch (const std::exception& e) {
                 Logger::GetInstance().ErrorFormat(
@@ -470,6 +702,7 @@ std::shared_ptr<ModelLoadTask> AsyncResourceLoader::LoadModelAsync(
                 task->errorMessage = e.what();
                 m_failedTasks++;
                 m_loadingCount--;
+                ReleaseInflight(task);
             }
         },
         taskPriority,
@@ -481,6 +714,109 @@ std::shared_ptr<ModelLoadTask> AsyncResourceLoader::LoadModelAsync(
     return task;
 }
 
+std::shared_ptr<LODGenerateTask> AsyncResourceLoader::GenerateLODAsync(
+    Ref<Mesh> sourceMesh,
+    const LODSimplifyOptions& options,
+    uint64_t sourceHash,
+    bool useDiskCache,
+    std::function<void(const LODGenerateResult&)> callback,
+    float priority,
+    const std::string& sourceFilePath)
+{
+    if (!sourceMesh) {
+        Logger::GetInstance().Error("AsyncResourceLoader::GenerateLODAsync: 源网格为空");
+        return nullptr;
+    }
+    
+    auto task = std::make_shared<LODGenerateTask>();
+    task->name = "LOD_" + std::to_string(reinterpret_cast<uintptr_t>(sourceMesh.get()));
+    task->type = AsyncResourceType::LOD;
+    task->priority = priority;
+    task->callback = callback;
+    task->sourceMesh = sourceMesh;
+    task->submitTime = std::chrono::steady_clock::now();
+    
+    // OpenGL 调用只能在主线程进行，上传推迟到 ExecuteUpload
+    LODGenerator::SimplifyOptions workerOptions = options;
+    workerOptions.uploadToGPU = false;
+    
+    task->loadFunc = [sourceMesh, workerOptions, sourceHash, useDiskCache, sourceFilePath]() -> LODGenerateTask::Output {
+        LODGenerateTask::Output output;
+        LODCache& cache = LODCache::GetInstance();
+        
+        uint64_t key = 0;
+        std::vector<Ref<Mesh>> generated;
+        std::vector<float> errors;
+        
+        if (useDiskCache) {
+            // 文件哈希需要读取整个源文件，只在工作线程计算
+            uint64_t hash = sourceHash;
+            if (hash == 0) {
+                const bool hasFile = !sourceFilePath.empty() && FileUtils::FileExists(sourceFilePath);
+                hash = LODCache::HashSource(hasFile ? sourceFilePath : std::string(), sourceMesh);
+            }
+            key = LODCache::BuildKey(hash, workerOptions);
+            output.fromCache = cache.Load(key, generated, errors);
+        }
+        
+        if (!output.fromCache) {
+            generated = LODGenerator::GenerateLODLevels(sourceMesh, workerOptions, &errors);
+            if (useDiskCache) {
+                cache.Store(key, generated, errors);
+            }
+        }
+        
+        output.lodMeshes.reserve(generated.size() + 1);
+        output.lodMeshes.push_back(sourceMesh);
+        output.geometricErrors.reserve(generated.size() + 1);
+        output.geometricErrors.push_back(0.0f);
+        for (size_t i = 0; i < generated.size(); ++i) {
+            output.lodMeshes.push_back(generated[i]);
+            output.geometricErrors.push_back(i < errors.size() ? errors[i] : -1.0f);
+        }
+        return output;
+    };
+    
+    m_totalTasks++;
+    m_loadingCount++;
+    
+    TaskPriority taskPriority = TaskPriority::Low;
+    if (priority > 0.5f) taskPriority = TaskPriority::Normal;
+    if (priority > 0.8f) taskPriority = TaskPriority::High;
+    
+    TaskScheduler::GetInstance().SubmitLambda(
+        [this, task]() {
+            try {
+                task->ExecuteLoad();
+                m_loadingCount--;
+                
+                if (!task->IsCancelled() && task->status != LoadStatus::Failed) {
+                    task->status = LoadStatus::Loaded;
+                    std::lock_guard<std::mutex> lock(m_completedMutex);
+                    m_completedTasks.push(task);
+                } else {
+                    m_failedTasks++;
+                }
+            } catch (const std::exception& e) {
+                Logger::GetInstance().ErrorFormat(
+                    "AsyncResourceLoader: LOD 生成异常: %s",
+                    e.what()
+                );
+                task->status = LoadStatus::Failed;
+                task->errorMessage = e.what();
+                m_failedTasks++;
+                m_loadingCount--;
+            }
+        },
+        taskPriority,
+        task->name.c_str()
+    );
+    
+    Logger::GetInstance().Info("✅ 提交 LOD 生成任务: " + task->name);
+    
+    return task;
+}
+
 size_t AsyncResourceLoader::ProcessCompletedTasks(size_t maxTasks) {
     // ✅ 确保在主线程（OpenGL上下文线程）
     try {
@@ -493,6 +829,42 @@ size_t AsyncResourceLoader::ProcessCompletedTasks(size_t maxTasks) {
     
     size_t processed = 0;
     
+    // 推进分帧纹理上传，并结束 fence 已触发的任务
+    TextureUploadQueue::GetInstance().Update();
+    {
+        std::vector<std::shared_ptr<LoadTaskBase>> uploading;
+        {
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            uploading.swap(m_uploadingTasks);
+        }
+        
+        std::vector<std::shared_ptr<LoadTaskBase>> stillUploading;
+        for (auto& task : uploading) {
+            if (!task->PollUpload()) {
+                stillUploading.push_back(std::move(task));
+                continue;
+            }
+            if (task->IsCancelled()) {
+                Logger::GetInstance().Info("任务在上传过程中被取消: " + task->name);
+                ReleaseInflight(task);
+                continue;
+            }
+            try {
+                FinishTask(task);
+            } catch (const std::exception& e) {
+                Logger::GetInstance().Error("GPU上传异常: " + std::string(e.what()));
+            }
+            processed++;
+        }
+        
+        if (!stillUploading.empty()) {
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            m_uploadingTasks.insert(m_uploadingTasks.end(),
+                                    std::make_move_iterator(stillUploading.begin()),
+                                    std::make_move_iterator(stillUploading.end()));
+        }
+    }
+    
     for (size_t i = 0; i < maxTasks; ++i) {
         std::shared_ptr<LoadTaskBase> task;
         
@@ -513,6 +885,14 @@ size_t AsyncResourceLoader::ProcessCompletedTasks(size_t maxTasks) {
         // 检查任务是否已取消
         if (task->IsCancelled()) {
             Logger::GetInstance().Info("跳过已取消的任务: " + task->name);
+            ReleaseInflight(task);
+            continue;
+        }
+        
+        // 由已有资源直接满足的请求：只需在主线程调用回调
+        if (task->status == LoadStatus::Completed) {
+            InvokeCallbacks(task);
+            processed++;
             continue;
         }
         
@@ -525,69 +905,146 @@ size_t AsyncResourceLoader::ProcessCompletedTasks(size_t maxTasks) {
             // 再次检查是否已取消
             if (task->IsCancelled()) {
                 Logger::GetInstance().Info("任务在上传过程中被取消: " + task->name);
+                ReleaseInflight(task);
                 continue;
             }
             
-            if (task->status != LoadStatus::Failed) {
-                task->status = LoadStatus::Completed;
-                m_completedCount++;
-                
-                Logger::GetInstance().Info("✅ 资源上传完成: " + task->name);
-            } else {
-                Logger::GetInstance().Error("❌ 资源上传失败: " + task->name);
-                m_failedTasks++;
+            // 分帧上传尚未结束：之后的帧继续轮询
+            if (task->status != LoadStatus::Failed && !task->PollUpload()) {
+                std::lock_guard<std::mutex> lock(m_completedMutex);
+                m_uploadingTasks.push_back(task);
+                continue;
             }
             
+            FinishTask(task);
             processed++;
             
-            // 调用回调
-            if (auto meshTask = std::dynamic_pointer_cast<MeshLoadTask>(task)) {
-                if (meshTask->callback) {
-                    MeshLoadResult result;
-                    result.resource = meshTask->result;
-                    result.name = meshTask->name;
-                    result.status = task->status;
-                    result.errorMessage = task->errorMessage;
-                    result.errorType = task->errorType;
-                    meshTask->callback(result);
-                }
-            } else if (auto texTask = std::dynamic_pointer_cast<TextureLoadTask>(task)) {
-                if (texTask->callback) {
-                    TextureLoadResult result;
-                    result.resource = texTask->result;
-                    result.name = texTask->name;
-                    result.status = task->status;
-                    result.errorMessage = task->errorMessage;
-                    result.errorType = task->errorType;
-                    texTask->callback(result);
-                }
-            } else if (auto modelTask = std::dynamic_pointer_cast<ModelLoadTask>(task)) {
-                if (modelTask->callback) {
-                    ModelLoadResult result;
-                    result.resource = modelTask->result.model;
-                    result.name = modelTask->result.modelName.empty()
-                        ? modelTask->name
-                        : modelTask->result.modelName;
-                    result.status = task->status;
-                    result.errorMessage = task->errorMessage;
-                    result.errorType = task->errorType;
-                    result.meshResourceNames = modelTask->result.meshResourceNames;
-                    result.materialResourceNames = modelTask->result.materialResourceNames;
-                    modelTask->callback(result);
-                }
-            }
-            
         } catch (const std::exception& e) {
             Logger::GetInstance().Error("GPU上传异常: " + std::string(e.what()));
             task->status = LoadStatus::Failed;
             task->errorMessage = "Upload exception: " + std::string(e.what());
             m_failedTasks++;
+            ReleaseInflight(task);
         }
     }
     
     return processed;
 }
 
+void AsyncResourceLoader::FinishTask(const std::shared_ptr<LoadTaskBase>& task) {
+    if (task->status != LoadStatus::Failed) {
+        task->status = LoadStatus::Completed;
+        m_completedCount++;
+        
+        Logger::GetInstance().Info("✅ 资源上传完成: " + task->name);
+    } else {
+        Logger::GetInstance().Error("❌ 资源上传失败: " + task->name);
+        m_failedTasks++;
+    }
+    
+    // 先移出进行中请求表：回调内再次发起的同一请求不会合并到已结束的任务
+    ReleaseInflight(task);
+    
+    if (auto modelTask = std::dynamic_pointer_cast<ModelLoadTask>(task);
+        modelTask && task->status == LoadStatus::Completed && modelTask->result.model &&
+        modelTask->requestedOptions.registerModel) {
+        ModelRegistration registration;
+        registration.modelName = modelTask->result.modelName.empty()
+            ? modelTask->filepath
+            : modelTask->result.modelName;
+        registration.meshResourceNames = modelTask->result.meshResourceNames;
+        registration.materialResourceNames = modelTask->result.materialResourceNames;
+        
+        std::lock_guard<std::mutex> lock(m_inflightMutex);
+        m_registeredModels[task->requestKey] = std::move(registration);
+    }
+    
+    InvokeCallbacks(task);
+}
+
+void AsyncResourceLoader::InvokeCallbacks(const std::shared_ptr<LoadTaskBase>& task) {
+    // 取出合并的回调（任务已移出进行中请求表，之后不会再追加）
+    auto takeCoalesced = [this](auto& callbacks) {
+        std::remove_reference_t<decltype(callbacks)> taken;
+        std::lock_guard<std::mutex> lock(m_inflightMutex);
+        taken.swap(callbacks);
+        return taken;
+    };
+    
+    if (auto meshTask = std::dynamic_pointer_cast<MeshLoadTask>(task)) {
+        auto coalesced = takeCoalesced(meshTask->coalescedCallbacks);
+        if (meshTask->callback || !coalesced.empty()) {
+            MeshLoadResult result;
+            result.resource = meshTask->result;
+            result.name = meshTask->name;
+            result.status = task->status;
+            result.errorMessage = task->errorMessage;
+            result.errorType = task->errorType;
+            if (meshTask->callback && !task->IsRequestCancelled(task->requestId)) {
+                meshTask->callback(result);
+            }
+            for (const auto& [requestId, callback] : coalesced) {
+                if (!task->IsRequestCancelled(requestId)) {
+                    callback(result);
+                }
+            }
+        }
+    } else if (auto texTask = std::dynamic_pointer_cast<TextureLoadTask>(task)) {
+        auto coalesced = takeCoalesced(texTask->coalescedCallbacks);
+        if (texTask->callback || !coalesced.empty()) {
+            TextureLoadResult result;
+            result.resource = texTask->result;
+            result.name = texTask->name;
+            result.status = task->status;
+            result.errorMessage = task->errorMessage;
+            result.errorType = task->errorType;
+            if (texTask->callback && !task->IsRequestCancelled(task->requestId)) {
+                texTask->callback(result);
+            }
+            for (const auto& [requestId, callback] : coalesced) {
+                if (!task->IsRequestCancelled(requestId)) {
+                    callback(result);
+                }
+            }
+        }
+    } else if (auto modelTask = std::dynamic_pointer_cast<ModelLoadTask>(task)) {
+        auto coalesced = takeCoalesced(modelTask->coalescedCallbacks);
+        if (modelTask->callback || !coalesced.empty()) {
+            ModelLoadResult result;
+            result.resource = modelTask->result.model;
+            result.name = modelTask->result.modelName.empty()
+                ? modelTask->name
+                : modelTask->result.modelName;
+            result.status = task->status;
+            result.errorMessage = task->errorMessage;
+            result.errorType = task->errorType;
+            result.meshResourceNames = modelTask->result.meshResourceNames;
+            result.materialResourceNames = modelTask->result.materialResourceNames;
+            if (modelTask->callback && !task->IsRequestCancelled(task->requestId)) {
+                modelTask->callback(result);
+            }
+            for (const auto& [requestId, callback] : coalesced) {
+                if (!task->IsRequestCancelled(requestId)) {
+                    callback(result);
+                }
+            }
+        }
+    } else if (auto lodTask = std::dynamic_pointer_cast<LODGenerateTask>(task)) {
+        if (lodTask->callback) {
+            LODGenerateResult result;
+            result.resource = lodTask->sourceMesh;
+            result.name = lodTask->name;
+            result.status = task->status;
+            result.errorMessage = task->errorMessage;
+            result.errorType = task->errorType;
+            result.lodMeshes = lodTask->result.lodMeshes;
+            result.geometricErrors = lodTask->result.geometricErrors;
+            result.fromCache = lodTask->result.fromCache;
+            lodTask->callback(result);
+        }
+    }
+}
+
 bool AsyncResourceLoader::WaitForAll(float timeoutSeconds) {
     auto startTime = std::chrono::steady_clock::now();
     
@@ -628,7 +1085,12 @@ size_t AsyncResourceLoader::GetLoadingTaskCount() const {
 
 size_t AsyncResourceLoader::GetWaitingUploadCount() const {
     std::lock_guard<std::mutex> lock(m_completedMutex);
-    return m_completedTasks.size();
+    return m_completedTasks.size() + m_uploadingTasks.size();
+}
+
+size_t AsyncResourceLoader::GetInflightRequestCount() const {
+    std::lock_guard<std::mutex> lock(m_inflightMutex);
+    return m_inflightTasks.size();
 }
 
 void AsyncResourceLoader::PrintStatistics() const {
@@ -641,6 +1103,9 @@ void AsyncResourceLoader::PrintStatistics() const {
     Logger::GetInstance().Info("正在加载: " + std::to_string(GetLoadingTaskCount()));
     Logger::GetInstance().Info("待处理: " + std::to_string(GetPendingTaskCount()));
     Logger::GetInstance().Info("等待上传: " + std::to_string(GetWaitingUploadCount()));
+    Logger::GetInstance().Info("进行中请求: " + std::to_string(GetInflightRequestCount()));
+    Logger::GetInstance().Info("合并的重复请求: " + std::to_string(m_coalescedRequests.load()));
+    Logger::GetInstance().Info("ResourceManager 命中: " + std::to_string(m_resourceHits.load()));
     Logger::GetInstance().Info("========================================");
 }
 
@@ -0,0 +1,747 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/bvh.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Render {
+
+namespace {
+
+constexpr int kSAHBins = 12;
+constexpr uint32_t kMaxSAHDepth = 64;     ///< 超过该深度改用中位数划分，限制递归深度
+constexpr size_t kMinPendingForRebuild = 64;
+constexpr float kMaxRefitDegradation = 2.0f;
+
+AABB EmptyAABB() {
+    const float big = std::numeric_limits<float>::max();
+    return AABB(Vector3(big, big, big), Vector3(-big, -big, -big));
+}
+
+inline bool IsEmpty(const AABB& box) {
+    return box.min.x() > box.max.x();
+}
+
+inline float SafeSurfaceArea(const AABB& box) {
+    return IsEmpty(box) ? 0.0f : box.GetSurfaceArea();
+}
+
+/// 射线预计算数据（倒数方向、平行轴标记）
+struct RayData {
+    Vector3 origin;
+    Vector3 invDirection;
+    bool parallel[3];
+
+    explicit RayData(const Ray& ray) : origin(ray.origin), invDirection(Vector3::Zero()) {
+        for (int i = 0; i < 3; ++i) {
+            parallel[i] = std::abs(ray.direction[i]) < 1e-6f;
+            invDirection[i] = parallel[i] ? 0.0f : 1.0f / ray.direction[i];
+        }
+    }
+};
+
+/// 射线与 AABB 的 slab 测试，tEntry 为进入距离（起点在盒内时为 0）
+bool IntersectRay(const RayData& ray, const AABB& box, float maxDistance, float& tEntry) {
+    if (IsEmpty(box)) {
+        return false;
+    }
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    for (int i = 0; i < 3; ++i) {
+        if (ray.parallel[i]) {
+            if (ray.origin[i] < box.min[i] || ray.origin[i] > box.max[i]) {
+                return false;
+            }
+            continue;
+        }
+        float t1 = (box.min[i] - ray.origin[i]) * ray.invDirection[i];
+        float t2 = (box.max[i] - ray.origin[i]) * ray.invDirection[i];
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    tEntry = tMin;
+    return true;
+}
+
+bool OverlapsSphere(const AABB& box, const Vector3& center, float radiusSq) {
+    if (IsEmpty(box)) {
+        return false;
+    }
+    const Vector3 closest = center.cwiseMax(box.min).cwiseMin(box.max);
+    return (closest - center).squaredNorm() <= radiusSq;
+}
+
+/// 视锥体平面测试结果
+enum class PlaneTest { Outside, Intersecting };
+
+/**
+ * @brief 对 mask 中的平面测试 AABB：完全在外返回 Outside；完全位于某平面内侧时清除该平面位
+ */
+PlaneTest TestPlanes(const Frustum& frustum, const AABB& box, uint32_t& mask) {
+    for (int p = 0; p < 6; ++p) {
+        const uint32_t bit = 1u << p;
+        if ((mask & bit) == 0) {
+            continue;
+        }
+        const Plane& plane = frustum.planes[p];
+        const Vector3 positiveVertex(
+            plane.normal.x() >= 0 ? box.max.x() : box.min.x(),
+            plane.normal.y() >= 0 ? box.max.y() : box.min.y(),
+            plane.normal.z() >= 0 ? box.max.z() : box.min.z());
+        if (plane.GetDistance(positiveVertex) < 0.0f) {
+            return PlaneTest::Outside;
+        }
+        const Vector3 negativeVertex(
+            plane.normal.x() >= 0 ? box.min.x() : box.max.x(),
+            plane.normal.y() >= 0 ? box.min.y() : box.max.y(),
+            plane.normal.z() >= 0 ? box.min.z() : box.max.z());
+        if (plane.GetDistance(negativeVertex) >= 0.0f) {
+            mask &= ~bit;
+        }
+    }
+    return PlaneTest::Intersecting;
+}
+
+constexpr uint32_t kAllPlanesMask = 0x3F;
+
+} // namespace
+
+// ============================================================================
+// BVH 修改
+// ============================================================================
+
+uint32_t BVH::Insert(const AABB& bounds, uint32_t userData) {
+    uint32_t proxy;
+    if (!m_freeProxies.empty()) {
+        proxy = m_freeProxies.back();
+        m_freeProxies.pop_back();
+    } else {
+        proxy = static_cast<uint32_t>(m_proxies.size());
+        m_proxies.emplace_back();
+    }
+
+    Proxy& entry = m_proxies[proxy];
+    entry.bounds = bounds;
+    entry.userData = userData;
+    entry.alive = true;
+    entry.inTree = false;
+    entry.pendingSlot = static_cast<uint32_t>(m_pending.size());
+    m_pending.push_back(proxy);
+    ++m_liveCount;
+    return proxy;
+}
+
+void BVH::Update(uint32_t proxy, const AABB& bounds) {
+    if (!IsValidProxy(proxy)) {
+        return;
+    }
+    Proxy& entry = m_proxies[proxy];
+    entry.bounds = bounds;
+    if (entry.inTree) {
+        m_needsRefit = true;
+    }
+}
+
+void BVH::Remove(uint32_t proxy) {
+    if (!IsValidProxy(proxy)) {
+        return;
+    }
+    Proxy& entry = m_proxies[proxy];
+    entry.alive = false;
+    --m_liveCount;
+
+    if (entry.inTree) {
+        // 叶子仍引用该代理，构建时再回收
+        ++m_removedInTree;
+        m_deferredFree.push_back(proxy);
+        m_needsRefit = true;
+        return;
+    }
+
+    const uint32_t slot = entry.pendingSlot;
+    const uint32_t last = m_pending.back();
+    m_pending[slot] = last;
+    m_proxies[last].pendingSlot = slot;
+    m_pending.pop_back();
+    entry.pendingSlot = kInvalidProxy;
+    m_freeProxies.push_back(proxy);
+}
+
+bool BVH::IsValidProxy(uint32_t proxy) const {
+    return proxy < m_proxies.size() && m_proxies[proxy].alive;
+}
+
+void BVH::Clear() {
+    m_nodes.clear();
+    m_primIndices.clear();
+    m_proxies.clear();
+    m_freeProxies.clear();
+    m_deferredFree.clear();
+    m_pending.clear();
+    m_liveCount = 0;
+    m_treePrimitiveCount = 0;
+    m_removedInTree = 0;
+    m_builtAreaSum = 0.0f;
+    m_currentAreaSum = 0.0f;
+    m_needsRefit = false;
+}
+
+// ============================================================================
+// 构建与 Refit
+// ============================================================================
+
+void BVH::Build() {
+    m_freeProxies.insert(m_freeProxies.end(), m_deferredFree.begin(), m_deferredFree.end());
+    m_deferredFree.clear();
+
+    m_nodes.clear();
+    m_primIndices.clear();
+    m_primIndices.reserve(m_liveCount);
+
+    std::vector<Vector3> centroids(m_proxies.size(), Vector3::Zero());
+    for (uint32_t i = 0; i < m_proxies.size(); ++i) {
+        Proxy& proxy = m_proxies[i];
+        if (!proxy.alive) {
+            continue;
+        }
+        proxy.inTree = true;
+        proxy.pendingSlot = kInvalidProxy;
+        centroids[i] = proxy.bounds.GetCenter();
+        m_primIndices.push_back(i);
+    }
+
+    m_pending.clear();
+    m_removedInTree = 0;
+    m_needsRefit = false;
+    m_treePrimitiveCount = m_primIndices.size();
+
+    if (m_primIndices.empty()) {
+        m_builtAreaSum = m_currentAreaSum = 0.0f;
+        return;
+    }
+
+    m_nodes.reserve(2 * m_primIndices.size());
+    m_nodes.emplace_back();
+    Subdivide(0, 0, static_cast<uint32_t>(m_primIndices.size()), 0, centroids);
+
+    m_builtAreaSum = m_currentAreaSum = ComputeNodeAreaSum();
+}
+
+void BVH::Subdivide(uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t depth,
+                    const std::vector<Vector3>& centroids) {
+    AABB bounds = EmptyAABB();
+    AABB centroidBounds = EmptyAABB();
+    for (uint32_t i = begin; i < end; ++i) {
+        const uint32_t proxy = m_primIndices[i];
+        bounds.Merge(m_proxies[proxy].bounds);
+        centroidBounds.Expand(centroids[proxy]);
+    }
+
+    const uint32_t count = end - begin;
+    m_nodes[nodeIndex].bounds = bounds;
+    if (count <= kMaxLeafPrimitives) {
+        m_nodes[nodeIndex].first = begin;
+        m_nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // ==================== 分桶 SAH ====================
+    int bestAxis = -1;
+    int bestSplit = 0;
+    float bestCost = std::numeric_limits<float>::max();
+
+    if (depth < kMaxSAHDepth) {
+        for (int axis = 0; axis < 3; ++axis) {
+            const float axisMin = centroidBounds.min[axis];
+            const float extent = centroidBounds.max[axis] - axisMin;
+            if (extent <= 1e-6f) {
+                continue;
+            }
+
+            AABB binBounds[kSAHBins];
+            uint32_t binCounts[kSAHBins] = {};
+            for (AABB& b : binBounds) {
+                b = EmptyAABB();
+            }
+
+            const float scale = kSAHBins / extent;
+            for (uint32_t i = begin; i < end; ++i) {
+                const uint32_t proxy = m_primIndices[i];
+                const int bin = std::min(kSAHBins - 1,
+                                         static_cast<int>((centroids[proxy][axis] - axisMin) * scale));
+                ++binCounts[bin];
+                binBounds[bin].Merge(m_proxies[proxy].bounds);
+            }
+
+            // 从左向右累积每个划分位置左侧的面积与数量
+            float leftArea[kSAHBins - 1];
+            uint32_t leftCount[kSAHBins - 1];
+            AABB accum = EmptyAABB();
+            uint32_t accumCount = 0;
+            for (int i = 0; i < kSAHBins - 1; ++i) {
+                accum.Merge(binBounds[i]);
+                accumCount += binCounts[i];
+                leftArea[i] = SafeSurfaceArea(accum);
+                leftCount[i] = accumCount;
+            }
+
+            accum = EmptyAABB();
+            accumCount = 0;
+            for (int i = kSAHBins - 1; i > 0; --i) {
+                accum.Merge(binBounds[i]);
+                accumCount += binCounts[i];
+                if (leftCount[i - 1] == 0 || accumCount == 0) {
+                    continue;
+                }
+                const float cost = leftArea[i - 1] * static_cast<float>(leftCount[i - 1]) +
+                                   SafeSurfaceArea(accum) * static_cast<float>(accumCount);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+    }
+
+    uint32_t mid = begin;
+    if (bestAxis >= 0) {
+        const float axisMin = centroidBounds.min[bestAxis];
+        const float scale = kSAHBins / (centroidBounds.max[bestAxis] - axisMin);
+        auto* first = m_primIndices.data() + begin;
+        auto* last = m_primIndices.data() + end;
+        mid = begin + static_cast<uint32_t>(std::partition(first, last, [&](uint32_t proxy) {
+            const int bin = std::min(kSAHBins - 1,
+                                     static_cast<int>((centroids[proxy][bestAxis] - axisMin) * scale));
+            return bin < bestSplit;
+        }) - first);
+    }
+
+    if (mid == begin || mid == end) {
+        // 质心重合或深度过大：沿最长轴按中位数划分
+        const Vector3 extent = centroidBounds.GetSize();
+        int axis = 0;
+        if (extent.y() > extent[axis]) axis = 1;
+        if (extent.z() > extent[axis]) axis = 2;
+        mid = begin + count / 2;
+        std::nth_element(m_primIndices.begin() + begin, m_primIndices.begin() + mid,
+                         m_primIndices.begin() + end, [&](uint32_t a, uint32_t b) {
+                             return centroids[a][axis] < centroids[b][axis];
+                         });
+    }
+
+    const uint32_t left = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+    m_nodes[nodeIndex].first = left;
+    m_nodes[nodeIndex].count = 0;
+
+    Subdivide(left, begin, mid, depth + 1, centroids);
+    Subdivide(left + 1, mid, end, depth + 1, centroids);
+}
+
+void BVH::Refit() {
+    if (!m_needsRefit || m_nodes.empty()) {
+        m_needsRefit = false;
+        return;
+    }
+
+    // 子节点总在父节点之后，逆序遍历即为自底向上
+    for (size_t i = m_nodes.size(); i-- > 0;) {
+        Node& node = m_nodes[i];
+        AABB bounds = EmptyAABB();
+        if (node.count > 0) {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                const Proxy& proxy = m_proxies[m_primIndices[k]];
+                if (proxy.alive) {
+                    bounds.Merge(proxy.bounds);
+                }
+            }
+        } else {
+            bounds = m_nodes[node.first].bounds;
+            bounds.Merge(m_nodes[node.first + 1].bounds);
+        }
+        node.bounds = bounds;
+    }
+
+    m_currentAreaSum = ComputeNodeAreaSum();
+    m_needsRefit = false;
+}
+
+bool BVH::NeedsRebuild() const {
+    if (m_nodes.empty()) {
+        return !m_pending.empty() || m_removedInTree > 0;
+    }
+    const size_t treeSize = std::max<size_t>(m_treePrimitiveCount, 1);
+    if (m_pending.size() > std::max(kMinPendingForRebuild, treeSize / 8)) {
+        return true;
+    }
+    if (m_removedInTree > treeSize / 4) {
+        return true;
+    }
+    return m_builtAreaSum > 0.0f && m_currentAreaSum > m_builtAreaSum * kMaxRefitDegradation;
+}
+
+float BVH::ComputeNodeAreaSum() const {
+    double sum = 0.0;
+    for (const Node& node : m_nodes) {
+        sum += SafeSurfaceArea(node.bounds);
+    }
+    return static_cast<float>(sum);
+}
+
+// ============================================================================
+// 查询
+// ============================================================================
+
+void BVH::CollectSubtree(uint32_t nodeIndex, std::vector<uint32_t>& out) const {
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(nodeIndex);
+    while (!stack.empty()) {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (node.count > 0) {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                const Proxy& proxy = m_proxies[m_primIndices[k]];
+                if (proxy.alive) {
+                    out.push_back(proxy.userData);
+                }
+            }
+        } else {
+            stack.push_back(node.first);
+            stack.push_back(node.first + 1);
+        }
+    }
+}
+
+void BVH::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& out,
+                       BVHQueryStats* stats) const {
+    if (!m_nodes.empty()) {
+        struct StackEntry {
+            uint32_t node;
+            uint32_t planeMask;
+        };
+        std::vector<StackEntry> stack;
+        stack.reserve(64);
+        stack.push_back({0, kAllPlanesMask});
+
+        while (!stack.empty()) {
+            const StackEntry entry = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[entry.node];
+            if (stats) {
+                ++stats->nodesVisited;
+            }
+
+            uint32_t mask = entry.planeMask;
+            if (TestPlanes(frustum, node.bounds, mask) == PlaneTest::Outside) {
+                continue;
+            }
+
+            if (mask == 0) {
+                // 整棵子树位于视锥体内
+                CollectSubtree(entry.node, out);
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                    const Proxy& proxy = m_proxies[m_primIndices[k]];
+                    if (!proxy.alive) {
+                        continue;
+                    }
+                    if (stats) {
+                        ++stats->primitivesTested;
+                    }
+                    uint32_t primMask = mask;
+                    if (TestPlanes(frustum, proxy.bounds, primMask) != PlaneTest::Outside) {
+                        out.push_back(proxy.userData);
+                    }
+                }
+            } else {
+                stack.push_back({node.first, mask});
+                stack.push_back({node.first + 1, mask});
+            }
+        }
+    }
+
+    for (uint32_t proxy : m_pending) {
+        if (stats) {
+            ++stats->primitivesTested;
+        }
+        if (frustum.IntersectsAABB(m_proxies[proxy].bounds)) {
+            out.push_back(m_proxies[proxy].userData);
+        }
+    }
+}
+
+void BVH::QueryAABB(const AABB& bounds, std::vector<uint32_t>& out) const {
+    if (!m_nodes.empty()) {
+        std::vector<uint32_t> stack;
+        stack.reserve(64);
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            if (!node.bounds.Intersects(bounds)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                    const Proxy& proxy = m_proxies[m_primIndices[k]];
+                    if (proxy.alive && proxy.bounds.Intersects(bounds)) {
+                        out.push_back(proxy.userData);
+                    }
+                }
+            } else {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+            }
+        }
+    }
+
+    for (uint32_t proxy : m_pending) {
+        if (m_proxies[proxy].bounds.Intersects(bounds)) {
+            out.push_back(m_proxies[proxy].userData);
+        }
+    }
+}
+
+void BVH::QuerySphere(const Vector3& center, float radius, std::vector<uint32_t>& out) const {
+    const float radiusSq = radius * radius;
+    if (!m_nodes.empty()) {
+        std::vector<uint32_t> stack;
+        stack.reserve(64);
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            if (!OverlapsSphere(node.bounds, center, radiusSq)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                    const Proxy& proxy = m_proxies[m_primIndices[k]];
+                    if (proxy.alive && OverlapsSphere(proxy.bounds, center, radiusSq)) {
+                        out.push_back(proxy.userData);
+                    }
+                }
+            } else {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+            }
+        }
+    }
+
+    for (uint32_t proxy : m_pending) {
+        if (OverlapsSphere(m_proxies[proxy].bounds, center, radiusSq)) {
+            out.push_back(m_proxies[proxy].userData);
+        }
+    }
+}
+
+bool BVH::Raycast(const Ray& ray, float maxDistance, uint32_t& outUserData, float& outDistance,
+                  const RayNarrowPhase& narrowPhase) const {
+    const RayData rayData(ray);
+    float best = maxDistance;
+    bool hit = false;
+
+    auto testPrimitive = [&](const Proxy& proxy) {
+        float t = 0.0f;
+        if (!IntersectRay(rayData, proxy.bounds, best, t)) {
+            return;
+        }
+        if (narrowPhase && !narrowPhase(proxy.userData, t)) {
+            return;
+        }
+        if (t <= maxDistance && (!hit || t < best)) {
+            hit = true;
+            best = t;
+            outUserData = proxy.userData;
+        }
+    };
+
+    if (!m_nodes.empty()) {
+        float rootEntry = 0.0f;
+        if (IntersectRay(rayData, m_nodes[0].bounds, best, rootEntry)) {
+            struct StackEntry {
+                uint32_t node;
+                float entry;
+            };
+            std::vector<StackEntry> stack;
+            stack.reserve(64);
+            stack.push_back({0, rootEntry});
+
+            while (!stack.empty()) {
+                const StackEntry entry = stack.back();
+                stack.pop_back();
+                if (hit && entry.entry > best) {
+                    continue;
+                }
+                const Node& node = m_nodes[entry.node];
+                if (node.count > 0) {
+                    for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                        const Proxy& proxy = m_proxies[m_primIndices[k]];
+                        if (proxy.alive) {
+                            testPrimitive(proxy);
+                        }
+                    }
+                    continue;
+                }
+
+                // 先压入较远的子节点，使较近的子节点先被处理
+                float tLeft = 0.0f, tRight = 0.0f;
+                const bool hitLeft = IntersectRay(rayData, m_nodes[node.first].bounds, best, tLeft);
+                const bool hitRight = IntersectRay(rayData, m_nodes[node.first + 1].bounds, best, tRight);
+                if (hitLeft && hitRight) {
+                    if (tLeft <= tRight) {
+                        stack.push_back({node.first + 1, tRight});
+                        stack.push_back({node.first, tLeft});
+                    } else {
+                        stack.push_back({node.first, tLeft});
+                        stack.push_back({node.first + 1, tRight});
+                    }
+                } else if (hitLeft) {
+                    stack.push_back({node.first, tLeft});
+                } else if (hitRight) {
+                    stack.push_back({node.first + 1, tRight});
+                }
+            }
+        }
+    }
+
+    for (uint32_t proxy : m_pending) {
+        testPrimitive(m_proxies[proxy]);
+    }
+
+    if (hit) {
+        outDistance = best;
+    }
+    return hit;
+}
+
+// ============================================================================
+// SceneBVH
+// ============================================================================
+
+void SceneBVH::Set(uint32_t id, const AABB& bounds) {
+    if (id >= m_entries.size()) {
+        m_entries.resize(static_cast<size_t>(id) + 1);
+    }
+
+    Entry& entry = m_entries[id];
+    if (entry.proxy == BVH::kInvalidProxy) {
+        entry.proxy = m_staticTree.Insert(bounds, id);
+        entry.dynamic = false;
+        return;
+    }
+
+    BVH& tree = entry.dynamic ? m_dynamicTree : m_staticTree;
+    const AABB& current = tree.GetProxyBounds(entry.proxy);
+    if (current.min == bounds.min && current.max == bounds.max) {
+        return;
+    }
+
+    if (entry.dynamic) {
+        m_dynamicTree.Update(entry.proxy, bounds);
+        return;
+    }
+
+    // 静态对象发生移动：迁移到动态树
+    m_staticTree.Remove(entry.proxy);
+    entry.proxy = m_dynamicTree.Insert(bounds, id);
+    entry.dynamic = true;
+}
+
+void SceneBVH::Remove(uint32_t id) {
+    if (!Contains(id)) {
+        return;
+    }
+    Entry& entry = m_entries[id];
+    (entry.dynamic ? m_dynamicTree : m_staticTree).Remove(entry.proxy);
+    entry = Entry{};
+}
+
+bool SceneBVH::Contains(uint32_t id) const {
+    return id < m_entries.size() && m_entries[id].proxy != BVH::kInvalidProxy;
+}
+
+bool SceneBVH::IsDynamic(uint32_t id) const {
+    return Contains(id) && m_entries[id].dynamic;
+}
+
+void SceneBVH::Commit() {
+    for (BVH* tree : {&m_staticTree, &m_dynamicTree}) {
+        if (tree->NeedsRebuild()) {
+            tree->Build();
+        } else {
+            tree->Refit();
+        }
+    }
+}
+
+void SceneBVH::Clear() {
+    m_entries.clear();
+    m_staticTree.Clear();
+    m_dynamicTree.Clear();
+}
+
+void SceneBVH::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& out,
+                            BVHQueryStats* stats) const {
+    m_staticTree.QueryFrustum(frustum, out, stats);
+    m_dynamicTree.QueryFrustum(frustum, out, stats);
+}
+
+void SceneBVH::QueryAABB(const AABB& bounds, std::vector<uint32_t>& out) const {
+    m_staticTree.QueryAABB(bounds, out);
+    m_dynamicTree.QueryAABB(bounds, out);
+}
+
+void SceneBVH::QuerySphere(const Vector3& center, float radius, std::vector<uint32_t>& out) const {
+    m_staticTree.QuerySphere(center, radius, out);
+    m_dynamicTree.QuerySphere(center, radius, out);
+}
+
+bool SceneBVH::Raycast(const Ray& ray, float maxDistance, uint32_t& outId, float& outDistance,
+                       const BVH::RayNarrowPhase& narrowPhase) const {
+    bool hit = m_staticTree.Raycast(ray, maxDistance, outId, outDistance, narrowPhase);
+    const float dynamicMax = hit ? outDistance : maxDistance;
+    uint32_t dynamicId = 0;
+    float dynamicDistance = 0.0f;
+    if (m_dynamicTree.Raycast(ray, dynamicMax, dynamicId, dynamicDistance, narrowPhase) &&
+        (!hit || dynamicDistance < outDistance)) {
+        outId = dynamicId;
+        outDistance = dynamicDistance;
+        hit = true;
+    }
+    return hit;
+}
+
+} // namespace Render
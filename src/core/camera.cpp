@@ -24,8 +24,96 @@
 #include <cmath>
 #include <algorithm>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace Render {
 
+namespace {
+
+/// 单个对象的平面一致性裁剪：先测缓存的平面，剔除时回写剔除平面
+template <typename OutsideFn>
+uint8_t CullOneCoherent(OutsideFn&& outside, uint8_t* cacheSlot) {
+    int first = -1;
+    if (cacheSlot) {
+        first = std::min<int>(*cacheSlot, 5);
+        if (outside(first)) {
+            return 0;
+        }
+    }
+    for (int p = 0; p < 6; ++p) {
+        if (p != first && outside(p)) {
+            if (cacheSlot) {
+                *cacheSlot = static_cast<uint8_t>(p);
+            }
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#ifdef __AVX2__
+/// 6 个平面的 SoA 寄存器表示（第 6、7 通道为填充，缓存索引会被钳制到 0-5）
+struct FrustumPlanesAVX {
+    __m256 nx, ny, nz, d;
+
+    explicit FrustumPlanesAVX(const Plane* planes) {
+        alignas(32) float x[8] = {}, y[8] = {}, z[8] = {}, w[8] = {};
+        for (int p = 0; p < 6; ++p) {
+            x[p] = planes[p].normal.x();
+            y[p] = planes[p].normal.y();
+            z[p] = planes[p].normal.z();
+            w[p] = planes[p].distance;
+        }
+        nx = _mm256_load_ps(x);
+        ny = _mm256_load_ps(y);
+        nz = _mm256_load_ps(z);
+        d = _mm256_load_ps(w);
+    }
+};
+
+/// 读取 8 个对象的缓存平面索引（钳制到 0-5）
+inline __m256i LoadPlaneCache(const uint8_t* cache) {
+    __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cache));
+    return _mm256_min_epu32(_mm256_cvtepu8_epi32(bytes), _mm256_set1_epi32(5));
+}
+
+/// 将 8 个 32 位通道压缩为 8 个字节写出
+inline void StoreLanesAsBytes(__m256i lanes, uint8_t* out) {
+    const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(words, words));
+}
+
+/// 写回 8 个对象的可见性与剔除平面
+inline void StoreCullResult(__m256 culled, __m256i rejectPlane, uint8_t* outVisible, uint8_t* cache) {
+    // 未剔除的通道符号位为 0，右移 31 位得到 1
+    StoreLanesAsBytes(_mm256_srli_epi32(_mm256_castps_si256(_mm256_xor_ps(
+        culled, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))), 31), outVisible);
+    if (cache) {
+        StoreLanesAsBytes(rejectPlane, cache);
+    }
+}
+
+/// 对新剔除的通道记录剔除平面 p
+inline __m256i MarkRejectPlane(__m256i rejectPlane, __m256 newlyCulled, int p) {
+    return _mm256_castps_si256(_mm256_blendv_ps(
+        _mm256_castsi256_ps(rejectPlane),
+        _mm256_castsi256_ps(_mm256_set1_epi32(p)),
+        newlyCulled));
+}
+
+inline __m256 PlaneDistance(__m256 nx, __m256 ny, __m256 nz, __m256 d,
+                            __m256 x, __m256 y, __m256 z) {
+    __m256 dist = _mm256_mul_ps(nx, x);
+    dist = _mm256_add_ps(dist, _mm256_mul_ps(ny, y));
+    dist = _mm256_add_ps(dist, _mm256_mul_ps(nz, z));
+    return _mm256_sub_ps(dist, d);
+}
+#endif
+
+} // namespace
+
 // ============================================================================
 // Frustum 实现
 // ============================================================================
@@ -132,6 +220,135 @@ bool Frustum::IntersectsAABB(const AABB& aabb) const {
     return true;
 }
 
+void Frustum::CullSpheres(const float* cx, const float* cy, const float* cz, const float* r,
+                          size_t count, uint8_t* outVisible, uint8_t* planeCache) const {
+    if (count == 0 || !cx || !cy || !cz || !r || !outVisible) {
+        return;
+    }
+
+    size_t i = 0;
+
+#ifdef __AVX2__
+    const FrustumPlanesAVX soa(planes);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(cx + i);
+        const __m256 y = _mm256_loadu_ps(cy + i);
+        const __m256 z = _mm256_loadu_ps(cz + i);
+        const __m256 negR = _mm256_sub_ps(zero, _mm256_loadu_ps(r + i));
+
+        __m256 culled = zero;
+        __m256i rejectPlane = _mm256_setzero_si256();
+
+        if (planeCache) {
+            // 平面一致性：每个通道先测试上一帧剔除它的平面
+            rejectPlane = LoadPlaneCache(planeCache + i);
+            const __m256 dist = PlaneDistance(
+                _mm256_permutevar8x32_ps(soa.nx, rejectPlane),
+                _mm256_permutevar8x32_ps(soa.ny, rejectPlane),
+                _mm256_permutevar8x32_ps(soa.nz, rejectPlane),
+                _mm256_permutevar8x32_ps(soa.d, rejectPlane),
+                x, y, z);
+            culled = _mm256_cmp_ps(dist, negR, _CMP_LT_OQ);
+        }
+
+        for (int p = 0; p < 6 && _mm256_movemask_ps(culled) != 0xFF; ++p) {
+            const Plane& plane = planes[p];
+            const __m256 dist = PlaneDistance(
+                _mm256_set1_ps(plane.normal.x()), _mm256_set1_ps(plane.normal.y()),
+                _mm256_set1_ps(plane.normal.z()), _mm256_set1_ps(plane.distance),
+                x, y, z);
+            const __m256 out = _mm256_cmp_ps(dist, negR, _CMP_LT_OQ);
+            rejectPlane = MarkRejectPlane(rejectPlane, _mm256_andnot_ps(culled, out), p);
+            culled = _mm256_or_ps(culled, out);
+        }
+
+        StoreCullResult(culled, rejectPlane, outVisible + i, planeCache ? planeCache + i : nullptr);
+    }
+#endif
+
+    // 标量路径（无 AVX2 时处理全部，否则处理尾部）
+    for (; i < count; ++i) {
+        const float x = cx[i], y = cy[i], z = cz[i], negR = -r[i];
+        outVisible[i] = CullOneCoherent([&](int p) {
+            const Plane& plane = planes[p];
+            const float dist = plane.normal.x() * x + plane.normal.y() * y +
+                               plane.normal.z() * z - plane.distance;
+            return dist < negR;
+        }, planeCache ? planeCache + i : nullptr);
+    }
+}
+
+void Frustum::CullAABBs(const float* minX, const float* minY, const float* minZ,
+                        const float* maxX, const float* maxY, const float* maxZ,
+                        size_t count, uint8_t* outVisible, uint8_t* planeCache) const {
+    if (count == 0 || !minX || !minY || !minZ || !maxX || !maxY || !maxZ || !outVisible) {
+        return;
+    }
+
+    size_t i = 0;
+
+#ifdef __AVX2__
+    const FrustumPlanesAVX soa(planes);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 loX = _mm256_loadu_ps(minX + i);
+        const __m256 loY = _mm256_loadu_ps(minY + i);
+        const __m256 loZ = _mm256_loadu_ps(minZ + i);
+        const __m256 hiX = _mm256_loadu_ps(maxX + i);
+        const __m256 hiY = _mm256_loadu_ps(maxY + i);
+        const __m256 hiZ = _mm256_loadu_ps(maxZ + i);
+
+        __m256 culled = zero;
+        __m256i rejectPlane = _mm256_setzero_si256();
+
+        if (planeCache) {
+            rejectPlane = LoadPlaneCache(planeCache + i);
+            const __m256 nx = _mm256_permutevar8x32_ps(soa.nx, rejectPlane);
+            const __m256 ny = _mm256_permutevar8x32_ps(soa.ny, rejectPlane);
+            const __m256 nz = _mm256_permutevar8x32_ps(soa.nz, rejectPlane);
+            // 正向顶点：法线分量 >= 0 取 max，否则取 min（与 IntersectsAABB 相同）
+            const __m256 px = _mm256_blendv_ps(loX, hiX, _mm256_cmp_ps(nx, zero, _CMP_GE_OQ));
+            const __m256 py = _mm256_blendv_ps(loY, hiY, _mm256_cmp_ps(ny, zero, _CMP_GE_OQ));
+            const __m256 pz = _mm256_blendv_ps(loZ, hiZ, _mm256_cmp_ps(nz, zero, _CMP_GE_OQ));
+            const __m256 dist = PlaneDistance(nx, ny, nz,
+                                              _mm256_permutevar8x32_ps(soa.d, rejectPlane),
+                                              px, py, pz);
+            culled = _mm256_cmp_ps(dist, zero, _CMP_LT_OQ);
+        }
+
+        for (int p = 0; p < 6 && _mm256_movemask_ps(culled) != 0xFF; ++p) {
+            const Plane& plane = planes[p];
+            const __m256 dist = PlaneDistance(
+                _mm256_set1_ps(plane.normal.x()), _mm256_set1_ps(plane.normal.y()),
+                _mm256_set1_ps(plane.normal.z()), _mm256_set1_ps(plane.distance),
+                plane.normal.x() >= 0 ? hiX : loX,
+                plane.normal.y() >= 0 ? hiY : loY,
+                plane.normal.z() >= 0 ? hiZ : loZ);
+            const __m256 out = _mm256_cmp_ps(dist, zero, _CMP_LT_OQ);
+            rejectPlane = MarkRejectPlane(rejectPlane, _mm256_andnot_ps(culled, out), p);
+            culled = _mm256_or_ps(culled, out);
+        }
+
+        StoreCullResult(culled, rejectPlane, outVisible + i, planeCache ? planeCache + i : nullptr);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        outVisible[i] = CullOneCoherent([&](int p) {
+            const Plane& plane = planes[p];
+            const float x = plane.normal.x() >= 0 ? maxX[i] : minX[i];
+            const float y = plane.normal.y() >= 0 ? maxY[i] : minY[i];
+            const float z = plane.normal.z() >= 0 ? maxZ[i] : minZ[i];
+            const float dist = plane.normal.x() * x + plane.normal.y() * y +
+                               plane.normal.z() * z - plane.distance;
+            return dist < 0.0f;
+        }, planeCache ? planeCache + i : nullptr);
+    }
+}
+
 // ============================================================================
 // Camera 实现
 // ============================================================================
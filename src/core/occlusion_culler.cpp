@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/occlusion_culler.h"
+#include "render/mesh.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace Render {
+
+namespace {
+
+constexpr float kMinClipW = 1e-5f;
+constexpr float kMinTriangleArea = 1e-8f;
+constexpr float kEdgeBias = 1.0f / 256.0f;  ///< 边函数外扩（像素），避免共享边因浮点误差出现裂缝
+constexpr int kPixelTestThreshold = 64;   ///< 覆盖像素数不超过该值时直接逐像素测试
+
+/// 屏幕空间顶点：像素坐标 + [0, 1] 深度
+struct ScreenVertex {
+    float x, y, z;
+};
+
+inline bool IsClipVertexUsable(const Vector4& c) {
+    // 位于近平面之后（或 w 接近 0）的顶点无法安全投影
+    return c.w() > kMinClipW && c.z() >= -c.w();
+}
+
+inline ScreenVertex ToScreen(const Vector4& c, float width, float height) {
+    const float invW = 1.0f / c.w();
+    return {
+        (c.x() * invW * 0.5f + 0.5f) * width,
+        (c.y() * invW * 0.5f + 0.5f) * height,
+        c.z() * invW * 0.5f + 0.5f
+    };
+}
+
+/// 边函数 E(px, py) = a * px + b * py + c，三角形内部（逆时针）为非负
+struct EdgeFunction {
+    float a, b, c;
+
+    EdgeFunction(const ScreenVertex& v0, const ScreenVertex& v1)
+        : a(v0.y - v1.y), b(v1.x - v0.x), c(v0.x * v1.y - v0.y * v1.x) {
+        c += kEdgeBias * (std::abs(a) + std::abs(b));
+    }
+
+    float Evaluate(float px, float py) const { return a * px + b * py + c; }
+};
+
+} // anonymous namespace
+
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height) {
+    SetResolution(width, height);
+}
+
+void OcclusionCuller::SetResolution(uint32_t width, uint32_t height) {
+    m_width = std::max(width, 1u);
+    m_height = std::max(height, 1u);
+    m_stride = (m_width + 7u) & ~7u;
+    m_tilesX = (m_width + kTileSize - 1) / kTileSize;
+    m_tilesY = (m_height + kTileSize - 1) / kTileSize;
+    m_depth.assign(static_cast<size_t>(m_stride) * m_height, 1.0f);
+    m_tileMaxDepth.assign(static_cast<size_t>(m_tilesX) * m_tilesY, 1.0f);
+    m_finalized = false;
+}
+
+void OcclusionCuller::BeginFrame(const Matrix4& viewProjection) {
+    m_viewProjection = viewProjection;
+    std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+    m_stats = OcclusionStats{};
+    m_finalized = false;
+}
+
+void OcclusionCuller::RasterizeTriangles(const Vector3* positions, size_t vertexCount,
+                                         const uint32_t* indices, size_t indexCount,
+                                         const Matrix4& worldMatrix) {
+    if (!positions || vertexCount == 0) {
+        return;
+    }
+
+    const Matrix4 toClip = m_viewProjection * worldMatrix;
+    m_clipScratch.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        m_clipScratch[i] = toClip * positions[i].homogeneous();
+    }
+
+    ++m_stats.occluders;
+    if (indices) {
+        RasterizeClipTriangles(indices, indexCount);
+    } else {
+        m_indexScratch.resize(vertexCount - vertexCount % 3);
+        for (size_t i = 0; i < m_indexScratch.size(); ++i) {
+            m_indexScratch[i] = static_cast<uint32_t>(i);
+        }
+        RasterizeClipTriangles(m_indexScratch.data(), m_indexScratch.size());
+    }
+}
+
+void OcclusionCuller::RasterizeMesh(const Mesh& mesh, const Matrix4& worldMatrix) {
+    // 顶点与索引共用同一把（非递归）锁，必须分两次访问
+    mesh.AccessIndices([this](const std::vector<uint32_t>& indices) {
+        m_indexScratch.assign(indices.begin(), indices.end());
+    });
+
+    const Matrix4 toClip = m_viewProjection * worldMatrix;
+    mesh.AccessPositions([this, &toClip](const Mesh::PositionView& positions) {
+        m_clipScratch.resize(positions.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            m_clipScratch[i] = toClip * positions[i].homogeneous();
+        }
+    });
+
+    if (m_clipScratch.empty()) {
+        return;
+    }
+
+    if (m_indexScratch.empty()) {
+        const size_t count = m_clipScratch.size() - m_clipScratch.size() % 3;
+        m_indexScratch.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            m_indexScratch[i] = static_cast<uint32_t>(i);
+        }
+    }
+
+    ++m_stats.occluders;
+    RasterizeClipTriangles(m_indexScratch.data(), m_indexScratch.size());
+}
+
+void OcclusionCuller::RasterizeClipTriangles(const uint32_t* indices, size_t indexCount) {
+    const size_t vertexCount = m_clipScratch.size();
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        const uint32_t i0 = indices[i];
+        const uint32_t i1 = indices[i + 1];
+        const uint32_t i2 = indices[i + 2];
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+            ++m_stats.trianglesSkipped;
+            continue;
+        }
+        RasterizeTriangle(m_clipScratch[i0], m_clipScratch[i1], m_clipScratch[i2]);
+    }
+}
+
+void OcclusionCuller::RasterizeTriangle(const Vector4& c0, const Vector4& c1, const Vector4& c2) {
+    // 跨越近平面的三角形直接跳过（不裁剪）：少写深度只会让遮挡判定更保守
+    if (!IsClipVertexUsable(c0) || !IsClipVertexUsable(c1) || !IsClipVertexUsable(c2)) {
+        ++m_stats.trianglesSkipped;
+        return;
+    }
+
+    const float width = static_cast<float>(m_width);
+    const float height = static_cast<float>(m_height);
+    ScreenVertex v0 = ToScreen(c0, width, height);
+    ScreenVertex v1 = ToScreen(c1, width, height);
+    ScreenVertex v2 = ToScreen(c2, width, height);
+
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (std::abs(area) < kMinTriangleArea) {
+        ++m_stats.trianglesSkipped;
+        return;
+    }
+    if (area < 0.0f) {
+        // 双面光栅化：统一为逆时针
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // 像素中心 (x + 0.5, y + 0.5) 位于三角形内才写入
+    const int minX = std::max(0, static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x}) - 0.5f)));
+    const int minY = std::max(0, static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y}) - 0.5f)));
+    const int maxX = std::min(static_cast<int>(m_width) - 1,
+                              static_cast<int>(std::ceil(std::max({v0.x, v1.x, v2.x}) - 0.5f)));
+    const int maxY = std::min(static_cast<int>(m_height) - 1,
+                              static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y}) - 0.5f)));
+    if (minX > maxX || minY > maxY) {
+        ++m_stats.trianglesSkipped;
+        return;
+    }
+    ++m_stats.trianglesRasterized;
+
+    const EdgeFunction e0(v1, v2);
+    const EdgeFunction e1(v2, v0);
+    const EdgeFunction e2(v0, v1);
+
+    // NDC 深度在屏幕空间内是线性的：z(px, py) = za * px + zb * py + zc
+    const float invArea = 1.0f / area;
+    const float za = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) * invArea;
+    const float zb = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) * invArea;
+    const float zc = v0.z - za * v0.x - zb * v0.y;
+
+#ifdef __AVX2__
+    // 行跨度按 8 对齐，从对齐位置开始整块处理；覆盖判定保证不会写到三角形包围盒之外
+    const int alignedMinX = minX & ~7;
+    const __m256 laneOffsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 a0 = _mm256_set1_ps(e0.a);
+    const __m256 a1 = _mm256_set1_ps(e1.a);
+    const __m256 a2 = _mm256_set1_ps(e2.a);
+    const __m256 vza = _mm256_set1_ps(za);
+
+    for (int y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const __m256 r0 = _mm256_set1_ps(e0.b * py + e0.c);
+        const __m256 r1 = _mm256_set1_ps(e1.b * py + e1.c);
+        const __m256 r2 = _mm256_set1_ps(e2.b * py + e2.c);
+        const __m256 rz = _mm256_set1_ps(zb * py + zc);
+        float* row = m_depth.data() + static_cast<size_t>(y) * m_stride;
+
+        for (int x = alignedMinX; x <= maxX; x += 8) {
+            const __m256 px = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), laneOffsets);
+            const __m256 w0 = _mm256_add_ps(_mm256_mul_ps(a0, px), r0);
+            const __m256 w1 = _mm256_add_ps(_mm256_mul_ps(a1, px), r1);
+            const __m256 w2 = _mm256_add_ps(_mm256_mul_ps(a2, px), r2);
+            const __m256 inside = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(w0, zero, _CMP_GE_OQ), _mm256_cmp_ps(w1, zero, _CMP_GE_OQ)),
+                _mm256_cmp_ps(w2, zero, _CMP_GE_OQ));
+            if (_mm256_movemask_ps(inside) == 0) {
+                continue;
+            }
+            const __m256 depth = _mm256_add_ps(_mm256_mul_ps(vza, px), rz);
+            const __m256 old = _mm256_loadu_ps(row + x);
+            _mm256_storeu_ps(row + x, _mm256_blendv_ps(old, _mm256_min_ps(old, depth), inside));
+        }
+    }
+#else
+    for (int y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        float* row = m_depth.data() + static_cast<size_t>(y) * m_stride;
+        for (int x = minX; x <= maxX; ++x) {
+            const float px = static_cast<float>(x) + 0.5f;
+            if (e0.Evaluate(px, py) < 0.0f || e1.Evaluate(px, py) < 0.0f || e2.Evaluate(px, py) < 0.0f) {
+                continue;
+            }
+            const float depth = za * px + zb * py + zc;
+            row[x] = std::min(row[x], depth);
+        }
+    }
+#endif
+}
+
+void OcclusionCuller::Finalize() {
+    for (uint32_t ty = 0; ty < m_tilesY; ++ty) {
+        const uint32_t y0 = ty * kTileSize;
+        const uint32_t y1 = std::min(y0 + kTileSize, m_height);
+        for (uint32_t tx = 0; tx < m_tilesX; ++tx) {
+            const uint32_t x0 = tx * kTileSize;
+            const uint32_t x1 = std::min(x0 + kTileSize, m_width);
+            float maxDepth = 0.0f;
+            for (uint32_t y = y0; y < y1; ++y) {
+                const float* row = m_depth.data() + static_cast<size_t>(y) * m_stride;
+                for (uint32_t x = x0; x < x1; ++x) {
+                    maxDepth = std::max(maxDepth, row[x]);
+                }
+            }
+            m_tileMaxDepth[ty * m_tilesX + tx] = maxDepth;
+        }
+    }
+    m_finalized = true;
+}
+
+bool OcclusionCuller::IsRectVisibleInTile(uint32_t tileX, uint32_t tileY, int x0, int y0, int x1, int y1,
+                                          float minDepth) const {
+    // 分块内所有像素都比包围盒更近：整块被遮挡
+    if (m_tileMaxDepth[tileY * m_tilesX + tileX] < minDepth) {
+        return false;
+    }
+
+    const int tx0 = std::max(x0, static_cast<int>(tileX * kTileSize));
+    const int ty0 = std::max(y0, static_cast<int>(tileY * kTileSize));
+    const int tx1 = std::min(x1, static_cast<int>((tileX + 1) * kTileSize) - 1);
+    const int ty1 = std::min(y1, static_cast<int>((tileY + 1) * kTileSize) - 1);
+    for (int y = ty0; y <= ty1; ++y) {
+        const float* row = m_depth.data() + static_cast<size_t>(y) * m_stride;
+        for (int x = tx0; x <= tx1; ++x) {
+            if (row[x] >= minDepth) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool OcclusionCuller::IsVisible(const AABB& worldBounds) {
+    if (!m_finalized) {
+        return true;
+    }
+    ++m_stats.occludeesTested;
+
+    const float width = static_cast<float>(m_width);
+    const float height = static_cast<float>(m_height);
+    float minSx = width, minSy = height, maxSx = 0.0f, maxSy = 0.0f;
+    float minDepth = 1.0f;
+
+    for (int i = 0; i < 8; ++i) {
+        const Vector3 corner((i & 1) ? worldBounds.max.x() : worldBounds.min.x(),
+                             (i & 2) ? worldBounds.max.y() : worldBounds.min.y(),
+                             (i & 4) ? worldBounds.max.z() : worldBounds.min.z());
+        const Vector4 clip = m_viewProjection * corner.homogeneous();
+        if (!IsClipVertexUsable(clip)) {
+            // 包围盒跨越近平面：相机可能位于其中，视为可见
+            return true;
+        }
+        const ScreenVertex s = ToScreen(clip, width, height);
+        minSx = std::min(minSx, s.x);
+        minSy = std::min(minSy, s.y);
+        maxSx = std::max(maxSx, s.x);
+        maxSy = std::max(maxSy, s.y);
+        minDepth = std::min(minDepth, s.z);
+    }
+
+    // 覆盖到的所有像素（包含部分覆盖的像素）
+    const int x0 = std::max(0, static_cast<int>(std::floor(minSx)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(minSy)));
+    const int x1 = std::min(static_cast<int>(m_width) - 1, static_cast<int>(std::floor(maxSx)));
+    const int y1 = std::min(static_cast<int>(m_height) - 1, static_cast<int>(std::floor(maxSy)));
+    if (x0 > x1 || y0 > y1) {
+        // 完全位于屏幕外，交给视锥体剔除处理
+        return true;
+    }
+
+    bool visible = false;
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) <= kPixelTestThreshold) {
+        for (int y = y0; y <= y1 && !visible; ++y) {
+            const float* row = m_depth.data() + static_cast<size_t>(y) * m_stride;
+            for (int x = x0; x <= x1; ++x) {
+                if (row[x] >= minDepth) {
+                    visible = true;
+                    break;
+                }
+            }
+        }
+    } else {
+        const uint32_t tileX0 = static_cast<uint32_t>(x0) / kTileSize;
+        const uint32_t tileY0 = static_cast<uint32_t>(y0) / kTileSize;
+        const uint32_t tileX1 = static_cast<uint32_t>(x1) / kTileSize;
+        const uint32_t tileY1 = static_cast<uint32_t>(y1) / kTileSize;
+        for (uint32_t ty = tileY0; ty <= tileY1 && !visible; ++ty) {
+            for (uint32_t tx = tileX0; tx <= tileX1; ++tx) {
+                if (IsRectVisibleInTile(tx, ty, x0, y0, x1, y1, minDepth)) {
+                    visible = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!visible) {
+        ++m_stats.occludeesOccluded;
+    }
+    return visible;
+}
+
+} // namespace Render
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/pipeline_state.h"
+#include <bitset>
+#include <mutex>
+
+namespace Render {
+
+PipelineStateDesc PipelineStateDesc::Normalized() const noexcept {
+    PipelineStateDesc result{};
+    result.fields = fields & PipelineStateFields_All;
+
+    if (result.fields & PipelineStateFields_DepthTest) {
+        result.depthTest = depthTest;
+    }
+    if (result.fields & PipelineStateFields_DepthFunc) {
+        result.depthFunc = depthFunc;
+    }
+    if (result.fields & PipelineStateFields_DepthWrite) {
+        result.depthWrite = depthWrite;
+    }
+    if (result.fields & PipelineStateFields_Blend) {
+        result.blendMode = blendMode;
+        // 混合因子只对自定义混合模式有意义
+        if (blendMode == BlendMode::Custom) {
+            result.blendSrcFactor = blendSrcFactor;
+            result.blendDstFactor = blendDstFactor;
+        }
+    }
+    if (result.fields & PipelineStateFields_CullFace) {
+        result.cullFace = cullFace;
+    }
+    if (result.fields & PipelineStateFields_Program) {
+        result.program = program;
+    }
+    return result;
+}
+
+bool PipelineStateDesc::operator==(const PipelineStateDesc& other) const noexcept {
+    return fields == other.fields &&
+           depthTest == other.depthTest &&
+           depthFunc == other.depthFunc &&
+           depthWrite == other.depthWrite &&
+           blendMode == other.blendMode &&
+           blendSrcFactor == other.blendSrcFactor &&
+           blendDstFactor == other.blendDstFactor &&
+           cullFace == other.cullFace &&
+           program == other.program;
+}
+
+std::size_t PipelineStateDescHasher::operator()(const PipelineStateDesc& desc) const noexcept {
+    const uint64_t parts[] = {
+        (static_cast<uint64_t>(desc.fields) << 32) | desc.program,
+        (static_cast<uint64_t>(desc.blendSrcFactor) << 32) | desc.blendDstFactor,
+        (static_cast<uint64_t>(static_cast<uint32_t>(desc.blendMode)) << 24) |
+        (static_cast<uint64_t>(static_cast<uint32_t>(desc.cullFace)) << 16) |
+        (static_cast<uint64_t>(static_cast<uint32_t>(desc.depthFunc)) << 8) |
+        (static_cast<uint64_t>(desc.depthTest) << 1) |
+        static_cast<uint64_t>(desc.depthWrite)
+    };
+
+    uint64_t hash = 1469598103934665603ull;
+    for (uint64_t part : parts) {
+        hash ^= part + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+uint32_t DiffPipelineState(const PipelineStateDesc& current, const PipelineStateDesc& target) noexcept {
+    uint32_t changed = PipelineStateFields_None;
+
+    if ((target.fields & PipelineStateFields_DepthTest) && current.depthTest != target.depthTest) {
+        changed |= PipelineStateFields_DepthTest;
+    }
+    if ((target.fields & PipelineStateFields_DepthFunc) && current.depthFunc != target.depthFunc) {
+        changed |= PipelineStateFields_DepthFunc;
+    }
+    if ((target.fields & PipelineStateFields_DepthWrite) && current.depthWrite != target.depthWrite) {
+        changed |= PipelineStateFields_DepthWrite;
+    }
+    if (target.fields & PipelineStateFields_Blend) {
+        const bool factorsDiffer = target.blendMode == BlendMode::Custom &&
+            (current.blendSrcFactor != target.blendSrcFactor ||
+             current.blendDstFactor != target.blendDstFactor);
+        if (current.blendMode != target.blendMode || factorsDiffer) {
+            changed |= PipelineStateFields_Blend;
+        }
+    }
+    if ((target.fields & PipelineStateFields_CullFace) && current.cullFace != target.cullFace) {
+        changed |= PipelineStateFields_CullFace;
+    }
+    if ((target.fields & PipelineStateFields_Program) && current.program != target.program) {
+        changed |= PipelineStateFields_Program;
+    }
+
+    return changed;
+}
+
+uint32_t CountPipelineStateFields(uint32_t fields) noexcept {
+    return static_cast<uint32_t>(std::bitset<32>(fields & PipelineStateFields_All).count());
+}
+
+PipelineStateRegistry& PipelineStateRegistry::GetInstance() {
+    static PipelineStateRegistry instance;
+    return instance;
+}
+
+PipelineStateId PipelineStateRegistry::Acquire(const PipelineStateDesc& desc) {
+    const PipelineStateDesc normalized = desc.Normalized();
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_lookup.find(normalized);
+        if (it != m_lookup.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_lookup.find(normalized);
+    if (it != m_lookup.end()) {
+        return it->second;
+    }
+
+    m_states.push_back(normalized);
+    const auto id = static_cast<PipelineStateId>(m_states.size());
+    m_lookup.emplace(normalized, id);
+    return id;
+}
+
+const PipelineStateDesc* PipelineStateRegistry::Find(PipelineStateId id) const {
+    if (id == kInvalidPipelineState) {
+        return nullptr;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (id > m_states.size()) {
+        return nullptr;
+    }
+    return &m_states[id - 1];
+}
+
+size_t PipelineStateRegistry::GetCount() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_states.size();
+}
+
+} // namespace Render
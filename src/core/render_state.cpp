@@ -19,6 +19,8 @@
  * For commercial licensing, please contact: 2052046346@qq.com
  */
 #include "render/render_state.h"
+#include "render/pipeline_state.h"
+#include "render/shader.h"
 #include "render/logger.h"
 #include "render/error.h"
 #include <glad/glad.h>
@@ -46,6 +48,8 @@ RenderState::RenderState()
     , m_boundUniformBuffer(0)
     , m_boundShaderStorageBuffer(0)
     , m_currentProgram(0)
+    , m_currentPipelineState(kInvalidPipelineState)
+    , m_programBindEpoch(0)
     , m_viewMatrix(Matrix4::Identity())
     , m_projectionMatrix(Matrix4::Identity())
     , m_viewMatrixSet(false)
@@ -96,6 +100,9 @@ void RenderState::SetDepthTest(bool enable) {
         m_depthTest = enable;
         m_depthTestDirty = true;
         ApplyDepthTest();
+        RecordStateChange(true);
+    } else {
+        RecordStateChange(false);
     }
 }
 
@@ -105,6 +112,9 @@ void RenderState::SetDepthFunc(DepthFunc func) {
         m_depthFunc = func;
         m_depthFuncDirty = true;
         ApplyDepthFunc();
+        RecordStateChange(true);
+    } else {
+        RecordStateChange(false);
     }
 }
 
@@ -114,6 +124,9 @@ void RenderState::SetDepthWrite(bool enable) {
         m_depthWrite = enable;
         m_depthWriteDirty = true;
         ApplyDepthWrite();
+        RecordStateChange(true);
+    } else {
+        RecordStateChange(false);
     }
 }
 
@@ -123,6 +136,9 @@ void RenderState::SetBlendMode(BlendMode mode) {
         m_blendMode = mode;
         m_blendModeDirty = true;
         ApplyBlendMode();
+        RecordStateChange(true);
+    } else {
+        RecordStateChange(false);
     }
 }
 
@@ -134,6 +150,9 @@ void RenderState::SetBlendFunc(uint32_t srcFactor, uint32_t dstFactor) {
         m_blendMode = BlendMode::Custom;
         m_blendModeDirty = true;
         ApplyBlendMode();
+        RecordStateChange(true);
+    } else {
+        RecordStateChange(false);
     }
 }
 
@@ -143,6 +162,9 @@ void RenderState::SetCullFace(CullFace mode) {
         m_cullFace = mode;
         m_cullFaceDirty = true;
         ApplyCullFace();
+        RecordStateChange(true);
+    } else {
+        RecordStateChange(false);
     }
 }
 
@@ -249,6 +271,7 @@ void RenderState::Reset() {
     m_boundUniformBuffer = 0;
     m_boundShaderStorageBuffer = 0;
     m_currentProgram = 0;
+    m_currentPipelineState = kInvalidPipelineState;
     
     // 重置相机矩阵（不清除矩阵值，只清除标志，以便后续可以检查是否已设置）
     m_viewMatrixSet = false;
@@ -487,6 +510,122 @@ void RenderState::UseProgram(uint32_t programId) {
         GL_THREAD_CHECK();
         glUseProgram(programId);
         m_currentProgram = programId;
+        m_currentPipelineState = kInvalidPipelineState;
+    }
+}
+
+// ============================================================================
+// 管线状态对象
+// ============================================================================
+
+void RenderState::ApplyPipelineState(PipelineStateId id) {
+    const PipelineStateDesc* desc = PipelineStateRegistry::GetInstance().Find(id);
+    if (!desc) {
+        Logger::GetInstance().Warning("RenderState::ApplyPipelineState: 无效的管线状态 ID " +
+                                      std::to_string(id));
+        return;
+    }
+
+    // Shader::Use()/Unuse() 直接调用 glUseProgram，通过纪元号检测缓存的程序绑定是否仍然可信
+    const uint64_t programEpoch = Shader::GetBindEpoch();
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+    const bool ownsProgram = (desc->fields & PipelineStateFields_Program) != 0;
+    const bool programTrusted = !ownsProgram || programEpoch == m_programBindEpoch;
+    const uint32_t requested = CountPipelineStateFields(desc->fields);
+
+    if (id == m_currentPipelineState && programTrusted && !m_strictMode) {
+        m_stateChangeCounters.skipped += requested;
+        return;
+    }
+
+    PipelineStateDesc current;
+    current.depthTest = m_depthTest;
+    current.depthFunc = m_depthFunc;
+    current.depthWrite = m_depthWrite;
+    current.blendMode = m_blendMode;
+    current.blendSrcFactor = m_blendSrcFactor;
+    current.blendDstFactor = m_blendDstFactor;
+    current.cullFace = m_cullFace;
+    current.program = m_currentProgram;
+
+    uint32_t changed = DiffPipelineState(current, *desc);
+
+    // 脏标志（缓存失效）与严格模式都要求强制下发
+    if (m_strictMode) {
+        changed = desc->fields & PipelineStateFields_All;
+    } else {
+        if (m_depthTestDirty) changed |= desc->fields & PipelineStateFields_DepthTest;
+        if (m_depthFuncDirty) changed |= desc->fields & PipelineStateFields_DepthFunc;
+        if (m_depthWriteDirty) changed |= desc->fields & PipelineStateFields_DepthWrite;
+        if (m_blendModeDirty) changed |= desc->fields & PipelineStateFields_Blend;
+        if (m_cullFaceDirty) changed |= desc->fields & PipelineStateFields_CullFace;
+        if (!programTrusted) changed |= desc->fields & PipelineStateFields_Program;
+    }
+
+    if (changed & PipelineStateFields_DepthTest) {
+        m_depthTest = desc->depthTest;
+        ApplyDepthTest();
+    }
+    if (changed & PipelineStateFields_DepthFunc) {
+        m_depthFunc = desc->depthFunc;
+        ApplyDepthFunc();
+    }
+    if (changed & PipelineStateFields_DepthWrite) {
+        m_depthWrite = desc->depthWrite;
+        ApplyDepthWrite();
+    }
+    if (changed & PipelineStateFields_Blend) {
+        m_blendMode = desc->blendMode;
+        if (desc->blendMode == BlendMode::Custom) {
+            m_blendSrcFactor = desc->blendSrcFactor;
+            m_blendDstFactor = desc->blendDstFactor;
+        }
+        ApplyBlendMode();
+    }
+    if (changed & PipelineStateFields_CullFace) {
+        m_cullFace = desc->cullFace;
+        ApplyCullFace();
+    }
+    if (changed & PipelineStateFields_Program) {
+        GL_THREAD_CHECK();
+        glUseProgram(desc->program);
+        m_currentProgram = desc->program;
+    }
+
+    if (ownsProgram) {
+        m_programBindEpoch = programEpoch;
+    }
+
+    const uint32_t applied = CountPipelineStateFields(changed);
+    m_stateChangeCounters.applied += applied;
+    m_stateChangeCounters.skipped += requested - applied;
+    m_currentPipelineState = id;
+}
+
+PipelineStateId RenderState::GetCurrentPipelineState() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_currentPipelineState;
+}
+
+RenderState::StateChangeCounters RenderState::GetStateChangeCounters() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_stateChangeCounters;
+}
+
+void RenderState::ResetStateChangeCounters() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_stateChangeCounters = StateChangeCounters{};
+}
+
+void RenderState::RecordStateChange(bool applied) {
+    if (applied) {
+        ++m_stateChangeCounters.applied;
+        // 单项设置改变了状态，当前管线状态对象不再准确
+        m_currentPipelineState = kInvalidPipelineState;
+    } else {
+        ++m_stateChangeCounters.skipped;
     }
 }
 
@@ -513,6 +652,7 @@ void RenderState::InvalidateCache() {
     m_boundUniformBuffer = 0;
     m_boundShaderStorageBuffer = 0;
     m_currentProgram = 0;
+    m_currentPipelineState = kInvalidPipelineState;
     
     Logger::GetInstance().Debug("RenderState: 已清空所有状态缓存");
 }
@@ -537,6 +677,7 @@ void RenderState::InvalidateBufferCache() {
 void RenderState::InvalidateShaderCache() {
     std::unique_lock<std::shared_mutex> lock(m_mutex);
     m_currentProgram = 0;
+    m_currentPipelineState = kInvalidPipelineState;
     Logger::GetInstance().Debug("RenderState: 已清空着色器程序缓存");
 }
 
@@ -547,6 +688,7 @@ void RenderState::InvalidateRenderStateCache() {
     m_depthWriteDirty = true;
     m_blendModeDirty = true;
     m_cullFaceDirty = true;
+    m_currentPipelineState = kInvalidPipelineState;
     Logger::GetInstance().Debug("RenderState: 已清空渲染状态缓存");
 }
 
@@ -668,6 +810,8 @@ void RenderState::SyncFromGL() {
     m_depthWriteDirty = false;
     m_blendModeDirty = false;
     m_cullFaceDirty = false;
+    m_currentPipelineState = kInvalidPipelineState;
+    m_programBindEpoch = Shader::GetBindEpoch();
     
     Logger::GetInstance().Info("RenderState: 已从 OpenGL 同步所有状态");
 }
@@ -27,7 +27,9 @@
 #include "render/material_sort_key.h"
 #include "render/text/text.h"
 #include "render/material_state_cache.h"
+#include "render/pipeline_state.h"
 #include "render/render_layer.h"
+#include "render/debug/profiler.h"
 #include <SDL3/SDL.h>
 #include <algorithm>
 #include <cstdint>
@@ -433,8 +435,11 @@ BatchableItem CreateBatchableItem(Renderable* renderable) {
             }
 
             item.isTransparent = isTransparent;
-            item.batchable = hasIndices && !item.isTransparent && !item.meshData.hasMaterialOverride;
-            item.instanceEligible = hasIndices && !item.meshData.hasMaterialOverride && !item.isTransparent;
+            // 带 meshlet 剔除区间的对象只绘制部分三角形，合批/实例化会提交完整网格
+            const bool meshletCulled = meshRenderable->HasMeshletRanges();
+            item.batchable = hasIndices && !item.isTransparent && !item.meshData.hasMaterialOverride && !meshletCulled;
+            item.instanceEligible = hasIndices && !item.meshData.hasMaterialOverride && !item.isTransparent &&
+                                    !meshletCulled;
             return item;
         }
         case RenderableType::Model: {
@@ -644,6 +649,7 @@ bool Renderer::Initialize(const std::string& title, int width, int height) {
         // 重置渲染状态
         m_renderState->Reset();
         m_batchManager.SetMode(m_batchingMode);
+        Profiler::GetInstance().SetGpuTimingAvailable(true);
         
         m_lastFrameTime = static_cast<float>(SDL_GetTicks()) * 0.001f;
         m_initialized = true;
@@ -668,6 +674,8 @@ void Renderer::Shutdown() {
     
     LOG_INFO("Shutting down RenderEngine...");
     
+    Profiler::GetInstance().SetGpuTimingAvailable(false);
+    Profiler::GetInstance().ReleaseGpuResources();
     m_context->Shutdown();
     
     m_initialized = false;
@@ -676,6 +684,7 @@ void Renderer::Shutdown() {
 
 void Renderer::BeginFrame() {
     std::lock_guard<std::mutex> lock(m_mutex);
+    Profiler::GetInstance().BeginFrame();
     
     // 更新时间
     float currentTime = static_cast<float>(SDL_GetTicks()) * 0.001f;
@@ -702,6 +711,9 @@ void Renderer::BeginFrame() {
     m_stats.Reset();
     m_batchManager.Reset();
     MaterialStateCache::Get().Reset();
+    if (m_renderState) {
+        m_renderState->ResetStateChangeCounters();
+    }
 }
 
 void Renderer::EndFrame() {
@@ -714,6 +726,9 @@ void Renderer::EndFrame() {
     m_lastFrameStats = m_stats;
     
     m_frameCount++;
+
+    // 汇总本帧各线程的 CPU 作用域并轮询已完成的 GPU 查询
+    Profiler::GetInstance().EndFrame();
 }
 
 void Renderer::Present() {
@@ -771,6 +786,12 @@ int Renderer::GetHeight() const {
 void Renderer::UpdateStats() {
     m_stats.frameTime = m_deltaTime * 1000.0f; // 转换为毫秒
     
+    if (m_renderState) {
+        const auto stateCounters = m_renderState->GetStateChangeCounters();
+        m_stats.stateChangesApplied = stateCounters.applied;
+        m_stats.stateChangesSkipped = stateCounters.skipped;
+    }
+    
     // 每秒更新一次 FPS
     m_fpsUpdateTimer += m_deltaTime;
     if (m_fpsUpdateTimer >= 1.0f) {
@@ -862,6 +883,7 @@ void Renderer::FlushRenderQueue() {
     // 2. 所有命令已经处理完成（排序、批处理等）
     // 3. 清除后立即开始渲染，没有空窗期
     // 清除操作将在实际调用 BatchManager::Flush() 之前执行
+    PROFILE_SCOPE("Renderer.FlushRenderQueue");
     
     std::vector<LayerBucket> bucketsSnapshot;
     std::vector<RenderLayerRecord> layerRecords;
@@ -1247,6 +1269,8 @@ void Renderer::FlushRenderQueue() {
             m_needsClear = false;
         }
 
+        PROFILE_SCOPE("Renderer.BatchFlush");
+        PROFILE_GPU_SCOPE("Renderer.BatchFlush");
         auto flushResult = m_batchManager.Flush(m_renderState.get());
         logInfo.result = flushResult;
         m_stats.drawCalls += flushResult.drawCalls;
@@ -1268,11 +1292,17 @@ void Renderer::FlushRenderQueue() {
         // 这确保UI层的状态覆盖（depthTest=false, depthWrite=false）不会影响下一帧的世界层渲染
         if (m_initialized && m_renderState) {
             // 恢复世界层的默认状态：depthTest=true, depthWrite=true
-            m_renderState->SetDepthTest(true);
-            m_renderState->SetDepthWrite(true);
-            m_renderState->SetDepthFunc(DepthFunc::Less);
-            m_renderState->SetBlendMode(BlendMode::None);
-            m_renderState->SetCullFace(CullFace::Back);
+            static const PipelineStateId worldDefaultState = [] {
+                PipelineStateDesc desc;
+                desc.fields = PipelineStateFields_FixedFunction;
+                desc.depthTest = true;
+                desc.depthWrite = true;
+                desc.depthFunc = DepthFunc::Less;
+                desc.blendMode = BlendMode::None;
+                desc.cullFace = CullFace::Back;
+                return PipelineStateRegistry::GetInstance().Acquire(desc);
+            }();
+            m_renderState->ApplyPipelineState(worldDefaultState);
         }
 
         if (currentBatchingMode == BatchingMode::GpuInstancing) {
@@ -1374,6 +1404,15 @@ void Renderer::UpdateLODInstancingStats(const LODInstancingStats& stats) {
     m_lodInstancingStats = stats;
 }
 
+void Renderer::AddCullingStats(uint32_t visibleMeshes, uint32_t culledMeshes,
+                               uint32_t occludedMeshes, uint32_t occluders) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.visibleMeshes += visibleMeshes;
+    m_stats.culledMeshes += culledMeshes;
+    m_stats.occludedMeshes += occludedMeshes;
+    m_stats.occluders += occluders;
+}
+
 bool Renderer::IsLODInstancingAvailable() const {
     // 检查 LOD 实例化渲染是否可用
     // 条件：
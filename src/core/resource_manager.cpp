@@ -923,10 +923,12 @@ ResourceStats ResourceManager::GetStats() const {
         stats.textureMemory += entry.resource->GetMemoryUsage();
     }
     
-    // 计算网格内存
+    // 计算网格内存（CPU 副本与 GPU 缓冲分开统计）
     for (const auto& [name, entry] : m_meshes) {
-        stats.meshMemory += entry.resource->GetMemoryUsage();
+        stats.meshCPUMemory += entry.resource->GetMemoryUsage();
+        stats.meshGPUMemory += entry.resource->GetGPUMemoryUsage();
     }
+    stats.meshMemory = stats.meshCPUMemory + stats.meshGPUMemory;
     
     stats.totalMemory = stats.textureMemory + stats.meshMemory;
     
@@ -986,7 +988,9 @@ void ResourceManager::PrintStatistics() const {
     Logger::GetInstance().Info("总资源数量: " + std::to_string(stats.totalCount));
     Logger::GetInstance().Info("----------------------------------------");
     Logger::GetInstance().Info("纹理内存: " + std::to_string(stats.textureMemory / 1024) + " KB");
-    Logger::GetInstance().Info("网格内存: " + std::to_string(stats.meshMemory / 1024) + " KB");
+    Logger::GetInstance().Info("网格内存: " + std::to_string(stats.meshMemory / 1024) + " KB (CPU " +
+                               std::to_string(stats.meshCPUMemory / 1024) + " KB, GPU " +
+                               std::to_string(stats.meshGPUMemory / 1024) + " KB)");
     Logger::GetInstance().Info("总内存: " + std::to_string(stats.totalMemory / 1024) + " KB");
     Logger::GetInstance().Info("========================================");
 }
@@ -21,6 +21,7 @@
 #include "render/task_scheduler.h"
 #include "render/logger.h"
 #include <algorithm>
+#include <exception>
 
 namespace Render {
 
@@ -216,6 +217,77 @@ std::vector<std::shared_ptr<TaskHandle>> TaskScheduler::SubmitBatch(
     return handles;
 }
 
+void TaskScheduler::ParallelFor(size_t count,
+                                const std::function<void(size_t)>& body,
+                                TaskPriority priority,
+                                const char* name) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || !IsInitialized()) {
+        for (size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+    
+    // 共享状态由辅助任务持有：迭代全部完成后才被调度的辅助任务只会领取到越界下标并直接返回
+    struct SharedState {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t count = 0;
+        const std::function<void(size_t)>* body = nullptr;
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;   // 第一个异常（failed 置位者写入，等待结束后由调用线程读取）
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<SharedState>();
+    state->count = count;
+    state->body = &body;
+    
+    auto run = [state, name]() {
+        for (;;) {
+            const size_t index = state->next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= state->count) {
+                return;
+            }
+            // 出错后剩余迭代不再执行，但仍计入 done，保证调用线程能够返回
+            if (!state->failed.load(std::memory_order_relaxed)) {
+                try {
+                    (*state->body)(index);
+                } catch (...) {
+                    if (!state->failed.exchange(true, std::memory_order_acq_rel)) {
+                        state->error = std::current_exception();
+                        Logger::GetInstance().ErrorFormat("ParallelFor '%s' 迭代 %zu 抛出异常，其余迭代取消", name, index);
+                    }
+                }
+            }
+            if (state->done.fetch_add(1, std::memory_order_acq_rel) + 1 == state->count) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->cv.notify_all();
+            }
+        }
+    };
+    
+    const size_t helperCount = std::min(GetWorkerCount(), count - 1);
+    for (size_t i = 0; i < helperCount; ++i) {
+        SubmitLambda(run, priority, name);
+    }
+    run();
+    
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->cv.wait(lock, [&state] {
+            return state->done.load(std::memory_order_acquire) == state->count;
+        });
+    }
+    
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
 void TaskScheduler::WaitForAll(const std::vector<std::shared_ptr<TaskHandle>>& handles) {
     for (const auto& handle : handles) {
         if (handle) {
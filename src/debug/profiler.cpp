@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/debug/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+#include "render/gl_thread_checker.h"
+#include "render/logger.h"
+
+namespace Render {
+
+namespace {
+
+/// 最多同时等待结果的 GPU 帧数，超过后丢弃最旧的帧，避免查询池无限增长
+constexpr size_t kMaxPendingGpuFrames = 4;
+
+struct ScopeAggregator {
+    std::vector<ProfilerScopeStats> scopes;
+    std::unordered_map<std::string, size_t> indexByPath;
+
+    size_t Record(const std::string& path, const char* name, uint32_t depth, double durationMs) {
+        auto it = indexByPath.find(path);
+        size_t index;
+        if (it == indexByPath.end()) {
+            index = scopes.size();
+            indexByPath.emplace(path, index);
+            ProfilerScopeStats stats;
+            stats.path = path;
+            stats.name = name;
+            stats.depth = depth;
+            scopes.push_back(std::move(stats));
+        } else {
+            index = it->second;
+        }
+
+        ProfilerScopeStats& stats = scopes[index];
+        stats.callCount++;
+        stats.totalMs += durationMs;
+        stats.selfMs += durationMs;
+        stats.maxMs = std::max(stats.maxMs, durationMs);
+        return index;
+    }
+};
+
+/// 按层级路径聚合的通用实现：events 需已按开始时间排序
+template <typename Event, typename DurationFn>
+void AggregateEvents(const std::vector<Event>& events, DurationFn durationMs, ScopeAggregator& aggregator) {
+    struct StackEntry {
+        std::string path;
+        size_t index;
+    };
+    std::vector<StackEntry> stack;
+
+    for (const Event& event : events) {
+        // 作用域跨越帧边界时父事件可能尚未结束，此时直接挂到当前栈顶
+        while (stack.size() > event.depth) {
+            stack.pop_back();
+        }
+
+        std::string path = stack.empty() ? std::string(event.name)
+                                         : stack.back().path + "/" + event.name;
+        const double duration = durationMs(event);
+        const uint32_t depth = static_cast<uint32_t>(stack.size());
+        const size_t index = aggregator.Record(path, event.name, depth, duration);
+        if (!stack.empty()) {
+            aggregator.scopes[stack.back().index].selfMs -= duration;
+        }
+        stack.push_back({std::move(path), index});
+    }
+}
+
+} // namespace
+
+Profiler& Profiler::GetInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() = default;
+
+Profiler::~Profiler() = default;
+
+uint64_t Profiler::NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::SetGpuTimingAvailable(bool available) {
+    m_gpuAvailable.store(available, std::memory_order_relaxed);
+}
+
+void Profiler::SetHistorySize(size_t frames) {
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    m_historySize = std::max<size_t>(frames, 1);
+    while (m_history.size() > m_historySize) {
+        m_history.pop_front();
+    }
+}
+
+// ============================================================================
+// CPU 事件
+// ============================================================================
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto owned = std::make_unique<ThreadBuffer>();
+        buffer = owned.get();
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        m_threadBuffers.push_back(std::move(owned));
+    }
+    return buffer;
+}
+
+uint64_t Profiler::BeginCpuScope() {
+    if (!IsEnabled()) {
+        return 0;
+    }
+    GetThreadBuffer()->depth++;
+    return NowNs();
+}
+
+void Profiler::EndCpuScope(const char* name, uint64_t beginNs) {
+    const uint64_t endNs = NowNs();
+    ThreadBuffer* buffer = GetThreadBuffer();
+    if (buffer->depth > 0) {
+        buffer->depth--;
+    }
+
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    const uint64_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail >= kThreadBufferCapacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    CpuEvent& event = buffer->events[head % kThreadBufferCapacity];
+    event.name = name;
+    event.beginNs = beginNs;
+    event.endNs = endNs;
+    event.depth = buffer->depth;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::DrainCpuEvents(std::vector<std::vector<CpuEvent>>& perThread, uint32_t& dropped) {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    perThread.reserve(m_threadBuffers.size());
+    for (auto& buffer : m_threadBuffers) {
+        const uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+        if (head == tail) {
+            continue;
+        }
+
+        std::vector<CpuEvent> events;
+        events.reserve(static_cast<size_t>(head - tail));
+        for (uint64_t i = tail; i < head; ++i) {
+            events.push_back(buffer->events[i % kThreadBufferCapacity]);
+        }
+        buffer->tail.store(head, std::memory_order_release);
+
+        // 事件按结束顺序写入（子先于父），聚合前恢复为开始顺序
+        std::sort(events.begin(), events.end(), [](const CpuEvent& a, const CpuEvent& b) {
+            if (a.beginNs != b.beginNs) {
+                return a.beginNs < b.beginNs;
+            }
+            return a.depth < b.depth;
+        });
+        perThread.push_back(std::move(events));
+    }
+}
+
+// ============================================================================
+// 帧边界
+// ============================================================================
+
+void Profiler::BeginFrame() {
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    m_frameBeginNs = NowNs();
+    m_inFrame = true;
+}
+
+void Profiler::EndFrame() {
+    const uint64_t endNs = NowNs();
+
+    std::vector<std::vector<CpuEvent>> perThread;
+    uint32_t dropped = 0;
+    DrainCpuEvents(perThread, dropped);
+
+    ProfilerFrame frame;
+    frame.droppedEvents = dropped;
+
+    // 各线程独立还原层级，相同路径跨线程合并
+    ScopeAggregator aggregator;
+    for (const auto& events : perThread) {
+        AggregateEvents(events, [](const CpuEvent& event) {
+            return static_cast<double>(event.endNs - event.beginNs) / 1.0e6;
+        }, aggregator);
+    }
+    frame.cpuScopes = std::move(aggregator.scopes);
+
+    {
+        std::lock_guard<std::mutex> lock(m_frameMutex);
+        frame.frameIndex = m_frameIndex++;
+        frame.frameMs = m_inFrame ? static_cast<double>(endNs - m_frameBeginNs) / 1.0e6 : 0.0;
+        m_inFrame = false;
+
+        if (IsEnabled()) {
+            m_history.push_back(std::move(frame));
+            while (m_history.size() > m_historySize) {
+                m_history.pop_front();
+            }
+        }
+    }
+
+    if (!m_currentGpuFrame.scopes.empty()) {
+        m_currentGpuFrame.frameIndex = m_frameIndex - 1;
+        m_pendingGpuFrames.push_back(std::move(m_currentGpuFrame));
+        m_currentGpuFrame = GpuFrame{};
+    }
+    m_gpuDepth = 0;
+    ResolveGpuFrames();
+}
+
+// ============================================================================
+// GPU 查询
+// ============================================================================
+
+uint32_t Profiler::AcquireQuery() {
+    if (m_freeQueries.empty()) {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        if (query == 0) {
+            return 0;
+        }
+        m_allQueries.push_back(query);
+        return query;
+    }
+    const uint32_t query = m_freeQueries.back();
+    m_freeQueries.pop_back();
+    return query;
+}
+
+int32_t Profiler::BeginGpuScope(const char* name) {
+    if (!IsEnabled() || !IsGpuTimingAvailable()) {
+        return -1;
+    }
+
+    GL_THREAD_CHECK();
+    // 使用时间戳对而非 GL_TIME_ELAPSED：后者同一时刻只能有一个活动查询，无法嵌套
+    GpuScope scope;
+    scope.name = name;
+    scope.depth = m_gpuDepth;
+    scope.beginQuery = AcquireQuery();
+    scope.endQuery = AcquireQuery();
+    if (scope.beginQuery == 0 || scope.endQuery == 0) {
+        if (scope.beginQuery != 0) {
+            m_freeQueries.push_back(scope.beginQuery);
+        }
+        if (scope.endQuery != 0) {
+            m_freeQueries.push_back(scope.endQuery);
+        }
+        return -1;
+    }
+
+    glQueryCounter(scope.beginQuery, GL_TIMESTAMP);
+    m_currentGpuFrame.scopes.push_back(scope);
+    m_gpuDepth++;
+    return static_cast<int32_t>(m_currentGpuFrame.scopes.size() - 1);
+}
+
+void Profiler::EndGpuScope(int32_t scopeIndex) {
+    if (scopeIndex < 0 || static_cast<size_t>(scopeIndex) >= m_currentGpuFrame.scopes.size()) {
+        return;
+    }
+
+    GL_THREAD_CHECK();
+    glQueryCounter(m_currentGpuFrame.scopes[static_cast<size_t>(scopeIndex)].endQuery, GL_TIMESTAMP);
+    if (m_gpuDepth > 0) {
+        m_gpuDepth--;
+    }
+}
+
+void Profiler::ResolveGpuFrames() {
+    if (m_pendingGpuFrames.empty()) {
+        return;
+    }
+    if (!IsGpuTimingAvailable()) {
+        m_pendingGpuFrames.clear();
+        return;
+    }
+
+    GL_THREAD_CHECK();
+    auto recycle = [this](const GpuFrame& frame) {
+        for (const GpuScope& scope : frame.scopes) {
+            m_freeQueries.push_back(scope.beginQuery);
+            m_freeQueries.push_back(scope.endQuery);
+        }
+    };
+
+    // 结果迟迟未就绪（例如驱动不支持时间戳）时丢弃最旧的帧
+    while (m_pendingGpuFrames.size() > kMaxPendingGpuFrames) {
+        recycle(m_pendingGpuFrames.front());
+        m_pendingGpuFrames.pop_front();
+    }
+
+    while (!m_pendingGpuFrames.empty()) {
+        GpuFrame& frame = m_pendingGpuFrames.front();
+
+        // 查询按提交顺序完成，检查最后一个结束查询即可
+        GLint available = 0;
+        glGetQueryObjectiv(frame.scopes.back().endQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+
+        struct GpuEvent {
+            const char* name;
+            uint32_t depth;
+            double durationMs;
+        };
+        std::vector<GpuEvent> events;
+        events.reserve(frame.scopes.size());
+        for (const GpuScope& scope : frame.scopes) {
+            GLuint64 beginNs = 0;
+            GLuint64 endNs = 0;
+            glGetQueryObjectui64v(scope.beginQuery, GL_QUERY_RESULT, &beginNs);
+            glGetQueryObjectui64v(scope.endQuery, GL_QUERY_RESULT, &endNs);
+            const double duration = endNs > beginNs ? static_cast<double>(endNs - beginNs) / 1.0e6 : 0.0;
+            events.push_back({scope.name, scope.depth, duration});
+        }
+
+        ScopeAggregator aggregator;
+        AggregateEvents(events, [](const GpuEvent& event) { return event.durationMs; }, aggregator);
+        AttachGpuResults(frame.frameIndex, std::move(aggregator.scopes));
+
+        recycle(frame);
+        m_pendingGpuFrames.pop_front();
+    }
+}
+
+void Profiler::AttachGpuResults(uint64_t frameIndex, std::vector<ProfilerScopeStats>&& scopes) {
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    for (auto it = m_history.rbegin(); it != m_history.rend(); ++it) {
+        if (it->frameIndex == frameIndex) {
+            it->gpuScopes = std::move(scopes);
+            return;
+        }
+    }
+}
+
+void Profiler::ReleaseGpuResources() {
+    m_pendingGpuFrames.clear();
+    m_currentGpuFrame = GpuFrame{};
+    m_freeQueries.clear();
+    m_gpuDepth = 0;
+    if (!m_allQueries.empty()) {
+        GL_THREAD_CHECK();
+        glDeleteQueries(static_cast<GLsizei>(m_allQueries.size()), m_allQueries.data());
+        m_allQueries.clear();
+    }
+}
+
+// ============================================================================
+// 查询与导出
+// ============================================================================
+
+ProfilerFrame Profiler::GetLastFrame() const {
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    return m_history.empty() ? ProfilerFrame{} : m_history.back();
+}
+
+std::vector<ProfilerScopeStats> Profiler::GetTopScopes(size_t count) const {
+    std::vector<ProfilerScopeStats> scopes;
+    {
+        std::lock_guard<std::mutex> lock(m_frameMutex);
+        if (m_history.empty()) {
+            return scopes;
+        }
+        scopes = m_history.back().cpuScopes;
+    }
+
+    std::stable_sort(scopes.begin(), scopes.end(),
+                     [](const ProfilerScopeStats& a, const ProfilerScopeStats& b) {
+                         return a.totalMs > b.totalMs;
+                     });
+    if (scopes.size() > count) {
+        scopes.resize(count);
+    }
+    return scopes;
+}
+
+std::vector<ProfilerFrame> Profiler::GetHistory() const {
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    return std::vector<ProfilerFrame>(m_history.begin(), m_history.end());
+}
+
+bool Profiler::DumpToFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        Logger::GetInstance().WarningFormat("[Profiler] Failed to open dump file: %s", path.c_str());
+        return false;
+    }
+
+    file << "frame,source,path,depth,calls,total_ms,self_ms,max_ms,frame_ms\n";
+    const std::vector<ProfilerFrame> history = GetHistory();
+    auto writeScopes = [&file](const ProfilerFrame& frame, const char* source,
+                               const std::vector<ProfilerScopeStats>& scopes) {
+        for (const auto& scope : scopes) {
+            file << frame.frameIndex << ',' << source << ',' << scope.path << ','
+                 << scope.depth << ',' << scope.callCount << ','
+                 << scope.totalMs << ',' << scope.selfMs << ',' << scope.maxMs << ','
+                 << frame.frameMs << '\n';
+        }
+    };
+    for (const auto& frame : history) {
+        writeScopes(frame, "cpu", frame.cpuScopes);
+        writeScopes(frame, "gpu", frame.gpuScopes);
+    }
+
+    if (!file.good()) {
+        Logger::GetInstance().WarningFormat("[Profiler] Failed to write dump file: %s", path.c_str());
+        return false;
+    }
+
+    Logger::GetInstance().InfoFormat("[Profiler] Dumped %zu frames to %s", history.size(), path.c_str());
+    return true;
+}
+
+void Profiler::Reset() {
+    std::vector<std::vector<CpuEvent>> discarded;
+    uint32_t dropped = 0;
+    DrainCpuEvents(discarded, dropped);
+
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    m_history.clear();
+    m_inFrame = false;
+}
+
+} // namespace Render
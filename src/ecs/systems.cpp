@@ -36,8 +36,11 @@
 #include "render/sprite/sprite_nineslice.h"
 #include "render/ecs/sprite_animation_script_registry.h"
 #include "render/debug/sprite_animation_debugger.h"
+#include "render/debug/profiler.h"
 #include "render/lod_system.h"  // LOD 系统支持
 #include "render/lod_instanced_renderer.h"  // LOD 实例化渲染器（阶段2.2）
+#include "render/texture_streamer.h"
+#include "render/meshlet.h"
 
 #include <utility>
 #include <algorithm>
@@ -51,6 +54,12 @@ namespace ECS {
 
 namespace {
 
+/// 声明了 FrameData 块的着色器由帧数据 UBO 提供相机/光照/时间数据
+bool UsesFrameUniformBlock(const Shader& shader) {
+    const UniformManager* uniformMgr = shader.GetUniformManager();
+    return uniformMgr && uniformMgr->HasUniformBlock(kFrameUniformBlockName);
+}
+
 uint32_t HashCombine(uint32_t seed, uint32_t value) {
     seed ^= value + 0x9e3779b9u + (seed << 6) + (seed >> 2);
     return seed;
@@ -270,6 +279,44 @@ bool ProcessAnimationTransitions(EntityID entity,
     return false;
 }
 
+/// 取实体的裁剪包围球：优先使用 WorldBoundsComponent 缓存，缺失时退回实体位置 + 默认半径
+void ResolveCullingSphere(World* world, EntityID entity, const TransformComponent& transform,
+                          Vector3& center, float& radius) {
+    center = transform.GetPosition();
+    radius = 1.0f;  // 默认半径
+    if (world->HasComponent<WorldBoundsComponent>(entity)) {
+        const auto& bounds = world->GetComponent<WorldBoundsComponent>(entity);
+        if (bounds.valid) {
+            center = bounds.sphereCenter;
+            radius = bounds.sphereRadius;
+        }
+    }
+}
+
+/// 相机周围不做视锥体剔除的半径（与 MeshRenderSystem::ShouldCull、LODFrustumCullingSystem 一致）
+constexpr float kNoCullRadius = 5.0f;
+
+/// 场景 BVH 中包围球的放大系数：覆盖 ShouldCull（1.5 倍）与 LODFrustumCullingSystem（2.5 倍）的安全边距，
+/// 保证 BVH 粗筛结果是两条裁剪路径可见集合的超集
+constexpr float kBVHCullingRadiusScale = 2.5f;
+
+/// 每帧轮转复查的已跟踪实体数量（兜底没有事件的修改，如直接替换 MeshRenderComponent::mesh）
+constexpr size_t kBVHRevalidateBudget = 256;
+
+/// 选择写入遮挡深度缓冲的网格：occluderMesh > LOD3 > LOD2 > 原始网格
+Ref<Mesh> ResolveOccluderMesh(World* world, EntityID entity, const MeshRenderComponent& meshComp) {
+    if (meshComp.occluderMesh) {
+        return meshComp.occluderMesh;
+    }
+    if (world->HasComponent<LODComponent>(entity)) {
+        const auto& lodConfig = world->GetComponent<LODComponent>(entity).config;
+        if (lodConfig.enabled) {
+            return lodConfig.GetLODMesh(LODLevel::LOD3, lodConfig.GetLODMesh(LODLevel::LOD2, meshComp.mesh));
+        }
+    }
+    return meshComp.mesh;
+}
+
 } // namespace
 
 // ============================================================
@@ -277,6 +324,7 @@ bool ProcessAnimationTransitions(EntityID entity,
 // ============================================================
 
 void TransformSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.TransformSystem");
     (void)deltaTime;  // 未使用
     
     if (!m_world) return;
@@ -553,6 +601,7 @@ void ResourceLoadingSystem::OnDestroy() {
 }
 
 void ResourceLoadingSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.ResourceLoadingSystem");
     (void)deltaTime;  // 未使用
     
     // ✅ 更严格的检查：确保AsyncResourceLoader已初始化
@@ -1508,6 +1557,11 @@ MeshRenderSystem::MeshRenderSystem(Renderer* renderer)
 void MeshRenderSystem::OnCreate(World* world) {
     System::OnCreate(world);
     
+    // 包围体组件由本系统自动添加，注册是幂等的
+    if (world) {
+        world->RegisterComponent<WorldBoundsComponent>();
+    }
+    
     // 注意：不在这里获取CameraSystem，因为此时World::RegisterSystem持有unique_lock
     // 需要在World::PostInitialize后手动设置，或在ShouldCull中按需获取
 }
@@ -1519,6 +1573,25 @@ void MeshRenderSystem::SetLODInstancingEnabled(bool enabled) {
     }
 }
 
+void MeshRenderSystem::SetBVHCullingEnabled(bool enabled) {
+    if (m_bvhCullingEnabled == enabled) {
+        return;
+    }
+    m_bvhCullingEnabled = enabled;
+    if (!enabled) {
+        UnregisterBVHCallbacks();
+        m_sceneBVH.Clear();
+        m_bvhEntities.clear();
+        m_bvhSyncFrame.clear();
+        m_bvhUnbounded.clear();
+        m_bvhParented.clear();
+        m_bvhTouched.clear();
+        m_bvhQueryScratch.clear();
+        m_bvhRevalidateCursor = 0;
+    }
+    m_bvhNeedsFullSync = true;
+}
+
 bool MeshRenderSystem::IsLODInstancingEnabled() const {
     // 阶段2.3：从 Renderer 获取设置，而不是使用本地设置
     if (m_renderer) {
@@ -1528,11 +1601,13 @@ bool MeshRenderSystem::IsLODInstancingEnabled() const {
 }
 
 void MeshRenderSystem::OnDestroy() {
+    UnregisterBVHCallbacks();
     m_cameraSystem = nullptr;
     System::OnDestroy();
 }
 
 void MeshRenderSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.MeshRenderSystem");
     (void)deltaTime;  // 未使用
     
     // 延迟获取 CameraSystem（避免在 OnCreate 时获取导致死锁）
@@ -1560,6 +1635,14 @@ void MeshRenderSystem::Update(float deltaTime) {
         
         // 查询所有有 LODComponent 的实体
         auto entities = m_world->Query<TransformComponent, MeshRenderComponent>();
+        
+        // 刷新世界空间包围体（仅变换或网格变化的实体会重新计算）
+        // BVH 模式下由事件驱动，只刷新本帧受影响的实体
+        if (m_bvhCullingEnabled) {
+            SyncSceneBVH();
+        } else {
+            UpdateWorldBounds(entities);
+        }
         std::vector<EntityID> lodEntities;
         lodEntities.reserve(entities.size());
         
@@ -1577,6 +1660,17 @@ void MeshRenderSystem::Update(float deltaTime) {
     
     // 提交渲染对象
     SubmitRenderables();
+    
+    // 将剔除统计转发到 Renderer，使 GetStats() 与 HUD 可见
+    if (m_renderer) {
+        m_renderer->AddCullingStats(static_cast<uint32_t>(m_stats.visibleMeshes),
+                                    static_cast<uint32_t>(m_stats.culledMeshes),
+                                    static_cast<uint32_t>(m_stats.occludedMeshes),
+                                    static_cast<uint32_t>(m_stats.occluderCount));
+    }
+    
+    // 按本帧请求提升/降低流式纹理的驻留级别
+    TextureStreamer::GetInstance().Update();
 }
 
 void MeshRenderSystem::SubmitRenderables() {
@@ -1604,6 +1698,28 @@ void MeshRenderSystem::SubmitRenderables() {
             firstFrame = false;
         }
         
+        // ==================== 场景 BVH 粗筛 ====================
+        // 只保留 BVH 判定可能可见的实体，后续的逐实体裁剪与 LOD 流程保持不变
+        const size_t totalEntityCount = entities.size();
+        if (m_bvhCullingEnabled) {
+            PROFILE_SCOPE("MeshRender.BVHCull");
+            std::vector<EntityID> candidates;
+            if (CollectBVHCandidates(candidates)) {
+                m_stats.culledMeshes += totalEntityCount - candidates.size();
+                entities = std::move(candidates);
+            }
+        }
+        
+        // ==================== 软件遮挡剔除 ====================
+        // 在 LOD 选择与提交之前移除被遮挡体完全挡住的实体
+        if (m_occlusionCullingEnabled) {
+            PROFILE_SCOPE("MeshRender.OcclusionCull");
+            ApplyOcclusionCulling(entities);
+        }
+        
+        // ==================== 纹理 mip 流式请求 ====================
+        RequestTextureResidency(entities);
+        
         // ✅ 检查RenderState是否有效
         auto renderState = m_renderer->GetRenderState();
         if (!renderState) {
@@ -1624,18 +1740,22 @@ void MeshRenderSystem::SubmitRenderables() {
             // ==================== 阶段3.3：LOD 视锥体裁剪优化 ====================
             // 如果启用阶段3.3优化，使用 LODFrustumCullingSystem 进行批量视锥体裁剪和 LOD 选择
             std::vector<EntityID> entitiesToProcess;
+            std::vector<LODLevel> entityLODsToProcess;  // 与 entitiesToProcess 对应（含视锥体外降级），为空时使用 currentLOD
             size_t totalEntities = entities.size();
             
             if (m_lodFrustumCullingEnabled && m_cameraSystem) {
                 Camera* mainCamera = m_cameraSystem->GetMainCameraObject();
                 if (mainCamera) {
                     // 使用 LODFrustumCullingSystem 进行批量视锥体裁剪和 LOD 选择
+                    PROFILE_SCOPE("LOD.Cull");
                     std::vector<EntityID> entityList(entities.begin(), entities.end());
+                    // LOD 已在 Update 中由 LODSelector 选择（含分帧更新与预算），这里只做裁剪与视锥体外降级
                     auto visibleEntitiesByLOD = LODFrustumCullingSystem::BatchCullAndSelectLOD(
                         entityList,
                         m_world,
                         mainCamera,
-                        m_frameId
+                        m_frameId,
+                        true
                     );
                     
                     // 收集所有可见实体（按 LOD 级别分组）
@@ -1645,6 +1765,7 @@ void MeshRenderSystem::SubmitRenderables() {
                         entitiesToProcess.insert(entitiesToProcess.end(), 
                                                  visibleEntities.begin(), 
                                                  visibleEntities.end());
+                        entityLODsToProcess.insert(entityLODsToProcess.end(), visibleEntities.size(), lodLevel);
                     }
                     
                     // 更新剔除统计（阶段3.3优化已经处理了视锥体裁剪）
@@ -1660,7 +1781,8 @@ void MeshRenderSystem::SubmitRenderables() {
             }
             
             // 收集实例数据（只处理可见实体）
-            for (const auto& entity : entitiesToProcess) {
+            for (size_t processIndex = 0; processIndex < entitiesToProcess.size(); ++processIndex) {
+                const EntityID entity = entitiesToProcess[processIndex];
                 auto& transform = m_world->GetComponent<TransformComponent>(entity);
                 auto& meshComp = m_world->GetComponent<MeshRenderComponent>(entity);
                 
@@ -1682,7 +1804,7 @@ void MeshRenderSystem::SubmitRenderables() {
                 
                 if (m_world->HasComponent<LODComponent>(entity)) {
                     auto& lodComp = m_world->GetComponent<LODComponent>(entity);
-                    lodLevel = lodComp.currentLOD;
+                    lodLevel = entityLODsToProcess.empty() ? lodComp.currentLOD : entityLODsToProcess[processIndex];
                     usingLOD = lodComp.config.enabled;
                     
                     // 统计 LOD 使用情况
@@ -1702,6 +1824,7 @@ void MeshRenderSystem::SubmitRenderables() {
                             case LODLevel::LOD1: m_stats.lod1Count++; break;
                             case LODLevel::LOD2: m_stats.lod2Count++; break;
                             case LODLevel::LOD3: m_stats.lod3Count++; break;
+                            case LODLevel::Impostor: m_stats.impostorCount++; break;
                             default: break;
                         }
                     }
@@ -1727,20 +1850,10 @@ void MeshRenderSystem::SubmitRenderables() {
                 // 阶段3.3：如果启用了LOD视锥体裁剪优化，LODFrustumCullingSystem已经处理了视锥体裁剪
                 // 这里只需要对未启用阶段3.3优化的情况进行视锥体裁剪
                 if (!m_lodFrustumCullingEnabled) {
-                    Vector3 position = transform.GetPosition();
-                    
-                    // 从网格包围盒计算半径（使用 LOD 网格）
-                    float radius = 1.0f;  // 默认半径
-                    if (renderMesh) {
-                        AABB bounds = renderMesh->CalculateBounds();
-                        Vector3 size = bounds.max - bounds.min;
-                        radius = size.norm() * 0.5f;  // 包围盒对角线的一半作为半径
-                        
-                        // 考虑Transform的缩放
-                        Vector3 scale = transform.GetScale();
-                        float maxScale = std::max(std::max(scale.x(), scale.y()), scale.z());
-                        radius *= maxScale;
-                    }
+                    // 使用缓存的世界空间包围球（由 UpdateWorldBounds 维护，不再逐帧遍历顶点）
+                    Vector3 position;
+                    float radius = 1.0f;
+                    ResolveCullingSphere(m_world, entity, transform, position, radius);
                     
                     if (ShouldCull(position, radius)) {
                         m_stats.culledMeshes++;
@@ -1811,10 +1924,10 @@ void MeshRenderSystem::SubmitRenderables() {
                 if (m_stats.lodEnabledEntities > 0) {
                     Logger::GetInstance().InfoFormat(
                         "[MeshRenderSystem] LOD Instanced: %zu groups, %zu instances, %zu draw calls | "
-                        "LOD: enabled=%zu, LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, culled=%zu",
+                        "LOD: enabled=%zu, LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, impostor=%zu, culled=%zu",
                         lodStats.groupCount, lodStats.totalInstances, lodStats.drawCalls,
                         m_stats.lodEnabledEntities, m_stats.lod0Count, m_stats.lod1Count,
-                        m_stats.lod2Count, m_stats.lod3Count, m_stats.lodCulledCount
+                        m_stats.lod2Count, m_stats.lod3Count, m_stats.impostorCount, m_stats.lodCulledCount
                     );
                 } else {
                     Logger::GetInstance().InfoFormat(
@@ -1881,6 +1994,7 @@ void MeshRenderSystem::SubmitRenderables() {
                         case LODLevel::LOD1: m_stats.lod1Count++; break;
                         case LODLevel::LOD2: m_stats.lod2Count++; break;
                         case LODLevel::LOD3: m_stats.lod3Count++; break;
+                        case LODLevel::Impostor: m_stats.impostorCount++; break;
                         default: break;
                     }
                 }
@@ -1903,21 +2017,10 @@ void MeshRenderSystem::SubmitRenderables() {
                 continue;
             }
             
-            // 视锥体裁剪优化
-            Vector3 position = transform.GetPosition();
-            
-            // 从网格包围盒计算半径（使用 LOD 网格）
-            float radius = 1.0f;  // 默认半径
-            if (renderMesh) {
-                AABB bounds = renderMesh->CalculateBounds();
-                Vector3 size = bounds.max - bounds.min;
-                radius = size.norm() * 0.5f;  // 包围盒对角线的一半作为半径
-                
-                // 考虑Transform的缩放
-                Vector3 scale = transform.GetScale();
-                float maxScale = std::max(std::max(scale.x(), scale.y()), scale.z());
-                radius *= maxScale;
-            }
+            // 视锥体裁剪优化：使用缓存的世界空间包围球（由 UpdateWorldBounds 维护）
+            Vector3 position;
+            float radius = 1.0f;
+            ResolveCullingSphere(m_world, entity, transform, position, radius);
             
             if (ShouldCull(position, radius)) {
                 m_stats.culledMeshes++;
@@ -1936,6 +2039,32 @@ void MeshRenderSystem::SubmitRenderables() {
                 continue;
             }
             
+            // ==================== Meshlet 剔除 ====================
+            // 大网格按簇测试视锥体与背面：全部可见照常绘制，部分可见只提交可见区间，全部不可见直接跳过
+            m_meshletRanges.clear();
+            if (m_meshletCullingEnabled && renderMaterial->GetCullFace() != CullFace::None) {
+                auto meshlets = renderMesh->GetMeshlets();
+                Camera* mainCamera = m_cameraSystem ? m_cameraSystem->GetMainCameraObject() : nullptr;
+                if (meshlets && mainCamera && meshlets->triangleCount >= m_meshletMinTriangles) {
+                    PROFILE_SCOPE("MeshRender.MeshletCull");
+                    MeshletCullStats cullStats;
+                    const size_t visibleIndices = MeshletCuller::CullRanges(
+                        *meshlets, transform.transform->GetWorldMatrix(), mainCamera->GetFrustum(),
+                        mainCamera->GetPosition(), m_meshletRanges, &cullStats);
+                    m_stats.meshletTestedMeshes++;
+                    m_stats.meshletTrianglesCulled += cullStats.trianglesTotal - cullStats.trianglesSubmitted;
+                    if (visibleIndices == 0) {
+                        m_stats.culledMeshes++;
+                        continue;
+                    }
+                    if (visibleIndices == meshlets->triangleCount * 3) {
+                        m_meshletRanges.clear();  // 全部可见：绘制完整网格，保留合批/实例化资格
+                    } else {
+                        m_stats.meshletPartialMeshes++;
+                    }
+                }
+            }
+            
             // ==================== 实例化渲染支持 ====================
             // 注意：传统实例化（useInstancing + instanceCount）用于单个实体渲染多个实例的场景
             // 但推荐使用 LOD 实例化渲染（通过创建多个实体，每个实体有自己的 TransformComponent）
@@ -1980,6 +2109,11 @@ void MeshRenderSystem::SubmitRenderables() {
             renderable->SetRenderPriority(meshComp.renderPriority);
             renderable->SetCastShadows(meshComp.castShadows);
             renderable->SetReceiveShadows(meshComp.receiveShadows);
+            if (m_meshletRanges.empty()) {
+                renderable->ClearMeshletRanges();  // 池化对象可能带有上一帧的区间
+            } else {
+                renderable->SetMeshletRanges(m_meshletRanges);
+            }
             
             // ==================== ✅ MaterialOverride 处理 ====================
             // 将ECS组件的MaterialOverride传递给MeshRenderable
@@ -2145,14 +2279,14 @@ void MeshRenderSystem::SubmitRenderables() {
             if (m_stats.lodEnabledEntities > 0) {
                 Logger::GetInstance().InfoFormat(
                     "[MeshRenderSystem] Submitted %zu renderables (total: %zu, culled: %zu) | "
-                    "LOD: enabled=%zu, LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, culled=%zu",
-                    m_stats.visibleMeshes, entities.size(), m_stats.culledMeshes,
+                    "LOD: enabled=%zu, LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, impostor=%zu, culled=%zu",
+                    m_stats.visibleMeshes, totalEntityCount, m_stats.culledMeshes,
                     m_stats.lodEnabledEntities, m_stats.lod0Count, m_stats.lod1Count,
-                    m_stats.lod2Count, m_stats.lod3Count, m_stats.lodCulledCount
+                    m_stats.lod2Count, m_stats.lod3Count, m_stats.impostorCount, m_stats.lodCulledCount
                 );
             } else {
                 Logger::GetInstance().InfoFormat("[MeshRenderSystem] Submitted %zu renderables (total entities: %zu, culled: %zu)", 
-                                                 m_stats.visibleMeshes, entities.size(), m_stats.culledMeshes);
+                                                 m_stats.visibleMeshes, totalEntityCount, m_stats.culledMeshes);
             }
         }
     }
@@ -2161,6 +2295,271 @@ void MeshRenderSystem::SubmitRenderables() {
     }
 }
 
+void MeshRenderSystem::UpdateWorldBounds(const std::vector<EntityID>& entities) {
+    PROFILE_SCOPE("MeshRender.UpdateWorldBounds");
+    
+    for (EntityID entity : entities) {
+        RefreshWorldBounds(entity);
+    }
+}
+
+const WorldBoundsComponent* MeshRenderSystem::RefreshWorldBounds(EntityID entity) {
+    auto& meshComp = m_world->GetComponent<MeshRenderComponent>(entity);
+    auto& transformComp = m_world->GetComponent<TransformComponent>(entity);
+    if (!meshComp.mesh || !transformComp.transform) {
+        return nullptr;
+    }
+    
+    if (!m_world->HasComponent<WorldBoundsComponent>(entity)) {
+        m_world->AddComponent(entity, WorldBoundsComponent{});
+    }
+    
+    auto& boundsComp = m_world->GetComponent<WorldBoundsComponent>(entity);
+    boundsComp.Refresh(meshComp.mesh, transformComp.GetWorldMatrix());
+    return &boundsComp;
+}
+
+void MeshRenderSystem::RegisterBVHCallbacks() {
+    if (!m_world || !m_bvhCallbackIds.empty()) {
+        return;
+    }
+    
+    auto& registry = m_world->GetComponentRegistry();
+    auto enqueue = [this](EntityID entity) {
+        std::lock_guard<std::mutex> lock(m_bvhEventMutex);
+        m_bvhPendingEntities.push_back(entity);
+    };
+    
+    m_bvhCallbackIds.push_back(registry.RegisterComponentChangeCallback<TransformComponent>(
+        [enqueue](EntityID entity, const TransformComponent&) { enqueue(entity); }));
+    m_bvhCallbackIds.push_back(registry.RegisterComponentLifecycleCallback<TransformComponent>(
+        [enqueue](EntityID entity, ComponentRegistry::ComponentLifecycleEvent) { enqueue(entity); }));
+    m_bvhCallbackIds.push_back(registry.RegisterComponentLifecycleCallback<MeshRenderComponent>(
+        [enqueue](EntityID entity, ComponentRegistry::ComponentLifecycleEvent) { enqueue(entity); }));
+    
+    // 注册前发生的变化没有事件，首次同步遍历一次全部实体
+    m_bvhNeedsFullSync = true;
+}
+
+void MeshRenderSystem::UnregisterBVHCallbacks() {
+    if (m_world && !m_bvhCallbackIds.empty()) {
+        auto& registry = m_world->GetComponentRegistry();
+        registry.UnregisterComponentChangeCallback(m_bvhCallbackIds.front());
+        for (size_t i = 1; i < m_bvhCallbackIds.size(); ++i) {
+            registry.UnregisterComponentLifecycleCallback(m_bvhCallbackIds[i]);
+        }
+    }
+    m_bvhCallbackIds.clear();
+    
+    std::lock_guard<std::mutex> lock(m_bvhEventMutex);
+    m_bvhPendingEntities.clear();
+}
+
+void MeshRenderSystem::SyncSceneBVH() {
+    PROFILE_SCOPE("MeshRender.SyncSceneBVH");
+    
+    RegisterBVHCallbacks();
+    
+    m_bvhTouched.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_bvhEventMutex);
+        m_bvhTouched.swap(m_bvhPendingEntities);
+    }
+    
+    if (m_bvhNeedsFullSync) {
+        m_bvhNeedsFullSync = false;
+        auto entities = m_world->Query<TransformComponent, MeshRenderComponent>();
+        m_bvhTouched.insert(m_bvhTouched.end(), entities.begin(), entities.end());
+    }
+    
+    // 尚无包围体（网格未加载）与有父变换的实体每帧复查，它们的变化不会产生自身的事件
+    m_bvhTouched.insert(m_bvhTouched.end(), m_bvhUnbounded.begin(), m_bvhUnbounded.end());
+    m_bvhTouched.insert(m_bvhTouched.end(), m_bvhParented.begin(), m_bvhParented.end());
+    m_bvhUnbounded.clear();
+    m_bvhParented.clear();
+    
+    // 轮转复查一小段已跟踪实体
+    const size_t slotCount = m_bvhEntities.size();
+    const size_t revalidateCount = std::min(slotCount, kBVHRevalidateBudget);
+    for (size_t i = 0; i < revalidateCount; ++i) {
+        if (m_bvhRevalidateCursor >= slotCount) {
+            m_bvhRevalidateCursor = 0;
+        }
+        const EntityID entity = m_bvhEntities[m_bvhRevalidateCursor++];
+        if (entity.IsValid()) {
+            m_bvhTouched.push_back(entity);
+        }
+    }
+    
+    for (EntityID entity : m_bvhTouched) {
+        SyncBVHEntity(entity);
+    }
+    
+    m_sceneBVH.Commit();
+}
+
+void MeshRenderSystem::SyncBVHEntity(EntityID entity) {
+    const uint32_t index = entity.index;
+    if (index >= m_bvhEntities.size()) {
+        m_bvhEntities.resize(static_cast<size_t>(index) + 1, EntityID::Invalid());
+        m_bvhSyncFrame.resize(static_cast<size_t>(index) + 1, 0);
+    }
+    
+    // 同一实体本帧可能来自多个事件，只同步一次
+    if (m_bvhSyncFrame[index] == m_frameId && m_bvhEntities[index] == entity) {
+        return;
+    }
+    
+    const bool alive = m_world->IsValidEntity(entity) &&
+                       m_world->HasComponent<TransformComponent>(entity) &&
+                       m_world->HasComponent<MeshRenderComponent>(entity);
+    if (!alive) {
+        // 已销毁或失去组件；索引可能已被新实体复用，只移除仍属于该实体的条目
+        if (m_bvhEntities[index] == entity) {
+            m_sceneBVH.Remove(index);
+            m_bvhEntities[index] = EntityID::Invalid();
+        }
+        return;
+    }
+    
+    m_bvhEntities[index] = entity;
+    m_bvhSyncFrame[index] = m_frameId;
+    
+    const auto& transformComp = m_world->GetComponent<TransformComponent>(entity);
+    if (transformComp.transform && transformComp.transform->HasParent()) {
+        m_bvhParented.push_back(entity);
+    }
+    
+    const WorldBoundsComponent* bounds = RefreshWorldBounds(entity);
+    if (!bounds || !bounds->valid) {
+        // 网格尚未加载等情况：不放入 BVH，始终作为候选交给逐实体裁剪
+        m_sceneBVH.Remove(index);
+        m_bvhUnbounded.push_back(entity);
+        return;
+    }
+    
+    // SceneBVH::Set 在包围盒未变化时直接返回
+    const Vector3 extent = Vector3::Constant(bounds->sphereRadius * kBVHCullingRadiusScale);
+    m_sceneBVH.Set(index, AABB(bounds->sphereCenter - extent, bounds->sphereCenter + extent));
+}
+
+bool MeshRenderSystem::CollectBVHCandidates(std::vector<EntityID>& candidates) {
+    if (!m_cameraSystem) {
+        return false;
+    }
+    Camera* mainCamera = m_cameraSystem->GetMainCameraObject();
+    if (!mainCamera) {
+        return false;
+    }
+    
+    m_bvhQueryScratch.clear();
+    m_sceneBVH.QueryFrustum(mainCamera->GetFrustum(), m_bvhQueryScratch);
+    // 近距离保护：相机附近的实体即使在视锥体外也不剔除
+    m_sceneBVH.QuerySphere(mainCamera->GetPosition(), kNoCullRadius, m_bvhQueryScratch);
+    
+    std::sort(m_bvhQueryScratch.begin(), m_bvhQueryScratch.end());
+    m_bvhQueryScratch.erase(std::unique(m_bvhQueryScratch.begin(), m_bvhQueryScratch.end()),
+                            m_bvhQueryScratch.end());
+    
+    candidates.clear();
+    candidates.reserve(m_bvhQueryScratch.size() + m_bvhUnbounded.size());
+    for (uint32_t index : m_bvhQueryScratch) {
+        candidates.push_back(m_bvhEntities[index]);
+    }
+    candidates.insert(candidates.end(), m_bvhUnbounded.begin(), m_bvhUnbounded.end());
+    return true;
+}
+
+void MeshRenderSystem::ApplyOcclusionCulling(std::vector<EntityID>& entities) {
+    if (!m_cameraSystem) {
+        return;
+    }
+    Camera* mainCamera = m_cameraSystem->GetMainCameraObject();
+    if (!mainCamera) {
+        return;
+    }
+    
+    const Frustum& frustum = mainCamera->GetFrustum();
+    m_occlusionCuller.BeginFrame(mainCamera->GetViewProjectionMatrix());
+    
+    // 光栅化位于视锥体内的遮挡体
+    for (EntityID entity : entities) {
+        const auto& meshComp = m_world->GetComponent<MeshRenderComponent>(entity);
+        if (!meshComp.occluder || !meshComp.visible || !meshComp.resourcesLoaded ||
+            !m_world->HasComponent<WorldBoundsComponent>(entity)) {
+            continue;
+        }
+        const auto& bounds = m_world->GetComponent<WorldBoundsComponent>(entity);
+        if (!bounds.valid || !frustum.IntersectsAABB(bounds.worldBounds)) {
+            continue;
+        }
+        
+        Ref<Mesh> occluderMesh = ResolveOccluderMesh(m_world, entity, meshComp);
+        if (!occluderMesh) {
+            continue;
+        }
+        const auto& transform = m_world->GetComponent<TransformComponent>(entity);
+        m_occlusionCuller.RasterizeMesh(*occluderMesh, transform.GetWorldMatrix());
+    }
+    
+    m_stats.occluderCount = m_occlusionCuller.GetStats().occluders;
+    if (m_stats.occluderCount == 0) {
+        return;
+    }
+    m_occlusionCuller.Finalize();
+    
+    // 测试其余实体（没有有效包围体的实体保守地保留）
+    const auto occludedBegin = std::remove_if(entities.begin(), entities.end(), [this](EntityID entity) {
+        if (!m_world->HasComponent<WorldBoundsComponent>(entity)) {
+            return false;
+        }
+        const auto& bounds = m_world->GetComponent<WorldBoundsComponent>(entity);
+        return bounds.valid && !m_occlusionCuller.IsVisible(bounds.worldBounds);
+    });
+    m_stats.occludedMeshes += static_cast<size_t>(std::distance(occludedBegin, entities.end()));
+    entities.erase(occludedBegin, entities.end());
+}
+
+void MeshRenderSystem::RequestTextureResidency(const std::vector<EntityID>& entities) {
+    TextureStreamer& streamer = TextureStreamer::GetInstance();
+    if (streamer.GetTextureCount() == 0 || !m_cameraSystem) {
+        return;
+    }
+    Camera* mainCamera = m_cameraSystem->GetMainCameraObject();
+    if (!mainCamera) {
+        return;
+    }
+    PROFILE_SCOPE("MeshRender.TextureResidency");
+    
+    const Vector3 cameraPos = mainCamera->GetPosition();
+    const bool perspective = mainCamera->GetProjectionType() == ProjectionType::Perspective;
+    const float tanHalfFov = std::tan(MathUtils::DegreesToRadians(mainCamera->GetFieldOfView() * 0.5f));
+    const float viewportHeight = static_cast<float>(m_renderer->GetHeight());
+    
+    for (EntityID entity : entities) {
+        const auto& meshComp = m_world->GetComponent<MeshRenderComponent>(entity);
+        if (!meshComp.visible || !meshComp.material || !m_world->HasComponent<WorldBoundsComponent>(entity)) {
+            continue;
+        }
+        const auto& bounds = m_world->GetComponent<WorldBoundsComponent>(entity);
+        if (!bounds.valid || ShouldCull(bounds.sphereCenter, bounds.sphereRadius)) {
+            continue;
+        }
+        
+        // 假设纹理 [0,1] UV 范围覆盖整个包围球直径；正交投影直接请求最精细级别
+        float screenPixels = std::numeric_limits<float>::max();
+        if (perspective) {
+            const float distance = std::max((bounds.sphereCenter - cameraPos).norm(), 1e-3f);
+            screenPixels = bounds.sphereRadius * viewportHeight / (distance * tanHalfFov);
+        }
+        meshComp.material->ForEachTexture([&streamer, screenPixels](const std::string&, const Ref<Texture>& texture) {
+            if (texture) {
+                streamer.RequestTexture(texture.get(), screenPixels);
+            }
+        });
+    }
+}
+
 bool MeshRenderSystem::ShouldCull(const Vector3& position, float radius) const {
     // ✅ 视锥体剔除优化（带近距离保护）
     if (!m_cameraSystem) {
@@ -2176,10 +2575,8 @@ bool MeshRenderSystem::ShouldCull(const Vector3& position, float radius) const {
     Vector3 cameraPos = mainCamera->GetPosition();
     float distanceToCamera = (position - cameraPos).norm();
     
-    // 定义不剔除球体半径（相机周围这个范围内的物体永远可见）
-    const float noCullRadius = 5.0f;  // 5米内的物体不剔除
-    
-    if (distanceToCamera < noCullRadius + radius) {
+    // 相机周围 kNoCullRadius 范围内的物体永远可见
+    if (distanceToCamera < kNoCullRadius + radius) {
         // 物体在相机附近，不剔除
         return false;
     }
@@ -2212,13 +2609,41 @@ void MeshRenderSystem::BatchCalculateLOD(const std::vector<EntityID>& entities,
         return;
     }
     
-    // ✅ 使用 LODSelector 批量计算 LOD
-    LODSelector::BatchCalculateLOD(entities, m_world, cameraPosition, frameId);
+    // ✅ 使用 LODSelector 批量计算 LOD（三角形预算模式或距离阈值 + 分帧更新）
+    {
+        PROFILE_SCOPE("LOD.Select");
+        LODSelectionStats selectionStats;
+        if (m_lodSelectionOptions.triangleBudget > 0) {
+            Camera* mainCamera = m_cameraSystem ? m_cameraSystem->GetMainCameraObject() : nullptr;
+            LODSelector::SelectLODWithTriangleBudget(entities, m_world, cameraPosition, frameId,
+                                                     m_lodSelectionOptions.triangleBudget,
+                                                     mainCamera ? &mainCamera->GetFrustum() : nullptr,
+                                                     &selectionStats);
+        } else {
+            // 屏幕空间误差模式需要视场角和视口高度，未显式设置时取主相机和渲染器的当前值
+            LODSelectionOptions selectionOptions = m_lodSelectionOptions;
+            if (selectionOptions.fovYDegrees <= 0.0f) {
+                Camera* mainCamera = m_cameraSystem ? m_cameraSystem->GetMainCameraObject() : nullptr;
+                if (mainCamera && mainCamera->GetProjectionType() == ProjectionType::Perspective) {
+                    selectionOptions.fovYDegrees = mainCamera->GetFieldOfView();
+                }
+            }
+            if (selectionOptions.viewportHeight <= 0.0f && m_renderer) {
+                selectionOptions.viewportHeight = static_cast<float>(m_renderer->GetHeight());
+            }
+            LODSelector::BatchCalculateLOD(entities, m_world, cameraPosition, frameId,
+                                           selectionOptions, &selectionStats);
+        }
+        m_stats.lodEvaluated = selectionStats.evaluated;
+        m_stats.lodDeferred = selectionStats.deferred;
+        m_stats.lodTriangleBudget = selectionStats.triangleBudget;
+        m_stats.lodSelectedTriangles = selectionStats.selectedTriangles;
+    }
     
     // ✅ 调试：记录LOD更新统计和距离信息（每100帧记录一次）
     static uint64_t debugCounter = 0;
     if (++debugCounter % 100 == 0 && !entities.empty()) {
-        size_t lod0Count = 0, lod1Count = 0, lod2Count = 0, lod3Count = 0, culledCount = 0;
+        size_t lod0Count = 0, lod1Count = 0, lod2Count = 0, lod3Count = 0, impostorCount = 0, culledCount = 0;
         float minDistance = std::numeric_limits<float>::max();
         float maxDistance = 0.0f;
         float avgDistance = 0.0f;
@@ -2240,22 +2665,24 @@ void MeshRenderSystem::BatchCalculateLOD(const std::vector<EntityID>& entities,
                     case LODLevel::LOD1: lod1Count++; break;
                     case LODLevel::LOD2: lod2Count++; break;
                     case LODLevel::LOD3: lod3Count++; break;
+                    case LODLevel::Impostor: impostorCount++; break;
                     case LODLevel::Culled: culledCount++; break;
                     default: break;
                 }
             }
         }
         
-        if (lod0Count + lod1Count + lod2Count + lod3Count + culledCount > 0) {
-            avgDistance /= static_cast<float>(lod0Count + lod1Count + lod2Count + lod3Count + culledCount);
+        const size_t lodEntityCount = lod0Count + lod1Count + lod2Count + lod3Count + impostorCount + culledCount;
+        if (lodEntityCount > 0) {
+            avgDistance /= static_cast<float>(lodEntityCount);
         }
         
         Logger::GetInstance().InfoFormat(
             "[MeshRenderSystem] LOD Stats (frame %llu, camera pos: %.1f,%.1f,%.1f): "
-            "LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, Culled=%zu | "
+            "LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, Impostor=%zu, Culled=%zu | "
             "Distance: min=%.1f, max=%.1f, avg=%.1f",
             frameId, cameraPosition.x(), cameraPosition.y(), cameraPosition.z(),
-            lod0Count, lod1Count, lod2Count, lod3Count, culledCount,
+            lod0Count, lod1Count, lod2Count, lod3Count, impostorCount, culledCount,
             minDistance, maxDistance, avgDistance
         );
     }
@@ -2300,6 +2727,7 @@ void ModelRenderSystem::OnDestroy() {
 }
 
 void ModelRenderSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.ModelRenderSystem");
     (void)deltaTime;
 
     if (!m_cameraSystem && m_world) {
@@ -2323,6 +2751,7 @@ void ModelRenderSystem::Update(float deltaTime) {
             auto lodEntities = m_world->Query<LODComponent, TransformComponent, ModelComponent>();
             if (!lodEntities.empty()) {
                 // 批量计算 LOD（使用 Model 的包围盒）
+                PROFILE_SCOPE("LOD.Select");
                 std::vector<EntityID> entityList(lodEntities.begin(), lodEntities.end());
                 LODSelector::BatchCalculateLODWithBounds(
                     entityList,
@@ -2396,6 +2825,7 @@ void ModelRenderSystem::SubmitRenderables() {
                 Camera* mainCamera = m_cameraSystem->GetMainCameraObject();
                 if (mainCamera) {
                     // 使用 LODFrustumCullingSystem 进行批量视锥体裁剪和 LOD 选择
+                    PROFILE_SCOPE("LOD.Cull");
                     std::vector<EntityID> entityList(entities.begin(), entities.end());
                     visibleEntitiesByLOD = LODFrustumCullingSystem::BatchCullAndSelectLODWithBounds(
                         entityList,
@@ -2467,6 +2897,7 @@ void ModelRenderSystem::SubmitRenderables() {
                         case LODLevel::LOD1: m_stats.lod1Count += visibleEntities.size(); break;
                         case LODLevel::LOD2: m_stats.lod2Count += visibleEntities.size(); break;
                         case LODLevel::LOD3: m_stats.lod3Count += visibleEntities.size(); break;
+                        case LODLevel::Impostor: m_stats.impostorCount += visibleEntities.size(); break;
                         default: break;
                     }
                     
@@ -2586,6 +3017,7 @@ void ModelRenderSystem::SubmitRenderables() {
                                 case LODLevel::LOD1: m_stats.lod1Count++; break;
                                 case LODLevel::LOD2: m_stats.lod2Count++; break;
                                 case LODLevel::LOD3: m_stats.lod3Count++; break;
+                                case LODLevel::Impostor: m_stats.impostorCount++; break;
                                 default: break;
                             }
                         }
@@ -2696,10 +3128,10 @@ void ModelRenderSystem::SubmitRenderables() {
                 if (m_stats.lodEnabledEntities > 0) {
                     Logger::GetInstance().InfoFormat(
                         "[ModelRenderSystem] LOD Instanced: %zu groups, %zu instances, %zu draw calls | "
-                        "LOD: enabled=%zu, LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, culled=%zu",
+                        "LOD: enabled=%zu, LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, impostor=%zu, culled=%zu",
                         lodStats.groupCount, lodStats.totalInstances, lodStats.drawCalls,
                         m_stats.lodEnabledEntities, m_stats.lod0Count, m_stats.lod1Count,
-                        m_stats.lod2Count, m_stats.lod3Count, m_stats.lodCulledCount
+                        m_stats.lod2Count, m_stats.lod3Count, m_stats.impostorCount, m_stats.lodCulledCount
                     );
                 } else {
                     Logger::GetInstance().InfoFormat(
@@ -2764,6 +3196,7 @@ void ModelRenderSystem::SubmitRenderables() {
                         case LODLevel::LOD1: m_stats.lod1Count++; break;
                         case LODLevel::LOD2: m_stats.lod2Count++; break;
                         case LODLevel::LOD3: m_stats.lod3Count++; break;
+                        case LODLevel::Impostor: m_stats.impostorCount++; break;
                         default: break;
                     }
                 }
@@ -2869,10 +3302,10 @@ void ModelRenderSystem::SubmitRenderables() {
             if (m_stats.lodEnabledEntities > 0) {
                 Logger::GetInstance().InfoFormat(
                     "[ModelRenderSystem] Submitted %zu models (culled: %zu, parts: %zu) | "
-                    "LOD: enabled=%zu, LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, culled=%zu",
+                    "LOD: enabled=%zu, LOD0=%zu, LOD1=%zu, LOD2=%zu, LOD3=%zu, impostor=%zu, culled=%zu",
                     m_stats.visibleModels, m_stats.culledModels, m_stats.submittedParts,
                     m_stats.lodEnabledEntities, m_stats.lod0Count, m_stats.lod1Count,
-                    m_stats.lod2Count, m_stats.lod3Count, m_stats.lodCulledCount
+                    m_stats.lod2Count, m_stats.lod3Count, m_stats.impostorCount, m_stats.lodCulledCount
                 );
             } else {
                 Logger::GetInstance().InfoFormat(
@@ -2915,6 +3348,7 @@ bool ModelRenderSystem::ShouldCull(const Vector3& position, float radius) const
 // ============================================================
 
 void SpriteAnimationSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.SpriteAnimationSystem");
     if (!m_world) {
         return;
     }
@@ -3199,6 +3633,7 @@ void SpriteRenderSystem::OnDestroy() {
 }
 
 void SpriteRenderSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.SpriteRenderSystem");
     (void)deltaTime;  // 未使用
     
     // ✅ 安全检查
@@ -3584,6 +4019,7 @@ void SpriteRenderSystem::Update(float deltaTime) {
 // ============================================================
 
 void CameraSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.CameraSystem");
     (void)deltaTime;  // 未使用
     
     if (!m_world) {
@@ -3805,6 +4241,7 @@ LightSystem::LightSystem(Renderer* renderer)
 }
 
 void LightSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.LightSystem");
     (void)deltaTime;  // 未使用
     
     // ✅ 安全检查（虽然当前不直接使用Renderer，但为未来扩展保留）
@@ -4011,11 +4448,14 @@ void UniformSystem::OnCreate(World* world) {
 void UniformSystem::OnDestroy() {
     m_cameraSystem = nullptr;
     m_lightSystem = nullptr;
+    m_frameUniformBuffer.reset();
+    m_frameWriter.reset();
     Logger::GetInstance().InfoFormat("[UniformSystem] UniformSystem destroyed");
     System::OnDestroy();
 }
 
 void UniformSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.UniformSystem");
     // ✅ 安全检查：系统是否启用、World和Renderer是否有效
     if (!m_enabled || !m_world || !m_renderer) {
         return;
@@ -4028,6 +4468,8 @@ void UniformSystem::Update(float deltaTime) {
     
     // 累计时间
     m_time += deltaTime;
+    m_frameData.time = m_time;
+    m_frameData.deltaTime = deltaTime;
     
     // 延迟获取系统（避免在 OnCreate 时获取）
     if (!m_cameraSystem) {
@@ -4046,6 +4488,9 @@ void UniformSystem::Update(float deltaTime) {
     
     // 设置时间 uniform
     SetTimeUniforms();
+    
+    // 上传帧数据 UBO（每帧一次）
+    UploadFrameUniforms();
 }
 
 void UniformSystem::SetCameraUniforms() {
@@ -4076,6 +4521,10 @@ void UniformSystem::SetCameraUniforms() {
     Vector3 cameraPos = camera->GetPosition();
     m_lastCameraPosition = cameraPos;
     
+    m_frameData.view = viewMatrix;
+    m_frameData.projection = projectionMatrix;
+    m_frameData.cameraPosition = cameraPos;
+    
     // ✅ 将相机矩阵存储到 RenderState，供 MeshRenderable::Render() 使用
     if (m_renderer) {
         auto renderState = m_renderer->GetRenderState();
@@ -4119,6 +4568,11 @@ void UniformSystem::SetCameraUniforms() {
             continue;
         }
         
+        if (UsesFrameUniformBlock(*shader)) {
+            processedShaders.insert(shaderPtr);
+            continue;
+        }
+        
         try {
             shader->Use();
             auto uniformMgr = shader->GetUniformManager();
@@ -4181,6 +4635,11 @@ void UniformSystem::SetCameraUniforms() {
                     continue;
                 }
 
+                if (UsesFrameUniformBlock(*shader)) {
+                    processedShaders.insert(shaderPtr);
+                    continue;
+                }
+
                 try {
                     shader->Use();
                     if (auto uniformMgr = shader->GetUniformManager()) {
@@ -4298,6 +4757,46 @@ void UniformSystem::SetLightUniforms() {
         legacyLightIntensity = m_lightSystem->GetPrimaryLightIntensity();
     }
 
+    // 填充帧数据块（超出上限的光源与逐着色器路径一致地被着色器忽略）
+    m_frameData.cameraPosition = cameraPos;
+    m_frameData.directionalCount = std::min(directionalCount, kFrameMaxDirectionalLights);
+    m_frameData.pointCount = std::min(pointCount, kFrameMaxPointLights);
+    m_frameData.spotCount = std::min(spotCount, kFrameMaxSpotLights);
+    m_frameData.ambientCount = std::min(ambientCount, kFrameMaxAmbientLights);
+    m_frameData.culledDirectional = snapshot.culledDirectional;
+    m_frameData.culledPoint = snapshot.culledPoint;
+    m_frameData.culledSpot = snapshot.culledSpot;
+    m_frameData.culledAmbient = snapshot.culledAmbient;
+    for (uint32_t i = 0; i < m_frameData.directionalCount; ++i) {
+        m_frameData.directionalDirections[i] = directionalDirections[i];
+        m_frameData.directionalColors[i] = directionalColors[i];
+    }
+    for (uint32_t i = 0; i < m_frameData.pointCount; ++i) {
+        m_frameData.pointPositions[i] = pointPositions[i];
+        m_frameData.pointColors[i] = pointColors[i];
+        const Vector3& att = pointAttenuations[i];
+        m_frameData.pointAttenuation[i] = Vector4(att.x(), att.y(), att.z(), 0.0f);
+    }
+    for (uint32_t i = 0; i < m_frameData.spotCount; ++i) {
+        m_frameData.spotPositions[i] = spotPositions[i];
+        m_frameData.spotColors[i] = spotColors[i];
+        m_frameData.spotDirections[i] = spotDirections[i];
+        const Vector3& att = spotAttenuations[i];
+        m_frameData.spotAttenuation[i] = Vector4(att.x(), att.y(), att.z(), spotInnerCos[i]);
+    }
+    for (uint32_t i = 0; i < m_frameData.ambientCount; ++i) {
+        m_frameData.ambientColors[i] = ambientColors[i];
+    }
+    m_frameData.legacyLightPosition = legacyLightPos;
+    m_frameData.legacyLightColor = legacyLightColor;
+    m_frameData.legacyLightIntensity = legacyLightIntensity;
+    if (hasAdvancedLights) {
+        m_frameData.legacyAmbientColor = Color::Black();
+    } else {
+        m_frameData.legacyAmbientColor = Color(legacyLightColor.r * 0.2f, legacyLightColor.g * 0.2f,
+                                               legacyLightColor.b * 0.2f, legacyLightColor.a);
+    }
+
     auto entities = m_world->Query<MeshRenderComponent>();
     std::unordered_set<Shader*> processedShaders;
 
@@ -4325,6 +4824,11 @@ void UniformSystem::SetLightUniforms() {
             continue;
         }
 
+        if (UsesFrameUniformBlock(*shader)) {
+            processedShaders.insert(shaderPtr);
+            continue;
+        }
+
         try {
             shader->Use();
             auto uniformMgr = shader->GetUniformManager();
@@ -4468,6 +4972,11 @@ void UniformSystem::SetTimeUniforms() {
             continue;
         }
         
+        if (UsesFrameUniformBlock(*shader)) {
+            processedShaders.insert(shaderPtr);
+            continue;
+        }
+        
         try {
             shader->Use();
             auto uniformMgr = shader->GetUniformManager();
@@ -4492,6 +5001,21 @@ void UniformSystem::SetTimeUniforms() {
     }
 }
 
+void UniformSystem::UploadFrameUniforms() {
+    if (!m_frameWriter) {
+        m_frameWriter = std::make_unique<Std140Writer>(GetFrameUniformLayout());
+    }
+    if (!m_frameUniformBuffer) {
+        m_frameUniformBuffer = std::make_unique<UniformBuffer>();
+    }
+    
+    PackFrameUniforms(m_frameData, *m_frameWriter);
+    
+    RenderState* renderState = m_renderer ? m_renderer->GetRenderState().get() : nullptr;
+    m_frameUniformBuffer->Upload(m_frameWriter->GetData(), m_frameWriter->GetSize(), renderState);
+    m_frameUniformBuffer->BindBase(kFrameUniformBinding);
+}
+
 // ============================================================
 // WindowSystem 实现
 // ============================================================
@@ -4626,6 +5150,7 @@ void WindowSystem::OnWindowResized(int width, int height) {
 // ============================================================
 
 void GeometrySystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.GeometrySystem");
     (void)deltaTime;  // 未使用
     
     if (!m_world) {
@@ -4735,6 +5260,7 @@ ResourceCleanupSystem::ResourceCleanupSystem(float cleanupIntervalSeconds, uint3
 }
 
 void ResourceCleanupSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ECS.ResourceCleanupSystem");
     if (!m_enabled) {
         return;
     }
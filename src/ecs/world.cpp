@@ -22,6 +22,7 @@
 #include "render/ecs/components.h"
 #include "render/logger.h"
 #include "render/resource_manager.h"
+#include "render/debug/profiler.h"
 #include <algorithm>
 
 namespace Render {
@@ -185,6 +186,8 @@ void World::Update(float deltaTime) {
         return;
     }
     
+    PROFILE_SCOPE("ECS.World.Update");
+
     // 记录开始时间
     auto startTime = std::chrono::high_resolution_clock::now();
     
@@ -205,9 +205,9 @@ static btCollisionShape* CreateBaseShape(const ColliderComponent& collider) {
             btConvexHullShape* hullShape = new btConvexHullShape();
             
             // 访问网格顶点数据
-            collider.meshData->AccessVertices([&](const std::vector<Vertex>& vertices) {
-                for (const auto& vertex : vertices) {
-                    btVector3 point = ToBullet(vertex.position);
+            collider.meshData->AccessPositions([&](const Mesh::PositionView& positions) {
+                for (size_t i = 0; i < positions.size(); ++i) {
+                    btVector3 point = ToBullet(positions[i]);
                     hullShape->addPoint(point, false);
                 }
             });
@@ -230,10 +230,10 @@ static btCollisionShape* CreateBaseShape(const ColliderComponent& collider) {
             std::vector<btVector3> vertices;
             std::vector<int> indices;
             
-            collider.meshData->AccessVertices([&](const std::vector<Vertex>& meshVertices) {
-                vertices.reserve(meshVertices.size());
-                for (const auto& v : meshVertices) {
-                    vertices.push_back(ToBullet(v.position));
+            collider.meshData->AccessPositions([&](const Mesh::PositionView& positions) {
+                vertices.reserve(positions.size());
+                for (size_t i = 0; i < positions.size(); ++i) {
+                    vertices.push_back(ToBullet(positions[i]));
                 }
             });
             
@@ -282,6 +282,8 @@ bool Framebuffer::CreateTextureAttachment(const FramebufferAttachment& attachmen
             format = GL_DEPTH_STENCIL;
             type = GL_UNSIGNED_INT_24_8;
             break;
+        default:
+            break;   // 块压缩格式不能作为附件，保持 RGBA 默认值
     }
     
     // 创建纹理
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/hdri_cache.h"
+#include "render/file_utils.h"
+#include "render/logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace Render {
+
+namespace {
+
+constexpr char kMagic[4] = {'R', 'E', 'N', 'V'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kMaxLevelCount = 16;
+constexpr uint32_t kMaxResolution = 16384;
+
+constexpr uint32_t kFlagPrefiltered = 1u << 0;
+constexpr uint32_t kFlagIrradianceSH = 1u << 1;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t resolution;
+    uint32_t levelCount;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 32, "HDRI cache header layout changed");
+
+constexpr size_t kSHFloatCount = 27;
+
+template<typename T>
+uint64_t HashValue(const T& value, uint64_t hash) {
+    return FileUtils::HashBytes(&value, sizeof(T), hash);
+}
+
+/**
+ * @brief 按基础分辨率与级别数推导各级别布局，返回像素总浮点数
+ */
+size_t BuildLevels(int resolution, uint32_t levelCount, std::vector<HDRCubemapLevel>& outLevels) {
+    outLevels.resize(levelCount);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        const int levelResolution = std::max(1, resolution >> i);
+        outLevels[i].resolution = levelResolution;
+        outLevels[i].offset = offset;
+        offset += static_cast<size_t>(levelResolution) * levelResolution * 6 * 4;
+    }
+    return offset;
+}
+
+} // namespace
+
+HDRICache& HDRICache::GetInstance() {
+    static HDRICache instance;
+    return instance;
+}
+
+void HDRICache::SetCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_directoryMutex);
+    m_directory = directory;
+}
+
+std::string HDRICache::GetCacheDirectory() const {
+    std::lock_guard<std::mutex> lock(m_directoryMutex);
+    return m_directory;
+}
+
+uint64_t HDRICache::BuildKey(uint64_t sourceHash, const HDRCubemapOptions& options) {
+    uint64_t hash = HashValue(kFormatVersion, FileUtils::kHashSeed);
+    hash = HashValue(sourceHash, hash);
+    hash = HashValue(static_cast<int32_t>(options.resolution), hash);
+    // 按 Convert 实际输出的级数计算，0 与 1 级结果相同，应命中同一缓存
+    const uint32_t levelCount = HDRIConverter::GetSpecularLevelCount(options);
+    hash = HashValue(levelCount, hash);
+    // 未预过滤时采样数不影响结果，避免无谓的缓存失效
+    hash = HashValue(levelCount > 1 ? std::max(1u, options.specularSampleCount) : 0u, hash);
+    hash = HashValue(static_cast<uint8_t>(options.computeIrradianceSH), hash);
+    return hash;
+}
+
+std::string HDRICache::GetCachePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.envc", static_cast<unsigned long long>(key));
+    return FileUtils::CombinePaths(GetCacheDirectory(), name);
+}
+
+// ============================================================================
+// 读写
+// ============================================================================
+
+bool HDRICache::Load(uint64_t key, HDRCubemapData& outData) {
+    outData = HDRCubemapData{};
+    
+    if (!IsEnabled()) {
+        return false;
+    }
+    
+    const std::string path = GetCachePath(key);
+    MappedFile file;
+    if (!file.Open(path)) {
+        m_misses++;
+        return false;
+    }
+    
+    const uint8_t* data = file.GetData();
+    const size_t size = file.GetSize();
+    
+    FileHeader header{};
+    if (size < sizeof(FileHeader) + kSHFloatCount * sizeof(float)) {
+        LOG_WARNING_F("HDRICache: Truncated cache file %s", path.c_str());
+        m_misses++;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kFormatVersion ||
+        header.key != key ||
+        header.resolution == 0 || header.resolution > kMaxResolution ||
+        header.levelCount == 0 || header.levelCount > kMaxLevelCount) {
+        LOG_WARNING_F("HDRICache: Invalid or stale cache file %s", path.c_str());
+        m_misses++;
+        return false;
+    }
+    
+    HDRCubemapData result;
+    result.resolution = static_cast<int>(header.resolution);
+    result.prefiltered = (header.flags & kFlagPrefiltered) != 0;
+    result.hasIrradianceSH = (header.flags & kFlagIrradianceSH) != 0;
+    const size_t floatCount = BuildLevels(result.resolution, header.levelCount, result.levels);
+    
+    const size_t dataStart = sizeof(FileHeader) + kSHFloatCount * sizeof(float);
+    if (size - dataStart != floatCount * sizeof(float)) {
+        LOG_WARNING_F("HDRICache: Size mismatch in %s", path.c_str());
+        m_misses++;
+        return false;
+    }
+    
+    float sh[kSHFloatCount];
+    std::memcpy(sh, data + sizeof(FileHeader), sizeof(sh));
+    for (size_t i = 0; i < result.irradianceSH.size(); ++i) {
+        result.irradianceSH[i] = Vector3(sh[i * 3], sh[i * 3 + 1], sh[i * 3 + 2]);
+    }
+    
+    result.pixels.resize(floatCount);
+    std::memcpy(result.pixels.data(), data + dataStart, floatCount * sizeof(float));
+    
+    outData = std::move(result);
+    m_hits++;
+    return true;
+}
+
+bool HDRICache::Store(uint64_t key, const HDRCubemapData& data) {
+    if (!IsEnabled() || !data.IsValid() || data.levels.size() > kMaxLevelCount ||
+        data.resolution > static_cast<int>(kMaxResolution)) {
+        return false;
+    }
+    
+    // 级别布局必须与文件格式推导的布局一致（Load 不保存每级偏移）
+    std::vector<HDRCubemapLevel> expected;
+    const size_t floatCount = BuildLevels(data.resolution, static_cast<uint32_t>(data.levels.size()), expected);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (expected[i].resolution != data.levels[i].resolution || expected[i].offset != data.levels[i].offset) {
+            LOG_WARNING_F("HDRICache: Unexpected level layout at level %zu, skipping store", i);
+            return false;
+        }
+    }
+    if (data.pixels.size() != floatCount) {
+        LOG_WARNING("HDRICache: Pixel data size mismatch, skipping store");
+        return false;
+    }
+    
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.key = key;
+    header.resolution = static_cast<uint32_t>(data.resolution);
+    header.levelCount = static_cast<uint32_t>(data.levels.size());
+    header.flags = (data.prefiltered ? kFlagPrefiltered : 0u) | (data.hasIrradianceSH ? kFlagIrradianceSH : 0u);
+    
+    float sh[kSHFloatCount] = {};
+    if (data.hasIrradianceSH) {
+        for (size_t i = 0; i < data.irradianceSH.size(); ++i) {
+            sh[i * 3] = data.irradianceSH[i].x();
+            sh[i * 3 + 1] = data.irradianceSH[i].y();
+            sh[i * 3 + 2] = data.irradianceSH[i].z();
+        }
+    }
+    
+    const std::string path = GetCachePath(key);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    
+    // 先写临时文件再重命名，避免其他线程/进程读到写了一半的文件
+    std::ostringstream tempSuffix;
+    tempSuffix << ".tmp" << std::this_thread::get_id();
+    const std::string tempPath = path + tempSuffix.str();
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            LOG_WARNING_F("HDRICache: Failed to open %s for writing", tempPath.c_str());
+            return false;
+        }
+        
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(sh), sizeof(sh));
+        out.write(reinterpret_cast<const char*>(data.pixels.data()),
+                  static_cast<std::streamsize>(data.pixels.size() * sizeof(float)));
+        if (!out.good()) {
+            LOG_WARNING_F("HDRICache: Failed to write %s", tempPath.c_str());
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        // Windows 上目标已存在时重命名可能失败（其他线程已写入相同内容）
+        std::filesystem::remove(tempPath, ec);
+        return std::filesystem::exists(path);
+    }
+    
+    m_writes++;
+    LOG_INFO_F("HDRICache: Stored %dx%d cubemap (%zu levels) to %s (%zu bytes)",
+               data.resolution, data.resolution, data.levels.size(), path.c_str(),
+               data.pixels.size() * sizeof(float));
+    return true;
+}
+
+size_t HDRICache::ClearDiskCache() {
+    const std::string directory = GetCacheDirectory();
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        return 0;
+    }
+    
+    size_t removed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".envc") {
+            if (std::filesystem::remove(entry.path(), ec)) {
+                removed++;
+            }
+        }
+    }
+    return removed;
+}
+
+HDRICache::Stats HDRICache::GetStats() const {
+    Stats stats;
+    stats.hits = m_hits.load();
+    stats.misses = m_misses.load();
+    stats.writes = m_writes.load();
+    return stats;
+}
+
+void HDRICache::ResetStats() {
+    m_hits = 0;
+    m_misses = 0;
+    m_writes = 0;
+}
+
+} // namespace Render
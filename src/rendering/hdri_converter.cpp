@@ -0,0 +1,785 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/hdri_converter.h"
+#include "render/hdri_cache.h"
+#include "render/file_utils.h"
+#include "render/logger.h"
+#include "render/math_utils.h"
+#include "render/task_scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE__)
+#include <immintrin.h>
+#endif
+
+namespace Render {
+
+namespace {
+
+constexpr int kMaxResolution = 16384;
+constexpr int kMaxSourceWidth = 16384;    ///< 等距柱状源图的最大宽度（16K）
+constexpr int kMaxSourceHeight = 8192;
+constexpr int kMaxRLEWidth = 0x7fff;
+constexpr int kMaxRunLength = 127;
+constexpr size_t kMaxHeaderLine = 1024;
+
+bool Fail(std::string* error, const std::string& message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+// ============================================================================
+// RGBE
+// ============================================================================
+
+bool ReadLine(const uint8_t* data, size_t size, size_t& pos, std::string& line) {
+    line.clear();
+    while (pos < size) {
+        const char c = static_cast<char>(data[pos++]);
+        if (c == '\n') {
+            return true;
+        }
+        if (line.size() >= kMaxHeaderLine) {
+            return false;
+        }
+        line.push_back(c);
+    }
+    return false;
+}
+
+inline void RGBEToFloat(const uint8_t* rgbe, float* out) {
+    if (rgbe[3] == 0) {
+        out[0] = out[1] = out[2] = 0.0f;
+    } else {
+        const float scale = std::ldexp(1.0f, static_cast<int>(rgbe[3]) - (128 + 8));
+        out[0] = rgbe[0] * scale;
+        out[1] = rgbe[1] * scale;
+        out[2] = rgbe[2] * scale;
+    }
+    out[3] = 1.0f;
+}
+
+inline void FloatToRGBE(const float* rgb, uint8_t* out) {
+    const float r = std::max(rgb[0], 0.0f);
+    const float g = std::max(rgb[1], 0.0f);
+    const float b = std::max(rgb[2], 0.0f);
+    const float v = std::max(r, std::max(g, b));
+    if (!(v >= 1e-32f)) {
+        out[0] = out[1] = out[2] = out[3] = 0;
+        return;
+    }
+    int exponent = 0;
+    const float scale = std::frexp(v, &exponent) * 256.0f / v;
+    out[0] = static_cast<uint8_t>(std::min(r * scale, 255.0f));
+    out[1] = static_cast<uint8_t>(std::min(g * scale, 255.0f));
+    out[2] = static_cast<uint8_t>(std::min(b * scale, 255.0f));
+    out[3] = static_cast<uint8_t>(std::clamp(exponent + 128, 0, 255));
+}
+
+/**
+ * @brief 解码一条扫描线到交错 RGBE
+ * 
+ * 新式游程编码以 (2, 2, 宽度高字节, 宽度低字节) 开头，随后 4 个通道依次编码：
+ * 计数 > 128 表示重复下一字节 (计数 - 128) 次，否则表示随后有计数个字面字节。
+ */
+// 一行扫描线编码后的最小字节数：游程编码为 4 字节行头 + 每通道每 127 像素至少 2 字节，否则为原始 RGBE
+size_t MinScanlineBytes(int width) {
+    if (width >= 8 && width <= kMaxRLEWidth) {
+        const size_t runs = (static_cast<size_t>(width) + kMaxRunLength - 1) / kMaxRunLength;
+        return 4 + runs * 2 * 4;
+    }
+    return static_cast<size_t>(width) * 4;
+}
+
+bool DecodeScanline(const uint8_t* data, size_t size, size_t& pos, int width, uint8_t* rgbe) {
+    const bool rle = width >= 8 && width <= kMaxRLEWidth && pos + 4 <= size &&
+                     data[pos] == 2 && data[pos + 1] == 2 && (data[pos + 2] & 0x80) == 0;
+    if (!rle) {
+        const size_t bytes = static_cast<size_t>(width) * 4;
+        if (size - pos < bytes) {
+            return false;
+        }
+        std::memcpy(rgbe, data + pos, bytes);
+        pos += bytes;
+        return true;
+    }
+    
+    if (((static_cast<int>(data[pos + 2]) << 8) | data[pos + 3]) != width) {
+        return false;
+    }
+    pos += 4;
+    
+    for (int channel = 0; channel < 4; ++channel) {
+        int x = 0;
+        while (x < width) {
+            if (pos >= size) {
+                return false;
+            }
+            int count = data[pos++];
+            if (count > 128) {
+                count -= 128;
+                if (x + count > width || pos >= size) {
+                    return false;
+                }
+                const uint8_t value = data[pos++];
+                for (int i = 0; i < count; ++i) {
+                    rgbe[(x + i) * 4 + channel] = value;
+                }
+            } else {
+                if (count == 0 || x + count > width || size - pos < static_cast<size_t>(count)) {
+                    return false;
+                }
+                for (int i = 0; i < count; ++i) {
+                    rgbe[(x + i) * 4 + channel] = data[pos++];
+                }
+            }
+            x += count;
+        }
+    }
+    return true;
+}
+
+void EncodeChannel(const uint8_t* rgbe, int width, int channel, std::vector<uint8_t>& out) {
+    auto runLength = [&](int x) {
+        const uint8_t value = rgbe[x * 4 + channel];
+        int run = 1;
+        while (x + run < width && run < 127 && rgbe[(x + run) * 4 + channel] == value) {
+            run++;
+        }
+        return run;
+    };
+    
+    int x = 0;
+    while (x < width) {
+        const int run = runLength(x);
+        if (run >= 4) {
+            out.push_back(static_cast<uint8_t>(128 + run));
+            out.push_back(rgbe[x * 4 + channel]);
+            x += run;
+            continue;
+        }
+        
+        // 字面段延伸到下一个长度 >= 4 的游程之前（最多 128 字节）
+        const int start = x;
+        while (x < width && x - start < 128 && (x == start || runLength(x) < 4)) {
+            x++;
+        }
+        out.push_back(static_cast<uint8_t>(x - start));
+        for (int i = start; i < x; ++i) {
+            out.push_back(rgbe[i * 4 + channel]);
+        }
+    }
+}
+
+// ============================================================================
+// 采样
+// ============================================================================
+
+/**
+ * @brief 等距柱状投影双线性采样（RGBA32F，水平环绕，垂直钳制）
+ */
+inline void SampleEquirect(const float* pixels, int width, int height, float u, float v, float* out) {
+    const float fx = u * width - 0.5f;
+    const float fy = v * height - 0.5f;
+    const float x0f = std::floor(fx);
+    const float y0f = std::floor(fy);
+    const float tx = fx - x0f;
+    const float ty = fy - y0f;
+    
+    int x0 = static_cast<int>(x0f) % width;
+    if (x0 < 0) {
+        x0 += width;
+    }
+    const int x1 = x0 + 1 == width ? 0 : x0 + 1;
+    const int y0 = std::clamp(static_cast<int>(y0f), 0, height - 1);
+    const int y1 = std::clamp(static_cast<int>(y0f) + 1, 0, height - 1);
+    
+    const float* row0 = pixels + static_cast<size_t>(y0) * width * 4;
+    const float* row1 = pixels + static_cast<size_t>(y1) * width * 4;
+    
+#if defined(__SSE__)
+    const __m128 p00 = _mm_loadu_ps(row0 + x0 * 4);
+    const __m128 p01 = _mm_loadu_ps(row0 + x1 * 4);
+    const __m128 p10 = _mm_loadu_ps(row1 + x0 * 4);
+    const __m128 p11 = _mm_loadu_ps(row1 + x1 * 4);
+    const __m128 wx = _mm_set1_ps(tx);
+    const __m128 top = _mm_add_ps(p00, _mm_mul_ps(_mm_sub_ps(p01, p00), wx));
+    const __m128 bottom = _mm_add_ps(p10, _mm_mul_ps(_mm_sub_ps(p11, p10), wx));
+    _mm_storeu_ps(out, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(ty))));
+#else
+    for (int c = 0; c < 4; ++c) {
+        const float top = row0[x0 * 4 + c] + (row0[x1 * 4 + c] - row0[x0 * 4 + c]) * tx;
+        const float bottom = row1[x0 * 4 + c] + (row1[x1 * 4 + c] - row1[x0 * 4 + c]) * tx;
+        out[c] = top + (bottom - top) * ty;
+    }
+#endif
+}
+
+/**
+ * @brief 等距柱状投影降采样金字塔（2x2 盒式滤波），供预过滤按样本立体角选择采样级别
+ */
+struct EquirectPyramid {
+    struct Level {
+        int width = 0;
+        int height = 0;
+        std::vector<float> pixels;
+    };
+    
+    const HDRImage* base = nullptr;
+    std::vector<Level> levels;    ///< levels[i] 对应金字塔第 i + 1 级
+    
+    void Build(const HDRImage& image) {
+        base = &image;
+        levels.clear();
+        int width = image.width;
+        int height = image.height;
+        const float* src = image.pixels.data();
+        while (width > 1 || height > 1) {
+            Level level;
+            level.width = std::max(1, width / 2);
+            level.height = std::max(1, height / 2);
+            level.pixels.resize(static_cast<size_t>(level.width) * level.height * 4);
+            for (int y = 0; y < level.height; ++y) {
+                const int sy0 = std::min(y * 2, height - 1);
+                const int sy1 = std::min(y * 2 + 1, height - 1);
+                for (int x = 0; x < level.width; ++x) {
+                    const int sx0 = std::min(x * 2, width - 1);
+                    const int sx1 = std::min(x * 2 + 1, width - 1);
+                    float* dst = level.pixels.data() + (static_cast<size_t>(y) * level.width + x) * 4;
+                    for (int c = 0; c < 4; ++c) {
+                        dst[c] = 0.25f * (src[(static_cast<size_t>(sy0) * width + sx0) * 4 + c] +
+                                          src[(static_cast<size_t>(sy0) * width + sx1) * 4 + c] +
+                                          src[(static_cast<size_t>(sy1) * width + sx0) * 4 + c] +
+                                          src[(static_cast<size_t>(sy1) * width + sx1) * 4 + c]);
+                    }
+                }
+            }
+            levels.push_back(std::move(level));
+            width = levels.back().width;
+            height = levels.back().height;
+            src = levels.back().pixels.data();
+        }
+    }
+    
+    [[nodiscard]] int GetLevelCount() const { return static_cast<int>(levels.size()) + 1; }
+    
+    void SampleLevel(int level, float u, float v, float* out) const {
+        if (level == 0) {
+            SampleEquirect(base->pixels.data(), base->width, base->height, u, v, out);
+        } else {
+            const Level& l = levels[level - 1];
+            SampleEquirect(l.pixels.data(), l.width, l.height, u, v, out);
+        }
+    }
+    
+    /**
+     * @brief 在两个相邻级别间线性插值采样
+     */
+    void Sample(float lod, float u, float v, float* out) const {
+        lod = std::clamp(lod, 0.0f, static_cast<float>(GetLevelCount() - 1));
+        const int l0 = static_cast<int>(lod);
+        const float t = lod - static_cast<float>(l0);
+        SampleLevel(l0, u, v, out);
+        if (t > 0.0f && l0 + 1 < GetLevelCount()) {
+            float next[4];
+            SampleLevel(l0 + 1, u, v, next);
+            for (int c = 0; c < 4; ++c) {
+                out[c] += (next[c] - out[c]) * t;
+            }
+        }
+    }
+};
+
+// ============================================================================
+// 预过滤
+// ============================================================================
+
+inline float RadicalInverse(uint32_t bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return static_cast<float>(bits) * 2.3283064365386963e-10f;
+}
+
+/**
+ * @brief 切线空间中的 GGX 重要性样本（N = V = +Z），附带权重与采样源级别
+ */
+struct PrefilterSample {
+    Vector3 direction;
+    float weight;
+    float sourceLod;
+};
+
+std::vector<PrefilterSample> BuildPrefilterSamples(float roughness, uint32_t sampleCount, int sourceWidth, int sourceHeight) {
+    std::vector<PrefilterSample> samples;
+    samples.reserve(sampleCount);
+    
+    const float alpha = roughness * roughness;
+    const float alpha2 = alpha * alpha;
+    // 赤道处等距柱状投影像素立体角（两极更小，按赤道估计会略偏模糊，但不会欠采样）
+    const float texelSolidAngle = 2.0f * MathUtils::PI * MathUtils::PI /
+                                  (static_cast<float>(sourceWidth) * static_cast<float>(sourceHeight));
+    
+    for (uint32_t i = 0; i < sampleCount; ++i) {
+        const float xi0 = (static_cast<float>(i) + 0.5f) / static_cast<float>(sampleCount);
+        const float xi1 = RadicalInverse(i);
+        const float phi = MathUtils::TWO_PI * xi0;
+        const float cosTheta = std::sqrt((1.0f - xi1) / (1.0f + (alpha2 - 1.0f) * xi1));
+        const float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+        
+        // L = reflect(-V, H)，V = N = +Z
+        const Vector3 direction(2.0f * cosTheta * sinTheta * std::cos(phi),
+                                2.0f * cosTheta * sinTheta * std::sin(phi),
+                                2.0f * cosTheta * cosTheta - 1.0f);
+        const float nDotL = direction.z();
+        if (nDotL <= 0.0f) {
+            continue;
+        }
+        
+        // pdf(L) = D(H) * NdotH / (4 * VdotH) = D(H) / 4
+        const float denom = cosTheta * cosTheta * (alpha2 - 1.0f) + 1.0f;
+        const float d = alpha2 / (MathUtils::PI * denom * denom);
+        const float pdf = std::max(d * 0.25f, 1e-6f);
+        const float sampleSolidAngle = 1.0f / (static_cast<float>(sampleCount) * pdf);
+        const float lod = std::max(0.0f, 0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f);
+        
+        samples.push_back({direction, nDotL, lod});
+    }
+    return samples;
+}
+
+// ============================================================================
+// 球谐
+// ============================================================================
+
+inline void EvaluateSHBasis(const Vector3& n, float* basis) {
+    const float x = n.x();
+    const float y = n.y();
+    const float z = n.z();
+    basis[0] = 0.282095f;
+    basis[1] = 0.488603f * y;
+    basis[2] = 0.488603f * z;
+    basis[3] = 0.488603f * x;
+    basis[4] = 1.092548f * x * y;
+    basis[5] = 1.092548f * y * z;
+    basis[6] = 0.315392f * (3.0f * z * z - 1.0f);
+    basis[7] = 1.092548f * x * z;
+    basis[8] = 0.546274f * (x * x - y * y);
+}
+
+size_t FaceFloatCount(int resolution) {
+    return static_cast<size_t>(resolution) * resolution * 4;
+}
+
+} // namespace
+
+// ============================================================================
+// Radiance .hdr
+// ============================================================================
+
+bool HDRIConverter::DecodeRadiance(const uint8_t* data, size_t size, HDRImage& outImage, std::string* error) {
+    outImage = HDRImage{};
+    if (!data || size == 0) {
+        return Fail(error, "empty input");
+    }
+    
+    size_t pos = 0;
+    std::string line;
+    if (!ReadLine(data, size, pos, line) || line.rfind("#?", 0) != 0) {
+        return Fail(error, "missing #? signature");
+    }
+    
+    // 头部以空行结束；只支持 RGBE（XYZE 需要色彩空间转换，不在此处理）
+    while (true) {
+        if (!ReadLine(data, size, pos, line)) {
+            return Fail(error, "truncated header");
+        }
+        if (line.empty()) {
+            break;
+        }
+        if (line.rfind("FORMAT=", 0) == 0 && line != "FORMAT=32-bit_rle_rgbe") {
+            return Fail(error, "unsupported format: " + line.substr(7));
+        }
+    }
+    
+    if (!ReadLine(data, size, pos, line)) {
+        return Fail(error, "missing resolution line");
+    }
+    int width = 0;
+    int height = 0;
+    char ySign = 0;
+    if (std::sscanf(line.c_str(), "%cY %d +X %d", &ySign, &height, &width) != 3 || (ySign != '-' && ySign != '+')) {
+        return Fail(error, "unsupported resolution line: " + line);
+    }
+    if (width <= 0 || height <= 0 || width > kMaxSourceWidth || height > kMaxSourceHeight) {
+        return Fail(error, "invalid image size");
+    }
+    // 先确认剩余数据至少能容纳 height 行，避免伪造的头部触发巨大的分配
+    if (size - pos < MinScanlineBytes(width) * static_cast<size_t>(height)) {
+        return Fail(error, "truncated pixel data");
+    }
+    
+    HDRImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    
+    std::vector<uint8_t> scanline(static_cast<size_t>(width) * 4);
+    for (int row = 0; row < height; ++row) {
+        if (!DecodeScanline(data, size, pos, width, scanline.data())) {
+            return Fail(error, "corrupted scanline " + std::to_string(row));
+        }
+        // "+Y" 表示自下而上存储，统一翻转为第 0 行在顶部
+        const int dstRow = ySign == '-' ? row : height - 1 - row;
+        float* dst = image.pixels.data() + static_cast<size_t>(dstRow) * width * 4;
+        for (int x = 0; x < width; ++x) {
+            RGBEToFloat(scanline.data() + x * 4, dst + x * 4);
+        }
+    }
+    
+    outImage = std::move(image);
+    return true;
+}
+
+bool HDRIConverter::LoadRadianceFile(const std::string& filepath, HDRImage& outImage, std::string* error) {
+    MappedFile file;
+    if (!file.Open(filepath)) {
+        outImage = HDRImage{};
+        return Fail(error, "cannot open " + filepath);
+    }
+    return DecodeRadiance(file.GetData(), file.GetSize(), outImage, error);
+}
+
+std::vector<uint8_t> HDRIConverter::EncodeRadiance(const HDRImage& image) {
+    std::vector<uint8_t> out;
+    if (!image.IsValid()) {
+        return out;
+    }
+    
+    char header[128];
+    const int headerSize = std::snprintf(header, sizeof(header),
+                                         "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y %d +X %d\n",
+                                         image.height, image.width);
+    out.insert(out.end(), header, header + headerSize);
+    out.reserve(out.size() + static_cast<size_t>(image.width) * image.height * 4);
+    
+    const bool rle = image.width >= 8 && image.width <= kMaxRLEWidth;
+    std::vector<uint8_t> scanline(static_cast<size_t>(image.width) * 4);
+    for (int row = 0; row < image.height; ++row) {
+        const float* src = image.pixels.data() + static_cast<size_t>(row) * image.width * 4;
+        for (int x = 0; x < image.width; ++x) {
+            FloatToRGBE(src + x * 4, scanline.data() + x * 4);
+        }
+        if (!rle) {
+            out.insert(out.end(), scanline.begin(), scanline.end());
+            continue;
+        }
+        out.push_back(2);
+        out.push_back(2);
+        out.push_back(static_cast<uint8_t>(image.width >> 8));
+        out.push_back(static_cast<uint8_t>(image.width & 0xff));
+        for (int channel = 0; channel < 4; ++channel) {
+            EncodeChannel(scanline.data(), image.width, channel, out);
+        }
+    }
+    return out;
+}
+
+// ============================================================================
+// 投影
+// ============================================================================
+
+void HDRIConverter::DirectionToEquirect(const Vector3& direction, float& u, float& v) {
+    u = 0.5f + std::atan2(direction.z(), direction.x()) / MathUtils::TWO_PI;
+    v = std::acos(std::clamp(direction.y(), -1.0f, 1.0f)) / MathUtils::PI;
+}
+
+Vector3 HDRIConverter::CubemapTexelDirection(int face, int x, int y, int resolution) {
+    const float u = 2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(resolution) - 1.0f;
+    const float v = 2.0f * (static_cast<float>(y) + 0.5f) / static_cast<float>(resolution) - 1.0f;
+    Vector3 direction;
+    switch (face) {
+        case 0:  direction = Vector3(1.0f, -v, -u); break;   // +X
+        case 1:  direction = Vector3(-1.0f, -v, u); break;   // -X
+        case 2:  direction = Vector3(u, 1.0f, v); break;     // +Y
+        case 3:  direction = Vector3(u, -1.0f, -v); break;   // -Y
+        case 4:  direction = Vector3(u, -v, 1.0f); break;    // +Z
+        default: direction = Vector3(-u, -v, -1.0f); break;  // -Z
+    }
+    return direction.normalized();
+}
+
+void HDRIConverter::SampleBilinear(const HDRImage& image, float u, float v, float* outRGBA) {
+    SampleEquirect(image.pixels.data(), image.width, image.height, u, v, outRGBA);
+}
+
+void HDRIConverter::ConvertToCubemap(const HDRImage& image, int resolution, std::vector<float>& outPixels) {
+    outPixels.assign(FaceFloatCount(resolution) * 6, 0.0f);
+    
+    float* dst = outPixels.data();
+    TaskScheduler::GetInstance().ParallelFor(static_cast<size_t>(resolution) * 6, [&](size_t index) {
+        const int face = static_cast<int>(index / resolution);
+        const int y = static_cast<int>(index % resolution);
+        float* row = dst + face * FaceFloatCount(resolution) + static_cast<size_t>(y) * resolution * 4;
+        for (int x = 0; x < resolution; ++x) {
+            float u = 0.0f;
+            float v = 0.0f;
+            DirectionToEquirect(CubemapTexelDirection(face, x, y, resolution), u, v);
+            SampleEquirect(image.pixels.data(), image.width, image.height, u, v, row + x * 4);
+        }
+    }, TaskPriority::Normal, "HDRICubemapRow");
+}
+
+// ============================================================================
+// 辐照度球谐
+// ============================================================================
+
+std::array<Vector3, 9> HDRIConverter::ComputeIrradianceSH(const std::vector<float>& facePixels, int resolution) {
+    std::array<Vector3, 9> result;
+    result.fill(Vector3::Zero());
+    if (resolution <= 0 || facePixels.size() < FaceFloatCount(resolution) * 6) {
+        return result;
+    }
+    
+    // 每行独立累加（双精度）后串行归约，结果与线程数无关
+    struct RowSum {
+        double coefficients[27] = {};
+        double weight = 0.0;
+    };
+    const size_t rowCount = static_cast<size_t>(resolution) * 6;
+    std::vector<RowSum> rows(rowCount);
+    
+    TaskScheduler::GetInstance().ParallelFor(rowCount, [&](size_t index) {
+        const int face = static_cast<int>(index / resolution);
+        const int y = static_cast<int>(index % resolution);
+        const float* src = facePixels.data() + face * FaceFloatCount(resolution) + static_cast<size_t>(y) * resolution * 4;
+        const float texelArea = 4.0f / (static_cast<float>(resolution) * static_cast<float>(resolution));
+        const float v = 2.0f * (static_cast<float>(y) + 0.5f) / static_cast<float>(resolution) - 1.0f;
+        
+        RowSum& sum = rows[index];
+        float basis[9];
+        for (int x = 0; x < resolution; ++x) {
+            const float u = 2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(resolution) - 1.0f;
+            // 立方体面上像素 (u, v) 对应的立体角：dA / (1 + u² + v²)^(3/2)
+            const float r2 = 1.0f + u * u + v * v;
+            const float solidAngle = texelArea / (r2 * std::sqrt(r2));
+            
+            EvaluateSHBasis(CubemapTexelDirection(face, x, y, resolution), basis);
+            const float* texel = src + x * 4;
+            for (int i = 0; i < 9; ++i) {
+                const double w = static_cast<double>(basis[i]) * solidAngle;
+                sum.coefficients[i * 3] += w * texel[0];
+                sum.coefficients[i * 3 + 1] += w * texel[1];
+                sum.coefficients[i * 3 + 2] += w * texel[2];
+            }
+            sum.weight += solidAngle;
+        }
+    }, TaskPriority::Normal, "HDRIIrradianceSH");
+    
+    RowSum total;
+    for (const RowSum& row : rows) {
+        for (int i = 0; i < 27; ++i) {
+            total.coefficients[i] += row.coefficients[i];
+        }
+        total.weight += row.weight;
+    }
+    if (total.weight <= 0.0) {
+        return result;
+    }
+    
+    // 离散立体角之和归一化到 4π，再与余弦核卷积（A0 = π, A1 = 2π/3, A2 = π/4）
+    const double normalize = 4.0 * MathUtils::PI / total.weight;
+    const double band[9] = {
+        MathUtils::PI,
+        2.0 * MathUtils::PI / 3.0, 2.0 * MathUtils::PI / 3.0, 2.0 * MathUtils::PI / 3.0,
+        MathUtils::PI / 4.0, MathUtils::PI / 4.0, MathUtils::PI / 4.0, MathUtils::PI / 4.0, MathUtils::PI / 4.0
+    };
+    for (int i = 0; i < 9; ++i) {
+        const double scale = normalize * band[i];
+        result[i] = Vector3(static_cast<float>(total.coefficients[i * 3] * scale),
+                            static_cast<float>(total.coefficients[i * 3 + 1] * scale),
+                            static_cast<float>(total.coefficients[i * 3 + 2] * scale));
+    }
+    return result;
+}
+
+Vector3 HDRIConverter::EvaluateIrradianceSH(const std::array<Vector3, 9>& sh, const Vector3& normal) {
+    float basis[9];
+    EvaluateSHBasis(normal.normalized(), basis);
+    Vector3 result = Vector3::Zero();
+    for (int i = 0; i < 9; ++i) {
+        result += sh[i] * basis[i];
+    }
+    return result;
+}
+
+// ============================================================================
+// 完整转换
+// ============================================================================
+
+uint32_t HDRIConverter::GetSpecularLevelCount(const HDRCubemapOptions& options) {
+    // 预过滤级数不超过完整 mip 链长度
+    uint32_t maxLevels = 1;
+    while ((options.resolution >> maxLevels) > 0) {
+        maxLevels++;
+    }
+    return std::clamp(options.specularMipLevels, 1u, maxLevels);
+}
+
+bool HDRIConverter::Convert(const HDRImage& image, const HDRCubemapOptions& options, HDRCubemapData& outData) {
+    outData = HDRCubemapData{};
+    if (!image.IsValid()) {
+        LOG_WARNING("HDRIConverter::Convert: Invalid source image");
+        return false;
+    }
+    if (options.resolution <= 0 || options.resolution > kMaxResolution) {
+        LOG_WARNING_F("HDRIConverter::Convert: Invalid cubemap resolution %d", options.resolution);
+        return false;
+    }
+    
+    const int resolution = options.resolution;
+    HDRCubemapData result;
+    result.resolution = resolution;
+    ConvertToCubemap(image, resolution, result.pixels);
+    
+    if (options.computeIrradianceSH) {
+        result.irradianceSH = ComputeIrradianceSH(result.pixels, resolution);
+        result.hasIrradianceSH = true;
+    }
+    
+    const uint32_t levelCount = GetSpecularLevelCount(options);
+    
+    size_t offset = 0;
+    result.levels.resize(levelCount);
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        result.levels[level].resolution = std::max(1, resolution >> level);
+        result.levels[level].offset = offset;
+        offset += FaceFloatCount(result.levels[level].resolution) * 6;
+    }
+    result.pixels.resize(offset);
+    result.prefiltered = levelCount > 1;
+    
+    if (result.prefiltered) {
+        EquirectPyramid pyramid;
+        pyramid.Build(image);
+        const uint32_t sampleCount = std::max(1u, options.specularSampleCount);
+        
+        // 第 0 级（粗糙度 0）即镜面反射，直接使用投影结果
+        for (uint32_t level = 1; level < levelCount; ++level) {
+            const float roughness = static_cast<float>(level) / static_cast<float>(levelCount - 1);
+            const std::vector<PrefilterSample> samples =
+                BuildPrefilterSamples(roughness, sampleCount, image.width, image.height);
+            const int levelResolution = result.levels[level].resolution;
+            float* dst = result.pixels.data() + result.levels[level].offset;
+            
+            TaskScheduler::GetInstance().ParallelFor(static_cast<size_t>(levelResolution) * 6, [&](size_t index) {
+                const int face = static_cast<int>(index / levelResolution);
+                const int y = static_cast<int>(index % levelResolution);
+                float* row = dst + face * FaceFloatCount(levelResolution) + static_cast<size_t>(y) * levelResolution * 4;
+                
+                for (int x = 0; x < levelResolution; ++x) {
+                    const Vector3 n = CubemapTexelDirection(face, x, y, levelResolution);
+                    const Vector3 up = std::abs(n.z()) < 0.999f ? Vector3::UnitZ() : Vector3::UnitX();
+                    const Vector3 tangent = up.cross(n).normalized();
+                    const Vector3 bitangent = n.cross(tangent);
+                    
+                    float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                    float totalWeight = 0.0f;
+                    for (const PrefilterSample& sample : samples) {
+                        const Vector3 l = tangent * sample.direction.x() + bitangent * sample.direction.y() +
+                                          n * sample.direction.z();
+                        float u = 0.0f;
+                        float v = 0.0f;
+                        DirectionToEquirect(l, u, v);
+                        float color[4];
+                        pyramid.Sample(sample.sourceLod, u, v, color);
+                        for (int c = 0; c < 3; ++c) {
+                            accum[c] += color[c] * sample.weight;
+                        }
+                        totalWeight += sample.weight;
+                    }
+                    
+                    float* texel = row + x * 4;
+                    const float inv = totalWeight > 0.0f ? 1.0f / totalWeight : 0.0f;
+                    texel[0] = accum[0] * inv;
+                    texel[1] = accum[1] * inv;
+                    texel[2] = accum[2] * inv;
+                    texel[3] = 1.0f;
+                }
+            }, TaskPriority::Normal, "HDRIPrefilterRow");
+        }
+    }
+    
+    outData = std::move(result);
+    return true;
+}
+
+bool HDRIConverter::LoadFromFile(const std::string& filepath, const HDRCubemapOptions& options,
+                                 HDRCubemapData& outData, std::string* error) {
+    outData = HDRCubemapData{};
+    
+    MappedFile file;
+    if (!file.Open(filepath)) {
+        return Fail(error, "cannot open " + filepath);
+    }
+    
+    HDRICache& cache = HDRICache::GetInstance();
+    const bool useCache = options.useDiskCache && cache.IsEnabled();
+    uint64_t key = 0;
+    if (useCache) {
+        key = HDRICache::BuildKey(FileUtils::HashBytes(file.GetData(), file.GetSize()), options);
+        if (cache.Load(key, outData)) {
+            LOG_DEBUG_F("HDRIConverter: Cache hit for %s", filepath.c_str());
+            return true;
+        }
+    }
+    
+    const auto start = std::chrono::steady_clock::now();
+    HDRImage image;
+    std::string decodeError;
+    if (!DecodeRadiance(file.GetData(), file.GetSize(), image, &decodeError)) {
+        return Fail(error, filepath + ": " + decodeError);
+    }
+    file.Close();
+    
+    if (!Convert(image, options, outData)) {
+        return Fail(error, filepath + ": conversion failed");
+    }
+    
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG_INFO_F("HDRIConverter: Converted %s (%dx%d) to %d cubemap, %zu levels in %.1f ms",
+               filepath.c_str(), image.width, image.height, outData.resolution, outData.levels.size(), elapsedMs);
+    
+    if (useCache) {
+        cache.Store(key, outData);
+    }
+    return true;
+}
+
+} // namespace Render
@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/impostor.h"
+#include "render/lod_system.h"
+#include "render/framebuffer.h"
+#include "render/gl_thread_checker.h"
+#include "render/logger.h"
+#include "render/material_state_cache.h"
+#include "render/math_utils.h"
+#include "render/shader_cache.h"
+#include "render/task_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Render {
+
+namespace {
+
+float SignNotZero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+uint8_t ToByte(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+/**
+ * @brief 软件光栅化一帧（正交投影，深度测试，逐像素 Lambert 着色）
+ */
+void RasterizeFrame(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                    const Color& diffuse, const ImpostorBakeOptions& options,
+                    const Vector3& center, float radius, int frameX, int frameY,
+                    int frameSize, int atlasSize, std::vector<uint8_t>& pixels) {
+    const int framesPerAxis = options.framesPerAxis;
+    const Vector3 viewDir = ImpostorAtlas::GetFrameDirection(frameX, frameY, framesPerAxis);
+    Vector3 right, up;
+    ImpostorAtlas::GetFrameBasis(viewDir, right, up);
+    
+    Vector3 lightDir = -options.lightDirection;
+    lightDir = lightDir.squaredNorm() > 0.0f ? lightDir.normalized() : Vector3::UnitY();
+    const float ambient = std::clamp(options.ambient, 0.0f, 1.0f);
+    
+    // 顶点投影到帧像素坐标（x 沿 right，y 沿 up，深度沿观察方向，越大越靠近相机）
+    const float pixelScale = static_cast<float>(frameSize) / (2.0f * radius);
+    std::vector<Vector3> projected(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vector3 rel = vertices[i].position - center;
+        projected[i] = Vector3((rel.dot(right) + radius) * pixelScale,
+                               (rel.dot(up) + radius) * pixelScale,
+                               rel.dot(viewDir));
+    }
+    
+    std::vector<float> depth(static_cast<size_t>(frameSize) * frameSize,
+                             -std::numeric_limits<float>::infinity());
+    const size_t rowStride = static_cast<size_t>(atlasSize) * 4;
+    const size_t frameOffset = static_cast<size_t>(frameY) * frameSize * rowStride +
+                               static_cast<size_t>(frameX) * frameSize * 4;
+    
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const uint32_t i0 = indices[t], i1 = indices[t + 1], i2 = indices[t + 2];
+        if (i0 >= vertices.size() || i1 >= vertices.size() || i2 >= vertices.size()) {
+            continue;
+        }
+        const Vector3& p0 = projected[i0];
+        const Vector3& p1 = projected[i1];
+        const Vector3& p2 = projected[i2];
+        
+        const float area = (p1.x() - p0.x()) * (p2.y() - p0.y()) - (p1.y() - p0.y()) * (p2.x() - p0.x());
+        if (std::abs(area) < 1e-12f) {
+            continue;
+        }
+        const float invArea = 1.0f / area;
+        
+        const int minX = std::max(0, static_cast<int>(std::floor(std::min({p0.x(), p1.x(), p2.x()}))));
+        const int maxX = std::min(frameSize - 1, static_cast<int>(std::ceil(std::max({p0.x(), p1.x(), p2.x()}))));
+        const int minY = std::max(0, static_cast<int>(std::floor(std::min({p0.y(), p1.y(), p2.y()}))));
+        const int maxY = std::min(frameSize - 1, static_cast<int>(std::ceil(std::max({p0.y(), p1.y(), p2.y()}))));
+        if (minX > maxX || minY > maxY) {
+            continue;
+        }
+        
+        // 顶点法线缺失时使用面法线；背向相机的法线翻转（双面）
+        const Vector3 faceNormal = (vertices[i1].position - vertices[i0].position)
+                                       .cross(vertices[i2].position - vertices[i0].position);
+        
+        for (int py = minY; py <= maxY; ++py) {
+            const float sy = static_cast<float>(py) + 0.5f;
+            for (int px = minX; px <= maxX; ++px) {
+                const float sx = static_cast<float>(px) + 0.5f;
+                const float w0 = ((p1.x() - sx) * (p2.y() - sy) - (p1.y() - sy) * (p2.x() - sx)) * invArea;
+                const float w1 = ((p2.x() - sx) * (p0.y() - sy) - (p2.y() - sy) * (p0.x() - sx)) * invArea;
+                const float w2 = 1.0f - w0 - w1;
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                    continue;
+                }
+                
+                const float z = w0 * p0.z() + w1 * p1.z() + w2 * p2.z();
+                float& storedDepth = depth[static_cast<size_t>(py) * frameSize + px];
+                if (z <= storedDepth) {
+                    continue;
+                }
+                storedDepth = z;
+                
+                Vector3 normal = w0 * vertices[i0].normal + w1 * vertices[i1].normal + w2 * vertices[i2].normal;
+                if (normal.squaredNorm() < 1e-12f) {
+                    normal = faceNormal;
+                }
+                normal = normal.squaredNorm() > 0.0f ? normal.normalized() : viewDir;
+                if (normal.dot(viewDir) < 0.0f) {
+                    normal = -normal;
+                }
+                const float lighting = ambient + (1.0f - ambient) * std::max(0.0f, normal.dot(lightDir));
+                
+                const Color& c0 = vertices[i0].color;
+                const Color& c1 = vertices[i1].color;
+                const Color& c2 = vertices[i2].color;
+                uint8_t* out = pixels.data() + frameOffset + static_cast<size_t>(py) * rowStride +
+                               static_cast<size_t>(px) * 4;
+                out[0] = ToByte((w0 * c0.r + w1 * c1.r + w2 * c2.r) * diffuse.r * lighting);
+                out[1] = ToByte((w0 * c0.g + w1 * c1.g + w2 * c2.g) * diffuse.g * lighting);
+                out[2] = ToByte((w0 * c0.b + w1 * c1.b + w2 * c2.b) * diffuse.b * lighting);
+                out[3] = 255;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+// ==================== 八面体映射 ====================
+
+Vector2 ImpostorAtlas::OctahedralEncode(const Vector3& direction) {
+    const float l1 = std::abs(direction.x()) + std::abs(direction.y()) + std::abs(direction.z());
+    if (l1 <= 0.0f) {
+        return Vector2::Zero();
+    }
+    const Vector3 n = direction / l1;
+    Vector2 p(n.x(), n.z());
+    if (n.y() < 0.0f) {
+        p = Vector2((1.0f - std::abs(n.z())) * SignNotZero(n.x()),
+                    (1.0f - std::abs(n.x())) * SignNotZero(n.z()));
+    }
+    return p;
+}
+
+Vector3 ImpostorAtlas::OctahedralDecode(const Vector2& encoded) {
+    Vector3 n(encoded.x(), 1.0f - std::abs(encoded.x()) - std::abs(encoded.y()), encoded.y());
+    if (n.y() < 0.0f) {
+        const float x = n.x();
+        n.x() = (1.0f - std::abs(n.z())) * SignNotZero(x);
+        n.z() = (1.0f - std::abs(x)) * SignNotZero(n.z());
+    }
+    return n.normalized();
+}
+
+Vector3 ImpostorAtlas::GetFrameDirection(int frameX, int frameY, int framesPerAxis) {
+    const float n = static_cast<float>(std::max(framesPerAxis, 1));
+    const Vector2 encoded((static_cast<float>(frameX) + 0.5f) / n * 2.0f - 1.0f,
+                          (static_cast<float>(frameY) + 0.5f) / n * 2.0f - 1.0f);
+    return OctahedralDecode(encoded);
+}
+
+void ImpostorAtlas::SelectFrame(const Vector3& direction, int framesPerAxis, int& frameX, int& frameY) {
+    const int n = std::max(framesPerAxis, 1);
+    const Vector2 encoded = OctahedralEncode(direction);
+    frameX = std::clamp(static_cast<int>(std::floor((encoded.x() * 0.5f + 0.5f) * n)), 0, n - 1);
+    frameY = std::clamp(static_cast<int>(std::floor((encoded.y() * 0.5f + 0.5f) * n)), 0, n - 1);
+}
+
+void ImpostorAtlas::GetFrameBasis(const Vector3& direction, Vector3& right, Vector3& up) {
+    const Vector3 upHint = std::abs(direction.y()) > 0.999f ? Vector3::UnitZ() : Vector3::UnitY();
+    right = upHint.cross(direction).normalized();
+    up = direction.cross(right);
+}
+
+// ==================== 烘焙 ====================
+
+bool ImpostorAtlas::PrepareBake(const Ref<Mesh>& mesh, const ImpostorBakeOptions& options, ImpostorAtlas& atlas) {
+    if (!mesh) {
+        LOG_ERROR("ImpostorAtlas: Source mesh is null");
+        return false;
+    }
+    if (options.framesPerAxis <= 0 || options.atlasSize < options.framesPerAxis) {
+        LOG_ERROR_F("ImpostorAtlas: Invalid frame layout (framesPerAxis=%d, atlasSize=%d)",
+                    options.framesPerAxis, options.atlasSize);
+        return false;
+    }
+    
+    // 包围球：包围盒中心 + 到最远顶点的距离（比半对角线更紧）
+    const AABB bounds = mesh->CalculateBounds();
+    atlas.m_center = bounds.GetCenter();
+    float radiusSq = 0.0f;
+    mesh->AccessPositions([&](const Mesh::PositionView& positions) {
+        for (size_t i = 0; i < positions.size(); ++i) {
+            radiusSq = std::max(radiusSq, (positions[i] - atlas.m_center).squaredNorm());
+        }
+    });
+    atlas.m_radius = radiusSq > 0.0f ? std::sqrt(radiusSq) : bounds.GetExtents().norm();
+    if (atlas.m_radius <= 0.0f) {
+        LOG_ERROR("ImpostorAtlas: Source mesh has empty bounds");
+        return false;
+    }
+    
+    atlas.m_framesPerAxis = options.framesPerAxis;
+    // 图集边长向下取整到帧尺寸的整数倍
+    atlas.m_atlasSize = (options.atlasSize / options.framesPerAxis) * options.framesPerAxis;
+    atlas.m_pixels.assign(static_cast<size_t>(atlas.m_atlasSize) * atlas.m_atlasSize * 4, 0);
+    return true;
+}
+
+ImpostorAtlas ImpostorAtlas::Bake(const Ref<Mesh>& mesh, const Ref<Material>& material,
+                                  const ImpostorBakeOptions& options) {
+    ImpostorBakeBackend backend = options.backend;
+    if (backend == ImpostorBakeBackend::Auto) {
+        const auto& checker = GLThreadChecker::GetInstance();
+        const bool glAvailable = GLAD_GL_VERSION_3_0 && checker.IsRegistered() && checker.IsGLThread();
+        backend = glAvailable ? ImpostorBakeBackend::GPU : ImpostorBakeBackend::CPU;
+    }
+    return backend == ImpostorBakeBackend::GPU ? BakeGPU(mesh, material, options)
+                                               : BakeCPU(mesh, material, options);
+}
+
+ImpostorAtlas ImpostorAtlas::BakeCPU(const Ref<Mesh>& mesh, const Ref<Material>& material,
+                                     const ImpostorBakeOptions& options) {
+    ImpostorAtlas atlas;
+    if (!PrepareBake(mesh, options, atlas)) {
+        return ImpostorAtlas();
+    }
+    
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    mesh->AccessVertices([&](const std::vector<Vertex>& source) { vertices = source; });
+    mesh->AccessIndices([&](const std::vector<uint32_t>& source) { indices = source; });
+    if (indices.empty()) {
+        indices.resize(vertices.size() - vertices.size() % 3);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = static_cast<uint32_t>(i);
+        }
+    }
+    
+    const Color diffuse = material ? material->GetDiffuseColor() : Color::White();
+    const int framesPerAxis = atlas.m_framesPerAxis;
+    const int frameSize = atlas.GetFrameSize();
+    
+    // 每行帧一个任务：各帧写入图集的不相交区域
+    auto bakeRow = [&](int frameY) {
+        for (int frameX = 0; frameX < framesPerAxis; ++frameX) {
+            RasterizeFrame(vertices, indices, diffuse, options, atlas.m_center, atlas.m_radius,
+                           frameX, frameY, frameSize, atlas.m_atlasSize, atlas.m_pixels);
+        }
+    };
+    
+    auto& scheduler = TaskScheduler::GetInstance();
+    if (framesPerAxis > 1 && scheduler.IsInitialized() && scheduler.GetWorkerCount() > 1) {
+        std::vector<std::shared_ptr<TaskHandle>> handles;
+        handles.reserve(static_cast<size_t>(framesPerAxis));
+        for (int frameY = 0; frameY < framesPerAxis; ++frameY) {
+            handles.push_back(scheduler.SubmitLambda([&bakeRow, frameY]() { bakeRow(frameY); },
+                                                     TaskPriority::Normal, "ImpostorBake"));
+        }
+        scheduler.WaitForAll(handles);
+    } else {
+        for (int frameY = 0; frameY < framesPerAxis; ++frameY) {
+            bakeRow(frameY);
+        }
+    }
+    
+    atlas.DilateFrames(options.dilationPixels);
+    LOG_INFO_F("ImpostorAtlas: CPU baked %dx%d frames into %dx%d atlas",
+               framesPerAxis, framesPerAxis, atlas.m_atlasSize, atlas.m_atlasSize);
+    return atlas;
+}
+
+ImpostorAtlas ImpostorAtlas::BakeGPU(const Ref<Mesh>& mesh, const Ref<Material>& material,
+                                     const ImpostorBakeOptions& options) {
+    ImpostorAtlas atlas;
+    if (!material || !material->GetShader()) {
+        LOG_ERROR("ImpostorAtlas: GPU bake requires a material with shader");
+        return atlas;
+    }
+    if (!PrepareBake(mesh, options, atlas)) {
+        return ImpostorAtlas();
+    }
+    
+    GL_THREAD_CHECK();
+    
+    const int framesPerAxis = atlas.m_framesPerAxis;
+    const int frameSize = atlas.GetFrameSize();
+    
+    FramebufferConfig config;
+    config.SetSize(frameSize, frameSize)
+          .AddColorAttachment(TextureFormat::RGBA, false)
+          .AddDepthAttachment(true)
+          .SetName("ImpostorBake");
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(config)) {
+        LOG_ERROR("ImpostorAtlas: Failed to create bake framebuffer");
+        return ImpostorAtlas();
+    }
+    if (!mesh->IsUploaded()) {
+        mesh->Upload();
+    }
+    
+    GLint previousViewport[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    GLfloat previousClearColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor);
+    
+    framebuffer.Bind();
+    glViewport(0, 0, frameSize, frameSize);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ROW_LENGTH, atlas.m_atlasSize);
+    
+    material->Bind();
+    auto* uniformMgr = material->GetShader()->GetUniformManager();
+    const float radius = atlas.m_radius;
+    const Matrix4 projection = MathUtils::Orthographic(-radius, radius, -radius, radius, 0.5f * radius, 3.5f * radius);
+    
+    for (int frameY = 0; frameY < framesPerAxis; ++frameY) {
+        for (int frameX = 0; frameX < framesPerAxis; ++frameX) {
+            const Vector3 viewDir = GetFrameDirection(frameX, frameY, framesPerAxis);
+            Vector3 right, up;
+            GetFrameBasis(viewDir, right, up);
+            const Matrix4 view = MathUtils::LookAt(atlas.m_center + viewDir * (2.0f * radius), atlas.m_center, up);
+            
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            if (uniformMgr) {
+                uniformMgr->SetBool("uHasInstanceData", false);
+                uniformMgr->SetMatrix4("uModel", Matrix4::Identity());
+                uniformMgr->SetMatrix4("uView", view);
+                uniformMgr->SetMatrix4("uProjection", projection);
+            }
+            mesh->Draw();
+            
+            uint8_t* dst = atlas.m_pixels.data() +
+                           (static_cast<size_t>(frameY) * frameSize * atlas.m_atlasSize +
+                            static_cast<size_t>(frameX) * frameSize) * 4;
+            glReadPixels(0, 0, frameSize, frameSize, GL_RGBA, GL_UNSIGNED_BYTE, dst);
+        }
+    }
+    
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    framebuffer.Unbind();
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glClearColor(previousClearColor[0], previousClearColor[1], previousClearColor[2], previousClearColor[3]);
+    // 直接绑定了材质，使材质状态缓存失效
+    MaterialStateCache::Get().Reset();
+    
+    atlas.DilateFrames(options.dilationPixels);
+    LOG_INFO_F("ImpostorAtlas: GPU baked %dx%d frames into %dx%d atlas",
+               framesPerAxis, framesPerAxis, atlas.m_atlasSize, atlas.m_atlasSize);
+    return atlas;
+}
+
+void ImpostorAtlas::DilateFrames(int iterations) {
+    // 透明像素取相邻不透明像素的平均颜色（alpha 保持 0），限制在帧内避免跨帧渗色
+    const int frameSize = GetFrameSize();
+    const size_t rowStride = static_cast<size_t>(m_atlasSize) * 4;
+    std::vector<uint8_t> filled;
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        std::vector<uint8_t> source = m_pixels;
+        filled.assign(static_cast<size_t>(m_atlasSize) * m_atlasSize, 0);
+        for (size_t i = 0; i < filled.size(); ++i) {
+            filled[i] = source[i * 4 + 3] > 0 || (source[i * 4] | source[i * 4 + 1] | source[i * 4 + 2]) ? 1 : 0;
+        }
+        
+        for (int y = 0; y < m_atlasSize; ++y) {
+            const int frameMinY = (y / frameSize) * frameSize;
+            for (int x = 0; x < m_atlasSize; ++x) {
+                const size_t index = static_cast<size_t>(y) * m_atlasSize + x;
+                if (filled[index]) {
+                    continue;
+                }
+                const int frameMinX = (x / frameSize) * frameSize;
+                int sum[3] = {0, 0, 0};
+                int count = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const int nx = x + dx;
+                        const int ny = y + dy;
+                        if (nx < frameMinX || nx >= frameMinX + frameSize ||
+                            ny < frameMinY || ny >= frameMinY + frameSize) {
+                            continue;
+                        }
+                        const size_t neighbor = static_cast<size_t>(ny) * m_atlasSize + nx;
+                        if (!filled[neighbor]) {
+                            continue;
+                        }
+                        const uint8_t* px = source.data() + static_cast<size_t>(ny) * rowStride + static_cast<size_t>(nx) * 4;
+                        sum[0] += px[0];
+                        sum[1] += px[1];
+                        sum[2] += px[2];
+                        ++count;
+                    }
+                }
+                if (count > 0) {
+                    uint8_t* out = m_pixels.data() + static_cast<size_t>(y) * rowStride + static_cast<size_t>(x) * 4;
+                    out[0] = static_cast<uint8_t>(sum[0] / count);
+                    out[1] = static_cast<uint8_t>(sum[1] / count);
+                    out[2] = static_cast<uint8_t>(sum[2] / count);
+                }
+            }
+        }
+    }
+}
+
+size_t ImpostorAtlas::CountFrameCoverage(int frameX, int frameY) const {
+    if (!IsValid() || frameX < 0 || frameY < 0 || frameX >= m_framesPerAxis || frameY >= m_framesPerAxis) {
+        return 0;
+    }
+    const int frameSize = GetFrameSize();
+    size_t covered = 0;
+    for (int y = 0; y < frameSize; ++y) {
+        const uint8_t* row = m_pixels.data() +
+                             (static_cast<size_t>(frameY * frameSize + y) * m_atlasSize +
+                              static_cast<size_t>(frameX) * frameSize) * 4;
+        for (int x = 0; x < frameSize; ++x) {
+            covered += row[x * 4 + 3] >= 128 ? 1 : 0;
+        }
+    }
+    return covered;
+}
+
+// ==================== GPU 资源 ====================
+
+bool ImpostorAtlas::UploadToGPU() {
+    if (!IsValid()) {
+        LOG_ERROR("ImpostorAtlas: Cannot upload an empty atlas");
+        return false;
+    }
+    
+    GL_THREAD_CHECK();
+    
+    m_texture = CreateRef<Texture>();
+    if (!m_texture->CreateFromData(m_pixels.data(), m_atlasSize, m_atlasSize, TextureFormat::RGBA, true)) {
+        LOG_ERROR("ImpostorAtlas: Failed to create atlas texture");
+        m_texture.reset();
+        return false;
+    }
+    m_texture->SetWrap(TextureWrap::ClampToEdge, TextureWrap::ClampToEdge);
+    
+    // 单位四边形（xy ∈ [-0.5, 0.5]），朝向与尺寸由 impostor.vert 按帧计算
+    std::vector<Vertex> quadVertices(4);
+    const float corners[4][2] = {{-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {-0.5f, 0.5f}};
+    for (int i = 0; i < 4; ++i) {
+        quadVertices[i].position = Vector3(corners[i][0], corners[i][1], 0.0f);
+        quadVertices[i].texCoord = Vector2(corners[i][0] + 0.5f, corners[i][1] + 0.5f);
+        quadVertices[i].normal = Vector3::UnitZ();
+    }
+    m_quadMesh = CreateRef<Mesh>(quadVertices, std::vector<uint32_t>{0, 1, 2, 0, 2, 3});
+    m_quadMesh->Upload();
+    
+    auto shader = ShaderCache::GetInstance().LoadShader("impostor", "shaders/impostor.vert", "shaders/impostor.frag");
+    if (!shader) {
+        LOG_ERROR("ImpostorAtlas: Failed to load impostor shader");
+        return false;
+    }
+    m_material = CreateRef<Material>();
+    m_material->SetName("ImpostorMaterial");
+    m_material->SetShader(shader);
+    m_material->SetTexture("uImpostorAtlas", m_texture);
+    m_material->SetInt("uImpostorFramesPerAxis", m_framesPerAxis);
+    m_material->SetVector3("uImpostorCenter", m_center);
+    m_material->SetFloat("uImpostorRadius", m_radius);
+    m_material->SetFloat("uAlphaCutoff", 0.5f);
+    m_material->SetCullFace(CullFace::None);
+    return true;
+}
+
+bool ImpostorAtlas::ConfigureLOD(LODConfig& config, float impostorEndDistance) const {
+    if (!m_quadMesh || !m_material) {
+        LOG_WARNING("ImpostorAtlas: ConfigureLOD called before UploadToGPU");
+        return false;
+    }
+    
+    config.impostorMesh = m_quadMesh;
+    config.impostorMaterial = m_material;
+    
+    const LODConfig defaults;
+    while (config.distanceThresholds.size() < 4) {
+        config.distanceThresholds.push_back(defaults.distanceThresholds[config.distanceThresholds.size()]);
+    }
+    const float lod3End = config.distanceThresholds[3];
+    config.distanceThresholds.resize(5);
+    config.distanceThresholds[4] = impostorEndDistance > lod3End ? impostorEndDistance : lod3End * 4.0f;
+    return true;
+}
+
+} // namespace Render
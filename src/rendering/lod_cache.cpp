@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/lod_cache.h"
+#include "render/file_utils.h"
+#include "render/logger.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace Render {
+
+namespace {
+
+constexpr char kMagic[4] = {'R', 'L', 'O', 'D'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kFloatsPerVertex = 18;  // position3 + uv2 + normal3 + color4 + tangent3 + bitangent3
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t levelCount;
+    uint32_t floatsPerVertex;
+};
+
+struct LevelHeader {
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    float geometricError;
+    uint32_t present;
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+};
+
+static_assert(sizeof(FileHeader) == 24, "LOD cache header layout changed");
+static_assert(sizeof(LevelHeader) == 32, "LOD cache level layout changed");
+
+template<typename T>
+uint64_t HashValue(const T& value, uint64_t hash) {
+    return FileUtils::HashBytes(&value, sizeof(T), hash);
+}
+
+void WriteVertex(const Vertex& v, float* out) {
+    out[0] = v.position.x();  out[1] = v.position.y();  out[2] = v.position.z();
+    out[3] = v.texCoord.x();  out[4] = v.texCoord.y();
+    out[5] = v.normal.x();    out[6] = v.normal.y();    out[7] = v.normal.z();
+    out[8] = v.color.r;       out[9] = v.color.g;       out[10] = v.color.b;     out[11] = v.color.a;
+    out[12] = v.tangent.x();  out[13] = v.tangent.y();  out[14] = v.tangent.z();
+    out[15] = v.bitangent.x(); out[16] = v.bitangent.y(); out[17] = v.bitangent.z();
+}
+
+void ReadVertex(const float* in, Vertex& v) {
+    v.position = Vector3(in[0], in[1], in[2]);
+    v.texCoord = Vector2(in[3], in[4]);
+    v.normal = Vector3(in[5], in[6], in[7]);
+    v.color = Color(in[8], in[9], in[10], in[11]);
+    v.tangent = Vector3(in[12], in[13], in[14]);
+    v.bitangent = Vector3(in[15], in[16], in[17]);
+}
+
+} // namespace
+
+LODCache& LODCache::GetInstance() {
+    static LODCache instance;
+    return instance;
+}
+
+void LODCache::SetCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_directoryMutex);
+    m_directory = directory;
+}
+
+std::string LODCache::GetCacheDirectory() const {
+    std::lock_guard<std::mutex> lock(m_directoryMutex);
+    return m_directory;
+}
+
+// ============================================================================
+// 哈希
+// ============================================================================
+
+uint64_t LODCache::HashFile(const std::string& filepath) {
+    return FileUtils::HashFile(filepath);
+}
+
+uint64_t LODCache::HashMesh(const Ref<Mesh>& mesh) {
+    if (!mesh) {
+        return 0;
+    }
+    
+    uint64_t hash = FileUtils::kHashSeed;
+    bool empty = true;
+    mesh->AccessVertices([&](const std::vector<Vertex>& vertices) {
+        float packed[kFloatsPerVertex];
+        for (const auto& v : vertices) {
+            WriteVertex(v, packed);
+            hash = FileUtils::HashBytes(packed, sizeof(packed), hash);
+        }
+        empty = vertices.empty();
+    });
+    mesh->AccessIndices([&](const std::vector<uint32_t>& indices) {
+        hash = FileUtils::HashBytes(indices.data(), indices.size() * sizeof(uint32_t), hash);
+        empty = empty || indices.empty();
+    });
+    return empty ? 0 : hash;
+}
+
+uint64_t LODCache::HashSource(const std::string& filepath, const Ref<Mesh>& mesh) {
+    const uint64_t meshHash = HashMesh(mesh);
+    const uint64_t fileHash = filepath.empty() ? 0 : HashFile(filepath);
+    if (fileHash == 0) {
+        return meshHash;
+    }
+    return HashValue(meshHash, fileHash);
+}
+
+uint64_t LODCache::HashOptions(const LODGenerator::SimplifyOptions& options) {
+    uint64_t hash = FileUtils::kHashSeed;
+    hash = HashValue(static_cast<uint32_t>(options.mode), hash);
+    hash = HashValue(static_cast<uint64_t>(options.triangleCounts.lod1), hash);
+    hash = HashValue(static_cast<uint64_t>(options.triangleCounts.lod2), hash);
+    hash = HashValue(static_cast<uint64_t>(options.triangleCounts.lod3), hash);
+    hash = HashValue(options.targetErrors.lod1, hash);
+    hash = HashValue(options.targetErrors.lod2, hash);
+    hash = HashValue(options.targetErrors.lod3, hash);
+    hash = HashValue(static_cast<uint32_t>(options.flags), hash);
+    hash = HashValue(options.attributeWeights.normal, hash);
+    hash = HashValue(options.attributeWeights.texCoord, hash);
+    hash = HashValue(options.attributeWeights.color, hash);
+    hash = HashValue(static_cast<uint8_t>(options.recalculateNormals), hash);
+    hash = HashValue(static_cast<uint8_t>(options.recalculateTangents), hash);
+    hash = HashValue(static_cast<uint8_t>(options.optimizeMesh), hash);
+    return hash;
+}
+
+uint64_t LODCache::BuildKey(uint64_t sourceHash, const LODGenerator::SimplifyOptions& options) {
+    uint64_t hash = HashValue(kFormatVersion, FileUtils::kHashSeed);
+    hash = HashValue(sourceHash, hash);
+    hash = HashValue(HashOptions(options), hash);
+    return hash;
+}
+
+std::string LODCache::GetCachePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.lodc", static_cast<unsigned long long>(key));
+    return FileUtils::CombinePaths(GetCacheDirectory(), name);
+}
+
+// ============================================================================
+// 读写
+// ============================================================================
+
+bool LODCache::Load(uint64_t key,
+                    std::vector<Ref<Mesh>>& outLODMeshes,
+                    std::vector<float>& outGeometricErrors) {
+    outLODMeshes.clear();
+    outGeometricErrors.clear();
+    
+    if (!IsEnabled()) {
+        return false;
+    }
+    
+    const std::string path = GetCachePath(key);
+    MappedFile file;
+    if (!file.Open(path)) {
+        m_misses++;
+        return false;
+    }
+    
+    const uint8_t* data = file.GetData();
+    const size_t size = file.GetSize();
+    
+    FileHeader header{};
+    if (size < sizeof(FileHeader)) {
+        LOG_WARNING_F("LODCache: Truncated cache file %s", path.c_str());
+        m_misses++;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kFormatVersion ||
+        header.key != key ||
+        header.floatsPerVertex != kFloatsPerVertex ||
+        header.levelCount == 0 || header.levelCount > 8 ||
+        size < sizeof(FileHeader) + header.levelCount * sizeof(LevelHeader)) {
+        LOG_WARNING_F("LODCache: Invalid or stale cache file %s", path.c_str());
+        m_misses++;
+        return false;
+    }
+    
+    std::vector<Ref<Mesh>> meshes(header.levelCount);
+    std::vector<float> errors(header.levelCount, -1.0f);
+    
+    for (uint32_t level = 0; level < header.levelCount; ++level) {
+        LevelHeader levelHeader{};
+        std::memcpy(&levelHeader, data + sizeof(FileHeader) + level * sizeof(LevelHeader), sizeof(levelHeader));
+        if (!levelHeader.present) {
+            continue;
+        }
+        
+        const uint64_t vertexBytes = static_cast<uint64_t>(levelHeader.vertexCount) * kFloatsPerVertex * sizeof(float);
+        const uint64_t indexBytes = static_cast<uint64_t>(levelHeader.indexCount) * sizeof(uint32_t);
+        // 先比较偏移再比较剩余长度：损坏的 64 位偏移与长度相加可能回绕
+        if (levelHeader.vertexOffset > size || vertexBytes > size - levelHeader.vertexOffset ||
+            levelHeader.indexOffset > size || indexBytes > size - levelHeader.indexOffset) {
+            LOG_WARNING_F("LODCache: Corrupted level %u in %s", level, path.c_str());
+            m_misses++;
+            return false;
+        }
+        
+        std::vector<Vertex> vertices(levelHeader.vertexCount);
+        float packed[kFloatsPerVertex];
+        const uint8_t* vertexData = data + levelHeader.vertexOffset;
+        for (uint32_t i = 0; i < levelHeader.vertexCount; ++i) {
+            std::memcpy(packed, vertexData + i * sizeof(packed), sizeof(packed));
+            ReadVertex(packed, vertices[i]);
+        }
+        
+        std::vector<uint32_t> indices(levelHeader.indexCount);
+        if (indexBytes > 0) {
+            std::memcpy(indices.data(), data + levelHeader.indexOffset, static_cast<size_t>(indexBytes));
+        }
+        
+        meshes[level] = std::make_shared<Mesh>(vertices, indices);
+        errors[level] = levelHeader.geometricError;
+    }
+    
+    outLODMeshes = std::move(meshes);
+    outGeometricErrors = std::move(errors);
+    m_hits++;
+    return true;
+}
+
+bool LODCache::Store(uint64_t key,
+                     const std::vector<Ref<Mesh>>& lodMeshes,
+                     const std::vector<float>& geometricErrors) {
+    if (!IsEnabled() || lodMeshes.empty()) {
+        return false;
+    }
+    
+    const uint32_t levelCount = static_cast<uint32_t>(lodMeshes.size());
+    std::vector<LevelHeader> levels(levelCount);
+    std::vector<std::vector<float>> vertexBlocks(levelCount);
+    std::vector<std::vector<uint32_t>> indexBlocks(levelCount);
+    
+    uint64_t offset = sizeof(FileHeader) + levelCount * sizeof(LevelHeader);
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        LevelHeader& levelHeader = levels[level];
+        levelHeader = LevelHeader{};
+        levelHeader.geometricError = level < geometricErrors.size() ? geometricErrors[level] : -1.0f;
+        
+        const Ref<Mesh>& mesh = lodMeshes[level];
+        if (!mesh) {
+            continue;
+        }
+        
+        mesh->AccessVertices([&](const std::vector<Vertex>& vertices) {
+            auto& block = vertexBlocks[level];
+            block.resize(vertices.size() * kFloatsPerVertex);
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                WriteVertex(vertices[i], block.data() + i * kFloatsPerVertex);
+            }
+        });
+        mesh->AccessIndices([&](const std::vector<uint32_t>& indices) {
+            indexBlocks[level] = indices;
+        });
+        
+        levelHeader.present = 1;
+        levelHeader.vertexCount = static_cast<uint32_t>(vertexBlocks[level].size() / kFloatsPerVertex);
+        levelHeader.indexCount = static_cast<uint32_t>(indexBlocks[level].size());
+        levelHeader.vertexOffset = offset;
+        offset += vertexBlocks[level].size() * sizeof(float);
+        levelHeader.indexOffset = offset;
+        offset += indexBlocks[level].size() * sizeof(uint32_t);
+    }
+    
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.key = key;
+    header.levelCount = levelCount;
+    header.floatsPerVertex = kFloatsPerVertex;
+    
+    const std::string path = GetCachePath(key);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    
+    // 先写临时文件再重命名，避免其他线程/进程读到写了一半的文件
+    std::ostringstream tempSuffix;
+    tempSuffix << ".tmp" << std::this_thread::get_id();
+    const std::string tempPath = path + tempSuffix.str();
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            LOG_WARNING_F("LODCache: Failed to open %s for writing", tempPath.c_str());
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(levels.data()), levels.size() * sizeof(LevelHeader));
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            out.write(reinterpret_cast<const char*>(vertexBlocks[level].data()),
+                      vertexBlocks[level].size() * sizeof(float));
+            out.write(reinterpret_cast<const char*>(indexBlocks[level].data()),
+                      indexBlocks[level].size() * sizeof(uint32_t));
+        }
+        if (!out.good()) {
+            LOG_WARNING_F("LODCache: Failed to write %s", tempPath.c_str());
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        // Windows 上目标已存在时重命名可能失败（其他线程已写入相同内容）
+        std::filesystem::remove(tempPath, ec);
+        return std::filesystem::exists(path);
+    }
+    
+    m_writes++;
+    LOG_INFO_F("LODCache: Stored %u LOD levels to %s (%llu bytes)",
+               levelCount, path.c_str(), static_cast<unsigned long long>(offset));
+    return true;
+}
+
+size_t LODCache::ClearDiskCache() {
+    const std::string directory = GetCacheDirectory();
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        return 0;
+    }
+    
+    size_t removed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".lodc") {
+            if (std::filesystem::remove(entry.path(), ec)) {
+                removed++;
+            }
+        }
+    }
+    return removed;
+}
+
+LODCache::Stats LODCache::GetStats() const {
+    Stats stats;
+    stats.hits = m_hits.load();
+    stats.misses = m_misses.load();
+    stats.writes = m_writes.load();
+    return stats;
+}
+
+void LODCache::ResetStats() {
+    m_hits = 0;
+    m_misses = 0;
+    m_writes = 0;
+}
+
+} // namespace Render
@@ -22,10 +22,12 @@
 #include "render/mesh.h"
 #include "render/model.h"
 #include "render/mesh_loader.h"
+#include "render/mesh_optimizer.h"
 #include "render/lod_system.h"
 #include "render/logger.h"
 #include "render/texture.h"
 #include "render/material.h"
+#include "render/task_scheduler.h"
 #include "../../third_party/meshoptimizer/src/meshoptimizer.h"
 #include <algorithm>
 #include <cmath>
@@ -261,8 +263,13 @@ void LODGenerator::RebuildVertices(
 Ref<Mesh> LODGenerator::SimplifyMeshInternal(
     Ref<Mesh> sourceMesh,
     int lodLevel,
-    const SimplifyOptions& options
+    const SimplifyOptions& options,
+    float* outGeometricError
 ) {
+    if (outGeometricError) {
+        *outGeometricError = -1.0f;
+    }
+    
     if (!sourceMesh) {
         LOG_ERROR_F("LODGenerator: Source mesh is null");
         return nullptr;
@@ -297,7 +304,12 @@ Ref<Mesh> LODGenerator::SimplifyMeshInternal(
                  sourceIndices.size(), targetIndexCount);
         // 如果目标数量大于等于源数量，返回源网格的副本
         Ref<Mesh> copy = std::make_shared<Mesh>(sourceVertices, sourceIndices);
-        copy->Upload();
+        if (options.uploadToGPU) {
+            copy->Upload();
+        }
+        if (outGeometricError) {
+            *outGeometricError = 0.0f;
+        }
         return copy;
     }
     
@@ -383,17 +395,32 @@ Ref<Mesh> LODGenerator::SimplifyMeshInternal(
                  sourceIndices.size(), newIndexCount);
         // 简化失败，返回源网格的副本
         Ref<Mesh> copy = std::make_shared<Mesh>(sourceVertices, sourceIndices);
-        copy->Upload();
+        if (options.uploadToGPU) {
+            copy->Upload();
+        }
+        if (outGeometricError) {
+            *outGeometricError = 0.0f;
+        }
         return copy;
     }
     
     simplifiedIndices.resize(newIndexCount);
     
+    // resultError 是相对网格尺度的误差，乘以 errorScale 得到局部空间的绝对误差
+    if (outGeometricError) {
+        *outGeometricError = resultError * errorScale;
+    }
+    
     // 重建顶点数据
     std::vector<Vertex> simplifiedVertices;
     std::vector<uint32_t> remappedIndices;
     RebuildVertices(sourceVertices, simplifiedIndices, simplifiedVertices, remappedIndices);
     
+    // 简化会打乱三角形顺序，重新优化顶点缓存 / overdraw / 顶点获取顺序
+    if (options.optimizeMesh) {
+        MeshOptimizer::Optimize(simplifiedVertices, remappedIndices);
+    }
+    
     // 创建新的网格
     Ref<Mesh> simplifiedMesh = std::make_shared<Mesh>(simplifiedVertices, remappedIndices);
     
@@ -407,14 +434,17 @@ Ref<Mesh> LODGenerator::SimplifyMeshInternal(
         simplifiedMesh->RecalculateTangents();
     }
     
-    // 上传到 GPU
-    simplifiedMesh->Upload();
+    // 上传到 GPU（后台生成时由主线程负责上传）
+    if (options.uploadToGPU) {
+        simplifiedMesh->Upload();
+    }
     
-    LOG_INFO_F("LODGenerator: Generated LOD%d - Triangles: %zu -> %zu (reduction: %.1f%%)", 
+    LOG_INFO_F("LODGenerator: Generated LOD%d - Triangles: %zu -> %zu (reduction: %.1f%%, error: %.5f)", 
              lodLevel,
              sourceIndices.size() / 3,
              newIndexCount / 3,
-             (1.0f - (float)newIndexCount / sourceIndices.size()) * 100.0f);
+             (1.0f - (float)newIndexCount / sourceIndices.size()) * 100.0f,
+             resultError * errorScale);
     
     return simplifiedMesh;
 }
@@ -425,12 +455,17 @@ Ref<Mesh> LODGenerator::SimplifyMeshInternal(
 
 std::vector<Ref<Mesh>> LODGenerator::GenerateLODLevels(
     Ref<Mesh> sourceMesh,
-    const SimplifyOptions& options
+    const SimplifyOptions& options,
+    std::vector<float>* outGeometricErrors
 ) {
     std::vector<Ref<Mesh>> lodMeshes(3);  // LOD1, LOD2, LOD3
+    if (outGeometricErrors) {
+        outGeometricErrors->assign(3, -1.0f);
+    }
     
     for (int i = 1; i <= 3; ++i) {
-        lodMeshes[i - 1] = GenerateLODLevel(sourceMesh, i, options);
+        lodMeshes[i - 1] = GenerateLODLevel(sourceMesh, i, options,
+                                            outGeometricErrors ? &(*outGeometricErrors)[i - 1] : nullptr);
     }
     
     return lodMeshes;
@@ -439,14 +474,18 @@ std::vector<Ref<Mesh>> LODGenerator::GenerateLODLevels(
 Ref<Mesh> LODGenerator::GenerateLODLevel(
     Ref<Mesh> sourceMesh,
     int lodLevel,
-    const SimplifyOptions& options
+    const SimplifyOptions& options,
+    float* outGeometricError
 ) {
     if (lodLevel < 1 || lodLevel > 3) {
         LOG_ERROR_F("LODGenerator: Invalid LOD level: %d. Must be 1, 2, or 3", lodLevel);
+        if (outGeometricError) {
+            *outGeometricError = -1.0f;
+        }
         return nullptr;
     }
     
-    return SimplifyMeshInternal(sourceMesh, lodLevel, options);
+    return SimplifyMeshInternal(sourceMesh, lodLevel, options, outGeometricError);
 }
 
 bool LODGenerator::AutoConfigureLOD(
@@ -459,8 +498,9 @@ bool LODGenerator::AutoConfigureLOD(
         return false;
     }
     
-    // 生成所有 LOD 级别
-    auto lodMeshes = GenerateLODLevels(sourceMesh, options);
+    // 生成所有 LOD 级别（同时记录几何误差）
+    std::vector<float> geometricErrors;
+    auto lodMeshes = GenerateLODLevels(sourceMesh, options, &geometricErrors);
     
     // 检查是否至少有一个级别生成成功
     bool hasAnyLOD = false;
@@ -476,16 +516,19 @@ bool LODGenerator::AutoConfigureLOD(
         return false;
     }
     
-    // 配置到 LODConfig
+    // 配置到 LODConfig（索引与 LOD 级别一致：LOD0 为源网格）
     config.lodMeshes.clear();
     config.lodMeshes.reserve(4);  // LOD0, LOD1, LOD2, LOD3
+    config.lodMeshes.push_back(sourceMesh);
     
-    // LOD0 使用源网格（如果需要，可以添加，但通常不需要）
-    // config.lodMeshes.push_back(sourceMesh);  // 可选
+    config.lodGeometricErrors.clear();
+    config.lodGeometricErrors.reserve(4);
+    config.lodGeometricErrors.push_back(0.0f);
     
     // 添加生成的 LOD 级别
-    for (const auto& mesh : lodMeshes) {
-        config.lodMeshes.push_back(mesh);
+    for (size_t i = 0; i < lodMeshes.size(); ++i) {
+        config.lodMeshes.push_back(lodMeshes[i]);
+        config.lodGeometricErrors.push_back(geometricErrors[i]);
     }
     
     LOG_INFO_F("LODGenerator: Auto-configured LOD with %zu levels", lodMeshes.size());
@@ -497,12 +540,40 @@ std::vector<std::vector<Ref<Mesh>>> LODGenerator::BatchGenerateLODLevels(
     const std::vector<Ref<Mesh>>& sourceMeshes,
     const SimplifyOptions& options
 ) {
-    std::vector<std::vector<Ref<Mesh>>> allLODs;
-    allLODs.reserve(sourceMeshes.size());
+    std::vector<std::vector<Ref<Mesh>>> allLODs(sourceMeshes.size());
     
-    for (const auto& sourceMesh : sourceMeshes) {
-        auto lodMeshes = GenerateLODLevels(sourceMesh, options);
-        allLODs.push_back(std::move(lodMeshes));
+    auto& scheduler = TaskScheduler::GetInstance();
+    if (sourceMeshes.size() > 1 && scheduler.IsInitialized() && scheduler.GetWorkerCount() > 1) {
+        // 简化在工作线程并行执行；GPU 上传只能在当前（GL）线程完成
+        SimplifyOptions workerOptions = options;
+        workerOptions.uploadToGPU = false;
+        
+        std::vector<std::shared_ptr<TaskHandle>> handles;
+        handles.reserve(sourceMeshes.size());
+        for (size_t i = 0; i < sourceMeshes.size(); ++i) {
+            handles.push_back(scheduler.SubmitLambda(
+                [&allLODs, &sourceMeshes, &workerOptions, i]() {
+                    allLODs[i] = GenerateLODLevels(sourceMeshes[i], workerOptions);
+                },
+                TaskPriority::Normal,
+                "LODBatchGenerate"
+            ));
+        }
+        scheduler.WaitForAll(handles);
+        
+        if (options.uploadToGPU) {
+            for (const auto& lodMeshes : allLODs) {
+                for (const auto& mesh : lodMeshes) {
+                    if (mesh) {
+                        mesh->Upload();
+                    }
+                }
+            }
+        }
+    } else {
+        for (size_t i = 0; i < sourceMeshes.size(); ++i) {
+            allLODs[i] = GenerateLODLevels(sourceMeshes[i], options);
+        }
     }
     
     LOG_INFO_F("LODGenerator: Batch generated LOD levels for %zu meshes", sourceMeshes.size());
@@ -145,10 +145,63 @@ void LODInstancedRenderer::RenderAll(Renderer* renderer, RenderState* renderStat
     
     ScopedTimer totalTimer(m_stats.renderTimeMs);
     
+    // ✅ 处理待处理队列，添加到构建缓冲区
+    ProcessPendingInstances();
+    
+    // ✅ 先交换缓冲区（让构建缓冲区变成渲染缓冲区）
+    // 这样第一帧也能正确渲染（因为第一帧时构建缓冲区有数据，渲染缓冲区是空的）
+    std::swap(m_currentRenderBuffer, m_currentBuildBuffer);
+    
+    // ✅ 从渲染缓冲区获取要渲染的组
+    auto& renderGroups = m_groups[m_currentRenderBuffer];
+    
+    if (renderGroups.empty() && m_pendingInstances.empty()) {
+        return;
+    }
+    
+    // 排序
+    std::vector<LODInstancedGroup*> sortedGroups;
+    sortedGroups.reserve(renderGroups.size());
+    
+    for (auto& [key, group] : renderGroups) {
+        if (!group.IsEmpty()) {
+            sortedGroups.push_back(&group);
+        }
+    }
+    
+    if (sortedGroups.empty()) {
+        return;
+    }
+    
+    {
+        ScopedTimer sortTimer(m_stats.sortTimeMs);
+        
+        MaterialSortKeyLess less;
+        std::sort(sortedGroups.begin(), sortedGroups.end(),
+            [&less](const LODInstancedGroup* a, const LODInstancedGroup* b) {
+                if (less(a->sortKey, b->sortKey) || less(b->sortKey, a->sortKey)) {
+                    return less(a->sortKey, b->sortKey);
+                }
+                return static_cast<int>(a->lodLevel) < static_cast<int>(b->lodLevel);
+            });
+    }
+    
+    // 渲染
+    for (auto* group : sortedGroups) {
+        RenderGroup(group, renderer, renderState);
+    }
+    
+    // ✅ 清空构建缓冲区（为下一帧做准备）
+    // 注意：此时构建缓冲区是上一帧的渲染缓冲区，已经渲染过了，可以清空
+    for (auto& [key, group] : m_groups[m_currentBuildBuffer]) {
+        group.Clear();
+    }
+}
+
+void LODInstancedRenderer::ProcessPendingInstances() {
     // ✅ 重置当前帧处理计数
     m_currentFrameProcessed = 0;
     
-    // ✅ 处理待处理队列，添加到构建缓冲区
     size_t processCount = std::min(m_maxInstancesPerFrame, m_pendingInstances.size());
     
     // ✅ 使用TaskScheduler进行并行处理
@@ -218,67 +271,165 @@ void LODInstancedRenderer::RenderAll(Renderer* renderer, RenderState* renderStat
             );
         }
     }
+}
+
+void LODInstancedRenderer::Clear() {
+    ClearInstanceVBOs();
     
-    // ✅ 先交换缓冲区（让构建缓冲区变成渲染缓冲区）
-    // 这样第一帧也能正确渲染（因为第一帧时构建缓冲区有数据，渲染缓冲区是空的）
-    std::swap(m_currentRenderBuffer, m_currentBuildBuffer);
+    // ✅ 清空两个缓冲区
+    m_groups[0].clear();
+    m_groups[1].clear();
     
-    // ✅ 从渲染缓冲区获取要渲染的组
-    auto& renderGroups = m_groups[m_currentRenderBuffer];
+    m_pendingInstances.clear();
+    m_currentFrameProcessed = 0;
+    m_frameCounter = 0;
     
-    if (renderGroups.empty() && m_pendingInstances.empty()) {
-        return;
+    // ✅ 清空收集组注册表（释放网格/材质引用），桶保留容量供下一帧复用
+    m_gatherGroupKeys.clear();
+    m_gatherGroupIndices.clear();
+    for (auto& bucket : m_gatherBuckets) {
+        bucket.Reset();
     }
-    
-    // 排序
-    std::vector<LODInstancedGroup*> sortedGroups;
-    sortedGroups.reserve(renderGroups.size());
-    
-    for (auto& [key, group] : renderGroups) {
-        if (!group.IsEmpty()) {
-            sortedGroups.push_back(&group);
-        }
+    m_activeGatherBuckets = 0;
+}
+
+uint32_t LODInstancedRenderer::RegisterGatherGroup(
+    Ref<Mesh> mesh,
+    Ref<Material> material,
+    LODLevel lodLevel
+) {
+    if (!mesh || !material) {
+        return InstanceGatherBucket::kInvalidGroup;
     }
     
-    if (sortedGroups.empty()) {
-        return;
-    }
+    GroupKey key;
+    key.mesh = mesh;
+    key.material = material;
+    key.lodLevel = lodLevel;
+    key.sortKey = GenerateSortKey(material, mesh);
     
-    {
-        ScopedTimer sortTimer(m_stats.sortTimeMs);
-        
-        MaterialSortKeyLess less;
-        std::sort(sortedGroups.begin(), sortedGroups.end(),
-            [&less](const LODInstancedGroup* a, const LODInstancedGroup* b) {
-                if (less(a->sortKey, b->sortKey) || less(b->sortKey, a->sortKey)) {
-                    return less(a->sortKey, b->sortKey);
-                }
-                return static_cast<int>(a->lodLevel) < static_cast<int>(b->lodLevel);
-            });
+    auto [it, inserted] = m_gatherGroupIndices.try_emplace(key, static_cast<uint32_t>(m_gatherGroupKeys.size()));
+    if (inserted) {
+        m_gatherGroupKeys.push_back(key);
     }
-    
-    // 渲染
-    for (auto* group : sortedGroups) {
-        RenderGroup(group, renderer, renderState);
+    return it->second;
+}
+
+void LODInstancedRenderer::BeginGather(size_t bucketCount) {
+    bucketCount = std::max(bucketCount, size_t(1));
+    if (m_gatherBuckets.size() < bucketCount) {
+        m_gatherBuckets.resize(bucketCount);
     }
-    
-    // ✅ 清空构建缓冲区（为下一帧做准备）
-    // 注意：此时构建缓冲区是上一帧的渲染缓冲区，已经渲染过了，可以清空
-    for (auto& [key, group] : m_groups[m_currentBuildBuffer]) {
-        group.Clear();
+    for (auto& bucket : m_gatherBuckets) {
+        bucket.Reset();
     }
+    m_activeGatherBuckets = bucketCount;
 }
 
-void LODInstancedRenderer::Clear() {
-    ClearInstanceVBOs();
+InstanceGatherBucket& LODInstancedRenderer::GetGatherBucket(size_t bucketIndex) {
+    if (bucketIndex >= m_activeGatherBuckets) {
+        LOG_ERROR_F("LODInstancedRenderer::GetGatherBucket: bucket index %zu out of range (%zu), call BeginGather first",
+                    bucketIndex, m_activeGatherBuckets);
+        if (m_gatherBuckets.empty()) {
+            m_gatherBuckets.resize(1);
+        }
+        return m_gatherBuckets[0];
+    }
+    return m_gatherBuckets[bucketIndex];
+}
+
+size_t LODInstancedRenderer::EndGather() {
+    m_stats.gatherMergeTimeMs = 0.0f;
+    ScopedTimer mergeTimer(m_stats.gatherMergeTimeMs);
+    
+    // 每个（组，桶）对应一段互不重叠的拷贝
+    struct CopyRange {
+        CompactInstanceData* dst = nullptr;
+        const CompactInstanceData* src = nullptr;
+        size_t count = 0;
+    };
+    std::vector<CopyRange> copyRanges;
+    size_t totalInstances = 0;
+    
+    auto& buildGroups = m_groups[m_currentBuildBuffer];
+    const size_t bucketCount = std::min(m_activeGatherBuckets, m_gatherBuckets.size());
+    
+    for (uint32_t groupIndex = 0; groupIndex < m_gatherGroupKeys.size(); ++groupIndex) {
+        size_t groupCount = 0;
+        for (size_t b = 0; b < bucketCount; ++b) {
+            const auto& records = m_gatherBuckets[b].m_records;
+            if (groupIndex < records.size()) {
+                groupCount += records[groupIndex].size();
+            }
+        }
+        if (groupCount == 0) {
+            continue;
+        }
+        
+        const GroupKey& key = m_gatherGroupKeys[groupIndex];
+        auto& group = buildGroups[key];
+        if (group.IsEmpty()) {
+            group.mesh = key.mesh;
+            group.material = key.material;
+            group.lodLevel = key.lodLevel;
+            group.sortKey = key.sortKey;
+        }
+        
+        // CompactInstanceData 的默认构造不写内存，resize 只分配空间
+        const size_t base = group.compactInstances.size();
+        group.compactInstances.resize(base + groupCount);
+        group.MarkDirty();
+        
+        CompactInstanceData* dst = group.compactInstances.data() + base;
+        for (size_t b = 0; b < bucketCount; ++b) {
+            const auto& records = m_gatherBuckets[b].m_records;
+            if (groupIndex < records.size() && !records[groupIndex].empty()) {
+                copyRanges.push_back({dst, records[groupIndex].data(), records[groupIndex].size()});
+                dst += records[groupIndex].size();
+            }
+        }
+        totalInstances += groupCount;
+    }
     
-    // ✅ 清空两个缓冲区
-    m_groups[0].clear();
-    m_groups[1].clear();
+    auto copyRangeSpan = [&copyRanges](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            std::memcpy(copyRanges[i].dst, copyRanges[i].src, copyRanges[i].count * sizeof(CompactInstanceData));
+        }
+    };
     
-    m_pendingInstances.clear();
-    m_currentFrameProcessed = 0;
-    m_frameCounter = 0;
+    // ✅ 大量实例时按拷贝量均分到 TaskScheduler 工作线程
+    const size_t minInstancesForParallel = 65536;
+    if (totalInstances >= minInstancesForParallel && copyRanges.size() > 1 &&
+        TaskScheduler::GetInstance().IsInitialized()) {
+        const size_t numTasks = std::max(size_t(1), TaskScheduler::GetInstance().GetWorkerCount());
+        const size_t instancesPerTask = (totalInstances + numTasks - 1) / numTasks;
+        
+        std::vector<std::shared_ptr<TaskHandle>> taskHandles;
+        taskHandles.reserve(numTasks);
+        
+        size_t begin = 0;
+        while (begin < copyRanges.size()) {
+            size_t end = begin;
+            size_t taskInstances = 0;
+            while (end < copyRanges.size() && (end == begin || taskInstances < instancesPerTask)) {
+                taskInstances += copyRanges[end].count;
+                ++end;
+            }
+            taskHandles.push_back(TaskScheduler::GetInstance().SubmitLambda(
+                [&copyRangeSpan, begin, end]() { copyRangeSpan(begin, end); },
+                TaskPriority::High,
+                "LODGatherMerge"
+            ));
+            begin = end;
+        }
+        
+        TaskScheduler::GetInstance().WaitForAll(taskHandles);
+    } else {
+        copyRangeSpan(0, copyRanges.size());
+    }
+    
+    m_stats.gatheredInstances = totalInstances;
+    return totalInstances;
 }
 
 LODInstancedRenderer::Stats LODInstancedRenderer::GetStats() const {
@@ -296,6 +447,7 @@ LODInstancedRenderer::Stats LODInstancedRenderer::GetStats() const {
     stats.lod1Instances = 0;
     stats.lod2Instances = 0;
     stats.lod3Instances = 0;
+    stats.impostorInstances = 0;
     stats.culledCount = 0;
     
     for (const auto& [key, group] : renderGroups) {
@@ -316,6 +468,9 @@ LODInstancedRenderer::Stats LODInstancedRenderer::GetStats() const {
             case LODLevel::LOD3:
                 stats.lod3Instances += instanceCount;
                 break;
+            case LODLevel::Impostor:
+                stats.impostorInstances += instanceCount;
+                break;
             case LODLevel::Culled:
                 stats.culledCount += instanceCount;
                 break;
@@ -332,7 +487,13 @@ LODInstancedRenderer::Stats LODInstancedRenderer::GetStats() const {
         for (const auto& [key, group] : m_groups[i]) {
             stats.totalAllocatedMemory += 
                 group.instances.capacity() * sizeof(InstanceData) +
-                group.entities.capacity() * sizeof(ECS::EntityID);
+                group.entities.capacity() * sizeof(ECS::EntityID) +
+                group.compactInstances.capacity() * sizeof(CompactInstanceData);
+        }
+    }
+    for (const auto& bucket : m_gatherBuckets) {
+        for (const auto& records : bucket.m_records) {
+            stats.totalAllocatedMemory += records.capacity() * sizeof(CompactInstanceData);
         }
     }
     
@@ -440,7 +601,7 @@ void LODInstancedRenderer::RenderGroup(
     Renderer* renderer,
     RenderState* renderState
 ) {
-    if (!group || !group->mesh || !group->material || group->instances.empty()) {
+    if (!group || !group->mesh || !group->material || group->IsEmpty()) {
         return;
     }
     
@@ -462,17 +623,18 @@ void LODInstancedRenderer::RenderGroup(
         if (auto uniformMgr = shader->GetUniformManager()) {
             uniformMgr->SetBool("uHasInstanceData", true);
             uniformMgr->SetMatrix4("uModel", Matrix4::Identity());
+            group->mesh->ApplyVertexLayoutUniforms(uniformMgr);
         }
     }
     
     // 仅在需要时上传数据
     if (group->NeedsUpload()) {
         ScopedTimer uploadTimer(m_stats.uploadTimeMs);
-        UploadInstanceData(group->instances, group->mesh);
+        UploadInstanceData(group->instances, group->compactInstances, group->mesh);
         group->MarkUploaded();
     }
     
-    size_t instanceCount = group->instances.size();
+    size_t instanceCount = group->GetInstanceCount();
     auto& instanceVBOs = GetOrCreateInstanceVBOs(group->mesh, instanceCount);
     
     // 获取或创建实例化VAO（传入material以查询着色器中的实例化属性location）
@@ -497,7 +659,7 @@ void LODInstancedRenderer::RenderGroup(
         // 使用索引绘制实例
         glDrawElementsInstanced(GL_TRIANGLES, 
                                 static_cast<GLsizei>(indexCount), 
-                                GL_UNSIGNED_INT, 
+                                group->mesh->GetGLIndexType(),  // 与 Mesh EBO 格式一致（可能为 16 位）
                                 0, 
                                 static_cast<GLsizei>(instanceCount));
     } else {
@@ -538,22 +700,27 @@ void LODInstancedRenderer::RenderGroup(
 
 void LODInstancedRenderer::UploadInstanceData(
     const std::vector<InstanceData>& instances,
+    const std::vector<CompactInstanceData>& compactInstances,
     Ref<Mesh> mesh
 ) {
-    if (instances.empty() || !mesh) {
+    const size_t instanceCount = instances.size() + compactInstances.size();
+    if (instanceCount == 0 || !mesh) {
         return;
     }
     
     // 提取矩阵数据
     std::vector<Matrix4> matrices;
-    matrices.reserve(instances.size());
+    matrices.reserve(instanceCount);
     for (const auto& instance : instances) {
         matrices.push_back(instance.worldMatrix);
     }
+    for (const auto& instance : compactInstances) {
+        matrices.push_back(instance.ToMatrix4());
+    }
     
     // 提取颜色数据
     std::vector<Vector4> colors;
-    colors.reserve(instances.size());
+    colors.reserve(instanceCount);
     for (const auto& instance : instances) {
         colors.push_back(Vector4(
             instance.instanceColor.r,
@@ -562,13 +729,17 @@ void LODInstancedRenderer::UploadInstanceData(
             instance.instanceColor.a
         ));
     }
+    for (const auto& instance : compactInstances) {
+        colors.push_back(CompactInstanceData::UnpackColor(instance.packedColor));
+    }
     
-    // 提取自定义参数
+    // 提取自定义参数（紧凑记录不携带参数）
     std::vector<Vector4> customParams;
-    customParams.reserve(instances.size());
+    customParams.reserve(instanceCount);
     for (const auto& instance : instances) {
         customParams.push_back(instance.customParams);
     }
+    customParams.resize(instanceCount, Vector4::Zero());
     
     // 上传到 GPU
     UploadInstanceMatrices(matrices, mesh);
@@ -21,6 +21,7 @@
 #include "render/lod_loader.h"
 #include "render/mesh_loader.h"
 #include "render/lod_generator.h"
+#include "render/lod_cache.h"
 #include "render/file_utils.h"
 #include "render/logger.h"
 #include <filesystem>
@@ -257,9 +258,13 @@ std::vector<Ref<Mesh>> LODLoader::LoadLODMeshesFromFiles(
 
 std::vector<Ref<Mesh>> LODLoader::GenerateLODMeshes(
     Ref<Mesh> baseMesh,
-    const LODLoadOptions& options
+    const LODLoadOptions& options,
+    std::vector<float>* outGeometricErrors
 ) {
     std::vector<Ref<Mesh>> lodMeshes(4);  // LOD0, LOD1, LOD2, LOD3
+    if (outGeometricErrors) {
+        outGeometricErrors->assign(4, -1.0f);
+    }
     
     if (!baseMesh) {
         LOG_ERROR("LODLoader::GenerateLODMeshes: baseMesh is null");
@@ -269,8 +274,37 @@ std::vector<Ref<Mesh>> LODLoader::GenerateLODMeshes(
     // LOD0: 使用原始网格
     lodMeshes[0] = baseMesh;
     
-    // 生成 LOD1-LOD3
-    auto generated = LODGenerator::GenerateLODLevels(baseMesh, options.simplifyOptions);
+    // 生成 LOD1-LOD3（启用磁盘缓存时优先从缓存读取）
+    std::vector<float> generatedErrors;
+    std::vector<Ref<Mesh>> generated;
+    bool fromCache = false;
+    uint64_t cacheKey = 0;
+    
+    if (options.loadStrategy.useDiskCache) {
+        cacheKey = LODCache::BuildKey(ComputeSourceHash(baseMesh, options), options.simplifyOptions);
+        fromCache = LODCache::GetInstance().Load(cacheKey, generated, generatedErrors);
+        if (fromCache && options.simplifyOptions.uploadToGPU) {
+            for (const auto& mesh : generated) {
+                if (mesh) {
+                    mesh->Upload();
+                }
+            }
+        }
+    }
+    
+    if (!fromCache) {
+        generated = LODGenerator::GenerateLODLevels(baseMesh, options.simplifyOptions, &generatedErrors);
+        if (options.loadStrategy.useDiskCache) {
+            LODCache::GetInstance().Store(cacheKey, generated, generatedErrors);
+        }
+    }
+    
+    if (outGeometricErrors) {
+        (*outGeometricErrors)[0] = 0.0f;
+        for (size_t i = 0; i < generatedErrors.size() && i < 3; ++i) {
+            (*outGeometricErrors)[i + 1] = generatedErrors[i];
+        }
+    }
     
     // generated 返回的是 [LOD1, LOD2, LOD3]
     if (generated.size() >= 3) {
@@ -292,7 +326,8 @@ std::vector<Ref<Mesh>> LODLoader::GenerateLODMeshes(
         }
     }
     
-    LOG_INFO_F("LODLoader::GenerateLODMeshes: Generated %zu/%zu LOD meshes", successCount - 1, 3);  // -1 因为 LOD0 不算生成
+    LOG_INFO_F("LODLoader::GenerateLODMeshes: %s %zu/%d LOD meshes",
+               fromCache ? "Loaded from cache" : "Generated", successCount - 1, 3);  // -1 因为 LOD0 不算生成
     
     return lodMeshes;
 }
@@ -321,7 +356,7 @@ LODConfig LODLoader::LoadLODConfig(
         }
         
         Ref<Mesh> sourceMesh = baseMesh ? baseMesh : options.baseMesh;
-        config.lodMeshes = GenerateLODMeshes(sourceMesh, options);
+        config.lodMeshes = GenerateLODMeshes(sourceMesh, options, &config.lodGeometricErrors);
         
         LOG_INFO("LODLoader::LoadLODConfig: Generated LOD meshes automatically");
     } else {
@@ -352,5 +387,64 @@ LODConfig LODLoader::LoadLODConfig(
     return config;
 }
 
+uint64_t LODLoader::ComputeSourceHash(Ref<Mesh> baseMesh, const LODLoadOptions& options) {
+    const bool hasFile = !options.basePath.empty() && FileUtils::FileExists(options.basePath);
+    return LODCache::HashSource(hasFile ? options.basePath : std::string(),
+                                baseMesh ? baseMesh : options.baseMesh);
+}
+
+LODConfig LODLoader::LoadLODConfigAsync(
+    Ref<Mesh> baseMesh,
+    const LODLoadOptions& options,
+    std::function<void(const LODConfig&)> onReady,
+    float priority
+) {
+    Ref<Mesh> sourceMesh = baseMesh ? baseMesh : options.baseMesh;
+    
+    if (!options.autoGenerateLOD || !options.loadStrategy.asyncLoad || !sourceMesh) {
+        LODConfig config = LoadLODConfig(baseMesh, options);
+        if (onReady) {
+            onReady(config);
+        }
+        return config;
+    }
+    
+    // 初始配置：只有 LOD0，生成完成前所有级别都回退到源网格
+    LODConfig config;
+    config.enabled = true;
+    config.distanceThresholds = options.distanceThresholds.empty()
+        ? std::vector<float>{50.0f, 150.0f, 500.0f, 1000.0f}
+        : options.distanceThresholds;
+    config.lodMeshes = {sourceMesh};
+    config.lodGeometricErrors = {0.0f};
+    
+    // 源文件哈希需要读取整个文件，交给工作线程计算（不阻塞调用线程）
+    LODConfig pendingConfig = config;
+    AsyncResourceLoader::GetInstance().GenerateLODAsync(
+        sourceMesh,
+        options.simplifyOptions,
+        0,
+        options.loadStrategy.useDiskCache,
+        [pendingConfig, onReady](const LODGenerateResult& result) mutable {
+            if (!result.IsSuccess()) {
+                LOG_WARNING_F("LODLoader::LoadLODConfigAsync: LOD generation failed: %s",
+                              result.errorMessage.c_str());
+                return;
+            }
+            pendingConfig.lodMeshes = result.lodMeshes;
+            pendingConfig.lodGeometricErrors = result.geometricErrors;
+            LOG_INFO_F("LODLoader::LoadLODConfigAsync: LOD meshes ready (%s)",
+                       result.fromCache ? "cache" : "generated");
+            if (onReady) {
+                onReady(pendingConfig);
+            }
+        },
+        priority,
+        options.basePath
+    );
+    
+    return config;
+}
+
 } // namespace Render
 
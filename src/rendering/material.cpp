@@ -22,6 +22,9 @@
 #include "render/shader.h"
 #include "render/texture.h"
 #include "render/render_state.h"
+#include "render/pipeline_state.h"
+#include "render/std140_layout.h"
+#include "render/uniform_buffer.h"
 #include "render/logger.h"
 #include "render/error.h"
 #include <utility>
@@ -36,6 +39,23 @@ namespace Render {
 
 namespace {
 constexpr size_t kMaxUniformVectorArraySize = 64;
+
+/// 材质接管混合/剔除/深度测试/深度写入（以及可选的程序绑定），深度函数由渲染层决定
+PipelineStateId AcquireMaterialPipelineState(BlendMode blendMode, CullFace cullFace,
+                                             bool depthTest, bool depthWrite, uint32_t program) {
+    PipelineStateDesc desc;
+    desc.fields = PipelineStateFields_Blend | PipelineStateFields_CullFace |
+                  PipelineStateFields_DepthTest | PipelineStateFields_DepthWrite;
+    desc.blendMode = blendMode;
+    desc.cullFace = cullFace;
+    desc.depthTest = depthTest;
+    desc.depthWrite = depthWrite;
+    if (program != 0) {
+        desc.fields |= PipelineStateFields_Program;
+        desc.program = program;
+    }
+    return PipelineStateRegistry::GetInstance().Acquire(desc);
+}
 }
 
 std::atomic<uint32_t> Material::s_nextStableID{1};
@@ -94,6 +114,8 @@ Material::Material(Material&& other) noexcept {
     m_depthWrite = other.m_depthWrite;
     m_stableID = other.m_stableID;
     other.m_stableID = 0;
+    m_uniformBuffer = std::move(other.m_uniformBuffer);
+    m_uniformBufferGeneration = 0;
     m_cacheDirty = true;
     m_cachedState.reset();
 }
@@ -126,6 +148,8 @@ Material& Material::operator=(Material&& other) noexcept {
         m_depthWrite = other.m_depthWrite;
         m_stableID = other.m_stableID;
         other.m_stableID = 0;
+        m_uniformBuffer = std::move(other.m_uniformBuffer);
+        m_uniformBufferGeneration = 0;
     }
     m_cacheDirty = true;
     m_cachedState.reset();
@@ -157,6 +181,23 @@ std::shared_ptr<Material::CachedState> Material::EnsureCachedStateLocked() {
     snapshot->depthTest = m_depthTest;
     snapshot->depthWrite = m_depthWrite;
     snapshot->name = m_name;
+    snapshot->pipelineProgram = m_shader ? m_shader->GetProgramID() : 0;
+    snapshot->pipelineState = AcquireMaterialPipelineState(
+        m_blendMode, m_cullFace, m_depthTest, m_depthWrite, snapshot->pipelineProgram);
+    snapshot->generation = ++m_snapshotGeneration;
+
+    MaterialUniformData blockData;
+    blockData.ambient = m_ambientColor;
+    blockData.diffuse = m_diffuseColor;
+    blockData.specular = m_specularColor;
+    blockData.emissive = m_emissiveColor;
+    blockData.shininess = m_shininess;
+    blockData.opacity = m_opacity;
+    blockData.metallic = m_metallic;
+    blockData.roughness = m_roughness;
+    Std140Writer blockWriter(GetMaterialUniformLayout());
+    PackMaterialUniforms(blockData, blockWriter);
+    snapshot->uniformBlock = blockWriter.GetBuffer();
 
     snapshot->textures.reserve(m_textures.size());
     for (const auto& entry : m_textures) {
@@ -519,13 +560,18 @@ void Material::Bind(RenderState* renderState) {
     }
 
     auto shader = snapshot->shader;
-    shader->Use();
 
     if (renderState) {
-        renderState->SetBlendMode(snapshot->blendMode);
-        renderState->SetCullFace(snapshot->cullFace);
-        renderState->SetDepthTest(snapshot->depthTest);
-        renderState->SetDepthWrite(snapshot->depthWrite);
+        // 着色器热重载后程序 ID 会变化，此时快照中的管线状态已过期
+        PipelineStateId pipelineState = snapshot->pipelineState;
+        if (shader->GetProgramID() != snapshot->pipelineProgram) {
+            pipelineState = AcquireMaterialPipelineState(snapshot->blendMode, snapshot->cullFace,
+                                                         snapshot->depthTest, snapshot->depthWrite,
+                                                         shader->GetProgramID());
+        }
+        renderState->ApplyPipelineState(pipelineState);
+    } else {
+        shader->Use();
     }
 
     auto* uniformMgr = shader->GetUniformManager();
@@ -534,63 +580,26 @@ void Material::Bind(RenderState* renderState) {
         return;
     }
 
-    try {
-        if (uniformMgr->HasUniform("uAmbientColor")) {
-            uniformMgr->SetColor("uAmbientColor", snapshot->ambientColor);
-        }
-        if (uniformMgr->HasUniform("uDiffuseColor")) {
-            uniformMgr->SetColor("uDiffuseColor", snapshot->diffuseColor);
-        }
-        if (uniformMgr->HasUniform("uSpecularColor")) {
-            uniformMgr->SetColor("uSpecularColor", snapshot->specularColor);
-        }
-        if (uniformMgr->HasUniform("uShininess")) {
-            uniformMgr->SetFloat("uShininess", snapshot->shininess);
-        }
-
-        if (uniformMgr->HasUniform("material.ambient")) {
-            uniformMgr->SetColor("material.ambient", snapshot->ambientColor);
-        }
-        if (uniformMgr->HasUniform("material.diffuse")) {
-            uniformMgr->SetColor("material.diffuse", snapshot->diffuseColor);
-        }
-        if (uniformMgr->HasUniform("material.specular")) {
-            uniformMgr->SetColor("material.specular", snapshot->specularColor);
-        }
-        if (uniformMgr->HasUniform("material.emissive")) {
-            uniformMgr->SetColor("material.emissive", snapshot->emissiveColor);
-        }
-        if (uniformMgr->HasUniform("material.shininess")) {
-            uniformMgr->SetFloat("material.shininess", snapshot->shininess);
-        }
-        if (uniformMgr->HasUniform("material.opacity")) {
-            uniformMgr->SetFloat("material.opacity", snapshot->opacity);
-        }
-        if (uniformMgr->HasUniform("material.metallic")) {
-            uniformMgr->SetFloat("material.metallic", snapshot->metallic);
-        }
-        if (uniformMgr->HasUniform("material.roughness")) {
-            uniformMgr->SetFloat("material.roughness", snapshot->roughness);
-        }
-
-        if (uniformMgr->HasUniform("uColor")) {
-            uniformMgr->SetColor("uColor", snapshot->diffuseColor);
-        }
+    // 声明了 MaterialData 块的着色器直接使用材质 UBO（快照变化时才重新上传）
+    if (uniformMgr->HasUniformBlock(kMaterialUniformBlockName)) {
+        BindUniformBlock(*snapshot, renderState);
+    }
 
-        if (uniformMgr->HasUniform("uUseTexture")) {
-            const bool hasTexture = std::any_of(snapshot->textures.begin(), snapshot->textures.end(),
-                [](const auto& pair) {
-                    return pair.first == "diffuseMap" || pair.first == "uTexture0";
-                });
-            uniformMgr->SetBool("uUseTexture", hasTexture);
-        }
+    // 句柄表按程序解析一次，之后每次绑定只遍历句柄，不做字符串查找
+    auto table = snapshot->uniformTable;
+    if (!table || table->program != shader->GetProgramID() || table->manager != uniformMgr) {
+        table = BuildUniformTable(*snapshot, *uniformMgr, shader->GetProgramID());
+        snapshot->uniformTable = table;
+    }
 
-        if (uniformMgr->HasUniform("uUseVertexColor")) {
-            uniformMgr->SetBool("uUseVertexColor", true);
-        }
-    } catch (const std::exception& e) {
-        LOG_ERROR("Exception setting material properties: " + std::string(e.what()));
-        return;
+    for (const auto& entry : table->propertyColors) {
+        uniformMgr->SetColor(entry.first, entry.second);
+    }
+    for (const auto& entry : table->propertyFloats) {
+        uniformMgr->SetFloat(entry.first, entry.second);
+    }
+    for (const auto& entry : table->propertyInts) {
+        uniformMgr->SetInt(entry.first, entry.second);
     }
 
     try {
@@ -636,65 +645,145 @@ void Material::Bind(RenderState* renderState) {
             }
         }
 
-        if (uniformMgr->HasUniform("hasDiffuseMap")) {
-            uniformMgr->SetBool("hasDiffuseMap", hasDiffuse);
+        uniformMgr->SetBool(table->hasDiffuseMap, hasDiffuse);
+        uniformMgr->SetBool(table->hasNormalMap, hasNormal);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Exception binding textures: " + std::string(e.what()));
+    }
+
+    for (const auto& entry : table->ints) {
+        uniformMgr->SetInt(entry.first, entry.second);
+    }
+    for (const auto& entry : table->floats) {
+        uniformMgr->SetFloat(entry.first, entry.second);
+    }
+    for (const auto& entry : table->vector2s) {
+        uniformMgr->SetVector2(entry.first, entry.second);
+    }
+    for (const auto& entry : table->vector3s) {
+        uniformMgr->SetVector3(entry.first, entry.second);
+    }
+    for (const auto& entry : table->vector4s) {
+        uniformMgr->SetVector4(entry.first, entry.second);
+    }
+    for (const auto& entry : table->matrix4s) {
+        uniformMgr->SetMatrix4(entry.first, entry.second);
+    }
+    for (const auto& entry : table->vector2Arrays) {
+        const auto& values = snapshot->vector2ArrayParams[entry.second].second;
+        uniformMgr->SetVector2Array(entry.first, values.data(), static_cast<uint32_t>(values.size()));
+    }
+    for (const auto& entry : table->colorArrays) {
+        const auto& values = snapshot->colorArrayParams[entry.second].second;
+        uniformMgr->SetColorArray(entry.first, values.data(), static_cast<uint32_t>(values.size()));
+    }
+}
+
+std::shared_ptr<Material::UniformTable> Material::BuildUniformTable(const CachedState& snapshot,
+                                                                    const UniformManager& uniformMgr,
+                                                                    uint32_t program) {
+    auto table = std::make_shared<UniformTable>();
+    table->program = program;
+    table->manager = &uniformMgr;
+
+    auto addColor = [&](const char* name, const Color& value) {
+        UniformHandle handle = uniformMgr.GetHandle(name);
+        if (handle.IsValid()) {
+            table->propertyColors.emplace_back(handle, value);
         }
-        if (uniformMgr->HasUniform("hasNormalMap")) {
-            uniformMgr->SetBool("hasNormalMap", hasNormal);
+    };
+    auto addFloat = [&](const char* name, float value) {
+        UniformHandle handle = uniformMgr.GetHandle(name);
+        if (handle.IsValid()) {
+            table->propertyFloats.emplace_back(handle, value);
         }
+    };
+
+    addColor("uAmbientColor", snapshot.ambientColor);
+    addColor("uDiffuseColor", snapshot.diffuseColor);
+    addColor("uSpecularColor", snapshot.specularColor);
+    addFloat("uShininess", snapshot.shininess);
+
+    addColor("material.ambient", snapshot.ambientColor);
+    addColor("material.diffuse", snapshot.diffuseColor);
+    addColor("material.specular", snapshot.specularColor);
+    addColor("material.emissive", snapshot.emissiveColor);
+    addFloat("material.shininess", snapshot.shininess);
+    addFloat("material.opacity", snapshot.opacity);
+    addFloat("material.metallic", snapshot.metallic);
+    addFloat("material.roughness", snapshot.roughness);
+
+    addColor("uColor", snapshot.diffuseColor);
+
+    if (UniformHandle handle = uniformMgr.GetHandle("uUseTexture"); handle.IsValid()) {
+        const bool hasTexture = std::any_of(snapshot.textures.begin(), snapshot.textures.end(),
+            [](const auto& pair) {
+                return pair.first == "diffuseMap" || pair.first == "uTexture0";
+            });
+        table->propertyInts.emplace_back(handle, hasTexture ? 1 : 0);
+    }
+    if (UniformHandle handle = uniformMgr.GetHandle("uUseVertexColor"); handle.IsValid()) {
+        table->propertyInts.emplace_back(handle, 1);
+    }
 
-        for (const auto& pair : snapshot->intParams) {
-            if (uniformMgr->HasUniform(pair.first)) {
-                uniformMgr->SetInt(pair.first, pair.second);
-            }
-        }
+    table->hasDiffuseMap = uniformMgr.GetHandle("hasDiffuseMap");
+    table->hasNormalMap = uniformMgr.GetHandle("hasNormalMap");
 
-        for (const auto& pair : snapshot->floatParams) {
-            if (uniformMgr->HasUniform(pair.first)) {
-                uniformMgr->SetFloat(pair.first, pair.second);
+    auto collect = [&uniformMgr](const auto& params, auto& out) {
+        for (const auto& pair : params) {
+            UniformHandle handle = uniformMgr.GetHandle(pair.first);
+            if (handle.IsValid()) {
+                out.emplace_back(handle, pair.second);
             }
         }
-
-        for (const auto& pair : snapshot->vector2Params) {
-            if (uniformMgr->HasUniform(pair.first)) {
-                uniformMgr->SetVector2(pair.first, pair.second);
-            }
+    };
+    collect(snapshot.intParams, table->ints);
+    collect(snapshot.floatParams, table->floats);
+    collect(snapshot.vector2Params, table->vector2s);
+    collect(snapshot.vector3Params, table->vector3s);
+    collect(snapshot.vector4Params, table->vector4s);
+    collect(snapshot.matrix4Params, table->matrix4s);
+
+    // 数组 uniform 可能只以 "name[0]" 形式暴露
+    auto resolveArray = [&uniformMgr](const std::string& name) {
+        UniformHandle handle = uniformMgr.GetHandle(name);
+        if (!handle.IsValid() && name.find('[') == std::string::npos) {
+            handle = uniformMgr.GetHandle(name + "[0]");
         }
-
-        for (const auto& pair : snapshot->vector3Params) {
-            if (uniformMgr->HasUniform(pair.first)) {
-                uniformMgr->SetVector3(pair.first, pair.second);
-            }
+        return handle;
+    };
+    for (size_t i = 0; i < snapshot.vector2ArrayParams.size(); ++i) {
+        const auto& pair = snapshot.vector2ArrayParams[i];
+        UniformHandle handle = resolveArray(pair.first);
+        if (!pair.second.empty() && handle.IsValid()) {
+            table->vector2Arrays.emplace_back(handle, i);
         }
-
-        for (const auto& pair : snapshot->vector4Params) {
-            if (uniformMgr->HasUniform(pair.first)) {
-                uniformMgr->SetVector4(pair.first, pair.second);
-            }
+    }
+    for (size_t i = 0; i < snapshot.colorArrayParams.size(); ++i) {
+        const auto& pair = snapshot.colorArrayParams[i];
+        UniformHandle handle = resolveArray(pair.first);
+        if (!pair.second.empty() && handle.IsValid()) {
+            table->colorArrays.emplace_back(handle, i);
         }
+    }
 
-        for (const auto& pair : snapshot->matrix4Params) {
-            if (uniformMgr->HasUniform(pair.first)) {
-                uniformMgr->SetMatrix4(pair.first, pair.second);
-            }
-        }
+    return table;
+}
 
-        for (const auto& pair : snapshot->vector2ArrayParams) {
-            if (!pair.second.empty() && uniformMgr->HasUniform(pair.first)) {
-                uniformMgr->SetVector2Array(pair.first, pair.second.data(),
-                    static_cast<uint32_t>(pair.second.size()));
-            }
-        }
+void Material::BindUniformBlock(const CachedState& snapshot, RenderState* renderState) {
+    if (snapshot.uniformBlock.empty()) {
+        return;
+    }
 
-        for (const auto& pair : snapshot->colorArrayParams) {
-            if (!pair.second.empty() && uniformMgr->HasUniform(pair.first)) {
-                uniformMgr->SetColorArray(pair.first, pair.second.data(),
-                    static_cast<uint32_t>(pair.second.size()));
-            }
-        }
-    } catch (const std::exception& e) {
-        LOG_ERROR("Exception setting texture/custom parameters: " + std::string(e.what()));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_uniformBuffer) {
+        m_uniformBuffer = std::make_unique<UniformBuffer>();
+    }
+    if (m_uniformBufferGeneration != snapshot.generation) {
+        m_uniformBuffer->Upload(snapshot.uniformBlock.data(), snapshot.uniformBlock.size(), renderState);
+        m_uniformBufferGeneration = snapshot.generation;
     }
+    m_uniformBuffer->BindBase(kMaterialUniformBinding);
 }
 
 void Material::Unbind() {
@@ -710,10 +799,8 @@ void Material::ApplyRenderState(RenderState* renderState) {
         return;
     }
     
-    renderState->SetBlendMode(m_blendMode);
-    renderState->SetCullFace(m_cullFace);
-    renderState->SetDepthTest(m_depthTest);
-    renderState->SetDepthWrite(m_depthWrite);
+    renderState->ApplyPipelineState(
+        AcquireMaterialPipelineState(m_blendMode, m_cullFace, m_depthTest, m_depthWrite, 0));
 }
 
 bool Material::IsValid() const {
@@ -19,9 +19,12 @@
  * For commercial licensing, please contact: 2052046346@qq.com
  */
 #include "render/mesh.h"
+#include "render/meshlet.h"
+#include "render/mesh_kernels.h"
 #include "render/logger.h"
 #include "render/error.h"
 #include "render/gl_thread_checker.h"
+#include "render/uniform_manager.h"
 #include <algorithm>
 #include <cmath>
 #include <unordered_map>
@@ -29,6 +32,19 @@
 
 namespace Render {
 
+namespace {
+
+AABB ComputeVertexBounds(const std::vector<Vertex>& vertices) {
+    AABB bounds(vertices[0].position, vertices[0].position);
+    for (size_t i = 1; i < vertices.size(); ++i) {
+        bounds.min = bounds.min.cwiseMin(vertices[i].position);
+        bounds.max = bounds.max.cwiseMax(vertices[i].position);
+    }
+    return bounds;
+}
+
+} // anonymous namespace
+
 // ============================================================================
 // Mesh 实现
 // ============================================================================
@@ -42,9 +58,9 @@ Mesh::Mesh()
 {
 }
 
-Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
-    : m_Vertices(vertices)
-    , m_Indices(indices)
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices)
+    : m_Vertices(std::move(vertices))
+    , m_Indices(std::move(indices))
     , m_VAO(0)
     , m_VBO(0)
     , m_EBO(0)
@@ -68,12 +84,33 @@ Mesh::Mesh(Mesh&& other) noexcept {
     m_Uploaded = other.m_Uploaded;
     m_uploadState.store(other.m_uploadState.load(std::memory_order_acquire), 
                         std::memory_order_release);
+    m_cachedBounds = other.m_cachedBounds;
+    m_boundsDirty = other.m_boundsDirty;
+    m_meshlets = std::move(other.m_meshlets);
+    m_meshletEBO = other.m_meshletEBO;
+    m_meshletIndexFormat = other.m_meshletIndexFormat;
+    m_meshletEBODirty = other.m_meshletEBODirty;
+    m_vertexLayout = other.m_vertexLayout;
+    m_uploadedVertexLayout = other.m_uploadedVertexLayout;
+    m_vertexQuantization = other.m_vertexQuantization;
+    m_uploadedIndexFormat = other.m_uploadedIndexFormat;
+    m_cpuResidency = other.m_cpuResidency;
+    m_cpuDataSource = std::move(other.m_cpuDataSource);
+    m_positions = std::move(other.m_positions);
+    m_verticesReleased = other.m_verticesReleased;
+    m_indicesReleased = other.m_indicesReleased;
+    m_releasedVertexCount = other.m_releasedVertexCount;
+    m_releasedIndexCount = other.m_releasedIndexCount;
+    other.InvalidateBoundsNoLock();
     
     other.m_VAO = 0;
     other.m_VBO = 0;
     other.m_EBO = 0;
+    other.m_meshletEBO = 0;
     other.m_Uploaded = false;
     other.m_uploadState.store(UploadState::NotUploaded, std::memory_order_release);
+    other.m_verticesReleased = false;
+    other.m_indicesReleased = false;
 }
 
 Mesh& Mesh::operator=(Mesh&& other) noexcept {
@@ -97,6 +134,11 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
             glDeleteBuffers(1, &m_EBO);
             m_EBO = 0;
         }
+        if (m_meshletEBO != 0) {
+            GL_THREAD_CHECK();
+            glDeleteBuffers(1, &m_meshletEBO);
+            m_meshletEBO = 0;
+        }
         
         m_Vertices = std::move(other.m_Vertices);
         m_Indices = std::move(other.m_Indices);
@@ -106,26 +148,58 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
         m_Uploaded = other.m_Uploaded;
         m_uploadState.store(other.m_uploadState.load(std::memory_order_acquire), 
                             std::memory_order_release);
+        m_cachedBounds = other.m_cachedBounds;
+        m_boundsDirty = other.m_boundsDirty;
+        m_boundsVersion.store(NextBoundsVersion(), std::memory_order_release);
+        m_meshlets = std::move(other.m_meshlets);
+        m_meshletEBO = other.m_meshletEBO;
+        m_meshletIndexFormat = other.m_meshletIndexFormat;
+        m_meshletEBODirty = other.m_meshletEBODirty;
+        m_vertexLayout = other.m_vertexLayout;
+        m_uploadedVertexLayout = other.m_uploadedVertexLayout;
+        m_vertexQuantization = other.m_vertexQuantization;
+        m_uploadedIndexFormat = other.m_uploadedIndexFormat;
+        m_cpuResidency = other.m_cpuResidency;
+        m_cpuDataSource = std::move(other.m_cpuDataSource);
+        m_positions = std::move(other.m_positions);
+        m_verticesReleased = other.m_verticesReleased;
+        m_indicesReleased = other.m_indicesReleased;
+        m_releasedVertexCount = other.m_releasedVertexCount;
+        m_releasedIndexCount = other.m_releasedIndexCount;
+        other.InvalidateBoundsNoLock();
         
         other.m_VAO = 0;
         other.m_VBO = 0;
         other.m_EBO = 0;
+        other.m_meshletEBO = 0;
         other.m_Uploaded = false;
         other.m_uploadState.store(UploadState::NotUploaded, std::memory_order_release);
+        other.m_verticesReleased = false;
+        other.m_indicesReleased = false;
     }
     return *this;
 }
 
 void Mesh::SetVertices(const std::vector<Vertex>& vertices) {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    RestoreCPUDataNoLock();  // 保留的索引可能已释放，替换顶点前先读回
     m_Vertices = vertices;
+    m_positions.clear();
+    m_verticesReleased = false;
+    m_cpuDataSource = nullptr;
+    InvalidateBoundsNoLock();
+    m_meshlets.reset();
     m_Uploaded = false;  // 需要重新上传
     m_uploadState.store(UploadState::NotUploaded, std::memory_order_release);
 }
 
 void Mesh::SetIndices(const std::vector<uint32_t>& indices) {
     std::lock_guard<std::mutex> lock(m_Mutex);
+    RestoreCPUDataNoLock();  // 保留的顶点可能已释放，替换索引前先读回
     m_Indices = indices;
+    m_indicesReleased = false;
+    m_cpuDataSource = nullptr;
+    m_meshlets.reset();
     m_Uploaded = false;  // 需要重新上传
     m_uploadState.store(UploadState::NotUploaded, std::memory_order_release);
 }
@@ -134,6 +208,12 @@ void Mesh::SetData(const std::vector<Vertex>& vertices, const std::vector<uint32
     std::lock_guard<std::mutex> lock(m_Mutex);
     m_Vertices = vertices;
     m_Indices = indices;
+    m_positions.clear();
+    m_verticesReleased = false;
+    m_indicesReleased = false;
+    m_cpuDataSource = nullptr;
+    InvalidateBoundsNoLock();
+    m_meshlets.reset();
     m_Uploaded = false;  // 需要重新上传
     m_uploadState.store(UploadState::NotUploaded, std::memory_order_release);
 }
@@ -156,33 +236,42 @@ void Mesh::UpdateVertices(const std::vector<Vertex>& vertices, size_t offset) {
     }
     
     // 检查 offset 是否越界
-    if (offset >= m_Vertices.size()) {
+    const size_t vertexCount = VertexCountNoLock();
+    if (offset >= vertexCount) {
         HANDLE_ERROR(RENDER_ERROR(ErrorCode::OutOfRange, 
                                  "Mesh::UpdateVertices: Offset " + std::to_string(offset) + 
-                                 " exceeds vertex count " + std::to_string(m_Vertices.size())));
+                                 " exceeds vertex count " + std::to_string(vertexCount)));
         return;
     }
     
     // 检查 offset + size 是否越界
-    if (offset + vertices.size() > m_Vertices.size()) {
+    if (offset + vertices.size() > vertexCount) {
         HANDLE_ERROR(RENDER_ERROR(ErrorCode::OutOfRange, 
                                  "Mesh::UpdateVertices: Offset " + std::to_string(offset) + 
                                  " + size " + std::to_string(vertices.size()) + 
-                                 " exceeds vertex count " + std::to_string(m_Vertices.size())));
+                                 " exceeds vertex count " + std::to_string(vertexCount)));
+        return;
+    }
+    
+    // 完整顶点可能已按驻留策略释放：先读回，写入 GPU 后再按策略释放
+    if (!EnsureCPUDataForWriteNoLock("Mesh::UpdateVertices")) {
         return;
     }
     
     // 更新 CPU 端数据
     std::copy(vertices.begin(), vertices.end(), m_Vertices.begin() + offset);
+    InvalidateBoundsNoLock();
+    m_meshlets.reset();
     
     // 更新 GPU 端数据
     GL_THREAD_CHECK();
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 
-                    offset * sizeof(Vertex), 
-                    vertices.size() * sizeof(Vertex), 
-                    vertices.data());
+    WriteVertexBufferNoLock(offset, vertices.size());
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    // 修改后的数据与数据源不再一致，释放后无法重新读取
+    m_cpuDataSource = nullptr;
+    ApplyCPUResidencyNoLock();
 }
 
 void Mesh::Upload() {
@@ -194,12 +283,13 @@ void Mesh::Upload() {
     // === 阶段1：快速复制数据（持锁，微秒级）===
     std::vector<Vertex> vertices_copy;
     std::vector<uint32_t> indices_copy;
+    VertexLayout layout;
     bool need_reupload = false;
     
     {
         std::lock_guard<std::mutex> lock(m_Mutex);
         
-        if (m_Vertices.empty()) {
+        if (VertexCountNoLock() == 0) {
             HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState, 
                                        "Mesh::Upload: No vertices to upload"));
             m_uploadState.store(UploadState::Failed, std::memory_order_release);
@@ -219,18 +309,56 @@ void Mesh::Upload() {
             return;
         }
         
+        // 重新上传（如布局变化）时需要完整数据：按驻留策略释放过则先从数据源读回
+        RestoreCPUDataNoLock();
+        if (m_verticesReleased || m_indicesReleased) {
+            HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidState, 
+                                     "Mesh::Upload: CPU data was released and no data source is available"));
+            m_uploadState.store(UploadState::Failed, std::memory_order_release);
+            return;
+        }
+        
         // 标记为正在上传（其他线程会看到此状态并等待）
         m_uploadState.store(UploadState::Uploading, std::memory_order_release);
         
         // 快速复制数据
         vertices_copy = m_Vertices;
         indices_copy = m_Indices;
+        layout = m_vertexLayout;
         need_reupload = m_Uploaded;
     }  // 🔓 锁释放！其他线程现在可以访问Mesh对象
     
     // === 阶段2：OpenGL调用（无锁，毫秒级）===
     GLuint vao = 0, vbo = 0, ebo = 0;
     
+    // 压缩布局：在锁外编码顶点
+    const void* vertexData = vertices_copy.data();
+    size_t vertexBytes = vertices_copy.size() * sizeof(Vertex);
+    std::vector<uint8_t> encodedVertices;
+    VertexQuantization quantization;
+    if (!layout.IsFull()) {
+        if (layout.position == VertexPositionFormat::SNorm16) {
+            quantization = VertexQuantization::FromBounds(ComputeVertexBounds(vertices_copy));
+        }
+        encodedVertices.resize(vertices_copy.size() * layout.GetStride());
+        VertexCodec::Encode(vertices_copy.data(), vertices_copy.size(), layout, quantization,
+                            encodedVertices.data());
+        vertexData = encodedVertices.data();
+        vertexBytes = encodedVertices.size();
+    }
+    
+    // 索引：顶点数允许时打包为 16 位
+    const IndexFormat indexFormat = IndexCodec::SelectFormat(vertices_copy.size());
+    const void* indexData = indices_copy.data();
+    size_t indexBytes = indices_copy.size() * sizeof(uint32_t);
+    std::vector<uint16_t> packedIndices;
+    if (indexFormat == IndexFormat::UInt16 && !indices_copy.empty()) {
+        packedIndices.resize(indices_copy.size());
+        IndexCodec::PackUInt16(indices_copy.data(), indices_copy.size(), packedIndices.data());
+        indexData = packedIndices.data();
+        indexBytes = packedIndices.size() * sizeof(uint16_t);
+    }
+    
     try {
         // 如果需要重新上传，先清理旧资源
         if (need_reupload) {
@@ -269,8 +397,8 @@ void Mesh::Upload() {
         }
         glBindBuffer(GL_ARRAY_BUFFER, vbo);
         glBufferData(GL_ARRAY_BUFFER, 
-                     vertices_copy.size() * sizeof(Vertex), 
-                     vertices_copy.data(), 
+                     vertexBytes, 
+                     vertexData, 
                      GL_STATIC_DRAW);
         
         // 创建并填充EBO（回退到传统方式）
@@ -281,13 +409,13 @@ void Mesh::Upload() {
             }
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
             glBufferData(GL_ELEMENT_ARRAY_BUFFER, 
-                         indices_copy.size() * sizeof(uint32_t), 
-                         indices_copy.data(), 
+                         indexBytes, 
+                         indexData, 
                          GL_STATIC_DRAW);
         }
         
         // 设置顶点属性
-        SetupVertexAttributes();
+        SetupVertexAttributes(layout);
         
         // 解绑
         glBindVertexArray(0);
@@ -300,14 +428,20 @@ void Mesh::Upload() {
             m_VAO = vao;
             m_VBO = vbo;
             m_EBO = ebo;
+            m_uploadedVertexLayout = layout;
+            m_vertexQuantization = quantization;
+            m_uploadedIndexFormat = indexFormat;
             m_Uploaded = true;
+            ApplyCPUResidencyNoLock();
         }
         
         // 标记上传完成（原子操作，无锁）
         m_uploadState.store(UploadState::Uploaded, std::memory_order_release);
         
         Logger::GetInstance().Debug("Mesh uploaded: " + std::to_string(vertices_copy.size()) + 
-                                   " vertices, " + std::to_string(indices_copy.size()) + " indices");
+                                   " vertices, " + std::to_string(indices_copy.size()) +
+                                   (indexFormat == IndexFormat::UInt16 ? " u16" : " u32") + " indices, layout " +
+                                   layout.ToString());
                                    
     } catch (const std::exception& e) {
         // 异常处理
@@ -386,7 +520,7 @@ void Mesh::Draw(DrawMode mode) const {
         return;
     }
     
-    if (m_Vertices.empty()) {
+    if (VertexCountNoLock() == 0) {
         HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState, 
                                    "Mesh::Draw: 网格顶点数据为空"));
         return;
@@ -394,6 +528,9 @@ void Mesh::Draw(DrawMode mode) const {
     
     GL_THREAD_CHECK();
     glBindVertexArray(m_VAO);
+    if (!m_uploadedVertexLayout.IsFull()) {
+        ApplyMissingAttributeDefaults(m_uploadedVertexLayout);
+    }
     
     // ✅ 确保禁用实例化属性（location 6-11），避免LOD渲染器修改VAO后影响普通渲染
     // LOD渲染器会在VAO上启用这些属性，但普通渲染不应该使用它们
@@ -403,12 +540,13 @@ void Mesh::Draw(DrawMode mode) const {
     
     GLenum glMode = ConvertDrawMode(mode);
     
-    if (!m_Indices.empty()) {
+    if (IndexCountNoLock() > 0) {
         // 使用索引绘制
-        glDrawElements(glMode, static_cast<GLsizei>(m_Indices.size()), GL_UNSIGNED_INT, 0);
+        glDrawElements(glMode, static_cast<GLsizei>(IndexCountNoLock()),
+                       m_uploadedIndexFormat == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, 0);
     } else {
         // 直接绘制顶点
-        glDrawArrays(glMode, 0, static_cast<GLsizei>(m_Vertices.size()));
+        glDrawArrays(glMode, 0, static_cast<GLsizei>(VertexCountNoLock()));
     }
     
     glBindVertexArray(0);
@@ -458,21 +596,102 @@ void Mesh::DrawInstanced(uint32_t instanceCount, DrawMode mode) const {
     
     GL_THREAD_CHECK();
     glBindVertexArray(m_VAO);
+    if (!m_uploadedVertexLayout.IsFull()) {
+        ApplyMissingAttributeDefaults(m_uploadedVertexLayout);
+    }
     
     GLenum glMode = ConvertDrawMode(mode);
     
-    if (!m_Indices.empty()) {
+    if (IndexCountNoLock() > 0) {
         // 使用索引绘制实例
-        glDrawElementsInstanced(glMode, static_cast<GLsizei>(m_Indices.size()), 
-                                GL_UNSIGNED_INT, 0, instanceCount);
+        glDrawElementsInstanced(glMode, static_cast<GLsizei>(IndexCountNoLock()), 
+                                m_uploadedIndexFormat == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                                0, instanceCount);
     } else {
         // 直接绘制顶点实例
-        glDrawArraysInstanced(glMode, 0, static_cast<GLsizei>(m_Vertices.size()), instanceCount);
+        glDrawArraysInstanced(glMode, 0, static_cast<GLsizei>(VertexCountNoLock()), instanceCount);
     }
     
     glBindVertexArray(0);
 }
 
+void Mesh::DrawMeshletRanges(const std::vector<MeshletDrawRange>& ranges, DrawMode mode) const {
+    if (ranges.empty()) {
+        return;
+    }
+    
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (!m_meshlets || m_meshlets->indexOffsets.size() != m_meshlets->meshlets.size() ||
+        !m_Uploaded || m_VAO == 0 || m_uploadState.load(std::memory_order_acquire) == UploadState::Uploading) {
+        // 没有可用的 meshlet 数据或 GPU 缓冲区：走常规路径（含等待上传与错误报告）
+        lock.unlock();
+        Draw(mode);
+        return;
+    }
+    
+    GL_THREAD_CHECK();
+    if (m_meshletEBODirty || m_meshletEBO == 0) {
+        // 按 meshlet 顺序展开索引（只依赖 meshlet 数据，CPU 顶点/索引已释放时同样可用）
+        const MeshletData& data = *m_meshlets;
+        std::vector<uint32_t> indices;
+        indices.reserve(data.triangleCount * 3);
+        for (const Meshlet& meshlet : data.meshlets) {
+            const uint32_t* vertices = data.vertices.data() + meshlet.vertexOffset;
+            const uint8_t* triangles = data.triangles.data() + meshlet.triangleOffset;
+            for (uint32_t i = 0; i < meshlet.triangleCount * 3; ++i) {
+                indices.push_back(vertices[triangles[i]]);
+            }
+        }
+        
+        m_meshletIndexFormat = IndexCodec::SelectFormat(VertexCountNoLock());
+        std::vector<uint16_t> packed;
+        const void* indexData = indices.data();
+        size_t indexBytes = indices.size() * sizeof(uint32_t);
+        if (m_meshletIndexFormat == IndexFormat::UInt16) {
+            packed.resize(indices.size());
+            IndexCodec::PackUInt16(indices.data(), indices.size(), packed.data());
+            indexData = packed.data();
+            indexBytes = packed.size() * sizeof(uint16_t);
+        }
+        
+        if (m_meshletEBO == 0) {
+            glGenBuffers(1, &m_meshletEBO);
+        }
+        // EBO 绑定属于 VAO 状态，先解绑 VAO，避免改动其他对象的 VAO
+        glBindVertexArray(0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_meshletEBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexBytes), indexData, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        m_meshletEBODirty = false;
+    }
+    
+    thread_local std::vector<GLsizei> counts;
+    thread_local std::vector<const void*> offsets;
+    counts.clear();
+    offsets.clear();
+    const size_t indexSize = IndexCodec::GetIndexSize(m_meshletIndexFormat);
+    for (const auto& range : ranges) {
+        counts.push_back(static_cast<GLsizei>(range.indexCount));
+        offsets.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(range.indexOffset) * indexSize));
+    }
+    
+    glBindVertexArray(m_VAO);
+    if (!m_uploadedVertexLayout.IsFull()) {
+        ApplyMissingAttributeDefaults(m_uploadedVertexLayout);
+    }
+    for (int i = 6; i <= 11; ++i) {
+        glDisableVertexAttribArray(i);
+    }
+    
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_meshletEBO);
+    glMultiDrawElements(ConvertDrawMode(mode), counts.data(),
+                        m_meshletIndexFormat == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                        offsets.data(), static_cast<GLsizei>(counts.size()));
+    // 恢复 VAO 记录的原始 EBO，Draw() 与直接绑定 VAO 的渲染器仍按 m_EBO 绘制
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBindVertexArray(0);
+}
+
 uint32_t Mesh::GetVertexArrayID() const {
     std::lock_guard<std::mutex> lock(m_Mutex);
     return m_VAO;
@@ -499,6 +718,13 @@ void Mesh::Clear() {
         m_EBO = 0;
     }
     
+    if (m_meshletEBO != 0) {
+        GL_THREAD_CHECK();
+        glDeleteBuffers(1, &m_meshletEBO);
+        m_meshletEBO = 0;
+    }
+    m_meshletEBODirty = true;
+    
     m_Uploaded = false;
     m_uploadState.store(UploadState::NotUploaded, std::memory_order_release);
 }
@@ -507,12 +733,17 @@ AABB Mesh::CalculateBounds() const {
     std::lock_guard<std::mutex> lock(m_Mutex);
     
     // 返回空的包围盒并记录警告
-    if (m_Vertices.empty()) {
+    if (VertexCountNoLock() == 0) {
         HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState, 
                                    "Mesh::CalculateBounds: Mesh has no vertices"));
         return AABB();
     }
     
+    // 按驻留策略释放顶点前总会先缓存包围盒，因此释放后这里必定命中
+    if (!m_boundsDirty || m_verticesReleased) {
+        return m_cachedBounds;
+    }
+    
     // 在同一个临界区内完成所有操作
     AABB bounds;
     bounds.min = m_Vertices[0].position;
@@ -525,18 +756,40 @@ AABB Mesh::CalculateBounds() const {
         bounds.max = bounds.max.cwiseMax(pos);
     }
     
+    m_cachedBounds = bounds;
+    m_boundsDirty = false;
     return bounds;
 }
 
+void Mesh::SetCachedBounds(const AABB& bounds) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_cachedBounds = bounds;
+    m_boundsDirty = false;
+}
+
+void Mesh::InvalidateBoundsNoLock() {
+    m_boundsDirty = true;
+    m_boundsVersion.store(NextBoundsVersion(), std::memory_order_release);
+}
+
+uint64_t Mesh::NextBoundsVersion() {
+    static std::atomic<uint64_t> s_nextVersion{1};
+    return s_nextVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Mesh::RecalculateNormals() {
     std::lock_guard<std::mutex> lock(m_Mutex);
     
-    if (m_Indices.size() < 3) {
+    if (IndexCountNoLock() < 3) {
         HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState, 
                                    "Mesh::RecalculateNormals: Not enough indices for triangles"));
         return;
     }
     
+    if (!EnsureCPUDataForWriteNoLock("Mesh::RecalculateNormals")) {
+        return;
+    }
+    
     // 先将所有法线清零
     for (auto& vertex : m_Vertices) {
         vertex.normal = Vector3::Zero();
@@ -601,9 +854,11 @@ void Mesh::RecalculateNormals() {
     // 如果已上传，需要更新 GPU 数据
     if (m_Uploaded) {
         glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, m_Vertices.size() * sizeof(Vertex), m_Vertices.data());
+        WriteVertexBufferNoLock(0, m_Vertices.size());
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
+    m_cpuDataSource = nullptr;
+    ApplyCPUResidencyNoLock();
     
     Logger::GetInstance().Info("Mesh normals recalculated");
 }
@@ -611,156 +866,166 @@ void Mesh::RecalculateNormals() {
 void Mesh::RecalculateTangents() {
     std::lock_guard<std::mutex> lock(m_Mutex);
 
-    if (m_Vertices.empty()) {
+    if (VertexCountNoLock() == 0) {
         HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState,
                                    "Mesh::RecalculateTangents: Mesh has no vertices"));
         return;
     }
 
-    const float EPSILON = 1e-6f;
-
-    // 清零当前切线/副切线
-    for (auto& vertex : m_Vertices) {
-        vertex.tangent = Vector3::Zero();
-        vertex.bitangent = Vector3::Zero();
+    if (!EnsureCPUDataForWriteNoLock("Mesh::RecalculateTangents")) {
+        return;
     }
 
-    auto accumulateTriangle = [&](uint32_t i0, uint32_t i1, uint32_t i2) {
-        if (i0 >= m_Vertices.size() || i1 >= m_Vertices.size() || i2 >= m_Vertices.size()) {
-            return;
-        }
-
-        const Vector3& p0 = m_Vertices[i0].position;
-        const Vector3& p1 = m_Vertices[i1].position;
-        const Vector3& p2 = m_Vertices[i2].position;
-
-        const Vector2& uv0 = m_Vertices[i0].texCoord;
-        const Vector2& uv1 = m_Vertices[i1].texCoord;
-        const Vector2& uv2 = m_Vertices[i2].texCoord;
-
-        Vector3 edge1 = p1 - p0;
-        Vector3 edge2 = p2 - p0;
-
-        Vector2 deltaUV1 = uv1 - uv0;
-        Vector2 deltaUV2 = uv2 - uv0;
-
-        float determinant = deltaUV1.x() * deltaUV2.y() - deltaUV2.x() * deltaUV1.y();
-        if (std::abs(determinant) < EPSILON) {
-            return;
-        }
-
-        float r = 1.0f / determinant;
-        Vector3 tangent = (edge1 * deltaUV2.y() - edge2 * deltaUV1.y()) * r;
-        Vector3 bitangent = (edge2 * deltaUV1.x() - edge1 * deltaUV2.x()) * r;
-
-        m_Vertices[i0].tangent += tangent;
-        m_Vertices[i1].tangent += tangent;
-        m_Vertices[i2].tangent += tangent;
-
-        m_Vertices[i0].bitangent += bitangent;
-        m_Vertices[i1].bitangent += bitangent;
-        m_Vertices[i2].bitangent += bitangent;
-    };
-
-    if (!m_Indices.empty()) {
-        for (size_t i = 0; i + 2 < m_Indices.size(); i += 3) {
-            accumulateTriangle(m_Indices[i], m_Indices[i + 1], m_Indices[i + 2]);
-        }
-    } else {
-        if (m_Vertices.size() % 3 != 0) {
-            HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState,
-                                       "Mesh::RecalculateTangents: Non-indexed mesh vertex count not divisible by 3"));
-        }
-
-        for (size_t i = 0; i + 2 < m_Vertices.size(); i += 3) {
-            accumulateTriangle(static_cast<uint32_t>(i),
-                               static_cast<uint32_t>(i + 1),
-                               static_cast<uint32_t>(i + 2));
-        }
+    if (m_Indices.empty() && m_Vertices.size() % 3 != 0) {
+        HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState,
+                                   "Mesh::RecalculateTangents: Non-indexed mesh vertex count not divisible by 3"));
     }
 
-    // 正交化并归一化
-    for (auto& vertex : m_Vertices) {
-        Vector3 normal = vertex.normal;
-        if (normal.squaredNorm() < EPSILON) {
-            normal = Vector3::UnitY();
-        } else {
-            normal.normalize();
-        }
-
-        Vector3 tangent = vertex.tangent;
-        if (tangent.squaredNorm() < EPSILON) {
-            tangent = Vector3::UnitX();
-        }
-
-        tangent = (tangent - normal * normal.dot(tangent));
-        float tangentLength = tangent.norm();
-        if (tangentLength < EPSILON) {
-            tangent = Vector3::UnitX();
-        } else {
-            tangent /= tangentLength;
-        }
-
-        Vector3 bitangent = vertex.bitangent;
-        float handedness = 1.0f;
-        if (bitangent.squaredNorm() >= EPSILON) {
-            handedness = (normal.cross(tangent).dot(bitangent) < 0.0f) ? -1.0f : 1.0f;
-        }
-        bitangent = normal.cross(tangent) * handedness;
-
-        vertex.normal = normal;
-        vertex.tangent = tangent;
-        vertex.bitangent = bitangent;
-    }
+    // 累加三角形切线并正交化（SoA + AVX2 内核）
+    MeshKernels::ComputeTangents(m_Vertices.data(), m_Vertices.size(),
+                                 m_Indices.empty() ? nullptr : m_Indices.data(), m_Indices.size());
 
     if (m_Uploaded) {
         glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, m_Vertices.size() * sizeof(Vertex), m_Vertices.data());
+        WriteVertexBufferNoLock(0, m_Vertices.size());
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
+    m_cpuDataSource = nullptr;
+    ApplyCPUResidencyNoLock();
 
     Logger::GetInstance().Info("Mesh tangents recalculated");
 }
 
-void Mesh::SetupVertexAttributes() {
-    // 顶点属性布局：
-    // Location 0: Position (vec3) - 12 bytes
-    // Location 1: TexCoord (vec2) - 8 bytes
-    // Location 2: Normal (vec3) - 12 bytes
-    // Location 3: Color (vec4) - 16 bytes
-    // Location 4: Tangent (vec3) - 12 bytes
-    // Location 5: Bitangent (vec3) - 12 bytes
-    // Total: 72 bytes per vertex
+void Mesh::SetupVertexAttributes(const VertexLayout& layout) {
+    // 顶点属性布局（location 固定，格式由 VertexLayout 决定）：
+    // Location 0: Position  - vec3 float / snorm16x4（需反量化）
+    // Location 1: TexCoord  - vec2 float / half2
+    // Location 2: Normal    - vec3 float / 八面体 snorm16x2
+    // Location 3: Color     - vec4 float / unorm8x4
+    // Location 4: Tangent   - vec3 float / 八面体 snorm16x4（z 为手性符号）
+    // Location 5: Bitangent - vec3 float（仅完整布局）
+    // 完整布局与 Vertex 一致：72 bytes per vertex
+    const GLsizei stride = static_cast<GLsizei>(layout.GetStride());
+    auto offsetPointer = [](uint32_t offset) {
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(offset));
+    };
     
     // Position
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
-                          (void*)offsetof(Vertex, position));
+    if (layout.position == VertexPositionFormat::SNorm16) {
+        glVertexAttribPointer(0, 4, GL_SHORT, GL_TRUE, stride, offsetPointer(0));
+    } else {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, offsetPointer(0));
+    }
     
     // TexCoord
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
-                          (void*)offsetof(Vertex, texCoord));
+    const VertexAttributeSlot uvSlot = layout.GetTexCoordSlot();
+    if (uvSlot.enabled) {
+        glEnableVertexAttribArray(1);
+        if (layout.texCoord == VertexTexCoordFormat::Half2) {
+            glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, stride, offsetPointer(uvSlot.offset));
+        } else {
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, offsetPointer(uvSlot.offset));
+        }
+    } else {
+        glDisableVertexAttribArray(1);
+    }
     
     // Normal
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
-                          (void*)offsetof(Vertex, normal));
+    const VertexAttributeSlot normalSlot = layout.GetNormalSlot();
+    if (normalSlot.enabled) {
+        glEnableVertexAttribArray(2);
+        if (layout.normal == VertexNormalFormat::Oct16) {
+            glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, stride, offsetPointer(normalSlot.offset));
+        } else {
+            glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, offsetPointer(normalSlot.offset));
+        }
+    } else {
+        glDisableVertexAttribArray(2);
+    }
     
     // Color
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
-                          (void*)offsetof(Vertex, color));
+    const VertexAttributeSlot colorSlot = layout.GetColorSlot();
+    if (colorSlot.enabled) {
+        glEnableVertexAttribArray(3);
+        if (layout.color == VertexColorFormat::UNorm8) {
+            glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, offsetPointer(colorSlot.offset));
+        } else {
+            glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, offsetPointer(colorSlot.offset));
+        }
+    } else {
+        glDisableVertexAttribArray(3);
+    }
     
     // Tangent
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, tangent));
+    const VertexAttributeSlot tangentSlot = layout.GetTangentSlot();
+    if (tangentSlot.enabled) {
+        glEnableVertexAttribArray(4);
+        if (layout.tangent == VertexTangentFormat::Oct16Sign) {
+            glVertexAttribPointer(4, 4, GL_SHORT, GL_TRUE, stride, offsetPointer(tangentSlot.offset));
+        } else {
+            glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, offsetPointer(tangentSlot.offset));
+        }
+    } else {
+        glDisableVertexAttribArray(4);
+    }
     
     // Bitangent
-    glEnableVertexAttribArray(5);
-    glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, bitangent));
+    const VertexAttributeSlot bitangentSlot = layout.GetBitangentSlot();
+    if (bitangentSlot.enabled) {
+        glEnableVertexAttribArray(5);
+        glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, stride, offsetPointer(bitangentSlot.offset));
+    } else {
+        glDisableVertexAttribArray(5);
+    }
+}
+
+void Mesh::ApplyMissingAttributeDefaults(const VertexLayout& layout) {
+    // 禁用的属性读取上下文中的常量值（非 VAO 状态），因此每次绘制前设置
+    if (layout.texCoord == VertexTexCoordFormat::None) {
+        glVertexAttrib2f(1, 0.0f, 0.0f);
+    }
+    if (layout.normal == VertexNormalFormat::None) {
+        glVertexAttrib3f(2, 0.0f, 1.0f, 0.0f);
+    }
+    if (layout.color == VertexColorFormat::None) {
+        glVertexAttrib4f(3, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    if (layout.tangent == VertexTangentFormat::None) {
+        glVertexAttrib3f(4, 1.0f, 0.0f, 0.0f);
+    }
+    if (layout.tangent != VertexTangentFormat::Float3Bitangent) {
+        glVertexAttrib3f(5, 0.0f, 0.0f, 1.0f);
+    }
+}
+
+void Mesh::WriteVertexBufferNoLock(size_t offset, size_t count) {
+    const VertexLayout& layout = m_uploadedVertexLayout;
+    if (layout.IsFull()) {
+        glBufferSubData(GL_ARRAY_BUFFER,
+                        offset * sizeof(Vertex),
+                        count * sizeof(Vertex),
+                        m_Vertices.data() + offset);
+        return;
+    }
+    
+    if (layout.position == VertexPositionFormat::SNorm16) {
+        const bool inRange = std::all_of(m_Vertices.begin() + offset, m_Vertices.begin() + offset + count,
+                                         [this](const Vertex& vertex) {
+                                             return m_vertexQuantization.Contains(vertex.position);
+                                         });
+        if (!inRange) {
+            // 新位置超出量化范围：重新量化并整体重写（缓冲大小不变）
+            m_vertexQuantization = VertexQuantization::FromBounds(ComputeVertexBounds(m_Vertices));
+            offset = 0;
+            count = m_Vertices.size();
+        }
+    }
+    
+    const size_t stride = layout.GetStride();
+    std::vector<uint8_t> encoded(count * stride);
+    VertexCodec::Encode(m_Vertices.data() + offset, count, layout, m_vertexQuantization, encoded.data());
+    glBufferSubData(GL_ARRAY_BUFFER, offset * stride, encoded.size(), encoded.data());
 }
 
 GLenum Mesh::ConvertDrawMode(DrawMode mode) const {
@@ -779,15 +1044,191 @@ GLenum Mesh::ConvertDrawMode(DrawMode mode) const {
 size_t Mesh::GetMemoryUsage() const {
     std::lock_guard<std::mutex> lock(m_Mutex);
     
-    // 顶点数据内存
-    size_t vertexMemory = m_Vertices.size() * sizeof(Vertex);
+    // 顶点数据内存（PositionsOnly 策略下为紧凑位置副本）
+    size_t vertexMemory = m_Vertices.size() * sizeof(Vertex) + m_positions.size() * sizeof(Vector3);
     
     // 索引数据内存
     size_t indexMemory = m_Indices.size() * sizeof(uint32_t);
     
-    // 总内存 = 顶点内存 + 索引内存
+    // 总内存 = 顶点内存 + 索引内存（已释放的部分不计入）
     return vertexMemory + indexMemory;
 }
 
+size_t Mesh::GetGPUMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const VertexLayout& layout = m_Uploaded ? m_uploadedVertexLayout : m_vertexLayout;
+    const IndexFormat indexFormat = m_Uploaded ? m_uploadedIndexFormat : IndexCodec::SelectFormat(VertexCountNoLock());
+    return VertexCountNoLock() * layout.GetStride() + IndexCountNoLock() * IndexCodec::GetIndexSize(indexFormat);
+}
+
+IndexFormat Mesh::GetIndexFormat() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    // 以现存 EBO 为准：SetData 后、重新上传前仍绑定的是旧缓冲
+    return m_EBO != 0 ? m_uploadedIndexFormat : IndexCodec::SelectFormat(VertexCountNoLock());
+}
+
+void Mesh::SetCPUResidency(MeshCPUResidency residency) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (residency == m_cpuResidency) {
+        return;
+    }
+    
+    // 放宽策略：Keep 需要完整数据；PositionsOnly 需要索引与位置（Release 下两者都已释放）
+    const bool needsRestore = residency == MeshCPUResidency::Keep ? (m_verticesReleased || m_indicesReleased)
+                                                                  : (m_indicesReleased || (m_verticesReleased && m_positions.empty()));
+    m_cpuResidency = residency;
+    if (needsRestore) {
+        RestoreCPUDataNoLock();
+    }
+    ApplyCPUResidencyNoLock();
+}
+
+void Mesh::SetCPUDataSource(CPUDataSource source) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_cpuDataSource = std::move(source);
+    m_restoreFailureLogged = false;
+}
+
+bool Mesh::RestoreCPUDataNoLock() const {
+    if (!m_verticesReleased && !m_indicesReleased) {
+        return false;
+    }
+    
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    const bool loaded = m_cpuDataSource && m_cpuDataSource(vertices, indices);
+    const size_t expectedIndices = m_indicesReleased ? m_releasedIndexCount : m_Indices.size();
+    if (!loaded || vertices.size() != VertexCountNoLock() || indices.size() != expectedIndices) {
+        if (!m_restoreFailureLogged) {
+            m_restoreFailureLogged = true;
+            HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState,
+                                       m_cpuDataSource ? "Mesh: CPU data source returned mismatched data, released data unavailable"
+                                                       : "Mesh: CPU data was released after upload and no data source is set"));
+        }
+        return false;
+    }
+    
+    m_Vertices = std::move(vertices);
+    m_Indices = std::move(indices);
+    std::vector<Vector3>().swap(m_positions);
+    m_verticesReleased = false;
+    m_indicesReleased = false;
+    return true;
+}
+
+bool Mesh::LoadReleasedCPUData(std::unique_lock<std::mutex>& lock,
+                               std::vector<Vertex>& vertices,
+                               std::vector<uint32_t>& indices) const {
+    const CPUDataSource source = m_cpuDataSource;
+    const size_t expectedVertices = VertexCountNoLock();
+    const size_t expectedIndices = IndexCountNoLock();
+    lock.unlock();
+    
+    // 数据源可能读取磁盘缓存，不持有 m_Mutex，避免阻塞渲染线程的 Draw
+    vertices.clear();
+    indices.clear();
+    const bool loaded = source && source(vertices, indices);
+    if (loaded && vertices.size() == expectedVertices && indices.size() == expectedIndices) {
+        return true;
+    }
+    
+    vertices.clear();
+    indices.clear();
+    lock.lock();
+    if (!m_restoreFailureLogged) {
+        m_restoreFailureLogged = true;
+        HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidState,
+                                   source ? "Mesh: CPU data source returned mismatched data, released data unavailable"
+                                          : "Mesh: CPU data was released after upload and no data source is set"));
+    }
+    lock.unlock();
+    return false;
+}
+
+void Mesh::ApplyCPUResidencyNoLock() const {
+    // 仅释放已成功上传的数据，未上传（或上传后又被修改）的网格总是保留 CPU 副本
+    if (m_cpuResidency == MeshCPUResidency::Keep || !m_Uploaded || m_VAO == 0) {
+        return;
+    }
+    
+    if (!m_verticesReleased) {
+        if (m_boundsDirty && !m_Vertices.empty()) {
+            m_cachedBounds = ComputeVertexBounds(m_Vertices);
+            m_boundsDirty = false;
+        }
+        if (m_cpuResidency == MeshCPUResidency::PositionsOnly) {
+            m_positions.resize(m_Vertices.size());
+            for (size_t i = 0; i < m_Vertices.size(); ++i) {
+                m_positions[i] = m_Vertices[i].position;
+            }
+        }
+        m_releasedVertexCount = m_Vertices.size();
+        std::vector<Vertex>().swap(m_Vertices);
+        m_verticesReleased = true;
+    }
+    
+    if (m_cpuResidency == MeshCPUResidency::Release) {
+        std::vector<Vector3>().swap(m_positions);
+        if (!m_indicesReleased) {
+            m_releasedIndexCount = m_Indices.size();
+            std::vector<uint32_t>().swap(m_Indices);
+            m_indicesReleased = true;
+        }
+    }
+}
+
+bool Mesh::EnsureCPUDataForWriteNoLock(const char* caller) {
+    RestoreCPUDataNoLock();
+    if (m_verticesReleased || m_indicesReleased) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidState,
+                                 std::string(caller) + ": CPU data was released and no data source is available"));
+        return false;
+    }
+    return true;
+}
+
+void Mesh::SetVertexLayout(const VertexLayout& layout) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (layout == m_vertexLayout) {
+        return;
+    }
+    m_vertexLayout = layout;
+    
+    // 已上传的网格保留旧缓冲继续绘制，下次 Upload() 时按新布局重建
+    if (m_uploadState.load(std::memory_order_acquire) == UploadState::Uploaded) {
+        m_uploadState.store(UploadState::NotUploaded, std::memory_order_release);
+    }
+}
+
+void Mesh::ApplyVertexLayoutUniforms(UniformManager* uniforms) const {
+    if (!uniforms || !uniforms->HasUniform("uVertexLayoutFlags")) {
+        return;
+    }
+    
+    uint32_t flags = 0;
+    VertexQuantization quantization;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        flags = m_uploadedVertexLayout.GetShaderFlags();
+        quantization = m_vertexQuantization;
+    }
+    
+    uniforms->SetInt("uVertexLayoutFlags", static_cast<int>(flags));
+    if ((flags & VertexLayoutFlag_QuantizedPosition) && uniforms->HasUniform("uVertexDequant")) {
+        uniforms->SetVector4("uVertexDequant", quantization.ToVector4());
+    }
+}
+
+void Mesh::SetMeshlets(std::shared_ptr<const MeshletData> meshlets) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_meshlets = std::move(meshlets);
+    m_meshletEBODirty = true;
+}
+
+std::shared_ptr<const MeshletData> Mesh::GetMeshlets() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_meshlets;
+}
+
 } // namespace Render
 
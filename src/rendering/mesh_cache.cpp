@@ -0,0 +1,760 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/mesh_cache.h"
+#include "render/file_utils.h"
+#include "render/logger.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+
+namespace Render {
+
+namespace {
+
+constexpr char kMagic[4] = {'R', 'M', 'S', 'H'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kMaxMeshCount = 1u << 20;
+constexpr uint64_t kBlobAlignment = 8;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t meshCount;
+    uint32_t vertexStride;
+};
+
+struct MeshRecord {
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t metaOffset;
+    uint64_t metaSize;
+    float boundsMin[3];
+    float boundsMax[3];
+};
+
+static_assert(sizeof(FileHeader) == 24, "Mesh cache header layout changed");
+static_assert(sizeof(MeshRecord) == 64, "Mesh cache record layout changed");
+// 顶点块按 Vertex 内存布局直接存储（与 Mesh::Upload 提交给 GPU 的布局一致），布局变化时必须提升 kFormatVersion
+static_assert(sizeof(Vertex) == 72, "Vertex layout changed, bump mesh cache format version");
+
+enum MaterialFieldBits : uint32_t {
+    kHasAmbient   = 1u << 0,
+    kHasDiffuse   = 1u << 1,
+    kHasSpecular  = 1u << 2,
+    kHasEmissive  = 1u << 3,
+    kHasShininess = 1u << 4,
+    kHasOpacity   = 1u << 5,
+    kHasMetallic  = 1u << 6,
+    kHasRoughness = 1u << 7,
+};
+
+template<typename T>
+uint64_t HashValue(const T& value, uint64_t hash) {
+    return FileUtils::HashBytes(&value, sizeof(T), hash);
+}
+
+uint64_t AlignOffset(uint64_t offset) {
+    return (offset + kBlobAlignment - 1) & ~(kBlobAlignment - 1);
+}
+
+/**
+ * @brief 元数据序列化（追加写入字节数组）
+ */
+class BlobWriter {
+public:
+    template<typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BlobWriter only writes POD values");
+        WriteBytes(&value, sizeof(T));
+    }
+    
+    void WriteBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+    
+    void WriteString(const std::string& value) {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+    
+    void WriteMatrix(const Matrix4& matrix) {
+        WriteBytes(matrix.data(), sizeof(float) * 16);
+    }
+    
+    void WriteColor(const Color& color) {
+        const float rgba[4] = {color.r, color.g, color.b, color.a};
+        WriteBytes(rgba, sizeof(rgba));
+    }
+    
+    [[nodiscard]] const std::vector<uint8_t>& GetBuffer() const { return m_buffer; }
+
+private:
+    std::vector<uint8_t> m_buffer;
+};
+
+/**
+ * @brief 元数据反序列化（带越界检查，任何越界读取都会使 IsValid() 返回 false）
+ */
+class BlobReader {
+public:
+    BlobReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+    
+    template<typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BlobReader only reads POD values");
+        return ReadBytes(&value, sizeof(T));
+    }
+    
+    bool ReadBytes(void* out, size_t size) {
+        if (!m_valid || size > m_size - m_pos) {
+            m_valid = false;
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(out, m_data + m_pos, size);
+        }
+        m_pos += size;
+        return true;
+    }
+    
+    bool ReadString(std::string& value) {
+        uint32_t length = 0;
+        if (!Read(length) || !CanRead(length, 1)) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+        m_pos += length;
+        return true;
+    }
+    
+    bool ReadMatrix(Matrix4& matrix) {
+        return ReadBytes(matrix.data(), sizeof(float) * 16);
+    }
+    
+    bool ReadColor(Color& color) {
+        float rgba[4];
+        if (!ReadBytes(rgba, sizeof(rgba))) {
+            return false;
+        }
+        color = Color(rgba[0], rgba[1], rgba[2], rgba[3]);
+        return true;
+    }
+    
+    /**
+     * @brief 检查剩余数据是否足够容纳 count 个元素（用于在分配内存前拒绝损坏的计数）
+     */
+    bool CanRead(uint64_t count, size_t elementSize) {
+        if (!m_valid || count > (m_size - m_pos) / elementSize) {
+            m_valid = false;
+        }
+        return m_valid;
+    }
+    
+    [[nodiscard]] bool IsValid() const { return m_valid; }
+    [[nodiscard]] bool IsAtEnd() const { return m_pos == m_size; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    bool m_valid = true;
+};
+
+void WriteMeta(BlobWriter& writer, const MeshImportResult& result, const MeshMaterialDesc& material) {
+    const MeshExtraData& extra = result.extra;
+    writer.WriteString(result.name);
+    writer.WriteMatrix(extra.localTransform);
+    writer.WriteMatrix(extra.worldTransform);
+    writer.Write(extra.assimpMeshIndex);
+    writer.Write(static_cast<uint8_t>(extra.enableUvChannelScaling));
+    
+    writer.Write(static_cast<uint32_t>(extra.uvChannels.size()));
+    for (const auto& channel : extra.uvChannels) {
+        writer.Write(static_cast<uint32_t>(channel.size()));
+        for (const auto& uv : channel) {
+            writer.WriteBytes(uv.data(), sizeof(float) * 2);
+        }
+    }
+    
+    writer.Write(static_cast<uint32_t>(extra.colorChannels.size()));
+    for (const auto& channel : extra.colorChannels) {
+        writer.Write(static_cast<uint32_t>(channel.size()));
+        for (const auto& color : channel) {
+            writer.WriteColor(color);
+        }
+    }
+    
+    // 蒙皮数据
+    const MeshSkinningData& skinning = extra.skinning;
+    writer.Write(static_cast<uint32_t>(skinning.bones.size()));
+    for (const auto& bone : skinning.bones) {
+        writer.WriteString(bone.name);
+        writer.WriteString(bone.parentName);
+        writer.Write(static_cast<uint32_t>(bone.vertexWeights.size()));
+        for (const auto& weight : bone.vertexWeights) {
+            writer.Write(weight.vertexIndex);
+            writer.Write(weight.weight);
+        }
+    }
+    writer.Write(static_cast<uint32_t>(skinning.boneOffsetMatrices.size()));
+    for (const auto& matrix : skinning.boneOffsetMatrices) {
+        writer.WriteMatrix(matrix);
+    }
+    writer.Write(static_cast<uint32_t>(skinning.vertexWeights.size()));
+    for (const auto& weights : skinning.vertexWeights) {
+        writer.Write(static_cast<uint32_t>(weights.size()));
+        for (const auto& weight : weights) {
+            writer.Write(weight.boneIndex);
+            writer.Write(weight.weight);
+        }
+    }
+    writer.Write(static_cast<uint32_t>(skinning.boneNameToIndex.size()));
+    for (const auto& [name, index] : skinning.boneNameToIndex) {
+        writer.WriteString(name);
+        writer.Write(index);
+    }
+    
+    // 材质描述
+    writer.Write(static_cast<uint8_t>(material.valid));
+    writer.Write(material.materialIndex);
+    writer.WriteString(material.name);
+    uint32_t fields = 0;
+    fields |= material.ambientColor ? kHasAmbient : 0u;
+    fields |= material.diffuseColor ? kHasDiffuse : 0u;
+    fields |= material.specularColor ? kHasSpecular : 0u;
+    fields |= material.emissiveColor ? kHasEmissive : 0u;
+    fields |= material.shininess ? kHasShininess : 0u;
+    fields |= material.opacity ? kHasOpacity : 0u;
+    fields |= material.metallic ? kHasMetallic : 0u;
+    fields |= material.roughness ? kHasRoughness : 0u;
+    writer.Write(fields);
+    writer.WriteColor(material.ambientColor.value_or(Color::Black()));
+    writer.WriteColor(material.diffuseColor.value_or(Color::Black()));
+    writer.WriteColor(material.specularColor.value_or(Color::Black()));
+    writer.WriteColor(material.emissiveColor.value_or(Color::Black()));
+    writer.Write(material.shininess.value_or(0.0f));
+    writer.Write(material.opacity.value_or(0.0f));
+    writer.Write(material.metallic.value_or(0.0f));
+    writer.Write(material.roughness.value_or(0.0f));
+    writer.Write(static_cast<uint32_t>(material.textures.size()));
+    for (const auto& texture : material.textures) {
+        writer.WriteString(texture.slotName);
+        writer.WriteString(texture.relativePath);
+    }
+}
+
+bool ReadMeta(BlobReader& reader, MeshImportResult& result, MeshMaterialDesc& material) {
+    MeshExtraData& extra = result.extra;
+    uint8_t flag = 0;
+    uint32_t count = 0;
+    
+    reader.ReadString(result.name);
+    reader.ReadMatrix(extra.localTransform);
+    reader.ReadMatrix(extra.worldTransform);
+    reader.Read(extra.assimpMeshIndex);
+    reader.Read(flag);
+    extra.enableUvChannelScaling = flag != 0;
+    
+    if (reader.Read(count) && reader.CanRead(count, sizeof(uint32_t))) {
+        extra.uvChannels.resize(count);
+        for (auto& channel : extra.uvChannels) {
+            uint32_t uvCount = 0;
+            if (!reader.Read(uvCount) || !reader.CanRead(uvCount, sizeof(float) * 2)) {
+                return false;
+            }
+            channel.resize(uvCount);
+            for (auto& uv : channel) {
+                reader.ReadBytes(uv.data(), sizeof(float) * 2);
+            }
+        }
+    }
+    
+    if (reader.Read(count) && reader.CanRead(count, sizeof(uint32_t))) {
+        extra.colorChannels.resize(count);
+        for (auto& channel : extra.colorChannels) {
+            uint32_t colorCount = 0;
+            if (!reader.Read(colorCount) || !reader.CanRead(colorCount, sizeof(float) * 4)) {
+                return false;
+            }
+            channel.resize(colorCount);
+            for (auto& color : channel) {
+                reader.ReadColor(color);
+            }
+        }
+    }
+    
+    // 蒙皮数据
+    MeshSkinningData& skinning = extra.skinning;
+    if (reader.Read(count) && reader.CanRead(count, sizeof(uint32_t) * 3)) {
+        skinning.bones.resize(count);
+        for (auto& bone : skinning.bones) {
+            uint32_t weightCount = 0;
+            reader.ReadString(bone.name);
+            reader.ReadString(bone.parentName);
+            if (!reader.Read(weightCount) || !reader.CanRead(weightCount, sizeof(BoneVertexWeight))) {
+                return false;
+            }
+            bone.vertexWeights.resize(weightCount);
+            for (auto& weight : bone.vertexWeights) {
+                reader.Read(weight.vertexIndex);
+                reader.Read(weight.weight);
+            }
+        }
+    }
+    if (reader.Read(count) && reader.CanRead(count, sizeof(float) * 16)) {
+        skinning.boneOffsetMatrices.resize(count);
+        for (auto& matrix : skinning.boneOffsetMatrices) {
+            reader.ReadMatrix(matrix);
+        }
+    }
+    if (reader.Read(count) && reader.CanRead(count, sizeof(uint32_t))) {
+        skinning.vertexWeights.resize(count);
+        for (auto& weights : skinning.vertexWeights) {
+            uint32_t weightCount = 0;
+            if (!reader.Read(weightCount) || !reader.CanRead(weightCount, sizeof(VertexBoneWeight))) {
+                return false;
+            }
+            weights.resize(weightCount);
+            for (auto& weight : weights) {
+                reader.Read(weight.boneIndex);
+                reader.Read(weight.weight);
+            }
+        }
+    }
+    if (reader.Read(count) && reader.CanRead(count, sizeof(uint32_t) * 2)) {
+        skinning.boneNameToIndex.reserve(count);
+        for (uint32_t i = 0; i < count && reader.IsValid(); ++i) {
+            std::string name;
+            uint32_t index = 0;
+            reader.ReadString(name);
+            reader.Read(index);
+            skinning.boneNameToIndex.emplace(std::move(name), index);
+        }
+    }
+    
+    // 材质描述
+    uint32_t fields = 0;
+    Color colors[4];
+    float scalars[4] = {};
+    reader.Read(flag);
+    material.valid = flag != 0;
+    reader.Read(material.materialIndex);
+    reader.ReadString(material.name);
+    reader.Read(fields);
+    for (auto& color : colors) {
+        reader.ReadColor(color);
+    }
+    reader.ReadBytes(scalars, sizeof(scalars));
+    if (fields & kHasAmbient)   material.ambientColor = colors[0];
+    if (fields & kHasDiffuse)   material.diffuseColor = colors[1];
+    if (fields & kHasSpecular)  material.specularColor = colors[2];
+    if (fields & kHasEmissive)  material.emissiveColor = colors[3];
+    if (fields & kHasShininess) material.shininess = scalars[0];
+    if (fields & kHasOpacity)   material.opacity = scalars[1];
+    if (fields & kHasMetallic)  material.metallic = scalars[2];
+    if (fields & kHasRoughness) material.roughness = scalars[3];
+    
+    if (reader.Read(count) && reader.CanRead(count, sizeof(uint32_t) * 2)) {
+        material.textures.resize(count);
+        for (auto& texture : material.textures) {
+            reader.ReadString(texture.slotName);
+            reader.ReadString(texture.relativePath);
+        }
+    }
+    
+    return reader.IsValid() && reader.IsAtEnd();
+}
+
+bool ReadHeader(const uint8_t* data, size_t size, uint64_t key, const std::string& path, FileHeader& header) {
+    if (size < sizeof(FileHeader)) {
+        LOG_WARNING_F("MeshCache: Truncated cache file %s", path.c_str());
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kFormatVersion ||
+        header.key != key ||
+        header.vertexStride != sizeof(Vertex) ||
+        header.meshCount == 0 || header.meshCount > kMaxMeshCount ||
+        size < sizeof(FileHeader) + static_cast<uint64_t>(header.meshCount) * sizeof(MeshRecord)) {
+        LOG_WARNING_F("MeshCache: Invalid or stale cache file %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool RecordInBounds(const MeshRecord& record, size_t size) {
+    const uint64_t vertexBytes = static_cast<uint64_t>(record.vertexCount) * sizeof(Vertex);
+    const uint64_t indexBytes = static_cast<uint64_t>(record.indexCount) * sizeof(uint32_t);
+    return record.vertexOffset <= size && vertexBytes <= size - record.vertexOffset &&
+           record.indexOffset <= size && indexBytes <= size - record.indexOffset &&
+           record.metaOffset <= size && record.metaSize <= size - record.metaOffset;
+}
+
+void CopyMeshData(const uint8_t* data, const MeshRecord& record,
+                  std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    vertices.resize(record.vertexCount);
+    if (record.vertexCount > 0) {
+        std::memcpy(static_cast<void*>(vertices.data()), data + record.vertexOffset,
+                    static_cast<size_t>(record.vertexCount) * sizeof(Vertex));
+    }
+    indices.resize(record.indexCount);
+    if (record.indexCount > 0) {
+        std::memcpy(indices.data(), data + record.indexOffset,
+                    static_cast<size_t>(record.indexCount) * sizeof(uint32_t));
+    }
+}
+
+} // namespace
+
+MeshCache& MeshCache::GetInstance() {
+    static MeshCache instance;
+    return instance;
+}
+
+void MeshCache::SetCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_directoryMutex);
+    m_directory = directory;
+}
+
+std::string MeshCache::GetCacheDirectory() const {
+    std::lock_guard<std::mutex> lock(m_directoryMutex);
+    return m_directory;
+}
+
+// ============================================================================
+// 哈希
+// ============================================================================
+
+uint64_t MeshCache::HashOptions(const MeshImportOptions& options) {
+    const bool flags[] = {
+        options.flipUVs,
+        options.triangulate,
+        options.generateSmoothNormals,
+        options.calculateTangentSpace,
+        options.joinIdenticalVertices,
+        options.sortByPrimitiveType,
+        options.improveCacheLocality,
+        options.optimizeMeshes,
+        options.validateDataStructure,
+        options.generateUVCoords,
+        options.transformUVCoords,
+        options.findInvalidData,
+        options.populateArmatureData,
+        options.gatherAdditionalUVs,
+        options.gatherVertexColors,
+        options.gatherBones,
+        options.normalizeBoneWeights,
+        options.limitBoneWeightsPerVertex,
+        options.runMeshOptimizer,
+    };
+    
+    uint64_t hash = FileUtils::kHashSeed;
+    for (bool flag : flags) {
+        hash = HashValue(static_cast<uint8_t>(flag), hash);
+    }
+    hash = HashValue(options.maxBoneWeightsPerVertex, hash);
+    return hash;
+}
+
+uint64_t MeshCache::BuildKey(uint64_t sourceHash, const MeshImportOptions& options) {
+    uint64_t hash = HashValue(kFormatVersion, FileUtils::kHashSeed);
+    hash = HashValue(sourceHash, hash);
+    hash = HashValue(HashOptions(options), hash);
+    return hash;
+}
+
+std::string MeshCache::GetCachePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.meshc", static_cast<unsigned long long>(key));
+    return FileUtils::CombinePaths(GetCacheDirectory(), name);
+}
+
+// ============================================================================
+// 读写
+// ============================================================================
+
+bool MeshCache::Load(uint64_t key,
+                     std::vector<MeshImportResult>& outResults,
+                     std::vector<MeshMaterialDesc>& outMaterials) {
+    outResults.clear();
+    outMaterials.clear();
+    
+    if (!IsEnabled()) {
+        return false;
+    }
+    
+    const std::string path = GetCachePath(key);
+    MappedFile file;
+    if (!file.Open(path)) {
+        m_misses++;
+        return false;
+    }
+    
+    const uint8_t* data = file.GetData();
+    const size_t size = file.GetSize();
+    
+    FileHeader header{};
+    if (!ReadHeader(data, size, key, path, header)) {
+        m_misses++;
+        return false;
+    }
+    
+    std::vector<MeshImportResult> results(header.meshCount);
+    std::vector<MeshMaterialDesc> materials(header.meshCount);
+    
+    for (uint32_t i = 0; i < header.meshCount; ++i) {
+        MeshRecord record{};
+        std::memcpy(&record, data + sizeof(FileHeader) + i * sizeof(MeshRecord), sizeof(record));
+        
+        if (!RecordInBounds(record, size)) {
+            LOG_WARNING_F("MeshCache: Corrupted mesh %u in %s", i, path.c_str());
+            m_misses++;
+            return false;
+        }
+        
+        BlobReader reader(data + record.metaOffset, static_cast<size_t>(record.metaSize));
+        if (!ReadMeta(reader, results[i], materials[i])) {
+            LOG_WARNING_F("MeshCache: Corrupted metadata for mesh %u in %s", i, path.c_str());
+            m_misses++;
+            return false;
+        }
+        
+        // 顶点与索引块与内存中的布局一致，整块拷贝即可，无需逐顶点解析
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        CopyMeshData(data, record, vertices, indices);
+        
+        auto mesh = CreateRef<Mesh>(std::move(vertices), std::move(indices));
+        mesh->SetCachedBounds(AABB(
+            Vector3(record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]),
+            Vector3(record.boundsMax[0], record.boundsMax[1], record.boundsMax[2])));
+        // 缓存文件即数据源：驻留策略释放 CPU 副本后可按需重新读取
+        mesh->SetCPUDataSource(MakeCPUDataSource(key, i));
+        results[i].mesh = std::move(mesh);
+    }
+    
+    outResults = std::move(results);
+    outMaterials = std::move(materials);
+    m_hits++;
+    return true;
+}
+
+bool MeshCache::LoadMeshData(uint64_t key, uint32_t meshIndex,
+                             std::vector<Vertex>& outVertices,
+                             std::vector<uint32_t>& outIndices) const {
+    const std::string path = GetCachePath(key);
+    MappedFile file;
+    if (!file.Open(path)) {
+        LOG_WARNING_F("MeshCache: Cache file %s is no longer available", path.c_str());
+        return false;
+    }
+    
+    const uint8_t* data = file.GetData();
+    const size_t size = file.GetSize();
+    FileHeader header{};
+    if (!ReadHeader(data, size, key, path, header)) {
+        return false;
+    }
+    if (meshIndex >= header.meshCount) {
+        LOG_WARNING_F("MeshCache: Mesh index %u out of range in %s", meshIndex, path.c_str());
+        return false;
+    }
+    
+    // 只读取目标网格的记录与数据块，其余网格的数据页不会被读入
+    MeshRecord record{};
+    std::memcpy(&record, data + sizeof(FileHeader) + meshIndex * sizeof(MeshRecord), sizeof(record));
+    if (!RecordInBounds(record, size)) {
+        LOG_WARNING_F("MeshCache: Corrupted mesh %u in %s", meshIndex, path.c_str());
+        return false;
+    }
+    CopyMeshData(data, record, outVertices, outIndices);
+    return true;
+}
+
+Mesh::CPUDataSource MeshCache::MakeCPUDataSource(uint64_t key, uint32_t meshIndex) {
+    return [key, meshIndex](std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        return MeshCache::GetInstance().LoadMeshData(key, meshIndex, vertices, indices);
+    };
+}
+
+bool MeshCache::Store(uint64_t key,
+                      const std::vector<MeshImportResult>& results,
+                      const std::vector<MeshMaterialDesc>& materials) {
+    if (!IsEnabled() || results.empty()) {
+        return false;
+    }
+    
+    const uint32_t meshCount = static_cast<uint32_t>(results.size());
+    std::vector<MeshRecord> records(meshCount);
+    std::vector<std::vector<Vertex>> vertexBlocks(meshCount);
+    std::vector<std::vector<uint32_t>> indexBlocks(meshCount);
+    std::vector<std::vector<uint8_t>> metaBlocks(meshCount);
+    const MeshMaterialDesc noMaterial;
+    
+    uint64_t offset = sizeof(FileHeader) + static_cast<uint64_t>(meshCount) * sizeof(MeshRecord);
+    for (uint32_t i = 0; i < meshCount; ++i) {
+        const MeshImportResult& result = results[i];
+        if (!result.mesh) {
+            LOG_WARNING_F("MeshCache: Result %u has no mesh, skipping store", i);
+            return false;
+        }
+        
+        result.mesh->AccessVertices([&](const std::vector<Vertex>& vertices) {
+            vertexBlocks[i] = vertices;
+        });
+        result.mesh->AccessIndices([&](const std::vector<uint32_t>& indices) {
+            indexBlocks[i] = indices;
+        });
+        const AABB bounds = result.mesh->CalculateBounds();
+        
+        BlobWriter writer;
+        WriteMeta(writer, result, i < materials.size() ? materials[i] : noMaterial);
+        metaBlocks[i] = writer.GetBuffer();
+        
+        MeshRecord& record = records[i];
+        record = MeshRecord{};
+        record.vertexCount = static_cast<uint32_t>(vertexBlocks[i].size());
+        record.indexCount = static_cast<uint32_t>(indexBlocks[i].size());
+        for (int axis = 0; axis < 3; ++axis) {
+            record.boundsMin[axis] = bounds.min[axis];
+            record.boundsMax[axis] = bounds.max[axis];
+        }
+        
+        offset = AlignOffset(offset);
+        record.vertexOffset = offset;
+        offset += vertexBlocks[i].size() * sizeof(Vertex);
+        offset = AlignOffset(offset);
+        record.indexOffset = offset;
+        offset += indexBlocks[i].size() * sizeof(uint32_t);
+        offset = AlignOffset(offset);
+        record.metaOffset = offset;
+        record.metaSize = metaBlocks[i].size();
+        offset += metaBlocks[i].size();
+    }
+    
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.key = key;
+    header.meshCount = meshCount;
+    header.vertexStride = sizeof(Vertex);
+    
+    const std::string path = GetCachePath(key);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    
+    // 先写临时文件再重命名，避免其他线程/进程读到写了一半的文件
+    std::ostringstream tempSuffix;
+    tempSuffix << ".tmp" << std::this_thread::get_id();
+    const std::string tempPath = path + tempSuffix.str();
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            LOG_WARNING_F("MeshCache: Failed to open %s for writing", tempPath.c_str());
+            return false;
+        }
+        
+        uint64_t written = 0;
+        auto writeBytes = [&](const void* bytes, uint64_t count) {
+            out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+            written += count;
+        };
+        auto padTo = [&](uint64_t target) {
+            static const char zeros[kBlobAlignment] = {};
+            if (target > written) {
+                writeBytes(zeros, target - written);
+            }
+        };
+        
+        writeBytes(&header, sizeof(header));
+        writeBytes(records.data(), records.size() * sizeof(MeshRecord));
+        for (uint32_t i = 0; i < meshCount; ++i) {
+            padTo(records[i].vertexOffset);
+            writeBytes(vertexBlocks[i].data(), vertexBlocks[i].size() * sizeof(Vertex));
+            padTo(records[i].indexOffset);
+            writeBytes(indexBlocks[i].data(), indexBlocks[i].size() * sizeof(uint32_t));
+            padTo(records[i].metaOffset);
+            writeBytes(metaBlocks[i].data(), metaBlocks[i].size());
+        }
+        if (!out.good()) {
+            LOG_WARNING_F("MeshCache: Failed to write %s", tempPath.c_str());
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        // Windows 上目标已存在时重命名可能失败（其他线程已写入相同内容）
+        std::filesystem::remove(tempPath, ec);
+        return std::filesystem::exists(path);
+    }
+    
+    m_writes++;
+    LOG_INFO_F("MeshCache: Stored %u meshes to %s (%llu bytes)",
+               meshCount, path.c_str(), static_cast<unsigned long long>(offset));
+    return true;
+}
+
+size_t MeshCache::ClearDiskCache() {
+    const std::string directory = GetCacheDirectory();
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        return 0;
+    }
+    
+    size_t removed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".meshc") {
+            if (std::filesystem::remove(entry.path(), ec)) {
+                removed++;
+            }
+        }
+    }
+    return removed;
+}
+
+MeshCache::Stats MeshCache::GetStats() const {
+    Stats stats;
+    stats.hits = m_hits.load();
+    stats.misses = m_misses.load();
+    stats.writes = m_writes.load();
+    return stats;
+}
+
+void MeshCache::ResetStats() {
+    m_hits = 0;
+    m_misses = 0;
+    m_writes = 0;
+}
+
+} // namespace Render
@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/mesh_kernels.h"
+#include "render/mesh_loader.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace Render {
+namespace MeshKernels {
+
+namespace {
+
+constexpr float kEpsilon = 1e-6f;
+
+// 直接以 float 流访问 Vertex 数组（布局与 GL 顶点属性一致：紧密排列的 18 个 float）
+constexpr int kVertexStride = 18;
+constexpr int kPositionOffset = 0;
+constexpr int kTexCoordOffset = 3;
+constexpr int kTangentOffset = 12;   // tangent(3) 与 bitangent(3) 相邻
+static_assert(sizeof(Vertex) == kVertexStride * sizeof(float), "Vertex must be tightly packed floats");
+
+/// 每顶点累加的切线 / 副切线（32 字节对齐，AVX2 下整行读改写）
+struct alignas(32) TangentAccum {
+    float t[3];
+    float b[3];
+    float padding[2];
+};
+
+/**
+ * @brief 每线程复用的累加缓冲：导入时同一 worker 连续处理多个网格，
+ *        避免每个网格重新分配并缺页清零整块内存
+ */
+TangentAccum* AcquireAccumScratch(size_t vertexCount) {
+    thread_local std::vector<TangentAccum> scratch;
+    scratch.assign(vertexCount, TangentAccum{});
+    return scratch.data();
+}
+
+inline void AccumulateTriangle(const Vertex* vertices, TangentAccum* accum, uint32_t i0, uint32_t i1, uint32_t i2, size_t vertexCount) {
+    if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+        return;
+    }
+    const Vertex& v0 = vertices[i0];
+    const Vertex& v1 = vertices[i1];
+    const Vertex& v2 = vertices[i2];
+    const float e1x = v1.position.x() - v0.position.x();
+    const float e1y = v1.position.y() - v0.position.y();
+    const float e1z = v1.position.z() - v0.position.z();
+    const float e2x = v2.position.x() - v0.position.x();
+    const float e2y = v2.position.y() - v0.position.y();
+    const float e2z = v2.position.z() - v0.position.z();
+    const float du1 = v1.texCoord.x() - v0.texCoord.x(), dv1 = v1.texCoord.y() - v0.texCoord.y();
+    const float du2 = v2.texCoord.x() - v0.texCoord.x(), dv2 = v2.texCoord.y() - v0.texCoord.y();
+    
+    const float determinant = du1 * dv2 - du2 * dv1;
+    if (std::abs(determinant) < kEpsilon) {
+        return;
+    }
+    const float r = 1.0f / determinant;
+    const float tangent[3] = {(e1x * dv2 - e2x * dv1) * r, (e1y * dv2 - e2y * dv1) * r, (e1z * dv2 - e2z * dv1) * r};
+    const float bitangent[3] = {(e2x * du1 - e1x * du2) * r, (e2y * du1 - e1y * du2) * r, (e2z * du1 - e1z * du2) * r};
+    
+    for (uint32_t index : {i0, i1, i2}) {
+        for (int k = 0; k < 3; ++k) {
+            accum[index].t[k] += tangent[k];
+            accum[index].b[k] += bitangent[k];
+        }
+    }
+}
+
+/**
+ * @brief 单个顶点的 Gram-Schmidt 正交化（与原 Mesh::RecalculateTangents 逐顶点实现相同）
+ * @param frame 连续的 tangent(3) + bitangent(3)，可以指向 vertex 自身
+ */
+inline void OrthonormalizeVertex(Vertex& vertex, const float* frame) {
+    float nx = vertex.normal.x(), ny = vertex.normal.y(), nz = vertex.normal.z();
+    const float n2 = nx * nx + ny * ny + nz * nz;
+    if (n2 < kEpsilon) {
+        nx = 0.0f; ny = 1.0f; nz = 0.0f;
+    } else {
+        const float length = std::sqrt(n2);
+        nx /= length; ny /= length; nz /= length;
+    }
+    
+    float tx = frame[0], ty = frame[1], tz = frame[2];
+    if (tx * tx + ty * ty + tz * tz < kEpsilon) {
+        tx = 1.0f; ty = 0.0f; tz = 0.0f;
+    }
+    const float d = nx * tx + ny * ty + nz * tz;
+    tx -= nx * d; ty -= ny * d; tz -= nz * d;
+    const float tLength = std::sqrt(tx * tx + ty * ty + tz * tz);
+    if (tLength < kEpsilon) {
+        tx = 1.0f; ty = 0.0f; tz = 0.0f;
+    } else {
+        tx /= tLength; ty /= tLength; tz /= tLength;
+    }
+    
+    const float cx = ny * tz - nz * ty;
+    const float cy = nz * tx - nx * tz;
+    const float cz = nx * ty - ny * tx;
+    const float bx = frame[3], by = frame[4], bz = frame[5];
+    const float b2 = bx * bx + by * by + bz * bz;
+    const float handedness = (b2 >= kEpsilon && cx * bx + cy * by + cz * bz < 0.0f) ? -1.0f : 1.0f;
+    
+    vertex.normal = Vector3(nx, ny, nz);
+    vertex.tangent = Vector3(tx, ty, tz);
+    vertex.bitangent = Vector3(cx * handedness, cy * handedness, cz * handedness);
+}
+
+#ifdef __AVX2__
+
+/// 8x8 转置：rows[i] 的第 j 个元素变为 rows[j] 的第 i 个元素
+inline void Transpose8x8(__m256 rows[8]) {
+    const __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+    const __m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+    const __m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+    const __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+    const __m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+    const __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+    const __m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    rows[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+    rows[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+    rows[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+    rows[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+    rows[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+    rows[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+    rows[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+    rows[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+inline __m256 Dot3(__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz) {
+    return _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx)));
+}
+
+/// tangent + bitangent 共 6 个 float 的读写掩码
+inline __m256i FrameMask() {
+    return _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0);
+}
+
+/**
+ * @brief 以 8 个三角形为一组计算切线（从 Vertex 数组 gather + 8 宽运算），
+ *        转置后按三角形顺序把每个角的 6 分量一次性加到累加缓冲上
+ * @return 已处理的三角形数（剩余部分由标量路径处理）
+ */
+size_t AccumulateTrianglesAVX2(const Vertex* vertices, TangentAccum* accum,
+                               const uint32_t* indices, size_t triangleCount, size_t vertexCount) {
+    const __m256i stride = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    const __m256i maxIndex = _mm256_set1_epi32(static_cast<int>(vertexCount - 1));
+    const __m256i vertexStride = _mm256_set1_epi32(kVertexStride);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 epsilon = _mm256_set1_ps(kEpsilon);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const float* base = reinterpret_cast<const float*>(vertices);
+    
+    alignas(32) uint32_t lanes[3][8];
+    
+    size_t t = 0;
+    for (; t + 8 <= triangleCount; t += 8) {
+        __m256i vi[3];
+        for (int corner = 0; corner < 3; ++corner) {
+            if (indices) {
+                vi[corner] = _mm256_i32gather_epi32(reinterpret_cast<const int*>(indices + t * 3 + corner), stride, 4);
+            } else {
+                vi[corner] = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(t * 3 + corner)), stride);
+            }
+        }
+        
+        // 越界索引的三角形跳过（先把下标置 0 保证 gather 安全）
+        __m256i valid = _mm256_set1_epi32(-1);
+        for (int corner = 0; corner < 3; ++corner) {
+            valid = _mm256_and_si256(valid, _mm256_cmpeq_epi32(_mm256_min_epu32(vi[corner], maxIndex), vi[corner]));
+        }
+        __m256i offset[3];
+        for (int corner = 0; corner < 3; ++corner) {
+            vi[corner] = _mm256_and_si256(vi[corner], valid);
+            offset[corner] = _mm256_mullo_epi32(vi[corner], vertexStride);
+        }
+        
+        auto gather = [base](const __m256i& index, int component) {
+            return _mm256_i32gather_ps(base + component, index, 4);
+        };
+        const __m256 px0 = gather(offset[0], kPositionOffset);
+        const __m256 py0 = gather(offset[0], kPositionOffset + 1);
+        const __m256 pz0 = gather(offset[0], kPositionOffset + 2);
+        const __m256 u0 = gather(offset[0], kTexCoordOffset);
+        const __m256 v0 = gather(offset[0], kTexCoordOffset + 1);
+        const __m256 e1x = _mm256_sub_ps(gather(offset[1], kPositionOffset), px0);
+        const __m256 e1y = _mm256_sub_ps(gather(offset[1], kPositionOffset + 1), py0);
+        const __m256 e1z = _mm256_sub_ps(gather(offset[1], kPositionOffset + 2), pz0);
+        const __m256 du1 = _mm256_sub_ps(gather(offset[1], kTexCoordOffset), u0);
+        const __m256 dv1 = _mm256_sub_ps(gather(offset[1], kTexCoordOffset + 1), v0);
+        const __m256 e2x = _mm256_sub_ps(gather(offset[2], kPositionOffset), px0);
+        const __m256 e2y = _mm256_sub_ps(gather(offset[2], kPositionOffset + 1), py0);
+        const __m256 e2z = _mm256_sub_ps(gather(offset[2], kPositionOffset + 2), pz0);
+        const __m256 du2 = _mm256_sub_ps(gather(offset[2], kTexCoordOffset), u0);
+        const __m256 dv2 = _mm256_sub_ps(gather(offset[2], kTexCoordOffset + 1), v0);
+        
+        const __m256 determinant = _mm256_fmsub_ps(du1, dv2, _mm256_mul_ps(du2, dv1));
+        const __m256 usable = _mm256_and_ps(
+            _mm256_castsi256_ps(valid),
+            _mm256_cmp_ps(_mm256_andnot_ps(signMask, determinant), epsilon, _CMP_GE_OQ));
+        const int mask = _mm256_movemask_ps(usable);
+        if (mask == 0) {
+            continue;
+        }
+        const __m256 r = _mm256_div_ps(one, determinant);
+        
+        __m256 rows[8] = {
+            _mm256_mul_ps(_mm256_fmsub_ps(e1x, dv2, _mm256_mul_ps(e2x, dv1)), r),
+            _mm256_mul_ps(_mm256_fmsub_ps(e1y, dv2, _mm256_mul_ps(e2y, dv1)), r),
+            _mm256_mul_ps(_mm256_fmsub_ps(e1z, dv2, _mm256_mul_ps(e2z, dv1)), r),
+            _mm256_mul_ps(_mm256_fmsub_ps(e2x, du1, _mm256_mul_ps(e1x, du2)), r),
+            _mm256_mul_ps(_mm256_fmsub_ps(e2y, du1, _mm256_mul_ps(e1y, du2)), r),
+            _mm256_mul_ps(_mm256_fmsub_ps(e2z, du1, _mm256_mul_ps(e1z, du2)), r),
+            _mm256_setzero_ps(),
+            _mm256_setzero_ps(),
+        };
+        Transpose8x8(rows);   // rows[lane] = (tx, ty, tz, bx, by, bz, 0, 0)
+        for (int corner = 0; corner < 3; ++corner) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[corner]), vi[corner]);
+        }
+        
+        for (int lane = 0; lane < 8; ++lane) {
+            if (!(mask & (1 << lane))) {
+                continue;
+            }
+            for (int corner = 0; corner < 3; ++corner) {
+                float* frame = accum[lanes[corner][lane]].t;
+                _mm256_store_ps(frame, _mm256_add_ps(_mm256_load_ps(frame), rows[lane]));
+            }
+        }
+    }
+    return t;
+}
+
+/**
+ * @brief 以 8 个顶点为一组正交化（转置 tangent/bitangent 为 SoA 后 8 宽运算）
+ * @param frames      第 i 个顶点的 tangent(3) + bitangent(3) 位于 frames + i * frameStride
+ * @return 已处理的顶点数
+ */
+size_t OrthonormalizeAVX2(Vertex* vertices, const float* frames, size_t frameStride, size_t count) {
+    const __m256i frameMask = FrameMask();
+    const __m256 epsilon = _mm256_set1_ps(kEpsilon);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 minusOne = _mm256_set1_ps(-1.0f);
+    alignas(32) float normal[3][8];
+    alignas(32) float out[9][8];
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 rows[8];
+        for (int lane = 0; lane < 8; ++lane) {
+            rows[lane] = _mm256_maskload_ps(frames + (i + lane) * frameStride, frameMask);
+            normal[0][lane] = vertices[i + lane].normal.x();
+            normal[1][lane] = vertices[i + lane].normal.y();
+            normal[2][lane] = vertices[i + lane].normal.z();
+        }
+        Transpose8x8(rows);   // rows[0..5] = tx, ty, tz, bx, by, bz
+        
+        __m256 nx = _mm256_load_ps(normal[0]);
+        __m256 ny = _mm256_load_ps(normal[1]);
+        __m256 nz = _mm256_load_ps(normal[2]);
+        const __m256 n2 = Dot3(nx, ny, nz, nx, ny, nz);
+        const __m256 degenerateNormal = _mm256_cmp_ps(n2, epsilon, _CMP_LT_OQ);
+        const __m256 nLength = _mm256_sqrt_ps(n2);
+        nx = _mm256_blendv_ps(_mm256_div_ps(nx, nLength), zero, degenerateNormal);
+        ny = _mm256_blendv_ps(_mm256_div_ps(ny, nLength), one, degenerateNormal);
+        nz = _mm256_blendv_ps(_mm256_div_ps(nz, nLength), zero, degenerateNormal);
+        
+        __m256 tx = rows[0], ty = rows[1], tz = rows[2];
+        const __m256 missingTangent = _mm256_cmp_ps(Dot3(tx, ty, tz, tx, ty, tz), epsilon, _CMP_LT_OQ);
+        tx = _mm256_blendv_ps(tx, one, missingTangent);
+        ty = _mm256_blendv_ps(ty, zero, missingTangent);
+        tz = _mm256_blendv_ps(tz, zero, missingTangent);
+        const __m256 d = Dot3(nx, ny, nz, tx, ty, tz);
+        tx = _mm256_fnmadd_ps(nx, d, tx);
+        ty = _mm256_fnmadd_ps(ny, d, ty);
+        tz = _mm256_fnmadd_ps(nz, d, tz);
+        const __m256 tLength = _mm256_sqrt_ps(Dot3(tx, ty, tz, tx, ty, tz));
+        const __m256 degenerateTangent = _mm256_cmp_ps(tLength, epsilon, _CMP_LT_OQ);
+        tx = _mm256_blendv_ps(_mm256_div_ps(tx, tLength), one, degenerateTangent);
+        ty = _mm256_blendv_ps(_mm256_div_ps(ty, tLength), zero, degenerateTangent);
+        tz = _mm256_blendv_ps(_mm256_div_ps(tz, tLength), zero, degenerateTangent);
+        
+        const __m256 cx = _mm256_fmsub_ps(ny, tz, _mm256_mul_ps(nz, ty));
+        const __m256 cy = _mm256_fmsub_ps(nz, tx, _mm256_mul_ps(nx, tz));
+        const __m256 cz = _mm256_fmsub_ps(nx, ty, _mm256_mul_ps(ny, tx));
+        const __m256 bx = rows[3], by = rows[4], bz = rows[5];
+        const __m256 flip = _mm256_and_ps(
+            _mm256_cmp_ps(Dot3(bx, by, bz, bx, by, bz), epsilon, _CMP_GE_OQ),
+            _mm256_cmp_ps(Dot3(cx, cy, cz, bx, by, bz), zero, _CMP_LT_OQ));
+        const __m256 handedness = _mm256_blendv_ps(one, minusOne, flip);
+        
+        const __m256 results[9] = {nx, ny, nz, tx, ty, tz,
+                                   _mm256_mul_ps(cx, handedness), _mm256_mul_ps(cy, handedness),
+                                   _mm256_mul_ps(cz, handedness)};
+        for (int k = 0; k < 9; ++k) {
+            _mm256_store_ps(out[k], results[k]);
+        }
+        for (int lane = 0; lane < 8; ++lane) {
+            Vertex& vertex = vertices[i + lane];
+            vertex.normal = Vector3(out[0][lane], out[1][lane], out[2][lane]);
+            vertex.tangent = Vector3(out[3][lane], out[4][lane], out[5][lane]);
+            vertex.bitangent = Vector3(out[6][lane], out[7][lane], out[8][lane]);
+        }
+    }
+    return i;
+}
+
+#endif
+
+void Orthonormalize(Vertex* vertices, const float* frames, size_t frameStride, size_t count) {
+    size_t begin = 0;
+#ifdef __AVX2__
+    begin = OrthonormalizeAVX2(vertices, frames, frameStride, count);
+#endif
+    for (size_t i = begin; i < count; ++i) {
+        OrthonormalizeVertex(vertices[i], frames + i * frameStride);
+    }
+}
+
+} // namespace
+
+void ComputeTangents(Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount) {
+    if (!vertices || vertexCount == 0) {
+        return;
+    }
+    
+    TangentAccum* accum = AcquireAccumScratch(vertexCount);
+    
+    const size_t triangleCount = indices ? indexCount / 3 : vertexCount / 3;
+    size_t t = 0;
+#ifdef __AVX2__
+    // gather 偏移为 32 位（顶点下标 * 18 个 float）
+    if (vertexCount <= static_cast<size_t>(std::numeric_limits<int32_t>::max() / kVertexStride)) {
+        t = AccumulateTrianglesAVX2(vertices, accum, indices, triangleCount, vertexCount);
+    }
+#endif
+    for (; t < triangleCount; ++t) {
+        const size_t base = t * 3;
+        if (indices) {
+            AccumulateTriangle(vertices, accum, indices[base], indices[base + 1], indices[base + 2], vertexCount);
+        } else {
+            AccumulateTriangle(vertices, accum, static_cast<uint32_t>(base), static_cast<uint32_t>(base + 1),
+                               static_cast<uint32_t>(base + 2), vertexCount);
+        }
+    }
+    
+    Orthonormalize(vertices, accum[0].t, sizeof(TangentAccum) / sizeof(float), vertexCount);
+}
+
+void OrthonormalizeTangents(Vertex* vertices, size_t vertexCount) {
+    if (!vertices) {
+        return;
+    }
+    // 导入的切线已在 Vertex 内，原地正交化
+    Orthonormalize(vertices, reinterpret_cast<const float*>(vertices) + kTangentOffset, kVertexStride, vertexCount);
+}
+
+void LimitBoneWeights(std::vector<uint32_t>& offsets,
+                      std::vector<VertexBoneWeight>& weights,
+                      uint32_t maxWeights,
+                      bool normalize) {
+    if (offsets.size() < 2) {
+        return;
+    }
+    const size_t vertexCount = offsets.size() - 1;
+    auto byWeightDesc = [](const VertexBoneWeight& lhs, const VertexBoneWeight& rhs) {
+        return lhs.weight > rhs.weight;
+    };
+    
+    // 逐顶点处理并向前压缩（写位置不超过读位置）
+    uint32_t write = 0;
+    for (size_t v = 0; v < vertexCount; ++v) {
+        const uint32_t begin = offsets[v];
+        const uint32_t end = offsets[v + 1];
+        VertexBoneWeight* span = weights.data() + begin;
+        uint32_t count = end - begin;
+        
+        if (maxWeights > 0 && count > maxWeights) {
+            std::partial_sort(span, span + maxWeights, span + count, byWeightDesc);
+            count = maxWeights;
+        }
+        
+        if (normalize) {
+            float sum = 0.0f;
+            for (uint32_t i = 0; i < count; ++i) {
+                sum += span[i].weight;
+            }
+            if (sum > 0.0f) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    span[i].weight /= sum;
+                }
+            }
+        }
+        
+        offsets[v] = write;
+        if (write != begin) {
+            std::copy(span, span + count, weights.data() + write);
+        }
+        write += count;
+    }
+    offsets[vertexCount] = write;
+    weights.resize(write);
+}
+
+} // namespace MeshKernels
+} // namespace Render
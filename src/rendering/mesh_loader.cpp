@@ -19,10 +19,16 @@
  * For commercial licensing, please contact: 2052046346@qq.com
  */
 #include "render/mesh_loader.h"
+#include "render/mesh_cache.h"
+#include "render/file_utils.h"
 #include "render/material.h"
 #include "render/texture_loader.h"
 #include "render/logger.h"
+#include "render/mesh_kernels.h"
+#include "render/mesh_optimizer.h"
+#include "render/task_scheduler.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <numeric>
 #include <limits>
@@ -83,7 +89,8 @@ static unsigned int GeneratePostProcessFlags(const MeshImportOptions& options) {
     if (options.sortByPrimitiveType) {
         flags |= aiProcess_SortByPType;
     }
-    if (options.improveCacheLocality) {
+    // MeshOptimizer 会重新排序索引，此时 Assimp 的缓存局部性处理是多余的
+    if (options.improveCacheLocality && !options.runMeshOptimizer) {
         flags |= aiProcess_ImproveCacheLocality;
     }
     if (options.optimizeMeshes) {
@@ -148,10 +155,10 @@ static Ref<Mesh> ProcessAssimpMesh(
         extraData->skinning.Clear();
     }
     
-    // 提取顶点数据
-    vertices.reserve(assimpMesh->mNumVertices);
+    // 提取顶点数据（预先分配，原地写入）
+    vertices.resize(assimpMesh->mNumVertices);
     for (uint32_t i = 0; i < assimpMesh->mNumVertices; i++) {
-        Vertex vertex;
+        Vertex& vertex = vertices[i];
         vertex.tangent = Vector3::Zero();
         vertex.bitangent = Vector3::Zero();
         
@@ -210,8 +217,6 @@ static Ref<Mesh> ProcessAssimpMesh(
                 requireTangentRecalculate = true;
             }
         }
-        
-        vertices.push_back(vertex);
     }
 
     // 收集额外的 UV 通道
@@ -266,49 +271,49 @@ static Ref<Mesh> ProcessAssimpMesh(
         }
     }
     
-    // 提取索引数据
-    indices.reserve(assimpMesh->mNumFaces * 3);
+    // 提取索引数据（先统计总数，避免非三角面导致的重新分配）
+    size_t indexCount = 0;
     for (uint32_t i = 0; i < assimpMesh->mNumFaces; i++) {
-        aiFace face = assimpMesh->mFaces[i];
-        for (uint32_t j = 0; j < face.mNumIndices; j++) {
-            indices.push_back(face.mIndices[j]);
-        }
+        indexCount += assimpMesh->mFaces[i].mNumIndices;
+    }
+    indices.resize(indexCount);
+    uint32_t* indexOut = indices.data();
+    for (uint32_t i = 0; i < assimpMesh->mNumFaces; i++) {
+        const aiFace& face = assimpMesh->mFaces[i];
+        indexOut = std::copy(face.mIndices, face.mIndices + face.mNumIndices, indexOut);
     }
     
-    if (hasTangents) {
-        const float EPSILON = 1e-6f;
-        for (auto& vertex : vertices) {
-            Vector3 normal = vertex.normal;
-            if (normal.squaredNorm() < EPSILON) {
-                normal = Vector3::UnitY();
-            } else {
-                normal.normalize();
-            }
+    // 切线空间：缺失或无效时由 UV 重建，否则对导入的切线正交化
+    if (requireTangentRecalculate && hasPrimaryUV) {
+        MeshKernels::ComputeTangents(vertices.data(), vertices.size(), indices.data(), indices.size());
+    } else {
+        if (hasTangents) {
+            MeshKernels::OrthonormalizeTangents(vertices.data(), vertices.size());
+        }
+        if (requireTangentRecalculate) {
+            Logger::GetInstance().Warning("MeshLoader: 由于缺少有效切线且没有 UV，无法重建切线空间");
+        }
+    }
 
-            Vector3 tangent = vertex.tangent;
-            if (tangent.squaredNorm() < EPSILON) {
-                tangent = Vector3::UnitX();
-            }
-            tangent = tangent - normal * normal.dot(tangent);
-            float tLen = tangent.norm();
-            if (tLen < EPSILON) {
-                tangent = Vector3::UnitX();
-            } else {
-                tangent /= tLen;
+    // 顶点缓存 / overdraw / 顶点获取顺序优化；额外 UV、颜色通道按同一映射重排
+    std::vector<uint32_t> vertexRemap;
+    if ((!options || options->runMeshOptimizer) && MeshOptimizer::Optimize(vertices, indices, {}, &vertexRemap)) {
+        if (extraData) {
+            for (auto& uvData : extraData->uvChannels) {
+                MeshOptimizer::RemapVertexAttribute(uvData, vertexRemap, vertices.size());
             }
-
-            Vector3 bitangent = vertex.bitangent;
-            float handedness = 1.0f;
-            if (bitangent.squaredNorm() >= EPSILON) {
-                handedness = (normal.cross(tangent).dot(bitangent) < 0.0f) ? -1.0f : 1.0f;
+            for (auto& colorData : extraData->colorChannels) {
+                MeshOptimizer::RemapVertexAttribute(colorData, vertexRemap, vertices.size());
             }
-            bitangent = normal.cross(tangent) * handedness;
-
-            vertex.normal = normal;
-            vertex.tangent = tangent;
-            vertex.bitangent = bitangent;
         }
     }
+    // Assimp 顶点编号 -> 最终顶点下标（被优化丢弃的顶点返回 kInvalidIndex）
+    auto mapVertex = [&](uint32_t assimpVertex) -> uint32_t {
+        if (assimpVertex >= assimpMesh->mNumVertices) {
+            return MeshOptimizer::kInvalidIndex;
+        }
+        return vertexRemap.empty() ? assimpVertex : vertexRemap[assimpVertex];
+    };
 
     // 蒙皮数据采集
     if (extraData && options && options->gatherBones && assimpMesh->HasBones()) {
@@ -316,10 +321,26 @@ static Ref<Mesh> ProcessAssimpMesh(
         skinning.Clear();
         skinning.bones.reserve(assimpMesh->mNumBones);
         skinning.boneOffsetMatrices.reserve(assimpMesh->mNumBones);
-        skinning.vertexWeights.resize(assimpMesh->mNumVertices);
+        skinning.vertexWeights.resize(vertices.size());
         skinning.boneNameToIndex.reserve(assimpMesh->mNumBones);
 
-        std::vector<std::vector<std::pair<uint32_t, float>>> rawWeights(assimpMesh->mNumVertices);
+        // 权重按顶点存入扁平数组（CSR）：先统计每个顶点的权重数，再按骨骼顺序填充
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        std::vector<uint32_t> weightOffsets(static_cast<size_t>(vertexCount) + 1, 0);
+        for (uint32_t boneIdx = 0; boneIdx < assimpMesh->mNumBones; ++boneIdx) {
+            const aiBone* bone = assimpMesh->mBones[boneIdx];
+            for (uint32_t weightIdx = 0; weightIdx < bone->mNumWeights; ++weightIdx) {
+                const uint32_t vertexIndex = mapVertex(bone->mWeights[weightIdx].mVertexId);
+                if (vertexIndex != MeshOptimizer::kInvalidIndex) {
+                    weightOffsets[vertexIndex + 1]++;
+                }
+            }
+        }
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            weightOffsets[v + 1] += weightOffsets[v];
+        }
+        std::vector<VertexBoneWeight> flatWeights(weightOffsets[vertexCount]);
+        std::vector<uint32_t> fillCursor(weightOffsets.begin(), weightOffsets.end() - 1);
 
         for (uint32_t boneIdx = 0; boneIdx < assimpMesh->mNumBones; ++boneIdx) {
             aiBone* bone = assimpMesh->mBones[boneIdx];
@@ -334,10 +355,11 @@ static Ref<Mesh> ProcessAssimpMesh(
 
             for (uint32_t weightIdx = 0; weightIdx < bone->mNumWeights; ++weightIdx) {
                 const aiVertexWeight& weight = bone->mWeights[weightIdx];
-                if (weight.mVertexId >= assimpMesh->mNumVertices) {
+                const uint32_t vertexIndex = mapVertex(weight.mVertexId);
+                if (vertexIndex == MeshOptimizer::kInvalidIndex) {
                     continue;
                 }
-                rawWeights[weight.mVertexId].emplace_back(boneIndex, weight.mWeight);
+                flatWeights[fillCursor[vertexIndex]++] = { boneIndex, weight.mWeight };
             }
         }
 
@@ -355,81 +377,102 @@ static Ref<Mesh> ProcessAssimpMesh(
         }
 
         const bool limitWeights = options->limitBoneWeightsPerVertex && options->maxBoneWeightsPerVertex > 0;
-        const bool normalizeWeights = options->normalizeBoneWeights;
-
-        for (uint32_t vertexIndex = 0; vertexIndex < assimpMesh->mNumVertices; ++vertexIndex) {
-            auto& weights = rawWeights[vertexIndex];
-            if (weights.empty()) {
-                continue;
-            }
-
-            if (limitWeights && weights.size() > options->maxBoneWeightsPerVertex) {
-                std::sort(weights.begin(), weights.end(), [](const auto& lhs, const auto& rhs) {
-                    return lhs.second > rhs.second;
-                });
-                weights.resize(options->maxBoneWeightsPerVertex);
-            }
-
-            float weightSum = 0.0f;
-            for (const auto& entry : weights) {
-                weightSum += entry.second;
-            }
-
-            if (weightSum > 0.0f && normalizeWeights) {
-                for (auto& entry : weights) {
-                    entry.second /= weightSum;
-                }
-            }
-
-            auto& vertexWeightsForVertex = skinning.vertexWeights[vertexIndex];
-            vertexWeightsForVertex.reserve(weights.size());
-
-            for (const auto& entry : weights) {
-                const uint32_t boneIndex = entry.first;
-                const float weight = entry.second;
-                vertexWeightsForVertex.push_back({ boneIndex, weight });
-                if (boneIndex < skinning.bones.size()) {
-                    skinning.bones[boneIndex].vertexWeights.push_back({ vertexIndex, weight });
+        MeshKernels::LimitBoneWeights(weightOffsets, flatWeights,
+                                      limitWeights ? options->maxBoneWeightsPerVertex : 0,
+                                      options->normalizeBoneWeights);
+
+        for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+            const VertexBoneWeight* begin = flatWeights.data() + weightOffsets[vertexIndex];
+            const VertexBoneWeight* end = flatWeights.data() + weightOffsets[vertexIndex + 1];
+            skinning.vertexWeights[vertexIndex].assign(begin, end);
+            for (const VertexBoneWeight* entry = begin; entry != end; ++entry) {
+                if (entry->boneIndex < skinning.bones.size()) {
+                    skinning.bones[entry->boneIndex].vertexWeights.push_back({ vertexIndex, entry->weight });
                 }
             }
         }
     }
 
-    // 创建网格
-    auto mesh = CreateRef<Mesh>(vertices, indices);
-
-    if (requireTangentRecalculate) {
-        if (hasPrimaryUV) {
-            mesh->RecalculateTangents();
-        } else {
-            Logger::GetInstance().Warning("MeshLoader: 由于缺少有效切线且没有 UV，无法重建切线空间");
-        }
-    }
+    // 创建网格（数据直接移入，不再复制）
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = indices.size() / 3;
+    auto mesh = CreateRef<Mesh>(std::move(vertices), std::move(indices));
     
     // ⭐ v0.12.0: 条件上传（支持异步加载）
     if (autoUpload) {
         mesh->Upload();
     }
     
-    Logger::GetInstance().Info("Processed mesh: " + std::to_string(vertices.size()) + 
-                               " vertices, " + std::to_string(indices.size() / 3) + " triangles");
+    Logger::GetInstance().Info("Processed mesh: " + std::to_string(vertexCount) + 
+                               " vertices, " + std::to_string(triangleCount) + " triangles");
     
     return mesh;
 }
 
 /**
- * @brief 递归处理 Assimp 场景节点
+ * @brief 场景中的一个网格实例（节点引用的网格及其变换）
  */
-static void ProcessAssimpNode(aiNode* node, const aiScene* scene, std::vector<Ref<Mesh>>& meshes, bool autoUpload = true) {
-    // 处理当前节点的所有网格
-    for (uint32_t i = 0; i < node->mNumMeshes; i++) {
-        aiMesh* assimpMesh = scene->mMeshes[node->mMeshes[i]];
-        meshes.push_back(ProcessAssimpMesh(assimpMesh, scene, autoUpload));
+struct AssimpMeshInstance {
+    const aiNode* node = nullptr;
+    uint32_t slot = 0;                          ///< 在 node->mMeshes 中的位置
+    Matrix4 localTransform = Matrix4::Identity();
+    Matrix4 worldTransform = Matrix4::Identity();
+};
+
+/**
+ * @brief 按深度优先顺序收集网格实例（与原递归处理顺序一致）
+ */
+static void CollectAssimpMeshInstances(const aiNode* node,
+                                       const Matrix4& parentTransform,
+                                       std::vector<AssimpMeshInstance>& instances) {
+    AssimpMeshInstance instance;
+    instance.node = node;
+    instance.localTransform = ConvertMatrix(node->mTransformation);
+    instance.worldTransform = parentTransform * instance.localTransform;
+    for (uint32_t i = 0; i < node->mNumMeshes; ++i) {
+        instance.slot = i;
+        instances.push_back(instance);
     }
-    
-    // 递归处理子节点
-    for (uint32_t i = 0; i < node->mNumChildren; i++) {
-        ProcessAssimpNode(node->mChildren[i], scene, meshes, autoUpload);
+    for (uint32_t i = 0; i < node->mNumChildren; ++i) {
+        CollectAssimpMeshInstances(node->mChildren[i], instance.worldTransform, instances);
+    }
+}
+
+/**
+ * @brief 在 TaskScheduler 工作线程上并行转换网格（不上传）
+ * @param extras 非空时为每个实例采集额外数据（需预先设置变换等字段）
+ * 
+ * 各网格的顶点收集、切线与蒙皮处理互不依赖；上传与材质创建由调用方在当前线程串行完成
+ */
+static std::vector<Ref<Mesh>> ProcessAssimpMeshesParallel(
+    const std::vector<AssimpMeshInstance>& instances,
+    const aiScene* scene,
+    std::vector<MeshExtraData>* extras = nullptr,
+    const MeshImportOptions* options = nullptr) {
+    std::vector<Ref<Mesh>> meshes(instances.size());
+    TaskScheduler::GetInstance().ParallelFor(instances.size(), [&](size_t i) {
+        const AssimpMeshInstance& instance = instances[i];
+        aiMesh* assimpMesh = scene->mMeshes[instance.node->mMeshes[instance.slot]];
+        meshes[i] = ProcessAssimpMesh(assimpMesh, scene, false, extras ? &(*extras)[i] : nullptr, options);
+    }, TaskPriority::High, "MeshImport");
+    return meshes;
+}
+
+/**
+ * @brief 处理 Assimp 场景节点及其子节点的所有网格
+ */
+static void ProcessAssimpNode(aiNode* node, const aiScene* scene, std::vector<Ref<Mesh>>& meshes, bool autoUpload = true) {
+    std::vector<AssimpMeshInstance> instances;
+    CollectAssimpMeshInstances(node, Matrix4::Identity(), instances);
+    
+    auto processed = ProcessAssimpMeshesParallel(instances, scene);
+    meshes.reserve(meshes.size() + processed.size());
+    for (auto& mesh : processed) {
+        // ⭐ v0.12.0: 条件上传（支持异步加载）
+        if (autoUpload) {
+            mesh->Upload();
+        }
+        meshes.push_back(std::move(mesh));
     }
 }
 
@@ -438,25 +481,96 @@ static void ProcessAssimpNode(aiNode* node, const aiScene* scene, std::vector<Re
 // ============================================================================
 
 /**
- * @brief 从 Assimp 材质加载纹理
+ * @brief 读取 Assimp 材质中指定类型的第一张纹理路径
+ */
+static std::string GetMaterialTexturePath(const aiMaterial* mat, aiTextureType type) {
+    if (mat->GetTextureCount(type) == 0) {
+        return {};
+    }
+    aiString texPath;
+    mat->GetTexture(type, 0, &texPath);
+    return std::string(texPath.C_Str());
+}
+
+/**
+ * @brief 从 Assimp 材质提取与导入器无关的材质描述
+ */
+static MeshMaterialDesc ExtractMaterialDesc(const aiMaterial* aiMat, uint32_t materialIndex) {
+    MeshMaterialDesc desc;
+    desc.valid = true;
+    desc.materialIndex = materialIndex;
+
+    // 材质名称
+    aiString materialName;
+    if (aiMat->Get(AI_MATKEY_NAME, materialName) == AI_SUCCESS) {
+        desc.name = materialName.C_Str();
+    }
+    if (desc.name.empty()) {
+        desc.name = "Material_" + std::to_string(materialIndex);
+    }
+
+    // 颜色属性
+    aiColor3D color(0.0f, 0.0f, 0.0f);
+    if (aiMat->Get(AI_MATKEY_COLOR_AMBIENT, color) == AI_SUCCESS) {
+        desc.ambientColor = Color(color.r, color.g, color.b, 1.0f);
+    }
+    if (aiMat->Get(AI_MATKEY_COLOR_DIFFUSE, color) == AI_SUCCESS) {
+        desc.diffuseColor = Color(color.r, color.g, color.b, 1.0f);
+    }
+    if (aiMat->Get(AI_MATKEY_COLOR_SPECULAR, color) == AI_SUCCESS) {
+        desc.specularColor = Color(color.r, color.g, color.b, 1.0f);
+    }
+    if (aiMat->Get(AI_MATKEY_COLOR_EMISSIVE, color) == AI_SUCCESS) {
+        desc.emissiveColor = Color(color.r, color.g, color.b, 1.0f);
+    }
+
+    // 标量属性（含 PBR 属性，如果可用）
+    float value = 0.0f;
+    if (aiMat->Get(AI_MATKEY_SHININESS, value) == AI_SUCCESS) {
+        desc.shininess = value;
+    }
+    if (aiMat->Get(AI_MATKEY_OPACITY, value) == AI_SUCCESS) {
+        desc.opacity = value;
+    }
+    if (aiMat->Get(AI_MATKEY_METALLIC_FACTOR, value) == AI_SUCCESS) {
+        desc.metallic = value;
+    }
+    if (aiMat->Get(AI_MATKEY_ROUGHNESS_FACTOR, value) == AI_SUCCESS) {
+        desc.roughness = value;
+    }
+
+    // 纹理贴图路径
+    auto addTexture = [&desc](const char* slotName, std::string path) {
+        if (!path.empty()) {
+            desc.textures.push_back({ slotName, std::move(path) });
+        }
+    };
+    addTexture("diffuseMap", GetMaterialTexturePath(aiMat, aiTextureType_DIFFUSE));
+    addTexture("specularMap", GetMaterialTexturePath(aiMat, aiTextureType_SPECULAR));
+
+    // 有些格式使用 HEIGHT 代替 NORMALS
+    std::string normalPath = GetMaterialTexturePath(aiMat, aiTextureType_NORMALS);
+    if (normalPath.empty()) {
+        normalPath = GetMaterialTexturePath(aiMat, aiTextureType_HEIGHT);
+    }
+    addTexture("normalMap", std::move(normalPath));
+    addTexture("aoMap", GetMaterialTexturePath(aiMat, aiTextureType_AMBIENT_OCCLUSION));
+    addTexture("emissiveMap", GetMaterialTexturePath(aiMat, aiTextureType_EMISSIVE));
+
+    return desc;
+}
+
+/**
+ * @brief 加载材质纹理（或在延迟上传模式下记录纹理请求）
  */
 static Ref<Texture> LoadMaterialTexture(
-    aiMaterial* mat,
-    aiTextureType type,
+    const std::string& texPathStr,
     const std::string& basePath,
     const std::string& textureName,
     const std::string& slotName,
     bool autoUpload,
     std::vector<MaterialTextureRequest>* pendingRequests)
 {
-    if (mat->GetTextureCount(type) == 0) {
-        return nullptr;
-    }
-    
-    aiString texPath;
-    mat->GetTexture(type, 0, &texPath);
-    
-    std::string texPathStr(texPath.C_Str());
     if (texPathStr.empty()) {
         return nullptr;
     }
@@ -495,182 +609,107 @@ static Ref<Texture> LoadMaterialTexture(
 }
 
 /**
- * @brief 从 Assimp 材质创建 Material 对象
+ * @brief 根据材质描述创建 Material 对象
+ * 
+ * Assimp 导入路径与二进制网格缓存命中路径共用此函数，保证两者得到相同的材质。
  */
-static Ref<Material> ProcessAssimpMaterial(
-    aiMaterial* aiMat,
-    const aiScene* scene,
+static Ref<Material> BuildMaterialFromDesc(
+    const MeshMaterialDesc& desc,
     const std::string& basePath,
     Ref<Shader> shader,
-    uint32_t materialIndex,
     bool autoUpload,
     std::vector<MaterialTextureRequest>* pendingRequests)
 {
     auto material = CreateRef<Material>();
-    
-    // 设置材质名称
-    aiString materialName;
-    if (aiMat->Get(AI_MATKEY_NAME, materialName) == AI_SUCCESS) {
-        material->SetName(std::string(materialName.C_Str()));
-    } else {
-        material->SetName("Material_" + std::to_string(materialIndex));
-    }
+    material->SetName(desc.name);
     
     // 设置着色器
     if (shader) {
         material->SetShader(shader);
     }
     
-    // 获取颜色属性
-    aiColor3D color(0.0f, 0.0f, 0.0f);
-    
-    // 环境光颜色
-    if (aiMat->Get(AI_MATKEY_COLOR_AMBIENT, color) == AI_SUCCESS) {
-        material->SetAmbientColor(Color(color.r, color.g, color.b, 1.0f));
+    if (desc.ambientColor) {
+        material->SetAmbientColor(*desc.ambientColor);
     }
-    
-    // 漫反射颜色
-    if (aiMat->Get(AI_MATKEY_COLOR_DIFFUSE, color) == AI_SUCCESS) {
-        material->SetDiffuseColor(Color(color.r, color.g, color.b, 1.0f));
+    if (desc.diffuseColor) {
+        material->SetDiffuseColor(*desc.diffuseColor);
     }
-    
-    // 镜面反射颜色
-    if (aiMat->Get(AI_MATKEY_COLOR_SPECULAR, color) == AI_SUCCESS) {
-        material->SetSpecularColor(Color(color.r, color.g, color.b, 1.0f));
+    if (desc.specularColor) {
+        material->SetSpecularColor(*desc.specularColor);
     }
-    
-    // 自发光颜色
-    if (aiMat->Get(AI_MATKEY_COLOR_EMISSIVE, color) == AI_SUCCESS) {
-        material->SetEmissiveColor(Color(color.r, color.g, color.b, 1.0f));
+    if (desc.emissiveColor) {
+        material->SetEmissiveColor(*desc.emissiveColor);
     }
-    
-    // 镜面反射强度（光泽度）
-    float shininess = 32.0f;
-    if (aiMat->Get(AI_MATKEY_SHININESS, shininess) == AI_SUCCESS) {
-        material->SetShininess(shininess);
+    if (desc.shininess) {
+        material->SetShininess(*desc.shininess);
     }
-    
-    // 不透明度
-    float opacity = 1.0f;
-    if (aiMat->Get(AI_MATKEY_OPACITY, opacity) == AI_SUCCESS) {
-        material->SetOpacity(opacity);
-        if (opacity < 1.0f) {
+    if (desc.opacity) {
+        material->SetOpacity(*desc.opacity);
+        if (*desc.opacity < 1.0f) {
             material->SetBlendMode(BlendMode::Alpha);
             material->SetDepthWrite(false);
         }
     }
-    
-    // PBR 属性（如果可用）
-    float metallic = 0.0f;
-    if (aiMat->Get(AI_MATKEY_METALLIC_FACTOR, metallic) == AI_SUCCESS) {
-        material->SetMetallic(metallic);
+    if (desc.metallic) {
+        material->SetMetallic(*desc.metallic);
     }
-    
-    float roughness = 0.5f;
-    if (aiMat->Get(AI_MATKEY_ROUGHNESS_FACTOR, roughness) == AI_SUCCESS) {
-        material->SetRoughness(roughness);
+    if (desc.roughness) {
+        material->SetRoughness(*desc.roughness);
     }
     
     // 加载纹理贴图
-    std::string matNameStr = material->GetName();
-    if (matNameStr.empty()) {
-        matNameStr = "Material_" + std::to_string(materialIndex);
-        material->SetName(matNameStr);
-    }
-    
-    // 漫反射贴图（使用纹理路径作为唯一标识，而不是材质名）
-    // 先获取纹理路径，用作缓存键
-    std::string diffuseTexName;
-    if (aiMat->GetTextureCount(aiTextureType_DIFFUSE) > 0) {
-        aiString texPath;
-        aiMat->GetTexture(aiTextureType_DIFFUSE, 0, &texPath);
-        std::string texPathStr(texPath.C_Str());
-        // 使用完整路径作为纹理标识
-        diffuseTexName = basePath + "/" + texPathStr;
-    }
-    
-    auto diffuseMap = LoadMaterialTexture(
-        aiMat,
-        aiTextureType_DIFFUSE,
-        basePath,
-        diffuseTexName.empty() ? (matNameStr + "_diffuse") : diffuseTexName,
-        "diffuseMap",
-        autoUpload,
-        pendingRequests);
-    if (diffuseMap) {
-        material->SetTexture("diffuseMap", diffuseMap);
-    }
-    
-    // 镜面反射贴图
-    auto specularMap = LoadMaterialTexture(
-        aiMat,
-        aiTextureType_SPECULAR,
-        basePath,
-        matNameStr + "_specular",
-        "specularMap",
-        autoUpload,
-        pendingRequests);
-    if (specularMap) {
-        material->SetTexture("specularMap", specularMap);
-    }
-    
-    // 法线贴图
-    auto normalMap = LoadMaterialTexture(
-        aiMat,
-        aiTextureType_NORMALS,
-        basePath,
-        matNameStr + "_normal",
-        "normalMap",
-        autoUpload,
-        pendingRequests);
-    if (!normalMap) {
-        // 有些格式使用 HEIGHT 代替 NORMALS
-        normalMap = LoadMaterialTexture(
-            aiMat,
-            aiTextureType_HEIGHT,
+    for (const auto& texture : desc.textures) {
+        std::string textureName;
+        if (texture.slotName == "diffuseMap") {
+            // 漫反射贴图使用完整路径作为唯一标识（缓存键），而不是材质名
+            textureName = basePath + "/" + texture.relativePath;
+        } else {
+            // 其他贴图：材质名 + 槽位后缀（specularMap -> _specular）
+            std::string suffix = texture.slotName;
+            if (suffix.size() > 3 && suffix.compare(suffix.size() - 3, 3, "Map") == 0) {
+                suffix.resize(suffix.size() - 3);
+            }
+            textureName = desc.name + "_" + suffix;
+        }
+
+        auto loaded = LoadMaterialTexture(
+            texture.relativePath,
             basePath,
-            matNameStr + "_normal",
-            "normalMap",
+            textureName,
+            texture.slotName,
             autoUpload,
             pendingRequests);
-    }
-    if (normalMap) {
-        material->SetTexture("normalMap", normalMap);
+        if (loaded) {
+            material->SetTexture(texture.slotName, loaded);
+        }
     }
     
-    // 环境遮蔽贴图
-    auto aoMap = LoadMaterialTexture(
-        aiMat,
-        aiTextureType_AMBIENT_OCCLUSION,
-        basePath,
-        matNameStr + "_ao",
-        "aoMap",
-        autoUpload,
-        pendingRequests);
-    if (aoMap) {
-        material->SetTexture("aoMap", aoMap);
-    }
+    Logger::GetInstance().Info("Processed material: " + material->GetName());
     
-    // 自发光贴图
-    auto emissiveMap = LoadMaterialTexture(
-        aiMat,
-        aiTextureType_EMISSIVE,
+    return material;
+}
+
+/**
+ * @brief 从 Assimp 材质创建 Material 对象
+ */
+static Ref<Material> ProcessAssimpMaterial(
+    aiMaterial* aiMat,
+    const std::string& basePath,
+    Ref<Shader> shader,
+    uint32_t materialIndex,
+    bool autoUpload,
+    std::vector<MaterialTextureRequest>* pendingRequests)
+{
+    return BuildMaterialFromDesc(
+        ExtractMaterialDesc(aiMat, materialIndex),
         basePath,
-        matNameStr + "_emissive",
-        "emissiveMap",
+        shader,
         autoUpload,
         pendingRequests);
-    if (emissiveMap) {
-        material->SetTexture("emissiveMap", emissiveMap);
-    }
-    
-    Logger::GetInstance().Info("Processed material: " + material->GetName());
-    
-    return material;
 }
 
 /**
- * @brief 递归处理节点（包含材质）
+ * @brief 处理节点及其子节点的所有网格（包含材质）
  */
 static void ProcessAssimpNodeWithMaterials(
     aiNode* node,
@@ -679,12 +718,16 @@ static void ProcessAssimpNodeWithMaterials(
     Ref<Shader> shader,
     std::vector<MeshWithMaterial>& results)
 {
-    // 处理当前节点的所有网格
-    for (uint32_t i = 0; i < node->mNumMeshes; i++) {
-        aiMesh* assimpMesh = scene->mMeshes[node->mMeshes[i]];
+    std::vector<AssimpMeshInstance> instances;
+    CollectAssimpMeshInstances(node, Matrix4::Identity(), instances);
+    auto meshes = ProcessAssimpMeshesParallel(instances, scene);
+    results.reserve(results.size() + instances.size());
+    
+    for (size_t i = 0; i < instances.size(); ++i) {
+        aiMesh* assimpMesh = scene->mMeshes[instances[i].node->mMeshes[instances[i].slot]];
         
-        // 处理网格（自动上传 - 假设在主线程调用）
-        auto mesh = ProcessAssimpMesh(assimpMesh, scene, true);
+        // 上传网格（假设在主线程调用）
+        meshes[i]->Upload();
         
         // 处理材质（如果有）
         Ref<Material> material = nullptr;
@@ -693,7 +736,6 @@ static void ProcessAssimpNodeWithMaterials(
             aiMaterial* aiMat = scene->mMaterials[assimpMesh->mMaterialIndex];
             material = ProcessAssimpMaterial(
                 aiMat,
-                scene,
                 basePath,
                 shader,
                 assimpMesh->mMaterialIndex,
@@ -704,20 +746,18 @@ static void ProcessAssimpNodeWithMaterials(
         // 获取网格名称
         std::string meshName = assimpMesh->mName.C_Str();
         if (meshName.empty()) {
-            meshName = "Mesh_" + std::to_string(i);
+            meshName = "Mesh_" + std::to_string(instances[i].slot);
         }
         
-        results.push_back(MeshWithMaterial(mesh, material, meshName));
-    }
-    
-    // 递归处理子节点
-    for (uint32_t i = 0; i < node->mNumChildren; i++) {
-        ProcessAssimpNodeWithMaterials(node->mChildren[i], scene, basePath, shader, results);
+        results.push_back(MeshWithMaterial(meshes[i], material, meshName));
     }
 }
 
 /**
- * @brief 递归处理节点并采集额外数据
+ * @brief 处理节点及其子节点的所有网格并采集额外数据
+ * @param materialDescs 非空时为每个结果记录材质描述（供二进制网格缓存保存，与 loadMaterials 无关）
+ * 
+ * 网格转换在工作线程并行执行；材质创建、上传与结果组装按原遍历顺序在当前线程完成
  */
 static void ProcessAssimpNodeDetailed(
     aiNode* node,
@@ -726,72 +766,101 @@ static void ProcessAssimpNodeDetailed(
     const std::string& basePath,
     Ref<Shader> shader,
     const Matrix4& parentTransform,
-    std::vector<MeshImportResult>& results)
+    std::vector<MeshImportResult>& results,
+    std::vector<MeshMaterialDesc>* materialDescs)
 {
-    Matrix4 localTransform = ConvertMatrix(node->mTransformation);
-    Matrix4 worldTransform = parentTransform * localTransform;
-
-    for (uint32_t i = 0; i < node->mNumMeshes; ++i) {
-        aiMesh* assimpMesh = scene->mMeshes[node->mMeshes[i]];
-
-        MeshExtraData extra;
-        extra.localTransform = localTransform;
-        extra.worldTransform = worldTransform;
-        extra.assimpMeshIndex = node->mMeshes[i];
+    std::vector<AssimpMeshInstance> instances;
+    CollectAssimpMeshInstances(node, parentTransform, instances);
+    
+    std::vector<MeshExtraData> extras(instances.size());
+    for (size_t i = 0; i < instances.size(); ++i) {
+        extras[i].localTransform = instances[i].localTransform;
+        extras[i].worldTransform = instances[i].worldTransform;
+        extras[i].assimpMeshIndex = instances[i].node->mMeshes[instances[i].slot];
+    }
+    auto meshes = ProcessAssimpMeshesParallel(instances, scene, &extras, &options);
+    
+    results.reserve(results.size() + instances.size());
+    if (materialDescs) {
+        materialDescs->reserve(materialDescs->size() + instances.size());
+    }
+    
+    for (size_t i = 0; i < instances.size(); ++i) {
+        aiMesh* assimpMesh = scene->mMeshes[extras[i].assimpMeshIndex];
+        MeshExtraData& extra = extras[i];
 
-        auto mesh = ProcessAssimpMesh(assimpMesh, scene, options.autoUpload, &extra, &options);
+        MeshMaterialDesc materialDesc;
+        if (assimpMesh->mMaterialIndex < scene->mNumMaterials &&
+            (options.loadMaterials || materialDescs)) {
+            materialDesc = ExtractMaterialDesc(
+                scene->mMaterials[assimpMesh->mMaterialIndex],
+                assimpMesh->mMaterialIndex
+            );
+        }
 
         Ref<Material> material = nullptr;
-        if (options.loadMaterials &&
-            assimpMesh->mMaterialIndex >= 0 &&
-            assimpMesh->mMaterialIndex < scene->mNumMaterials) {
-            material = ProcessAssimpMaterial(
-                scene->mMaterials[assimpMesh->mMaterialIndex],
-                scene,
+        if (options.loadMaterials && materialDesc.valid) {
+            material = BuildMaterialFromDesc(
+                materialDesc,
                 basePath,
                 shader,
-                assimpMesh->mMaterialIndex,
                 options.autoUpload,
                 &extra.pendingTextureRequests
             );
         }
+        if (materialDescs) {
+            materialDescs->push_back(std::move(materialDesc));
+        }
+        
+        if (options.autoUpload) {
+            meshes[i]->Upload();
+        }
 
         std::string meshName = assimpMesh->mName.C_Str();
         if (meshName.empty()) {
-            meshName = node->mName.C_Str();
+            meshName = instances[i].node->mName.C_Str();
         }
         if (meshName.empty()) {
             meshName = "Mesh_" + std::to_string(results.size());
         }
 
         MeshImportResult result;
-        result.mesh = mesh;
+        result.mesh = meshes[i];
         result.material = material;
         result.name = meshName;
         result.extra = std::move(extra);
         results.push_back(std::move(result));
     }
-
-    for (uint32_t i = 0; i < node->mNumChildren; ++i) {
-        ProcessAssimpNodeDetailed(
-            node->mChildren[i],
-            scene,
-            options,
-            basePath,
-            shader,
-            worldTransform,
-            results
-        );
-    }
 }
 
 // ============================================================================
 // MeshLoader - 文件加载实现
 // ============================================================================
 
-std::vector<Ref<Mesh>> MeshLoader::LoadFromFile(const std::string& filepath, bool flipUVs, bool autoUpload) {
+std::vector<Ref<Mesh>> MeshLoader::LoadFromFile(const std::string& filepath, bool flipUVs, bool autoUpload, bool useBinaryCache) {
     std::vector<Ref<Mesh>> meshes;
     
+    if (useBinaryCache) {
+        // 通过详细导入路径走缓存；选项与下方固定的后处理标志保持一致，且不采集额外数据
+        MeshImportOptions options;
+        options.flipUVs = flipUVs;
+        options.autoUpload = autoUpload;
+        options.useBinaryCache = true;
+        options.findInvalidData = false;
+        options.populateArmatureData = false;
+        options.gatherAdditionalUVs = false;
+        options.gatherVertexColors = false;
+        options.gatherBones = false;
+        options.limitBoneWeightsPerVertex = false;
+        
+        auto results = LoadDetailedFromFile(filepath, options);
+        meshes.reserve(results.size());
+        for (auto& result : results) {
+            meshes.push_back(std::move(result.mesh));
+        }
+        return meshes;
+    }
+    
     Logger::GetInstance().Info("Loading model from file: " + filepath + 
                                (autoUpload ? " (自动上传)" : " (延迟上传)"));
     
@@ -925,6 +994,39 @@ std::vector<MeshImportResult> MeshLoader::LoadDetailedFromFile(
 
     Logger::GetInstance().Info("Loading detailed model from file: " + filepath);
 
+    std::string actualBasePath = ResolveBasePath(filepath, basePath);
+
+    // 二进制网格缓存：命中时跳过 Assimp 导入，只需重建材质与上传
+    uint64_t cacheKey = 0;
+    if (options.useBinaryCache && MeshCache::GetInstance().IsEnabled()) {
+        const uint64_t sourceHash = FileUtils::HashFile(filepath);
+        if (sourceHash != 0) {
+            cacheKey = MeshCache::BuildKey(sourceHash, options);
+        }
+    }
+    std::vector<MeshMaterialDesc> materialDescs;
+    if (cacheKey != 0 && MeshCache::GetInstance().Load(cacheKey, results, materialDescs)) {
+        for (size_t i = 0; i < results.size(); ++i) {
+            MeshImportResult& result = results[i];
+            if (options.loadMaterials && materialDescs[i].valid) {
+                result.material = BuildMaterialFromDesc(
+                    materialDescs[i],
+                    actualBasePath,
+                    shader,
+                    options.autoUpload,
+                    &result.extra.pendingTextureRequests
+                );
+            }
+            // 数据源已由 MeshCache::Load 设置，释放的 CPU 数据可从缓存文件重新读取
+            result.mesh->SetCPUResidency(options.cpuResidency);
+            if (options.autoUpload) {
+                result.mesh->Upload();
+            }
+        }
+        Logger::GetInstance().Info("Detailed model loaded from mesh cache. Total meshes: " + std::to_string(results.size()));
+        return results;
+    }
+
     Assimp::Importer importer;
     if (options.limitBoneWeightsPerVertex && options.maxBoneWeightsPerVertex > 0) {
         importer.SetPropertyInteger(
@@ -944,7 +1046,6 @@ std::vector<MeshImportResult> MeshLoader::LoadDetailedFromFile(
         return results;
     }
 
-    std::string actualBasePath = ResolveBasePath(filepath, basePath);
     Matrix4 identity = Matrix4::Identity();
 
     ProcessAssimpNodeDetailed(
@@ -954,9 +1055,20 @@ std::vector<MeshImportResult> MeshLoader::LoadDetailedFromFile(
         actualBasePath,
         shader,
         identity,
-        results
+        results,
+        cacheKey != 0 ? &materialDescs : nullptr
     );
 
+    const bool cached = cacheKey != 0 && MeshCache::GetInstance().Store(cacheKey, results, materialDescs);
+    
+    // 驻留策略在写入缓存之后才应用（autoUpload 时网格已上传，会立即释放 CPU 数据）
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (cached) {
+            results[i].mesh->SetCPUDataSource(MeshCache::MakeCPUDataSource(cacheKey, static_cast<uint32_t>(i)));
+        }
+        results[i].mesh->SetCPUResidency(options.cpuResidency);
+    }
+
     Logger::GetInstance().Info("Detailed model loading complete. Total meshes: " + std::to_string(results.size()));
 
     return results;
@@ -996,8 +1108,24 @@ uint32_t SanitizeSegments(const char* name, uint32_t value, uint32_t minValue, u
     return clamped;
 }
 
+std::atomic<bool> g_optimizeGeneratedMeshes{true};
+
+void OptimizeGeneratedMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    if (g_optimizeGeneratedMeshes.load(std::memory_order_relaxed)) {
+        MeshOptimizer::Optimize(vertices, indices);
+    }
+}
+
 } // namespace
 
+void MeshLoader::SetOptimizeGeneratedMeshes(bool enabled) {
+    g_optimizeGeneratedMeshes.store(enabled, std::memory_order_relaxed);
+}
+
+bool MeshLoader::IsOptimizeGeneratedMeshesEnabled() {
+    return g_optimizeGeneratedMeshes.load(std::memory_order_relaxed);
+}
+
 Ref<Mesh> MeshLoader::CreatePlane(float width, float height, 
                                    uint32_t widthSegments, uint32_t heightSegments,
                                    const Color& color) {
@@ -1052,6 +1180,7 @@ Ref<Mesh> MeshLoader::CreatePlane(float width, float height,
         }
     }
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -1126,6 +1255,7 @@ Ref<Mesh> MeshLoader::CreateCube(float width, float height, float depth, const C
         indices.push_back(base + 3);
     }
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -1186,6 +1316,7 @@ Ref<Mesh> MeshLoader::CreateSphere(float radius, uint32_t segments, uint32_t rin
         }
     }
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -1307,6 +1438,7 @@ Ref<Mesh> MeshLoader::CreateCylinder(float radiusTop, float radiusBottom, float
         indices.push_back(bottomCapStart + 1 + i + 1);
     }
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -1384,6 +1516,7 @@ Ref<Mesh> MeshLoader::CreateTorus(float majorRadius, float minorRadius,
         }
     }
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -1534,6 +1667,7 @@ Ref<Mesh> MeshLoader::CreateCapsule(float radius, float height, uint32_t segment
         }
     }
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -1558,6 +1692,7 @@ Ref<Mesh> MeshLoader::CreateQuad(float width, float height, const Color& color)
     // 两个三角形
     indices = { 0, 1, 2, 0, 2, 3 };
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -1581,6 +1716,7 @@ Ref<Mesh> MeshLoader::CreateTriangle(float size, const Color& color) {
     
     indices = { 0, 1, 2 };
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -1622,6 +1758,7 @@ Ref<Mesh> MeshLoader::CreateCircle(float radius, uint32_t segments, const Color&
         indices.push_back(i + 2);
     }
     
+    OptimizeGeneratedMesh(vertices, indices);
     auto mesh = CreateRef<Mesh>(vertices, indices);
     mesh->RecalculateTangents();
     mesh->Upload();
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/mesh_optimizer.h"
+#include "render/logger.h"
+#include "../../third_party/meshoptimizer/src/meshoptimizer.h"
+
+namespace Render {
+
+namespace {
+
+bool ValidateIndices(size_t vertexCount, const std::vector<uint32_t>& indices) {
+    if (vertexCount == 0 || indices.size() < 3 || indices.size() % 3 != 0) {
+        return false;
+    }
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// 统计只依赖索引与顶点数（顶点获取按 Vertex 大小计算）
+MeshOptimizeStats AnalyzeIndices(const std::vector<uint32_t>& indices, size_t vertexCount) {
+    MeshOptimizeStats stats;
+    if (!ValidateIndices(vertexCount, indices)) {
+        return stats;
+    }
+    
+    const meshopt_VertexCacheStatistics cache = meshopt_analyzeVertexCache(
+        indices.data(), indices.size(), vertexCount, MeshOptimizer::kAnalyzeCacheSize, 0, 0);
+    const meshopt_VertexFetchStatistics fetch = meshopt_analyzeVertexFetch(
+        indices.data(), indices.size(), vertexCount, sizeof(Vertex));
+    stats.acmr = cache.acmr;
+    stats.atvr = cache.atvr;
+    stats.overfetch = fetch.overfetch;
+    return stats;
+}
+
+} // anonymous namespace
+
+bool MeshOptimizer::Optimize(std::vector<Vertex>& vertices,
+                             std::vector<uint32_t>& indices,
+                             const MeshOptimizeOptions& options,
+                             std::vector<uint32_t>* vertexRemap) {
+    if (vertexRemap) {
+        vertexRemap->clear();
+    }
+    if (!ValidateIndices(vertices.size(), indices)) {
+        LOG_WARNING_F("MeshOptimizer: Invalid input skipped (%zu vertices, %zu indices)", vertices.size(), indices.size());
+        return false;
+    }
+    
+    const size_t indexCount = indices.size();
+    const size_t vertexCount = vertices.size();
+    
+    if (options.vertexCache) {
+        meshopt_optimizeVertexCache(indices.data(), indices.data(), indexCount, vertexCount);
+    }
+    
+    // overdraw 优化以缓存优化的结果为基础，只在 ACMR 不超过阈值的前提下调整三角形簇顺序
+    if (options.overdraw) {
+        meshopt_optimizeOverdraw(indices.data(), indices.data(), indexCount,
+                                 vertices[0].position.data(), vertexCount, sizeof(Vertex),
+                                 options.overdrawThreshold);
+    }
+    
+    if (options.vertexFetch) {
+        std::vector<uint32_t> remap(vertexCount);
+        const size_t uniqueCount = meshopt_optimizeVertexFetchRemap(remap.data(), indices.data(), indexCount, vertexCount);
+        meshopt_remapIndexBuffer(indices.data(), indices.data(), indexCount, remap.data());
+        RemapVertexAttribute(vertices, remap, uniqueCount);
+        if (vertexRemap) {
+            *vertexRemap = std::move(remap);
+        }
+    }
+    
+    return true;
+}
+
+MeshOptimizeStats MeshOptimizer::Analyze(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    return AnalyzeIndices(indices, vertices.size());
+}
+
+MeshOptimizeStats MeshOptimizer::Analyze(const Mesh& mesh) {
+    // Access* 共用同一把互斥锁，不能嵌套调用；统计只需要索引副本与顶点数
+    std::vector<uint32_t> indices;
+    mesh.AccessIndices([&](const std::vector<uint32_t>& source) {
+        indices = source;
+    });
+    return AnalyzeIndices(indices, mesh.GetVertexCount());
+}
+
+} // namespace Render
+
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/meshlet.h"
+#include "render/camera.h"
+#include "render/logger.h"
+#include "render/task_scheduler.h"
+#include "../../third_party/meshoptimizer/src/meshoptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace Render {
+
+namespace {
+
+constexpr size_t kMaxMeshletVertices = 255;
+constexpr size_t kMaxMeshletTriangles = 512;
+constexpr size_t kCullBatchChunkSize = 64;  // 每个任务处理的对象数
+
+/**
+ * @brief 把一个 meshlet 的三角形展开为网格顶点索引
+ * @return 写入位置之后的指针
+ */
+uint32_t* EmitMeshlet(const MeshletData& data, const Meshlet& meshlet, uint32_t* out) {
+    const uint32_t* vertices = data.vertices.data() + meshlet.vertexOffset;
+    const uint8_t* triangles = data.triangles.data() + meshlet.triangleOffset;
+    const size_t indexCount = static_cast<size_t>(meshlet.triangleCount) * 3;
+    for (size_t i = 0; i < indexCount; ++i) {
+        out[i] = vertices[triangles[i]];
+    }
+    return out + indexCount;
+}
+
+} // anonymous namespace
+
+// ==================== MeshletBuilder ====================
+
+Ref<MeshletData> MeshletBuilder::Build(const std::vector<Vertex>& vertices,
+                                       const std::vector<uint32_t>& indices,
+                                       const MeshletBuildOptions& options) {
+    if (vertices.empty() || indices.size() < 3 || indices.size() % 3 != 0) {
+        LOG_WARNING_F("MeshletBuilder: Invalid input (%zu vertices, %zu indices)", vertices.size(), indices.size());
+        return nullptr;
+    }
+    
+    const size_t maxVertices = std::clamp<size_t>(options.maxVertices, 3, kMaxMeshletVertices);
+    // meshoptimizer 要求三角形上限为 4 的倍数
+    const size_t maxTriangles = std::clamp<size_t>(options.maxTriangles & ~size_t(3), 4, kMaxMeshletTriangles);
+    const float coneWeight = std::clamp(options.coneWeight, 0.0f, 1.0f);
+    
+    // 提取紧凑的位置数组（Vertex 含 18 个 float，直接传 stride 也可，但紧凑数组对缓存更友好）
+    std::vector<float> positions(vertices.size() * 3);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        positions[i * 3 + 0] = vertices[i].position.x();
+        positions[i * 3 + 1] = vertices[i].position.y();
+        positions[i * 3 + 2] = vertices[i].position.z();
+    }
+    
+    const size_t maxMeshlets = meshopt_buildMeshletsBound(indices.size(), maxVertices, maxTriangles);
+    std::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+    auto data = CreateRef<MeshletData>();
+    data->vertices.resize(maxMeshlets * maxVertices);
+    data->triangles.resize(maxMeshlets * maxTriangles * 3);
+    
+    const size_t meshletCount = meshopt_buildMeshlets(
+        meshlets.data(), data->vertices.data(), data->triangles.data(),
+        indices.data(), indices.size(),
+        positions.data(), vertices.size(), sizeof(float) * 3,
+        maxVertices, maxTriangles, coneWeight);
+    if (meshletCount == 0) {
+        LOG_WARNING("MeshletBuilder: meshopt_buildMeshlets produced no meshlets");
+        return nullptr;
+    }
+    
+    const meshopt_Meshlet& last = meshlets[meshletCount - 1];
+    data->vertices.resize(last.vertex_offset + last.vertex_count);
+    data->triangles.resize(last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3u));
+    data->triangleCount = indices.size() / 3;
+    
+    data->meshlets.resize(meshletCount);
+    data->bounds.resize(meshletCount);
+    data->indexOffsets.resize(meshletCount);
+    uint32_t indexOffset = 0;
+    for (size_t i = 0; i < meshletCount; ++i) {
+        const meshopt_Meshlet& source = meshlets[i];
+        if (options.optimize) {
+            meshopt_optimizeMeshlet(&data->vertices[source.vertex_offset], &data->triangles[source.triangle_offset],
+                                    source.triangle_count, source.vertex_count);
+        }
+        
+        Meshlet& meshlet = data->meshlets[i];
+        meshlet.vertexOffset = source.vertex_offset;
+        meshlet.triangleOffset = source.triangle_offset;
+        meshlet.vertexCount = source.vertex_count;
+        meshlet.triangleCount = source.triangle_count;
+        data->indexOffsets[i] = indexOffset;
+        indexOffset += source.triangle_count * 3;
+        
+        const meshopt_Bounds bounds = meshopt_computeMeshletBounds(
+            &data->vertices[source.vertex_offset], &data->triangles[source.triangle_offset],
+            source.triangle_count, positions.data(), vertices.size(), sizeof(float) * 3);
+        MeshletBounds& out = data->bounds[i];
+        out.center = Vector3(bounds.center[0], bounds.center[1], bounds.center[2]);
+        out.radius = bounds.radius;
+        out.coneApex = Vector3(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]);
+        out.coneAxis = Vector3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+        out.coneCutoff = bounds.cone_cutoff;
+    }
+    
+    return data;
+}
+
+bool MeshletBuilder::BuildForMesh(const Ref<Mesh>& mesh, const MeshletBuildOptions& options) {
+    if (!mesh) {
+        return false;
+    }
+    
+    // 两个访问器使用同一把（非递归）锁，不能嵌套：先复制较小的索引数组
+    std::vector<uint32_t> indices;
+    mesh->AccessIndices([&](const std::vector<uint32_t>& source) { indices = source; });
+    Ref<MeshletData> data;
+    mesh->AccessVertices([&](const std::vector<Vertex>& vertices) {
+        data = Build(vertices, indices, options);
+    });
+    if (!data) {
+        return false;
+    }
+    
+    LOG_INFO_F("MeshletBuilder: Built %zu meshlets for %zu triangles (%.1f KB)",
+               data->GetMeshletCount(), data->triangleCount, data->GetMemoryUsage() / 1024.0);
+    mesh->SetMeshlets(std::move(data));
+    return true;
+}
+
+// ==================== MeshletCuller ====================
+
+size_t MeshletCuller::ClassifyMeshlets(const MeshletData& data, const Matrix4& model, const Frustum& frustum,
+                                       const Vector3& cameraPosition, std::vector<uint32_t>& outVisible,
+                                       MeshletCullStats& stats) {
+    const Matrix3 linear = model.block<3, 3>(0, 0);
+    const Matrix3 normalMatrix = linear.inverse().transpose();
+    const Vector3 translation = model.block<3, 1>(0, 3);
+    const float maxScale = std::max({linear.col(0).norm(), linear.col(1).norm(), linear.col(2).norm()});
+    
+    stats.objectsTested++;
+    stats.trianglesTotal += data.triangleCount;
+    size_t indexCount = 0;
+    
+    for (size_t i = 0; i < data.meshlets.size(); ++i) {
+        const MeshletBounds& bounds = data.bounds[i];
+        stats.meshletsTested++;
+        
+        const Vector3 center = linear * bounds.center + translation;
+        if (!frustum.IntersectsSphere(center, bounds.radius * maxScale)) {
+            stats.meshletsFrustumCulled++;
+            continue;
+        }
+        
+        if (bounds.coneCutoff < 1.0f) {
+            const Vector3 apex = linear * bounds.coneApex + translation;
+            const Vector3 axis = (normalMatrix * bounds.coneAxis).normalized();
+            const Vector3 toApex = apex - cameraPosition;
+            const float distance = toApex.norm();
+            if (distance > 0.0f && toApex.dot(axis) >= bounds.coneCutoff * distance) {
+                stats.meshletsBackfaceCulled++;
+                continue;
+            }
+        }
+        
+        outVisible.push_back(static_cast<uint32_t>(i));
+        stats.trianglesSubmitted += data.meshlets[i].triangleCount;
+        indexCount += static_cast<size_t>(data.meshlets[i].triangleCount) * 3;
+    }
+    return indexCount;
+}
+
+size_t MeshletCuller::Cull(const MeshletData& data, const Matrix4& model, const Frustum& frustum,
+                           const Vector3& cameraPosition, std::vector<uint32_t>& outIndices,
+                           MeshletCullStats* stats) {
+    thread_local std::vector<uint32_t> visible;
+    visible.clear();
+    MeshletCullStats local;
+    const size_t indexCount = ClassifyMeshlets(data, model, frustum, cameraPosition, visible, local);
+    
+    const size_t base = outIndices.size();
+    outIndices.resize(base + indexCount);
+    uint32_t* out = outIndices.data() + base;
+    for (uint32_t meshletIndex : visible) {
+        out = EmitMeshlet(data, data.meshlets[meshletIndex], out);
+    }
+    
+    if (stats) {
+        stats->Accumulate(local);
+    }
+    return indexCount;
+}
+
+size_t MeshletCuller::CullRanges(const MeshletData& data, const Matrix4& model, const Frustum& frustum,
+                                 const Vector3& cameraPosition, std::vector<MeshletDrawRange>& outRanges,
+                                 MeshletCullStats* stats) {
+    outRanges.clear();
+    if (data.indexOffsets.size() != data.meshlets.size()) {
+        return 0;
+    }
+    
+    thread_local std::vector<uint32_t> visible;
+    visible.clear();
+    MeshletCullStats local;
+    const size_t indexCount = ClassifyMeshlets(data, model, frustum, cameraPosition, visible, local);
+    
+    // 可见 meshlet 按下标递增输出，排序缓冲区中相邻的簇合并为一次绘制
+    for (uint32_t meshletIndex : visible) {
+        const uint32_t offset = data.indexOffsets[meshletIndex];
+        const uint32_t count = data.meshlets[meshletIndex].triangleCount * 3;
+        if (!outRanges.empty() && outRanges.back().indexOffset + outRanges.back().indexCount == offset) {
+            outRanges.back().indexCount += count;
+        } else {
+            outRanges.push_back(MeshletDrawRange{offset, count});
+        }
+    }
+    
+    if (stats) {
+        stats->Accumulate(local);
+    }
+    return indexCount;
+}
+
+void MeshletCuller::CullBatch(const std::vector<Object>& objects, const Frustum& frustum,
+                              const Vector3& cameraPosition, std::vector<uint32_t>& outIndices,
+                              std::vector<ObjectRange>& outRanges, MeshletCullStats* stats) {
+    outRanges.assign(objects.size(), ObjectRange{});
+    if (objects.empty()) {
+        outIndices.clear();
+        return;
+    }
+    
+    const size_t chunkCount = (objects.size() + kCullBatchChunkSize - 1) / kCullBatchChunkSize;
+    std::vector<std::vector<uint32_t>> chunkVisible(chunkCount);   // 每块可见 meshlet 下标（按对象顺序）
+    std::vector<uint32_t> objectVisibleCount(objects.size(), 0);
+    std::vector<MeshletCullStats> chunkStats(chunkCount);
+    
+    auto& scheduler = TaskScheduler::GetInstance();
+    const bool parallel = chunkCount > 1 && scheduler.IsInitialized() && scheduler.GetWorkerCount() > 1;
+    auto forEachChunk = [&](const std::function<void(size_t)>& body) {
+        if (!parallel) {
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                body(chunk);
+            }
+            return;
+        }
+        std::vector<std::shared_ptr<TaskHandle>> handles;
+        handles.reserve(chunkCount);
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            handles.push_back(scheduler.SubmitLambda([&body, chunk]() { body(chunk); },
+                                                     TaskPriority::High, "MeshletCull"));
+        }
+        scheduler.WaitForAll(handles);
+    };
+    
+    // 第一遍：测试 meshlet，记录可见列表与每个对象的索引数
+    forEachChunk([&](size_t chunk) {
+        const size_t begin = chunk * kCullBatchChunkSize;
+        const size_t end = std::min(begin + kCullBatchChunkSize, objects.size());
+        for (size_t i = begin; i < end; ++i) {
+            if (!objects[i].meshlets) {
+                continue;
+            }
+            const size_t visibleBefore = chunkVisible[chunk].size();
+            outRanges[i].indexCount = static_cast<uint32_t>(ClassifyMeshlets(
+                *objects[i].meshlets, objects[i].model, frustum, cameraPosition,
+                chunkVisible[chunk], chunkStats[chunk]));
+            objectVisibleCount[i] = static_cast<uint32_t>(chunkVisible[chunk].size() - visibleBefore);
+        }
+    });
+    
+    // 前缀和确定每个对象在输出中的位置
+    size_t totalIndices = 0;
+    for (auto& range : outRanges) {
+        range.indexOffset = static_cast<uint32_t>(totalIndices);
+        totalIndices += range.indexCount;
+    }
+    outIndices.resize(totalIndices);
+    
+    // 第二遍：各块直接写入最终位置，无需合并拷贝
+    forEachChunk([&](size_t chunk) {
+        const size_t begin = chunk * kCullBatchChunkSize;
+        const size_t end = std::min(begin + kCullBatchChunkSize, objects.size());
+        const uint32_t* visible = chunkVisible[chunk].data();
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t* out = outIndices.data() + outRanges[i].indexOffset;
+            for (uint32_t v = 0; v < objectVisibleCount[i]; ++v) {
+                out = EmitMeshlet(*objects[i].meshlets, objects[i].meshlets->meshlets[*visible++], out);
+            }
+        }
+    });
+    
+    if (stats) {
+        for (const auto& chunkStat : chunkStats) {
+            stats->Accumulate(chunkStat);
+        }
+    }
+}
+
+} // namespace Render
@@ -131,6 +131,8 @@ ModelLoadOutput ModelLoader::BuildModel(const std::string& filepath,
     importOptions.flipUVs = options.flipUVs;
     importOptions.autoUpload = options.autoUpload;
     importOptions.loadMaterials = true;
+    importOptions.useBinaryCache = options.useBinaryCache;
+    importOptions.cpuResidency = options.cpuResidency;
 
     auto importResults = MeshLoader::LoadDetailedFromFile(
         filepath,
@@ -27,6 +27,7 @@
 #include "render/renderable.h"
 #include "render/sprite/sprite_batcher.h"
 #include "render/shader.h"
+#include "render/pipeline_state.h"
 #include "render/gl_thread_checker.h"
 #include "render/gpu_buffer_pool.h"
 #include <glad/glad.h>
@@ -459,6 +460,7 @@ void RenderBatch::Reset() {
     m_keyInitialized = false;
     m_cpuVertices.clear();
     m_cpuIndices.clear();
+    m_directDrawItems.clear();
     m_indexCount = 0;
     m_drawVertexCount = 0;
     m_cachedTriangleCount = 0;
@@ -665,6 +667,7 @@ void RenderBatch::UploadResources(ResourceManager* resourceManager, BatchingMode
 
     m_cpuVertices.clear();
     m_cpuIndices.clear();
+    m_directDrawItems.clear();
     m_indexCount = 0;
     m_cachedTriangleCount = 0;
     m_gpuResourcesReady = false;
@@ -730,6 +733,18 @@ void RenderBatch::UploadResources(ResourceManager* resourceManager, BatchingMode
             Logger::GetInstance().Warning("[RenderBatch] CPU Merge: Skipping mesh with no indices");
             continue;
         }
+
+        // CPU 数据已按驻留策略释放的网格每次合并都要回读磁盘，改为在批次内直接绘制其 GPU 缓冲
+        if (mesh->GetCPUResidency() != MeshCPUResidency::Keep) {
+            if (!IsMatrixValid(item.meshData.modelMatrix)) {
+                Logger::GetInstance().Warning(
+                    "[RenderBatch] Invalid model matrix detected (contains NaN/Inf), skipping item");
+                buildFailed = true;
+                break;
+            }
+            m_directDrawItems.push_back(static_cast<size_t>(&item - m_items.data()));
+            continue;
+        }
         
         const size_t vertexCount = mesh->GetVertexCount();
         if (vertexCount == 0) {
@@ -898,6 +913,16 @@ void RenderBatch::UploadResources(ResourceManager* resourceManager, BatchingMode
         }
     }
 
+    if (!buildFailed && m_cpuVertices.empty() && m_cpuIndices.empty() && !m_directDrawItems.empty()) {
+        // 批次内全部为直接绘制项，无需合并网格
+        ReleaseGpuResources();
+        for (size_t index : m_directDrawItems) {
+            m_cachedTriangleCount += static_cast<uint32_t>(m_items[index].meshData.mesh->GetIndexCount() / 3);
+        }
+        m_gpuResourcesReady = true;
+        return;
+    }
+
     // 最终验证（参考 Transform 的错误处理）
     if (buildFailed || m_cpuVertices.empty() || m_cpuIndices.empty()) {
         Logger::GetInstance().Warning(
@@ -926,6 +951,9 @@ void RenderBatch::UploadResources(ResourceManager* resourceManager, BatchingMode
     m_indexCount = static_cast<uint32_t>(m_cpuIndices.size());
     m_cachedTriangleCount = m_indexCount / 3;
     m_drawVertexCount = static_cast<uint32_t>(m_cpuVertices.size());
+    for (size_t index : m_directDrawItems) {
+        m_cachedTriangleCount += static_cast<uint32_t>(m_items[index].meshData.mesh->GetIndexCount() / 3);
+    }
 
     // 创建并上传 Mesh（带异常保护）
     try {
@@ -979,8 +1007,10 @@ void RenderBatch::UploadResources(ResourceManager* resourceManager, BatchingMode
         m_gpuResourcesReady = true;
         
         Logger::GetInstance().InfoFormat(
-            "[RenderBatch] CPU Merge: Successfully created batch (V:%u, I:%u, T:%u)",
-            m_drawVertexCount, m_indexCount, m_cachedTriangleCount);
+            "[RenderBatch] CPU Merge: Successfully created batch (V:%u, I:%u %s, T:%u)",
+            m_drawVertexCount, m_indexCount,
+            mergedMesh->GetIndexFormat() == IndexFormat::UInt16 ? "u16" : "u32",
+            m_cachedTriangleCount);
             
     } catch (const std::exception& e) {
         Logger::GetInstance().ErrorFormat(
@@ -1042,10 +1072,14 @@ bool RenderBatch::Draw(RenderState* renderState, uint32_t& drawCallCounter, Batc
 
         // 设置渲染状态（带验证）
         try {
-            renderState->SetBlendMode(firstItem.key.blendMode);
-            renderState->SetDepthTest(firstItem.key.depthTest);
-            renderState->SetDepthWrite(firstItem.key.depthWrite);
-            renderState->SetCullFace(firstItem.key.cullFace);
+            PipelineStateDesc pipelineDesc;
+            pipelineDesc.fields = PipelineStateFields_Blend | PipelineStateFields_DepthTest |
+                                  PipelineStateFields_DepthWrite | PipelineStateFields_CullFace;
+            pipelineDesc.blendMode = firstItem.key.blendMode;
+            pipelineDesc.depthTest = firstItem.key.depthTest;
+            pipelineDesc.depthWrite = firstItem.key.depthWrite;
+            pipelineDesc.cullFace = firstItem.key.cullFace;
+            renderState->ApplyPipelineState(PipelineStateRegistry::GetInstance().Acquire(pipelineDesc));
         } catch (const std::exception& e) {
             Logger::GetInstance().ErrorFormat(
                 "[RenderBatch] Draw Text: Failed to set render state: %s", 
@@ -1227,6 +1261,7 @@ bool RenderBatch::Draw(RenderState* renderState, uint32_t& drawCallCounter, Batc
                     if (uniformMgr->HasUniform("uHasInstanceData")) {
                         uniformMgr->SetBool("uHasInstanceData", true);
                     }
+                    m_sourceMesh->ApplyVertexLayoutUniforms(uniformMgr);
                 } catch (const std::exception& e) {
                     Logger::GetInstance().ErrorFormat(
                         "[RenderBatch] Draw Instanced: Failed to set uniforms: %s", 
@@ -1303,21 +1338,48 @@ bool RenderBatch::Draw(RenderState* renderState, uint32_t& drawCallCounter, Batc
 
     // 设置 uniforms
     auto shader = material->GetShader();
-    if (shader) {
-        auto* uniformMgr = shader->GetUniformManager();
-        if (uniformMgr) {
+    UniformManager* uniformMgr = shader ? shader->GetUniformManager() : nullptr;
+    if (uniformMgr) {
+        try {
+            const Matrix4 identity = Matrix4::Identity();
+            uniformMgr->SetMatrix4("uModel", identity);
+            if (uniformMgr->HasUniform("uHasInstanceData")) {
+                uniformMgr->SetBool("uHasInstanceData", false);
+            }
+        } catch (const std::exception& e) {
+            Logger::GetInstance().ErrorFormat(
+                "[RenderBatch] Draw Merged: Failed to set uniforms: %s", 
+                e.what());
+        }
+    }
+
+    // 未参与合并的网格（CPU 数据未常驻）沿用同一材质，逐个设置 uModel 后直接绘制
+    const auto drawDirectItems = [&]() {
+        bool anyDrawn = false;
+        for (size_t index : m_directDrawItems) {
+            const auto& item = m_items[index];
+            if (!item.meshData.mesh || (item.renderable && !item.renderable->IsVisible())) {
+                continue;
+            }
             try {
-                const Matrix4 identity = Matrix4::Identity();
-                uniformMgr->SetMatrix4("uModel", identity);
-                if (uniformMgr->HasUniform("uHasInstanceData")) {
-                    uniformMgr->SetBool("uHasInstanceData", false);
+                if (uniformMgr) {
+                    uniformMgr->SetMatrix4("uModel", item.meshData.modelMatrix);
+                    item.meshData.mesh->ApplyVertexLayoutUniforms(uniformMgr);
                 }
+                item.meshData.mesh->Draw();
+                ++drawCallCounter;
+                anyDrawn = true;
             } catch (const std::exception& e) {
                 Logger::GetInstance().ErrorFormat(
-                    "[RenderBatch] Draw Merged: Failed to set uniforms: %s", 
+                    "[RenderBatch] Draw Merged: Exception during direct draw: %s", 
                     e.what());
             }
         }
+        return anyDrawn;
+    };
+
+    if (!m_batchMesh && !m_meshHandle.IsValid() && !m_directDrawItems.empty()) {
+        return drawDirectItems();
     }
 
     // 获取要绘制的 mesh（带验证）
@@ -1340,6 +1402,9 @@ bool RenderBatch::Draw(RenderState* renderState, uint32_t& drawCallCounter, Batc
         drawFallback();
         return false;
     }
+    if (uniformMgr) {
+        meshToDraw->ApplyVertexLayoutUniforms(uniformMgr);
+    }
     
     // 验证 mesh 有效性
     if (meshToDraw->GetVertexArrayID() == 0) {
@@ -1353,7 +1418,6 @@ bool RenderBatch::Draw(RenderState* renderState, uint32_t& drawCallCounter, Batc
     try {
         meshToDraw->Draw();
         ++drawCallCounter;
-        return true;
     } catch (const std::exception& e) {
         Logger::GetInstance().ErrorFormat(
             "[RenderBatch] Draw Merged: Exception during draw: %s", 
@@ -1361,6 +1425,9 @@ bool RenderBatch::Draw(RenderState* renderState, uint32_t& drawCallCounter, Batc
         drawFallback();
         return false;
     }
+
+    drawDirectItems();
+    return true;
 }
 
 BatchManager::BatchManager()
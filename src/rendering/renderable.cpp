@@ -444,7 +444,8 @@ MeshRenderable::MeshRenderable(MeshRenderable&& other) noexcept
       m_material(std::move(other.m_material)),
       m_materialOverride(std::move(other.m_materialOverride)),
       m_castShadows(other.m_castShadows),
-      m_receiveShadows(other.m_receiveShadows) {
+      m_receiveShadows(other.m_receiveShadows),
+      m_meshletRanges(std::move(other.m_meshletRanges)) {
 }
 
 MeshRenderable& MeshRenderable::operator=(MeshRenderable&& other) noexcept {
@@ -455,6 +456,7 @@ MeshRenderable& MeshRenderable::operator=(MeshRenderable&& other) noexcept {
         m_materialOverride = std::move(other.m_materialOverride);
         m_castShadows = other.m_castShadows;
         m_receiveShadows = other.m_receiveShadows;
+        m_meshletRanges = std::move(other.m_meshletRanges);
     }
     return *this;
 }
@@ -504,6 +506,7 @@ void MeshRenderable::Render(RenderState* renderState) {
             if (uniformMgr->HasUniform("uHasInstanceData")) {
                 uniformMgr->SetBool("uHasInstanceData", false);
             }
+            m_mesh->ApplyVertexLayoutUniforms(uniformMgr);
             
             // ✅ 设置视图和投影矩阵（如果着色器需要但尚未设置）
             // 优先从RenderState获取（由相机系统设置），如果没有则使用默认Camera生成
@@ -596,8 +599,12 @@ void MeshRenderable::Render(RenderState* renderState) {
         }
     }
     
-    // 绘制网格
-    m_mesh->Draw();
+    // 绘制网格（meshlet 剔除后只提交可见区间）
+    if (!m_meshletRanges.empty()) {
+        m_mesh->DrawMeshletRanges(m_meshletRanges);
+    } else {
+        m_mesh->Draw();
+    }
 }
 
 void MeshRenderable::SubmitToRenderer(Renderer* renderer) {
@@ -674,6 +681,21 @@ bool MeshRenderable::GetReceiveShadows() const {
     return m_receiveShadows;
 }
 
+void MeshRenderable::SetMeshletRanges(const std::vector<MeshletDrawRange>& ranges) {
+    std::unique_lock lock(m_mutex);
+    m_meshletRanges.assign(ranges.begin(), ranges.end());
+}
+
+void MeshRenderable::ClearMeshletRanges() {
+    std::unique_lock lock(m_mutex);
+    m_meshletRanges.clear();
+}
+
+bool MeshRenderable::HasMeshletRanges() const {
+    std::shared_lock lock(m_mutex);
+    return !m_meshletRanges.empty();
+}
+
 AABB MeshRenderable::GetBoundingBox() const {
     std::shared_lock lock(m_mutex);
     
@@ -681,31 +703,11 @@ AABB MeshRenderable::GetBoundingBox() const {
         return AABB();
     }
     
-    // 使用 AccessVertices 回调方式计算包围盒
-    AABB localBounds;
-    bool boundsValid = false;
-    
-    m_mesh->AccessVertices([&localBounds, &boundsValid](const std::vector<Vertex>& vertices) {
-        if (vertices.empty()) {
-            return;
-        }
-        
-        // 计算局部空间包围盒
-        Vector3 minPoint = vertices[0].position;
-        Vector3 maxPoint = vertices[0].position;
-        
-        for (const auto& vertex : vertices) {
-            minPoint = minPoint.cwiseMin(vertex.position);
-            maxPoint = maxPoint.cwiseMax(vertex.position);
-        }
-        
-        localBounds = AABB(minPoint, maxPoint);
-        boundsValid = true;
-    });
-    
-    if (!boundsValid) {
+    // 使用网格缓存的局部包围盒（CPU 顶点按驻留策略释放后仍然有效）
+    if (m_mesh->GetVertexCount() == 0) {
         return AABB();
     }
+    const AABB localBounds = m_mesh->CalculateBounds();
     
     // 如果有变换，将包围盒转换到世界空间
     if (m_transform) {
@@ -847,6 +849,7 @@ void ModelRenderable::Render(RenderState* renderState) {
                         if (uniformMgr->HasUniform("uHasInstanceData")) {
                             uniformMgr->SetBool("uHasInstanceData", false);
                         }
+                        part.mesh->ApplyVertexLayoutUniforms(uniformMgr);
                     }
                 }
             }
@@ -162,7 +162,8 @@ std::vector<ResourceInfo> ResourceMemoryTracker::GetMeshInfoList() const {
     for (const auto& [mesh, entry] : m_meshes) {
         ResourceInfo info;
         info.name = entry.name;
-        info.memorySize = entry.memorySize;
+        info.memorySize = CalculateMeshMemory(mesh);
+        info.cpuMemorySize = mesh->GetMemoryUsage();
         info.vertexCount = entry.vertexCount;
         info.indexCount = entry.indexCount;
         infos.push_back(info);
@@ -311,9 +312,10 @@ ResourceMemoryStats ResourceMemoryTracker::GetStats() const {
         stats.textureCount++;
     }
     
-    // 网格统计
+    // 网格统计：注册后网格可能才上传或按驻留策略释放 CPU 数据，因此按当前状态计算
     for (const auto& [mesh, entry] : m_meshes) {
-        stats.meshMemory += entry.memorySize;
+        stats.meshMemory += CalculateMeshMemory(mesh);
+        stats.meshCPUMemory += mesh->GetMemoryUsage();
         stats.meshCount++;
     }
     
@@ -352,6 +354,7 @@ bool ResourceMemoryTracker::GenerateReport(const std::string& outputPath) const
     file << "    \"totalMemoryMB\": " << (stats.totalMemory / (1024.0f * 1024.0f)) << ",\n";
     file << "    \"textureMemory\": " << stats.textureMemory << ",\n";
     file << "    \"meshMemory\": " << stats.meshMemory << ",\n";
+    file << "    \"meshCPUMemory\": " << stats.meshCPUMemory << ",\n";
     file << "    \"shaderMemory\": " << stats.shaderMemory << ",\n";
     file << "    \"bufferMemory\": " << stats.bufferMemory << ",\n";
     file << "    \"textureCount\": " << stats.textureCount << ",\n";
@@ -382,7 +385,8 @@ bool ResourceMemoryTracker::GenerateReport(const std::string& outputPath) const
         if (!first) file << ",\n";
         file << "    {\n";
         file << "      \"name\": \"" << entry.name << "\",\n";
-        file << "      \"size\": " << entry.memorySize << ",\n";
+        file << "      \"size\": " << CalculateMeshMemory(mesh) << ",\n";
+        file << "      \"cpuSize\": " << mesh->GetMemoryUsage() << ",\n";
         file << "      \"vertexCount\": " << entry.vertexCount << ",\n";
         file << "      \"indexCount\": " << entry.indexCount << "\n";
         file << "    }";
@@ -502,16 +506,9 @@ size_t ResourceMemoryTracker::CalculateMeshMemory(Mesh* mesh) const {
         return 0;
     }
     
-    // 顶点数据大小
-    // 假设每个顶点包含：position(12) + texCoord(8) + normal(12) + color(16) = 48 字节
-    size_t vertexSize = 48;  // sizeof(Vertex)
-    size_t vertexMemory = mesh->GetVertexCount() * vertexSize;
-    
-    // 索引数据大小
-    size_t indexSize = 4;  // sizeof(uint32_t)
-    size_t indexMemory = mesh->GetIndexCount() * indexSize;
-    
-    return vertexMemory + indexMemory;
+    // GPU 顶点缓冲按网格的顶点布局计算（完整布局 72 字节/顶点，压缩布局 20-32 字节），
+    // 索引按上传格式计算（16 或 32 位）
+    return mesh->GetGPUMemoryUsage();
 }
 
 size_t ResourceMemoryTracker::CalculateShaderMemory(Shader* shader) const {
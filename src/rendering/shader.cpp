@@ -20,11 +20,13 @@
  */
 #include "render/shader.h"
 #include "render/uniform_manager.h"
+#include "render/uniform_buffer.h"
 #include "render/file_utils.h"
 #include "render/logger.h"
 #include "render/error.h"
 #include "render/gl_thread_checker.h"
 #include <glad/glad.h>
+#include <atomic>
 
 namespace Render {
 
@@ -167,20 +169,34 @@ bool Shader::LoadFromSource_Locked(const std::string& vertexSource,
     // 创建 UniformManager
     m_uniformManager = std::make_unique<UniformManager>(m_programID);
     
+    // 声明了标准 uniform 块的着色器绑定到固定绑定点（未声明时忽略）
+    m_uniformManager->BindUniformBlock(kFrameUniformBlockName, kFrameUniformBinding);
+    m_uniformManager->BindUniformBlock(kMaterialUniformBlockName, kMaterialUniformBinding);
+    
     return true;
 }
 
+namespace {
+std::atomic<uint64_t> s_bindEpoch{1};
+}
+
 void Shader::Use() const {
     std::lock_guard<std::mutex> lock(m_mutex);
     if (m_programID != 0) {
         GL_THREAD_CHECK();
         glUseProgram(m_programID);
+        s_bindEpoch.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
 void Shader::Unuse() const {
     GL_THREAD_CHECK();
     glUseProgram(0);
+    s_bindEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t Shader::GetBindEpoch() {
+    return s_bindEpoch.load(std::memory_order_relaxed);
 }
 
 bool Shader::Reload() {
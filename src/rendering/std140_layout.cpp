@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/std140_layout.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Render {
+
+namespace {
+
+constexpr uint32_t kVec4Alignment = 16;
+
+constexpr uint32_t AlignUp(uint32_t value, uint32_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+bool IsMatrix(Std140Type type) {
+    return type == Std140Type::Mat3 || type == Std140Type::Mat4;
+}
+
+uint32_t MatrixColumns(Std140Type type) {
+    return type == Std140Type::Mat3 ? 3u : 4u;
+}
+
+} // namespace
+
+// ============================================================================
+// Std140Layout
+// ============================================================================
+
+uint32_t Std140Layout::GetBaseAlignment(Std140Type type) {
+    switch (type) {
+        case Std140Type::Int:
+        case Std140Type::Bool:
+        case Std140Type::Float:
+            return 4;
+        case Std140Type::Vec2:
+            return 8;
+        case Std140Type::Vec3:
+        case Std140Type::Vec4:
+        case Std140Type::IVec4:
+        case Std140Type::Mat3:
+        case Std140Type::Mat4:
+            return kVec4Alignment;
+    }
+    return kVec4Alignment;
+}
+
+uint32_t Std140Layout::GetTypeSize(Std140Type type) {
+    switch (type) {
+        case Std140Type::Int:
+        case Std140Type::Bool:
+        case Std140Type::Float:
+            return 4;
+        case Std140Type::Vec2:
+            return 8;
+        case Std140Type::Vec3:
+            return 12;
+        case Std140Type::Vec4:
+        case Std140Type::IVec4:
+            return 16;
+        case Std140Type::Mat3:
+            return 3 * kVec4Alignment;
+        case Std140Type::Mat4:
+            return 4 * kVec4Alignment;
+    }
+    return 0;
+}
+
+uint32_t Std140Layout::Add(const std::string& name, Std140Type type, uint32_t arraySize) {
+    Std140Member member;
+    member.name = name;
+    member.type = type;
+    member.arraySize = arraySize;
+
+    const uint32_t elementSize = GetTypeSize(type);
+    if (arraySize > 0) {
+        // 数组：元素对齐与步长均向上取整到 vec4
+        const uint32_t alignment = AlignUp(GetBaseAlignment(type), kVec4Alignment);
+        member.offset = AlignUp(m_cursor, alignment);
+        member.arrayStride = AlignUp(elementSize, kVec4Alignment);
+        member.size = member.arrayStride * arraySize;
+    } else {
+        member.offset = AlignUp(m_cursor, GetBaseAlignment(type));
+        member.size = elementSize;
+    }
+
+    m_cursor = member.offset + member.size;
+    // 数组与矩阵之后的成员从下一个 vec4 边界开始
+    if (arraySize > 0 || IsMatrix(type)) {
+        m_cursor = AlignUp(m_cursor, kVec4Alignment);
+    }
+
+    m_members.push_back(std::move(member));
+    return static_cast<uint32_t>(m_members.size() - 1);
+}
+
+int32_t Std140Layout::Find(const std::string& name) const {
+    for (size_t i = 0; i < m_members.size(); ++i) {
+        if (m_members[i].name == name) {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+uint32_t Std140Layout::GetSize() const {
+    return AlignUp(m_cursor, kVec4Alignment);
+}
+
+// ============================================================================
+// Std140Writer
+// ============================================================================
+
+Std140Writer::Std140Writer(const Std140Layout& layout)
+    : m_layout(layout)
+    , m_data(layout.GetSize(), 0) {
+}
+
+void Std140Writer::Clear() {
+    std::fill(m_data.begin(), m_data.end(), static_cast<uint8_t>(0));
+}
+
+uint8_t* Std140Writer::Locate(uint32_t member, Std140Type expected, uint32_t arrayIndex) {
+    if (member >= m_layout.GetMembers().size()) {
+        return nullptr;
+    }
+
+    const Std140Member& info = m_layout.GetMember(member);
+    if (info.type != expected) {
+        return nullptr;
+    }
+
+    uint32_t offset = info.offset;
+    if (info.arraySize > 0) {
+        if (arrayIndex >= info.arraySize) {
+            return nullptr;
+        }
+        offset += info.arrayStride * arrayIndex;
+    } else if (arrayIndex != 0) {
+        return nullptr;
+    }
+
+    if (offset + Std140Layout::GetTypeSize(expected) > m_data.size()) {
+        return nullptr;
+    }
+    return m_data.data() + offset;
+}
+
+void Std140Writer::SetInt(uint32_t member, int value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Int, arrayIndex)) {
+        const int32_t v = value;
+        std::memcpy(dst, &v, sizeof(v));
+    }
+}
+
+void Std140Writer::SetBool(uint32_t member, bool value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Bool, arrayIndex)) {
+        const uint32_t v = value ? 1u : 0u;
+        std::memcpy(dst, &v, sizeof(v));
+    }
+}
+
+void Std140Writer::SetFloat(uint32_t member, float value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Float, arrayIndex)) {
+        std::memcpy(dst, &value, sizeof(value));
+    }
+}
+
+void Std140Writer::SetVector2(uint32_t member, const Vector2& value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Vec2, arrayIndex)) {
+        const float v[2] = { value.x(), value.y() };
+        std::memcpy(dst, v, sizeof(v));
+    }
+}
+
+void Std140Writer::SetVector3(uint32_t member, const Vector3& value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Vec3, arrayIndex)) {
+        const float v[3] = { value.x(), value.y(), value.z() };
+        std::memcpy(dst, v, sizeof(v));
+    }
+}
+
+void Std140Writer::SetVector4(uint32_t member, const Vector4& value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Vec4, arrayIndex)) {
+        const float v[4] = { value.x(), value.y(), value.z(), value.w() };
+        std::memcpy(dst, v, sizeof(v));
+    }
+}
+
+void Std140Writer::SetIVector4(uint32_t member, int x, int y, int z, int w, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::IVec4, arrayIndex)) {
+        const int32_t v[4] = { x, y, z, w };
+        std::memcpy(dst, v, sizeof(v));
+    }
+}
+
+void Std140Writer::SetColor(uint32_t member, const Color& value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Vec4, arrayIndex)) {
+        const float v[4] = { value.r, value.g, value.b, value.a };
+        std::memcpy(dst, v, sizeof(v));
+    }
+}
+
+void Std140Writer::SetMatrix3(uint32_t member, const Matrix3& value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Mat3, arrayIndex)) {
+        // Eigen 默认列主序，与 GLSL 一致；每列补齐到 vec4
+        for (uint32_t col = 0; col < MatrixColumns(Std140Type::Mat3); ++col) {
+            const float column[3] = { value(0, col), value(1, col), value(2, col) };
+            std::memcpy(dst + col * kVec4Alignment, column, sizeof(column));
+        }
+    }
+}
+
+void Std140Writer::SetMatrix4(uint32_t member, const Matrix4& value, uint32_t arrayIndex) {
+    if (uint8_t* dst = Locate(member, Std140Type::Mat4, arrayIndex)) {
+        std::memcpy(dst, value.data(), sizeof(float) * 16);
+    }
+}
+
+// ============================================================================
+// 帧数据块
+// ============================================================================
+
+namespace {
+
+/// 与 BuildFrameLayout 中的追加顺序一一对应
+enum FrameMember : uint32_t {
+    FrameMember_View,
+    FrameMember_Projection,
+    FrameMember_ViewProjection,
+    FrameMember_CameraPosition,
+    FrameMember_TimeParams,
+    FrameMember_LightCounts,
+    FrameMember_CulledLightCounts,
+    FrameMember_DirectionalDirections,
+    FrameMember_DirectionalColors,
+    FrameMember_PointPositions,
+    FrameMember_PointColors,
+    FrameMember_PointAttenuation,
+    FrameMember_SpotPositions,
+    FrameMember_SpotColors,
+    FrameMember_SpotDirections,
+    FrameMember_SpotAttenuation,
+    FrameMember_AmbientColors,
+    FrameMember_LegacyLightPosition,
+    FrameMember_LegacyLightColor,
+    FrameMember_LegacyAmbientColor
+};
+
+Std140Layout BuildFrameLayout() {
+    Std140Layout layout;
+    layout.Add("uView", Std140Type::Mat4);
+    layout.Add("uProjection", Std140Type::Mat4);
+    layout.Add("uViewProjection", Std140Type::Mat4);
+    layout.Add("uCameraPosition", Std140Type::Vec4);
+    layout.Add("uTimeParams", Std140Type::Vec4);
+    layout.Add("uLightCounts", Std140Type::IVec4);
+    layout.Add("uCulledLightCounts", Std140Type::IVec4);
+    layout.Add("uDirectionalDirections", Std140Type::Vec4, kFrameMaxDirectionalLights);
+    layout.Add("uDirectionalColors", Std140Type::Vec4, kFrameMaxDirectionalLights);
+    layout.Add("uPointPositions", Std140Type::Vec4, kFrameMaxPointLights);
+    layout.Add("uPointColors", Std140Type::Vec4, kFrameMaxPointLights);
+    layout.Add("uPointAttenuation", Std140Type::Vec4, kFrameMaxPointLights);
+    layout.Add("uSpotPositions", Std140Type::Vec4, kFrameMaxSpotLights);
+    layout.Add("uSpotColors", Std140Type::Vec4, kFrameMaxSpotLights);
+    layout.Add("uSpotDirections", Std140Type::Vec4, kFrameMaxSpotLights);
+    layout.Add("uSpotAttenuation", Std140Type::Vec4, kFrameMaxSpotLights);
+    layout.Add("uAmbientColors", Std140Type::Vec4, kFrameMaxAmbientLights);
+    layout.Add("uLegacyLightPosition", Std140Type::Vec4);
+    layout.Add("uLegacyLightColor", Std140Type::Vec4);
+    layout.Add("uLegacyAmbientColor", Std140Type::Vec4);
+    return layout;
+}
+
+enum MaterialMember : uint32_t {
+    MaterialMember_Ambient,
+    MaterialMember_Diffuse,
+    MaterialMember_Specular,
+    MaterialMember_Emissive,
+    MaterialMember_Params
+};
+
+Std140Layout BuildMaterialLayout() {
+    Std140Layout layout;
+    layout.Add("uMatAmbient", Std140Type::Vec4);
+    layout.Add("uMatDiffuse", Std140Type::Vec4);
+    layout.Add("uMatSpecular", Std140Type::Vec4);
+    layout.Add("uMatEmissive", Std140Type::Vec4);
+    layout.Add("uMatParams", Std140Type::Vec4);
+    return layout;
+}
+
+template <size_t N>
+void WriteVector4Array(Std140Writer& writer, uint32_t member,
+                       const std::array<Vector4, N>& values, uint32_t count) {
+    // 超出 count 的元素保持为零，避免上传未初始化数据
+    const uint32_t clamped = std::min<uint32_t>(count, static_cast<uint32_t>(N));
+    for (uint32_t i = 0; i < clamped; ++i) {
+        writer.SetVector4(member, values[i], i);
+    }
+}
+
+} // namespace
+
+const Std140Layout& GetFrameUniformLayout() {
+    static const Std140Layout layout = BuildFrameLayout();
+    return layout;
+}
+
+void PackFrameUniforms(const FrameUniformData& data, Std140Writer& writer) {
+    writer.Clear();
+
+    writer.SetMatrix4(FrameMember_View, data.view);
+    writer.SetMatrix4(FrameMember_Projection, data.projection);
+    writer.SetMatrix4(FrameMember_ViewProjection, data.projection * data.view);
+    writer.SetVector4(FrameMember_CameraPosition,
+                      Vector4(data.cameraPosition.x(), data.cameraPosition.y(), data.cameraPosition.z(), 1.0f));
+    writer.SetVector4(FrameMember_TimeParams, Vector4(data.time, data.deltaTime, 0.0f, 0.0f));
+
+    const uint32_t directionalCount = std::min(data.directionalCount, kFrameMaxDirectionalLights);
+    const uint32_t pointCount = std::min(data.pointCount, kFrameMaxPointLights);
+    const uint32_t spotCount = std::min(data.spotCount, kFrameMaxSpotLights);
+    const uint32_t ambientCount = std::min(data.ambientCount, kFrameMaxAmbientLights);
+
+    writer.SetIVector4(FrameMember_LightCounts,
+                       static_cast<int>(directionalCount), static_cast<int>(pointCount),
+                       static_cast<int>(spotCount), static_cast<int>(ambientCount));
+    writer.SetIVector4(FrameMember_CulledLightCounts,
+                       static_cast<int>(data.culledDirectional), static_cast<int>(data.culledPoint),
+                       static_cast<int>(data.culledSpot), static_cast<int>(data.culledAmbient));
+
+    WriteVector4Array(writer, FrameMember_DirectionalDirections, data.directionalDirections, directionalCount);
+    WriteVector4Array(writer, FrameMember_DirectionalColors, data.directionalColors, directionalCount);
+    WriteVector4Array(writer, FrameMember_PointPositions, data.pointPositions, pointCount);
+    WriteVector4Array(writer, FrameMember_PointColors, data.pointColors, pointCount);
+    WriteVector4Array(writer, FrameMember_PointAttenuation, data.pointAttenuation, pointCount);
+    WriteVector4Array(writer, FrameMember_SpotPositions, data.spotPositions, spotCount);
+    WriteVector4Array(writer, FrameMember_SpotColors, data.spotColors, spotCount);
+    WriteVector4Array(writer, FrameMember_SpotDirections, data.spotDirections, spotCount);
+    WriteVector4Array(writer, FrameMember_SpotAttenuation, data.spotAttenuation, spotCount);
+    WriteVector4Array(writer, FrameMember_AmbientColors, data.ambientColors, ambientCount);
+
+    writer.SetVector4(FrameMember_LegacyLightPosition,
+                      Vector4(data.legacyLightPosition.x(), data.legacyLightPosition.y(),
+                              data.legacyLightPosition.z(), 1.0f));
+    writer.SetVector4(FrameMember_LegacyLightColor,
+                      Vector4(data.legacyLightColor.r, data.legacyLightColor.g,
+                              data.legacyLightColor.b, data.legacyLightIntensity));
+    writer.SetColor(FrameMember_LegacyAmbientColor, data.legacyAmbientColor);
+}
+
+const Std140Layout& GetMaterialUniformLayout() {
+    static const Std140Layout layout = BuildMaterialLayout();
+    return layout;
+}
+
+void PackMaterialUniforms(const MaterialUniformData& data, Std140Writer& writer) {
+    writer.Clear();
+    writer.SetColor(MaterialMember_Ambient, data.ambient);
+    writer.SetColor(MaterialMember_Diffuse, data.diffuse);
+    writer.SetColor(MaterialMember_Specular, data.specular);
+    writer.SetColor(MaterialMember_Emissive, data.emissive);
+    writer.SetVector4(MaterialMember_Params,
+                      Vector4(data.shininess, data.opacity, data.metallic, data.roughness));
+}
+
+} // namespace Render
@@ -19,11 +19,13 @@
  * For commercial licensing, please contact: 2052046346@qq.com
  */
 #include "render/texture.h"
+#include "render/texture_compression.h"
 #include "render/logger.h"
 #include "render/error.h"
 #include "render/gl_thread_checker.h"
 #include <SDL3_image/SDL_image.h>
 #include <SDL3/SDL.h>
+#include <algorithm>
 
 namespace Render {
 
@@ -33,6 +35,8 @@ Texture::Texture()
     , m_height(0)
     , m_format(TextureFormat::RGBA)
     , m_hasMipmap(false)
+    , m_mipLevelCount(0)
+    , m_storageBaseLevel(0)
 {
 }
 
@@ -48,6 +52,8 @@ Texture::Texture(Texture&& other) noexcept {
     m_height = other.m_height;
     m_format = other.m_format;
     m_hasMipmap = other.m_hasMipmap;
+    m_mipLevelCount = other.m_mipLevelCount;
+    m_storageBaseLevel = other.m_storageBaseLevel;
     
     other.m_textureID = 0;
     other.m_width = 0;
@@ -71,6 +77,8 @@ Texture& Texture::operator=(Texture&& other) noexcept {
         m_height = other.m_height;
         m_format = other.m_format;
         m_hasMipmap = other.m_hasMipmap;
+        m_mipLevelCount = other.m_mipLevelCount;
+        m_storageBaseLevel = other.m_storageBaseLevel;
 
         other.m_textureID = 0;
         other.m_width = 0;
@@ -158,6 +166,8 @@ bool Texture::LoadFromFile(const std::string& filepath, bool generateMipmap) {
         m_width = width;
         m_height = height;
         m_format = format;
+        m_mipLevelCount = 0;
+        m_storageBaseLevel = 0;
 
         // ✅ 在绑定纹理前，清理OpenGL状态以避免冲突
         // 确保没有VAO绑定（VAO可能影响纹理操作）
@@ -285,6 +295,12 @@ bool Texture::CreateFromData(const void* data, int width, int height,
         return false;
     }
     
+    if (TextureCompressor::IsBlockCompressed(format)) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidArgument, 
+                                 "Texture::CreateFromData: 块压缩格式请使用 CreateFromMipLevels"));
+        return false;
+    }
+    
     if (width > 8192 || height > 8192) {
         HANDLE_ERROR(RENDER_WARNING(ErrorCode::OutOfRange, 
                                    "Texture::CreateFromData: 纹理尺寸超过推荐限制: " + 
@@ -307,6 +323,8 @@ bool Texture::CreateFromData(const void* data, int width, int height,
         m_width = width;
         m_height = height;
         m_format = format;
+        m_mipLevelCount = 0;
+        m_storageBaseLevel = 0;
 
         // ✅ 在绑定纹理前，清理OpenGL状态以避免冲突
         // 确保没有VAO绑定（VAO可能影响纹理操作）
@@ -418,6 +436,246 @@ bool Texture::CreateEmpty(int width, int height, TextureFormat format) {
     return CreateFromData(nullptr, width, height, format, false);
 }
 
+bool Texture::CreateFromMipLevels(const void* data,
+                                  const std::vector<TextureMipLevel>& levels,
+                                  TextureFormat format,
+                                  int storageBaseLevel) {
+    // 参数验证
+    if (levels.empty() || levels[0].width <= 0 || levels[0].height <= 0 ||
+        storageBaseLevel < 0 || storageBaseLevel >= static_cast<int>(levels.size())) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidArgument, 
+                                 "Texture::CreateFromMipLevels: 无效的 mip 数据"));
+        return false;
+    }
+    
+    const bool compressed = TextureCompressor::IsBlockCompressed(format);
+    if (compressed && !IsFormatSupported(format)) {
+        Logger::GetInstance().Warning("Texture::CreateFromMipLevels: 当前 OpenGL 不支持压缩格式 " + 
+                                      std::to_string(static_cast<int>(format)));
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    try {
+        // 释放旧纹理（内部方法，无需再加锁）
+        if (m_textureID != 0) {
+            glDeleteTextures(1, &m_textureID);
+            Logger::GetInstance().Debug("释放纹理 ID: " + std::to_string(m_textureID));
+            m_textureID = 0;
+        }
+
+        m_width = levels[0].width;
+        m_height = levels[0].height;
+        m_format = format;
+        m_hasMipmap = levels.size() > 1;
+        m_mipLevelCount = static_cast<int>(levels.size());
+        m_storageBaseLevel = storageBaseLevel;
+
+        // 与 CreateFromData 相同：解绑 VAO、激活纹理单元 0 并清除旧错误
+        GLint currentVAO = 0;
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &currentVAO);
+        if (currentVAO != 0) {
+            glBindVertexArray(0);
+        }
+        glActiveTexture(GL_TEXTURE0);
+        glGetError();
+
+        glGenTextures(1, &m_textureID);
+        if (m_textureID == 0) {
+            throw std::runtime_error("Failed to generate texture ID");
+        }
+        glBindTexture(GL_TEXTURE_2D, m_textureID);
+
+        // 逐级上传预生成的数据（不调用 glGenerateMipmap）
+        const GLenum glInternalFormat = ToGLInternalFormat(format);
+        const GLenum glFormat = ToGLFormat(format);
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (size_t level = 0; level < levels.size(); ++level) {
+            const TextureMipLevel& mip = levels[level];
+            // storageBaseLevel 之前的级别定义为 0x0，不占用显存
+            const bool allocated = static_cast<int>(level) >= storageBaseLevel;
+            const GLsizei width = allocated ? mip.width : 0;
+            const GLsizei height = allocated ? mip.height : 0;
+            const uint8_t* levelData = (bytes && allocated) ? bytes + mip.offset : nullptr;
+            if (compressed) {
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), glInternalFormat,
+                                       width, height, 0,
+                                       allocated ? static_cast<GLsizei>(mip.size) : 0, levelData);
+            } else {
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), glInternalFormat,
+                             width, height, 0, glFormat, GL_UNSIGNED_BYTE, levelData);
+            }
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        
+        GLenum err = glGetError();
+        if (err != GL_NO_ERROR) {
+            Logger::GetInstance().Error("上传 mip 链失败，OpenGL 错误: " + std::to_string(err));
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDeleteTextures(1, &m_textureID);
+            m_textureID = 0;
+            m_width = 0;
+            m_height = 0;
+            m_hasMipmap = false;
+            m_mipLevelCount = 0;
+            m_storageBaseLevel = 0;
+            if (currentVAO != 0) {
+                glBindVertexArray(currentVAO);
+            }
+            return false;
+        }
+
+        // 限制采样级别到实际提供的级别，避免纹理不完整
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, storageBaseLevel);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_LOD, static_cast<float>(storageBaseLevel));
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_mipLevelCount - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_hasMipmap ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (currentVAO != 0) {
+            glBindVertexArray(currentVAO);
+        }
+
+        Logger::GetInstance().Debug("从 mip 链创建纹理: " + std::to_string(m_width) + "x" + 
+                     std::to_string(m_height) + ", ID: " + std::to_string(m_textureID) + 
+                     ", 格式: " + std::to_string(static_cast<int>(format)) + 
+                     ", 级别: " + std::to_string(m_mipLevelCount));
+
+        return true;
+        
+    } catch (const std::exception& e) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::Unknown, 
+                                 "Texture::CreateFromMipLevels: Exception during texture creation - " + std::string(e.what())));
+        
+        if (m_textureID != 0) {
+            glDeleteTextures(1, &m_textureID);
+            m_textureID = 0;
+        }
+        m_width = 0;
+        m_height = 0;
+        m_hasMipmap = false;
+        m_mipLevelCount = 0;
+        m_storageBaseLevel = 0;
+        
+        return false;
+    }
+}
+
+bool Texture::UploadSubImage(int level, int y, int width, int height, const void* data, size_t size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (m_textureID == 0 || width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    glGetError();
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (TextureCompressor::IsBlockCompressed(m_format)) {
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, height,
+                                  ToGLInternalFormat(m_format), static_cast<GLsizei>(size), data);
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, height,
+                        ToGLFormat(m_format), GL_UNSIGNED_BYTE, data);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        Logger::GetInstance().Error("Texture::UploadSubImage 失败，OpenGL 错误: " + std::to_string(err));
+        return false;
+    }
+    return true;
+}
+
+bool Texture::SetBaseLevel(int level) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (m_textureID == 0) {
+        return false;
+    }
+    const int maxLevel = std::max(m_mipLevelCount, 1) - 1;
+    level = std::clamp(level, 0, maxLevel);
+    
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_LOD, static_cast<float>(level));
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+bool Texture::SetStorageBaseLevel(int level) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (m_textureID == 0 || m_mipLevelCount <= 0) {
+        return false;
+    }
+    level = std::clamp(level, 0, m_mipLevelCount - 1);
+    if (level == m_storageBaseLevel) {
+        return true;
+    }
+    
+    const bool compressed = TextureCompressor::IsBlockCompressed(m_format);
+    const GLenum glInternalFormat = ToGLInternalFormat(m_format);
+    const GLenum glFormat = ToGLFormat(m_format);
+    const int first = std::min(level, m_storageBaseLevel);
+    const int end = std::max(level, m_storageBaseLevel);
+    
+    glGetError();
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    for (int mip = first; mip < end; ++mip) {
+        // 降低基础级别时为 [level, 旧基础级别) 分配存储（内容未定义），提高时把 [旧基础级别, level) 重定义为 0x0 以释放显存
+        const bool allocate = mip >= level;
+        const GLsizei width = allocate ? std::max(1, m_width >> mip) : 0;
+        const GLsizei height = allocate ? std::max(1, m_height >> mip) : 0;
+        if (compressed) {
+            const size_t size = allocate ? TextureCompressor::GetLevelSize(m_format, width, height) : 0;
+            glCompressedTexImage2D(GL_TEXTURE_2D, mip, glInternalFormat, width, height, 0,
+                                   static_cast<GLsizei>(size), nullptr);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, mip, glInternalFormat, width, height, 0,
+                         glFormat, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        Logger::GetInstance().Error("Texture::SetStorageBaseLevel 失败，OpenGL 错误: " + std::to_string(err));
+        return false;
+    }
+    m_storageBaseLevel = level;
+    return true;
+}
+
+int Texture::GetStorageBaseLevel() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_storageBaseLevel;
+}
+
+bool Texture::IsFormatSupported(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+            return GLAD_GL_EXT_texture_compression_s3tc != 0;
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+            return true;   // RGTC 为 OpenGL 3.0 核心功能
+        case TextureFormat::BC7:
+            return GLAD_GL_ARB_texture_compression_bptc != 0 ||
+                   GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 2);
+        default:
+            return true;
+    }
+}
+
 void Texture::Bind(unsigned int unit) const {
     // ✅ 修复：两阶段锁定，OpenGL调用移到锁外
     GLuint textureID;
@@ -507,6 +765,8 @@ void Texture::Release() {
     m_width = 0;
     m_height = 0;
     m_hasMipmap = false;
+    m_mipLevelCount = 0;
+    m_storageBaseLevel = 0;
 }
 
 GLenum Texture::ToGLFormat(TextureFormat format) const {
@@ -529,6 +789,11 @@ GLenum Texture::ToGLInternalFormat(TextureFormat format) const {
         case TextureFormat::RG:           return GL_RG8;
         case TextureFormat::Depth:        return GL_DEPTH_COMPONENT24;
         case TextureFormat::DepthStencil: return GL_DEPTH24_STENCIL8;
+        case TextureFormat::BC1:          return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFormat::BC3:          return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::BC4:          return GL_COMPRESSED_RED_RGTC1;
+        case TextureFormat::BC5:          return GL_COMPRESSED_RG_RGTC2;
+        case TextureFormat::BC7:          return GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
         default:                          return GL_RGBA8;
     }
 }
@@ -563,6 +828,20 @@ size_t Texture::GetMemoryUsage() const {
         return 0;
     }
     
+    // 块压缩格式：按实际分配的级别逐级累加块大小
+    if (TextureCompressor::IsBlockCompressed(m_format)) {
+        size_t total = 0;
+        const int levelCount = std::max(1, m_mipLevelCount);
+        for (int level = 0, w = m_width, h = m_height; level < levelCount; ++level) {
+            if (level >= m_storageBaseLevel) {
+                total += TextureCompressor::GetLevelSize(m_format, w, h);
+            }
+            w = std::max(1, w / 2);
+            h = std::max(1, h / 2);
+        }
+        return total;
+    }
+    
     // 计算每像素字节数
     size_t bytesPerPixel = 0;
     switch (m_format) {
@@ -584,6 +863,19 @@ size_t Texture::GetMemoryUsage() const {
         case TextureFormat::DepthStencil:
             bytesPerPixel = 4;  // 24 位深度 + 8 位模板
             break;
+        default:
+            bytesPerPixel = 4;
+            break;
+    }
+    
+    // 预生成 mip 链：按实际分配的级别逐级累加（流式纹理可能释放了精细级别）
+    if (m_mipLevelCount > 0) {
+        size_t total = 0;
+        for (int level = m_storageBaseLevel; level < m_mipLevelCount; ++level) {
+            total += static_cast<size_t>(std::max(1, m_width >> level)) *
+                     static_cast<size_t>(std::max(1, m_height >> level)) * bytesPerPixel;
+        }
+        return total;
     }
     
     // 溢出检查：检查 width * height 是否溢出
@@ -620,5 +912,16 @@ size_t Texture::GetMemoryUsage() const {
     return baseMemory;
 }
 
-} // namespace Render
+int Texture::GetMipLevelCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (m_textureID == 0) {
+        return 0;
+    }
+    if (m_mipLevelCount > 0) {
+        return m_mipLevelCount;
+    }
+    return m_hasMipmap ? TextureCompressor::GetMipLevelCount(m_width, m_height) : 1;
+}
 
+} // namespace Render
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/texture_cache.h"
+#include "render/file_utils.h"
+#include "render/logger.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace Render {
+
+namespace {
+
+constexpr char kMagic[4] = {'R', 'T', 'E', 'X'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kMaxMipCount = 32;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipCount;
+};
+
+struct MipRecord {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+    uint64_t size;
+};
+
+static_assert(sizeof(FileHeader) == 32, "Texture cache header layout changed");
+static_assert(sizeof(MipRecord) == 24, "Texture cache mip record layout changed");
+
+template<typename T>
+uint64_t HashValue(const T& value, uint64_t hash) {
+    return FileUtils::HashBytes(&value, sizeof(T), hash);
+}
+
+} // namespace
+
+TextureCache& TextureCache::GetInstance() {
+    static TextureCache instance;
+    return instance;
+}
+
+void TextureCache::SetCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_directoryMutex);
+    m_directory = directory;
+}
+
+std::string TextureCache::GetCacheDirectory() const {
+    std::lock_guard<std::mutex> lock(m_directoryMutex);
+    return m_directory;
+}
+
+uint64_t TextureCache::BuildKey(uint64_t sourceHash, const TextureCompressionOptions& options, bool generateMipmap) {
+    uint64_t hash = HashValue(kFormatVersion, FileUtils::kHashSeed);
+    hash = HashValue(sourceHash, hash);
+    hash = HashValue(static_cast<uint32_t>(options.format), hash);
+    hash = HashValue(static_cast<uint8_t>(options.autoSelectFormat), hash);
+    hash = HashValue(static_cast<uint8_t>(generateMipmap), hash);
+    return hash;
+}
+
+std::string TextureCache::GetCachePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.texc", static_cast<unsigned long long>(key));
+    return FileUtils::CombinePaths(GetCacheDirectory(), name);
+}
+
+// ============================================================================
+// 读写
+// ============================================================================
+
+bool TextureCache::Load(uint64_t key,
+                        TextureFormat& outFormat,
+                        std::vector<uint8_t>& outData,
+                        std::vector<TextureMipLevel>& outLevels) {
+    outData.clear();
+    outLevels.clear();
+    
+    if (!IsEnabled()) {
+        return false;
+    }
+    
+    const std::string path = GetCachePath(key);
+    MappedFile file;
+    if (!file.Open(path)) {
+        m_misses++;
+        return false;
+    }
+    
+    const uint8_t* data = file.GetData();
+    const size_t size = file.GetSize();
+    
+    FileHeader header{};
+    if (size < sizeof(FileHeader)) {
+        LOG_WARNING_F("TextureCache: Truncated cache file %s", path.c_str());
+        m_misses++;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    
+    const auto format = static_cast<TextureFormat>(header.format);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kFormatVersion ||
+        header.key != key ||
+        !TextureCompressor::IsBlockCompressed(format) ||
+        header.mipCount == 0 || header.mipCount > kMaxMipCount ||
+        size < sizeof(FileHeader) + static_cast<uint64_t>(header.mipCount) * sizeof(MipRecord)) {
+        LOG_WARNING_F("TextureCache: Invalid or stale cache file %s", path.c_str());
+        m_misses++;
+        return false;
+    }
+    
+    const uint64_t dataStart = sizeof(FileHeader) + static_cast<uint64_t>(header.mipCount) * sizeof(MipRecord);
+    std::vector<TextureMipLevel> levels(header.mipCount);
+    uint64_t dataSize = 0;
+    for (uint32_t i = 0; i < header.mipCount; ++i) {
+        MipRecord record{};
+        std::memcpy(&record, data + sizeof(FileHeader) + i * sizeof(MipRecord), sizeof(record));
+        
+        // 记录必须与格式/尺寸推导出的级别大小一致，且按顺序紧密排列
+        if (record.width == 0 || record.height == 0 ||
+            record.size != TextureCompressor::GetLevelSize(format, static_cast<int>(record.width),
+                                                           static_cast<int>(record.height)) ||
+            record.offset != dataSize ||
+            record.size > size - dataStart - dataSize) {
+            LOG_WARNING_F("TextureCache: Corrupted mip %u in %s", i, path.c_str());
+            m_misses++;
+            return false;
+        }
+        
+        levels[i].width = static_cast<int>(record.width);
+        levels[i].height = static_cast<int>(record.height);
+        levels[i].offset = static_cast<size_t>(record.offset);
+        levels[i].size = static_cast<size_t>(record.size);
+        dataSize += record.size;
+    }
+    
+    if (levels[0].width != static_cast<int>(header.width) || levels[0].height != static_cast<int>(header.height)) {
+        LOG_WARNING_F("TextureCache: Size mismatch in %s", path.c_str());
+        m_misses++;
+        return false;
+    }
+    
+    outData.assign(data + dataStart, data + dataStart + dataSize);
+    outLevels = std::move(levels);
+    outFormat = format;
+    m_hits++;
+    return true;
+}
+
+bool TextureCache::Store(uint64_t key,
+                         TextureFormat format,
+                         const std::vector<uint8_t>& data,
+                         const std::vector<TextureMipLevel>& levels) {
+    if (!IsEnabled() || levels.empty() || levels.size() > kMaxMipCount ||
+        !TextureCompressor::IsBlockCompressed(format)) {
+        return false;
+    }
+    
+    std::vector<MipRecord> records(levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const TextureMipLevel& level = levels[i];
+        if (level.offset > data.size() || level.size > data.size() - level.offset) {
+            LOG_WARNING_F("TextureCache: Mip %zu exceeds data size, skipping store", i);
+            return false;
+        }
+        records[i].width = static_cast<uint32_t>(level.width);
+        records[i].height = static_cast<uint32_t>(level.height);
+        records[i].size = level.size;
+    }
+    
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.key = key;
+    header.format = static_cast<uint32_t>(format);
+    header.width = static_cast<uint32_t>(levels[0].width);
+    header.height = static_cast<uint32_t>(levels[0].height);
+    header.mipCount = static_cast<uint32_t>(levels.size());
+    
+    // 级别数据按顺序重新紧密排列（输入的 offset 可能带有间隙）
+    uint64_t offset = 0;
+    for (auto& record : records) {
+        record.offset = offset;
+        offset += record.size;
+    }
+    
+    const std::string path = GetCachePath(key);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    
+    // 先写临时文件再重命名，避免其他线程/进程读到写了一半的文件
+    std::ostringstream tempSuffix;
+    tempSuffix << ".tmp" << std::this_thread::get_id();
+    const std::string tempPath = path + tempSuffix.str();
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            LOG_WARNING_F("TextureCache: Failed to open %s for writing", tempPath.c_str());
+            return false;
+        }
+        
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()),
+                  static_cast<std::streamsize>(records.size() * sizeof(MipRecord)));
+        for (const auto& level : levels) {
+            out.write(reinterpret_cast<const char*>(data.data() + level.offset),
+                      static_cast<std::streamsize>(level.size));
+        }
+        if (!out.good()) {
+            LOG_WARNING_F("TextureCache: Failed to write %s", tempPath.c_str());
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        // Windows 上目标已存在时重命名可能失败（其他线程已写入相同内容）
+        std::filesystem::remove(tempPath, ec);
+        return std::filesystem::exists(path);
+    }
+    
+    m_writes++;
+    LOG_INFO_F("TextureCache: Stored %ux%u (%u mips) to %s (%llu bytes)",
+               header.width, header.height, header.mipCount, path.c_str(),
+               static_cast<unsigned long long>(offset));
+    return true;
+}
+
+size_t TextureCache::ClearDiskCache() {
+    const std::string directory = GetCacheDirectory();
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        return 0;
+    }
+    
+    size_t removed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".texc") {
+            if (std::filesystem::remove(entry.path(), ec)) {
+                removed++;
+            }
+        }
+    }
+    return removed;
+}
+
+TextureCache::Stats TextureCache::GetStats() const {
+    Stats stats;
+    stats.hits = m_hits.load();
+    stats.misses = m_misses.load();
+    stats.writes = m_writes.load();
+    return stats;
+}
+
+void TextureCache::ResetStats() {
+    m_hits = 0;
+    m_misses = 0;
+    m_writes = 0;
+}
+
+} // namespace Render
@@ -0,0 +1,852 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/texture_compression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Render {
+
+namespace {
+
+constexpr int kBlockPixels = 16;
+
+/// BC7 4 位索引插值权重（单位 1/64）
+constexpr int kBC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/// BC7 最小二乘端点优化的最大迭代次数
+constexpr int kBC7RefineIterations = 2;
+
+using BlockPixels = uint8_t[kBlockPixels][4];
+
+/**
+ * @brief 读取 4x4 块（超出图像边界的像素复用边缘像素）
+ */
+void FetchBlock(const uint8_t* rgba, int width, int height, int blockX, int blockY, BlockPixels& out) {
+    for (int y = 0; y < 4; ++y) {
+        const int sy = std::min(blockY * 4 + y, height - 1);
+        for (int x = 0; x < 4; ++x) {
+            const int sx = std::min(blockX * 4 + x, width - 1);
+            std::memcpy(out[y * 4 + x], rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+        }
+    }
+}
+
+/**
+ * @brief 写回 4x4 块（只写图像范围内的像素）
+ */
+void StoreBlock(uint8_t* rgba, int width, int height, int blockX, int blockY, const BlockPixels& block) {
+    for (int y = 0; y < 4; ++y) {
+        const int dy = blockY * 4 + y;
+        if (dy >= height) {
+            break;
+        }
+        for (int x = 0; x < 4; ++x) {
+            const int dx = blockX * 4 + x;
+            if (dx >= width) {
+                break;
+            }
+            std::memcpy(rgba + (static_cast<size_t>(dy) * width + dx) * 4, block[y * 4 + x], 4);
+        }
+    }
+}
+
+/**
+ * @brief 计算块内 channels 个通道的主成分方向（幂迭代），返回均值与方向
+ * @return 块内颜色几乎一致时返回 false
+ */
+template<int Channels>
+bool PrincipalAxis(const BlockPixels& px, float mean[Channels], float axis[Channels]) {
+    for (int c = 0; c < Channels; ++c) {
+        mean[c] = 0.0f;
+        for (int i = 0; i < kBlockPixels; ++i) {
+            mean[c] += px[i][c];
+        }
+        mean[c] /= kBlockPixels;
+    }
+    
+    float cov[Channels][Channels] = {};
+    for (int i = 0; i < kBlockPixels; ++i) {
+        float d[Channels];
+        for (int c = 0; c < Channels; ++c) {
+            d[c] = px[i][c] - mean[c];
+        }
+        for (int a = 0; a < Channels; ++a) {
+            for (int b = a; b < Channels; ++b) {
+                cov[a][b] += d[a] * d[b];
+            }
+        }
+    }
+    for (int a = 0; a < Channels; ++a) {
+        for (int b = 0; b < a; ++b) {
+            cov[a][b] = cov[b][a];
+        }
+    }
+    
+    for (int c = 0; c < Channels; ++c) {
+        axis[c] = 1.0f;
+    }
+    float length = 0.0f;
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[Channels] = {};
+        for (int a = 0; a < Channels; ++a) {
+            for (int b = 0; b < Channels; ++b) {
+                next[a] += cov[a][b] * axis[b];
+            }
+        }
+        length = 0.0f;
+        for (int c = 0; c < Channels; ++c) {
+            length = std::max(length, std::abs(next[c]));
+        }
+        if (length < 1e-6f) {
+            return false;
+        }
+        for (int c = 0; c < Channels; ++c) {
+            axis[c] = next[c] / length;
+        }
+    }
+    
+    float norm = 0.0f;
+    for (int c = 0; c < Channels; ++c) {
+        norm += axis[c] * axis[c];
+    }
+    norm = std::sqrt(norm);
+    for (int c = 0; c < Channels; ++c) {
+        axis[c] /= norm;
+    }
+    return true;
+}
+
+/**
+ * @brief 沿主成分方向取块内投影范围作为初始端点
+ */
+template<int Channels>
+void InitialEndpoints(const BlockPixels& px, float lo[Channels], float hi[Channels]) {
+    float mean[Channels];
+    float axis[Channels];
+    if (!PrincipalAxis<Channels>(px, mean, axis)) {
+        for (int c = 0; c < Channels; ++c) {
+            lo[c] = hi[c] = mean[c];
+        }
+        return;
+    }
+    
+    float minT = 0.0f;
+    float maxT = 0.0f;
+    for (int i = 0; i < kBlockPixels; ++i) {
+        float t = 0.0f;
+        for (int c = 0; c < Channels; ++c) {
+            t += (px[i][c] - mean[c]) * axis[c];
+        }
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    for (int c = 0; c < Channels; ++c) {
+        lo[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+        hi[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+    }
+}
+
+/**
+ * @brief 给定每个像素在端点间的插值权重，最小二乘求解端点
+ * 
+ * 最小化 Σ|(1-t)·a + t·b - x|²
+ * @return 方程退化（所有像素使用同一权重）时返回 false
+ */
+template<int Channels>
+bool LeastSquaresEndpoints(const BlockPixels& px, const float weights[kBlockPixels],
+                           float a[Channels], float b[Channels]) {
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[Channels] = {};
+    float bx[Channels] = {};
+    for (int i = 0; i < kBlockPixels; ++i) {
+        const float t = weights[i];
+        const float s = 1.0f - t;
+        aa += s * s;
+        ab += s * t;
+        bb += t * t;
+        for (int c = 0; c < Channels; ++c) {
+            ax[c] += s * px[i][c];
+            bx[c] += t * px[i][c];
+        }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::abs(det) < 1e-6f) {
+        return false;
+    }
+    const float inv = 1.0f / det;
+    for (int c = 0; c < Channels; ++c) {
+        a[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inv, 0.0f, 255.0f);
+        b[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inv, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// ============================================================================
+// BC1 颜色块（BC1/BC3 共用）
+// ============================================================================
+
+uint16_t PackRGB565(const float color[3]) {
+    const int r = std::clamp(static_cast<int>(color[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+    const int g = std::clamp(static_cast<int>(color[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+    const int b = std::clamp(static_cast<int>(color[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void UnpackRGB565(uint16_t packed, int out[3]) {
+    const int r = (packed >> 11) & 31;
+    const int g = (packed >> 5) & 63;
+    const int b = packed & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * @brief 构造 BC1 调色板
+ * @param fourColor true 时为 4 色模式；false 时第 3 色为平均值、第 4 色为透明黑
+ */
+void BuildColorPalette(uint16_t c0, uint16_t c1, bool fourColor, int palette[4][4]) {
+    UnpackRGB565(c0, palette[0]);
+    UnpackRGB565(c1, palette[1]);
+    palette[0][3] = palette[1][3] = 255;
+    for (int c = 0; c < 3; ++c) {
+        if (fourColor) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = fourColor ? 255 : 0;
+}
+
+/**
+ * @brief 为每个像素选择最近的调色板颜色
+ * @return 总平方误差
+ */
+int SelectColorIndices(const BlockPixels& px, uint16_t c0, uint16_t c1, uint8_t indices[kBlockPixels]) {
+    int palette[4][4];
+    BuildColorPalette(c0, c1, true, palette);
+    int totalError = 0;
+    for (int i = 0; i < kBlockPixels; ++i) {
+        int bestError = 0x7fffffff;
+        for (int p = 0; p < 4; ++p) {
+            const int dr = px[i][0] - palette[p][0];
+            const int dg = px[i][1] - palette[p][1];
+            const int db = px[i][2] - palette[p][2];
+            const int error = dr * dr + dg * dg + db * db;
+            if (error < bestError) {
+                bestError = error;
+                indices[i] = static_cast<uint8_t>(p);
+            }
+        }
+        totalError += bestError;
+    }
+    return totalError;
+}
+
+void EncodeColorBlock(const BlockPixels& px, uint8_t out[8]) {
+    float lo[3];
+    float hi[3];
+    InitialEndpoints<3>(px, lo, hi);
+    
+    uint16_t c0 = PackRGB565(hi);
+    uint16_t c1 = PackRGB565(lo);
+    uint8_t indices[kBlockPixels];
+    int error = SelectColorIndices(px, c0, c1, indices);
+    
+    // 一次最小二乘端点优化：调色板顺序 c0, c1, 2/3·c0+1/3·c1, 1/3·c0+2/3·c1
+    if (c0 != c1) {
+        constexpr float kIndexWeight[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+        float weights[kBlockPixels];
+        for (int i = 0; i < kBlockPixels; ++i) {
+            weights[i] = kIndexWeight[indices[i]];
+        }
+        float a[3];
+        float b[3];
+        if (LeastSquaresEndpoints<3>(px, weights, a, b)) {
+            const uint16_t r0 = PackRGB565(a);
+            const uint16_t r1 = PackRGB565(b);
+            uint8_t refined[kBlockPixels];
+            const int refinedError = SelectColorIndices(px, r0, r1, refined);
+            if (refinedError < error) {
+                c0 = r0;
+                c1 = r1;
+                error = refinedError;
+                std::memcpy(indices, refined, sizeof(indices));
+            }
+        }
+    }
+    
+    // 4 色模式要求 c0 > c1；相等时所有像素使用索引 0
+    if (c0 < c1) {
+        std::swap(c0, c1);
+        constexpr uint8_t kSwapIndex[4] = {1, 0, 3, 2};
+        for (auto& index : indices) {
+            index = kSwapIndex[index];
+        }
+    } else if (c0 == c1) {
+        std::memset(indices, 0, sizeof(indices));
+    }
+    
+    uint32_t bits = 0;
+    for (int i = 0; i < kBlockPixels; ++i) {
+        bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+    }
+    out[0] = static_cast<uint8_t>(c0 & 0xff);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1 & 0xff);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    std::memcpy(out + 4, &bits, 4);
+}
+
+void DecodeColorBlock(const uint8_t in[8], bool allowThreeColor, BlockPixels& px) {
+    const uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+    const uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+    int palette[4][4];
+    BuildColorPalette(c0, c1, !allowThreeColor || c0 > c1, palette);
+    uint32_t bits = 0;
+    std::memcpy(&bits, in + 4, 4);
+    for (int i = 0; i < kBlockPixels; ++i) {
+        const int index = (bits >> (i * 2)) & 3;
+        for (int c = 0; c < 4; ++c) {
+            px[i][c] = static_cast<uint8_t>(palette[index][c]);
+        }
+    }
+}
+
+// ============================================================================
+// BC4 单通道块（BC3 Alpha / BC4 / BC5 共用）
+// ============================================================================
+
+void BuildScalarPalette(int v0, int v1, int palette[8]) {
+    palette[0] = v0;
+    palette[1] = v1;
+    if (v0 > v1) {
+        for (int i = 1; i < 7; ++i) {
+            palette[i + 1] = ((7 - i) * v0 + i * v1) / 7;
+        }
+    } else {
+        for (int i = 1; i < 5; ++i) {
+            palette[i + 1] = ((5 - i) * v0 + i * v1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+void EncodeScalarBlock(const BlockPixels& px, int channel, uint8_t out[8]) {
+    int lo = 255;
+    int hi = 0;
+    for (int i = 0; i < kBlockPixels; ++i) {
+        lo = std::min<int>(lo, px[i][channel]);
+        hi = std::max<int>(hi, px[i][channel]);
+    }
+    
+    uint64_t bits = 0;
+    if (hi > lo) {
+        // 8 级插值模式（v0 > v1）
+        int palette[8];
+        BuildScalarPalette(hi, lo, palette);
+        for (int i = 0; i < kBlockPixels; ++i) {
+            int best = 0;
+            int bestError = 256;
+            for (int p = 0; p < 8; ++p) {
+                const int error = std::abs(px[i][channel] - palette[p]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            bits |= static_cast<uint64_t>(best) << (i * 3);
+        }
+    }
+    
+    out[0] = static_cast<uint8_t>(hi);
+    out[1] = static_cast<uint8_t>(hi > lo ? lo : hi);
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<uint8_t>((bits >> (i * 8)) & 0xff);
+    }
+}
+
+void DecodeScalarBlock(const uint8_t in[8], int channel, BlockPixels& px) {
+    int palette[8];
+    BuildScalarPalette(in[0], in[1], palette);
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) {
+        bits |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < kBlockPixels; ++i) {
+        px[i][channel] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+    }
+}
+
+// ============================================================================
+// BC7 mode 6
+// ============================================================================
+
+/**
+ * @brief 小端位流写入器（BC7 块按最低位优先排列）
+ */
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* out) : m_out(out) { std::memset(m_out, 0, 16); }
+    
+    void Write(uint32_t value, int count) {
+        for (int i = 0; i < count; ++i, ++m_pos) {
+            if (value & (1u << i)) {
+                m_out[m_pos >> 3] |= static_cast<uint8_t>(1u << (m_pos & 7));
+            }
+        }
+    }
+
+private:
+    uint8_t* m_out;
+    int m_pos = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* in) : m_in(in) {}
+    
+    uint32_t Read(int count) {
+        uint32_t value = 0;
+        for (int i = 0; i < count; ++i, ++m_pos) {
+            value |= static_cast<uint32_t>((m_in[m_pos >> 3] >> (m_pos & 7)) & 1) << i;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* m_in;
+    int m_pos = 0;
+};
+
+/**
+ * @brief 将端点量化为 7 位 + 共享 P 位，选择误差更小的 P 位
+ */
+void QuantizeBC7Endpoint(const float endpoint[4], int quantized[4], int& pBit) {
+    float bestError = 1e30f;
+    for (int p = 0; p < 2; ++p) {
+        int candidate[4];
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            candidate[c] = std::clamp(static_cast<int>((endpoint[c] - p) * 0.5f + 0.5f), 0, 127);
+            const float diff = static_cast<float>(candidate[c] * 2 + p) - endpoint[c];
+            error += diff * diff;
+        }
+        if (error < bestError) {
+            bestError = error;
+            pBit = p;
+            std::memcpy(quantized, candidate, sizeof(candidate));
+        }
+    }
+}
+
+void BuildBC7Palette(const int q0[4], int p0, const int q1[4], int p1, int palette[16][4]) {
+    for (int c = 0; c < 4; ++c) {
+        const int e0 = q0[c] * 2 + p0;
+        const int e1 = q1[c] * 2 + p1;
+        for (int i = 0; i < 16; ++i) {
+            palette[i][c] = ((64 - kBC7Weights4[i]) * e0 + kBC7Weights4[i] * e1 + 32) >> 6;
+        }
+    }
+}
+
+int SelectBC7Indices(const BlockPixels& px, const int palette[16][4], uint8_t indices[kBlockPixels]) {
+    int totalError = 0;
+    for (int i = 0; i < kBlockPixels; ++i) {
+        int bestError = 0x7fffffff;
+        for (int p = 0; p < 16; ++p) {
+            int error = 0;
+            for (int c = 0; c < 4; ++c) {
+                const int diff = px[i][c] - palette[p][c];
+                error += diff * diff;
+            }
+            if (error < bestError) {
+                bestError = error;
+                indices[i] = static_cast<uint8_t>(p);
+            }
+        }
+        totalError += bestError;
+    }
+    return totalError;
+}
+
+void EncodeBC7Block(const BlockPixels& px, uint8_t out[16]) {
+    float lo[4];
+    float hi[4];
+    InitialEndpoints<4>(px, lo, hi);
+    
+    int q0[4], q1[4], p0 = 0, p1 = 0;
+    QuantizeBC7Endpoint(lo, q0, p0);
+    QuantizeBC7Endpoint(hi, q1, p1);
+    int palette[16][4];
+    BuildBC7Palette(q0, p0, q1, p1, palette);
+    uint8_t indices[kBlockPixels];
+    int error = SelectBC7Indices(px, palette, indices);
+    
+    // 最小二乘端点优化（误差不再下降时提前结束）
+    for (int iteration = 0; iteration < kBC7RefineIterations && error > 0; ++iteration) {
+        float weights[kBlockPixels];
+        for (int i = 0; i < kBlockPixels; ++i) {
+            weights[i] = kBC7Weights4[indices[i]] / 64.0f;
+        }
+        float a[4];
+        float b[4];
+        if (!LeastSquaresEndpoints<4>(px, weights, a, b)) {
+            break;
+        }
+        int r0[4], r1[4], rp0 = 0, rp1 = 0;
+        QuantizeBC7Endpoint(a, r0, rp0);
+        QuantizeBC7Endpoint(b, r1, rp1);
+        int refinedPalette[16][4];
+        BuildBC7Palette(r0, rp0, r1, rp1, refinedPalette);
+        uint8_t refined[kBlockPixels];
+        const int refinedError = SelectBC7Indices(px, refinedPalette, refined);
+        if (refinedError >= error) {
+            break;
+        }
+        std::memcpy(q0, r0, sizeof(q0));
+        std::memcpy(q1, r1, sizeof(q1));
+        p0 = rp0;
+        p1 = rp1;
+        error = refinedError;
+        std::memcpy(indices, refined, sizeof(indices));
+    }
+    
+    // 锚点索引（第 0 个像素）最高位隐含为 0：必要时交换端点并反转索引
+    if (indices[0] & 8) {
+        std::swap(q0, q1);
+        std::swap(p0, p1);
+        for (auto& index : indices) {
+            index = static_cast<uint8_t>(15 - index);
+        }
+    }
+    
+    BitWriter writer(out);
+    writer.Write(1u << 6, 7);   // mode 6：6 个 0 位后跟 1
+    for (int c = 0; c < 4; ++c) {
+        writer.Write(static_cast<uint32_t>(q0[c]), 7);
+        writer.Write(static_cast<uint32_t>(q1[c]), 7);
+    }
+    writer.Write(static_cast<uint32_t>(p0), 1);
+    writer.Write(static_cast<uint32_t>(p1), 1);
+    writer.Write(indices[0], 3);
+    for (int i = 1; i < kBlockPixels; ++i) {
+        writer.Write(indices[i], 4);
+    }
+}
+
+bool DecodeBC7Block(const uint8_t in[16], BlockPixels& px) {
+    if ((in[0] & 0x7f) != 0x40) {
+        // 非 mode 6 块：输出品红色以便发现问题
+        for (auto& pixel : px) {
+            pixel[0] = 255; pixel[1] = 0; pixel[2] = 255; pixel[3] = 255;
+        }
+        return false;
+    }
+    
+    BitReader reader(in);
+    reader.Read(7);
+    int q0[4], q1[4];
+    for (int c = 0; c < 4; ++c) {
+        q0[c] = static_cast<int>(reader.Read(7));
+        q1[c] = static_cast<int>(reader.Read(7));
+    }
+    const int p0 = static_cast<int>(reader.Read(1));
+    const int p1 = static_cast<int>(reader.Read(1));
+    int palette[16][4];
+    BuildBC7Palette(q0, p0, q1, p1, palette);
+    for (int i = 0; i < kBlockPixels; ++i) {
+        const uint32_t index = reader.Read(i == 0 ? 3 : 4);
+        for (int c = 0; c < 4; ++c) {
+            px[i][c] = static_cast<uint8_t>(palette[index][c]);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// 格式信息
+// ============================================================================
+
+bool TextureCompressor::IsBlockCompressed(TextureFormat format) {
+    return GetBytesPerBlock(format) != 0;
+}
+
+size_t TextureCompressor::GetBytesPerBlock(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::BC1:
+        case TextureFormat::BC4:
+            return 8;
+        case TextureFormat::BC3:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+size_t TextureCompressor::GetLevelSize(TextureFormat format, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+    const size_t blockBytes = GetBytesPerBlock(format);
+    if (blockBytes != 0) {
+        const size_t blocksX = (static_cast<size_t>(width) + 3) / 4;
+        const size_t blocksY = (static_cast<size_t>(height) + 3) / 4;
+        return blocksX * blocksY * blockBytes;
+    }
+    
+    size_t bytesPerPixel = 4;
+    switch (format) {
+        case TextureFormat::RGB: bytesPerPixel = 3; break;
+        case TextureFormat::RED: bytesPerPixel = 1; break;
+        case TextureFormat::RG:  bytesPerPixel = 2; break;
+        default: break;
+    }
+    return static_cast<size_t>(width) * static_cast<size_t>(height) * bytesPerPixel;
+}
+
+int TextureCompressor::GetMipLevelCount(int width, int height) {
+    int levels = 1;
+    int size = std::max(width, height);
+    while (size > 1) {
+        size >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+// ============================================================================
+// Mip 链
+// ============================================================================
+
+void TextureCompressor::GenerateMipChain(const uint8_t* rgba, int width, int height,
+                                         std::vector<uint8_t>& outPixels,
+                                         std::vector<TextureMipLevel>& outLevels) {
+    outPixels.clear();
+    outLevels.clear();
+    if (!rgba || width <= 0 || height <= 0) {
+        return;
+    }
+    
+    const int levelCount = GetMipLevelCount(width, height);
+    size_t totalBytes = 0;
+    for (int level = 0, w = width, h = height; level < levelCount; ++level) {
+        TextureMipLevel mip;
+        mip.width = w;
+        mip.height = h;
+        mip.offset = totalBytes;
+        mip.size = static_cast<size_t>(w) * h * 4;
+        totalBytes += mip.size;
+        outLevels.push_back(mip);
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    
+    outPixels.resize(totalBytes);
+    std::memcpy(outPixels.data(), rgba, outLevels[0].size);
+    
+    for (int level = 1; level < levelCount; ++level) {
+        const TextureMipLevel& src = outLevels[level - 1];
+        const TextureMipLevel& dst = outLevels[level];
+        const uint8_t* srcPixels = outPixels.data() + src.offset;
+        uint8_t* dstPixels = outPixels.data() + dst.offset;
+        
+        for (int y = 0; y < dst.height; ++y) {
+            const int y0 = std::min(y * 2, src.height - 1);
+            const int y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x) {
+                const int x0 = std::min(x * 2, src.width - 1);
+                const int x1 = std::min(x * 2 + 1, src.width - 1);
+                const uint8_t* s00 = srcPixels + (static_cast<size_t>(y0) * src.width + x0) * 4;
+                const uint8_t* s01 = srcPixels + (static_cast<size_t>(y0) * src.width + x1) * 4;
+                const uint8_t* s10 = srcPixels + (static_cast<size_t>(y1) * src.width + x0) * 4;
+                const uint8_t* s11 = srcPixels + (static_cast<size_t>(y1) * src.width + x1) * 4;
+                uint8_t* d = dstPixels + (static_cast<size_t>(y) * dst.width + x) * 4;
+                for (int c = 0; c < 4; ++c) {
+                    d[c] = static_cast<uint8_t>((s00[c] + s01[c] + s10[c] + s11[c] + 2) / 4);
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// 编码 / 解码
+// ============================================================================
+
+bool TextureCompressor::EncodeLevel(TextureFormat format, const uint8_t* rgba, int width, int height, uint8_t* out) {
+    const size_t blockBytes = GetBytesPerBlock(format);
+    if (blockBytes == 0 || !rgba || !out || width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    const int blocksX = (width + 3) / 4;
+    const int blocksY = (height + 3) / 4;
+    BlockPixels block;
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            FetchBlock(rgba, width, height, bx, by, block);
+            uint8_t* dst = out + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+            switch (format) {
+                case TextureFormat::BC1:
+                    EncodeColorBlock(block, dst);
+                    break;
+                case TextureFormat::BC3:
+                    EncodeScalarBlock(block, 3, dst);
+                    EncodeColorBlock(block, dst + 8);
+                    break;
+                case TextureFormat::BC4:
+                    EncodeScalarBlock(block, 0, dst);
+                    break;
+                case TextureFormat::BC5:
+                    EncodeScalarBlock(block, 0, dst);
+                    EncodeScalarBlock(block, 1, dst + 8);
+                    break;
+                case TextureFormat::BC7:
+                    EncodeBC7Block(block, dst);
+                    break;
+                default:
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool TextureCompressor::DecodeLevel(TextureFormat format, const uint8_t* data, int width, int height, uint8_t* outRgba) {
+    const size_t blockBytes = GetBytesPerBlock(format);
+    if (blockBytes == 0 || !data || !outRgba || width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    bool allValid = true;
+    const int blocksX = (width + 3) / 4;
+    const int blocksY = (height + 3) / 4;
+    BlockPixels block;
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            const uint8_t* src = data + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+            switch (format) {
+                case TextureFormat::BC1:
+                    DecodeColorBlock(src, true, block);
+                    break;
+                case TextureFormat::BC3:
+                    DecodeColorBlock(src + 8, false, block);
+                    DecodeScalarBlock(src, 3, block);
+                    break;
+                case TextureFormat::BC4:
+                    DecodeScalarBlock(src, 0, block);
+                    for (auto& pixel : block) {
+                        pixel[1] = pixel[2] = 0;
+                        pixel[3] = 255;
+                    }
+                    break;
+                case TextureFormat::BC5:
+                    DecodeScalarBlock(src, 0, block);
+                    DecodeScalarBlock(src + 8, 1, block);
+                    for (auto& pixel : block) {
+                        pixel[2] = 0;
+                        pixel[3] = 255;
+                    }
+                    break;
+                case TextureFormat::BC7:
+                    allValid = DecodeBC7Block(src, block) && allValid;
+                    break;
+                default:
+                    return false;
+            }
+            StoreBlock(outRgba, width, height, bx, by, block);
+        }
+    }
+    return allValid;
+}
+
+bool TextureCompressor::IsOpaque(const uint8_t* rgba, int width, int height) {
+    const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        if (rgba[i * 4 + 3] != 255) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TextureFormat TextureCompressor::SelectFormat(const TextureCompressionOptions& options,
+                                              const uint8_t* rgba, int width, int height) {
+    if (options.autoSelectFormat &&
+        (options.format == TextureFormat::BC3 || options.format == TextureFormat::BC7) &&
+        IsOpaque(rgba, width, height)) {
+        return TextureFormat::BC1;
+    }
+    return options.format;
+}
+
+bool TextureCompressor::Compress(const uint8_t* rgba, int width, int height,
+                                 TextureFormat format, bool generateMipmaps,
+                                 std::vector<uint8_t>& outData,
+                                 std::vector<TextureMipLevel>& outLevels) {
+    outData.clear();
+    outLevels.clear();
+    if (!IsBlockCompressed(format) || !rgba || width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    std::vector<uint8_t> chainPixels;
+    std::vector<TextureMipLevel> chainLevels;
+    if (generateMipmaps) {
+        GenerateMipChain(rgba, width, height, chainPixels, chainLevels);
+    } else {
+        chainLevels.push_back({width, height, 0, static_cast<size_t>(width) * height * 4});
+    }
+    const uint8_t* chainBase = generateMipmaps ? chainPixels.data() : rgba;
+    
+    size_t totalBytes = 0;
+    outLevels.reserve(chainLevels.size());
+    for (const auto& level : chainLevels) {
+        TextureMipLevel compressed;
+        compressed.width = level.width;
+        compressed.height = level.height;
+        compressed.offset = totalBytes;
+        compressed.size = GetLevelSize(format, level.width, level.height);
+        totalBytes += compressed.size;
+        outLevels.push_back(compressed);
+    }
+    
+    outData.resize(totalBytes);
+    for (size_t i = 0; i < chainLevels.size(); ++i) {
+        EncodeLevel(format, chainBase + chainLevels[i].offset,
+                    chainLevels[i].width, chainLevels[i].height,
+                    outData.data() + outLevels[i].offset);
+    }
+    return true;
+}
+
+} // namespace Render
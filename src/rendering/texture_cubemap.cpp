@@ -34,8 +34,11 @@ TextureCubemap::TextureCubemap()
     , m_resolution(0)
     , m_format(TextureFormat::RGBA)
     , m_hasMipmap(false)
+    , m_isHDR(false)
+    , m_hasIrradianceSH(false)
     , m_faceLoaded(6, false)
 {
+    m_irradianceSH.fill(Vector3::Zero());
 }
 
 TextureCubemap::~TextureCubemap() {
@@ -49,11 +52,16 @@ TextureCubemap::TextureCubemap(TextureCubemap&& other) noexcept {
     m_resolution = other.m_resolution;
     m_format = other.m_format;
     m_hasMipmap = other.m_hasMipmap;
+    m_isHDR = other.m_isHDR;
+    m_hasIrradianceSH = other.m_hasIrradianceSH;
+    m_irradianceSH = other.m_irradianceSH;
     m_faceLoaded = std::move(other.m_faceLoaded);
     
     other.m_textureID = 0;
     other.m_resolution = 0;
     other.m_hasMipmap = false;
+    other.m_isHDR = false;
+    other.m_hasIrradianceSH = false;
     other.m_faceLoaded = std::vector<bool>(6, false);
 }
 
@@ -73,11 +81,16 @@ TextureCubemap& TextureCubemap::operator=(TextureCubemap&& other) noexcept {
         m_resolution = other.m_resolution;
         m_format = other.m_format;
         m_hasMipmap = other.m_hasMipmap;
+        m_isHDR = other.m_isHDR;
+        m_hasIrradianceSH = other.m_hasIrradianceSH;
+        m_irradianceSH = other.m_irradianceSH;
         m_faceLoaded = std::move(other.m_faceLoaded);
 
         other.m_textureID = 0;
         other.m_resolution = 0;
         other.m_hasMipmap = false;
+        other.m_isHDR = false;
+        other.m_hasIrradianceSH = false;
         other.m_faceLoaded = std::vector<bool>(6, false);
     }
     return *this;
@@ -114,6 +127,8 @@ bool TextureCubemap::LoadFromFiles(const std::vector<std::string>& filepaths, bo
     m_resolution = 0;
     m_format = TextureFormat::RGBA;
     m_hasMipmap = false;
+    m_isHDR = false;
+    m_hasIrradianceSH = false;
     std::fill(m_faceLoaded.begin(), m_faceLoaded.end(), false);
 
     // 创建OpenGL立方体贴图
@@ -299,12 +314,102 @@ bool TextureCubemap::LoadFaceFromFile(CubemapFace face, const std::string& filep
 }
 
 bool TextureCubemap::LoadFromHDRI(const std::string& hdriPath, int resolution, bool generateMipmap) {
-    // TODO: 实现HDRI加载
-    // 需要集成stb_image库来加载HDR文件
-    // 然后使用等距柱状投影到立方体贴图的转换着色器
-    HANDLE_ERROR(RENDER_ERROR(ErrorCode::NotImplemented,
-                             "TextureCubemap::LoadFromHDRI: HDRI加载功能尚未实现，需要stb_image库支持"));
-    return false;
+    HDRCubemapOptions options;
+    options.resolution = resolution;
+    return LoadFromHDRI(hdriPath, options, generateMipmap);
+}
+
+bool TextureCubemap::LoadFromHDRI(const std::string& hdriPath, const HDRCubemapOptions& options, bool generateMipmap) {
+    HDRCubemapData data;
+    std::string error;
+    if (!HDRIConverter::LoadFromFile(hdriPath, options, data, &error)) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::ResourceLoadFailed,
+                                 "TextureCubemap::LoadFromHDRI: 加载HDRI失败: " + error));
+        return false;
+    }
+    return CreateFromHDRData(data, generateMipmap);
+}
+
+bool TextureCubemap::CreateFromHDRData(const HDRCubemapData& data, bool generateMipmap) {
+    if (!data.IsValid()) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidArgument,
+                                 "TextureCubemap::CreateFromHDRData: 无效的HDRI转换结果"));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 释放旧立方体贴图
+    GL_THREAD_CHECK();
+    if (m_textureID != 0) {
+        glDeleteTextures(1, &m_textureID);
+        m_textureID = 0;
+    }
+    std::fill(m_faceLoaded.begin(), m_faceLoaded.end(), false);
+
+    glGenTextures(1, &m_textureID);
+    if (m_textureID == 0) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::ResourceLoadFailed,
+                                 "TextureCubemap::CreateFromHDRData: 无法生成立方体贴图ID"));
+        return false;
+    }
+
+    glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // 浮点数据按 RGBA16F 存储（显存减半，驱动负责 float → half 转换）
+    for (size_t level = 0; level < data.levels.size(); ++level) {
+        const int levelResolution = data.levels[level].resolution;
+        for (int face = 0; face < 6; ++face) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, static_cast<GLint>(level), GL_RGBA16F,
+                         levelResolution, levelResolution, 0, GL_RGBA, GL_FLOAT, data.GetFace(level, face));
+        }
+    }
+
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        Logger::GetInstance().Error("CreateFromHDRData: glTexImage2D 失败，OpenGL 错误: " + std::to_string(err));
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        glDeleteTextures(1, &m_textureID);
+        m_textureID = 0;
+        m_resolution = 0;
+        return false;
+    }
+
+    bool hasMipmap = false;
+    if (data.prefiltered) {
+        // 预过滤 mip 链可能短于完整链，限制最大级别保证纹理完整
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(data.levels.size() - 1));
+        hasMipmap = true;
+    } else {
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 1000);
+        if (generateMipmap) {
+            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+            hasMipmap = true;
+        }
+    }
+
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, hasMipmap ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    m_resolution = data.resolution;
+    m_format = TextureFormat::RGBA;
+    m_hasMipmap = hasMipmap;
+    m_isHDR = true;
+    m_hasIrradianceSH = data.hasIrradianceSH;
+    m_irradianceSH = data.irradianceSH;
+    std::fill(m_faceLoaded.begin(), m_faceLoaded.end(), true);
+
+    Logger::GetInstance().Debug("从HDRI创建立方体贴图: " + std::to_string(data.resolution) + "x" +
+                 std::to_string(data.resolution) + "，级别数: " + std::to_string(data.levels.size()));
+
+    return true;
 }
 
 bool TextureCubemap::CreateFaceFromData(CubemapFace face, const void* data, int width, int height,
@@ -317,6 +422,12 @@ bool TextureCubemap::CreateFaceFromData(CubemapFace face, const void* data, int
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    if (m_isHDR) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidState,
+                                 "TextureCubemap::CreateFaceFromData: 浮点立方体贴图不能用 8 位数据替换单个面"));
+        return false;
+    }
+
     // 如果是第一个面，设置分辨率；否则检查分辨率是否一致
     if (m_resolution == 0) {
         m_resolution = width;
@@ -398,6 +509,8 @@ bool TextureCubemap::CreateEmpty(int resolution, TextureFormat format) {
     m_resolution = resolution;
     m_format = format;
     m_hasMipmap = false;
+    m_isHDR = false;
+    m_hasIrradianceSH = false;
     std::fill(m_faceLoaded.begin(), m_faceLoaded.end(), false);
 
     GL_THREAD_CHECK();
@@ -529,9 +642,26 @@ void TextureCubemap::Release() {
 
     m_resolution = 0;
     m_hasMipmap = false;
+    m_isHDR = false;
+    m_hasIrradianceSH = false;
     std::fill(m_faceLoaded.begin(), m_faceLoaded.end(), false);
 }
 
+bool TextureCubemap::IsHDR() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isHDR;
+}
+
+bool TextureCubemap::HasIrradianceSH() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hasIrradianceSH;
+}
+
+std::array<Vector3, 9> TextureCubemap::GetIrradianceSH() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_irradianceSH;
+}
+
 bool TextureCubemap::IsComplete() const {
     std::lock_guard<std::mutex> lock(m_mutex);
     return std::all_of(m_faceLoaded.begin(), m_faceLoaded.end(), [](bool loaded) { return loaded; });
@@ -612,6 +742,12 @@ size_t TextureCubemap::GetMemoryUsage() const {
         case TextureFormat::DepthStencil:
             bytesPerPixel = 4;
             break;
+        default:
+            bytesPerPixel = 4;
+            break;
+    }
+    if (m_isHDR) {
+        bytesPerPixel = 8;  // GL_RGBA16F
     }
     
     // 立方体贴图有6个面
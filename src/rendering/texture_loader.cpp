@@ -19,6 +19,9 @@
  * For commercial licensing, please contact: 2052046346@qq.com
  */
 #include "render/texture_loader.h"
+#include "render/texture_cache.h"
+#include "render/texture_streamer.h"
+#include "render/file_utils.h"
 #include "render/logger.h"
 #include "render/error.h"
 #include "render/gl_thread_checker.h"
@@ -29,11 +32,57 @@
 
 namespace Render {
 
+namespace {
+
+/**
+ * @brief 将压缩 staging 数据在 CPU 端解码为 RGBA8 mip 链（GPU 不支持该压缩格式时的回退）
+ */
+bool DecompressStagingData(TextureLoader::TextureStagingData& staging) {
+    std::vector<std::uint8_t> pixels;
+    std::vector<TextureMipLevel> levels;
+    size_t offset = 0;
+    for (const auto& level : staging.mipLevels) {
+        TextureMipLevel decoded;
+        decoded.width = level.width;
+        decoded.height = level.height;
+        decoded.offset = offset;
+        decoded.size = static_cast<size_t>(level.width) * level.height * 4;
+        offset += decoded.size;
+        levels.push_back(decoded);
+    }
+    
+    pixels.resize(offset);
+    for (size_t i = 0; i < levels.size(); ++i) {
+        if (!TextureCompressor::DecodeLevel(staging.format, staging.pixels.data() + staging.mipLevels[i].offset,
+                                            levels[i].width, levels[i].height,
+                                            pixels.data() + levels[i].offset)) {
+            return false;
+        }
+    }
+    
+    staging.pixels = std::move(pixels);
+    staging.mipLevels = std::move(levels);
+    staging.format = TextureFormat::RGBA;
+    return true;
+}
+
+} // namespace
+
 TextureLoader& TextureLoader::GetInstance() {
     static TextureLoader instance;
     return instance;
 }
 
+void TextureLoader::SetCompressionOptions(const TextureCompressionOptions& options) {
+    std::lock_guard<std::mutex> lock(m_optionsMutex);
+    m_compressionOptions = options;
+}
+
+TextureCompressionOptions TextureLoader::GetCompressionOptions() const {
+    std::lock_guard<std::mutex> lock(m_optionsMutex);
+    return m_compressionOptions;
+}
+
 bool TextureLoader::DecodeTextureToStaging(const std::string& filepath,
                                            bool generateMipmap,
                                            TextureStagingData* outData,
@@ -45,6 +94,27 @@ bool TextureLoader::DecodeTextureToStaging(const std::string& filepath,
         return false;
     }
 
+    const TextureCompressionOptions compression = GetCompressionOptions();
+    const bool compress = compression.enabled && TextureCompressor::IsBlockCompressed(compression.format);
+    const bool useDiskCache = compress && compression.useDiskCache && TextureCache::GetInstance().IsEnabled();
+    
+    // 压缩缓存命中时直接使用预编码数据，跳过图像解码、mip 生成与块编码
+    uint64_t cacheKey = 0;
+    if (useDiskCache) {
+        const uint64_t sourceHash = FileUtils::HashFile(filepath);
+        if (sourceHash != 0) {
+            cacheKey = TextureCache::BuildKey(sourceHash, compression, generateMipmap);
+            TextureFormat cachedFormat = TextureFormat::RGBA;
+            if (TextureCache::GetInstance().Load(cacheKey, cachedFormat, outData->pixels, outData->mipLevels)) {
+                outData->width = outData->mipLevels[0].width;
+                outData->height = outData->mipLevels[0].height;
+                outData->format = cachedFormat;
+                outData->generateMipmap = generateMipmap;
+                return true;
+            }
+        }
+    }
+
     SDL_Surface* surface = IMG_Load(filepath.c_str());
     if (!surface) {
         std::string message = "TextureLoader: 无法读取纹理文件: " + filepath +
@@ -94,6 +164,7 @@ bool TextureLoader::DecodeTextureToStaging(const std::string& filepath,
     outData->height = height;
     outData->format = TextureFormat::RGBA;
     outData->generateMipmap = generateMipmap;
+    outData->mipLevels.clear();
 
     const std::uint8_t* src = static_cast<const std::uint8_t*>(surface->pixels);
     std::uint8_t* dst = outData->pixels.data();
@@ -108,6 +179,22 @@ bool TextureLoader::DecodeTextureToStaging(const std::string& filepath,
     }
 
     SDL_DestroySurface(surface);
+    
+    if (compress) {
+        const TextureFormat format = TextureCompressor::SelectFormat(
+            compression, outData->pixels.data(), width, height);
+        std::vector<std::uint8_t> compressed;
+        std::vector<TextureMipLevel> levels;
+        if (TextureCompressor::Compress(outData->pixels.data(), width, height,
+                                        format, generateMipmap, compressed, levels)) {
+            outData->pixels = std::move(compressed);
+            outData->mipLevels = std::move(levels);
+            outData->format = format;
+            if (cacheKey != 0) {
+                TextureCache::GetInstance().Store(cacheKey, format, outData->pixels, outData->mipLevels);
+            }
+        }
+    }
     return true;
 }
 
@@ -141,12 +228,68 @@ TexturePtr TextureLoader::LoadTexture(const std::string& name,
     return UploadStagedTexture(name, std::move(staging));
 }
 
+TexturePtr TextureLoader::LoadStreamingTexture(const std::string& name, const std::string& filepath) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_textures.find(name);
+        if (it != m_textures.end()) {
+            return it->second;
+        }
+    }
+    
+    Logger::GetInstance().Info("加载流式纹理: " + name + " (路径: " + filepath + ")");
+    
+    TextureStagingData staging;
+    std::string errorMessage;
+    if (!DecodeTextureToStaging(filepath, true, &staging, &errorMessage)) {
+        if (errorMessage.empty()) {
+            errorMessage = "TextureLoader: 加载流式纹理失败: " + name;
+        }
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::TextureUploadFailed, errorMessage));
+        return nullptr;
+    }
+    
+    GL_THREAD_CHECK();
+    
+    // 流式加载需要完整的 CPU 端 mip 链：未压缩时在此生成，压缩格式不受支持时解码为 RGBA8
+    if (staging.mipLevels.empty()) {
+        std::vector<std::uint8_t> pixels;
+        std::vector<TextureMipLevel> levels;
+        TextureCompressor::GenerateMipChain(staging.pixels.data(), staging.width, staging.height, pixels, levels);
+        staging.pixels = std::move(pixels);
+        staging.mipLevels = std::move(levels);
+    } else if (TextureCompressor::IsBlockCompressed(staging.format) &&
+               !Texture::IsFormatSupported(staging.format)) {
+        if (!DecompressStagingData(staging)) {
+            HANDLE_ERROR(RENDER_ERROR(ErrorCode::TextureUploadFailed, "TextureLoader: 压缩纹理解码失败"));
+            return nullptr;
+        }
+    }
+    
+    auto texture = std::make_shared<Texture>();
+    if (!TextureStreamer::GetInstance().Register(texture, std::move(staging.pixels),
+                                                 std::move(staging.mipLevels), staging.format)) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::TextureUploadFailed, "TextureLoader: 流式纹理上传失败: " + name));
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto [it, inserted] = m_textures.emplace(name, texture);
+    if (!inserted) {
+        TextureStreamer::GetInstance().Unregister(texture.get());
+    }
+    return it->second;
+}
+
 TexturePtr TextureLoader::UploadStagedTexture(const std::string& name,
                                               TextureStagingData&& stagingData) {
-    if (!stagingData.IsValid()) {
+    if (!stagingData.IsValid() || stagingData.pixelBuffer.IsValid()) {
         HANDLE_ERROR(RENDER_ERROR(
             ErrorCode::InvalidArgument,
-            "TextureLoader: 上传失败，staging 数据无效"));
+            stagingData.pixelBuffer.IsValid()
+                ? "TextureLoader: PBO staging 数据须通过 BeginStagedUpload 上传"
+                : "TextureLoader: 上传失败，staging 数据无效"));
+        TextureUploadQueue::GetInstance().ReleaseStagingBuffer(stagingData.pixelBuffer);
         return nullptr;
     }
 
@@ -162,13 +305,33 @@ TexturePtr TextureLoader::UploadStagedTexture(const std::string& name,
 
     GL_THREAD_CHECK();
 
+    if (!stagingData.mipLevels.empty() &&
+        TextureCompressor::IsBlockCompressed(stagingData.format) &&
+        !Texture::IsFormatSupported(stagingData.format)) {
+        Logger::GetInstance().Warning("TextureLoader: GPU 不支持压缩格式 " +
+                                      std::to_string(static_cast<int>(stagingData.format)) +
+                                      "，回退为 RGBA8 上传");
+        if (!DecompressStagingData(stagingData)) {
+            HANDLE_ERROR(RENDER_ERROR(
+                ErrorCode::TextureUploadFailed,
+                "TextureLoader: 压缩纹理解码失败"));
+            return nullptr;
+        }
+    }
+
     auto texture = std::make_shared<Texture>();
-    if (!texture->CreateFromData(
-            stagingData.pixels.data(),
-            stagingData.width,
-            stagingData.height,
-            stagingData.format,
-            stagingData.generateMipmap)) {
+    const bool created = stagingData.mipLevels.empty()
+        ? texture->CreateFromData(
+              stagingData.pixels.data(),
+              stagingData.width,
+              stagingData.height,
+              stagingData.format,
+              stagingData.generateMipmap)
+        : texture->CreateFromMipLevels(
+              stagingData.pixels.data(),
+              stagingData.mipLevels,
+              stagingData.format);
+    if (!created) {
         HANDLE_ERROR(RENDER_ERROR(
             ErrorCode::TextureUploadFailed,
             "TextureLoader: 纹理上传失败"));
@@ -189,6 +352,128 @@ TexturePtr TextureLoader::UploadStagedTexture(const std::string& name,
     return texture;
 }
 
+bool TextureLoader::StageToPixelBuffer(TextureStagingData& stagingData) {
+    TextureUploadQueue& queue = TextureUploadQueue::GetInstance();
+    if (!queue.GetOptions().usePixelBuffers || stagingData.pixelBuffer.IsValid() || !stagingData.IsValid()) {
+        return false;
+    }
+    
+    // 不受支持的压缩格式需要在 GL 线程解码回退，保留 CPU 数据
+    // （IsFormatSupported 只读取 glad 加载时设置的标志，可在工作线程调用）
+    if (TextureCompressor::IsBlockCompressed(stagingData.format) &&
+        !Texture::IsFormatSupported(stagingData.format)) {
+        return false;
+    }
+    
+    if (stagingData.mipLevels.empty()) {
+        if (stagingData.generateMipmap && stagingData.format == TextureFormat::RGBA) {
+            std::vector<std::uint8_t> chainPixels;
+            std::vector<TextureMipLevel> chainLevels;
+            TextureCompressor::GenerateMipChain(stagingData.pixels.data(),
+                                                stagingData.width, stagingData.height,
+                                                chainPixels, chainLevels);
+            stagingData.pixels = std::move(chainPixels);
+            stagingData.mipLevels = std::move(chainLevels);
+        } else if (!stagingData.generateMipmap) {
+            TextureMipLevel base;
+            base.width = stagingData.width;
+            base.height = stagingData.height;
+            base.size = TextureCompressor::GetLevelSize(stagingData.format, stagingData.width, stagingData.height);
+            if (base.size > stagingData.pixels.size()) {
+                return false;
+            }
+            stagingData.mipLevels.push_back(base);
+        } else {
+            return false;
+        }
+    }
+    
+    TextureStagingBuffer buffer = queue.AcquireStagingBuffer(stagingData.pixels.size());
+    if (!buffer.IsValid()) {
+        return false;
+    }
+    
+    std::memcpy(buffer.data, stagingData.pixels.data(), stagingData.pixels.size());
+    queue.FinishStagingWrite(buffer);
+    stagingData.pixelBuffer = buffer;
+    std::vector<std::uint8_t>().swap(stagingData.pixels);
+    return true;
+}
+
+TexturePtr TextureLoader::BeginStagedUpload(const std::string& name,
+                                            TextureStagingData&& stagingData,
+                                            TextureUploadTicket& outTicket) {
+    outTicket = kInvalidUploadTicket;
+    TextureUploadQueue& queue = TextureUploadQueue::GetInstance();
+    
+    if (!stagingData.IsValid()) {
+        HANDLE_ERROR(RENDER_ERROR(
+            ErrorCode::InvalidArgument,
+            "TextureLoader: 上传失败，staging 数据无效"));
+        return nullptr;
+    }
+
+    if (!name.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_textures.find(name);
+        if (it != m_textures.end()) {
+            Logger::GetInstance().Info("纹理 '" + name + "' 已缓存，跳过上传");
+            queue.ReleaseStagingBuffer(stagingData.pixelBuffer);
+            return it->second;
+        }
+    }
+    
+    if (!stagingData.pixelBuffer.IsValid() &&
+        (stagingData.mipLevels.empty() || !queue.GetOptions().usePixelBuffers ||
+         (TextureCompressor::IsBlockCompressed(stagingData.format) &&
+          !Texture::IsFormatSupported(stagingData.format)))) {
+        return UploadStagedTexture(name, std::move(stagingData));
+    }
+
+    GL_THREAD_CHECK();
+
+    // 只分配各级别存储，数据由 TextureUploadQueue 分帧写入
+    auto texture = std::make_shared<Texture>();
+    if (!texture->CreateFromMipLevels(nullptr, stagingData.mipLevels, stagingData.format)) {
+        queue.ReleaseStagingBuffer(stagingData.pixelBuffer);
+        HANDLE_ERROR(RENDER_ERROR(
+            ErrorCode::TextureUploadFailed,
+            "TextureLoader: 分配纹理存储失败"));
+        return nullptr;
+    }
+    
+    outTicket = queue.Submit(texture,
+                             std::move(stagingData.pixels),
+                             std::move(stagingData.mipLevels),
+                             stagingData.format,
+                             stagingData.pixelBuffer);
+    stagingData.pixelBuffer = TextureStagingBuffer{};
+    if (outTicket == kInvalidUploadTicket) {
+        HANDLE_ERROR(RENDER_ERROR(
+            ErrorCode::TextureUploadFailed,
+            "TextureLoader: 提交分帧上传失败"));
+        return nullptr;
+    }
+    
+    return texture;
+}
+
+TexturePtr TextureLoader::FinishStagedUpload(const std::string& name, const TexturePtr& texture) {
+    if (name.empty() || !texture) {
+        return texture;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto [it, inserted] = m_textures.emplace(name, texture);
+    if (!inserted) {
+        Logger::GetInstance().Info("纹理 '" + name + "' 在上传过程中被其他线程缓存");
+        return it->second;
+    }
+
+    Logger::GetInstance().Info("纹理 '" + name + "' 分帧上传完成并加入缓存");
+    return texture;
+}
+
 TexturePtr TextureLoader::CreateTexture(const std::string& name,
                                        const void* data,
                                        int width,
@@ -336,12 +621,7 @@ void TextureLoader::PrintStatistics() const {
     // 计算总内存使用（内部实现，避免重复加锁）
     size_t totalBytes = 0;
     for (const auto& pair : m_textures) {
-        const TexturePtr& texture = pair.second;
-        int width = texture->GetWidth();
-        int height = texture->GetHeight();
-        size_t baseSize = width * height * 4;
-        size_t totalSize = baseSize * 4 / 3; // 包含 Mipmap
-        totalBytes += totalSize;
+        totalBytes += pair.second->GetMemoryUsage();   // 按实际格式与 mip 级别计算
     }
     
     Logger::GetInstance().Info("========================================");
@@ -362,7 +642,7 @@ void TextureLoader::PrintStatistics() const {
             long refCount = pair.second.use_count();
             int width = texture->GetWidth();
             int height = texture->GetHeight();
-            size_t memSize = width * height * 4; // 估算为 RGBA
+            size_t memSize = texture->GetMemoryUsage();
             
             Logger::GetInstance().Info("  - " + name + ": " + 
                         std::to_string(width) + "x" + std::to_string(height) + 
@@ -428,18 +708,8 @@ size_t TextureLoader::GetTotalMemoryUsage() const {
     size_t totalBytes = 0;
     
     for (const auto& pair : m_textures) {
-        const TexturePtr& texture = pair.second;
-        int width = texture->GetWidth();
-        int height = texture->GetHeight();
-        
-        // 估算内存使用（假设 RGBA 格式）
-        size_t baseSize = width * height * 4;
-        
-        // 如果有 Mipmap，增加约 1/3 的内存
-        // Mipmap 链: 原始 + 1/4 + 1/16 + ... ≈ 原始 * 1.33
-        size_t totalSize = baseSize * 4 / 3;
-        
-        totalBytes += totalSize;
+        // 按纹理实际格式计算（块压缩格式按块大小，含 mip 链）
+        totalBytes += pair.second->GetMemoryUsage();
     }
     
     return totalBytes;
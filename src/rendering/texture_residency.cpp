@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/texture_residency.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <tuple>
+
+namespace Render {
+
+TextureResidencyHandle TextureResidencyManager::Register(const std::vector<TextureMipLevel>& levels) {
+    if (levels.empty()) {
+        return kInvalidResidencyHandle;
+    }
+    
+    TextureResidencyHandle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = static_cast<TextureResidencyHandle>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    
+    Slot& slot = m_slots[handle];
+    slot = Slot{};
+    slot.active = true;
+    
+    const int levelCount = static_cast<int>(levels.size());
+    slot.chainBytes.assign(static_cast<size_t>(levelCount) + 1, 0);
+    for (int i = levelCount - 1; i >= 0; --i) {
+        slot.chainBytes[i] = slot.chainBytes[i + 1] + levels[i].size;
+    }
+    
+    // 最大边长不超过 alwaysResidentSize 的第一个级别（没有则为末级）
+    slot.floorMip = levelCount - 1;
+    for (int i = 0; i < levelCount; ++i) {
+        if (std::max(levels[i].width, levels[i].height) <= m_options.alwaysResidentSize) {
+            slot.floorMip = i;
+            break;
+        }
+    }
+    slot.residentMip = slot.floorMip;
+    slot.desiredMip = slot.floorMip;
+    slot.targetMip = slot.floorMip;
+    
+    m_residentBytes += slot.chainBytes[slot.residentMip];
+    m_stats.textureCount++;
+    return handle;
+}
+
+void TextureResidencyManager::Unregister(TextureResidencyHandle handle) {
+    if (handle >= m_slots.size() || !m_slots[handle].active) {
+        return;
+    }
+    Slot& slot = m_slots[handle];
+    m_residentBytes -= slot.chainBytes[slot.residentMip];
+    slot = Slot{};
+    m_freeHandles.push_back(handle);
+    m_stats.textureCount--;
+}
+
+void TextureResidencyManager::Request(TextureResidencyHandle handle, int mip) {
+    if (handle >= m_slots.size() || !m_slots[handle].active) {
+        return;
+    }
+    Slot& slot = m_slots[handle];
+    slot.requestedMip = std::min(slot.requestedMip, std::max(mip, 0));
+}
+
+int TextureResidencyManager::ComputeDesiredMip(int width, int height, float screenPixels, float bias) {
+    const int size = std::max(width, height);
+    int maxMip = 0;
+    for (int s = size; s > 1; s >>= 1) {
+        maxMip++;
+    }
+    if (!(screenPixels > 0.0f)) {
+        return maxMip;
+    }
+    // 每个屏幕像素覆盖的纹素数为 2^mip 时，mip 级别与像素约 1:1
+    const float texelsPerPixel = static_cast<float>(size) / screenPixels;
+    const float mip = std::log2(std::max(texelsPerPixel, 1.0f)) + bias;
+    return std::clamp(static_cast<int>(std::floor(mip)), 0, maxMip);
+}
+
+const TextureResidencyManager::Slot* TextureResidencyManager::GetSlot(TextureResidencyHandle handle) const {
+    if (handle >= m_slots.size() || !m_slots[handle].active) {
+        return nullptr;
+    }
+    return &m_slots[handle];
+}
+
+int TextureResidencyManager::GetResidentMip(TextureResidencyHandle handle) const {
+    const Slot* slot = GetSlot(handle);
+    return slot ? slot->residentMip : -1;
+}
+
+int TextureResidencyManager::GetTargetMip(TextureResidencyHandle handle) const {
+    const Slot* slot = GetSlot(handle);
+    return slot ? slot->targetMip : -1;
+}
+
+int TextureResidencyManager::GetFloorMip(TextureResidencyHandle handle) const {
+    const Slot* slot = GetSlot(handle);
+    return slot ? slot->floorMip : -1;
+}
+
+size_t TextureResidencyManager::GetChainBytes(TextureResidencyHandle handle, int mip) const {
+    const Slot* slot = GetSlot(handle);
+    if (!slot || mip < 0 || mip >= static_cast<int>(slot->chainBytes.size())) {
+        return 0;
+    }
+    return slot->chainBytes[mip];
+}
+
+const std::vector<TextureResidencyChange>& TextureResidencyManager::Update(uint64_t frameIndex) {
+    m_changes.clear();
+    m_stats.promotions = 0;
+    m_stats.demotions = 0;
+    m_stats.deferredPromotions = 0;
+    m_stats.budgetLimited = 0;
+    m_stats.requestedBytes = 0;
+    
+    // ==================== 1. 所需级别（带延迟降级） ====================
+    size_t streamedBytes = 0;   // 目标级别超出始终驻留部分的字节数
+    for (Slot& slot : m_slots) {
+        if (!slot.active) {
+            continue;
+        }
+        const bool requested = slot.requestedMip != std::numeric_limits<int>::max();
+        const bool expired = frameIndex - slot.desiredFrame > m_options.evictionDelayFrames;
+        if (requested) {
+            const int mip = std::min(slot.requestedMip, slot.floorMip);
+            if (mip <= slot.desiredMip || expired) {
+                slot.desiredMip = mip;
+                slot.desiredFrame = frameIndex;
+            }
+        } else if (expired) {
+            slot.desiredMip = slot.floorMip;
+        }
+        slot.targetMip = slot.desiredMip;
+        m_stats.requestedBytes += slot.chainBytes[slot.desiredMip];
+        streamedBytes += slot.chainBytes[slot.targetMip] - slot.chainBytes[slot.floorMip];
+    }
+    
+    // ==================== 2. 预算约束 ====================
+    // 优先降低本帧未请求的纹理，其次降低当前最精细级别最大的纹理
+    if (streamedBytes > m_options.budgetBytes) {
+        using Candidate = std::tuple<bool, size_t, TextureResidencyHandle>;
+        std::priority_queue<Candidate> queue;
+        auto push = [&](TextureResidencyHandle handle) {
+            const Slot& slot = m_slots[handle];
+            if (slot.targetMip < slot.floorMip) {
+                const size_t levelBytes = slot.chainBytes[slot.targetMip] - slot.chainBytes[slot.targetMip + 1];
+                const bool stale = slot.requestedMip == std::numeric_limits<int>::max();
+                queue.emplace(stale, levelBytes, handle);
+            }
+        };
+        for (TextureResidencyHandle handle = 0; handle < m_slots.size(); ++handle) {
+            if (m_slots[handle].active) {
+                push(handle);
+            }
+        }
+        while (streamedBytes > m_options.budgetBytes && !queue.empty()) {
+            const auto [stale, levelBytes, handle] = queue.top();
+            queue.pop();
+            Slot& slot = m_slots[handle];
+            slot.targetMip++;
+            streamedBytes -= levelBytes;
+            push(handle);
+        }
+    }
+    
+    // ==================== 3. 降级立即生效 ====================
+    for (TextureResidencyHandle handle = 0; handle < m_slots.size(); ++handle) {
+        Slot& slot = m_slots[handle];
+        if (!slot.active) {
+            continue;
+        }
+        if (slot.targetMip > slot.desiredMip) {
+            m_stats.budgetLimited++;
+        }
+        if (slot.targetMip > slot.residentMip) {
+            m_changes.push_back({handle, slot.residentMip, slot.targetMip, 0});
+            m_residentBytes -= slot.chainBytes[slot.residentMip] - slot.chainBytes[slot.targetMip];
+            slot.residentMip = slot.targetMip;
+            m_stats.demotions++;
+        }
+    }
+    
+    // ==================== 4. 提升按优先级分帧执行 ====================
+    std::vector<TextureResidencyHandle> promotions;
+    for (TextureResidencyHandle handle = 0; handle < m_slots.size(); ++handle) {
+        const Slot& slot = m_slots[handle];
+        if (slot.active && slot.targetMip < slot.residentMip) {
+            promotions.push_back(handle);
+        }
+    }
+    std::sort(promotions.begin(), promotions.end(), [this](TextureResidencyHandle a, TextureResidencyHandle b) {
+        const Slot& slotA = m_slots[a];
+        const Slot& slotB = m_slots[b];
+        const bool requestedA = slotA.requestedMip != std::numeric_limits<int>::max();
+        const bool requestedB = slotB.requestedMip != std::numeric_limits<int>::max();
+        if (requestedA != requestedB) {
+            return requestedA;
+        }
+        const int gapA = slotA.residentMip - slotA.targetMip;
+        const int gapB = slotB.residentMip - slotB.targetMip;
+        if (gapA != gapB) {
+            return gapA > gapB;
+        }
+        return a < b;
+    });
+    
+    size_t uploadedBytes = 0;
+    for (TextureResidencyHandle handle : promotions) {
+        Slot& slot = m_slots[handle];
+        // 只上传 [targetMip, residentMip) 之间缺失的级别，已驻留的粗级别保留在显存中
+        const size_t bytes = slot.chainBytes[slot.targetMip] - slot.chainBytes[slot.residentMip];
+        if (uploadedBytes > 0 && uploadedBytes + bytes > m_options.uploadBytesPerUpdate) {
+            m_stats.deferredPromotions++;
+            continue;
+        }
+        m_changes.push_back({handle, slot.residentMip, slot.targetMip, bytes});
+        m_residentBytes += bytes;
+        slot.residentMip = slot.targetMip;
+        uploadedBytes += bytes;
+        m_stats.promotions++;
+    }
+    
+    for (Slot& slot : m_slots) {
+        slot.requestedMip = std::numeric_limits<int>::max();
+    }
+    m_stats.residentBytes = m_residentBytes;
+    return m_changes;
+}
+
+} // namespace Render
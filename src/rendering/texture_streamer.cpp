@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/texture_streamer.h"
+#include "render/logger.h"
+#include "render/error.h"
+#include "render/gl_thread_checker.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Render {
+
+TextureStreamer& TextureStreamer::GetInstance() {
+    static TextureStreamer instance;
+    return instance;
+}
+
+void TextureStreamer::SetOptions(const TextureResidencyOptions& options) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_residency.SetOptions(options);
+}
+
+TextureResidencyOptions TextureStreamer::GetOptions() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_residency.GetOptions();
+}
+
+void TextureStreamer::SetEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = enabled;
+}
+
+bool TextureStreamer::IsEnabled() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_enabled;
+}
+
+bool TextureStreamer::UploadLevelsNow(Texture& texture, const Entry& entry, int firstMip) {
+    for (size_t level = static_cast<size_t>(firstMip); level < entry.levels.size(); ++level) {
+        const TextureMipLevel& mip = entry.levels[level];
+        if (!texture.UploadSubImage(static_cast<int>(level), 0, mip.width, mip.height,
+                                    entry.data.data() + mip.offset, mip.size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TextureUploadTicket TextureStreamer::SubmitLevels(const TexturePtr& texture, const Entry& entry,
+                                                  int firstMip, int endMip, size_t& outBytes) {
+    // 级别在数据块中连续存放，复制 [firstMip, endMip) 覆盖的字节区间并把偏移改为相对区间起点
+    size_t begin = entry.levels[firstMip].offset;
+    size_t end = begin;
+    for (int level = firstMip; level < endMip; ++level) {
+        begin = std::min(begin, entry.levels[level].offset);
+        end = std::max(end, entry.levels[level].offset + entry.levels[level].size);
+    }
+    std::vector<TextureMipLevel> levels(entry.levels.begin() + firstMip, entry.levels.begin() + endMip);
+    for (TextureMipLevel& level : levels) {
+        level.offset -= begin;
+    }
+    outBytes = end - begin;
+    
+    auto& queue = TextureUploadQueue::GetInstance();
+    TextureStagingBuffer staging = queue.AcquireStagingBuffer(outBytes);
+    std::vector<uint8_t> pixels;
+    if (staging.IsValid()) {
+        std::memcpy(staging.data, entry.data.data() + begin, outBytes);
+        staging.size = outBytes;
+        queue.FinishStagingWrite(staging);
+    } else {
+        pixels.assign(entry.data.begin() + static_cast<std::ptrdiff_t>(begin),
+                      entry.data.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+    return queue.Submit(texture, std::move(pixels), std::move(levels), entry.format, staging, firstMip);
+}
+
+void TextureStreamer::CancelUpload(Entry& entry) {
+    if (entry.ticket != kInvalidUploadTicket) {
+        TextureUploadQueue::GetInstance().Cancel(entry.ticket);
+        entry.ticket = kInvalidUploadTicket;
+        entry.requestedMip = entry.uploadedMip;
+    }
+}
+
+bool TextureStreamer::Register(const TexturePtr& texture,
+                               std::vector<uint8_t> data,
+                               std::vector<TextureMipLevel> levels,
+                               TextureFormat format) {
+    GL_THREAD_CHECK();
+    
+    if (!texture || data.empty() || levels.empty()) {
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidArgument,
+                                 "TextureStreamer::Register: 无效的纹理或 mip 数据"));
+        return false;
+    }
+    for (const TextureMipLevel& level : levels) {
+        if (level.offset + level.size > data.size()) {
+            HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidArgument,
+                                     "TextureStreamer::Register: mip 级别超出数据范围"));
+            return false;
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto existing = m_entries.find(texture.get());
+    if (existing != m_entries.end()) {
+        CancelUpload(existing->second);
+        m_handleToTexture.erase(existing->second.handle);
+        m_residency.Unregister(existing->second.handle);
+        m_entries.erase(existing);
+    }
+    
+    Entry entry;
+    entry.texture = texture;
+    entry.data = std::move(data);
+    entry.levels = std::move(levels);
+    entry.format = format;
+    entry.handle = m_residency.Register(entry.levels);
+    
+    // 只为驻留级别分配存储；纹理尺寸与 ID 按完整 mip 链固定，之后只调整分配范围、内容与采样基础级别
+    const int floorMip = m_residency.GetFloorMip(entry.handle);
+    if (!texture->CreateFromMipLevels(nullptr, entry.levels, format, floorMip) ||
+        !UploadLevelsNow(*texture, entry, floorMip)) {
+        m_residency.Unregister(entry.handle);
+        return false;
+    }
+    texture->SetBaseLevel(floorMip);
+    entry.uploadedMip = floorMip;
+    entry.requestedMip = floorMip;
+    
+    LOG_DEBUG_F("TextureStreamer: 注册流式纹理 %dx%d，%zu 级，初始驻留级别 %d",
+                entry.levels[0].width, entry.levels[0].height, entry.levels.size(), floorMip);
+    
+    m_handleToTexture[entry.handle] = texture.get();
+    m_entries[texture.get()] = std::move(entry);
+    return true;
+}
+
+void TextureStreamer::Unregister(const Texture* texture) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(texture);
+    if (it == m_entries.end()) {
+        return;
+    }
+    CancelUpload(it->second);
+    m_handleToTexture.erase(it->second.handle);
+    m_residency.Unregister(it->second.handle);
+    m_entries.erase(it);
+}
+
+void TextureStreamer::RequestTexture(const Texture* texture, float screenPixels) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(texture);
+    if (it == m_entries.end()) {
+        return;
+    }
+    const TextureMipLevel& base = it->second.levels[0];
+    const int mip = TextureResidencyManager::ComputeDesiredMip(base.width, base.height, screenPixels);
+    m_residency.Request(it->second.handle, mip);
+}
+
+void TextureStreamer::RequestMip(const Texture* texture, int mip) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(texture);
+    if (it != m_entries.end()) {
+        m_residency.Request(it->second.handle, mip);
+    }
+}
+
+void TextureStreamer::Update() {
+    GL_THREAD_CHECK();
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    // 清理已被释放的纹理
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.texture.expired()) {
+            CancelUpload(it->second);
+            m_handleToTexture.erase(it->second.handle);
+            m_residency.Unregister(it->second.handle);
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
+    if (!m_enabled || m_entries.empty()) {
+        return;
+    }
+    
+    auto& queue = TextureUploadQueue::GetInstance();
+    
+    // 1. 结束已完成的上传：新级别全部写入后才放开采样
+    for (auto& [key, entry] : m_entries) {
+        if (entry.ticket == kInvalidUploadTicket) {
+            continue;
+        }
+        const TextureUploadState state = queue.Poll(entry.ticket);
+        if (state == TextureUploadState::Pending) {
+            continue;
+        }
+        entry.ticket = kInvalidUploadTicket;
+        TexturePtr texture = entry.texture.lock();
+        if (state == TextureUploadState::Completed && texture) {
+            entry.uploadedMip = entry.requestedMip;
+            texture->SetBaseLevel(entry.uploadedMip);
+            m_stats.uploadedBytes += entry.ticketBytes;
+        } else {
+            // 释放未写入级别的存储，但保留 requestedMip：直到请求更精细的级别才重试，避免每帧重复失败
+            LOG_WARNING_F("TextureStreamer: 级别 %d -> %d 上传失败", entry.uploadedMip, entry.requestedMip);
+            if (texture) {
+                texture->SetStorageBaseLevel(entry.uploadedMip);
+            }
+        }
+    }
+    
+    // 2. 驻留决策
+    const auto& changes = m_residency.Update(++m_frameIndex);
+    for (const TextureResidencyChange& change : changes) {
+        if (change.toMip < change.fromMip) {
+            m_stats.promotions++;
+        } else {
+            m_stats.demotions++;
+        }
+    }
+    
+    // 3. 降级：取消已不需要的上传，先提高采样基础级别，再释放更精细级别的显存
+    for (auto& [key, entry] : m_entries) {
+        const int targetMip = m_residency.GetResidentMip(entry.handle);
+        if (targetMip < 0 || targetMip <= entry.requestedMip) {
+            continue;
+        }
+        TexturePtr texture = entry.texture.lock();
+        if (!texture) {
+            continue;
+        }
+        CancelUpload(entry);
+        if (targetMip > entry.uploadedMip) {
+            texture->SetBaseLevel(targetMip);
+            entry.uploadedMip = targetMip;
+            entry.requestedMip = targetMip;
+        }
+        texture->SetStorageBaseLevel(entry.uploadedMip);
+    }
+    
+    // 4. 提升：为新驻留级别分配存储，并把它们交给上传队列（受其每帧字节预算约束）
+    for (auto& [key, entry] : m_entries) {
+        if (entry.ticket != kInvalidUploadTicket) {
+            continue;
+        }
+        const int targetMip = m_residency.GetResidentMip(entry.handle);
+        if (targetMip < 0 || targetMip >= entry.requestedMip) {
+            continue;
+        }
+        TexturePtr texture = entry.texture.lock();
+        if (!texture || !texture->SetStorageBaseLevel(targetMip)) {
+            continue;
+        }
+        entry.ticket = SubmitLevels(texture, entry, targetMip, entry.uploadedMip, entry.ticketBytes);
+        if (entry.ticket != kInvalidUploadTicket) {
+            entry.requestedMip = targetMip;
+        } else {
+            texture->SetStorageBaseLevel(entry.uploadedMip);
+        }
+    }
+    
+    const TextureResidencyManager::Stats& stats = m_residency.GetStats();
+    m_stats.deferredPromotions = stats.deferredPromotions;
+    m_stats.budgetLimited = stats.budgetLimited;
+}
+
+bool TextureStreamer::IsStreaming(const Texture* texture) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.find(texture) != m_entries.end();
+}
+
+int TextureStreamer::GetResidentMip(const Texture* texture) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(texture);
+    return it != m_entries.end() ? m_residency.GetResidentMip(it->second.handle) : -1;
+}
+
+size_t TextureStreamer::GetTextureCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+TextureStreamer::Stats TextureStreamer::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats = m_stats;
+    stats.textureCount = m_entries.size();
+    stats.requestedBytes = m_residency.GetStats().requestedBytes;
+    stats.residentBytes = 0;
+    stats.cpuBytes = 0;
+    for (const auto& pair : m_entries) {
+        // 按纹理实际分配的级别统计（上传中的级别已分配存储，也计入）
+        if (TexturePtr texture = pair.second.texture.lock()) {
+            stats.residentBytes += texture->GetMemoryUsage();
+        }
+        stats.cpuBytes += pair.second.data.size();
+    }
+    return stats;
+}
+
+void TextureStreamer::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& pair : m_entries) {
+        CancelUpload(pair.second);
+        m_residency.Unregister(pair.second.handle);
+    }
+    m_entries.clear();
+    m_handleToTexture.clear();
+}
+
+} // namespace Render
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/texture_upload_planner.h"
+#include "render/texture_compression.h"
+#include <algorithm>
+
+namespace Render {
+
+int TextureUploadPlanner::GetRowGranularity(TextureFormat format) {
+    return TextureCompressor::IsBlockCompressed(format) ? 4 : 1;
+}
+
+size_t TextureUploadPlanner::GetRowPitch(TextureFormat format, int width) {
+    return TextureCompressor::GetLevelSize(format, width, GetRowGranularity(format));
+}
+
+std::vector<TextureUploadSlice> TextureUploadPlanner::BuildSlices(const std::vector<TextureMipLevel>& levels,
+                                                                  TextureFormat format,
+                                                                  size_t maxSliceBytes,
+                                                                  int firstLevel) {
+    std::vector<TextureUploadSlice> slices;
+    const int granularity = GetRowGranularity(format);
+    
+    for (size_t level = 0; level < levels.size(); ++level) {
+        const TextureMipLevel& mip = levels[level];
+        const size_t pitch = GetRowPitch(format, mip.width);
+        if (mip.height <= 0 || pitch == 0) {
+            continue;
+        }
+        
+        const int units = (mip.height + granularity - 1) / granularity;
+        const int unitsPerSlice = static_cast<int>(std::clamp<size_t>(
+            maxSliceBytes / pitch, 1, static_cast<size_t>(units)));
+        
+        for (int unit = 0; unit < units; unit += unitsPerSlice) {
+            const int count = std::min(unitsPerSlice, units - unit);
+            TextureUploadSlice slice;
+            slice.level = firstLevel + static_cast<int>(level);
+            slice.y = unit * granularity;
+            slice.width = mip.width;
+            slice.height = std::min(count * granularity, mip.height - slice.y);
+            slice.offset = mip.offset + static_cast<size_t>(unit) * pitch;
+            slice.size = static_cast<size_t>(count) * pitch;
+            slices.push_back(slice);
+        }
+    }
+    return slices;
+}
+
+void TextureUploadPlanner::Enqueue(TextureUploadJobId job, std::vector<TextureUploadSlice> slices) {
+    if (slices.empty()) {
+        return;
+    }
+    
+    Job entry;
+    entry.id = job;
+    entry.slices = std::move(slices);
+    for (const TextureUploadSlice& slice : entry.slices) {
+        m_pendingBytes += slice.size;
+    }
+    m_jobs.push_back(std::move(entry));
+    
+    m_stats.pendingJobs = m_jobs.size();
+    m_stats.pendingBytes = m_pendingBytes;
+}
+
+bool TextureUploadPlanner::Cancel(TextureUploadJobId job) {
+    auto it = std::find_if(m_jobs.begin(), m_jobs.end(),
+                           [job](const Job& entry) { return entry.id == job; });
+    if (it == m_jobs.end()) {
+        return false;
+    }
+    
+    for (size_t i = it->next; i < it->slices.size(); ++i) {
+        m_pendingBytes -= it->slices[i].size;
+    }
+    m_jobs.erase(it);
+    
+    m_stats.pendingJobs = m_jobs.size();
+    m_stats.pendingBytes = m_pendingBytes;
+    return true;
+}
+
+bool TextureUploadPlanner::IsQueued(TextureUploadJobId job) const {
+    return std::any_of(m_jobs.begin(), m_jobs.end(),
+                       [job](const Job& entry) { return entry.id == job; });
+}
+
+const std::vector<TextureUploadDispatch>& TextureUploadPlanner::NextFrame() {
+    m_dispatches.clear();
+    size_t frameBytes = 0;
+    
+    while (!m_jobs.empty()) {
+        Job& job = m_jobs.front();
+        const TextureUploadSlice& slice = job.slices[job.next];
+        
+        // 队首切片总是发出，之后的切片只在预算内发出
+        if (!m_dispatches.empty() && frameBytes + slice.size > m_bytesPerFrame) {
+            break;
+        }
+        
+        TextureUploadDispatch dispatch;
+        dispatch.job = job.id;
+        dispatch.slice = slice;
+        dispatch.lastSlice = job.next + 1 == job.slices.size();
+        m_dispatches.push_back(dispatch);
+        
+        frameBytes += slice.size;
+        m_pendingBytes -= slice.size;
+        ++job.next;
+        if (dispatch.lastSlice) {
+            m_jobs.pop_front();
+        }
+    }
+    
+    m_stats.pendingJobs = m_jobs.size();
+    m_stats.pendingBytes = m_pendingBytes;
+    m_stats.frameSlices = m_dispatches.size();
+    m_stats.frameBytes = frameBytes;
+    m_stats.totalSlices += m_dispatches.size();
+    m_stats.totalBytes += frameBytes;
+    return m_dispatches;
+}
+
+} // namespace Render
@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/texture_upload_queue.h"
+#include "render/logger.h"
+#include "render/error.h"
+#include "render/gl_thread_checker.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Render {
+
+namespace {
+
+constexpr uint32_t kNoBufferSlot = std::numeric_limits<uint32_t>::max();
+constexpr size_t kBufferGranularity = 1024 * 1024;
+constexpr auto kStagingDrainTimeout = std::chrono::seconds(2);   ///< Shutdown 等待工作线程写完 PBO 的上限
+
+} // namespace
+
+TextureUploadQueue& TextureUploadQueue::GetInstance() {
+    static TextureUploadQueue instance;
+    return instance;
+}
+
+void TextureUploadQueue::SetOptions(const TextureUploadOptions& options) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = options;
+    m_planner.SetBytesPerFrame(options.bytesPerFrame);
+}
+
+TextureUploadOptions TextureUploadQueue::GetOptions() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_options;
+}
+
+TextureStagingBuffer TextureUploadQueue::AcquireStagingBuffer(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    TextureStagingBuffer staging;
+    if (!m_options.usePixelBuffers || bytes == 0 || m_shuttingDown) {
+        return staging;
+    }
+    
+    // 最佳适配：容量足够的最小空闲缓冲
+    uint32_t best = kNoBufferSlot;
+    for (uint32_t slot = 0; slot < m_buffers.size(); ++slot) {
+        const PixelBuffer& buffer = m_buffers[slot];
+        if (buffer.id == 0 || buffer.inUse || !buffer.mapped || buffer.capacity < bytes) {
+            continue;
+        }
+        if (best == kNoBufferSlot || buffer.capacity < m_buffers[best].capacity) {
+            best = slot;
+        }
+    }
+    
+    if (best == kNoBufferSlot) {
+        if (bytes <= m_options.poolBudgetBytes) {
+            m_pendingDemand = std::max(m_pendingDemand, bytes);
+        }
+        m_stats.stagingMisses++;
+        return staging;
+    }
+    
+    m_buffers[best].inUse = true;
+    m_buffers[best].writing = true;
+    staging.slot = best;
+    staging.generation = m_generation;
+    staging.data = m_buffers[best].mapped;
+    staging.size = bytes;
+    return staging;
+}
+
+void TextureUploadQueue::FinishStagingWrite(const TextureStagingBuffer& buffer) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PixelBuffer* pixelBuffer = FindStagingLocked(buffer);
+        if (!pixelBuffer) {
+            return;
+        }
+        pixelBuffer->writing = false;
+    }
+    m_writeDone.notify_all();
+}
+
+void TextureUploadQueue::ReleaseStagingBuffer(TextureStagingBuffer& buffer) {
+    if (!buffer.IsValid()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Shutdown 之前取得的区域已随池释放，直接丢弃
+        if (PixelBuffer* pixelBuffer = FindStagingLocked(buffer)) {
+            // 仍处于映射状态，直接回到空闲列表
+            pixelBuffer->inUse = false;
+            pixelBuffer->writing = false;
+        }
+    }
+    m_writeDone.notify_all();
+    buffer = TextureStagingBuffer{};
+}
+
+TextureUploadTicket TextureUploadQueue::Submit(const TexturePtr& texture,
+                                               std::vector<uint8_t> pixels,
+                                               std::vector<TextureMipLevel> levels,
+                                               TextureFormat format,
+                                               TextureStagingBuffer staging,
+                                               int firstLevel) {
+    GL_THREAD_CHECK();
+    
+    size_t totalBytes = 0;
+    for (const TextureMipLevel& level : levels) {
+        totalBytes = std::max(totalBytes, level.offset + level.size);
+    }
+    const size_t availableBytes = staging.IsValid() ? staging.size : pixels.size();
+    
+    if (!texture || !texture->IsValid() || levels.empty() || totalBytes > availableBytes || firstLevel < 0) {
+        ReleaseStagingBuffer(staging);
+        HANDLE_ERROR(RENDER_ERROR(ErrorCode::InvalidArgument,
+                                 "TextureUploadQueue::Submit: 无效的纹理或 mip 数据"));
+        return kInvalidUploadTicket;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    Job job;
+    job.texture = texture;
+    job.bytes = totalBytes;
+    
+    PixelBuffer* stagingBuffer = FindStagingLocked(staging);
+    if (staging.IsValid() && !stagingBuffer) {
+        // Shutdown 已释放该缓冲，数据随之丢失
+        Logger::GetInstance().Error("TextureUploadQueue: staging PBO 已在 Shutdown 中释放，无法提交");
+        return kInvalidUploadTicket;
+    }
+    
+    if (stagingBuffer) {
+        PixelBuffer& buffer = *stagingBuffer;
+        buffer.writing = false;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+        const GLboolean unmapped = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        buffer.mapped = nullptr;
+        
+        if (unmapped == GL_FALSE) {
+            // 映射期间数据被破坏（例如显示模式切换），缓冲在下一次 Update 重新映射
+            buffer.inUse = false;
+            Logger::GetInstance().Error("TextureUploadQueue: 解除 PBO 映射失败，数据已失效");
+            return kInvalidUploadTicket;
+        }
+        job.bufferSlot = staging.slot;
+    } else {
+        job.pixels = std::move(pixels);
+    }
+    
+    TextureUploadTicket ticket = m_nextTicket++;
+    if (ticket == kInvalidUploadTicket) {
+        ticket = m_nextTicket++;
+    }
+    
+    m_planner.Enqueue(ticket, TextureUploadPlanner::BuildSlices(levels, format, m_options.maxSliceBytes, firstLevel));
+    m_jobs.emplace(ticket, std::move(job));
+    return ticket;
+}
+
+void TextureUploadQueue::Update() {
+    GL_THREAD_CHECK();
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    // 1. 回收 fence 已触发的任务；已取消但尚未插入 fence 的任务补插 fence
+    std::vector<TextureUploadTicket> finished;
+    for (auto& [ticket, job] : m_jobs) {
+        if (!job.fence) {
+            if (job.cancelled || job.failed) {
+                m_planner.Cancel(ticket);
+                job.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+            continue;
+        }
+        
+        const GLenum result = glClientWaitSync(job.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+            FinishJobLocked(ticket, job, job.failed ? TextureUploadState::Failed : TextureUploadState::Completed);
+            finished.push_back(ticket);
+        } else if (result == GL_WAIT_FAILED) {
+            Logger::GetInstance().Error("TextureUploadQueue: 等待上传 fence 失败");
+            FinishJobLocked(ticket, job, TextureUploadState::Failed);
+            finished.push_back(ticket);
+        }
+    }
+    for (TextureUploadTicket ticket : finished) {
+        m_jobs.erase(ticket);
+    }
+    
+    // 2. 重新映射空闲缓冲，并按工作线程的未满足需求扩容
+    for (PixelBuffer& buffer : m_buffers) {
+        if (buffer.id != 0 && !buffer.inUse && !buffer.mapped) {
+            MapBufferLocked(buffer);
+        }
+    }
+    
+    if (m_pendingDemand > 0 && m_options.usePixelBuffers) {
+        const size_t capacity = std::max(m_options.minBufferBytes,
+            (m_pendingDemand + kBufferGranularity - 1) / kBufferGranularity * kBufferGranularity);
+        
+        // 超出池预算时淘汰容量不足的空闲缓冲
+        while (GetPoolBytesLocked() + capacity > m_options.poolBudgetBytes) {
+            auto victim = std::find_if(m_buffers.begin(), m_buffers.end(), [this](const PixelBuffer& buffer) {
+                return buffer.id != 0 && !buffer.inUse && buffer.capacity < m_pendingDemand;
+            });
+            if (victim == m_buffers.end()) {
+                break;
+            }
+            DestroyBufferLocked(*victim);
+        }
+        
+        if (GetPoolBytesLocked() + capacity <= m_options.poolBudgetBytes) {
+            CreateBufferLocked(capacity);
+        }
+        m_pendingDemand = 0;
+    }
+    
+    // 3. 在预算内发出切片
+    const std::vector<TextureUploadDispatch>& dispatches = m_planner.NextFrame();
+    GLuint boundBuffer = 0;
+    size_t frameBytes = 0;
+    
+    for (const TextureUploadDispatch& dispatch : dispatches) {
+        auto it = m_jobs.find(dispatch.job);
+        if (it == m_jobs.end() || it->second.failed || it->second.cancelled) {
+            continue;
+        }
+        Job& job = it->second;
+        const TextureUploadSlice& slice = dispatch.slice;
+        
+        TexturePtr texture = job.texture.lock();
+        if (!texture) {
+            // 纹理在上传完成前被释放
+            job.cancelled = true;
+            m_planner.Cancel(dispatch.job);
+        } else {
+            const void* source = nullptr;
+            if (job.bufferSlot != kNoBufferSlot) {
+                const GLuint bufferId = m_buffers[job.bufferSlot].id;
+                if (boundBuffer != bufferId) {
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bufferId);
+                    boundBuffer = bufferId;
+                }
+                source = reinterpret_cast<const void*>(static_cast<uintptr_t>(slice.offset));
+            } else {
+                if (boundBuffer != 0) {
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                    boundBuffer = 0;
+                }
+                source = job.pixels.data() + slice.offset;
+            }
+            
+            if (!texture->UploadSubImage(slice.level, slice.y, slice.width, slice.height, source, slice.size)) {
+                job.failed = true;
+                m_planner.Cancel(dispatch.job);
+            } else {
+                frameBytes += slice.size;
+            }
+        }
+        
+        if (dispatch.lastSlice || job.failed || job.cancelled) {
+            job.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            // glTexSubImage2D 返回时已复制 CPU 数据，可立即释放
+            std::vector<uint8_t>().swap(job.pixels);
+        }
+    }
+    
+    if (boundBuffer != 0) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    
+    m_stats.lastFrameBytes = frameBytes;
+    m_stats.uploadedBytes += frameBytes;
+}
+
+TextureUploadState TextureUploadQueue::Poll(TextureUploadTicket ticket) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (m_jobs.count(ticket) != 0) {
+        return TextureUploadState::Pending;
+    }
+    
+    auto it = m_finished.find(ticket);
+    if (it == m_finished.end()) {
+        return TextureUploadState::Failed;
+    }
+    const TextureUploadState state = it->second;
+    m_finished.erase(it);
+    return state;
+}
+
+void TextureUploadQueue::Cancel(TextureUploadTicket ticket) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto it = m_jobs.find(ticket);
+    if (it != m_jobs.end()) {
+        it->second.cancelled = true;
+        m_planner.Cancel(ticket);
+    }
+    m_finished.erase(ticket);
+}
+
+void TextureUploadQueue::Prewarm(size_t bufferBytes, size_t count) {
+    GL_THREAD_CHECK();
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < count; ++i) {
+        if (GetPoolBytesLocked() + bufferBytes > m_options.poolBudgetBytes || !CreateBufferLocked(bufferBytes)) {
+            break;
+        }
+    }
+}
+
+void TextureUploadQueue::Shutdown() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    if (m_buffers.empty() && m_jobs.empty()) {
+        return;
+    }
+    
+    // 拒绝新的写入，并等待工作线程完成正在进行的 memcpy
+    m_shuttingDown = true;
+    const auto writersDone = [this]() {
+        return std::none_of(m_buffers.begin(), m_buffers.end(),
+                            [](const PixelBuffer& buffer) { return buffer.writing; });
+    };
+    if (!m_writeDone.wait_for(lock, kStagingDrainTimeout, writersDone)) {
+        Logger::GetInstance().Warning("TextureUploadQueue: 等待工作线程写入 PBO 超时，仍在写入的缓冲将不被删除");
+    }
+    
+    for (auto& [ticket, job] : m_jobs) {
+        if (job.fence) {
+            glDeleteSync(job.fence);
+        }
+    }
+    size_t abandoned = 0;
+    for (PixelBuffer& buffer : m_buffers) {
+        if (buffer.writing) {
+            // 保持映射且不删除：工作线程仍持有映射地址，缓冲随上下文一起销毁
+            abandoned++;
+            continue;
+        }
+        DestroyBufferLocked(buffer);
+    }
+    
+    Logger::GetInstance().Info("TextureUploadQueue: 已释放 " + std::to_string(m_buffers.size() - abandoned) +
+                               " 个 PBO，丢弃 " + std::to_string(m_jobs.size()) + " 个未完成的上传");
+    
+    m_buffers.clear();
+    m_jobs.clear();
+    m_finished.clear();
+    m_planner = TextureUploadPlanner(m_options.bytesPerFrame);
+    m_pendingDemand = 0;
+    // 之前取得的 staging 区域全部失效，避免其槽位与新建的缓冲混淆
+    m_generation++;
+    m_shuttingDown = false;
+}
+
+TextureUploadQueue::Stats TextureUploadQueue::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    Stats stats = m_stats;
+    stats.bufferCount = 0;
+    stats.buffersInUse = 0;
+    for (const PixelBuffer& buffer : m_buffers) {
+        if (buffer.id == 0) {
+            continue;
+        }
+        stats.bufferCount++;
+        if (buffer.inUse) {
+            stats.buffersInUse++;
+        }
+    }
+    stats.poolBytes = GetPoolBytesLocked();
+    stats.pendingUploads = m_jobs.size();
+    stats.pendingBytes = m_planner.GetPendingBytes();
+    return stats;
+}
+
+bool TextureUploadQueue::CreateBufferLocked(size_t capacity) {
+    PixelBuffer buffer;
+    buffer.capacity = capacity;
+    
+    glGetError();
+    glGenBuffers(1, &buffer.id);
+    if (buffer.id == 0) {
+        return false;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    
+    if (glGetError() != GL_NO_ERROR || !MapBufferLocked(buffer)) {
+        Logger::GetInstance().Warning("TextureUploadQueue: 创建 " + std::to_string(capacity) + " 字节的 PBO 失败");
+        glDeleteBuffers(1, &buffer.id);
+        return false;
+    }
+    
+    auto empty = std::find_if(m_buffers.begin(), m_buffers.end(),
+                              [](const PixelBuffer& slot) { return slot.id == 0; });
+    if (empty != m_buffers.end()) {
+        *empty = buffer;
+    } else {
+        m_buffers.push_back(buffer);
+    }
+    
+    Logger::GetInstance().Debug("TextureUploadQueue: 新建 PBO " + std::to_string(buffer.id) +
+                                "，容量 " + std::to_string(capacity / 1024) + " KB");
+    return true;
+}
+
+bool TextureUploadQueue::MapBufferLocked(PixelBuffer& buffer) {
+    // fence 已保证 GPU 不再读取该缓冲，无需同步映射
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(buffer.capacity),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    
+    buffer.mapped = static_cast<uint8_t*>(mapped);
+    return buffer.mapped != nullptr;
+}
+
+TextureUploadQueue::PixelBuffer* TextureUploadQueue::FindStagingLocked(const TextureStagingBuffer& staging) {
+    if (!staging.IsValid() || staging.generation != m_generation || staging.slot >= m_buffers.size() ||
+        m_buffers[staging.slot].id == 0) {
+        return nullptr;
+    }
+    return &m_buffers[staging.slot];
+}
+
+void TextureUploadQueue::DestroyBufferLocked(PixelBuffer& buffer) {
+    if (buffer.id == 0) {
+        return;
+    }
+    if (buffer.mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &buffer.id);
+    buffer = PixelBuffer{};
+}
+
+void TextureUploadQueue::RecycleBufferLocked(uint32_t slot) {
+    if (slot >= m_buffers.size() || m_buffers[slot].id == 0) {
+        return;
+    }
+    PixelBuffer& buffer = m_buffers[slot];
+    buffer.inUse = false;
+    MapBufferLocked(buffer);
+}
+
+void TextureUploadQueue::FinishJobLocked(TextureUploadTicket ticket, Job& job, TextureUploadState state) {
+    if (job.fence) {
+        glDeleteSync(job.fence);
+        job.fence = nullptr;
+    }
+    
+    const bool usedPixelBuffer = job.bufferSlot != kNoBufferSlot;
+    if (usedPixelBuffer) {
+        RecycleBufferLocked(job.bufferSlot);
+        job.bufferSlot = kNoBufferSlot;
+    }
+    
+    // 已取消的任务没有调用方等待结果
+    if (job.cancelled) {
+        return;
+    }
+    if (state == TextureUploadState::Completed) {
+        if (usedPixelBuffer) {
+            m_stats.pixelBufferUploads++;
+        } else {
+            m_stats.clientMemoryUploads++;
+        }
+    }
+    m_finished[ticket] = state;
+}
+
+size_t TextureUploadQueue::GetPoolBytesLocked() const {
+    size_t bytes = 0;
+    for (const PixelBuffer& buffer : m_buffers) {
+        if (buffer.id != 0) {
+            bytes += buffer.capacity;
+        }
+    }
+    return bytes;
+}
+
+} // namespace Render
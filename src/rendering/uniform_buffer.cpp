@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/uniform_buffer.h"
+#include "render/render_state.h"
+#include "render/error.h"
+#include "render/gl_thread_checker.h"
+#include <glad/glad.h>
+
+namespace Render {
+
+namespace {
+
+uint64_t HashBytes(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+UniformBuffer::~UniformBuffer() {
+    Release();
+}
+
+bool UniformBuffer::Upload(const void* data, size_t size, RenderState* renderState) {
+    if (!data || size == 0) {
+        HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidArgument,
+                                   "UniformBuffer::Upload: 数据为空"));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint64_t hash = HashBytes(data, size);
+    if (m_bufferID != 0 && m_size == size && m_contentHash == hash) {
+        return false;
+    }
+
+    GL_THREAD_CHECK();
+    if (m_bufferID == 0) {
+        glGenBuffers(1, &m_bufferID);
+        if (m_bufferID == 0) {
+            HANDLE_ERROR(RENDER_ERROR(ErrorCode::OutOfMemory,
+                                     "UniformBuffer::Upload: 创建缓冲失败"));
+            return false;
+        }
+    }
+
+    if (renderState) {
+        renderState->BindBuffer(BufferTarget::UniformBuffer, m_bufferID);
+    } else {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_bufferID);
+    }
+
+    if (m_size != size) {
+        glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), data, GL_DYNAMIC_DRAW);
+        m_size = size;
+    } else {
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(size), data);
+    }
+
+    m_contentHash = hash;
+    return true;
+}
+
+void UniformBuffer::BindBase(uint32_t bindingPoint) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_bufferID == 0) {
+        return;
+    }
+
+    GL_THREAD_CHECK();
+    glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, m_bufferID);
+}
+
+void UniformBuffer::Release() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_bufferID != 0) {
+        GL_THREAD_CHECK();
+        glDeleteBuffers(1, &m_bufferID);
+        m_bufferID = 0;
+    }
+    m_size = 0;
+    m_contentHash = 0;
+}
+
+uint32_t UniformBuffer::GetID() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bufferID;
+}
+
+size_t UniformBuffer::GetSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+} // namespace Render
@@ -273,6 +273,100 @@ bool UniformManager::HasUniform(const std::string& name) const {
     return location != -1;
 }
 
+UniformHandle UniformManager::GetHandle(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    
+    auto it = m_uniformLocationCache.find(name);
+    if (it != m_uniformLocationCache.end()) {
+        return UniformHandle{it->second};
+    }
+    
+    GL_THREAD_CHECK();
+    int location = glGetUniformLocation(m_programID, name.c_str());
+    m_uniformLocationCache[name] = location;
+    return UniformHandle{location};
+}
+
+void UniformManager::SetInt(UniformHandle handle, int value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniform1i(handle.location, value);
+    }
+}
+
+void UniformManager::SetFloat(UniformHandle handle, float value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniform1f(handle.location, value);
+    }
+}
+
+void UniformManager::SetBool(UniformHandle handle, bool value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniform1i(handle.location, value ? 1 : 0);
+    }
+}
+
+void UniformManager::SetVector2(UniformHandle handle, const Vector2& value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniform2f(handle.location, value.x(), value.y());
+    }
+}
+
+void UniformManager::SetVector3(UniformHandle handle, const Vector3& value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniform3f(handle.location, value.x(), value.y(), value.z());
+    }
+}
+
+void UniformManager::SetVector4(UniformHandle handle, const Vector4& value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniform4f(handle.location, value.x(), value.y(), value.z(), value.w());
+    }
+}
+
+void UniformManager::SetMatrix3(UniformHandle handle, const Matrix3& value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniformMatrix3fv(handle.location, 1, GL_FALSE, value.data());
+    }
+}
+
+void UniformManager::SetMatrix4(UniformHandle handle, const Matrix4& value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniformMatrix4fv(handle.location, 1, GL_FALSE, value.data());
+    }
+}
+
+void UniformManager::SetColor(UniformHandle handle, const Color& value) {
+    if (handle.IsValid()) {
+        GL_THREAD_CHECK();
+        glUniform4f(handle.location, value.r, value.g, value.b, value.a);
+    }
+}
+
+void UniformManager::SetVector2Array(UniformHandle handle, const Vector2* values, uint32_t count) {
+    if (!handle.IsValid() || !values || count == 0) {
+        return;
+    }
+    GL_THREAD_CHECK();
+    glUniform2fv(handle.location, count, reinterpret_cast<const float*>(values));
+}
+
+void UniformManager::SetColorArray(UniformHandle handle, const Color* values, uint32_t count) {
+    static_assert(sizeof(Color) == sizeof(float) * 4, "Color 必须是紧凑的 4 个 float");
+    if (!handle.IsValid() || !values || count == 0) {
+        return;
+    }
+    GL_THREAD_CHECK();
+    glUniform4fv(handle.location, count, &values[0].r);
+}
+
 void UniformManager::RegisterTextureUniform(const std::string& name, int textureUnit) {
     if (textureUnit < 0 || textureUnit > 31) {
         HANDLE_ERROR(RENDER_WARNING(ErrorCode::InvalidArgument,
@@ -310,6 +404,37 @@ void UniformManager::ClearCache() {
     std::lock_guard<std::mutex> lock(m_cacheMutex);
     m_uniformLocationCache.clear();
     m_textureUnits.clear();
+    m_uniformBlockIndexCache.clear();
+}
+
+bool UniformManager::HasUniformBlock(const std::string& blockName) const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    
+    auto it = m_uniformBlockIndexCache.find(blockName);
+    if (it != m_uniformBlockIndexCache.end()) {
+        return it->second != GL_INVALID_INDEX;
+    }
+    
+    GL_THREAD_CHECK();
+    GLuint index = glGetUniformBlockIndex(m_programID, blockName.c_str());
+    m_uniformBlockIndexCache[blockName] = index;
+    return index != GL_INVALID_INDEX;
+}
+
+bool UniformManager::BindUniformBlock(const std::string& blockName, uint32_t bindingPoint) {
+    if (!HasUniformBlock(blockName)) {
+        return false;
+    }
+    
+    GLuint index = GL_INVALID_INDEX;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        index = m_uniformBlockIndexCache[blockName];
+    }
+    
+    GL_THREAD_CHECK();
+    glUniformBlockBinding(m_programID, index, bindingPoint);
+    return true;
 }
 
 std::vector<std::string> UniformManager::GetAllUniformNames() const {
@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+#include "render/vertex_layout.h"
+#include "render/mesh.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace Render {
+
+namespace {
+
+constexpr uint32_t kPositionFloat3Size = 12;
+constexpr uint32_t kPositionSNorm16Size = 8;     // 第 4 分量为填充，保证 4 字节对齐
+
+uint32_t PositionSize(VertexPositionFormat format) {
+    return format == VertexPositionFormat::SNorm16 ? kPositionSNorm16Size : kPositionFloat3Size;
+}
+
+uint32_t TexCoordSize(VertexTexCoordFormat format) {
+    switch (format) {
+        case VertexTexCoordFormat::Float2: return 8;
+        case VertexTexCoordFormat::Half2:  return 4;
+        default:                           return 0;
+    }
+}
+
+uint32_t NormalSize(VertexNormalFormat format) {
+    switch (format) {
+        case VertexNormalFormat::Float3: return 12;
+        case VertexNormalFormat::Oct16:  return 4;
+        default:                         return 0;
+    }
+}
+
+uint32_t ColorSize(VertexColorFormat format) {
+    switch (format) {
+        case VertexColorFormat::Float4: return 16;
+        case VertexColorFormat::UNorm8: return 4;
+        default:                        return 0;
+    }
+}
+
+uint32_t TangentSize(VertexTangentFormat format) {
+    switch (format) {
+        case VertexTangentFormat::Float3Bitangent: return 24;
+        case VertexTangentFormat::Oct16Sign:       return 8;
+        default:                                   return 0;
+    }
+}
+
+template<typename T>
+void WriteValue(uint8_t* dst, const T& value) {
+    std::memcpy(dst, &value, sizeof(T));
+}
+
+template<typename T>
+T ReadValue(const uint8_t* src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+void WriteFloats(uint8_t* dst, const float* values, size_t count) {
+    std::memcpy(dst, values, count * sizeof(float));
+}
+
+} // anonymous namespace
+
+// ==================== VertexLayout ====================
+
+VertexLayout VertexLayout::Compact(bool quantizePositions) {
+    VertexLayout layout;
+    layout.position = quantizePositions ? VertexPositionFormat::SNorm16 : VertexPositionFormat::Float3;
+    layout.texCoord = VertexTexCoordFormat::Half2;
+    layout.normal = VertexNormalFormat::Oct16;
+    layout.color = VertexColorFormat::UNorm8;
+    layout.tangent = VertexTangentFormat::Oct16Sign;
+    return layout;
+}
+
+VertexLayout VertexLayout::Unlit() {
+    VertexLayout layout;
+    layout.position = VertexPositionFormat::Float3;
+    layout.texCoord = VertexTexCoordFormat::Half2;
+    layout.normal = VertexNormalFormat::None;
+    layout.color = VertexColorFormat::UNorm8;
+    layout.tangent = VertexTangentFormat::None;
+    return layout;
+}
+
+uint32_t VertexLayout::GetStride() const {
+    return PositionSize(position) + TexCoordSize(texCoord) + NormalSize(normal) +
+           ColorSize(color) + TangentSize(tangent);
+}
+
+VertexAttributeSlot VertexLayout::GetPositionSlot() const {
+    return VertexAttributeSlot{true, 0};
+}
+
+VertexAttributeSlot VertexLayout::GetTexCoordSlot() const {
+    return VertexAttributeSlot{texCoord != VertexTexCoordFormat::None, PositionSize(position)};
+}
+
+VertexAttributeSlot VertexLayout::GetNormalSlot() const {
+    return VertexAttributeSlot{normal != VertexNormalFormat::None,
+                               PositionSize(position) + TexCoordSize(texCoord)};
+}
+
+VertexAttributeSlot VertexLayout::GetColorSlot() const {
+    return VertexAttributeSlot{color != VertexColorFormat::None,
+                               PositionSize(position) + TexCoordSize(texCoord) + NormalSize(normal)};
+}
+
+VertexAttributeSlot VertexLayout::GetTangentSlot() const {
+    return VertexAttributeSlot{tangent != VertexTangentFormat::None,
+                               PositionSize(position) + TexCoordSize(texCoord) + NormalSize(normal) +
+                               ColorSize(color)};
+}
+
+VertexAttributeSlot VertexLayout::GetBitangentSlot() const {
+    VertexAttributeSlot slot = GetTangentSlot();
+    slot.enabled = tangent == VertexTangentFormat::Float3Bitangent;
+    slot.offset += 12;
+    return slot;
+}
+
+uint32_t VertexLayout::GetShaderFlags() const {
+    uint32_t flags = VertexLayoutFlag_None;
+    if (position == VertexPositionFormat::SNorm16) {
+        flags |= VertexLayoutFlag_QuantizedPosition;
+    }
+    if (normal == VertexNormalFormat::Oct16) {
+        flags |= VertexLayoutFlag_OctNormal;
+    }
+    if (tangent == VertexTangentFormat::Oct16Sign) {
+        flags |= VertexLayoutFlag_OctTangent;
+    }
+    return flags;
+}
+
+std::string VertexLayout::ToString() const {
+    std::string result = "pos:";
+    result += position == VertexPositionFormat::SNorm16 ? "snorm16" : "float3";
+    
+    result += " uv:";
+    switch (texCoord) {
+        case VertexTexCoordFormat::Float2: result += "float2"; break;
+        case VertexTexCoordFormat::Half2:  result += "half2"; break;
+        default:                           result += "-"; break;
+    }
+    
+    result += " n:";
+    switch (normal) {
+        case VertexNormalFormat::Float3: result += "float3"; break;
+        case VertexNormalFormat::Oct16:  result += "oct16"; break;
+        default:                         result += "-"; break;
+    }
+    
+    result += " c:";
+    switch (color) {
+        case VertexColorFormat::Float4: result += "float4"; break;
+        case VertexColorFormat::UNorm8: result += "unorm8"; break;
+        default:                        result += "-"; break;
+    }
+    
+    result += " t:";
+    switch (tangent) {
+        case VertexTangentFormat::Float3Bitangent: result += "float3+b"; break;
+        case VertexTangentFormat::Oct16Sign:       result += "oct16s"; break;
+        default:                                   result += "-"; break;
+    }
+    
+    result += " (" + std::to_string(GetStride()) + "B)";
+    return result;
+}
+
+// ==================== VertexQuantization ====================
+
+VertexQuantization VertexQuantization::FromBounds(const AABB& bounds) {
+    VertexQuantization quantization;
+    quantization.offset = bounds.GetCenter();
+    const float extent = bounds.GetExtents().maxCoeff();
+    quantization.scale = extent > 1e-6f ? extent : 1.0f;
+    return quantization;
+}
+
+bool VertexQuantization::Contains(const Vector3& position) const {
+    const float limit = scale * (1.0f + 1e-5f);
+    return ((position - offset).cwiseAbs().array() <= limit).all();
+}
+
+// ==================== VertexCodec ====================
+
+uint16_t VertexCodec::FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+    
+    if (exponent == 0xFFu) {
+        // Inf / NaN（保留 NaN 的静默位）
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+    
+    const int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+    if (halfExponent >= 0x1F) {
+        return static_cast<uint16_t>(sign | 0x7C00u);  // 溢出 → Inf
+    }
+    
+    if (halfExponent <= 0) {
+        // 非规格化数或下溢为 0
+        if (halfExponent < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+        mantissa |= 0x800000u;
+        const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+        uint32_t halfMantissa = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (halfMantissa & 1u))) {
+            ++halfMantissa;
+        }
+        return static_cast<uint16_t>(sign | halfMantissa);
+    }
+    
+    uint32_t half = sign | (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        ++half;  // 进位可能溢出到指数，结果仍正确（最大值进位为 Inf）
+    }
+    return static_cast<uint16_t>(half);
+}
+
+float VertexCodec::HalfToFloat(uint16_t value) {
+    const uint32_t sign = (static_cast<uint32_t>(value) & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+    
+    uint32_t bits;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // 非规格化数：规格化后转换
+            int32_t e = -1;
+            do {
+                ++e;
+                mantissa <<= 1;
+            } while ((mantissa & 0x400u) == 0);
+            bits = sign | (static_cast<uint32_t>(127 - 15 - e) << 23) | ((mantissa & 0x3FFu) << 13);
+        }
+    } else if (exponent == 0x1F) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+int16_t VertexCodec::FloatToSNorm16(float value) {
+    const float clamped = std::clamp(value, -1.0f, 1.0f);
+    return static_cast<int16_t>(std::lround(clamped * 32767.0f));
+}
+
+float VertexCodec::SNorm16ToFloat(int16_t value) {
+    return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+}
+
+void VertexCodec::OctEncode(const Vector3& direction, int16_t& outX, int16_t& outY) {
+    const float l1 = std::abs(direction.x()) + std::abs(direction.y()) + std::abs(direction.z());
+    if (l1 < 1e-12f) {
+        // 退化向量编码为 +Y（与 Vertex 默认法线一致）
+        outX = 0;
+        outY = FloatToSNorm16(1.0f);
+        return;
+    }
+    
+    float x = direction.x() / l1;
+    float y = direction.y() / l1;
+    if (direction.z() < 0.0f) {
+        const float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    outX = FloatToSNorm16(x);
+    outY = FloatToSNorm16(y);
+}
+
+Vector3 VertexCodec::OctDecode(int16_t x, int16_t y) {
+    Vector3 v(SNorm16ToFloat(x), SNorm16ToFloat(y), 0.0f);
+    v.z() = 1.0f - std::abs(v.x()) - std::abs(v.y());
+    const float t = std::max(-v.z(), 0.0f);
+    v.x() += v.x() >= 0.0f ? -t : t;
+    v.y() += v.y() >= 0.0f ? -t : t;
+    return v.normalized();
+}
+
+uint32_t VertexCodec::PackColorUNorm8(const Color& color) {
+    auto toByte = [](float value) -> uint32_t {
+        return static_cast<uint32_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    };
+    const uint8_t bytes[4] = {
+        static_cast<uint8_t>(toByte(color.r)), static_cast<uint8_t>(toByte(color.g)),
+        static_cast<uint8_t>(toByte(color.b)), static_cast<uint8_t>(toByte(color.a))
+    };
+    uint32_t packed;
+    std::memcpy(&packed, bytes, sizeof(packed));
+    return packed;
+}
+
+Color VertexCodec::UnpackColorUNorm8(uint32_t packed) {
+    uint8_t bytes[4];
+    std::memcpy(bytes, &packed, sizeof(bytes));
+    return Color(bytes[0] / 255.0f, bytes[1] / 255.0f, bytes[2] / 255.0f, bytes[3] / 255.0f);
+}
+
+void VertexCodec::Encode(const Vertex* vertices, size_t count, const VertexLayout& layout,
+                         const VertexQuantization& quantization, uint8_t* out) {
+    const uint32_t stride = layout.GetStride();
+    const VertexAttributeSlot uvSlot = layout.GetTexCoordSlot();
+    const VertexAttributeSlot normalSlot = layout.GetNormalSlot();
+    const VertexAttributeSlot colorSlot = layout.GetColorSlot();
+    const VertexAttributeSlot tangentSlot = layout.GetTangentSlot();
+    const float invScale = 1.0f / quantization.scale;
+    
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex& vertex = vertices[i];
+        uint8_t* dst = out + i * stride;
+        
+        if (layout.position == VertexPositionFormat::SNorm16) {
+            const Vector3 local = (vertex.position - quantization.offset) * invScale;
+            const int16_t packed[4] = {
+                FloatToSNorm16(local.x()), FloatToSNorm16(local.y()), FloatToSNorm16(local.z()), 0
+            };
+            WriteValue(dst, packed);
+        } else {
+            WriteFloats(dst, vertex.position.data(), 3);
+        }
+        
+        if (layout.texCoord == VertexTexCoordFormat::Float2) {
+            WriteFloats(dst + uvSlot.offset, vertex.texCoord.data(), 2);
+        } else if (layout.texCoord == VertexTexCoordFormat::Half2) {
+            const uint16_t packed[2] = {FloatToHalf(vertex.texCoord.x()), FloatToHalf(vertex.texCoord.y())};
+            WriteValue(dst + uvSlot.offset, packed);
+        }
+        
+        if (layout.normal == VertexNormalFormat::Float3) {
+            WriteFloats(dst + normalSlot.offset, vertex.normal.data(), 3);
+        } else if (layout.normal == VertexNormalFormat::Oct16) {
+            int16_t packed[2];
+            OctEncode(vertex.normal, packed[0], packed[1]);
+            WriteValue(dst + normalSlot.offset, packed);
+        }
+        
+        if (layout.color == VertexColorFormat::Float4) {
+            const float packed[4] = {vertex.color.r, vertex.color.g, vertex.color.b, vertex.color.a};
+            WriteValue(dst + colorSlot.offset, packed);
+        } else if (layout.color == VertexColorFormat::UNorm8) {
+            WriteValue(dst + colorSlot.offset, PackColorUNorm8(vertex.color));
+        }
+        
+        if (layout.tangent == VertexTangentFormat::Float3Bitangent) {
+            WriteFloats(dst + tangentSlot.offset, vertex.tangent.data(), 3);
+            WriteFloats(dst + tangentSlot.offset + 12, vertex.bitangent.data(), 3);
+        } else if (layout.tangent == VertexTangentFormat::Oct16Sign) {
+            // 手性：副切线与 N×T 同向为 +1，反向为 -1（与 RecalculateTangents 的约定一致）
+            const float handedness = vertex.normal.cross(vertex.tangent).dot(vertex.bitangent) < 0.0f ? -1.0f : 1.0f;
+            int16_t packed[4];
+            OctEncode(vertex.tangent, packed[0], packed[1]);
+            packed[2] = FloatToSNorm16(handedness);
+            packed[3] = 0;
+            WriteValue(dst + tangentSlot.offset, packed);
+        }
+    }
+}
+
+Vertex VertexCodec::Decode(const uint8_t* data, const VertexLayout& layout,
+                           const VertexQuantization& quantization) {
+    Vertex vertex;
+    
+    if (layout.position == VertexPositionFormat::SNorm16) {
+        const auto packed = ReadValue<std::array<int16_t, 4>>(data);
+        vertex.position = Vector3(SNorm16ToFloat(packed[0]), SNorm16ToFloat(packed[1]), SNorm16ToFloat(packed[2])) *
+                          quantization.scale + quantization.offset;
+    } else {
+        vertex.position = Vector3(ReadValue<float>(data), ReadValue<float>(data + 4), ReadValue<float>(data + 8));
+    }
+    
+    const VertexAttributeSlot uvSlot = layout.GetTexCoordSlot();
+    if (layout.texCoord == VertexTexCoordFormat::Float2) {
+        vertex.texCoord = Vector2(ReadValue<float>(data + uvSlot.offset), ReadValue<float>(data + uvSlot.offset + 4));
+    } else if (layout.texCoord == VertexTexCoordFormat::Half2) {
+        vertex.texCoord = Vector2(HalfToFloat(ReadValue<uint16_t>(data + uvSlot.offset)),
+                                  HalfToFloat(ReadValue<uint16_t>(data + uvSlot.offset + 2)));
+    }
+    
+    const VertexAttributeSlot normalSlot = layout.GetNormalSlot();
+    if (layout.normal == VertexNormalFormat::Float3) {
+        const uint8_t* src = data + normalSlot.offset;
+        vertex.normal = Vector3(ReadValue<float>(src), ReadValue<float>(src + 4), ReadValue<float>(src + 8));
+    } else if (layout.normal == VertexNormalFormat::Oct16) {
+        const auto packed = ReadValue<std::array<int16_t, 2>>(data + normalSlot.offset);
+        vertex.normal = OctDecode(packed[0], packed[1]);
+    }
+    
+    const VertexAttributeSlot colorSlot = layout.GetColorSlot();
+    if (layout.color == VertexColorFormat::Float4) {
+        const auto packed = ReadValue<std::array<float, 4>>(data + colorSlot.offset);
+        vertex.color = Color(packed[0], packed[1], packed[2], packed[3]);
+    } else if (layout.color == VertexColorFormat::UNorm8) {
+        vertex.color = UnpackColorUNorm8(ReadValue<uint32_t>(data + colorSlot.offset));
+    }
+    
+    const VertexAttributeSlot tangentSlot = layout.GetTangentSlot();
+    if (layout.tangent == VertexTangentFormat::Float3Bitangent) {
+        const auto packed = ReadValue<std::array<float, 6>>(data + tangentSlot.offset);
+        vertex.tangent = Vector3(packed[0], packed[1], packed[2]);
+        vertex.bitangent = Vector3(packed[3], packed[4], packed[5]);
+    } else if (layout.tangent == VertexTangentFormat::Oct16Sign) {
+        const auto packed = ReadValue<std::array<int16_t, 4>>(data + tangentSlot.offset);
+        vertex.tangent = OctDecode(packed[0], packed[1]);
+        const float handedness = packed[2] < 0 ? -1.0f : 1.0f;
+        vertex.bitangent = vertex.normal.cross(vertex.tangent) * handedness;
+    }
+    
+    return vertex;
+}
+
+void IndexCodec::PackUInt16(const uint32_t* indices, size_t count, uint16_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<uint16_t>(indices[i]);
+    }
+}
+
+} // namespace Render
@@ -23,6 +23,7 @@
 #include "render/mesh.h"
 #include "render/renderable.h"
 #include "render/render_state.h"
+#include "render/pipeline_state.h"
 #include "render/renderer.h"
 #include "render/shader.h"
 #include "render/math_utils.h"
@@ -254,10 +255,14 @@ void SpriteBatcher::DrawBatch(size_t index, RenderState* renderState) {
     }
 
     RenderState::ScopedStateGuard stateGuard(renderState);
-    renderState->SetBlendMode(batch.key.blendMode);
-    renderState->SetDepthTest(false);
-    renderState->SetDepthWrite(false);
-    renderState->SetCullFace(CullFace::None);
+    PipelineStateDesc pipelineDesc;
+    pipelineDesc.fields = PipelineStateFields_Blend | PipelineStateFields_DepthTest |
+                          PipelineStateFields_DepthWrite | PipelineStateFields_CullFace;
+    pipelineDesc.blendMode = batch.key.blendMode;
+    pipelineDesc.depthTest = false;
+    pipelineDesc.depthWrite = false;
+    pipelineDesc.cullFace = CullFace::None;
+    renderState->ApplyPipelineState(PipelineStateRegistry::GetInstance().Acquire(pipelineDesc));
 
     shader->Use();
 
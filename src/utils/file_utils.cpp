@@ -20,9 +20,23 @@
  */
 #include "render/file_utils.h"
 #include "render/logger.h"
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace Render {
 
@@ -89,5 +103,149 @@ std::string FileUtils::CombinePaths(const std::string& base, const std::string&
     return (basePath / relativePath).string();
 }
 
+std::string FileUtils::NormalizePath(const std::string& filepath) {
+    if (filepath.empty()) {
+        return filepath;
+    }
+    std::string normalized = std::filesystem::path(filepath).lexically_normal().generic_string();
+    // "dir/" 与 "dir" 视为同一路径
+    if (normalized.size() > 1 && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+uint64_t FileUtils::HashBytes(const void* data, size_t size, uint64_t seed) {
+    constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash ^= word;
+        hash *= kFnvPrime;
+    }
+    for (; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+uint64_t FileUtils::HashFile(const std::string& filepath) {
+    MappedFile file;
+    if (!file.Open(filepath)) {
+        return 0;
+    }
+    return HashBytes(file.GetData(), file.GetSize());
+}
+
+// ============================================================================
+// MappedFile
+// ============================================================================
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+        m_fileHandle = std::exchange(other.m_fileHandle, nullptr);
+        m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::string& filepath) {
+    Close();
+    
+#ifdef _WIN32
+    std::wstring widePath = std::filesystem::path(filepath).wstring();
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    
+    void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后即可关闭文件描述符
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close() {
+    if (!m_data) {
+        return;
+    }
+    
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    if (m_mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    if (m_fileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
 } // namespace Render
 
@@ -19,15 +19,22 @@
  * For commercial licensing, please contact: 2052046346@qq.com
  */
 #include <render/async_resource_loader.h>
+#include <render/file_utils.h>
 #include <render/logger.h>
 #include <render/mesh.h>
+#include <render/mesh_loader.h>
 #include <render/resource_manager.h>
 #include <render/renderer.h>
+#include <render/task_scheduler.h>
 
 #include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <iostream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -45,6 +52,48 @@ std::string BuildMissingFilePath() {
 #endif
 }
 
+int g_failedChecks = 0;
+
+bool Check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "[async_resource_loader_failure_test] 断言失败: " << message << '\n';
+        ++g_failedChecks;
+    }
+    return condition;
+}
+
+/**
+ * @brief 占满 TaskScheduler 的工作线程，使加载任务在 Open() 之前保持进行中
+ *
+ * 闸门任务优先级高于资源加载（Low），即使工作线程尚未取走闸门任务，加载任务也不会先执行
+ */
+class WorkerGate {
+public:
+    WorkerGate() {
+        auto& scheduler = TaskScheduler::GetInstance();
+        std::shared_future<void> opened = m_open.get_future().share();
+        for (size_t i = 0; i < scheduler.GetWorkerCount(); ++i) {
+            m_handles.push_back(scheduler.SubmitLambda([opened]() { opened.wait(); },
+                                                       TaskPriority::High, "WorkerGate"));
+        }
+    }
+
+    ~WorkerGate() { Open(); }
+
+    void Open() {
+        if (!m_opened) {
+            m_opened = true;
+            m_open.set_value();
+            TaskScheduler::GetInstance().WaitForAll(m_handles);
+        }
+    }
+
+private:
+    std::promise<void> m_open;
+    std::vector<std::shared_ptr<TaskHandle>> m_handles;
+    bool m_opened = false;
+};
+
 void PrintTaskState(const std::shared_ptr<MeshLoadTask>& task, const std::string& prefix) {
     if (!task) {
         std::cout << prefix << "任务句柄为空\n";
@@ -79,6 +128,111 @@ int main() {
     auto& asyncLoader = AsyncResourceLoader::GetInstance();
     asyncLoader.Initialize();
 
+    // ------------------------------------------------------------------------
+    // 请求合并：工作线程被占满，任务在检查期间一定仍在进行中
+    // ------------------------------------------------------------------------
+    {
+        WorkerGate gate;
+        const std::string coalescePath = BuildMissingFilePath();
+        LoadRequestId firstId = kInvalidLoadRequest;
+        LoadRequestId duplicateId = kInvalidLoadRequest;
+        auto first = asyncLoader.LoadMeshAsync(coalescePath, "async_coalesced_model", nullptr, 0.0f, &firstId);
+        // 同一路径（不同写法）与同名的重复请求应合并到同一个任务
+        auto duplicate = asyncLoader.LoadMeshAsync(
+            coalescePath + "/../" + FileUtils::GetFileName(coalescePath),
+            "async_coalesced_model", nullptr, 0.0f, &duplicateId);
+        Check(duplicate == first, "重复请求应返回同一任务");
+        Check(firstId != kInvalidLoadRequest && duplicateId != kInvalidLoadRequest && firstId != duplicateId,
+              "合并的请求应各有自己的请求标识");
+        Check(asyncLoader.GetCoalescedRequestCount() == 1, "合并计数应为 1");
+        Check(asyncLoader.GetInflightRequestCount() == 1, "进行中请求应为 1");
+
+        // 撤销按请求标识计数：同一请求重复撤销只生效一次，重复请求仍在等待时不取消加载
+        Check(first->CancelRequest(firstId), "撤销自己的请求应成功");
+        Check(!first->CancelRequest(firstId), "同一请求重复撤销应无效");
+        Check(!first->IsCancelled(), "仍有合并的请求时不应取消任务");
+        Check(first->CancelRequest(duplicateId), "撤销重复请求应成功");
+        Check(first->IsCancelled() && first->errorType == LoadErrorType::Cancelled,
+              "所有合并的请求都撤销后任务应被取消");
+
+        // 已取消的任务不再被合并，同键请求重新提交
+        auto resubmitted = asyncLoader.LoadMeshAsync(coalescePath, "async_coalesced_model");
+        Check(resubmitted != first, "取消后的同键请求应提交新任务");
+        Check(asyncLoader.GetCoalescedRequestCount() == 1, "重新提交不应计入合并");
+        resubmitted->Cancel();
+        Check(resubmitted->IsCancelled(), "Cancel() 应直接取消整个任务");
+    }
+    asyncLoader.WaitForAll(5.0f);
+
+    // ------------------------------------------------------------------------
+    // 撤销的请求不再收到回调，合并的其他请求照常完成
+    // ------------------------------------------------------------------------
+    {
+        const std::string objPath = (std::filesystem::temp_directory_path() / "async_coalesced_triangle.obj").string();
+        {
+            std::ofstream out(objPath);
+            out << "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nf 1//1 2//1 3//1\n";
+        }
+
+        bool keptCalled = false;
+        bool cancelledCalled = false;
+        bool keptSucceeded = false;
+        LoadRequestId cancelledId = kInvalidLoadRequest;
+        std::shared_ptr<MeshLoadTask> kept;
+        {
+            WorkerGate gate;
+            kept = asyncLoader.LoadMeshAsync(objPath, "async_cancel_one_request",
+                [&](const MeshLoadResult& result) {
+                    keptCalled = true;
+                    keptSucceeded = result.IsSuccess();
+                });
+            auto dropped = asyncLoader.LoadMeshAsync(objPath, "async_cancel_one_request",
+                [&](const MeshLoadResult&) { cancelledCalled = true; }, 0.0f, &cancelledId);
+            Check(dropped == kept, "重复请求应合并");
+            Check(dropped->CancelRequest(cancelledId), "撤销重复请求应成功");
+            Check(!kept->IsCancelled(), "仍有请求等待时加载应继续");
+        }
+
+        for (int i = 0; i < 500 && !keptCalled; ++i) {
+            asyncLoader.ProcessCompletedTasks(8);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        Check(keptCalled && keptSucceeded, "未撤销的请求应收到成功回调");
+        Check(!cancelledCalled, "已撤销的请求不应收到回调");
+        ResourceManager::GetInstance().RemoveMesh("async_cancel_one_request");
+        std::filesystem::remove(objPath);
+    }
+
+    // ------------------------------------------------------------------------
+    // ResourceManager 中已上传的网格直接返回，回调在 ProcessCompletedTasks 中调用
+    // ------------------------------------------------------------------------
+    {
+        auto registered = MeshLoader::CreateCube();
+        registered->Upload();
+        ResourceManager::GetInstance().RegisterMesh("async_registered_mesh", registered);
+
+        const size_t hitsBefore = asyncLoader.GetResourceHitCount();
+        const size_t inflightBefore = asyncLoader.GetInflightRequestCount();
+        bool callbackCalled = false;
+        Ref<Mesh> callbackMesh;
+        auto served = asyncLoader.LoadMeshAsync(
+            BuildMissingFilePath(),
+            "async_registered_mesh",
+            [&](const MeshLoadResult& result) {
+                callbackCalled = true;
+                callbackMesh = result.resource;
+            });
+        Check(served && served->status.load() == LoadStatus::Completed, "已注册网格应返回已完成任务");
+        Check(served && served->result == registered, "任务结果应为已注册的网格");
+        Check(asyncLoader.GetResourceHitCount() == hitsBefore + 1, "应计入资源命中");
+        Check(asyncLoader.GetInflightRequestCount() == inflightBefore, "已有资源不应登记进行中请求");
+        Check(!callbackCalled, "回调应推迟到 ProcessCompletedTasks");
+
+        asyncLoader.ProcessCompletedTasks(8);
+        Check(callbackCalled && callbackMesh == registered, "回调应在主线程收到已注册的网格");
+        ResourceManager::GetInstance().RemoveMesh("async_registered_mesh");
+    }
+
     const std::string missingPath = BuildMissingFilePath();
     std::cout << "尝试异步加载不存在的模型: " << missingPath << '\n';
 
@@ -136,7 +290,7 @@ int main() {
     ResourceManager::GetInstance().Clear();
     renderer.Shutdown();
 
-    return 0;
+    return g_failedChecks == 0 ? 0 : 1;
 }
 
 
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_bvh.cpp
+ * @brief BVH / SceneBVH 测试
+ *
+ * 视锥体、AABB、球体与射线查询结果与暴力遍历对比，并验证 Refit、增删与静态/动态树迁移（无需 GL 上下文）
+ */
+
+#include "render/bvh.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/// 位于 (0, 0, 0)、朝 -Z、60° FOV、远平面 200 的透视视锥体
+static Frustum MakeTestFrustum() {
+    const float fovY = 60.0f * 3.14159265f / 180.0f;
+    const float aspect = 16.0f / 9.0f;
+    const float nearPlane = 0.1f;
+    const float farPlane = 200.0f;
+    const float f = 1.0f / std::tan(fovY * 0.5f);
+
+    Matrix4 projection = Matrix4::Zero();
+    projection(0, 0) = f / aspect;
+    projection(1, 1) = f;
+    projection(2, 2) = (farPlane + nearPlane) / (nearPlane - farPlane);
+    projection(2, 3) = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+    projection(3, 2) = -1.0f;
+
+    Frustum frustum;
+    frustum.ExtractFromMatrix(projection);
+    return frustum;
+}
+
+static std::vector<AABB> MakeBoxes(size_t count, float range, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-range, range);
+    std::uniform_real_distribution<float> ext(0.1f, 3.0f);
+    std::vector<AABB> boxes;
+    boxes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3 center(pos(rng), pos(rng), pos(rng));
+        const Vector3 extents(ext(rng), ext(rng), ext(rng));
+        boxes.emplace_back(center - extents, center + extents);
+    }
+    return boxes;
+}
+
+static std::vector<uint32_t> Sorted(std::vector<uint32_t> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+static std::vector<uint32_t> BruteFrustum(const Frustum& frustum, const std::vector<AABB>& boxes,
+                                          const std::vector<bool>& alive) {
+    std::vector<uint32_t> result;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        if (alive[i] && frustum.IntersectsAABB(boxes[i])) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+// ============================================================================
+// BVH 查询
+// ============================================================================
+
+bool Test_BVH_FrustumMatchesBruteForce() {
+    const Frustum frustum = MakeTestFrustum();
+    const auto boxes = MakeBoxes(5000, 150.0f, 3);
+    std::vector<bool> alive(boxes.size(), true);
+
+    BVH bvh;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        bvh.Insert(boxes[i], i);
+    }
+    TEST_ASSERT(bvh.NeedsRebuild(), "未构建的 BVH 应需要构建");
+    bvh.Build();
+    TEST_ASSERT(bvh.GetPendingCount() == 0, "构建后待插入列表应为空");
+    TEST_ASSERT(bvh.GetPrimitiveCount() == boxes.size(), "图元数量应一致");
+
+    std::vector<uint32_t> result;
+    bvh.QueryFrustum(frustum, result);
+    const auto expected = BruteFrustum(frustum, boxes, alive);
+    TEST_ASSERT(!expected.empty(), "测试数据应有可见图元");
+    TEST_ASSERT(Sorted(result) == expected, "视锥体查询应与暴力遍历一致");
+    return true;
+}
+
+bool Test_BVH_RefitInsertRemove() {
+    const Frustum frustum = MakeTestFrustum();
+    auto boxes = MakeBoxes(2000, 150.0f, 5);
+    std::vector<bool> alive(boxes.size(), true);
+    std::vector<uint32_t> proxies(boxes.size());
+
+    BVH bvh;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        proxies[i] = bvh.Insert(boxes[i], i);
+    }
+    bvh.Build();
+
+    // 移动部分图元后 Refit
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> offset(-40.0f, 40.0f);
+    for (uint32_t i = 0; i < boxes.size(); i += 7) {
+        const Vector3 delta(offset(rng), offset(rng), offset(rng));
+        boxes[i] = AABB(boxes[i].min + delta, boxes[i].max + delta);
+        bvh.Update(proxies[i], boxes[i]);
+    }
+    // 删除部分图元
+    for (uint32_t i = 0; i < boxes.size(); i += 11) {
+        bvh.Remove(proxies[i]);
+        alive[i] = false;
+    }
+    bvh.Refit();
+
+    // 构建后插入（进入待插入列表）
+    const auto extra = MakeBoxes(30, 150.0f, 13);
+    for (const AABB& box : extra) {
+        const uint32_t id = static_cast<uint32_t>(boxes.size());
+        boxes.push_back(box);
+        alive.push_back(true);
+        proxies.push_back(bvh.Insert(box, id));
+    }
+    TEST_ASSERT(bvh.GetPendingCount() == extra.size(), "构建后插入的图元应在待插入列表中");
+
+    std::vector<uint32_t> result;
+    bvh.QueryFrustum(frustum, result);
+    TEST_ASSERT(Sorted(result) == BruteFrustum(frustum, boxes, alive), "Refit/增删后查询应与暴力遍历一致");
+
+    bvh.Build();
+    result.clear();
+    bvh.QueryFrustum(frustum, result);
+    TEST_ASSERT(Sorted(result) == BruteFrustum(frustum, boxes, alive), "重建后查询应与暴力遍历一致");
+    return true;
+}
+
+bool Test_BVH_OverlapQueries() {
+    const auto boxes = MakeBoxes(3000, 100.0f, 17);
+    BVH bvh;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        bvh.Insert(boxes[i], i);
+    }
+    bvh.Build();
+
+    const AABB region(Vector3(-20.0f, -10.0f, -30.0f), Vector3(25.0f, 15.0f, 5.0f));
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        if (boxes[i].Intersects(region)) {
+            expected.push_back(i);
+        }
+    }
+    std::vector<uint32_t> result;
+    bvh.QueryAABB(region, result);
+    TEST_ASSERT(Sorted(result) == expected, "AABB 查询应与暴力遍历一致");
+
+    const Vector3 center(10.0f, -5.0f, 20.0f);
+    const float radius = 18.0f;
+    expected.clear();
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        const Vector3 closest = center.cwiseMax(boxes[i].min).cwiseMin(boxes[i].max);
+        if ((closest - center).squaredNorm() <= radius * radius) {
+            expected.push_back(i);
+        }
+    }
+    result.clear();
+    bvh.QuerySphere(center, radius, result);
+    TEST_ASSERT(Sorted(result) == expected, "球体查询应与暴力遍历一致");
+    return true;
+}
+
+bool Test_BVH_RaycastNearest() {
+    const auto boxes = MakeBoxes(3000, 100.0f, 21);
+    BVH bvh;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        bvh.Insert(boxes[i], i);
+    }
+    bvh.Build();
+
+    std::mt19937 rng(33);
+    std::uniform_real_distribution<float> dir(-1.0f, 1.0f);
+    size_t mismatches = 0;
+    size_t hits = 0;
+    for (int r = 0; r < 200; ++r) {
+        const Ray ray(Vector3(0.0f, 0.0f, 0.0f), Vector3(dir(rng), dir(rng), dir(rng)));
+
+        float bestT = std::numeric_limits<float>::max();
+        bool expectedHit = false;
+        for (uint32_t i = 0; i < boxes.size(); ++i) {
+            float tMin = 0.0f, tMax = 0.0f;
+            if (ray.IntersectAABB(boxes[i], tMin, tMax) && tMin <= 500.0f && tMin < bestT) {
+                bestT = tMin;
+                expectedHit = true;
+            }
+        }
+
+        uint32_t hitId = 0;
+        float hitT = 0.0f;
+        const bool hit = bvh.Raycast(ray, 500.0f, hitId, hitT);
+        if (hit != expectedHit || (hit && std::abs(hitT - bestT) > 1e-3f)) {
+            ++mismatches;
+        }
+        hits += hit ? 1 : 0;
+    }
+    TEST_ASSERT(hits > 0, "应有射线命中");
+    TEST_ASSERT(mismatches == 0, "射线拾取应返回最近的包围盒");
+
+    // 窄相回调拒绝所有图元
+    uint32_t hitId = 0;
+    float hitT = 0.0f;
+    const bool hit = bvh.Raycast(Ray(Vector3::Zero(), Vector3(1.0f, 0.2f, 0.1f)), 500.0f, hitId, hitT,
+                                 [](uint32_t, float&) { return false; });
+    TEST_ASSERT(!hit, "窄相拒绝时不应命中");
+    return true;
+}
+
+bool Test_BVH_CostScalesWithVisible() {
+    // 大场景中只有少量对象位于视锥体内：遍历的节点数应远小于对象数
+    const Frustum frustum = MakeTestFrustum();
+    const auto boxes = MakeBoxes(100000, 5000.0f, 41);
+    BVH bvh;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        bvh.Insert(boxes[i], i);
+    }
+    bvh.Build();
+
+    std::vector<uint32_t> result;
+    BVHQueryStats stats;
+    bvh.QueryFrustum(frustum, result, &stats);
+    std::vector<bool> alive(boxes.size(), true);
+    TEST_ASSERT(Sorted(result) == BruteFrustum(frustum, boxes, alive), "大场景查询应与暴力遍历一致");
+    TEST_ASSERT(stats.nodesVisited < boxes.size() / 20, "遍历节点数应远小于场景对象数");
+    return true;
+}
+
+// ============================================================================
+// SceneBVH
+// ============================================================================
+
+bool Test_SceneBVH_StaticDynamic() {
+    const Frustum frustum = MakeTestFrustum();
+    auto boxes = MakeBoxes(1000, 150.0f, 51);
+    std::vector<bool> alive(boxes.size(), true);
+
+    SceneBVH scene;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        scene.Set(i, boxes[i]);
+    }
+    scene.Commit();
+    TEST_ASSERT(scene.GetStaticCount() == boxes.size(), "首次插入的对象应进入静态树");
+    TEST_ASSERT(scene.GetDynamicCount() == 0, "动态树应为空");
+
+    // 未变化的 Set 不应迁移
+    scene.Set(3, boxes[3]);
+    TEST_ASSERT(!scene.IsDynamic(3), "包围盒未变化时不应迁移到动态树");
+
+    // 移动的对象迁移到动态树
+    for (uint32_t i = 0; i < boxes.size(); i += 10) {
+        const Vector3 delta(0.0f, 0.0f, -30.0f);
+        boxes[i] = AABB(boxes[i].min + delta, boxes[i].max + delta);
+        scene.Set(i, boxes[i]);
+    }
+    scene.Remove(5);
+    alive[5] = false;
+    scene.Commit();
+    TEST_ASSERT(scene.IsDynamic(0) && scene.IsDynamic(990), "移动的对象应位于动态树");
+    TEST_ASSERT(scene.GetDynamicCount() == 100, "动态树对象数应正确");
+    TEST_ASSERT(!scene.Contains(5), "删除后不应再包含该对象");
+
+    // 动态对象再次移动（Refit 路径）
+    for (uint32_t i = 0; i < boxes.size(); i += 10) {
+        const Vector3 delta(5.0f, 0.0f, 0.0f);
+        boxes[i] = AABB(boxes[i].min + delta, boxes[i].max + delta);
+        scene.Set(i, boxes[i]);
+    }
+    scene.Commit();
+
+    std::vector<uint32_t> result;
+    scene.QueryFrustum(frustum, result);
+    TEST_ASSERT(Sorted(result) == BruteFrustum(frustum, boxes, alive), "SceneBVH 查询应与暴力遍历一致");
+
+    uint32_t hitId = 0;
+    float hitT = 0.0f;
+    const Vector3 target = boxes[10].GetCenter();
+    TEST_ASSERT(scene.Raycast(Ray(target, Vector3::UnitY()),
+                              1000.0f, hitId, hitT), "从包围盒内部发出的射线应命中");
+    TEST_ASSERT(hitT == 0.0f, "起点在包围盒内时命中距离应为 0");
+    return true;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "BVH 测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::cout << "\n--- BVH ---" << std::endl;
+    RUN_TEST(Test_BVH_FrustumMatchesBruteForce);
+    RUN_TEST(Test_BVH_RefitInsertRemove);
+    RUN_TEST(Test_BVH_OverlapQueries);
+    RUN_TEST(Test_BVH_RaycastNearest);
+    RUN_TEST(Test_BVH_CostScalesWithVisible);
+
+    std::cout << "\n--- SceneBVH ---" << std::endl;
+    RUN_TEST(Test_SceneBVH_StaticDynamic);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -529,6 +529,48 @@ bool Test_ComponentArray_CallbackExceptionHandling() {
     return true;
 }
 
+// ============================================================================
+// 1.4.4 测试组件生命周期事件
+// ============================================================================
+
+bool Test_ComponentRegistry_LifecycleEvents() {
+    ComponentRegistry registry;
+    registry.RegisterComponent<TransformComponent>();
+    registry.RegisterComponent<NameComponent>();
+    
+    using Event = ComponentRegistry::ComponentLifecycleEvent;
+    std::vector<std::pair<EntityID, Event>> events;
+    uint64_t callbackId = registry.RegisterComponentLifecycleCallback<TransformComponent>(
+        [&](EntityID entity, Event event) { events.emplace_back(entity, event); }
+    );
+    
+    EntityID entity{80, 1};
+    registry.AddComponent(entity, TransformComponent{});
+    registry.AddComponent(entity, NameComponent("Lifecycle"));
+    TEST_ASSERT(events.size() == 1, "只有 TransformComponent 的添加应该触发回调");
+    TEST_ASSERT(events[0].first == entity && events[0].second == Event::Added, "应该收到 Added 事件");
+    
+    registry.RemoveComponent<TransformComponent>(entity);
+    TEST_ASSERT(events.size() == 2 && events[1].second == Event::Removed, "移除组件应该触发 Removed 事件");
+    
+    // 移除不存在的组件不触发事件
+    registry.RemoveComponent<TransformComponent>(entity);
+    TEST_ASSERT(events.size() == 2, "重复移除不应该触发事件");
+    
+    // 销毁实体（RemoveAllComponents）同样触发 Removed
+    EntityID other{81, 1};
+    registry.AddComponent(other, TransformComponent{});
+    registry.RemoveAllComponents(other);
+    TEST_ASSERT(events.size() == 4 && events[3].first == other && events[3].second == Event::Removed,
+                "RemoveAllComponents 应该触发 Removed 事件");
+    
+    registry.UnregisterComponentLifecycleCallback(callbackId);
+    registry.AddComponent(entity, TransformComponent{});
+    TEST_ASSERT(events.size() == 4, "取消注册后不应该再调用回调");
+    
+    return true;
+}
+
 // ============================================================================
 // 主函数
 // ============================================================================
@@ -566,6 +608,11 @@ int main() {
     RUN_TEST(Test_ComponentArray_CallbackExceptionHandling);
     std::cout << std::endl;
     
+    // 1.4.4 测试组件生命周期事件
+    std::cout << "--- 1.4.4 测试组件生命周期事件 ---" << std::endl;
+    RUN_TEST(Test_ComponentRegistry_LifecycleEvents);
+    std::cout << std::endl;
+    
     // 输出测试结果
     std::cout << "========================================" << std::endl;
     std::cout << "测试结果统计" << std::endl;
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_frustum_cull.cpp
+ * @brief 批量视锥体裁剪测试
+ *
+ * 验证 Frustum::CullSpheres / CullAABBs 的结果与逐个调用 IntersectsSphere / IntersectsAABB 一致，
+ * 以及平面一致性缓存的写回行为（无需 GL 上下文）
+ */
+
+#include "render/camera.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/// 原点处朝 -Z 的透视视锥体（60° FOV，近 0.1，远 100）
+static Frustum MakeTestFrustum() {
+    const float fovY = 60.0f * 3.14159265f / 180.0f;
+    const float aspect = 16.0f / 9.0f;
+    const float nearPlane = 0.1f;
+    const float farPlane = 100.0f;
+    const float f = 1.0f / std::tan(fovY * 0.5f);
+
+    Matrix4 projection = Matrix4::Zero();
+    projection(0, 0) = f / aspect;
+    projection(1, 1) = f;
+    projection(2, 2) = (farPlane + nearPlane) / (nearPlane - farPlane);
+    projection(2, 3) = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+    projection(3, 2) = -1.0f;
+
+    Frustum frustum;
+    frustum.ExtractFromMatrix(projection);
+    return frustum;
+}
+
+struct SphereSet {
+    std::vector<float> x, y, z, r;
+};
+
+struct AABBSet {
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+};
+
+static SphereSet MakeSpheres(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> rad(0.1f, 8.0f);
+    SphereSet set;
+    for (size_t i = 0; i < count; ++i) {
+        set.x.push_back(pos(rng));
+        set.y.push_back(pos(rng));
+        set.z.push_back(pos(rng));
+        set.r.push_back(rad(rng));
+    }
+    return set;
+}
+
+static AABBSet MakeAABBs(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> ext(0.1f, 8.0f);
+    AABBSet set;
+    for (size_t i = 0; i < count; ++i) {
+        const float cx = pos(rng), cy = pos(rng), cz = pos(rng);
+        const float ex = ext(rng), ey = ext(rng), ez = ext(rng);
+        set.minX.push_back(cx - ex);
+        set.minY.push_back(cy - ey);
+        set.minZ.push_back(cz - ez);
+        set.maxX.push_back(cx + ex);
+        set.maxY.push_back(cy + ey);
+        set.maxZ.push_back(cz + ez);
+    }
+    return set;
+}
+
+// ============================================================================
+// 球体批量裁剪
+// ============================================================================
+
+bool Test_CullSpheres_MatchesScalar() {
+    const Frustum frustum = MakeTestFrustum();
+    const size_t count = 1003;  // 非 8 的倍数，覆盖标量尾部
+    const SphereSet spheres = MakeSpheres(count, 7);
+
+    std::vector<uint8_t> visible(count, 0xAA);
+    frustum.CullSpheres(spheres.x.data(), spheres.y.data(), spheres.z.data(), spheres.r.data(),
+                        count, visible.data());
+
+    size_t mismatches = 0;
+    size_t visibleCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const bool expected = frustum.IntersectsSphere(
+            Vector3(spheres.x[i], spheres.y[i], spheres.z[i]), spheres.r[i]);
+        if ((visible[i] != 0) != expected || visible[i] > 1) {
+            ++mismatches;
+        }
+        visibleCount += expected ? 1 : 0;
+    }
+    TEST_ASSERT(mismatches == 0, "批量球体裁剪结果应与 IntersectsSphere 一致");
+    TEST_ASSERT(visibleCount > 0 && visibleCount < count, "测试数据应同时包含可见与剔除的球体");
+    return true;
+}
+
+bool Test_CullSpheres_PlaneCache() {
+    const Frustum frustum = MakeTestFrustum();
+    const size_t count = 517;
+    const SphereSet spheres = MakeSpheres(count, 11);
+
+    std::vector<uint8_t> cache(count, 0);
+    std::vector<uint8_t> first(count, 0);
+    frustum.CullSpheres(spheres.x.data(), spheres.y.data(), spheres.z.data(), spheres.r.data(),
+                        count, first.data(), cache.data());
+
+    size_t wrongPlane = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (first[i] == 0) {
+            // 缓存的平面必须确实剔除该球体
+            const Plane& plane = frustum.planes[cache[i]];
+            const Vector3 center(spheres.x[i], spheres.y[i], spheres.z[i]);
+            if (cache[i] > 5 || plane.GetDistance(center) >= -spheres.r[i]) {
+                ++wrongPlane;
+            }
+        }
+    }
+    TEST_ASSERT(wrongPlane == 0, "剔除对象的缓存应记录剔除它的平面");
+
+    // 第二帧使用缓存结果应不变
+    std::vector<uint8_t> second(count, 0);
+    frustum.CullSpheres(spheres.x.data(), spheres.y.data(), spheres.z.data(), spheres.r.data(),
+                        count, second.data(), cache.data());
+    TEST_ASSERT(first == second, "使用平面缓存后结果应保持一致");
+
+    // 越界的缓存值应被钳制，不影响结果
+    std::vector<uint8_t> garbage(count, 200);
+    std::vector<uint8_t> third(count, 0);
+    frustum.CullSpheres(spheres.x.data(), spheres.y.data(), spheres.z.data(), spheres.r.data(),
+                        count, third.data(), garbage.data());
+    TEST_ASSERT(first == third, "越界的缓存值不应影响裁剪结果");
+    return true;
+}
+
+// ============================================================================
+// AABB 批量裁剪
+// ============================================================================
+
+bool Test_CullAABBs_MatchesScalar() {
+    const Frustum frustum = MakeTestFrustum();
+    const size_t count = 1021;
+    const AABBSet boxes = MakeAABBs(count, 23);
+
+    std::vector<uint8_t> cache(count, 0);
+    for (int frame = 0; frame < 2; ++frame) {
+        std::vector<uint8_t> visible(count, 0xAA);
+        frustum.CullAABBs(boxes.minX.data(), boxes.minY.data(), boxes.minZ.data(),
+                          boxes.maxX.data(), boxes.maxY.data(), boxes.maxZ.data(),
+                          count, visible.data(), cache.data());
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const AABB aabb(Vector3(boxes.minX[i], boxes.minY[i], boxes.minZ[i]),
+                            Vector3(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]));
+            if ((visible[i] != 0) != frustum.IntersectsAABB(aabb) || visible[i] > 1) {
+                ++mismatches;
+            }
+        }
+        TEST_ASSERT(mismatches == 0, "批量 AABB 裁剪结果应与 IntersectsAABB 一致");
+    }
+    return true;
+}
+
+bool Test_Cull_EmptyInput() {
+    const Frustum frustum = MakeTestFrustum();
+    uint8_t visible = 0xAA;
+    frustum.CullSpheres(nullptr, nullptr, nullptr, nullptr, 0, &visible);
+    frustum.CullAABBs(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0, &visible);
+    TEST_ASSERT(visible == 0xAA, "空输入不应写出结果");
+    return true;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "批量视锥体裁剪测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::cout << "\n--- 球体 ---" << std::endl;
+    RUN_TEST(Test_CullSpheres_MatchesScalar);
+    RUN_TEST(Test_CullSpheres_PlaneCache);
+
+    std::cout << "\n--- AABB ---" << std::endl;
+    RUN_TEST(Test_CullAABBs_MatchesScalar);
+    RUN_TEST(Test_Cull_EmptyInput);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
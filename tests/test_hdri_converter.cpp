@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_hdri_converter.cpp
+ * @brief HDRI 解码与立方体贴图转换测试
+ *
+ * 验证 Radiance .hdr 编解码往返（游程编码/未压缩扫描线、+Y 翻转、损坏数据）、立方体面方向约定、
+ * 并行等距柱状投影转换、辐照度球谐、预过滤 mip 链布局，以及 HDRICache 命中与失效（纯 CPU，无需 GL 上下文）
+ */
+
+#include "render/hdri_converter.h"
+#include "render/hdri_cache.h"
+#include "render/task_scheduler.h"
+#include "render/file_utils.h"
+#include "render/math_utils.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/// 构造等距柱状投影图像，像素值由 (x, y) 决定
+template<typename Func>
+static HDRImage MakeImage(int width, int height, Func&& func) {
+    HDRImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            float* p = image.pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+            func(x, y, p);
+            p[3] = 1.0f;
+        }
+    }
+    return image;
+}
+
+static std::string GetTestDirectory() {
+    return (std::filesystem::temp_directory_path() / "render_test_hdri").string();
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_RadianceRoundTrip() {
+    // 宽度 64 走游程编码（大片常量 + 渐变），宽度 5 走未压缩扫描线
+    for (int width : {64, 5}) {
+        const HDRImage source = MakeImage(width, 7, [](int x, int y, float* p) {
+            p[0] = x < 20 ? 1.5f : 0.01f * (x + 1);
+            p[1] = 100.0f * (y + 1);
+            p[2] = (x + y) % 3 == 0 ? 0.0f : 0.25f;
+        });
+        const std::vector<uint8_t> encoded = HDRIConverter::EncodeRadiance(source);
+        TEST_ASSERT(!encoded.empty(), "编码结果不应为空");
+        
+        HDRImage decoded;
+        std::string error;
+        TEST_ASSERT(HDRIConverter::DecodeRadiance(encoded.data(), encoded.size(), decoded, &error), "解码应成功: " + error);
+        TEST_ASSERT(decoded.width == width && decoded.height == 7, "尺寸应一致");
+        
+        // 共享指数：各通道误差相对于像素最大通道
+        bool match = true;
+        for (size_t i = 0; i < source.pixels.size(); i += 4) {
+            const float peak = std::max(source.pixels[i], std::max(source.pixels[i + 1], source.pixels[i + 2]));
+            for (size_t c = 0; c < 3; ++c) {
+                match = match && std::abs(source.pixels[i + c] - decoded.pixels[i + c]) <= peak / 64.0f;
+            }
+            match = match && decoded.pixels[i + 3] == 1.0f;
+        }
+        TEST_ASSERT(match, "往返后像素应在 RGBE 精度内一致");
+    }
+    
+    // 游程编码应明显小于未压缩大小（常量图像）
+    const HDRImage flat = MakeImage(256, 4, [](int, int, float* p) { p[0] = p[1] = p[2] = 2.0f; });
+    const std::vector<uint8_t> compressed = HDRIConverter::EncodeRadiance(flat);
+    TEST_ASSERT(compressed.size() < 256 * 4 * 4 / 4, "常量扫描线应被游程编码压缩");
+    return true;
+}
+
+bool Test_RadianceHeaderAndErrors() {
+    // "+Y" 表示自下而上存储：第一条扫描线应成为图像底部
+    std::string text = "#?RGBE\n# comment\nEXPOSURE=1.0\n\n+Y 2 +X 1\n";
+    std::vector<uint8_t> data(text.begin(), text.end());
+    const uint8_t bottom[4] = {128, 0, 0, 129};   // (1, 0, 0)
+    const uint8_t top[4] = {0, 128, 0, 130};      // (0, 2, 0)
+    data.insert(data.end(), bottom, bottom + 4);
+    data.insert(data.end(), top, top + 4);
+    
+    HDRImage image;
+    TEST_ASSERT(HDRIConverter::DecodeRadiance(data.data(), data.size(), image), "+Y 图像应可解码");
+    TEST_ASSERT(image.width == 1 && image.height == 2, "尺寸应为 1x2");
+    TEST_ASSERT(image.pixels[1] == 2.0f && image.pixels[4] == 1.0f, "第 0 行应为图像顶部");
+    
+    std::string error;
+    const std::string xyze = "#?RADIANCE\nFORMAT=32-bit_rle_xyze\n\n-Y 1 +X 1\n";
+    TEST_ASSERT(!HDRIConverter::DecodeRadiance(reinterpret_cast<const uint8_t*>(xyze.data()), xyze.size(), image, &error),
+                "XYZE 格式应被拒绝");
+    TEST_ASSERT(!error.empty(), "失败时应给出原因");
+    
+    const std::string png = "\x89PNG\r\n";
+    TEST_ASSERT(!HDRIConverter::DecodeRadiance(reinterpret_cast<const uint8_t*>(png.data()), png.size(), image),
+                "缺少签名应被拒绝");
+    
+    // 截断的游程编码数据
+    const HDRImage source = MakeImage(32, 4, [](int x, int, float* p) { p[0] = p[1] = p[2] = 0.1f * x; });
+    std::vector<uint8_t> encoded = HDRIConverter::EncodeRadiance(source);
+    encoded.resize(encoded.size() - 10);
+    TEST_ASSERT(!HDRIConverter::DecodeRadiance(encoded.data(), encoded.size(), image, &error), "截断数据应被拒绝");
+    TEST_ASSERT(!image.IsValid(), "失败时输出应为空");
+    
+    // 头部声明的尺寸远超剩余数据时应在分配像素前拒绝
+    const std::string huge = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y 8192 +X 16384\n";
+    error.clear();
+    TEST_ASSERT(!HDRIConverter::DecodeRadiance(reinterpret_cast<const uint8_t*>(huge.data()), huge.size(), image, &error),
+                "数据不足以容纳声明的扫描线时应被拒绝");
+    TEST_ASSERT(error == "truncated pixel data", "应在分配前报告数据截断: " + error);
+    
+    const std::string oversized = "#?RADIANCE\n\n-Y 32768 +X 65536\n";
+    TEST_ASSERT(!HDRIConverter::DecodeRadiance(reinterpret_cast<const uint8_t*>(oversized.data()), oversized.size(), image),
+                "超出等距柱状源图上限的尺寸应被拒绝");
+    return true;
+}
+
+bool Test_FaceDirections() {
+    const Vector3 expected[6] = {
+        Vector3::UnitX(), -Vector3::UnitX(), Vector3::UnitY(), -Vector3::UnitY(), Vector3::UnitZ(), -Vector3::UnitZ()
+    };
+    for (int face = 0; face < 6; ++face) {
+        const Vector3 center = HDRIConverter::CubemapTexelDirection(face, 1, 1, 3);
+        TEST_ASSERT((center - expected[face]).norm() < 1e-5f, "面中心方向应与 OpenGL 约定一致");
+    }
+    
+    // +X 面：s 增大 → -Z，t 增大 → -Y
+    const Vector3 corner = HDRIConverter::CubemapTexelDirection(0, 3, 3, 4);
+    TEST_ASSERT(corner.z() < 0.0f && corner.y() < 0.0f, "+X 面右下角应指向 -Z、-Y");
+    
+    float u = 0.0f;
+    float v = 0.0f;
+    HDRIConverter::DirectionToEquirect(Vector3::UnitY(), u, v);
+    TEST_ASSERT(std::abs(v) < 1e-5f, "+Y 应映射到图像顶部");
+    HDRIConverter::DirectionToEquirect(Vector3::UnitX(), u, v);
+    TEST_ASSERT(std::abs(u - 0.5f) < 1e-5f && std::abs(v - 0.5f) < 1e-5f, "+X 应映射到图像中心");
+    
+    // 水平环绕：u 接近 0 与接近 1 时应在左右边缘之间插值
+    const HDRImage image = MakeImage(4, 2, [](int x, int, float* p) { p[0] = p[1] = p[2] = x == 0 ? 1.0f : (x == 3 ? 3.0f : 0.0f); });
+    float sample[4];
+    HDRIConverter::SampleBilinear(image, 0.0f, 0.5f, sample);
+    TEST_ASSERT(std::abs(sample[0] - 2.0f) < 1e-5f, "u = 0 应为首尾两列的平均");
+    return true;
+}
+
+bool Test_ConvertAndIrradiance() {
+    auto& scheduler = TaskScheduler::GetInstance();
+    scheduler.Initialize(2);
+    
+    // 常量环境：所有面都为常量，辐照度 E = π·L
+    const HDRImage constant = MakeImage(64, 32, [](int, int, float* p) { p[0] = 1.0f; p[1] = 0.5f; p[2] = 2.0f; });
+    HDRCubemapOptions options;
+    options.resolution = 16;
+    options.useDiskCache = false;
+    HDRCubemapData data;
+    TEST_ASSERT(HDRIConverter::Convert(constant, options, data), "转换应成功");
+    TEST_ASSERT(data.resolution == 16 && data.levels.size() == 1 && !data.prefiltered, "默认只输出基础级别");
+    TEST_ASSERT(data.pixels.size() == 16u * 16u * 6u * 4u, "像素数应为 6 面 RGBA");
+    
+    bool allConstant = true;
+    for (size_t i = 0; i < data.pixels.size(); i += 4) {
+        allConstant = allConstant && std::abs(data.pixels[i] - 1.0f) < 1e-5f &&
+                      std::abs(data.pixels[i + 2] - 2.0f) < 1e-5f && data.pixels[i + 3] == 1.0f;
+    }
+    TEST_ASSERT(allConstant, "常量环境转换后应保持常量");
+    
+    TEST_ASSERT(data.hasIrradianceSH, "默认应计算辐照度球谐");
+    for (const Vector3& n : {Vector3(0, 1, 0), Vector3(1, 0, 0), Vector3(0.3f, -0.7f, 0.2f)}) {
+        const Vector3 e = HDRIConverter::EvaluateIrradianceSH(data.irradianceSH, n);
+        TEST_ASSERT(std::abs(e.x() - MathUtils::PI) < 0.02f, "常量环境辐照度应为 π·L");
+        TEST_ASSERT(std::abs(e.z() - 2.0f * MathUtils::PI) < 0.04f, "辐照度应与亮度成正比");
+    }
+    
+    // 上半球亮、下半球暗：+Y 面应全亮，-Y 面应全暗，辐照度向上大于向下
+    const HDRImage sky = MakeImage(128, 64, [](int, int y, float* p) { p[0] = p[1] = p[2] = y < 32 ? 4.0f : 0.0f; });
+    TEST_ASSERT(HDRIConverter::Convert(sky, options, data), "转换应成功");
+    TEST_ASSERT(data.GetFace(0, 2)[0] == 4.0f && data.GetFace(0, 3)[0] == 0.0f, "+Y 面亮、-Y 面暗");
+    const float up = HDRIConverter::EvaluateIrradianceSH(data.irradianceSH, Vector3::UnitY()).x();
+    const float down = HDRIConverter::EvaluateIrradianceSH(data.irradianceSH, -Vector3::UnitY()).x();
+    const float side = HDRIConverter::EvaluateIrradianceSH(data.irradianceSH, Vector3::UnitX()).x();
+    TEST_ASSERT(up > side && side > down, "辐照度应随法线朝上单调增大");
+    TEST_ASSERT(std::abs(side - 2.0f * MathUtils::PI) < 0.2f, "水平法线应接收一半天空辐照度");
+    
+    scheduler.Shutdown();
+    return true;
+}
+
+bool Test_PrefilterLevels() {
+    const HDRImage constant = MakeImage(64, 32, [](int, int, float* p) { p[0] = p[1] = p[2] = 3.0f; });
+    HDRCubemapOptions options;
+    options.resolution = 16;
+    options.specularMipLevels = 4;
+    options.specularSampleCount = 16;
+    options.computeIrradianceSH = false;
+    options.useDiskCache = false;
+    
+    HDRCubemapData data;
+    TEST_ASSERT(HDRIConverter::Convert(constant, options, data), "预过滤转换应成功");
+    TEST_ASSERT(data.prefiltered && data.levels.size() == 4, "应输出 4 个预过滤级别");
+    TEST_ASSERT(!data.hasIrradianceSH, "关闭后不应计算球谐");
+    
+    size_t expectedOffset = 0;
+    for (size_t level = 0; level < data.levels.size(); ++level) {
+        TEST_ASSERT(data.levels[level].resolution == (16 >> level), "级别分辨率应逐级减半");
+        TEST_ASSERT(data.levels[level].offset == expectedOffset, "级别应紧密排列");
+        expectedOffset += static_cast<size_t>(16 >> level) * (16 >> level) * 6 * 4;
+    }
+    TEST_ASSERT(data.pixels.size() == expectedOffset, "像素总数应与级别布局一致");
+    
+    bool allConstant = true;
+    for (size_t i = 0; i < data.pixels.size(); i += 4) {
+        allConstant = allConstant && std::abs(data.pixels[i] - 3.0f) < 1e-3f;
+    }
+    TEST_ASSERT(allConstant, "常量环境预过滤后应保持常量");
+    
+    // 点光源：高粗糙度级别应把能量扩散到更多像素
+    const HDRImage spot = MakeImage(64, 32, [](int x, int y, float* p) {
+        p[0] = p[1] = p[2] = (x == 32 && y == 16) ? 1000.0f : 0.0f;
+    });
+    TEST_ASSERT(HDRIConverter::Convert(spot, options, data), "预过滤转换应成功");
+    auto litFraction = [&](size_t level) {
+        const int res = data.levels[level].resolution;
+        size_t lit = 0;
+        for (int face = 0; face < 6; ++face) {
+            const float* p = data.GetFace(level, face);
+            for (int i = 0; i < res * res; ++i) {
+                lit += p[i * 4] > 1e-4f ? 1 : 0;
+            }
+        }
+        return static_cast<float>(lit) / static_cast<float>(res * res * 6);
+    };
+    TEST_ASSERT(litFraction(3) > litFraction(1), "粗糙度越高覆盖范围应越大");
+    
+    // 级数超过完整 mip 链时截断
+    options.specularMipLevels = 20;
+    options.resolution = 8;
+    TEST_ASSERT(HDRIConverter::Convert(constant, options, data), "转换应成功");
+    TEST_ASSERT(data.levels.size() == 4 && data.levels.back().resolution == 1, "级数应截断到 log2(8) + 1");
+    return true;
+}
+
+bool Test_DiskCache() {
+    const std::string directory = GetTestDirectory();
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    
+    HDRICache& cache = HDRICache::GetInstance();
+    cache.SetCacheDirectory((std::filesystem::path(directory) / "cache").string());
+    cache.ResetStats();
+    
+    const HDRImage image = MakeImage(32, 16, [](int x, int y, float* p) { p[0] = 0.1f * x; p[1] = 0.2f * y; p[2] = 1.0f; });
+    const std::string hdrPath = (std::filesystem::path(directory) / "sky.hdr").string();
+    {
+        const std::vector<uint8_t> encoded = HDRIConverter::EncodeRadiance(image);
+        std::ofstream out(hdrPath, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+    }
+    
+    HDRCubemapOptions options;
+    options.resolution = 8;
+    options.specularMipLevels = 2;
+    options.specularSampleCount = 8;
+    
+    HDRCubemapData first;
+    TEST_ASSERT(HDRIConverter::LoadFromFile(hdrPath, options, first), "首次加载应成功");
+    TEST_ASSERT(cache.GetStats().misses == 1 && cache.GetStats().writes == 1, "首次加载应未命中并写入缓存");
+    
+    HDRCubemapData second;
+    TEST_ASSERT(HDRIConverter::LoadFromFile(hdrPath, options, second), "再次加载应成功");
+    TEST_ASSERT(cache.GetStats().hits == 1, "再次加载应命中缓存");
+    TEST_ASSERT(second.resolution == first.resolution && second.levels.size() == first.levels.size() &&
+                second.prefiltered && second.hasIrradianceSH, "缓存应保留级别与标志");
+    TEST_ASSERT(second.pixels == first.pixels, "缓存像素应与转换结果完全一致");
+    TEST_ASSERT(second.irradianceSH[4] == first.irradianceSH[4], "缓存应保留球谐系数");
+    
+    // 选项不同 → 键不同；采样数只在预过滤时参与
+    HDRCubemapOptions other = options;
+    other.resolution = 16;
+    TEST_ASSERT(HDRICache::BuildKey(1, options) != HDRICache::BuildKey(1, other), "分辨率应参与缓存键");
+    other = options;
+    other.useDiskCache = false;
+    TEST_ASSERT(HDRICache::BuildKey(1, options) == HDRICache::BuildKey(1, other), "useDiskCache 不应参与缓存键");
+    other = options;
+    other.specularMipLevels = 0;
+    HDRCubemapOptions otherSamples = other;
+    otherSamples.specularSampleCount = 999;
+    TEST_ASSERT(HDRICache::BuildKey(1, other) == HDRICache::BuildKey(1, otherSamples), "未预过滤时采样数不应参与缓存键");
+    otherSamples.specularMipLevels = 1;
+    TEST_ASSERT(HDRICache::BuildKey(1, other) == HDRICache::BuildKey(1, otherSamples), "0 与 1 级输出相同，缓存键应相同");
+    otherSamples = options;
+    otherSamples.specularMipLevels = 100;
+    other = options;
+    other.specularMipLevels = HDRIConverter::GetSpecularLevelCount(otherSamples);
+    TEST_ASSERT(HDRICache::BuildKey(1, other) == HDRICache::BuildKey(1, otherSamples), "超出 mip 链的级数应按钳制后的值参与缓存键");
+    otherSamples.specularSampleCount = options.specularSampleCount + 1;
+    TEST_ASSERT(HDRICache::BuildKey(1, other) != HDRICache::BuildKey(1, otherSamples), "预过滤时采样数应参与缓存键");
+    
+    // 截断的缓存文件应视为未命中并重新转换
+    const uint64_t key = HDRICache::BuildKey(FileUtils::HashFile(hdrPath), options);
+    const std::string cachePath = cache.GetCachePath(key);
+    TEST_ASSERT(std::filesystem::exists(cachePath), "缓存文件应存在");
+    std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) - 4);
+    HDRCubemapData reloaded;
+    TEST_ASSERT(!cache.Load(key, reloaded) && !reloaded.IsValid(), "截断的缓存应未命中");
+    TEST_ASSERT(HDRIConverter::LoadFromFile(hdrPath, options, reloaded), "缓存损坏时应回退到转换");
+    TEST_ASSERT(reloaded.pixels == first.pixels, "回退转换结果应一致");
+    
+    TEST_ASSERT(cache.ClearDiskCache() == 1, "应删除 1 个缓存文件");
+    
+    std::string error;
+    TEST_ASSERT(!HDRIConverter::LoadFromFile((std::filesystem::path(directory) / "missing.hdr").string(), options, reloaded, &error),
+                "缺失文件应失败");
+    TEST_ASSERT(!error.empty(), "失败时应给出原因");
+    
+    std::filesystem::remove_all(directory);
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "HDRI 转换测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_RadianceRoundTrip);
+    RUN_TEST(Test_RadianceHeaderAndErrors);
+    RUN_TEST(Test_FaceDirections);
+    RUN_TEST(Test_ConvertAndIrradiance);
+    RUN_TEST(Test_PrefilterLevels);
+    RUN_TEST(Test_DiskCache);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
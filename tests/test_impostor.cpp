@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_impostor.cpp
+ * @brief 八面体替身测试
+ *
+ * 验证八面体编码/解码往返、帧选择与帧基、CPU 软件光栅化烘焙的覆盖率与对称性，
+ * 以及 LODConfig 的 Impostor 级别选择（无需 GL 上下文）
+ */
+
+#include "render/impostor.h"
+#include "render/lod_system.h"
+#include <cmath>
+#include <iostream>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/**
+ * @brief 创建沿 x 轴拉长的盒子（2 × 1 × 1），每个面独立顶点与法线
+ */
+static Ref<Mesh> MakeBoxMesh(const Color& color) {
+    const Vector3 halfSize(1.0f, 0.5f, 0.5f);
+    const Vector3 normals[6] = {
+        Vector3::UnitX(), -Vector3::UnitX(), Vector3::UnitY(),
+        -Vector3::UnitY(), Vector3::UnitZ(), -Vector3::UnitZ()
+    };
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    for (const Vector3& n : normals) {
+        // 面内两个切向轴
+        const Vector3 a = std::abs(n.y()) > 0.5f ? Vector3::UnitX() : Vector3::UnitY();
+        const Vector3 b = n.cross(a);
+        const uint32_t base = static_cast<uint32_t>(vertices.size());
+        const float signs[4][2] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+        for (const auto& s : signs) {
+            Vertex v(Vector3((n + a * s[0] + b * s[1]).cwiseProduct(halfSize)));
+            v.normal = n;
+            v.color = color;
+            vertices.push_back(v);
+        }
+        indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+    return CreateRef<Mesh>(vertices, indices);
+}
+
+static bool NearlyEqual(const Vector3& a, const Vector3& b, float eps = 1e-4f) {
+    return (a - b).norm() < eps;
+}
+
+// ============================================================================
+// 测试
+// ============================================================================
+
+static bool Test_OctahedralRoundTrip() {
+    const Vector3 directions[] = {
+        Vector3::UnitX(), -Vector3::UnitX(), Vector3::UnitY(), -Vector3::UnitY(),
+        Vector3::UnitZ(), -Vector3::UnitZ(),
+        Vector3(1, 1, 1).normalized(), Vector3(-1, -2, 0.5f).normalized(),
+        Vector3(0.3f, -0.1f, -0.9f).normalized(), Vector3(-0.7f, 0.2f, 0.1f).normalized()
+    };
+    for (const Vector3& d : directions) {
+        const Vector2 encoded = ImpostorAtlas::OctahedralEncode(d);
+        TEST_ASSERT(std::abs(encoded.x()) <= 1.0f && std::abs(encoded.y()) <= 1.0f, "编码应位于 [-1, 1]²");
+        TEST_ASSERT(NearlyEqual(ImpostorAtlas::OctahedralDecode(encoded), d), "解码应还原方向");
+    }
+    return true;
+}
+
+static bool Test_FrameSelectionAndBasis() {
+    const int frames = 8;
+    for (int y = 0; y < frames; ++y) {
+        for (int x = 0; x < frames; ++x) {
+            const Vector3 dir = ImpostorAtlas::GetFrameDirection(x, y, frames);
+            int sx = -1, sy = -1;
+            ImpostorAtlas::SelectFrame(dir, frames, sx, sy);
+            TEST_ASSERT(sx == x && sy == y, "帧中心方向应选中自身");
+            
+            Vector3 right, up;
+            ImpostorAtlas::GetFrameBasis(dir, right, up);
+            TEST_ASSERT(std::abs(right.norm() - 1.0f) < 1e-4f && std::abs(up.norm() - 1.0f) < 1e-4f, "帧基应为单位向量");
+            TEST_ASSERT(std::abs(right.dot(up)) < 1e-4f && std::abs(right.dot(dir)) < 1e-4f, "帧基应正交");
+        }
+    }
+    
+    // 非中心方向选中编码所在的单元
+    int sx = -1, sy = -1;
+    ImpostorAtlas::SelectFrame(Vector3(0.0f, 1.0f, 0.0f), frames, sx, sy);
+    TEST_ASSERT(sx >= 0 && sx < frames && sy >= 0 && sy < frames, "极点方向应选中有效帧");
+    return true;
+}
+
+static bool Test_CPUBakeCoverage() {
+    auto mesh = MakeBoxMesh(Color(1.0f, 0.2f, 0.2f, 1.0f));
+    ImpostorBakeOptions options;
+    options.framesPerAxis = 4;
+    options.atlasSize = 256;
+    options.backend = ImpostorBakeBackend::CPU;
+    
+    ImpostorAtlas atlas = ImpostorAtlas::Bake(mesh, nullptr, options);
+    TEST_ASSERT(atlas.IsValid(), "CPU 烘焙应成功");
+    TEST_ASSERT(atlas.GetFrameSize() == 64, "帧尺寸应为 64");
+    TEST_ASSERT(atlas.GetPixels().size() == 256u * 256u * 4u, "像素数据大小应正确");
+    TEST_ASSERT(std::abs(atlas.GetRadius() - std::sqrt(1.5f)) < 1e-3f, "包围球半径应为中心到角点距离");
+    
+    const size_t frameArea = static_cast<size_t>(atlas.GetFrameSize()) * atlas.GetFrameSize();
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            const size_t coverage = atlas.CountFrameCoverage(x, y);
+            TEST_ASSERT(coverage > 0 && coverage < frameArea, "每帧都应部分覆盖");
+        }
+    }
+    
+    // 相反方向的轮廓互为镜像，覆盖率应一致
+    int ax, ay, bx, by;
+    const Vector3 dir = ImpostorAtlas::GetFrameDirection(1, 2, 4);
+    ImpostorAtlas::SelectFrame(dir, 4, ax, ay);
+    ImpostorAtlas::SelectFrame(-dir, 4, bx, by);
+    const double coverageA = static_cast<double>(atlas.CountFrameCoverage(ax, ay));
+    const double coverageB = static_cast<double>(atlas.CountFrameCoverage(bx, by));
+    TEST_ASSERT(std::abs(coverageA - coverageB) / coverageA < 0.05, "相反方向帧覆盖率应接近");
+    
+    // 沿长轴观察的轮廓小于侧面观察
+    int lx, ly, sx, sy;
+    ImpostorAtlas::SelectFrame(Vector3(1.0f, 0.1f, 0.1f).normalized(), 4, lx, ly);
+    ImpostorAtlas::SelectFrame(Vector3(0.1f, 0.1f, 1.0f).normalized(), 4, sx, sy);
+    TEST_ASSERT(atlas.CountFrameCoverage(lx, ly) < atlas.CountFrameCoverage(sx, sy), "长轴方向轮廓应更小");
+    
+    // 着色颜色来自顶点颜色
+    const auto& pixels = atlas.GetPixels();
+    size_t redDominant = 0, opaque = 0;
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        if (pixels[i + 3] == 255) {
+            opaque++;
+            redDominant += pixels[i] > pixels[i + 1] ? 1 : 0;
+        }
+    }
+    TEST_ASSERT(opaque > 0 && redDominant == opaque, "不透明像素应保留红色顶点颜色");
+    return true;
+}
+
+static bool Test_BakeRejectsInvalidInput() {
+    ImpostorBakeOptions options;
+    options.backend = ImpostorBakeBackend::CPU;
+    TEST_ASSERT(!ImpostorAtlas::Bake(nullptr, nullptr, options).IsValid(), "空网格应烘焙失败");
+    
+    options.framesPerAxis = 0;
+    auto mesh = MakeBoxMesh(Color::White());
+    TEST_ASSERT(!ImpostorAtlas::Bake(mesh, nullptr, options).IsValid(), "无效帧布局应烘焙失败");
+    return true;
+}
+
+static bool Test_LODConfigImpostorLevel() {
+    LODConfig config;
+    config.distanceThresholds = {10.0f, 20.0f, 30.0f, 40.0f, 100.0f};
+    auto lod3Mesh = MakeBoxMesh(Color::White());
+    config.lodMeshes = {nullptr, nullptr, nullptr, lod3Mesh};
+    
+    // 未配置替身：第 5 个阈值被忽略
+    TEST_ASSERT(!config.HasImpostor(), "默认不应配置替身");
+    TEST_ASSERT(config.CalculateLOD(35.0f) == LODLevel::LOD3, "35 应为 LOD3");
+    TEST_ASSERT(config.CalculateLOD(50.0f) == LODLevel::Culled, "未配置替身时 50 应剔除");
+    TEST_ASSERT(config.GetLODMesh(LODLevel::Impostor, nullptr) == lod3Mesh, "未配置替身时回退到 LOD3 网格");
+    
+    config.impostorMesh = MakeBoxMesh(Color::White());
+    config.impostorMaterial = CreateRef<Material>();
+    TEST_ASSERT(config.HasImpostor(), "应配置替身");
+    TEST_ASSERT(config.CalculateLOD(50.0f) == LODLevel::Impostor, "50 应为 Impostor");
+    TEST_ASSERT(config.CalculateLOD(150.0f) == LODLevel::Culled, "超出替身距离应剔除");
+    TEST_ASSERT(config.GetLODMesh(LODLevel::Impostor, nullptr) == config.impostorMesh, "应返回替身网格");
+    TEST_ASSERT(config.GetLODMaterial(LODLevel::Impostor, nullptr) == config.impostorMaterial, "应返回替身材质");
+    
+    // 屏幕空间误差模式下替身区间仍使用替身
+    config.lodGeometricErrors = {0.0f, 0.1f, 0.2f, 0.4f};
+    TEST_ASSERT(config.CalculateLODFromScreenError(50.0f, 1000.0f) == LODLevel::Impostor, "屏幕误差模式替身区间应为 Impostor");
+    
+    // 滞后：刚越过替身阈值时保持 LOD3，越过替身结束阈值时保持 Impostor
+    config.useHysteresis = true;
+    config.transitionDistance = 5.0f;
+    TEST_ASSERT(config.CalculateLOD(42.0f, LODLevel::LOD3) == LODLevel::LOD3, "滞后带内应保持 LOD3");
+    TEST_ASSERT(config.CalculateLOD(102.0f, LODLevel::Impostor) == LODLevel::Impostor, "滞后带内应保持 Impostor");
+    TEST_ASSERT(config.CalculateLOD(110.0f, LODLevel::Impostor) == LODLevel::Culled, "越过滞后带应剔除");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "八面体替身测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_OctahedralRoundTrip);
+    RUN_TEST(Test_FrameSelectionAndBasis);
+    RUN_TEST(Test_CPUBakeCoverage);
+    RUN_TEST(Test_BakeRejectsInvalidInput);
+    RUN_TEST(Test_LODConfigImpostorLevel);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
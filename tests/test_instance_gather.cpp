@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_instance_gather.cpp
+ * @brief LOD 实例并行收集测试
+ *
+ * 验证 64 字节紧凑实例记录的矩阵/颜色往返以及收集桶按组追加（无需 GL 上下文）
+ */
+
+#include "render/lod_instanced_renderer.h"
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_CompactInstance_RoundTrip() {
+    TEST_ASSERT(sizeof(CompactInstanceData) == 64, "紧凑记录应为 64 字节");
+    TEST_ASSERT(alignof(CompactInstanceData) == 64, "紧凑记录应按缓存行对齐");
+
+    Matrix4 matrix = Matrix4::Identity();
+    matrix.block<3, 3>(0, 0) = Eigen::AngleAxisf(0.7f, Vector3(0.0f, 1.0f, 0.0f)).toRotationMatrix() * 2.0f;
+    matrix.block<3, 1>(0, 3) = Vector3(10.0f, -5.0f, 3.5f);
+
+    const CompactInstanceData record(matrix, 0x80402010u, 42);
+    TEST_ASSERT(record.ToMatrix4().isApprox(matrix), "矩阵应无损往返");
+    TEST_ASSERT(record.entityIndex == 42, "实体索引应保留");
+
+    const uint32_t packed = CompactInstanceData::PackColor(Color(1.0f, 0.5f, 0.0f, 0.25f));
+    TEST_ASSERT((packed & 0xFFu) == 255 && ((packed >> 8) & 0xFFu) == 128, "R 位于最低字节，按四舍五入量化");
+    const Vector4 unpacked = CompactInstanceData::UnpackColor(packed);
+    TEST_ASSERT(std::abs(unpacked.x() - 1.0f) < 1e-6f && std::abs(unpacked.y() - 0.5f) < 1.0f / 255.0f &&
+                unpacked.z() == 0.0f && std::abs(unpacked.w() - 0.25f) < 1.0f / 255.0f,
+                "颜色解包误差应小于一个量化级");
+    TEST_ASSERT(CompactInstanceData::PackColor(Color(2.0f, -1.0f, 0.0f, 1.0f)) == 0xFF0000FFu, "超出范围的分量应截断");
+    return true;
+}
+
+bool Test_GatherBucket_Append() {
+    InstanceGatherBucket bucket;
+    Matrix4 matrix = Matrix4::Identity();
+    for (uint32_t i = 0; i < 10; ++i) {
+        matrix(0, 3) = static_cast<float>(i);
+        bucket.Append(i % 3, matrix, 0xFFFFFFFFu, i);
+    }
+    bucket.Append(InstanceGatherBucket::kInvalidGroup, matrix);
+    TEST_ASSERT(bucket.GetInstanceCount() == 10, "无效组索引应被忽略");
+
+    CompactInstanceData record(matrix, 0u, 99);
+    bucket.Append(7, record);
+    TEST_ASSERT(bucket.GetInstanceCount() == 11, "应支持稀疏组索引");
+    return true;
+}
+
+bool Test_GatherBucket_PerThread() {
+    constexpr size_t kThreads = 4;
+    constexpr size_t kPerThread = 10000;
+    std::vector<InstanceGatherBucket> buckets(kThreads);
+    TEST_ASSERT(reinterpret_cast<uintptr_t>(&buckets[1]) % 64 == 0, "桶应按缓存行对齐，避免伪共享");
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&buckets, t]() {
+            Matrix4 matrix = Matrix4::Identity();
+            for (size_t i = 0; i < kPerThread; ++i) {
+                matrix(1, 3) = static_cast<float>(i);
+                buckets[t].Append(static_cast<uint32_t>(i % 5), matrix);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    size_t total = 0;
+    for (const auto& bucket : buckets) {
+        total += bucket.GetInstanceCount();
+    }
+    TEST_ASSERT(total == kThreads * kPerThread, "各线程写入自己的桶时不应丢失实例");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "LOD 实例并行收集测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_CompactInstance_RoundTrip);
+    RUN_TEST(Test_GatherBucket_Append);
+    RUN_TEST(Test_GatherBucket_PerThread);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_lod_cache.cpp
+ * @brief LOD 磁盘缓存测试
+ *
+ * 验证 LODCache 的写入/内存映射读取往返、缓存键对源数据与简化选项的敏感性，
+ * 以及损坏文件的拒绝（无需 GL 上下文，网格不上传）
+ */
+
+#include "render/lod_cache.h"
+#include "render/file_utils.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+static Ref<Mesh> MakeGridMesh(int size, float z) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    for (int y = 0; y <= size; ++y) {
+        for (int x = 0; x <= size; ++x) {
+            Vertex v(Vector3(static_cast<float>(x), static_cast<float>(y), z));
+            v.texCoord = Vector2(x / static_cast<float>(size), y / static_cast<float>(size));
+            v.color = Color(0.25f, 0.5f, 0.75f, 1.0f);
+            vertices.push_back(v);
+        }
+    }
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            uint32_t i0 = y * (size + 1) + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + size + 1;
+            uint32_t i3 = i2 + 1;
+            indices.insert(indices.end(), {i0, i2, i1, i1, i2, i3});
+        }
+    }
+    return std::make_shared<Mesh>(vertices, indices);
+}
+
+static std::string TestCacheDirectory() {
+    return (std::filesystem::temp_directory_path() / "render_test_lod_cache").string();
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_HashKeys() {
+    auto meshA = MakeGridMesh(4, 0.0f);
+    auto meshB = MakeGridMesh(4, 1.0f);
+    TEST_ASSERT(LODCache::HashMesh(meshA) != 0, "非空网格哈希不应为 0");
+    TEST_ASSERT(LODCache::HashMesh(meshA) == LODCache::HashMesh(MakeGridMesh(4, 0.0f)), "相同数据哈希应一致");
+    TEST_ASSERT(LODCache::HashMesh(meshA) != LODCache::HashMesh(meshB), "不同数据哈希应不同");
+    TEST_ASSERT(LODCache::HashMesh(nullptr) == 0, "空网格哈希为 0");
+
+    // 同一源文件的不同子网格必须得到不同的源哈希
+    const std::string sourcePath = (std::filesystem::temp_directory_path() / "render_test_lod_source.bin").string();
+    {
+        std::ofstream out(sourcePath, std::ios::binary);
+        out << "multi-mesh source";
+    }
+    TEST_ASSERT(LODCache::HashSource(sourcePath, meshA) != LODCache::HashSource(sourcePath, meshB),
+                "同一文件的不同网格源哈希应不同");
+    TEST_ASSERT(LODCache::HashSource(sourcePath, meshA) != LODCache::HashMesh(meshA), "文件内容应参与源哈希");
+    TEST_ASSERT(LODCache::HashSource("", meshA) == LODCache::HashMesh(meshA), "无文件时只使用网格哈希");
+    std::filesystem::remove(sourcePath);
+
+    LODGenerator::SimplifyOptions options;
+    LODGenerator::SimplifyOptions uploadOff = options;
+    uploadOff.uploadToGPU = false;
+    LODGenerator::SimplifyOptions lockBorder = options;
+    lockBorder.flags |= LODGenerator::SimplifyOptions::LockBorder;
+
+    const uint64_t source = LODCache::HashMesh(meshA);
+    TEST_ASSERT(LODCache::BuildKey(source, options) == LODCache::BuildKey(source, uploadOff),
+                "uploadToGPU 不应影响缓存键");
+    TEST_ASSERT(LODCache::BuildKey(source, options) != LODCache::BuildKey(source, lockBorder),
+                "简化标志应影响缓存键");
+    TEST_ASSERT(LODCache::BuildKey(source, options) != LODCache::BuildKey(LODCache::HashMesh(meshB), options),
+                "源数据应影响缓存键");
+    return true;
+}
+
+bool Test_StoreLoadRoundTrip() {
+    auto& cache = LODCache::GetInstance();
+    cache.SetCacheDirectory(TestCacheDirectory());
+    cache.ClearDiskCache();
+    cache.ResetStats();
+
+    std::vector<Ref<Mesh>> lods = {MakeGridMesh(8, 0.0f), nullptr, MakeGridMesh(2, 0.0f)};
+    std::vector<float> errors = {0.01f, -1.0f, 0.2f};
+    const uint64_t key = 0x1234abcdULL;
+
+    std::vector<Ref<Mesh>> loaded;
+    std::vector<float> loadedErrors;
+    TEST_ASSERT(!cache.Load(key, loaded, loadedErrors), "写入前应未命中");
+    TEST_ASSERT(cache.Store(key, lods, errors), "写入应成功");
+    TEST_ASSERT(FileUtils::FileExists(cache.GetCachePath(key)), "缓存文件应存在");
+
+    TEST_ASSERT(cache.Load(key, loaded, loadedErrors), "写入后应命中");
+    TEST_ASSERT(loaded.size() == 3 && loadedErrors.size() == 3, "级别数应一致");
+    TEST_ASSERT(loaded[1] == nullptr && loadedErrors[1] == -1.0f, "缺失级别应保持为空");
+    TEST_ASSERT(loaded[0] && loaded[0]->GetVertexCount() == lods[0]->GetVertexCount() &&
+                loaded[0]->GetIndexCount() == lods[0]->GetIndexCount(), "顶点/索引数量应一致");
+    TEST_ASSERT(std::abs(loadedErrors[2] - 0.2f) < 1e-6f, "几何误差应保留");
+    TEST_ASSERT(LODCache::HashMesh(loaded[0]) == LODCache::HashMesh(lods[0]), "顶点与索引数据应逐位一致");
+    TEST_ASSERT(!loaded[0]->IsUploaded(), "缓存读取的网格不应上传");
+
+    auto stats = cache.GetStats();
+    TEST_ASSERT(stats.hits == 1 && stats.misses == 1 && stats.writes == 1, "统计应正确");
+    return true;
+}
+
+bool Test_RejectCorruptedFile() {
+    auto& cache = LODCache::GetInstance();
+    const uint64_t key = 0x5555ULL;
+    std::vector<Ref<Mesh>> lods = {MakeGridMesh(4, 0.0f)};
+    TEST_ASSERT(cache.Store(key, lods, {0.05f}), "写入应成功");
+
+    // 截断文件：数据区越界应被拒绝
+    const std::string path = cache.GetCachePath(key);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    std::vector<Ref<Mesh>> loaded;
+    std::vector<float> loadedErrors;
+    TEST_ASSERT(!cache.Load(key, loaded, loadedErrors), "截断的缓存文件应被拒绝");
+    TEST_ASSERT(loaded.empty(), "拒绝时不应输出网格");
+
+    // 损坏的 64 位偏移：与数据长度相加会回绕，应被拒绝而不是越界读取
+    TEST_ASSERT(cache.Store(key, lods, {0.05f}), "重新写入应成功");
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        const uint64_t wrappedOffset = ~uint64_t(0) - 15;
+        file.seekp(24 + 16);  // FileHeader 之后第一个 LevelHeader 的 vertexOffset
+        file.write(reinterpret_cast<const char*>(&wrappedOffset), sizeof(wrappedOffset));
+    }
+    TEST_ASSERT(!cache.Load(key, loaded, loadedErrors), "回绕的偏移应被拒绝");
+    TEST_ASSERT(loaded.empty(), "拒绝时不应输出网格");
+
+    // 键不匹配（文件被拷贝/重命名）应被拒绝
+    const uint64_t otherKey = 0x6666ULL;
+    TEST_ASSERT(cache.Store(key, lods, {0.05f}), "重新写入应成功");
+    std::filesystem::copy_file(path, cache.GetCachePath(otherKey), std::filesystem::copy_options::overwrite_existing);
+    TEST_ASSERT(!cache.Load(otherKey, loaded, loadedErrors), "文件头中的键不匹配应被拒绝");
+
+    cache.SetEnabled(false);
+    TEST_ASSERT(!cache.Load(key, loaded, loadedErrors), "禁用时应总是未命中");
+    cache.SetEnabled(true);
+
+    TEST_ASSERT(cache.ClearDiskCache() >= 2, "应删除缓存文件");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "LOD 磁盘缓存测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_HashKeys);
+    RUN_TEST(Test_StoreLoadRoundTrip);
+    RUN_TEST(Test_RejectCorruptedFile);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
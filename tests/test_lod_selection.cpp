@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_lod_selection.cpp
+ * @brief LOD 选择测试
+ *
+ * 验证距离阈值滞后、远处实体分帧更新、按三角形预算以及按屏幕空间误差选择 LOD（无需 GL 上下文）
+ */
+
+#include "render/lod_system.h"
+#include "render/mesh.h"
+#include "render/ecs/world.h"
+#include "render/ecs/components.h"
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace Render;
+using namespace Render::ECS;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/// 指定三角形数量的网格（只用于计数，三角形可以退化）
+static Ref<Mesh> MakeMeshWithTriangles(size_t triangleCount) {
+    std::vector<Vertex> vertices(3);
+    vertices[1].position = Vector3(1.0f, 0.0f, 0.0f);
+    vertices[2].position = Vector3(0.0f, 1.0f, 0.0f);
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < triangleCount; ++i) {
+        indices.insert(indices.end(), { 0, 1, 2 });
+    }
+    return std::make_shared<Mesh>(vertices, indices);
+}
+
+static std::shared_ptr<World> MakeWorld() {
+    auto world = std::make_shared<World>();
+    world->RegisterComponent<TransformComponent>();
+    world->RegisterComponent<MeshRenderComponent>();
+    world->RegisterComponent<LODComponent>();
+    world->RegisterComponent<WorldBoundsComponent>();
+    world->Initialize();
+    return world;
+}
+
+static EntityID CreateLODEntity(World& world, const Vector3& position, const LODConfig& config,
+                                const Ref<Mesh>& mesh = nullptr) {
+    EntityID entity = world.CreateEntity();
+    TransformComponent transform;
+    transform.SetPosition(position);
+    world.AddComponent(entity, transform);
+
+    MeshRenderComponent meshComp;
+    meshComp.mesh = mesh;
+    world.AddComponent(entity, meshComp);
+    world.AddComponent(entity, LODComponent(config));
+    return entity;
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_Hysteresis_Bands() {
+    LODConfig config;
+    config.distanceThresholds = { 50.0f, 150.0f, 500.0f, 1000.0f };
+    config.transitionDistance = 10.0f;
+
+    TEST_ASSERT(config.CalculateLOD(55.0f, LODLevel::LOD0) == LODLevel::LOD1, "未启用滞后时应直接按阈值切换");
+
+    config.useHysteresis = true;
+    TEST_ASSERT(config.CalculateLOD(55.0f, LODLevel::LOD0) == LODLevel::LOD0, "阈值外 10 单位内应保持 LOD0");
+    TEST_ASSERT(config.CalculateLOD(61.0f, LODLevel::LOD0) == LODLevel::LOD1, "越过滞后带后应切换到 LOD1");
+    TEST_ASSERT(config.CalculateLOD(45.0f, LODLevel::LOD1) == LODLevel::LOD1, "返回阈值内 10 单位内应保持 LOD1");
+    TEST_ASSERT(config.CalculateLOD(39.0f, LODLevel::LOD1) == LODLevel::LOD0, "越过滞后带后应切换回 LOD0");
+    TEST_ASSERT(config.CalculateLOD(600.0f, LODLevel::LOD0) == LODLevel::LOD3, "跨越多个级别时应直接切换到目标级别");
+    TEST_ASSERT(config.CalculateLOD(995.0f, LODLevel::Culled) == LODLevel::Culled, "Culled 在滞后带内应保持");
+    TEST_ASSERT(config.CalculateLOD(985.0f, LODLevel::Culled) == LODLevel::LOD3, "越过滞后带后应从 Culled 恢复");
+
+    config.hysteresisBands = { 2.0f };
+    TEST_ASSERT(config.CalculateLOD(53.0f, LODLevel::LOD0) == LODLevel::LOD1, "应使用按阈值指定的滞后带宽");
+    TEST_ASSERT(config.CalculateLOD(155.0f, LODLevel::LOD1) == LODLevel::LOD1, "未指定的阈值应回退到 transitionDistance");
+    return true;
+}
+
+bool Test_Amortized_FarEntities() {
+    auto world = MakeWorld();
+    LODConfig config;
+    config.distanceThresholds = { 50.0f, 150.0f, 500.0f, 1000.0f };
+
+    std::vector<EntityID> entities;
+    entities.push_back(CreateLODEntity(*world, Vector3(0.0f, 0.0f, -10.0f), config));
+    for (int i = 0; i < 4; ++i) {
+        entities.push_back(CreateLODEntity(*world, Vector3(static_cast<float>(i), 0.0f, -100.0f), config));
+    }
+
+    LODSelectionOptions options;
+    options.farUpdateInterval = 4;
+    options.nearUpdateDistance = 50.0f;
+
+    LODSelectionStats firstStats;
+    LODSelector::BatchCalculateLOD(entities, world.get(), Vector3::Zero(), 1, options, &firstStats);
+    TEST_ASSERT(firstStats.evaluated == 5, "首次计算应评估所有实体");
+    TEST_ASSERT(firstStats.deferred == 0, "首次计算不应延迟");
+
+    size_t totalEvaluated = 0;
+    for (uint64_t frame = 2; frame <= 5; ++frame) {
+        LODSelectionStats stats;
+        LODSelector::BatchCalculateLOD(entities, world.get(), Vector3::Zero(), frame, options, &stats);
+        TEST_ASSERT(stats.evaluated + stats.deferred == 5, "每个实体应被评估或延迟");
+        TEST_ASSERT(stats.deferred >= 1, "远处实体应被分帧延迟");
+        totalEvaluated += stats.evaluated;
+    }
+    // 近处实体每帧 1 次 × 4 帧 + 4 个远处实体各 1 次
+    TEST_ASSERT(totalEvaluated == 8, "4 帧内每个远处实体应恰好重新计算一次");
+
+    const auto& farLOD = world->GetComponent<LODComponent>(entities[1]);
+    TEST_ASSERT(farLOD.currentLOD == LODLevel::LOD1, "远处实体应为 LOD1");
+    return true;
+}
+
+bool Test_TriangleBudget() {
+    auto world = MakeWorld();
+    LODConfig config;
+    config.distanceThresholds = { 1000.0f, 2000.0f, 3000.0f, 4000.0f };
+    config.lodMeshes = { MakeMeshWithTriangles(1000), MakeMeshWithTriangles(500),
+                         MakeMeshWithTriangles(250), MakeMeshWithTriangles(100) };
+
+    const EntityID nearEntity = CreateLODEntity(*world, Vector3(0.0f, 0.0f, -10.0f), config, config.lodMeshes[0]);
+    const EntityID farEntity = CreateLODEntity(*world, Vector3(0.0f, 0.0f, -100.0f), config, config.lodMeshes[0]);
+    const EntityID culledEntity = CreateLODEntity(*world, Vector3(0.0f, 0.0f, -5000.0f), config, config.lodMeshes[0]);
+    const std::vector<EntityID> entities = { nearEntity, farEntity, culledEntity };
+
+    LODSelectionStats stats;
+    LODSelector::SelectLODWithTriangleBudget(entities, world.get(), Vector3::Zero(), 1, 1600, nullptr, &stats);
+    TEST_ASSERT(world->GetComponent<LODComponent>(nearEntity).currentLOD == LODLevel::LOD0, "屏幕误差大的近处实体应细化到 LOD0");
+    TEST_ASSERT(world->GetComponent<LODComponent>(farEntity).currentLOD == LODLevel::LOD1, "远处实体应在预算内细化到 LOD1");
+    TEST_ASSERT(world->GetComponent<LODComponent>(culledEntity).currentLOD == LODLevel::Culled, "超出最远阈值的实体应为 Culled");
+    TEST_ASSERT(stats.selectedTriangles == 1500, "所选三角形总数应为 1500");
+    TEST_ASSERT(stats.triangleBudget == 1600, "应报告三角形预算");
+    TEST_ASSERT(stats.evaluated == 3, "应评估 3 个实体");
+
+    LODSelectionStats tightStats;
+    LODSelector::SelectLODWithTriangleBudget(entities, world.get(), Vector3::Zero(), 2, 100, nullptr, &tightStats);
+    TEST_ASSERT(world->GetComponent<LODComponent>(nearEntity).currentLOD == LODLevel::LOD3, "预算不足时应保持 LOD3");
+    TEST_ASSERT(world->GetComponent<LODComponent>(farEntity).currentLOD == LODLevel::LOD3, "预算不足时应保持 LOD3");
+    TEST_ASSERT(tightStats.selectedTriangles == 200, "预算不足时三角形总数为所有 LOD3 之和");
+    TEST_ASSERT(tightStats.switches == 2, "两个实体应切换 LOD");
+    return true;
+}
+
+bool Test_ScreenSpaceError() {
+    LODConfig config;
+    config.useScreenSpaceError = true;
+    config.maxScreenSpaceError = 1.0f;
+    config.lodMeshes = { MakeMeshWithTriangles(1000), MakeMeshWithTriangles(500),
+                         MakeMeshWithTriangles(250), MakeMeshWithTriangles(100) };
+    config.lodGeometricErrors = { 0.0f, 0.01f, 0.05f, 0.2f };
+
+    // 90° 视场角、1000 像素视口：单位误差在单位距离处为 500 像素
+    const float scale = LODSelector::CalculateErrorToPixelScale(90.0f, 1000.0f);
+    TEST_ASSERT(std::abs(scale - 500.0f) < 1e-2f, "误差像素比例应为 viewportHeight / (2·tan(fovY/2))");
+    TEST_ASSERT(std::abs(LODSelector::ProjectErrorToPixels(0.2f, 100.0f, 90.0f, 1000.0f) - 1.0f) < 1e-4f,
+                "0.2 单位误差在 100 单位处应投影为 1 像素");
+    TEST_ASSERT(LODSelector::CalculateErrorToPixelScale(0.0f, 1000.0f) == 0.0f, "无效视场角应返回 0");
+
+    TEST_ASSERT(config.CalculateLODFromScreenError(2.0f, scale) == LODLevel::LOD0, "近处误差超出容差应使用 LOD0");
+    TEST_ASSERT(config.CalculateLODFromScreenError(10.0f, scale) == LODLevel::LOD1, "应选择误差不超过容差的最粗级别");
+    TEST_ASSERT(config.CalculateLODFromScreenError(50.0f, scale) == LODLevel::LOD2, "应选择误差不超过容差的最粗级别");
+    TEST_ASSERT(config.CalculateLODFromScreenError(200.0f, scale) == LODLevel::LOD3, "远处应选择 LOD3");
+    TEST_ASSERT(config.CalculateLODFromScreenError(5000.0f, scale) == LODLevel::Culled, "超过最后一个阈值仍应剔除");
+
+    config.maxScreenSpaceError = 4.0f;
+    TEST_ASSERT(config.CalculateLODFromScreenError(50.0f, scale) == LODLevel::LOD3, "放宽容差后应选择更粗的级别");
+    config.maxScreenSpaceError = 1.0f;
+
+    config.lodGeometricErrors[3] = -1.0f;
+    TEST_ASSERT(config.CalculateLODFromScreenError(200.0f, scale) == LODLevel::LOD2, "误差未知的级别不应被选择");
+    config.lodGeometricErrors[3] = 0.2f;
+
+    auto world = MakeWorld();
+    const EntityID entity = CreateLODEntity(*world, Vector3(0.0f, 0.0f, -120.0f), config, config.lodMeshes[0]);
+    const EntityID scaledEntity = CreateLODEntity(*world, Vector3(0.0f, 0.0f, -120.0f), config, config.lodMeshes[0]);
+    world->GetComponent<TransformComponent>(scaledEntity).SetScale(Vector3(2.0f, 2.0f, 2.0f));
+    std::vector<EntityID> entities = { entity, scaledEntity };
+
+    LODSelector::BatchCalculateLOD(entities, world.get(), Vector3::Zero(), 1);
+    TEST_ASSERT(world->GetComponent<LODComponent>(entity).currentLOD == LODLevel::LOD1,
+                "未提供视场角和视口高度时应回退到距离阈值");
+
+    LODSelectionOptions options;
+    options.fovYDegrees = 90.0f;
+    options.viewportHeight = 1000.0f;
+    LODSelector::BatchCalculateLOD(entities, world.get(), Vector3::Zero(), 2, options);
+    TEST_ASSERT(world->GetComponent<LODComponent>(entity).currentLOD == LODLevel::LOD3, "应按屏幕空间误差选择 LOD3");
+    TEST_ASSERT(world->GetComponent<LODComponent>(scaledEntity).currentLOD == LODLevel::LOD2,
+                "放大的实体误差应按缩放换算，选择更细的级别");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "LOD 选择测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_Hysteresis_Bands);
+    RUN_TEST(Test_Amortized_FarEntities);
+    RUN_TEST(Test_TriangleBudget);
+    RUN_TEST(Test_ScreenSpaceError);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_mesh_cache.cpp
+ * @brief 二进制网格缓存测试
+ *
+ * 验证 MeshCache 的写入/内存映射读取往返（顶点、包围盒、附加通道、蒙皮、材质描述）、
+ * 缓存键对导入选项的敏感性，以及损坏文件的拒绝（无需 GL 上下文，网格不上传）
+ */
+
+#include "render/mesh_cache.h"
+#include "render/file_utils.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+using namespace Render;
+
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+
+static MeshImportResult MakeSkinnedResult() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices = {0, 1, 2, 2, 1, 3};
+    for (int i = 0; i < 4; ++i) {
+        Vertex v(Vector3(static_cast<float>(i % 2), static_cast<float>(i / 2), 0.5f * i));
+        v.texCoord = Vector2(0.1f * i, 0.2f * i);
+        v.color = Color(0.25f, 0.5f, 0.75f, 1.0f);
+        vertices.push_back(v);
+    }
+
+    MeshImportResult result;
+    result.mesh = std::make_shared<Mesh>(vertices, indices);
+    result.name = "Body";
+    result.extra.localTransform(0, 3) = 2.0f;
+    result.extra.worldTransform(1, 3) = -3.0f;
+    result.extra.assimpMeshIndex = 7;
+    result.extra.uvChannels = {
+        {Vector2(0, 0), Vector2(1, 0), Vector2(0, 1), Vector2(1, 1)},
+        {Vector2(2, 2), Vector2(3, 2), Vector2(2, 3), Vector2(3, 3)},
+    };
+    result.extra.colorChannels = {std::vector<Color>(4, Color(1.0f, 0.0f, 0.0f, 0.5f))};
+
+    auto& skinning = result.extra.skinning;
+    skinning.bones = {{"Root", "", {{0, 1.0f}, {1, 0.5f}}}, {"Spine", "Root", {{1, 0.5f}}}};
+    Matrix4 offset = Matrix4::Identity();
+    offset(2, 3) = 4.0f;
+    skinning.boneOffsetMatrices = {Matrix4::Identity(), offset};
+    skinning.vertexWeights = {{{0, 1.0f}}, {{0, 0.5f}, {1, 0.5f}}, {}, {}};
+    skinning.boneNameToIndex = {{"Root", 0}, {"Spine", 1}};
+
+    // 不应写入缓存的运行时数据
+    result.extra.pendingTextureRequests.push_back({"diffuseMap", "tex", "path/tex.png", true});
+    return result;
+}
+
+static MeshMaterialDesc MakeMaterialDesc() {
+    MeshMaterialDesc desc;
+    desc.valid = true;
+    desc.materialIndex = 3;
+    desc.name = "Skin";
+    desc.diffuseColor = Color(0.8f, 0.6f, 0.5f, 1.0f);
+    desc.opacity = 0.5f;
+    desc.roughness = 0.7f;
+    desc.textures = {{"diffuseMap", "textures/skin.png"}, {"normalMap", "textures/skin_n.png"}};
+    return desc;
+}
+
+static std::string TestCacheDirectory() {
+    return (std::filesystem::temp_directory_path() / "render_test_mesh_cache").string();
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_HashKeys() {
+    MeshImportOptions options;
+    MeshImportOptions runtimeOnly = options;
+    runtimeOnly.autoUpload = !options.autoUpload;
+    runtimeOnly.loadMaterials = !options.loadMaterials;
+    runtimeOnly.useBinaryCache = !options.useBinaryCache;
+    runtimeOnly.cpuResidency = MeshCPUResidency::Release;
+    MeshImportOptions noFlip = options;
+    noFlip.flipUVs = false;
+    MeshImportOptions moreWeights = options;
+    moreWeights.maxBoneWeightsPerVertex = 8;
+
+    const uint64_t source = 0x1234ULL;
+    TEST_ASSERT(MeshCache::BuildKey(source, options) == MeshCache::BuildKey(source, runtimeOnly),
+                "autoUpload/loadMaterials/useBinaryCache/cpuResidency 不应影响缓存键");
+    TEST_ASSERT(MeshCache::BuildKey(source, options) != MeshCache::BuildKey(source, noFlip),
+                "flipUVs 应影响缓存键");
+    TEST_ASSERT(MeshCache::BuildKey(source, options) != MeshCache::BuildKey(source, moreWeights),
+                "骨骼权重上限应影响缓存键");
+    TEST_ASSERT(MeshCache::BuildKey(source, options) != MeshCache::BuildKey(source + 1, options),
+                "源文件哈希应影响缓存键");
+    return true;
+}
+
+bool Test_StoreLoadRoundTrip() {
+    auto& cache = MeshCache::GetInstance();
+    cache.SetCacheDirectory(TestCacheDirectory());
+    cache.ClearDiskCache();
+    cache.ResetStats();
+
+    std::vector<MeshImportResult> results;
+    results.push_back(MakeSkinnedResult());
+    MeshImportResult plain;
+    plain.mesh = std::make_shared<Mesh>(
+        std::vector<Vertex>{Vertex(Vector3(-1, -2, -3)), Vertex(Vector3(1, 2, 3)), Vertex(Vector3(0, 1, 0))},
+        std::vector<uint32_t>{0, 1, 2});
+    plain.name = "Triangle";
+    results.push_back(std::move(plain));
+    std::vector<MeshMaterialDesc> materials = {MakeMaterialDesc()};
+    const uint64_t key = 0x1234abcdULL;
+
+    std::vector<MeshImportResult> loaded;
+    std::vector<MeshMaterialDesc> loadedMaterials;
+    TEST_ASSERT(!cache.Load(key, loaded, loadedMaterials), "写入前应未命中");
+    TEST_ASSERT(cache.Store(key, results, materials), "写入应成功");
+    TEST_ASSERT(cache.Load(key, loaded, loadedMaterials), "写入后应命中");
+    TEST_ASSERT(loaded.size() == 2 && loadedMaterials.size() == 2, "网格数应一致");
+
+    // 几何数据逐位一致
+    bool sameGeometry = true;
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::vector<Vertex> expectedVertices;
+        std::vector<uint32_t> expectedIndices;
+        results[i].mesh->AccessVertices([&](const std::vector<Vertex>& v) { expectedVertices = v; });
+        results[i].mesh->AccessIndices([&](const std::vector<uint32_t>& idx) { expectedIndices = idx; });
+        loaded[i].mesh->AccessVertices([&](const std::vector<Vertex>& v) {
+            sameGeometry = sameGeometry && v.size() == expectedVertices.size() &&
+                std::memcmp(v.data(), expectedVertices.data(), v.size() * sizeof(Vertex)) == 0;
+        });
+        loaded[i].mesh->AccessIndices([&](const std::vector<uint32_t>& idx) {
+            sameGeometry = sameGeometry && idx == expectedIndices;
+        });
+    }
+    TEST_ASSERT(sameGeometry, "顶点与索引数据应逐位一致");
+    const AABB expectedBounds = results[1].mesh->CalculateBounds();
+    const AABB loadedBounds = loaded[1].mesh->CalculateBounds();
+    TEST_ASSERT(loadedBounds.min.isApprox(expectedBounds.min) && loadedBounds.max.isApprox(expectedBounds.max),
+                "包围盒应保留");
+    TEST_ASSERT(!loaded[0].mesh->IsUploaded() && !loaded[0].material, "缓存读取的网格不应上传，也不创建材质");
+
+    // 额外数据
+    const MeshExtraData& extra = loaded[0].extra;
+    TEST_ASSERT(loaded[0].name == "Body" && loaded[1].name == "Triangle", "名称应保留");
+    TEST_ASSERT(extra.localTransform(0, 3) == 2.0f && extra.worldTransform(1, 3) == -3.0f &&
+                extra.assimpMeshIndex == 7, "节点变换与网格索引应保留");
+    TEST_ASSERT(extra.uvChannels.size() == 2 && extra.uvChannels[1][3] == Vector2(3, 3),
+                "附加 UV 通道应保留");
+    TEST_ASSERT(extra.colorChannels.size() == 1 && extra.colorChannels[0][2].a == 0.5f,
+                "颜色通道应保留");
+    TEST_ASSERT(extra.pendingTextureRequests.empty(), "纹理请求不应写入缓存");
+
+    // 蒙皮
+    const MeshSkinningData& skinning = extra.skinning;
+    TEST_ASSERT(skinning.bones.size() == 2 && skinning.bones[1].parentName == "Root" &&
+                skinning.bones[0].vertexWeights.size() == 2 &&
+                skinning.bones[0].vertexWeights[1].weight == 0.5f, "骨骼应保留");
+    TEST_ASSERT(skinning.boneOffsetMatrices.size() == 2 && skinning.boneOffsetMatrices[1](2, 3) == 4.0f,
+                "骨骼偏移矩阵应保留");
+    TEST_ASSERT(skinning.vertexWeights.size() == 4 && skinning.vertexWeights[1].size() == 2 &&
+                skinning.vertexWeights[1][1].boneIndex == 1, "顶点权重应保留");
+    TEST_ASSERT(skinning.boneNameToIndex.size() == 2 && skinning.boneNameToIndex.at("Spine") == 1,
+                "骨骼名称映射应保留");
+
+    // 材质描述
+    const MeshMaterialDesc& material = loadedMaterials[0];
+    TEST_ASSERT(material.valid && material.materialIndex == 3 && material.name == "Skin", "材质标识应保留");
+    TEST_ASSERT(material.diffuseColor && material.diffuseColor->r == 0.8f && !material.ambientColor,
+                "颜色属性及其是否存在应保留");
+    TEST_ASSERT(material.opacity == 0.5f && material.roughness == 0.7f && !material.metallic,
+                "标量属性及其是否存在应保留");
+    TEST_ASSERT(material.textures.size() == 2 && material.textures[1].slotName == "normalMap" &&
+                material.textures[1].relativePath == "textures/skin_n.png", "纹理引用应保留");
+    TEST_ASSERT(!loadedMaterials[1].valid, "未提供材质的网格应标记为无材质");
+
+    auto stats = cache.GetStats();
+    TEST_ASSERT(stats.hits == 1 && stats.misses == 1 && stats.writes == 1, "统计应正确");
+    return true;
+}
+
+bool Test_RejectCorruptedFile() {
+    auto& cache = MeshCache::GetInstance();
+    const uint64_t key = 0x5555ULL;
+    std::vector<MeshImportResult> results;
+    results.push_back(MakeSkinnedResult());
+    TEST_ASSERT(cache.Store(key, results, {MakeMaterialDesc()}), "写入应成功");
+
+    // 截断文件：元数据越界应被拒绝
+    const std::string path = cache.GetCachePath(key);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    std::vector<MeshImportResult> loaded;
+    std::vector<MeshMaterialDesc> loadedMaterials;
+    TEST_ASSERT(!cache.Load(key, loaded, loadedMaterials), "截断的缓存文件应被拒绝");
+    TEST_ASSERT(loaded.empty() && loadedMaterials.empty(), "拒绝时不应输出网格");
+
+    // 键不匹配（文件被拷贝/重命名）应被拒绝
+    const uint64_t otherKey = 0x6666ULL;
+    TEST_ASSERT(cache.Store(key, results, {}), "重新写入应成功");
+    std::filesystem::copy_file(path, cache.GetCachePath(otherKey), std::filesystem::copy_options::overwrite_existing);
+    TEST_ASSERT(!cache.Load(otherKey, loaded, loadedMaterials), "文件头中的键不匹配应被拒绝");
+
+    cache.SetEnabled(false);
+    TEST_ASSERT(!cache.Load(key, loaded, loadedMaterials), "禁用时应总是未命中");
+    cache.SetEnabled(true);
+
+    TEST_ASSERT(cache.ClearDiskCache() >= 2, "应删除缓存文件");
+    return true;
+}
+
+bool Test_ReloadSingleMesh() {
+    auto& cache = MeshCache::GetInstance();
+    cache.ResetStats();
+    const uint64_t key = 0x7777ULL;
+    std::vector<MeshImportResult> results;
+    results.push_back(MakeSkinnedResult());
+    results.push_back(MakeSkinnedResult());
+    std::vector<Vertex> expectedVertices;
+    std::vector<uint32_t> expectedIndices;
+    results[1].mesh->AccessVertices([&](const std::vector<Vertex>& v) { expectedVertices = v; });
+    results[1].mesh->AccessIndices([&](const std::vector<uint32_t>& idx) { expectedIndices = idx; });
+    TEST_ASSERT(cache.Store(key, results, {}), "写入应成功");
+
+    // 单网格读取：用于重新读取按驻留策略释放的数据
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    TEST_ASSERT(cache.LoadMeshData(key, 1, vertices, indices), "应能单独读取第二个网格");
+    TEST_ASSERT(vertices.size() == expectedVertices.size() &&
+                std::memcmp(vertices.data(), expectedVertices.data(), vertices.size() * sizeof(Vertex)) == 0 &&
+                indices == expectedIndices, "单独读取的数据应逐位一致");
+    TEST_ASSERT(!cache.LoadMeshData(key, 2, vertices, indices), "越界的网格序号应失败");
+    TEST_ASSERT(!cache.LoadMeshData(key + 1, 0, vertices, indices), "不存在的缓存文件应失败");
+    vertices.clear();
+    indices.clear();
+    TEST_ASSERT(MeshCache::MakeCPUDataSource(key, 1)(vertices, indices) && indices == expectedIndices,
+                "数据源回调应读取对应网格");
+    TEST_ASSERT(cache.GetStats().hits == 0 && cache.GetStats().misses == 0, "单网格读取不计入命中统计");
+
+    // 缓存读取的网格带有数据源；驻留策略只在上传成功后生效
+    std::vector<MeshImportResult> loaded;
+    std::vector<MeshMaterialDesc> loadedMaterials;
+    TEST_ASSERT(cache.Load(key, loaded, loadedMaterials), "应命中");
+    Ref<Mesh> mesh = loaded[1].mesh;
+    const size_t cpuBytes = mesh->GetMemoryUsage();
+    TEST_ASSERT(mesh->CanRestoreCPUData(), "缓存读取的网格应可重新读取");
+    mesh->SetCPUResidency(MeshCPUResidency::Release);
+    TEST_ASSERT(mesh->GetCPUResidency() == MeshCPUResidency::Release, "应记录驻留策略");
+    TEST_ASSERT(mesh->IsCPUDataResident() && mesh->GetMemoryUsage() == cpuBytes,
+                "未上传的网格不应释放 CPU 数据");
+    TEST_ASSERT(mesh->GetVertexCount() == expectedVertices.size() && mesh->GetIndexCount() == expectedIndices.size(),
+                "顶点/索引数量不受策略影响");
+    bool samePositions = false;
+    mesh->AccessPositions([&](const Mesh::PositionView& positions) {
+        samePositions = positions.size() == expectedVertices.size();
+        for (size_t i = 0; samePositions && i < positions.size(); ++i) {
+            samePositions = positions[i] == expectedVertices[i].position;
+        }
+    });
+    TEST_ASSERT(samePositions, "位置视图应按 Vertex 跨步读取全部顶点");
+
+    TEST_ASSERT(cache.ClearDiskCache() >= 1, "应删除缓存文件");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "二进制网格缓存测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_HashKeys);
+    RUN_TEST(Test_StoreLoadRoundTrip);
+    RUN_TEST(Test_RejectCorruptedFile);
+    RUN_TEST(Test_ReloadSingleMesh);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_mesh_kernels.cpp
+ * @brief 网格导入后处理内核测试
+ *
+ * 验证 MeshKernels 的切线计算与原逐顶点实现在容差内一致（AVX2 路径使用 FMA，不要求逐位相同）（含越界索引、UV 退化、非索引网格与 SIMD 尾部）、
+ * 导入切线的正交化与手性、骨骼权重限制/归一化的 CSR 压缩，以及 TaskScheduler::ParallelFor
+ * 在工作线程内嵌套调用时不会死锁（无需 GL 上下文）
+ */
+
+#include "render/mesh_kernels.h"
+#include "render/mesh_loader.h"
+#include "render/task_scheduler.h"
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/// 原 Mesh::RecalculateTangents 的逐顶点实现（作为参考结果）
+static void ReferenceTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    const float EPSILON = 1e-6f;
+    for (auto& vertex : vertices) {
+        vertex.tangent = Vector3::Zero();
+        vertex.bitangent = Vector3::Zero();
+    }
+    auto accumulate = [&](uint32_t i0, uint32_t i1, uint32_t i2) {
+        if (i0 >= vertices.size() || i1 >= vertices.size() || i2 >= vertices.size()) {
+            return;
+        }
+        Vector3 edge1 = vertices[i1].position - vertices[i0].position;
+        Vector3 edge2 = vertices[i2].position - vertices[i0].position;
+        Vector2 deltaUV1 = vertices[i1].texCoord - vertices[i0].texCoord;
+        Vector2 deltaUV2 = vertices[i2].texCoord - vertices[i0].texCoord;
+        float determinant = deltaUV1.x() * deltaUV2.y() - deltaUV2.x() * deltaUV1.y();
+        if (std::abs(determinant) < EPSILON) {
+            return;
+        }
+        float r = 1.0f / determinant;
+        Vector3 tangent = (edge1 * deltaUV2.y() - edge2 * deltaUV1.y()) * r;
+        Vector3 bitangent = (edge2 * deltaUV1.x() - edge1 * deltaUV2.x()) * r;
+        for (uint32_t index : {i0, i1, i2}) {
+            vertices[index].tangent += tangent;
+            vertices[index].bitangent += bitangent;
+        }
+    };
+    if (!indices.empty()) {
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            accumulate(indices[i], indices[i + 1], indices[i + 2]);
+        }
+    } else {
+        for (size_t i = 0; i + 2 < vertices.size(); i += 3) {
+            accumulate(static_cast<uint32_t>(i), static_cast<uint32_t>(i + 1), static_cast<uint32_t>(i + 2));
+        }
+    }
+    for (auto& vertex : vertices) {
+        Vector3 normal = vertex.normal.squaredNorm() < EPSILON ? Vector3::UnitY() : vertex.normal.normalized();
+        Vector3 tangent = vertex.tangent.squaredNorm() < EPSILON ? Vector3::UnitX() : vertex.tangent;
+        tangent = tangent - normal * normal.dot(tangent);
+        float length = tangent.norm();
+        tangent = length < EPSILON ? Vector3::UnitX() : Vector3(tangent / length);
+        float handedness = 1.0f;
+        if (vertex.bitangent.squaredNorm() >= EPSILON) {
+            handedness = (normal.cross(tangent).dot(vertex.bitangent) < 0.0f) ? -1.0f : 1.0f;
+        }
+        vertex.normal = normal;
+        vertex.tangent = tangent;
+        vertex.bitangent = normal.cross(tangent) * handedness;
+    }
+}
+
+/// 随机网格：部分顶点 UV 重复（退化三角形）、部分法线为零、少量越界索引
+static void MakeRandomMesh(uint32_t seed, size_t vertexCount, size_t triangleCount,
+                           std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    vertices.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        vertices[i].position = Vector3(dist(rng), dist(rng), dist(rng)) * 10.0f;
+        vertices[i].texCoord = (i % 7 == 0) ? Vector2(0.5f, 0.5f) : Vector2(dist(rng), dist(rng));
+        vertices[i].normal = (i % 11 == 0) ? Vector3::Zero() : Vector3(dist(rng), dist(rng), dist(rng));
+    }
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(vertexCount - 1));
+    indices.resize(triangleCount * 3);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = (i % 97 == 5) ? static_cast<uint32_t>(vertexCount + 3) : pick(rng);
+    }
+}
+
+static float MaxFrameError(const std::vector<Vertex>& a, const std::vector<Vertex>& b) {
+    float error = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i) {
+        error = std::max(error, (a[i].normal - b[i].normal).cwiseAbs().maxCoeff());
+        error = std::max(error, (a[i].tangent - b[i].tangent).cwiseAbs().maxCoeff());
+        error = std::max(error, (a[i].bitangent - b[i].bitangent).cwiseAbs().maxCoeff());
+    }
+    return error;
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_TangentsMatchReference() {
+    // 顶点/三角形数不是 8 的倍数，覆盖 SIMD 尾部
+    for (uint32_t seed = 1; seed <= 4; ++seed) {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        MakeRandomMesh(seed, 1003 + seed, 2011 + seed, vertices, indices);
+        
+        std::vector<Vertex> expected = vertices;
+        ReferenceTangents(expected, indices);
+        MeshKernels::ComputeTangents(vertices.data(), vertices.size(), indices.data(), indices.size());
+        
+        // 累加顺序一致，只有 FMA 舍入差异；大量三角形共享顶点时切线接近抵消，容差放宽
+        size_t mismatches = 0;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            if ((vertices[i].tangent - expected[i].tangent).norm() > 1e-3f ||
+                (vertices[i].normal - expected[i].normal).norm() > 1e-5f) {
+                mismatches++;
+            }
+        }
+        TEST_ASSERT(mismatches <= vertices.size() / 200, "切线应与参考实现一致");
+        for (const auto& vertex : vertices) {
+            TEST_ASSERT(std::abs(vertex.tangent.norm() - 1.0f) < 1e-4f, "切线应为单位向量");
+            TEST_ASSERT(std::abs(vertex.normal.dot(vertex.tangent)) < 1e-4f, "切线应与法线正交");
+        }
+    }
+    return true;
+}
+
+bool Test_TangentsGridExact() {
+    // 规则网格：每个顶点只被少量三角形共享，结果应与参考实现非常接近
+    const int size = 33;
+    std::vector<Vertex> vertices;
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            Vertex vertex;
+            vertex.position = Vector3(static_cast<float>(x), std::sin(x * 0.3f) * std::cos(z * 0.2f), static_cast<float>(z));
+            vertex.texCoord = Vector2(x / float(size - 1), 1.0f - z / float(size - 1));
+            vertex.normal = Vector3(0.1f * std::cos(x * 0.3f), 1.0f, 0.05f);
+            vertices.push_back(vertex);
+        }
+    }
+    std::vector<uint32_t> indices;
+    for (int z = 0; z + 1 < size; ++z) {
+        for (int x = 0; x + 1 < size; ++x) {
+            const uint32_t i = z * size + x;
+            indices.insert(indices.end(), {i, i + size, i + 1, i + 1, i + size, i + size + 1});
+        }
+    }
+    std::vector<Vertex> expected = vertices;
+    ReferenceTangents(expected, indices);
+    MeshKernels::ComputeTangents(vertices.data(), vertices.size(), indices.data(), indices.size());
+    TEST_ASSERT(MaxFrameError(vertices, expected) < 1e-5f, "规则网格切线应与参考实现一致");
+    
+    // 非索引网格：展开后结果与参考实现一致
+    std::vector<Vertex> flat;
+    for (uint32_t index : indices) {
+        flat.push_back(expected[index]);
+    }
+    std::vector<Vertex> flatExpected = flat;
+    ReferenceTangents(flatExpected, {});
+    MeshKernels::ComputeTangents(flat.data(), flat.size(), nullptr, 0);
+    TEST_ASSERT(MaxFrameError(flat, flatExpected) < 1e-5f, "非索引网格切线应与参考实现一致");
+    return true;
+}
+
+bool Test_OrthonormalizeImportedTangents() {
+    std::vector<Vertex> vertices(13);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        vertices[i].normal = Vector3(0.0f, 2.0f, 0.0f);
+        vertices[i].tangent = Vector3(1.0f, 0.5f, 0.0f);
+        vertices[i].bitangent = (i % 2 == 0) ? Vector3(0.0f, 0.0f, -3.0f) : Vector3(0.0f, 0.0f, 3.0f);
+    }
+    vertices[3].tangent = Vector3::Zero();        // 无效切线 → X 轴
+    vertices[4].tangent = Vector3(0.0f, 1.0f, 0.0f);   // 与法线平行 → X 轴
+    vertices[5].bitangent = Vector3::Zero();      // 无副切线 → 正手性
+    
+    MeshKernels::OrthonormalizeTangents(vertices.data(), vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& vertex = vertices[i];
+        TEST_ASSERT((vertex.normal - Vector3::UnitY()).norm() < 1e-6f, "法线应被归一化");
+        TEST_ASSERT((vertex.tangent - Vector3::UnitX()).norm() < 1e-6f, "切线应投影到法线平面并归一化");
+        const Vector3 expected = Vector3::UnitY().cross(Vector3::UnitX()) *
+                                 ((i % 2 == 0 || i == 5) ? 1.0f : -1.0f);
+        TEST_ASSERT((vertex.bitangent - expected).norm() < 1e-6f, "副切线应保留导入时的手性");
+    }
+    return true;
+}
+
+bool Test_LimitBoneWeights() {
+    // 顶点 0：5 个权重（限制为 4）；顶点 1：无权重；顶点 2：2 个权重；顶点 3：全零权重
+    std::vector<uint32_t> offsets = {0, 5, 5, 7, 9};
+    std::vector<VertexBoneWeight> weights = {
+        {0, 0.1f}, {1, 0.4f}, {2, 0.05f}, {3, 0.3f}, {4, 0.15f},
+        {7, 1.0f}, {2, 3.0f},
+        {1, 0.0f}, {5, 0.0f},
+    };
+    MeshKernels::LimitBoneWeights(offsets, weights, 4, true);
+    
+    TEST_ASSERT(offsets == std::vector<uint32_t>({0, 4, 4, 6, 8}), "CSR 偏移应被压缩");
+    TEST_ASSERT(weights.size() == 8, "超出限制的权重应被移除");
+    TEST_ASSERT(weights[0].boneIndex == 1 && weights[1].boneIndex == 3 &&
+                weights[2].boneIndex == 4 && weights[3].boneIndex == 0, "超限顶点应按权重降序保留");
+    TEST_ASSERT(std::abs(weights[0].weight - 0.4f / 0.95f) < 1e-6f, "保留的权重应归一化");
+    TEST_ASSERT(weights[4].boneIndex == 7 && weights[5].boneIndex == 2, "未超限顶点保持原顺序");
+    TEST_ASSERT(std::abs(weights[4].weight - 0.25f) < 1e-6f && std::abs(weights[5].weight - 0.75f) < 1e-6f,
+                "未超限顶点也应归一化");
+    TEST_ASSERT(weights[6].weight == 0.0f && weights[7].weight == 0.0f, "全零权重不应产生 NaN");
+    
+    // 不限制、不归一化：数据不变
+    std::vector<uint32_t> offsets2 = {0, 3};
+    std::vector<VertexBoneWeight> weights2 = {{0, 2.0f}, {1, 1.0f}, {2, 1.0f}};
+    MeshKernels::LimitBoneWeights(offsets2, weights2, 0, false);
+    TEST_ASSERT(weights2.size() == 3 && weights2[0].weight == 2.0f, "不限制时应保持原数据");
+    return true;
+}
+
+bool Test_ParallelForNested() {
+    auto& scheduler = TaskScheduler::GetInstance();
+    scheduler.Initialize(2);
+    
+    // 串行回退与并行路径都应完整覆盖所有下标
+    std::vector<std::atomic<int>> hits(1000);
+    scheduler.ParallelFor(hits.size(), [&](size_t i) { hits[i].fetch_add(1); });
+    bool allOnce = true;
+    for (auto& hit : hits) {
+        allOnce = allOnce && hit.load() == 1;
+    }
+    TEST_ASSERT(allOnce, "每个下标应恰好执行一次");
+    
+    // 在所有工作线程内嵌套调用（模拟异步加载任务内部的并行导入）不应死锁
+    std::atomic<size_t> innerTotal{0};
+    std::vector<std::shared_ptr<TaskHandle>> handles;
+    for (int outer = 0; outer < 4; ++outer) {
+        handles.push_back(scheduler.SubmitLambda([&]() {
+            scheduler.ParallelFor(64, [&](size_t) { innerTotal.fetch_add(1); });
+        }));
+    }
+    scheduler.WaitForAll(handles);
+    TEST_ASSERT(innerTotal.load() == 4 * 64, "嵌套 ParallelFor 应全部完成");
+    
+    scheduler.ParallelFor(0, [](size_t) {});
+    scheduler.Shutdown();
+    return true;
+}
+
+bool Test_ParallelForException() {
+    auto& scheduler = TaskScheduler::GetInstance();
+    scheduler.Initialize(2);
+    
+    // 非 std::exception 类型也应返回调用线程，而不是让等待永远挂起
+    bool caughtInt = false;
+    try {
+        scheduler.ParallelFor(1000, [](size_t i) {
+            if (i == 37) {
+                throw 42;
+            }
+        });
+    } catch (int value) {
+        caughtInt = value == 42;
+    }
+    TEST_ASSERT(caughtInt, "非 std::exception 异常应在调用线程重新抛出");
+    
+    bool caughtStd = false;
+    try {
+        scheduler.ParallelFor(64, [](size_t i) {
+            if (i % 2 == 0) {
+                throw std::runtime_error("import failed");
+            }
+        });
+    } catch (const std::runtime_error& e) {
+        caughtStd = std::string(e.what()) == "import failed";
+    }
+    TEST_ASSERT(caughtStd, "std::exception 应在调用线程重新抛出");
+    
+    // 出错后调度器仍可正常使用
+    std::atomic<size_t> total{0};
+    scheduler.ParallelFor(128, [&](size_t) { total.fetch_add(1); });
+    TEST_ASSERT(total.load() == 128, "异常之后的 ParallelFor 应正常完成");
+    
+    scheduler.Shutdown();
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "网格导入后处理内核测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_TangentsMatchReference);
+    RUN_TEST(Test_TangentsGridExact);
+    RUN_TEST(Test_OrthonormalizeImportedTangents);
+    RUN_TEST(Test_LimitBoneWeights);
+    RUN_TEST(Test_ParallelForNested);
+    RUN_TEST(Test_ParallelForException);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_mesh_optimizer.cpp
+ * @brief 网格优化（MeshOptimizer）测试
+ *
+ * 验证打乱三角形顺序的网格经 Optimize 后 ACMR 降低、几何形状不变，顶点获取优化的重映射表
+ * 与逐顶点数据重排一致并丢弃未引用顶点，以及无效输入保持原样（无需 GL 上下文）
+ */
+
+#include "render/mesh_optimizer.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+
+using namespace Render;
+
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/// 生成 size x size 顶点的网格并打乱三角形顺序
+static void MakeShuffledGrid(int size, uint32_t seed, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    vertices.clear();
+    indices.clear();
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            Vertex vertex;
+            vertex.position = Vector3(static_cast<float>(x), 0.0f, static_cast<float>(z));
+            vertex.texCoord = Vector2(x / float(size - 1), z / float(size - 1));
+            vertices.push_back(vertex);
+        }
+    }
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (int z = 0; z + 1 < size; ++z) {
+        for (int x = 0; x + 1 < size; ++x) {
+            const uint32_t i = static_cast<uint32_t>(z * size + x);
+            triangles.push_back({i, i + static_cast<uint32_t>(size), i + 1});
+            triangles.push_back({i + 1, i + static_cast<uint32_t>(size), i + static_cast<uint32_t>(size) + 1});
+        }
+    }
+    std::mt19937 rng(seed);
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+    for (const auto& triangle : triangles) {
+        indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+}
+
+/// 以顶点位置表示的三角形集合（旋转到最小位置在前，与顶点/三角形顺序无关）
+static std::vector<std::array<float, 9>> TriangleSet(const std::vector<Vertex>& vertices,
+                                                     const std::vector<uint32_t>& indices) {
+    std::vector<std::array<float, 9>> result;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        std::array<std::array<float, 3>, 3> corners;
+        for (int k = 0; k < 3; ++k) {
+            const Vector3& p = vertices[indices[t + k]].position;
+            corners[k] = {p.x(), p.y(), p.z()};
+        }
+        const int first = static_cast<int>(std::min_element(corners.begin(), corners.end()) - corners.begin());
+        std::array<float, 9> key;
+        for (int k = 0; k < 3; ++k) {
+            const auto& corner = corners[(first + k) % 3];
+            std::copy(corner.begin(), corner.end(), key.begin() + k * 3);
+        }
+        result.push_back(key);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_OptimizeImprovesCacheStats() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeShuffledGrid(48, 7u, vertices, indices);
+    const auto originalTriangles = TriangleSet(vertices, indices);
+    const size_t originalVertexCount = vertices.size();
+    
+    const MeshOptimizeStats before = MeshOptimizer::Analyze(vertices, indices);
+    TEST_ASSERT(MeshOptimizer::Optimize(vertices, indices), "有效网格应执行优化");
+    const MeshOptimizeStats after = MeshOptimizer::Analyze(vertices, indices);
+    
+    TEST_ASSERT(before.acmr > 1.5f, "打乱顺序的网格 ACMR 应接近最差值");
+    TEST_ASSERT(after.acmr < before.acmr * 0.6f, "优化后 ACMR 应明显降低");
+    TEST_ASSERT(after.atvr < before.atvr, "优化后 ATVR 应降低");
+    TEST_ASSERT(after.overfetch <= before.overfetch, "顶点获取优化后 overfetch 不应变差");
+    TEST_ASSERT(vertices.size() == originalVertexCount, "所有顶点都被引用，顶点数应不变");
+    TEST_ASSERT(TriangleSet(vertices, indices) == originalTriangles, "优化不应改变几何形状");
+    return true;
+}
+
+bool Test_VertexFetchRemap() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeShuffledGrid(12, 3u, vertices, indices);
+    // 追加两个未被引用的顶点
+    Vertex unused;
+    unused.position = Vector3(100.0f, 100.0f, 100.0f);
+    vertices.push_back(unused);
+    vertices.push_back(unused);
+    const std::vector<Vertex> original = vertices;
+    
+    std::vector<int> attribute(vertices.size());
+    for (size_t i = 0; i < attribute.size(); ++i) {
+        attribute[i] = static_cast<int>(i);
+    }
+    
+    std::vector<uint32_t> remap;
+    TEST_ASSERT(MeshOptimizer::Optimize(vertices, indices, {}, &remap), "有效网格应执行优化");
+    TEST_ASSERT(remap.size() == original.size(), "重映射表应覆盖所有原顶点");
+    TEST_ASSERT(vertices.size() == original.size() - 2, "未引用的顶点应被丢弃");
+    TEST_ASSERT(remap[original.size() - 1] == MeshOptimizer::kInvalidIndex, "未引用顶点应映射为 kInvalidIndex");
+    
+    MeshOptimizer::RemapVertexAttribute(attribute, remap, vertices.size());
+    TEST_ASSERT(attribute.size() == vertices.size(), "逐顶点数据应与新顶点数一致");
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const size_t source = static_cast<size_t>(attribute[i]);
+        TEST_ASSERT(remap[source] == i, "属性重排应与重映射表一致");
+        TEST_ASSERT(vertices[i].position == original[source].position, "顶点应按重映射表移动");
+    }
+    
+    // 首次使用顺序：索引按递增方式首次出现
+    uint32_t nextNew = 0;
+    for (uint32_t index : indices) {
+        TEST_ASSERT(index <= nextNew, "顶点应按首次使用顺序排列");
+        if (index == nextNew) {
+            ++nextNew;
+        }
+    }
+    return true;
+}
+
+bool Test_OptionsAndInvalidInput() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeShuffledGrid(8, 11u, vertices, indices);
+    const std::vector<Vertex> originalVertices = vertices;
+    
+    // 关闭顶点获取优化：只重排索引，顶点保持不变
+    MeshOptimizeOptions options;
+    options.vertexFetch = false;
+    std::vector<uint32_t> remap = {1u, 2u, 3u};
+    TEST_ASSERT(MeshOptimizer::Optimize(vertices, indices, options, &remap), "有效网格应执行优化");
+    TEST_ASSERT(remap.empty(), "未执行顶点获取优化时重映射表应为空");
+    TEST_ASSERT(vertices.size() == originalVertices.size(), "顶点数应不变");
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        TEST_ASSERT(vertices[i].position == originalVertices[i].position, "顶点顺序应不变");
+    }
+    
+    // 越界索引：保持原样
+    std::vector<uint32_t> invalid = {0u, 1u, static_cast<uint32_t>(vertices.size())};
+    const std::vector<uint32_t> invalidCopy = invalid;
+    TEST_ASSERT(!MeshOptimizer::Optimize(vertices, invalid), "越界索引应拒绝优化");
+    TEST_ASSERT(invalid == invalidCopy, "拒绝时索引应保持不变");
+    TEST_ASSERT(MeshOptimizer::Analyze(vertices, invalid).acmr == 0.0f, "无效输入统计应为 0");
+    
+    // 索引数不是 3 的倍数
+    std::vector<uint32_t> partial = {0u, 1u};
+    TEST_ASSERT(!MeshOptimizer::Optimize(vertices, partial), "不完整的三角形应拒绝优化");
+    
+    std::vector<Vertex> empty;
+    std::vector<uint32_t> emptyIndices;
+    TEST_ASSERT(!MeshOptimizer::Optimize(empty, emptyIndices), "空网格应拒绝优化");
+    return true;
+}
+
+bool Test_AnalyzeMesh() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeShuffledGrid(16, 5u, vertices, indices);
+    const MeshOptimizeStats expected = MeshOptimizer::Analyze(vertices, indices);
+    
+    Mesh mesh(vertices, indices);
+    const MeshOptimizeStats stats = MeshOptimizer::Analyze(mesh);
+    TEST_ASSERT(stats.acmr == expected.acmr, "Mesh 统计应与数组统计一致（ACMR）");
+    TEST_ASSERT(stats.atvr == expected.atvr, "Mesh 统计应与数组统计一致（ATVR）");
+    TEST_ASSERT(stats.overfetch == expected.overfetch, "Mesh 统计应与数组统计一致（overfetch）");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "网格优化测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_OptimizeImprovesCacheStats);
+    RUN_TEST(Test_VertexFetchRemap);
+    RUN_TEST(Test_OptionsAndInvalidInput);
+    RUN_TEST(Test_AnalyzeMesh);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
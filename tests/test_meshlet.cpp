@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_meshlet.cpp
+ * @brief Meshlet 构建与簇级剔除测试
+ *
+ * 验证 meshlet 覆盖全部三角形且满足顶点/三角形上限、包围球包含簇内顶点、
+ * Mesh 上的 meshlet 数据随几何变化失效，以及视锥体/法线锥剔除的保守性（无需 GL 上下文）
+ */
+
+#include "render/meshlet.h"
+#include "render/camera.h"
+#include "render/math_utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <set>
+
+using namespace Render;
+
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/**
+ * @brief 创建 UV 球（外法线，逆时针为正面）
+ */
+static void MakeSphere(int segments, int rings, float radius,
+                       std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    vertices.clear();
+    indices.clear();
+    for (int r = 0; r <= rings; ++r) {
+        const float phi = static_cast<float>(M_PI) * r / rings;
+        for (int s = 0; s <= segments; ++s) {
+            const float theta = 2.0f * static_cast<float>(M_PI) * s / segments;
+            const Vector3 n(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+            Vertex v(n * radius);
+            v.normal = n;
+            vertices.push_back(v);
+        }
+    }
+    const uint32_t stride = static_cast<uint32_t>(segments + 1);
+    for (int r = 0; r < rings; ++r) {
+        for (int s = 0; s < segments; ++s) {
+            const uint32_t a = r * stride + s;
+            const uint32_t b = a + stride;
+            if (r != 0) {
+                indices.insert(indices.end(), {a, a + 1, b});
+            }
+            if (r != rings - 1) {
+                indices.insert(indices.end(), {a + 1, b + 1, b});
+            }
+        }
+    }
+}
+
+static std::array<uint32_t, 3> SortedTriangle(uint32_t a, uint32_t b, uint32_t c) {
+    std::array<uint32_t, 3> t{a, b, c};
+    std::sort(t.begin(), t.end());
+    return t;
+}
+
+static Frustum MakeFrustum(const Vector3& eye, const Vector3& target) {
+    const Matrix4 view = MathUtils::LookAt(eye, target, Vector3::UnitY());
+    const Matrix4 projection = MathUtils::PerspectiveDegrees(60.0f, 1.0f, 0.1f, 100.0f);
+    Frustum frustum;
+    frustum.ExtractFromMatrix(projection * view);
+    return frustum;
+}
+
+// ============================================================================
+// 测试
+// ============================================================================
+
+static bool Test_BuildCoversAllTriangles() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(48, 32, 1.0f, vertices, indices);
+    
+    MeshletBuildOptions options;
+    options.maxVertices = 64;
+    options.maxTriangles = 124;
+    auto data = MeshletBuilder::Build(vertices, indices, options);
+    TEST_ASSERT(data != nullptr && !data->IsEmpty(), "应成功构建 meshlet");
+    TEST_ASSERT(data->bounds.size() == data->meshlets.size(), "包围数据应与 meshlet 一一对应");
+    TEST_ASSERT(data->triangleCount == indices.size() / 3, "源三角形数应正确");
+    
+    std::multiset<std::array<uint32_t, 3>> source, built;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        source.insert(SortedTriangle(indices[i], indices[i + 1], indices[i + 2]));
+    }
+    bool withinLimits = true;
+    bool localIndicesValid = true;
+    bool boundsContainVertices = true;
+    for (size_t m = 0; m < data->meshlets.size(); ++m) {
+        const Meshlet& meshlet = data->meshlets[m];
+        const MeshletBounds& bounds = data->bounds[m];
+        withinLimits = withinLimits && meshlet.vertexCount <= 64 && meshlet.triangleCount <= 124;
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+            uint32_t tri[3];
+            for (int k = 0; k < 3; ++k) {
+                const uint8_t local = data->triangles[meshlet.triangleOffset + t * 3 + k];
+                localIndicesValid = localIndicesValid && local < meshlet.vertexCount;
+                tri[k] = data->vertices[meshlet.vertexOffset + local];
+                const float distance = (vertices[tri[k]].position - bounds.center).norm();
+                boundsContainVertices = boundsContainVertices && distance <= bounds.radius * 1.001f + 1e-5f;
+            }
+            built.insert(SortedTriangle(tri[0], tri[1], tri[2]));
+        }
+    }
+    TEST_ASSERT(withinLimits, "应满足 meshlet 上限");
+    TEST_ASSERT(localIndicesValid, "局部索引应小于 meshlet 顶点数");
+    TEST_ASSERT(boundsContainVertices, "包围球应包含簇内顶点");
+    TEST_ASSERT(built == source, "meshlet 应恰好覆盖全部三角形");
+    
+    TEST_ASSERT(MeshletBuilder::Build(vertices, {0, 1}, options) == nullptr, "无效索引应构建失败");
+    return true;
+}
+
+static bool Test_MeshStorage() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(16, 8, 1.0f, vertices, indices);
+    auto mesh = CreateRef<Mesh>(vertices, indices);
+    
+    TEST_ASSERT(!mesh->HasMeshlets(), "初始不应有 meshlet");
+    TEST_ASSERT(MeshletBuilder::BuildForMesh(mesh), "BuildForMesh 应成功");
+    TEST_ASSERT(mesh->HasMeshlets() && mesh->GetMeshlets()->triangleCount == indices.size() / 3, "meshlet 应保存在网格上");
+    
+    mesh->SetIndices(indices);
+    TEST_ASSERT(!mesh->HasMeshlets(), "索引变化后 meshlet 应失效");
+    
+    MeshletBuilder::BuildForMesh(mesh);
+    mesh->SetVertices(vertices);
+    TEST_ASSERT(!mesh->HasMeshlets(), "顶点变化后 meshlet 应失效");
+    return true;
+}
+
+static bool Test_FrustumCulling() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(48, 32, 1.0f, vertices, indices);
+    auto data = MeshletBuilder::Build(vertices, indices);
+    TEST_ASSERT(data != nullptr, "应成功构建 meshlet");
+    
+    const Vector3 eye(0.0f, 0.0f, 5.0f);
+    const Frustum frustum = MakeFrustum(eye, Vector3::Zero());
+    
+    // 位于相机后方：全部剔除
+    Matrix4 behind = Matrix4::Identity();
+    behind.block<3, 1>(0, 3) = Vector3(0.0f, 0.0f, 20.0f);
+    std::vector<uint32_t> out;
+    MeshletCullStats stats;
+    TEST_ASSERT(MeshletCuller::Cull(*data, behind, frustum, eye, out, &stats) == 0, "相机后方的对象应全部剔除");
+    TEST_ASSERT(stats.meshletsFrustumCulled == data->GetMeshletCount(), "应全部由视锥体剔除");
+    
+    // 部分移出视野：只保留部分簇
+    Matrix4 partial = Matrix4::Identity();
+    partial.block<3, 1>(0, 3) = Vector3(2.9f, 0.0f, 0.0f);
+    stats.Reset();
+    out.clear();
+    MeshletCuller::Cull(*data, partial, frustum, eye, out, &stats);
+    TEST_ASSERT(stats.meshletsFrustumCulled > 0 && stats.trianglesSubmitted > 0, "部分可见对象应剔除部分簇");
+    return true;
+}
+
+static bool Test_BackfaceConeIsConservative() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(64, 48, 1.0f, vertices, indices);
+    auto data = MeshletBuilder::Build(vertices, indices);
+    TEST_ASSERT(data != nullptr, "应成功构建 meshlet");
+    
+    const Vector3 eye(0.0f, 0.0f, 4.0f);
+    const Frustum frustum = MakeFrustum(eye, Vector3::Zero());
+    // 模型带旋转与均匀缩放
+    Matrix4 model = Matrix4::Identity();
+    model.block<3, 3>(0, 0) = Eigen::AngleAxisf(0.7f, Vector3(0.3f, 1.0f, 0.2f).normalized()).toRotationMatrix() * 1.5f;
+    
+    std::vector<uint32_t> out;
+    MeshletCullStats stats;
+    MeshletCuller::Cull(*data, model, frustum, eye, out, &stats);
+    TEST_ASSERT(stats.meshletsBackfaceCulled > 0, "背向相机的簇应被剔除");
+    TEST_ASSERT(stats.trianglesSubmitted * 3 == out.size(), "索引数应与提交三角形数一致");
+    TEST_ASSERT(stats.trianglesSubmitted < stats.trianglesTotal * 3 / 4, "应剔除至少四分之一的三角形");
+    
+    // 保守性：所有正对相机的三角形都必须保留
+    std::multiset<std::array<uint32_t, 3>> emitted;
+    for (size_t i = 0; i < out.size(); i += 3) {
+        emitted.insert(SortedTriangle(out[i], out[i + 1], out[i + 2]));
+    }
+    const Matrix3 linear = model.block<3, 3>(0, 0);
+    size_t missingFrontFaces = 0;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const Vector3 p0 = linear * vertices[indices[i]].position;
+        const Vector3 p1 = linear * vertices[indices[i + 1]].position;
+        const Vector3 p2 = linear * vertices[indices[i + 2]].position;
+        const Vector3 normal = (p1 - p0).cross(p2 - p0);
+        if (normal.dot(eye - p0) > 1e-4f &&
+            emitted.count(SortedTriangle(indices[i], indices[i + 1], indices[i + 2])) == 0) {
+            missingFrontFaces++;
+        }
+    }
+    TEST_ASSERT(missingFrontFaces == 0, "正对相机的三角形不应被剔除");
+    return true;
+}
+
+static bool Test_CullBatchMatchesSingle() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(32, 24, 1.0f, vertices, indices);
+    auto data = MeshletBuilder::Build(vertices, indices);
+    TEST_ASSERT(data != nullptr, "应成功构建 meshlet");
+    
+    const Vector3 eye(0.0f, 0.0f, 10.0f);
+    const Frustum frustum = MakeFrustum(eye, Vector3::Zero());
+    
+    std::vector<MeshletCuller::Object> objects;
+    for (int i = 0; i < 200; ++i) {
+        MeshletCuller::Object object;
+        object.meshlets = (i % 7 == 0) ? nullptr : data.get();
+        object.model.block<3, 1>(0, 3) = Vector3(static_cast<float>(i % 20) - 10.0f,
+                                                 static_cast<float>(i / 20) - 5.0f, 0.0f);
+        objects.push_back(object);
+    }
+    
+    std::vector<uint32_t> batchIndices;
+    std::vector<MeshletCuller::ObjectRange> ranges;
+    MeshletCullStats batchStats;
+    MeshletCuller::CullBatch(objects, frustum, eye, batchIndices, ranges, &batchStats);
+    TEST_ASSERT(ranges.size() == objects.size(), "每个对象应有一个区间");
+    
+    MeshletCullStats singleStats;
+    size_t mismatchedObjects = 0;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        std::vector<uint32_t> single;
+        if (objects[i].meshlets) {
+            MeshletCuller::Cull(*objects[i].meshlets, objects[i].model, frustum, eye, single, &singleStats);
+        }
+        if (ranges[i].indexCount != single.size() ||
+            !std::equal(single.begin(), single.end(), batchIndices.begin() + ranges[i].indexOffset)) {
+            mismatchedObjects++;
+        }
+    }
+    TEST_ASSERT(mismatchedObjects == 0, "批量区间应与单对象结果一致");
+    TEST_ASSERT(batchStats.trianglesSubmitted == singleStats.trianglesSubmitted, "统计应一致");
+    TEST_ASSERT(batchStats.trianglesSubmitted * 3 == batchIndices.size(), "索引总数应与统计一致");
+    return true;
+}
+
+static bool Test_CullRangesMatchesCull() {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(64, 48, 1.0f, vertices, indices);
+    auto data = MeshletBuilder::Build(vertices, indices);
+    TEST_ASSERT(data != nullptr, "应成功构建 meshlet");
+    TEST_ASSERT(data->indexOffsets.size() == data->meshlets.size(), "每个 meshlet 应有排序缓冲区起始索引");
+    
+    // 按 meshlet 顺序展开的索引缓冲区（与 Mesh::DrawMeshletRanges 上传的内容一致）
+    std::vector<uint32_t> sorted;
+    for (size_t i = 0; i < data->meshlets.size(); ++i) {
+        TEST_ASSERT(data->indexOffsets[i] == sorted.size(), "起始索引应与展开位置一致");
+        const Meshlet& meshlet = data->meshlets[i];
+        for (uint32_t j = 0; j < meshlet.triangleCount * 3; ++j) {
+            sorted.push_back(data->vertices[meshlet.vertexOffset + data->triangles[meshlet.triangleOffset + j]]);
+        }
+    }
+    TEST_ASSERT(sorted.size() == indices.size(), "排序缓冲区应覆盖全部三角形");
+    
+    const Vector3 eye(0.0f, 0.0f, 4.0f);
+    const Frustum frustum = MakeFrustum(eye, Vector3::Zero());
+    Matrix4 model = Matrix4::Identity();
+    model.block<3, 1>(0, 3) = Vector3(1.5f, 0.0f, 0.0f);
+    
+    std::vector<uint32_t> expected;
+    MeshletCuller::Cull(*data, model, frustum, eye, expected);
+    
+    std::vector<MeshletDrawRange> ranges;
+    MeshletCullStats stats;
+    const size_t visibleIndices = MeshletCuller::CullRanges(*data, model, frustum, eye, ranges, &stats);
+    TEST_ASSERT(visibleIndices == expected.size(), "可见索引数应与 Cull 一致");
+    const size_t visibleMeshlets = stats.meshletsTested - stats.meshletsFrustumCulled - stats.meshletsBackfaceCulled;
+    TEST_ASSERT(!ranges.empty() && ranges.size() <= visibleMeshlets, "区间数不应超过可见簇数");
+    
+    std::vector<uint32_t> fromRanges;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        TEST_ASSERT(i == 0 || ranges[i - 1].indexOffset + ranges[i - 1].indexCount < ranges[i].indexOffset,
+                    "区间应递增且互不相邻");
+        fromRanges.insert(fromRanges.end(), sorted.begin() + ranges[i].indexOffset,
+                          sorted.begin() + ranges[i].indexOffset + ranges[i].indexCount);
+    }
+    TEST_ASSERT(fromRanges == expected, "区间内的索引应与 Cull 输出一致");
+    
+    // 完全不可见：输出清空
+    Matrix4 behind = Matrix4::Identity();
+    behind.block<3, 1>(0, 3) = Vector3(0.0f, 0.0f, 20.0f);
+    TEST_ASSERT(MeshletCuller::CullRanges(*data, behind, frustum, eye, ranges) == 0 && ranges.empty(),
+                "不可见对象不应输出区间");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Meshlet 构建与簇级剔除测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_BuildCoversAllTriangles);
+    RUN_TEST(Test_MeshStorage);
+    RUN_TEST(Test_FrustumCulling);
+    RUN_TEST(Test_BackfaceConeIsConservative);
+    RUN_TEST(Test_CullBatchMatchesSingle);
+    RUN_TEST(Test_CullRangesMatchesCull);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_occlusion_culler.cpp
+ * @brief CPU 软件遮挡剔除测试
+ *
+ * 在低分辨率深度缓冲上光栅化遮挡体，验证被遮挡、部分遮挡、位于前方及跨越近平面的包围盒判定（无需 GL 上下文）
+ */
+
+#include "render/occlusion_culler.h"
+#include "render/math_utils.h"
+#include "render/mesh.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+constexpr float kNear = 0.1f;
+constexpr float kFar = 100.0f;
+
+/// 原点处朝 -Z 的相机（60° FOV，宽高比与 256x128 深度缓冲一致）
+static Matrix4 MakeViewProjection() {
+    const Matrix4 projection = MathUtils::PerspectiveDegrees(60.0f, 2.0f, kNear, kFar);
+    const Matrix4 view = MathUtils::LookAt(Vector3::Zero(), Vector3(0.0f, 0.0f, -1.0f), Vector3::UnitY());
+    return projection * view;
+}
+
+/// z = -10 处 10x10 的四边形遮挡体
+static void RasterizeWall(OcclusionCuller& culler) {
+    const Vector3 positions[] = {
+        Vector3(-5.0f, -5.0f, 0.0f), Vector3(5.0f, -5.0f, 0.0f),
+        Vector3(5.0f, 5.0f, 0.0f), Vector3(-5.0f, 5.0f, 0.0f)
+    };
+    const uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+    Matrix4 world = Matrix4::Identity();
+    world(2, 3) = -10.0f;
+    culler.RasterizeTriangles(positions, 4, indices, 6, world);
+}
+
+static AABB BoxAt(const Vector3& center, float halfExtent) {
+    const Vector3 half(halfExtent, halfExtent, halfExtent);
+    return AABB(center - half, center + half);
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_Occlusion_DepthBuffer() {
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProjection());
+    RasterizeWall(culler);
+    culler.Finalize();
+
+    // 视线方向 z = -10 处的 NDC 深度
+    const float ndc = ((kFar + kNear) / (kFar - kNear) * 10.0f - 2.0f * kFar * kNear / (kFar - kNear)) / 10.0f;
+    const float expected = ndc * 0.5f + 0.5f;
+    TEST_ASSERT(std::abs(culler.GetDepth(128, 64) - expected) < 1e-4f, "遮挡体中心深度应等于 z=-10 处的深度");
+    TEST_ASSERT(culler.GetDepth(0, 0) == 1.0f, "遮挡体外的像素应保持清除值");
+    TEST_ASSERT(culler.GetStats().occluders == 1, "应记录 1 个遮挡体");
+    TEST_ASSERT(culler.GetStats().trianglesRasterized == 2, "应光栅化 2 个三角形");
+    return true;
+}
+
+bool Test_Occlusion_Visibility() {
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProjection());
+    RasterizeWall(culler);
+    culler.Finalize();
+
+    TEST_ASSERT(!culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, -20.0f), 1.0f)), "墙后的包围盒应被遮挡");
+    TEST_ASSERT(!culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, -50.0f), 0.2f)), "墙后的小包围盒应被遮挡（逐像素路径）");
+    TEST_ASSERT(!culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, -15.0f), 2.0f)), "墙后的大包围盒应被遮挡（分块路径）");
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, -5.0f), 1.0f)), "墙前的包围盒应可见");
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(10.0f, 0.0f, -20.0f), 1.0f)), "部分被遮挡的包围盒应可见");
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(20.0f, 0.0f, -20.0f), 1.0f)), "墙侧面的包围盒应可见");
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, 0.0f), 1.0f)), "跨越近平面的包围盒应可见");
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, 20.0f), 1.0f)), "相机后方的包围盒应保守地视为可见");
+
+    const OcclusionStats& stats = culler.GetStats();
+    TEST_ASSERT(stats.occludeesTested == 8, "应测试 8 个包围盒");
+    TEST_ASSERT(stats.occludeesOccluded == 3, "应有 3 个包围盒被遮挡");
+    return true;
+}
+
+bool Test_Occlusion_NotFinalized() {
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProjection());
+    RasterizeWall(culler);
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, -20.0f), 1.0f)), "未 Finalize 时应总是可见");
+
+    culler.Finalize();
+    culler.BeginFrame(MakeViewProjection());
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, -20.0f), 1.0f)), "新一帧开始后应清除上一帧的遮挡体");
+    TEST_ASSERT(culler.GetStats().occluders == 0, "BeginFrame 应重置统计");
+    return true;
+}
+
+bool Test_Occlusion_NearPlaneTriangleSkipped() {
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProjection());
+
+    // 一个顶点位于相机后方的三角形
+    const Vector3 positions[] = {
+        Vector3(-5.0f, -5.0f, -10.0f), Vector3(5.0f, -5.0f, -10.0f), Vector3(0.0f, 5.0f, 5.0f)
+    };
+    const uint32_t indices[] = { 0, 1, 2, 0, 1, 7 };
+    culler.RasterizeTriangles(positions, 3, indices, 6, Matrix4::Identity());
+    culler.Finalize();
+
+    TEST_ASSERT(culler.GetStats().trianglesRasterized == 0, "跨越近平面的三角形不应被光栅化");
+    TEST_ASSERT(culler.GetStats().trianglesSkipped == 2, "跨越近平面与索引越界的三角形应计入跳过数");
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, -20.0f), 1.0f)), "没有有效遮挡体时应可见");
+    return true;
+}
+
+bool Test_Occlusion_RasterizeMesh() {
+    std::vector<Vertex> vertices(4);
+    vertices[0].position = Vector3(-5.0f, -5.0f, -10.0f);
+    vertices[1].position = Vector3(5.0f, -5.0f, -10.0f);
+    vertices[2].position = Vector3(5.0f, 5.0f, -10.0f);
+    vertices[3].position = Vector3(-5.0f, 5.0f, -10.0f);
+    // 顺时针绕序：双面光栅化不受影响
+    const Mesh mesh(vertices, { 0, 2, 1, 0, 3, 2 });
+
+    OcclusionCuller culler(128, 64);
+    culler.BeginFrame(MakeViewProjection());
+    culler.RasterizeMesh(mesh, Matrix4::Identity());
+    culler.Finalize();
+
+    TEST_ASSERT(culler.GetStats().trianglesRasterized == 2, "网格的 2 个三角形应被光栅化");
+    TEST_ASSERT(!culler.IsVisible(BoxAt(Vector3(0.0f, 0.0f, -20.0f), 1.0f)), "网格遮挡体后的包围盒应被遮挡");
+    TEST_ASSERT(culler.IsVisible(BoxAt(Vector3(20.0f, 0.0f, -20.0f), 1.0f)), "网格遮挡体侧面的包围盒应可见");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "软件遮挡剔除测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_Occlusion_DepthBuffer);
+    RUN_TEST(Test_Occlusion_Visibility);
+    RUN_TEST(Test_Occlusion_NotFinalized);
+    RUN_TEST(Test_Occlusion_NearPlaneTriangleSkipped);
+    RUN_TEST(Test_Occlusion_RasterizeMesh);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_pipeline_state.cpp
+ * @brief 管线状态对象测试
+ *
+ * 测试 PipelineStateRegistry 的 ID 驻留与 DiffPipelineState 的最小差异计算（无需 GL 上下文）
+ */
+
+#include "render/pipeline_state.h"
+#include <iostream>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+static PipelineStateDesc MakeOpaqueDesc(uint32_t program) {
+    PipelineStateDesc desc;
+    desc.fields = PipelineStateFields_Blend | PipelineStateFields_CullFace |
+                  PipelineStateFields_DepthTest | PipelineStateFields_DepthWrite |
+                  PipelineStateFields_Program;
+    desc.blendMode = BlendMode::None;
+    desc.cullFace = CullFace::Back;
+    desc.depthTest = true;
+    desc.depthWrite = true;
+    desc.program = program;
+    return desc;
+}
+
+// ============================================================================
+// 注册表测试
+// ============================================================================
+
+bool Test_Registry_SameDescSameId() {
+    auto& registry = PipelineStateRegistry::GetInstance();
+    PipelineStateId a = registry.Acquire(MakeOpaqueDesc(7));
+    PipelineStateId b = registry.Acquire(MakeOpaqueDesc(7));
+
+    TEST_ASSERT(a != kInvalidPipelineState, "ID 应该有效");
+    TEST_ASSERT(a == b, "相同状态组合应得到相同 ID");
+    return true;
+}
+
+bool Test_Registry_DifferentDescDifferentId() {
+    auto& registry = PipelineStateRegistry::GetInstance();
+    PipelineStateDesc transparent = MakeOpaqueDesc(7);
+    transparent.blendMode = BlendMode::Alpha;
+    transparent.depthWrite = false;
+
+    TEST_ASSERT(registry.Acquire(MakeOpaqueDesc(7)) != registry.Acquire(transparent),
+                "不同混合状态应得到不同 ID");
+    TEST_ASSERT(registry.Acquire(MakeOpaqueDesc(7)) != registry.Acquire(MakeOpaqueDesc(8)),
+                "不同程序应得到不同 ID");
+    return true;
+}
+
+bool Test_Registry_IgnoresUnownedFields() {
+    auto& registry = PipelineStateRegistry::GetInstance();
+    PipelineStateDesc a = MakeOpaqueDesc(3);
+    PipelineStateDesc b = MakeOpaqueDesc(3);
+    // 深度函数不在掩码中，不应影响 ID
+    a.depthFunc = DepthFunc::Less;
+    b.depthFunc = DepthFunc::Always;
+    // 非自定义混合模式下混合因子不应影响 ID
+    b.blendSrcFactor = 1;
+    b.blendDstFactor = 0;
+
+    TEST_ASSERT(registry.Acquire(a) == registry.Acquire(b), "未接管的字段不应影响 ID");
+    return true;
+}
+
+bool Test_Registry_FindReturnsStableDesc() {
+    auto& registry = PipelineStateRegistry::GetInstance();
+    PipelineStateDesc desc = MakeOpaqueDesc(11);
+    desc.cullFace = CullFace::Front;
+    PipelineStateId id = registry.Acquire(desc);
+
+    const PipelineStateDesc* found = registry.Find(id);
+    TEST_ASSERT(found != nullptr, "Find 应找到已注册的状态");
+    TEST_ASSERT(found->cullFace == CullFace::Front, "状态内容应保持不变");
+    TEST_ASSERT(found->program == 11u, "程序 ID 应保持不变");
+
+    for (uint32_t program = 100; program < 200; ++program) {
+        registry.Acquire(MakeOpaqueDesc(program));
+    }
+    TEST_ASSERT(registry.Find(id) == found, "新增状态后指针应保持稳定");
+    TEST_ASSERT(registry.Find(kInvalidPipelineState) == nullptr, "无效 ID 应返回 nullptr");
+    TEST_ASSERT(registry.Find(static_cast<PipelineStateId>(registry.GetCount() + 1)) == nullptr,
+                "越界 ID 应返回 nullptr");
+    return true;
+}
+
+// ============================================================================
+// 差异计算测试
+// ============================================================================
+
+bool Test_Diff_IdenticalIsEmpty() {
+    PipelineStateDesc current = MakeOpaqueDesc(5);
+    TEST_ASSERT(DiffPipelineState(current, MakeOpaqueDesc(5)) == PipelineStateFields_None,
+                "相同状态不应产生差异");
+    return true;
+}
+
+bool Test_Diff_OnlyChangedFields() {
+    PipelineStateDesc current = MakeOpaqueDesc(5);
+    PipelineStateDesc target = MakeOpaqueDesc(5);
+    target.blendMode = BlendMode::Alpha;
+    target.depthWrite = false;
+
+    uint32_t diff = DiffPipelineState(current, target);
+    TEST_ASSERT(diff == (PipelineStateFields_Blend | PipelineStateFields_DepthWrite),
+                "只应报告混合与深度写入的变化");
+    TEST_ASSERT(CountPipelineStateFields(diff) == 2, "应有两个分组需要下发");
+    return true;
+}
+
+bool Test_Diff_IgnoresFieldsNotOwnedByTarget() {
+    PipelineStateDesc current = MakeOpaqueDesc(5);
+    current.depthFunc = DepthFunc::Always;
+
+    PipelineStateDesc target = MakeOpaqueDesc(9);
+    target.fields &= ~PipelineStateFields_Program;
+
+    TEST_ASSERT(DiffPipelineState(current, target) == PipelineStateFields_None,
+                "目标未接管的程序与深度函数不应产生差异");
+    return true;
+}
+
+bool Test_Diff_CustomBlendFactors() {
+    PipelineStateDesc current = MakeOpaqueDesc(5);
+    current.blendMode = BlendMode::Custom;
+    current.blendSrcFactor = 1;
+    current.blendDstFactor = 1;
+
+    PipelineStateDesc target = current;
+    TEST_ASSERT(DiffPipelineState(current, target) == PipelineStateFields_None,
+                "相同自定义混合因子不应产生差异");
+
+    target.blendDstFactor = 0;
+    TEST_ASSERT(DiffPipelineState(current, target) == PipelineStateFields_Blend,
+                "自定义混合因子变化应报告混合差异");
+    return true;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "管线状态对象测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::cout << "\n--- PipelineStateRegistry 测试 ---" << std::endl;
+    RUN_TEST(Test_Registry_SameDescSameId);
+    RUN_TEST(Test_Registry_DifferentDescDifferentId);
+    RUN_TEST(Test_Registry_IgnoresUnownedFields);
+    RUN_TEST(Test_Registry_FindReturnsStableDesc);
+
+    std::cout << "\n--- DiffPipelineState 测试 ---" << std::endl;
+    RUN_TEST(Test_Diff_IdenticalIsEmpty);
+    RUN_TEST(Test_Diff_OnlyChangedFields);
+    RUN_TEST(Test_Diff_IgnoresFieldsNotOwnedByTarget);
+    RUN_TEST(Test_Diff_CustomBlendFactors);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_profiler.cpp
+ * @brief 帧分析器测试
+ *
+ * 测试 CPU 作用域的层级聚合、自耗时计算、多线程汇总与 CSV 导出（无需 GL 上下文）
+ */
+
+#include "render/debug/profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+static void SleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static const ProfilerScopeStats* FindScope(const ProfilerFrame& frame, const std::string& path) {
+    for (const auto& scope : frame.cpuScopes) {
+        if (scope.path == path) {
+            return &scope;
+        }
+    }
+    return nullptr;
+}
+
+static void ResetProfiler() {
+    auto& profiler = Profiler::GetInstance();
+    profiler.SetEnabled(true);
+    profiler.SetHistorySize(240);
+    profiler.Reset();
+}
+
+// ============================================================================
+// 层级与耗时
+// ============================================================================
+
+bool Test_Profiler_NestedPaths() {
+    ResetProfiler();
+    auto& profiler = Profiler::GetInstance();
+
+    profiler.BeginFrame();
+    {
+        PROFILE_SCOPE("Outer");
+        {
+            PROFILE_SCOPE("Inner");
+        }
+        {
+            PROFILE_SCOPE("Inner");
+        }
+    }
+    profiler.EndFrame();
+
+    const ProfilerFrame frame = profiler.GetLastFrame();
+    const auto* outer = FindScope(frame, "Outer");
+    const auto* inner = FindScope(frame, "Outer/Inner");
+    TEST_ASSERT(outer != nullptr, "应记录顶层作用域");
+    TEST_ASSERT(inner != nullptr, "子作用域路径应包含父作用域");
+    TEST_ASSERT(outer->depth == 0 && inner->depth == 1, "嵌套深度应正确");
+    TEST_ASSERT(outer->callCount == 1, "顶层作用域调用次数应为 1");
+    TEST_ASSERT(inner->callCount == 2, "同一路径的多次调用应合并");
+    TEST_ASSERT(frame.cpuScopes.front().path == "Outer", "结果应按层级顺序排列（父在前）");
+    return true;
+}
+
+bool Test_Profiler_SelfTime() {
+    ResetProfiler();
+    auto& profiler = Profiler::GetInstance();
+
+    profiler.BeginFrame();
+    {
+        PROFILE_SCOPE("Parent");
+        SleepMs(5);
+        {
+            PROFILE_SCOPE("Child");
+            SleepMs(10);
+        }
+    }
+    profiler.EndFrame();
+
+    const ProfilerFrame frame = profiler.GetLastFrame();
+    const auto* parent = FindScope(frame, "Parent");
+    const auto* child = FindScope(frame, "Parent/Child");
+    TEST_ASSERT(parent && child, "应记录父子作用域");
+    TEST_ASSERT(child->totalMs >= 9.0, "子作用域耗时应不少于休眠时间");
+    TEST_ASSERT(parent->totalMs >= child->totalMs, "父作用域总耗时应包含子作用域");
+    TEST_ASSERT(parent->selfMs >= 4.0 && parent->selfMs < parent->totalMs,
+                "父作用域自耗时应扣除子作用域");
+    TEST_ASSERT(frame.frameMs >= parent->totalMs, "帧耗时应覆盖所有作用域");
+    return true;
+}
+
+bool Test_Profiler_TopScopes() {
+    ResetProfiler();
+    auto& profiler = Profiler::GetInstance();
+
+    profiler.BeginFrame();
+    {
+        PROFILE_SCOPE("Fast");
+    }
+    {
+        PROFILE_SCOPE("Slow");
+        SleepMs(3);
+    }
+    {
+        PROFILE_SCOPE("Medium");
+        SleepMs(1);
+    }
+    profiler.EndFrame();
+
+    const auto top = profiler.GetTopScopes(2);
+    TEST_ASSERT(top.size() == 2, "应只返回请求数量的作用域");
+    TEST_ASSERT(top[0].path == "Slow", "耗时最高的作用域应排在首位");
+    TEST_ASSERT(top[1].path == "Medium", "第二名应为次慢作用域");
+    return true;
+}
+
+bool Test_Profiler_Disabled() {
+    ResetProfiler();
+    auto& profiler = Profiler::GetInstance();
+    profiler.SetEnabled(false);
+
+    profiler.BeginFrame();
+    {
+        PROFILE_SCOPE("Ignored");
+    }
+    profiler.EndFrame();
+
+    TEST_ASSERT(profiler.GetHistory().empty(), "关闭时不应记录帧");
+    profiler.SetEnabled(true);
+    return true;
+}
+
+// ============================================================================
+// 多线程与历史
+// ============================================================================
+
+bool Test_Profiler_MultiThreaded() {
+    ResetProfiler();
+    auto& profiler = Profiler::GetInstance();
+
+    constexpr int kThreads = 4;
+    constexpr int kScopesPerThread = 100;
+
+    profiler.BeginFrame();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([]() {
+            for (int i = 0; i < kScopesPerThread; ++i) {
+                PROFILE_SCOPE("Worker");
+                PROFILE_SCOPE("Job");
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    profiler.EndFrame();
+
+    const ProfilerFrame frame = profiler.GetLastFrame();
+    const auto* worker = FindScope(frame, "Worker");
+    const auto* job = FindScope(frame, "Worker/Job");
+    TEST_ASSERT(worker && job, "各线程的作用域应被汇总");
+    TEST_ASSERT(worker->callCount == kThreads * kScopesPerThread, "所有线程的调用次数应合并");
+    TEST_ASSERT(job->callCount == kThreads * kScopesPerThread, "子作用域在各线程中应正确挂接");
+    TEST_ASSERT(frame.droppedEvents == 0, "容量充足时不应丢弃事件");
+    return true;
+}
+
+bool Test_Profiler_DropsWhenFull() {
+    ResetProfiler();
+    auto& profiler = Profiler::GetInstance();
+
+    const size_t total = Profiler::kThreadBufferCapacity + 100;
+    profiler.BeginFrame();
+    for (size_t i = 0; i < total; ++i) {
+        PROFILE_SCOPE("Spam");
+    }
+    profiler.EndFrame();
+
+    const ProfilerFrame frame = profiler.GetLastFrame();
+    const auto* spam = FindScope(frame, "Spam");
+    TEST_ASSERT(spam != nullptr, "应保留缓冲区内的事件");
+    TEST_ASSERT(spam->callCount == Profiler::kThreadBufferCapacity, "保留的事件数应等于缓冲区容量");
+    TEST_ASSERT(frame.droppedEvents == 100, "超出容量的事件应计入丢弃数");
+    return true;
+}
+
+bool Test_Profiler_HistoryLimit() {
+    ResetProfiler();
+    auto& profiler = Profiler::GetInstance();
+    profiler.SetHistorySize(3);
+
+    for (int i = 0; i < 5; ++i) {
+        profiler.BeginFrame();
+        PROFILE_SCOPE("Frame");
+        profiler.EndFrame();
+    }
+
+    const auto history = profiler.GetHistory();
+    TEST_ASSERT(history.size() == 3, "历史帧数应受限制");
+    TEST_ASSERT(history.back().frameIndex == history.front().frameIndex + 2, "历史应保留最近的帧");
+    return true;
+}
+
+bool Test_Profiler_DumpToFile() {
+    ResetProfiler();
+    auto& profiler = Profiler::GetInstance();
+
+    profiler.BeginFrame();
+    {
+        PROFILE_SCOPE("Dump");
+        PROFILE_SCOPE("Nested");
+    }
+    profiler.EndFrame();
+
+    const std::string path = "test_profiler_dump.csv";
+    TEST_ASSERT(profiler.DumpToFile(path), "导出应成功");
+
+    std::ifstream file(path);
+    TEST_ASSERT(file.is_open(), "导出文件应存在");
+
+    std::string header;
+    std::getline(file, header);
+    TEST_ASSERT(header == "frame,source,path,depth,calls,total_ms,self_ms,max_ms,frame_ms", "表头应正确");
+
+    bool foundNested = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.find(",cpu,Dump/Nested,1,1,") != std::string::npos) {
+            foundNested = true;
+        }
+    }
+    file.close();
+    std::remove(path.c_str());
+
+    TEST_ASSERT(foundNested, "导出内容应包含嵌套作用域");
+    return true;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "帧分析器测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::cout << "\n--- 层级与耗时 ---" << std::endl;
+    RUN_TEST(Test_Profiler_NestedPaths);
+    RUN_TEST(Test_Profiler_SelfTime);
+    RUN_TEST(Test_Profiler_TopScopes);
+    RUN_TEST(Test_Profiler_Disabled);
+
+    std::cout << "\n--- 多线程与历史 ---" << std::endl;
+    RUN_TEST(Test_Profiler_MultiThreaded);
+    RUN_TEST(Test_Profiler_DropsWhenFull);
+    RUN_TEST(Test_Profiler_HistoryLimit);
+    RUN_TEST(Test_Profiler_DumpToFile);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_std140_layout.cpp
+ * @brief std140 布局与打包测试
+ *
+ * 验证 Std140Layout 的偏移/步长规则，以及帧数据块、材质数据块的打包结果（无需 GL 上下文）
+ */
+
+#include "render/std140_layout.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+static float ReadFloat(const Std140Writer& writer, uint32_t offset) {
+    float value = 0.0f;
+    std::memcpy(&value, writer.GetData() + offset, sizeof(value));
+    return value;
+}
+
+static int32_t ReadInt(const Std140Writer& writer, uint32_t offset) {
+    int32_t value = 0;
+    std::memcpy(&value, writer.GetData() + offset, sizeof(value));
+    return value;
+}
+
+static bool NearlyEqual(float a, float b) {
+    return std::abs(a - b) < 1e-5f;
+}
+
+// ============================================================================
+// 布局规则测试
+// ============================================================================
+
+bool Test_Layout_ScalarAndVec3() {
+    Std140Layout layout;
+    uint32_t a = layout.Add("a", Std140Type::Float);
+    uint32_t b = layout.Add("b", Std140Type::Vec3);
+    uint32_t c = layout.Add("c", Std140Type::Float);
+
+    TEST_ASSERT(layout.GetMember(a).offset == 0, "float 应位于 0");
+    TEST_ASSERT(layout.GetMember(b).offset == 16, "vec3 应对齐到 16");
+    TEST_ASSERT(layout.GetMember(c).offset == 28, "vec3 之后的 float 应紧跟在第 12 字节后");
+    TEST_ASSERT(layout.GetSize() == 32, "块大小应取整到 16 的倍数");
+    return true;
+}
+
+bool Test_Layout_Vec2Alignment() {
+    Std140Layout layout;
+    layout.Add("a", Std140Type::Float);
+    uint32_t b = layout.Add("b", Std140Type::Vec2);
+    uint32_t c = layout.Add("c", Std140Type::Vec4);
+
+    TEST_ASSERT(layout.GetMember(b).offset == 8, "vec2 应对齐到 8");
+    TEST_ASSERT(layout.GetMember(c).offset == 16, "vec4 应对齐到 16");
+    TEST_ASSERT(layout.GetSize() == 32, "块大小应为 32");
+    return true;
+}
+
+bool Test_Layout_ScalarArrayStride() {
+    Std140Layout layout;
+    uint32_t arr = layout.Add("values", Std140Type::Float, 3);
+    uint32_t next = layout.Add("next", Std140Type::Float);
+
+    TEST_ASSERT(layout.GetMember(arr).arrayStride == 16, "标量数组步长应为 16");
+    TEST_ASSERT(layout.GetMember(arr).size == 48, "3 元素数组应占 48 字节");
+    TEST_ASSERT(layout.GetMember(next).offset == 48, "数组之后的成员应从 vec4 边界开始");
+    return true;
+}
+
+bool Test_Layout_Matrices() {
+    Std140Layout layout;
+    layout.Add("flag", Std140Type::Bool);
+    uint32_t m3 = layout.Add("normalMatrix", Std140Type::Mat3);
+    uint32_t m4 = layout.Add("model", Std140Type::Mat4);
+    uint32_t tail = layout.Add("tail", Std140Type::Float);
+
+    TEST_ASSERT(layout.GetMember(m3).offset == 16, "mat3 应对齐到 16");
+    TEST_ASSERT(layout.GetMember(m3).size == 48, "mat3 每列补齐到 vec4，共 48 字节");
+    TEST_ASSERT(layout.GetMember(m4).offset == 64, "mat4 应紧随 mat3");
+    TEST_ASSERT(layout.GetMember(tail).offset == 128, "矩阵之后的成员应从 vec4 边界开始");
+    TEST_ASSERT(layout.Find("model") == static_cast<int32_t>(m4), "Find 应返回成员索引");
+    TEST_ASSERT(layout.Find("missing") == -1, "未知成员应返回 -1");
+    return true;
+}
+
+// ============================================================================
+// 写入测试
+// ============================================================================
+
+bool Test_Writer_Matrix3ColumnPadding() {
+    Std140Layout layout;
+    uint32_t m3 = layout.Add("m", Std140Type::Mat3);
+    Std140Writer writer(layout);
+
+    Matrix3 matrix;
+    matrix << 1.0f, 2.0f, 3.0f,
+              4.0f, 5.0f, 6.0f,
+              7.0f, 8.0f, 9.0f;
+    writer.SetMatrix3(m3, matrix);
+
+    // 第二列 (2, 5, 8) 位于偏移 16
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 16), 2.0f), "第二列首元素");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 20), 5.0f), "第二列第二个元素");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 24), 8.0f), "第二列第三个元素");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 12), 0.0f), "列填充应保持为零");
+    return true;
+}
+
+bool Test_Writer_RejectsMismatch() {
+    Std140Layout layout;
+    uint32_t f = layout.Add("f", Std140Type::Float);
+    uint32_t arr = layout.Add("arr", Std140Type::Vec4, 2);
+    Std140Writer writer(layout);
+
+    writer.SetInt(f, 42);                                   // 类型不匹配
+    writer.SetVector4(arr, Vector4(1.0f, 1.0f, 1.0f, 1.0f), 2);  // 下标越界
+    writer.SetFloat(99, 1.0f);                              // 成员不存在
+
+    bool allZero = true;
+    for (size_t i = 0; i < writer.GetSize(); ++i) {
+        allZero = allZero && writer.GetData()[i] == 0;
+    }
+    TEST_ASSERT(allZero, "非法写入应被忽略");
+
+    writer.SetVector4(arr, Vector4(1.0f, 2.0f, 3.0f, 4.0f), 1);
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 32 + 12), 4.0f), "数组第二个元素应写入偏移 32");
+    return true;
+}
+
+// ============================================================================
+// 帧数据块 / 材质数据块
+// ============================================================================
+
+bool Test_FrameLayout_Offsets() {
+    const Std140Layout& layout = GetFrameUniformLayout();
+    auto offsetOf = [&](const char* name) {
+        int32_t index = layout.Find(name);
+        return index < 0 ? 0xFFFFFFFFu : layout.GetMember(static_cast<uint32_t>(index)).offset;
+    };
+
+    TEST_ASSERT(offsetOf("uView") == 0, "uView 偏移");
+    TEST_ASSERT(offsetOf("uViewProjection") == 128, "uViewProjection 偏移");
+    TEST_ASSERT(offsetOf("uCameraPosition") == 192, "uCameraPosition 偏移");
+    TEST_ASSERT(offsetOf("uLightCounts") == 224, "uLightCounts 偏移");
+    TEST_ASSERT(offsetOf("uDirectionalDirections") == 256, "方向光数组偏移");
+    TEST_ASSERT(offsetOf("uPointPositions") == 384, "点光源数组偏移");
+    TEST_ASSERT(offsetOf("uSpotPositions") == 768, "聚光灯数组偏移");
+    TEST_ASSERT(offsetOf("uAmbientColors") == 1024, "环境光数组偏移");
+    TEST_ASSERT(offsetOf("uLegacyAmbientColor") == 1120, "兼容环境光偏移");
+    TEST_ASSERT(layout.GetSize() == 1136, "帧数据块大小");
+    return true;
+}
+
+bool Test_FrameLayout_Packing() {
+    FrameUniformData data;
+    data.view = Matrix4::Identity();
+    data.view(0, 3) = 5.0f;  // 平移 x
+    data.projection = Matrix4::Identity() * 2.0f;
+    data.projection(3, 3) = 1.0f;
+    data.cameraPosition = Vector3(1.0f, 2.0f, 3.0f);
+    data.time = 10.0f;
+    data.deltaTime = 0.5f;
+    data.pointCount = 20;  // 超过上限应被截断
+    for (auto& position : data.pointPositions) {
+        position = Vector4(7.0f, 0.0f, 0.0f, 1.0f);
+    }
+    data.directionalCount = 1;
+    data.directionalDirections[0] = Vector4(0.0f, -1.0f, 0.0f, 0.0f);
+
+    Std140Writer writer(GetFrameUniformLayout());
+    PackFrameUniforms(data, writer);
+
+    // viewProjection = projection * view，第 4 列 x 分量位于偏移 128 + 48
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 128 + 48), 10.0f), "视图投影矩阵应为 P * V");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 192 + 8), 3.0f), "相机位置 z");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 208), 10.0f), "累计时间");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 212), 0.5f), "帧间隔");
+    TEST_ASSERT(ReadInt(writer, 224) == 1, "方向光数量");
+    TEST_ASSERT(ReadInt(writer, 228) == static_cast<int32_t>(kFrameMaxPointLights), "点光源数量应被截断");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 256 + 4), -1.0f), "方向光方向 y");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 384 + 16 * 7), 7.0f), "最后一个点光源位置");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 256 + 16), 0.0f), "未使用的方向光槽应为零");
+    return true;
+}
+
+bool Test_MaterialLayout_Packing() {
+    const Std140Layout& layout = GetMaterialUniformLayout();
+    TEST_ASSERT(layout.GetSize() == 80, "材质数据块大小应为 5 个 vec4");
+
+    MaterialUniformData data;
+    data.diffuse = Color(0.1f, 0.2f, 0.3f, 0.4f);
+    data.shininess = 64.0f;
+    data.opacity = 0.75f;
+    data.roughness = 0.25f;
+
+    Std140Writer writer(layout);
+    PackMaterialUniforms(data, writer);
+
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 16 + 8), 0.3f), "漫反射颜色 b");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 64), 64.0f), "shininess");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 68), 0.75f), "opacity");
+    TEST_ASSERT(NearlyEqual(ReadFloat(writer, 76), 0.25f), "roughness");
+    return true;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "std140 布局测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::cout << "\n--- Std140Layout 测试 ---" << std::endl;
+    RUN_TEST(Test_Layout_ScalarAndVec3);
+    RUN_TEST(Test_Layout_Vec2Alignment);
+    RUN_TEST(Test_Layout_ScalarArrayStride);
+    RUN_TEST(Test_Layout_Matrices);
+
+    std::cout << "\n--- Std140Writer 测试 ---" << std::endl;
+    RUN_TEST(Test_Writer_Matrix3ColumnPadding);
+    RUN_TEST(Test_Writer_RejectsMismatch);
+
+    std::cout << "\n--- 帧/材质数据块测试 ---" << std::endl;
+    RUN_TEST(Test_FrameLayout_Offsets);
+    RUN_TEST(Test_FrameLayout_Packing);
+    RUN_TEST(Test_MaterialLayout_Packing);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_texture_compression.cpp
+ * @brief 纹理块压缩与压缩纹理缓存测试
+ *
+ * 验证 TextureCompressor 各格式的编码/解码质量（PSNR）、级别大小与 mip 链尺寸、
+ * 不透明图像的格式自动选择，以及 TextureCache 的写入/读取往返与损坏文件拒绝（无需 GL 上下文）
+ */
+
+#include "render/texture_compression.h"
+#include "render/texture_cache.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+using namespace Render;
+
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/**
+ * @brief 生成带平滑渐变与硬边的测试图像（尺寸可为非 4 的倍数）
+ */
+static std::vector<uint8_t> MakeTestImage(int width, int height, bool withAlpha) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+            const float u = static_cast<float>(x) / width;
+            const float v = static_cast<float>(y) / height;
+            const float luminance = 0.5f * u + 0.5f * v;
+            p[0] = static_cast<uint8_t>(255.0f * luminance);
+            p[1] = static_cast<uint8_t>(30.0f + 200.0f * luminance);
+            p[2] = ((x / 8 + y / 8) % 2 == 0) ? 200 : 60;
+            p[3] = withAlpha ? static_cast<uint8_t>(255.0f * (0.5f + 0.5f * std::sin(u * 6.28f))) : 255;
+        }
+    }
+    return rgba;
+}
+
+/**
+ * @brief 计算指定通道范围内的峰值信噪比（dB）
+ */
+static double ComputePSNR(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b,
+                          int firstChannel, int channelCount) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        for (int c = firstChannel; c < firstChannel + channelCount; ++c) {
+            const double diff = static_cast<double>(a[i + c]) - b[i + c];
+            sum += diff * diff;
+            count++;
+        }
+    }
+    const double mse = sum / static_cast<double>(count);
+    return mse <= 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+static double RoundTripPSNR(TextureFormat format, const std::vector<uint8_t>& image,
+                            int width, int height, int firstChannel, int channelCount) {
+    std::vector<uint8_t> encoded(TextureCompressor::GetLevelSize(format, width, height));
+    std::vector<uint8_t> decoded(image.size());
+    if (!TextureCompressor::EncodeLevel(format, image.data(), width, height, encoded.data()) ||
+        !TextureCompressor::DecodeLevel(format, encoded.data(), width, height, decoded.data())) {
+        return 0.0;
+    }
+    return ComputePSNR(image, decoded, firstChannel, channelCount);
+}
+
+// ============================================================================
+// TextureCompressor 测试
+// ============================================================================
+
+static bool Test_LevelSizes() {
+    TEST_ASSERT(TextureCompressor::GetLevelSize(TextureFormat::BC1, 64, 64) == 16 * 16 * 8, "BC1 64x64 应为 2048 字节");
+    TEST_ASSERT(TextureCompressor::GetLevelSize(TextureFormat::BC7, 64, 64) == 16 * 16 * 16, "BC7 64x64 应为 4096 字节");
+    TEST_ASSERT(TextureCompressor::GetLevelSize(TextureFormat::BC4, 5, 3) == 2 * 1 * 8, "非 4 倍数尺寸应向上取整到块");
+    TEST_ASSERT(TextureCompressor::GetLevelSize(TextureFormat::BC5, 1, 1) == 16, "1x1 仍占一个块");
+    TEST_ASSERT(TextureCompressor::GetLevelSize(TextureFormat::RGBA, 4, 4) == 64, "RGBA 按像素计算");
+    TEST_ASSERT(!TextureCompressor::IsBlockCompressed(TextureFormat::RGBA), "RGBA 不是块压缩格式");
+    
+    TEST_ASSERT(TextureCompressor::GetMipLevelCount(1, 1) == 1, "1x1 只有一个级别");
+    TEST_ASSERT(TextureCompressor::GetMipLevelCount(256, 64) == 9, "256x64 应有 9 个级别");
+    TEST_ASSERT(TextureCompressor::GetMipLevelCount(37, 21) == 6, "37x21 应有 6 个级别");
+    return true;
+}
+
+static bool Test_MipChain() {
+    const int width = 37;
+    const int height = 21;
+    auto image = MakeTestImage(width, height, true);
+    
+    std::vector<uint8_t> pixels;
+    std::vector<TextureMipLevel> levels;
+    TextureCompressor::GenerateMipChain(image.data(), width, height, pixels, levels);
+    
+    TEST_ASSERT(levels.size() == 6, "mip 链级别数错误");
+    TEST_ASSERT(levels.back().width == 1 && levels.back().height == 1, "最后一级应为 1x1");
+    TEST_ASSERT(levels[1].width == 18 && levels[1].height == 10, "第 1 级尺寸应向下取整");
+    TEST_ASSERT(std::memcmp(pixels.data(), image.data(), image.size()) == 0, "基础级别应保持原样");
+    TEST_ASSERT(levels.back().offset + levels.back().size == pixels.size(), "级别应紧密排列");
+    
+    // 纯色图像的所有级别应保持同一颜色
+    std::vector<uint8_t> solid(16 * 16 * 4);
+    for (size_t i = 0; i < solid.size(); i += 4) {
+        solid[i] = 10; solid[i + 1] = 20; solid[i + 2] = 30; solid[i + 3] = 40;
+    }
+    TextureCompressor::GenerateMipChain(solid.data(), 16, 16, pixels, levels);
+    const uint8_t* last = pixels.data() + levels.back().offset;
+    TEST_ASSERT(last[0] == 10 && last[1] == 20 && last[2] == 30 && last[3] == 40, "纯色 mip 颜色应不变");
+    return true;
+}
+
+static bool Test_EncodeQuality() {
+    const int width = 64;
+    const int height = 48;
+    auto opaque = MakeTestImage(width, height, false);
+    auto translucent = MakeTestImage(width, height, true);
+    
+    const double bc1 = RoundTripPSNR(TextureFormat::BC1, opaque, width, height, 0, 3);
+    const double bc3 = RoundTripPSNR(TextureFormat::BC3, translucent, width, height, 0, 4);
+    const double bc4 = RoundTripPSNR(TextureFormat::BC4, opaque, width, height, 0, 1);
+    const double bc5 = RoundTripPSNR(TextureFormat::BC5, opaque, width, height, 0, 2);
+    const double bc7 = RoundTripPSNR(TextureFormat::BC7, translucent, width, height, 0, 4);
+    std::printf("  PSNR: BC1 %.2f dB, BC3 %.2f dB, BC4 %.2f dB, BC5 %.2f dB, BC7 %.2f dB\n",
+                bc1, bc3, bc4, bc5, bc7);
+    
+    TEST_ASSERT(bc1 > 32.0, "BC1 质量过低");
+    TEST_ASSERT(bc3 > 32.0, "BC3 质量过低");
+    TEST_ASSERT(bc4 > 40.0, "BC4 质量过低");
+    TEST_ASSERT(bc5 > 40.0, "BC5 质量过低");
+    TEST_ASSERT(bc7 > 38.0, "BC7 质量过低");
+    TEST_ASSERT(bc7 > bc1, "BC7 应优于 BC1");
+    
+    // 非 4 倍数尺寸：边缘块只写回图像范围内的像素
+    auto odd = MakeTestImage(37, 21, true);
+    TEST_ASSERT(RoundTripPSNR(TextureFormat::BC7, odd, 37, 21, 0, 4) > 34.0, "非 4 倍数尺寸的 BC7 质量过低");
+    
+    // 纯色块应无损（BC7 端点 7 位 + P 位可精确表示任意 8 位值）
+    std::vector<uint8_t> solid(8 * 8 * 4);
+    for (size_t i = 0; i < solid.size(); i += 4) {
+        solid[i] = 123; solid[i + 1] = 45; solid[i + 2] = 67; solid[i + 3] = 89;
+    }
+    TEST_ASSERT(RoundTripPSNR(TextureFormat::BC7, solid, 8, 8, 0, 4) >= 99.0, "纯色 BC7 应无损");
+    return true;
+}
+
+static bool Test_RejectUnsupportedInput() {
+    std::vector<uint8_t> image(16 * 4, 255);
+    std::vector<uint8_t> out(64);
+    TEST_ASSERT(!TextureCompressor::EncodeLevel(TextureFormat::RGBA, image.data(), 4, 4, out.data()), "非压缩格式应拒绝编码");
+    
+    // 非 mode 6 的 BC7 块（mode 0）解码失败并输出品红色
+    uint8_t block[16] = {0x01};
+    std::vector<uint8_t> decoded(16 * 4);
+    TEST_ASSERT(!TextureCompressor::DecodeLevel(TextureFormat::BC7, block, 4, 4, decoded.data()), "不支持的 BC7 模式应返回 false");
+    TEST_ASSERT(decoded[0] == 255 && decoded[1] == 0 && decoded[2] == 255, "不支持的 BC7 块应输出品红色");
+    
+    std::vector<uint8_t> data;
+    std::vector<TextureMipLevel> levels;
+    TEST_ASSERT(!TextureCompressor::Compress(image.data(), 0, 4, TextureFormat::BC1, true, data, levels), "无效尺寸应失败");
+    return true;
+}
+
+static bool Test_FormatSelection() {
+    auto opaque = MakeTestImage(16, 16, false);
+    auto translucent = MakeTestImage(16, 16, true);
+    
+    TextureCompressionOptions options;
+    options.format = TextureFormat::BC7;
+    TEST_ASSERT(TextureCompressor::SelectFormat(options, opaque.data(), 16, 16) == TextureFormat::BC1, "不透明图像应降级为 BC1");
+    TEST_ASSERT(TextureCompressor::SelectFormat(options, translucent.data(), 16, 16) == TextureFormat::BC7, "半透明图像应保持 BC7");
+    
+    options.autoSelectFormat = false;
+    TEST_ASSERT(TextureCompressor::SelectFormat(options, opaque.data(), 16, 16) == TextureFormat::BC7, "关闭自动选择时应保持目标格式");
+    
+    options.autoSelectFormat = true;
+    options.format = TextureFormat::BC5;
+    TEST_ASSERT(TextureCompressor::SelectFormat(options, opaque.data(), 16, 16) == TextureFormat::BC5, "BC5 不应被自动替换");
+    return true;
+}
+
+static bool Test_CompressWithMips() {
+    const int width = 64;
+    const int height = 32;
+    auto image = MakeTestImage(width, height, true);
+    
+    std::vector<uint8_t> data;
+    std::vector<TextureMipLevel> levels;
+    TEST_ASSERT(TextureCompressor::Compress(image.data(), width, height, TextureFormat::BC3, true, data, levels), "压缩应成功");
+    TEST_ASSERT(levels.size() == 7, "64x32 应有 7 个级别");
+    
+    size_t expected = 0;
+    for (const auto& level : levels) {
+        TEST_ASSERT(level.offset == expected, "级别偏移应连续");
+        TEST_ASSERT(level.size == TextureCompressor::GetLevelSize(TextureFormat::BC3, level.width, level.height), "级别大小错误");
+        expected += level.size;
+    }
+    TEST_ASSERT(data.size() == expected, "数据总大小错误");
+    // BC3 为 1 字节/像素：mip 链总大小应远小于 RGBA8 基础级别
+    TEST_ASSERT(data.size() < static_cast<size_t>(width) * height * 4 / 2, "压缩后应小于 RGBA8 的一半");
+    
+    TEST_ASSERT(TextureCompressor::Compress(image.data(), width, height, TextureFormat::BC1, false, data, levels), "无 mip 压缩应成功");
+    TEST_ASSERT(levels.size() == 1 && data.size() == 16 * 8 * 8, "无 mip 时只编码基础级别");
+    return true;
+}
+
+// ============================================================================
+// TextureCache 测试
+// ============================================================================
+
+static bool Test_CacheKeys() {
+    TextureCompressionOptions options;
+    const uint64_t base = TextureCache::BuildKey(1234, options, true);
+    TEST_ASSERT(base == TextureCache::BuildKey(1234, options, true), "相同输入应得到相同键");
+    TEST_ASSERT(base != TextureCache::BuildKey(1235, options, true), "源哈希不同应得到不同键");
+    TEST_ASSERT(base != TextureCache::BuildKey(1234, options, false), "mip 选项不同应得到不同键");
+    
+    TextureCompressionOptions other = options;
+    other.format = TextureFormat::BC3;
+    TEST_ASSERT(base != TextureCache::BuildKey(1234, other, true), "格式不同应得到不同键");
+    
+    other = options;
+    other.useDiskCache = false;
+    other.enabled = true;
+    TEST_ASSERT(base == TextureCache::BuildKey(1234, other, true), "enabled/useDiskCache 不应影响键");
+    return true;
+}
+
+static bool Test_CacheRoundTrip() {
+    auto& cache = TextureCache::GetInstance();
+    const std::string directory = (std::filesystem::temp_directory_path() / "render_texture_cache_test").string();
+    cache.SetCacheDirectory(directory);
+    cache.ClearDiskCache();
+    cache.ResetStats();
+    
+    auto image = MakeTestImage(40, 24, true);
+    std::vector<uint8_t> data;
+    std::vector<TextureMipLevel> levels;
+    TEST_ASSERT(TextureCompressor::Compress(image.data(), 40, 24, TextureFormat::BC7, true, data, levels), "压缩应成功");
+    
+    const uint64_t key = 0x1234abcdull;
+    TextureFormat format = TextureFormat::RGBA;
+    std::vector<uint8_t> loadedData;
+    std::vector<TextureMipLevel> loadedLevels;
+    TEST_ASSERT(!cache.Load(key, format, loadedData, loadedLevels), "写入前应未命中");
+    TEST_ASSERT(cache.Store(key, TextureFormat::BC7, data, levels), "写入应成功");
+    TEST_ASSERT(cache.Load(key, format, loadedData, loadedLevels), "写入后应命中");
+    
+    TEST_ASSERT(format == TextureFormat::BC7, "格式应一致");
+    TEST_ASSERT(loadedData == data, "数据应一致");
+    TEST_ASSERT(loadedLevels.size() == levels.size(), "级别数应一致");
+    for (size_t i = 0; i < levels.size(); ++i) {
+        TEST_ASSERT(loadedLevels[i].width == levels[i].width && loadedLevels[i].height == levels[i].height &&
+                    loadedLevels[i].offset == levels[i].offset && loadedLevels[i].size == levels[i].size,
+                    "级别描述应一致");
+    }
+    
+    const auto stats = cache.GetStats();
+    TEST_ASSERT(stats.hits == 1 && stats.misses == 1 && stats.writes == 1, "统计应正确");
+    return true;
+}
+
+static bool Test_CacheRejectCorrupted() {
+    auto& cache = TextureCache::GetInstance();
+    
+    auto image = MakeTestImage(16, 16, false);
+    std::vector<uint8_t> data;
+    std::vector<TextureMipLevel> levels;
+    TEST_ASSERT(TextureCompressor::Compress(image.data(), 16, 16, TextureFormat::BC1, true, data, levels), "压缩应成功");
+    
+    const uint64_t key = 0x5678ull;
+    TEST_ASSERT(cache.Store(key, TextureFormat::BC1, data, levels), "写入应成功");
+    const std::string path = cache.GetCachePath(key);
+    const auto fullSize = std::filesystem::file_size(path);
+    
+    TextureFormat format = TextureFormat::RGBA;
+    std::vector<uint8_t> loadedData;
+    std::vector<TextureMipLevel> loadedLevels;
+    
+    // 截断数据区
+    std::filesystem::resize_file(path, fullSize - 4);
+    TEST_ASSERT(!cache.Load(key, format, loadedData, loadedLevels), "截断文件应被拒绝");
+    
+    // 损坏魔数
+    TEST_ASSERT(cache.Store(key, TextureFormat::BC1, data, levels), "重新写入应成功");
+    {
+        std::FILE* file = std::fopen(path.c_str(), "r+b");
+        TEST_ASSERT(file != nullptr, "应能打开缓存文件");
+        std::fputc('X', file);
+        std::fclose(file);
+    }
+    TEST_ASSERT(!cache.Load(key, format, loadedData, loadedLevels), "魔数错误应被拒绝");
+    
+    // 文件头中的键与请求不一致
+    TEST_ASSERT(cache.Store(key, TextureFormat::BC1, data, levels), "重新写入应成功");
+    const uint64_t otherKey = key + 1;
+    std::filesystem::copy_file(path, cache.GetCachePath(otherKey), std::filesystem::copy_options::overwrite_existing);
+    TEST_ASSERT(!cache.Load(otherKey, format, loadedData, loadedLevels), "文件头中的键不匹配应被拒绝");
+    
+    TEST_ASSERT(!cache.Store(key, TextureFormat::RGBA, data, levels), "非压缩格式不应写入");
+    
+    cache.SetEnabled(false);
+    TEST_ASSERT(!cache.Load(key, format, loadedData, loadedLevels), "禁用时应总是未命中");
+    cache.SetEnabled(true);
+    
+    TEST_ASSERT(cache.ClearDiskCache() >= 2, "应删除缓存文件");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "纹理块压缩测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_LevelSizes);
+    RUN_TEST(Test_MipChain);
+    RUN_TEST(Test_EncodeQuality);
+    RUN_TEST(Test_RejectUnsupportedInput);
+    RUN_TEST(Test_FormatSelection);
+    RUN_TEST(Test_CompressWithMips);
+    RUN_TEST(Test_CacheKeys);
+    RUN_TEST(Test_CacheRoundTrip);
+    RUN_TEST(Test_CacheRejectCorrupted);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
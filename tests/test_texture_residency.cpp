@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_texture_residency.cpp
+ * @brief 纹理 mip 驻留决策测试
+ *
+ * 验证 TextureResidencyManager 的级别计算、初始低精度驻留、上传限制下的分帧提升、
+ * 预算约束下的均匀降级、延迟降级（防抖动）以及相机飞行模拟中的预算保持（纯 CPU，无需 GL 上下文）
+ */
+
+#include "render/texture_residency.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/// 构造 size x size 的 RGBA8 完整 mip 链描述
+static std::vector<TextureMipLevel> MakeLevels(int size) {
+    std::vector<TextureMipLevel> levels;
+    size_t offset = 0;
+    for (int s = size; ; s = std::max(s / 2, 1)) {
+        TextureMipLevel level;
+        level.width = s;
+        level.height = s;
+        level.offset = offset;
+        level.size = static_cast<size_t>(s) * s * 4;
+        offset += level.size;
+        levels.push_back(level);
+        if (s == 1) {
+            break;
+        }
+    }
+    return levels;
+}
+
+static size_t CountChanges(const std::vector<TextureResidencyChange>& changes, bool promotions) {
+    return static_cast<size_t>(std::count_if(changes.begin(), changes.end(), [promotions](const auto& change) {
+        return (change.toMip < change.fromMip) == promotions;
+    }));
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_ComputeDesiredMip() {
+    TEST_ASSERT(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 1024.0f) == 0, "纹素与像素 1:1 应为级别 0");
+    TEST_ASSERT(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 2048.0f) == 0, "放大时应为级别 0");
+    TEST_ASSERT(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 256.0f) == 2, "覆盖 256 像素应为级别 2");
+    TEST_ASSERT(TextureResidencyManager::ComputeDesiredMip(1024, 512, 300.0f) == 1, "应向更精细的级别取整");
+    TEST_ASSERT(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 0.5f) == 10, "应限制在最粗级别");
+    TEST_ASSERT(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 0.0f) == 10, "不可见时应为最粗级别");
+    TEST_ASSERT(TextureResidencyManager::ComputeDesiredMip(1024, 1024, 1024.0f, 1.0f) == 1, "正偏移应偏向更粗级别");
+    return true;
+}
+
+bool Test_InitialFloorResidency() {
+    TextureResidencyManager manager;
+    const auto levels = MakeLevels(1024);
+    const TextureResidencyHandle handle = manager.Register(levels);
+    
+    TEST_ASSERT(handle != kInvalidResidencyHandle, "注册应成功");
+    TEST_ASSERT(manager.GetFloorMip(handle) == 4, "64x64 级别应为始终驻留级别");
+    TEST_ASSERT(manager.GetResidentMip(handle) == 4, "初始只驻留低精度级别");
+    TEST_ASSERT(manager.GetResidentBytes() == manager.GetChainBytes(handle, 4), "驻留字节数应为低精度级别之和");
+    TEST_ASSERT(manager.GetChainBytes(handle, 0) > manager.GetChainBytes(handle, 1) * 3, "完整链约为次级链的 4 倍");
+    
+    const TextureResidencyHandle small = manager.Register(MakeLevels(32));
+    TEST_ASSERT(manager.GetFloorMip(small) == 0, "小纹理应完整驻留");
+    TEST_ASSERT(manager.Register({}) == kInvalidResidencyHandle, "空 mip 链应注册失败");
+    
+    manager.Update(1);
+    TEST_ASSERT(manager.GetStats().promotions == 0, "无请求时不应提升");
+    TEST_ASSERT(manager.GetResidentMip(handle) == 4, "无请求时保持低精度级别");
+    return true;
+}
+
+bool Test_PromotionThrottling() {
+    TextureResidencyOptions options;
+    options.uploadBytesPerUpdate = 6 * 1024 * 1024;   // 1024^2 RGBA 从 64 提升到 0 级约 5.3MB
+    TextureResidencyManager manager(options);
+    
+    std::vector<TextureResidencyHandle> handles;
+    for (int i = 0; i < 3; ++i) {
+        handles.push_back(manager.Register(MakeLevels(1024)));
+    }
+    
+    for (TextureResidencyHandle handle : handles) {
+        manager.Request(handle, 0);
+    }
+    const auto& changes = manager.Update(1);
+    TEST_ASSERT(CountChanges(changes, true) == 1, "上传限制下每帧只应提升一个纹理");
+    TEST_ASSERT(changes[0].uploadBytes == manager.GetChainBytes(changes[0].handle, 0) -
+                                          manager.GetChainBytes(changes[0].handle, changes[0].fromMip),
+                "上传字节应只包含新增级别");
+    TEST_ASSERT(manager.GetStats().deferredPromotions == 2, "其余提升应推迟");
+    
+    for (uint64_t frame = 2; frame <= 3; ++frame) {
+        for (TextureResidencyHandle handle : handles) {
+            manager.Request(handle, 0);
+        }
+        manager.Update(frame);
+    }
+    for (TextureResidencyHandle handle : handles) {
+        TEST_ASSERT(manager.GetResidentMip(handle) == 0, "三帧后所有纹理应完整驻留");
+    }
+    TEST_ASSERT(manager.GetResidentBytes() == manager.GetChainBytes(handles[0], 0) * 3, "驻留字节数应累计");
+    
+    // 单个纹理超过上传限制时仍应提升（每帧至少处理一个）
+    TextureResidencyOptions tiny = options;
+    tiny.uploadBytesPerUpdate = 1024;
+    TextureResidencyManager throttled(tiny);
+    const TextureResidencyHandle big = throttled.Register(MakeLevels(512));
+    throttled.Request(big, 0);
+    throttled.Update(1);
+    TEST_ASSERT(throttled.GetResidentMip(big) == 0, "超过上传限制的单个纹理也应提升");
+    return true;
+}
+
+bool Test_BudgetDistribution() {
+    TextureResidencyOptions options;
+    options.uploadBytesPerUpdate = 1ull << 40;
+    TextureResidencyManager manager(options);
+    
+    const TextureResidencyHandle a = manager.Register(MakeLevels(1024));
+    const TextureResidencyHandle b = manager.Register(MakeLevels(1024));
+    const size_t floorBytes = manager.GetChainBytes(a, manager.GetFloorMip(a));
+    
+    // 预算只够一个完整链：两个纹理应各自降一级，而不是一个完整、一个最低
+    TextureResidencyOptions budgeted = options;
+    budgeted.budgetBytes = manager.GetChainBytes(a, 0) - floorBytes;
+    manager.SetOptions(budgeted);
+    manager.Request(a, 0);
+    manager.Request(b, 0);
+    manager.Update(1);
+    TEST_ASSERT(manager.GetResidentMip(a) == 1 && manager.GetResidentMip(b) == 1, "两个纹理应均匀降级");
+    TEST_ASSERT(manager.GetStats().budgetLimited == 2, "两个纹理都应受预算限制");
+    TEST_ASSERT(manager.GetResidentBytes() - 2 * floorBytes <= budgeted.budgetBytes, "驻留字节数不应超过预算");
+    
+    // 只请求 a：b 在延迟期内仍想保持级别 0，但未被请求的纹理应优先降级
+    manager.Request(a, 0);
+    manager.Update(2);
+    TEST_ASSERT(manager.GetResidentMip(a) == 0, "本帧请求的纹理应优先获得预算");
+    TEST_ASSERT(manager.GetResidentMip(b) > 1, "未请求的纹理应被降级");
+    TEST_ASSERT(manager.GetResidentBytes() - 2 * floorBytes <= budgeted.budgetBytes, "驻留字节数不应超过预算");
+    return true;
+}
+
+bool Test_EvictionHysteresis() {
+    TextureResidencyOptions options;
+    options.evictionDelayFrames = 10;
+    TextureResidencyManager manager(options);
+    const TextureResidencyHandle handle = manager.Register(MakeLevels(512));
+    
+    manager.Request(handle, 0);
+    manager.Update(1);
+    TEST_ASSERT(manager.GetResidentMip(handle) == 0, "请求后应提升到级别 0");
+    
+    // 请求在 0/2 之间抖动：延迟期内保持级别 0，不应产生上传
+    size_t changes = 0;
+    for (uint64_t frame = 2; frame <= 29; ++frame) {
+        manager.Request(handle, frame % 2 == 0 ? 2 : 0);
+        changes += manager.Update(frame).size();
+    }
+    TEST_ASSERT(changes == 0, "级别边界抖动不应导致反复上传");
+    
+    // 持续请求更粗级别：最后一次请求级别 0 在第 29 帧，延迟期（10 帧）后降级
+    uint64_t frame = 30;
+    for (; frame <= 39; ++frame) {
+        manager.Request(handle, 2);
+        manager.Update(frame);
+        TEST_ASSERT(manager.GetResidentMip(handle) == 0, "延迟期内不应降级");
+    }
+    manager.Request(handle, 2);
+    manager.Update(frame++);
+    TEST_ASSERT(manager.GetResidentMip(handle) == 2, "延迟期后应降级到请求级别");
+    
+    // 不再请求：延迟期后回到始终驻留级别
+    for (uint64_t end = frame + 12; frame <= end; ++frame) {
+        manager.Update(frame);
+    }
+    TEST_ASSERT(manager.GetResidentMip(handle) == manager.GetFloorMip(handle), "长期未请求应回到低精度级别");
+    TEST_ASSERT(manager.GetResidentBytes() == manager.GetChainBytes(handle, manager.GetFloorMip(handle)),
+                "降级后驻留字节数应减少");
+    return true;
+}
+
+bool Test_UnregisterReleasesBytes() {
+    TextureResidencyManager manager;
+    const TextureResidencyHandle a = manager.Register(MakeLevels(256));
+    const TextureResidencyHandle b = manager.Register(MakeLevels(128));
+    manager.Request(a, 0);
+    manager.Update(1);
+    
+    const size_t bBytes = manager.GetChainBytes(b, manager.GetFloorMip(b));
+    manager.Unregister(a);
+    TEST_ASSERT(manager.GetResidentBytes() == bBytes, "注销后应释放驻留字节");
+    TEST_ASSERT(manager.GetResidentMip(a) == -1, "注销后句柄应无效");
+    TEST_ASSERT(manager.GetStats().textureCount == 1, "纹理计数应减少");
+    
+    const TextureResidencyHandle c = manager.Register(MakeLevels(64));
+    TEST_ASSERT(c == a, "句柄应被复用");
+    manager.Request(a, 0);   // 复用的句柄从新纹理的初始状态开始
+    manager.Update(2);
+    TEST_ASSERT(manager.GetResidentMip(c) == 0, "复用句柄的新纹理应正常工作");
+    return true;
+}
+
+bool Test_FlythroughSimulation() {
+    // 64 个纹理排成一行，相机沿行飞过；每帧按距离计算屏幕覆盖并请求级别
+    TextureResidencyOptions options;
+    options.budgetBytes = 24ull * 1024 * 1024;
+    options.uploadBytesPerUpdate = 8ull * 1024 * 1024;
+    options.evictionDelayFrames = 30;
+    TextureResidencyManager manager(options);
+    
+    constexpr int kTextureCount = 64;
+    constexpr float kSpacing = 10.0f;
+    constexpr float kViewportHeight = 1080.0f;
+    const float tanHalfFov = std::tan(30.0f * 3.14159265f / 180.0f);
+    
+    std::vector<TextureResidencyHandle> handles;
+    size_t floorBytes = 0;
+    for (int i = 0; i < kTextureCount; ++i) {
+        const TextureResidencyHandle handle = manager.Register(MakeLevels(i % 4 == 0 ? 2048 : 1024));
+        floorBytes += manager.GetChainBytes(handle, manager.GetFloorMip(handle));
+        handles.push_back(handle);
+    }
+    
+    size_t maxResident = 0;
+    size_t totalUploaded = 0;
+    for (uint64_t frame = 1; frame <= 600; ++frame) {
+        const float cameraX = static_cast<float>(frame) * (kTextureCount * kSpacing / 600.0f);
+        for (int i = 0; i < kTextureCount; ++i) {
+            const float distance = std::max(std::abs(i * kSpacing - cameraX), 1.0f);
+            if (distance > 150.0f) {
+                continue;   // 远处视为不可见，不请求
+            }
+            const float screenPixels = 2.0f * kViewportHeight / (distance * tanHalfFov);
+            const int size = i % 4 == 0 ? 2048 : 1024;
+            manager.Request(handles[i], TextureResidencyManager::ComputeDesiredMip(size, size, screenPixels));
+        }
+        size_t frameUploaded = 0;
+        for (const auto& change : manager.Update(frame)) {
+            frameUploaded += change.uploadBytes;
+        }
+        totalUploaded += frameUploaded;
+        TEST_ASSERT(frameUploaded <= options.uploadBytesPerUpdate || manager.GetStats().promotions == 1,
+                    "每帧上传量不应超过限制（单个纹理除外）");
+        maxResident = std::max(maxResident, manager.GetResidentBytes());
+        TEST_ASSERT(manager.GetResidentBytes() <= floorBytes + options.budgetBytes, "驻留字节数不应超过预算");
+        
+        // 相机附近的纹理在稳定后应获得精细级别
+        if (frame % 100 == 0) {
+            const int nearest = std::clamp(static_cast<int>(std::round(cameraX / kSpacing)), 0, kTextureCount - 1);
+            TEST_ASSERT(manager.GetResidentMip(handles[nearest]) <= 2, "相机附近的纹理应驻留精细级别");
+        }
+    }
+    
+    std::cout << "   峰值驻留 " << maxResident / 1024 << " KB（低精度 " << floorBytes / 1024
+              << " KB + 预算 " << options.budgetBytes / 1024 << " KB），累计上传 "
+              << totalUploaded / 1024 << " KB" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "纹理 mip 驻留决策测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_ComputeDesiredMip);
+    RUN_TEST(Test_InitialFloorResidency);
+    RUN_TEST(Test_PromotionThrottling);
+    RUN_TEST(Test_BudgetDistribution);
+    RUN_TEST(Test_EvictionHysteresis);
+    RUN_TEST(Test_UnregisterReleasesBytes);
+    RUN_TEST(Test_FlythroughSimulation);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
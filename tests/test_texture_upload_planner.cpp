@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ * 
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_texture_upload_planner.cpp
+ * @brief 纹理分帧上传计划测试
+ *
+ * 验证 TextureUploadPlanner 的行切分（非压缩与块压缩格式）、每帧字节预算、
+ * 超预算切片的推进保证、多任务顺序与取消，以及 4K 纹理分帧上传模拟（纯 CPU，无需 GL 上下文）
+ */
+
+#include "render/texture_upload_planner.h"
+#include "render/texture_compression.h"
+#include <algorithm>
+#include <iostream>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+/// 构造 width x height 的完整 mip 链描述（按格式计算各级别大小）
+static std::vector<TextureMipLevel> MakeLevels(int width, int height, TextureFormat format) {
+    std::vector<TextureMipLevel> levels;
+    size_t offset = 0;
+    for (int w = width, h = height; ; w = std::max(w / 2, 1), h = std::max(h / 2, 1)) {
+        TextureMipLevel level;
+        level.width = w;
+        level.height = h;
+        level.offset = offset;
+        level.size = TextureCompressor::GetLevelSize(format, w, h);
+        offset += level.size;
+        levels.push_back(level);
+        if (w == 1 && h == 1) {
+            break;
+        }
+    }
+    return levels;
+}
+
+/// 切片是否连续覆盖每个级别的全部数据
+static bool CoversLevels(const std::vector<TextureUploadSlice>& slices,
+                         const std::vector<TextureMipLevel>& levels) {
+    size_t index = 0;
+    for (size_t level = 0; level < levels.size(); ++level) {
+        size_t offset = levels[level].offset;
+        int y = 0;
+        while (index < slices.size() && slices[index].level == static_cast<int>(level)) {
+            const TextureUploadSlice& slice = slices[index++];
+            if (slice.offset != offset || slice.y != y || slice.width != levels[level].width) {
+                return false;
+            }
+            offset += slice.size;
+            y += slice.height;
+        }
+        if (offset != levels[level].offset + levels[level].size || y != levels[level].height) {
+            return false;
+        }
+    }
+    return index == slices.size();
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_RowPitch() {
+    TEST_ASSERT(TextureUploadPlanner::GetRowGranularity(TextureFormat::RGBA) == 1, "非压缩格式按像素行切分");
+    TEST_ASSERT(TextureUploadPlanner::GetRowGranularity(TextureFormat::BC1) == 4, "块压缩格式按块行切分");
+    TEST_ASSERT(TextureUploadPlanner::GetRowPitch(TextureFormat::RGBA, 100) == 400, "RGBA 行字节数");
+    TEST_ASSERT(TextureUploadPlanner::GetRowPitch(TextureFormat::RGB, 100) == 300, "RGB 行字节数");
+    TEST_ASSERT(TextureUploadPlanner::GetRowPitch(TextureFormat::BC1, 100) == 25 * 8, "BC1 块行字节数");
+    TEST_ASSERT(TextureUploadPlanner::GetRowPitch(TextureFormat::BC7, 6) == 2 * 16, "宽度应向上取整到块");
+    return true;
+}
+
+bool Test_SliceUncompressed() {
+    const auto levels = MakeLevels(1024, 512, TextureFormat::RGBA);
+    const size_t maxSlice = 256 * 1024;   // 64 行 RGBA
+    const auto slices = TextureUploadPlanner::BuildSlices(levels, TextureFormat::RGBA, maxSlice);
+    
+    TEST_ASSERT(CoversLevels(slices, levels), "切片应连续覆盖所有级别");
+    TEST_ASSERT(slices[0].height == 64 && slices[0].size == maxSlice, "基础级别应按 64 行切分");
+    TEST_ASSERT(std::count_if(slices.begin(), slices.end(), [](const auto& s) { return s.level == 0; }) == 8,
+                "512 行应切为 8 片");
+    for (const TextureUploadSlice& slice : slices) {
+        TEST_ASSERT(slice.size <= maxSlice, "切片不应超过上限");
+    }
+    
+    // 单行超过上限时每片一行
+    const auto wide = TextureUploadPlanner::BuildSlices(MakeLevels(4096, 4, TextureFormat::RGBA),
+                                                        TextureFormat::RGBA, 1024);
+    TEST_ASSERT(wide[0].height == 1 && wide[0].size == 4096 * 4, "单行超过上限时应保留整行");
+    TEST_ASSERT(TextureUploadPlanner::BuildSlices({}, TextureFormat::RGBA, maxSlice).empty(), "空 mip 链无切片");
+    return true;
+}
+
+bool Test_SliceBlockCompressed() {
+    // 高度不是 4 的倍数：最后一片到达级别底部
+    const auto levels = MakeLevels(256, 90, TextureFormat::BC1);
+    const size_t pitch = TextureUploadPlanner::GetRowPitch(TextureFormat::BC1, 256);
+    const auto slices = TextureUploadPlanner::BuildSlices(levels, TextureFormat::BC1, pitch * 5);
+    
+    TEST_ASSERT(CoversLevels(slices, levels), "压缩切片应连续覆盖所有级别");
+    for (const TextureUploadSlice& slice : slices) {
+        const int levelHeight = levels[slice.level].height;
+        TEST_ASSERT(slice.y % 4 == 0, "起始行应对齐到块");
+        TEST_ASSERT(slice.height % 4 == 0 || slice.y + slice.height == levelHeight,
+                    "行数应为 4 的倍数或到达级别底部");
+    }
+    TEST_ASSERT(slices[0].height == 20, "5 个块行应为 20 像素行");
+    
+    const auto& tail = slices.back();
+    TEST_ASSERT(tail.width == 1 && tail.height == 1 && tail.size == 8, "1x1 级别应为一个完整块");
+    return true;
+}
+
+bool Test_FrameBudget() {
+    const auto levels = MakeLevels(512, 512, TextureFormat::RGBA);
+    TextureUploadPlanner planner(256 * 1024);
+    planner.Enqueue(1, TextureUploadPlanner::BuildSlices(levels, TextureFormat::RGBA, 64 * 1024));
+    
+    const size_t total = planner.GetPendingBytes();
+    TEST_ASSERT(total == levels.back().offset + levels.back().size, "待上传字节应为整条链");
+    
+    size_t uploaded = 0;
+    size_t frames = 0;
+    bool sawLast = false;
+    while (planner.GetPendingJobCount() > 0) {
+        const auto& dispatches = planner.NextFrame();
+        TEST_ASSERT(!dispatches.empty(), "有待上传数据时每帧至少发出一个切片");
+        TEST_ASSERT(planner.GetStats().frameBytes <= planner.GetBytesPerFrame(), "每帧字节不应超过预算");
+        for (const TextureUploadDispatch& dispatch : dispatches) {
+            TEST_ASSERT(!sawLast, "最后一个切片之后不应再有切片");
+            sawLast = dispatch.lastSlice;
+            uploaded += dispatch.slice.size;
+        }
+        ++frames;
+    }
+    TEST_ASSERT(sawLast, "应标记最后一个切片");
+    TEST_ASSERT(uploaded == total && planner.GetPendingBytes() == 0, "所有字节应被发出");
+    TEST_ASSERT(frames == (total + 256 * 1024 - 1) / (256 * 1024), "帧数应为总字节除以预算");
+    TEST_ASSERT(planner.NextFrame().empty(), "队列为空时不发出切片");
+    return true;
+}
+
+bool Test_OversizedSliceProgress() {
+    TextureUploadPlanner planner(1024);
+    TextureMipLevel level{64, 64, 0, 64 * 64 * 4};
+    planner.Enqueue(7, TextureUploadPlanner::BuildSlices({level}, TextureFormat::RGBA, 8 * 1024));
+    
+    const auto& first = planner.NextFrame();
+    TEST_ASSERT(first.size() == 1 && first[0].slice.size == 8 * 1024, "超出预算的切片也应单独发出");
+    
+    size_t frames = 1;
+    while (planner.GetPendingJobCount() > 0) {
+        TEST_ASSERT(planner.NextFrame().size() == 1, "每帧只发出一个超预算切片");
+        ++frames;
+    }
+    TEST_ASSERT(frames == 2, "16KB 数据按 8KB 切片应在两帧完成");
+    return true;
+}
+
+bool Test_MultipleJobsAndCancel() {
+    const auto levels = MakeLevels(128, 128, TextureFormat::RGBA);   // 约 87KB
+    TextureUploadPlanner planner(1ull << 30);
+    planner.Enqueue(1, TextureUploadPlanner::BuildSlices(levels, TextureFormat::RGBA, 16 * 1024));
+    planner.Enqueue(2, TextureUploadPlanner::BuildSlices(levels, TextureFormat::RGBA, 16 * 1024));
+    planner.Enqueue(3, TextureUploadPlanner::BuildSlices(levels, TextureFormat::RGBA, 16 * 1024));
+    planner.Enqueue(4, {});
+    TEST_ASSERT(planner.GetPendingJobCount() == 3, "空切片任务应被忽略");
+    
+    const size_t perJob = planner.GetPendingBytes() / 3;
+    TEST_ASSERT(planner.Cancel(2), "应能取消排队中的任务");
+    TEST_ASSERT(!planner.IsQueued(2) && !planner.Cancel(2), "取消后不再排队");
+    TEST_ASSERT(planner.GetPendingBytes() == perJob * 2, "取消应扣除未发出的字节");
+    
+    const auto& dispatches = planner.NextFrame();
+    TEST_ASSERT(planner.GetPendingJobCount() == 0, "预算足够时一帧完成");
+    std::vector<TextureUploadJobId> order;
+    for (const TextureUploadDispatch& dispatch : dispatches) {
+        if (dispatch.lastSlice) {
+            order.push_back(dispatch.job);
+        }
+        TEST_ASSERT(dispatch.job != 2, "已取消任务不应发出切片");
+    }
+    TEST_ASSERT(order.size() == 2 && order[0] == 1 && order[1] == 3, "任务应按提交顺序完成");
+    
+    // 部分发出后取消：只扣除剩余字节
+    TextureUploadPlanner partial(32 * 1024);
+    partial.Enqueue(9, TextureUploadPlanner::BuildSlices(levels, TextureFormat::RGBA, 16 * 1024));
+    partial.NextFrame();
+    TEST_ASSERT(partial.GetPendingBytes() == perJob - 32 * 1024, "第一帧应发出 32KB");
+    TEST_ASSERT(partial.Cancel(9) && partial.GetPendingBytes() == 0, "取消后无待上传字节");
+    return true;
+}
+
+bool Test_SliceLevelRange() {
+    // 只上传 mip 链的一段（TextureStreamer 提升时只上传新驻留的级别）
+    const auto full = MakeLevels(256, 256, TextureFormat::RGBA);
+    std::vector<TextureMipLevel> range(full.begin() + 2, full.begin() + 4);
+    const size_t base = range[0].offset;
+    for (TextureMipLevel& level : range) {
+        level.offset -= base;
+    }
+    
+    const auto slices = TextureUploadPlanner::BuildSlices(range, TextureFormat::RGBA, 16 * 1024, 2);
+    TEST_ASSERT(!slices.empty(), "应生成切片");
+    TEST_ASSERT(slices.front().level == 2 && slices.back().level == 3, "切片级别应从 firstLevel 开始编号");
+    
+    size_t bytes = 0;
+    for (const TextureUploadSlice& slice : slices) {
+        bytes += slice.size;
+    }
+    TEST_ASSERT(bytes == range[1].offset + range[1].size, "切片应恰好覆盖所选级别的数据");
+    return true;
+}
+
+bool Test_4KUploadSimulation() {
+    // 4 张 4K RGBA 纹理（含 mip 链，每张约 85MB），每帧 8MB、每片 2MB
+    const auto levels = MakeLevels(4096, 4096, TextureFormat::RGBA);
+    const size_t budget = 8ull * 1024 * 1024;
+    TextureUploadPlanner planner(budget);
+    for (TextureUploadJobId job = 1; job <= 4; ++job) {
+        planner.Enqueue(job, TextureUploadPlanner::BuildSlices(levels, TextureFormat::RGBA, 2ull * 1024 * 1024));
+    }
+    
+    const size_t total = planner.GetPendingBytes();
+    size_t frames = 0;
+    size_t maxFrameBytes = 0;
+    size_t completed = 0;
+    while (planner.GetPendingJobCount() > 0) {
+        for (const TextureUploadDispatch& dispatch : planner.NextFrame()) {
+            completed += dispatch.lastSlice ? 1 : 0;
+        }
+        maxFrameBytes = std::max(maxFrameBytes, planner.GetStats().frameBytes);
+        ++frames;
+    }
+    
+    TEST_ASSERT(completed == 4, "所有纹理都应完成");
+    TEST_ASSERT(maxFrameBytes <= budget, "任何一帧都不应超过预算");
+    TEST_ASSERT(planner.GetStats().totalBytes == total, "累计字节应等于总数据量");
+    TEST_ASSERT(frames <= total / budget + 4 * levels.size(), "帧数应接近总字节除以预算");
+    
+    std::cout << "   " << total / (1024 * 1024) << " MB 分 " << frames << " 帧上传，单帧峰值 "
+              << maxFrameBytes / 1024 << " KB，共 " << planner.GetStats().totalSlices << " 个切片" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "纹理分帧上传计划测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_RowPitch);
+    RUN_TEST(Test_SliceUncompressed);
+    RUN_TEST(Test_SliceBlockCompressed);
+    RUN_TEST(Test_FrameBudget);
+    RUN_TEST(Test_OversizedSliceProgress);
+    RUN_TEST(Test_MultipleJobsAndCancel);
+    RUN_TEST(Test_SliceLevelRange);
+    RUN_TEST(Test_4KUploadSimulation);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
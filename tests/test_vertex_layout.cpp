@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_vertex_layout.cpp
+ * @brief 顶点布局与压缩编解码测试
+ *
+ * 验证各布局的步长/属性偏移、half 与八面体编码精度、压缩布局的 CPU 端编解码往返，
+ * 以及按布局统计的 GPU 内存（无需 GL 上下文，网格不上传）
+ */
+
+#include "render/mesh.h"
+#include "render/vertex_layout.h"
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Render;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+static Vector3 RandomDirection(std::mt19937& rng) {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    Vector3 v(dist(rng), dist(rng), dist(rng));
+    return v.norm() > 1e-6f ? v.normalized() : Vector3::UnitY();
+}
+
+/**
+ * @brief 生成带完整切线空间的随机顶点（两种手性各半）
+ */
+static std::vector<Vertex> MakeRandomVertices(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-25.0f, 40.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    
+    std::vector<Vertex> vertices(count);
+    for (size_t i = 0; i < count; ++i) {
+        Vertex& v = vertices[i];
+        v.position = Vector3(pos(rng), pos(rng) * 0.5f, pos(rng));
+        v.texCoord = Vector2(unit(rng) * 4.0f, unit(rng));
+        v.normal = RandomDirection(rng);
+        Vector3 t = RandomDirection(rng);
+        t = (t - v.normal * v.normal.dot(t)).normalized();
+        v.tangent = t;
+        v.bitangent = v.normal.cross(t) * ((i & 1) ? -1.0f : 1.0f);
+        v.color = Color(unit(rng), unit(rng), unit(rng), unit(rng));
+    }
+    return vertices;
+}
+
+// ============================================================================
+// 测试用例
+// ============================================================================
+
+bool Test_LayoutStrides() {
+    const VertexLayout full = VertexLayout::Full();
+    TEST_ASSERT(full.IsFull(), "默认布局应为完整布局");
+    TEST_ASSERT(full.GetStride() == sizeof(Vertex), "完整布局步长应等于 sizeof(Vertex)");
+    TEST_ASSERT(full.GetTexCoordSlot().offset == offsetof(Vertex, texCoord), "UV 偏移应与 Vertex 一致");
+    TEST_ASSERT(full.GetNormalSlot().offset == offsetof(Vertex, normal), "法线偏移应与 Vertex 一致");
+    TEST_ASSERT(full.GetColorSlot().offset == offsetof(Vertex, color), "颜色偏移应与 Vertex 一致");
+    TEST_ASSERT(full.GetTangentSlot().offset == offsetof(Vertex, tangent), "切线偏移应与 Vertex 一致");
+    TEST_ASSERT(full.GetBitangentSlot().offset == offsetof(Vertex, bitangent), "副切线偏移应与 Vertex 一致");
+    TEST_ASSERT(full.GetShaderFlags() == VertexLayoutFlag_None, "完整布局不需要着色器解码");
+    
+    const VertexLayout compact = VertexLayout::Compact();
+    const VertexLayout quantized = VertexLayout::Compact(true);
+    const VertexLayout unlit = VertexLayout::Unlit();
+    TEST_ASSERT(compact.GetStride() == 32, "紧凑布局应为 32 字节");
+    TEST_ASSERT(quantized.GetStride() == 28, "量化紧凑布局应为 28 字节");
+    TEST_ASSERT(unlit.GetStride() == 20, "无光照布局应为 20 字节");
+    TEST_ASSERT(!unlit.GetNormalSlot().enabled && !unlit.GetTangentSlot().enabled, "无光照布局不含法线/切线");
+    TEST_ASSERT(!quantized.GetBitangentSlot().enabled, "八面体切线布局不存储副切线");
+    TEST_ASSERT(quantized.GetShaderFlags() == (VertexLayoutFlag_QuantizedPosition | VertexLayoutFlag_OctNormal |
+                                               VertexLayoutFlag_OctTangent), "量化布局着色器标志");
+    
+    bool aligned = true;
+    for (const VertexLayout& layout : {compact, quantized, unlit}) {
+        for (const VertexAttributeSlot& slot : {layout.GetTexCoordSlot(), layout.GetNormalSlot(),
+                                                layout.GetColorSlot(), layout.GetTangentSlot()}) {
+            aligned = aligned && (slot.offset % 4 == 0);
+        }
+        aligned = aligned && (layout.GetStride() % 4 == 0);
+    }
+    TEST_ASSERT(aligned, "所有属性偏移与步长应 4 字节对齐");
+    return true;
+}
+
+bool Test_HalfFloat() {
+    const float exact[] = {0.0f, 1.0f, -2.0f, 0.5f, 0.25f, 1024.0f, 65504.0f, -0.0009765625f};
+    bool exactOk = true;
+    for (float value : exact) {
+        exactOk = exactOk && VertexCodec::HalfToFloat(VertexCodec::FloatToHalf(value)) == value;
+    }
+    TEST_ASSERT(exactOk, "可精确表示的值应无损往返");
+    
+    TEST_ASSERT(VertexCodec::FloatToHalf(1.0f) == 0x3C00, "1.0 的 half 编码应为 0x3C00");
+    TEST_ASSERT(std::isinf(VertexCodec::HalfToFloat(VertexCodec::FloatToHalf(1.0e6f))), "溢出应饱和为 Inf");
+    TEST_ASSERT(std::isnan(VertexCodec::HalfToFloat(VertexCodec::FloatToHalf(std::numeric_limits<float>::quiet_NaN()))),
+                "NaN 应保持为 NaN");
+    
+    const float subnormal = 3.0f * 5.9604645e-8f;  // 3 × 2^-24
+    TEST_ASSERT(VertexCodec::HalfToFloat(VertexCodec::FloatToHalf(subnormal)) == subnormal, "非规格化数应无损往返");
+    
+    // [0, 4] 范围内（典型平铺 UV）的相对误差 ≤ 2^-11
+    float maxRelError = 0.0f;
+    for (int i = 1; i <= 40000; ++i) {
+        const float value = i * 1.0e-4f;
+        const float decoded = VertexCodec::HalfToFloat(VertexCodec::FloatToHalf(value));
+        maxRelError = std::max(maxRelError, std::abs(decoded - value) / value);
+    }
+    TEST_ASSERT(maxRelError <= 1.0f / 2048.0f, "half 相对误差应不超过 2^-11");
+    return true;
+}
+
+bool Test_OctahedralEncoding() {
+    std::mt19937 rng(7);
+    float minDot = 1.0f;
+    for (int i = 0; i < 20000; ++i) {
+        const Vector3 direction = RandomDirection(rng);
+        int16_t x, y;
+        VertexCodec::OctEncode(direction, x, y);
+        minDot = std::min(minDot, VertexCodec::OctDecode(x, y).dot(direction));
+    }
+    // 16 位八面体编码误差约 0.005°，cos(0.02°) ≈ 0.99999994
+    TEST_ASSERT(minDot > 0.9999999f - 1e-6f, "八面体编码角度误差过大");
+    
+    bool axesOk = true;
+    const Vector3 axes[] = {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1),
+                            Vector3(-1, 0, 0), Vector3(0, -1, 0), Vector3(0, 0, -1)};
+    for (const Vector3& axis : axes) {
+        int16_t x, y;
+        VertexCodec::OctEncode(axis, x, y);
+        axesOk = axesOk && (VertexCodec::OctDecode(x, y) - axis).norm() < 1e-4f;
+    }
+    TEST_ASSERT(axesOk, "坐标轴方向应精确往返");
+    return true;
+}
+
+bool Test_FullLayoutMatchesVertex() {
+    const auto vertices = MakeRandomVertices(64, 3);
+    const VertexLayout layout = VertexLayout::Full();
+    std::vector<uint8_t> encoded(vertices.size() * layout.GetStride());
+    VertexCodec::Encode(vertices.data(), vertices.size(), layout, VertexQuantization(), encoded.data());
+    
+    // 逐字段比较（Vertex 内无填充，但不依赖 memcmp 整体比较）
+    bool equal = true;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex decoded = VertexCodec::Decode(encoded.data() + i * layout.GetStride(), layout, VertexQuantization());
+        equal = equal && decoded.position == vertices[i].position && decoded.texCoord == vertices[i].texCoord &&
+                decoded.normal == vertices[i].normal && decoded.tangent == vertices[i].tangent &&
+                decoded.bitangent == vertices[i].bitangent && decoded.color.a == vertices[i].color.a;
+    }
+    TEST_ASSERT(equal, "完整布局编解码应无损");
+    return true;
+}
+
+bool Test_CompactRoundTrip() {
+    const auto vertices = MakeRandomVertices(4096, 11);
+    AABB bounds(vertices[0].position, vertices[0].position);
+    for (const auto& v : vertices) {
+        bounds.min = bounds.min.cwiseMin(v.position);
+        bounds.max = bounds.max.cwiseMax(v.position);
+    }
+    const VertexQuantization quantization = VertexQuantization::FromBounds(bounds);
+    const VertexLayout layout = VertexLayout::Compact(true);
+    
+    std::vector<uint8_t> encoded(vertices.size() * layout.GetStride());
+    VertexCodec::Encode(vertices.data(), vertices.size(), layout, quantization, encoded.data());
+    
+    float maxPositionError = 0.0f;
+    float maxUVError = 0.0f;
+    float minNormalDot = 1.0f;
+    float minTangentDot = 1.0f;
+    float minBitangentDot = 1.0f;
+    float maxColorError = 0.0f;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& src = vertices[i];
+        const Vertex decoded = VertexCodec::Decode(encoded.data() + i * layout.GetStride(), layout, quantization);
+        maxPositionError = std::max(maxPositionError, (decoded.position - src.position).cwiseAbs().maxCoeff());
+        maxUVError = std::max(maxUVError, (decoded.texCoord - src.texCoord).cwiseAbs().maxCoeff());
+        minNormalDot = std::min(minNormalDot, decoded.normal.dot(src.normal));
+        minTangentDot = std::min(minTangentDot, decoded.tangent.dot(src.tangent));
+        minBitangentDot = std::min(minBitangentDot, decoded.bitangent.normalized().dot(src.bitangent));
+        maxColorError = std::max({maxColorError, std::abs(decoded.color.r - src.color.r),
+                                  std::abs(decoded.color.g - src.color.g), std::abs(decoded.color.b - src.color.b),
+                                  std::abs(decoded.color.a - src.color.a)});
+    }
+    
+    std::cout << "  pos err=" << maxPositionError << " (step " << quantization.scale / 32767.0f << ")"
+              << " uv err=" << maxUVError << " n dot=" << minNormalDot
+              << " t dot=" << minTangentDot << " b dot=" << minBitangentDot
+              << " color err=" << maxColorError << std::endl;
+    
+    TEST_ASSERT(maxPositionError <= quantization.scale / 32767.0f, "量化位置误差应不超过一个量化步长");
+    TEST_ASSERT(maxUVError <= 4.0f / 2048.0f, "half UV 误差过大");
+    TEST_ASSERT(minNormalDot > 0.99999f, "八面体法线误差过大");
+    TEST_ASSERT(minTangentDot > 0.99999f, "八面体切线误差过大");
+    TEST_ASSERT(minBitangentDot > 0.9999f, "重建副切线方向/手性错误");
+    TEST_ASSERT(maxColorError <= 0.5f / 255.0f + 1e-6f, "UNorm8 颜色误差应不超过半个量化级");
+    
+    TEST_ASSERT(quantization.Contains(bounds.max) && quantization.Contains(bounds.min), "包围盒端点应在量化范围内");
+    TEST_ASSERT(!quantization.Contains(bounds.max + Vector3(quantization.scale, 0.0f, 0.0f)), "超出范围的位置应被检出");
+    return true;
+}
+
+bool Test_MeshMemoryReport() {
+    const auto vertices = MakeRandomVertices(10000, 5);
+    std::vector<uint32_t> indices(30000);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = static_cast<uint32_t>(i % vertices.size());
+    }
+    
+    Mesh mesh(vertices, indices);
+    const size_t indexBytes = indices.size() * sizeof(uint32_t);
+    const size_t gpuIndexBytes = indices.size() * sizeof(uint16_t);   // 10000 顶点 → 16 位索引
+    const size_t fullBytes = mesh.GetGPUMemoryUsage() - gpuIndexBytes;
+    TEST_ASSERT(fullBytes == vertices.size() * sizeof(Vertex), "默认布局 GPU 顶点内存应等于 Vertex 数组大小");
+    TEST_ASSERT(mesh.GetVertexLayout().IsFull(), "网格默认使用完整布局");
+    
+    std::cout << "  顶点内存报告（10000 顶点）:" << std::endl;
+    std::cout << "    " << VertexLayout::Full().ToString() << ": " << fullBytes << " bytes" << std::endl;
+    
+    bool ratiosOk = true;
+    for (const VertexLayout& layout : {VertexLayout::Compact(), VertexLayout::Compact(true), VertexLayout::Unlit()}) {
+        mesh.SetVertexLayout(layout);
+        const size_t bytes = mesh.GetGPUMemoryUsage() - gpuIndexBytes;
+        const double ratio = static_cast<double>(fullBytes) / static_cast<double>(bytes);
+        std::cout << "    " << layout.ToString() << ": " << bytes << " bytes (" << ratio << "x)" << std::endl;
+        ratiosOk = ratiosOk && ratio >= 2.0;
+    }
+    TEST_ASSERT(ratiosOk, "压缩布局顶点内存应至少减少到 1/2");
+    TEST_ASSERT(mesh.GetVertexLayout() == VertexLayout::Unlit(), "SetVertexLayout 应记录布局");
+    TEST_ASSERT(mesh.GetMemoryUsage() == vertices.size() * sizeof(Vertex) + indexBytes, "CPU 内存统计不受布局影响");
+    return true;
+}
+
+bool Test_IndexFormatSelection() {
+    TEST_ASSERT(IndexCodec::SelectFormat(0) == IndexFormat::UInt16, "空网格选用 16 位索引");
+    TEST_ASSERT(IndexCodec::SelectFormat(65536) == IndexFormat::UInt16, "65536 顶点（最大索引 65535）仍可用 16 位");
+    TEST_ASSERT(IndexCodec::SelectFormat(65537) == IndexFormat::UInt32, "超过 65536 顶点必须使用 32 位");
+    TEST_ASSERT(IndexCodec::GetIndexSize(IndexFormat::UInt16) == 2, "16 位索引占 2 字节");
+    TEST_ASSERT(IndexCodec::GetIndexSize(IndexFormat::UInt32) == 4, "32 位索引占 4 字节");
+    
+    std::vector<uint32_t> indices(1000);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = static_cast<uint32_t>((i * 7919) % 65536);
+    }
+    indices.back() = 65535;
+    std::vector<uint16_t> packed(indices.size());
+    IndexCodec::PackUInt16(indices.data(), indices.size(), packed.data());
+    bool packedOk = true;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        packedOk = packedOk && packed[i] == indices[i];
+    }
+    TEST_ASSERT(packedOk, "16 位打包应保持索引值不变");
+    
+    Mesh small(MakeRandomVertices(100, 11), std::vector<uint32_t>{0, 1, 2});
+    TEST_ASSERT(small.GetIndexFormat() == IndexFormat::UInt16, "小网格应自动选用 16 位索引");
+    TEST_ASSERT(small.GetGLIndexType() == GL_UNSIGNED_SHORT, "16 位索引对应 GL_UNSIGNED_SHORT");
+    
+    Mesh large(MakeRandomVertices(70000, 12), std::vector<uint32_t>{0, 1, 69999});
+    TEST_ASSERT(large.GetIndexFormat() == IndexFormat::UInt32, "超过 65536 顶点的网格保持 32 位索引");
+    TEST_ASSERT(large.GetGLIndexType() == GL_UNSIGNED_INT, "32 位索引对应 GL_UNSIGNED_INT");
+    TEST_ASSERT(large.GetGPUMemoryUsage() == 70000 * sizeof(Vertex) + 3 * sizeof(uint32_t), "32 位索引按 4 字节统计");
+    return true;
+}
+
+// ============================================================================
+// 主函数
+// ============================================================================
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "顶点布局与压缩编解码测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    RUN_TEST(Test_LayoutStrides);
+    RUN_TEST(Test_HalfFloat);
+    RUN_TEST(Test_OctahedralEncoding);
+    RUN_TEST(Test_FullLayoutMatchesVertex);
+    RUN_TEST(Test_CompactRoundTrip);
+    RUN_TEST(Test_MeshMemoryReport);
+    RUN_TEST(Test_IndexFormatSelection);
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}
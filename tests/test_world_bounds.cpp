@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2025 Li Chaoyu
+ *
+ * This file is part of Render.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For commercial licensing, please contact: 2052046346@qq.com
+ */
+/**
+ * @file test_world_bounds.cpp
+ * @brief 网格包围盒缓存与 WorldBoundsComponent 测试
+ *
+ * 验证 Mesh 包围盒缓存的失效时机，以及世界空间包围体仅在变换或网格变化时重新计算（无需 GL 上下文）
+ */
+
+#include "render/mesh.h"
+#include "render/ecs/components.h"
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace Render;
+using namespace Render::ECS;
+
+// ============================================================================
+// 简单的测试框架
+// ============================================================================
+
+static int g_testCount = 0;
+static int g_passedCount = 0;
+static int g_failedCount = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        g_testCount++; \
+        if (!(condition)) { \
+            std::cerr << "❌ 测试失败: " << message << std::endl; \
+            std::cerr << "   位置: " << __FILE__ << ":" << __LINE__ << std::endl; \
+            std::cerr << "   条件: " << #condition << std::endl; \
+            g_failedCount++; \
+            return false; \
+        } \
+        g_passedCount++; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        std::cout << "运行测试: " << #test_func << "..." << std::endl; \
+        if (test_func()) { \
+            std::cout << "✓ " << #test_func << " 通过" << std::endl; \
+        } else { \
+            std::cout << "✗ " << #test_func << " 失败" << std::endl; \
+        } \
+    } while(0)
+
+// ============================================================================
+// 辅助函数
+// ============================================================================
+
+static bool NearlyEqual(const Vector3& a, const Vector3& b, float epsilon = 1e-4f) {
+    return (a - b).norm() <= epsilon;
+}
+
+static std::vector<Vertex> MakeBoxVertices(const Vector3& min, const Vector3& max) {
+    std::vector<Vertex> vertices(8);
+    for (int i = 0; i < 8; ++i) {
+        vertices[i].position = Vector3((i & 1) ? max.x() : min.x(),
+                                       (i & 2) ? max.y() : min.y(),
+                                       (i & 4) ? max.z() : min.z());
+    }
+    return vertices;
+}
+
+// ============================================================================
+// Mesh 包围盒缓存
+// ============================================================================
+
+bool Test_Mesh_BoundsCached() {
+    Mesh mesh(MakeBoxVertices(Vector3(-1, -2, -3), Vector3(1, 2, 3)), {});
+    const uint64_t version = mesh.GetBoundsVersion();
+
+    AABB first = mesh.CalculateBounds();
+    AABB second = mesh.CalculateBounds();
+    TEST_ASSERT(NearlyEqual(first.min, Vector3(-1, -2, -3)), "包围盒最小点应正确");
+    TEST_ASSERT(NearlyEqual(first.max, Vector3(1, 2, 3)), "包围盒最大点应正确");
+    TEST_ASSERT(NearlyEqual(second.min, first.min) && NearlyEqual(second.max, first.max),
+                "重复查询应返回相同的缓存结果");
+    TEST_ASSERT(mesh.GetBoundsVersion() == version, "查询包围盒不应改变版本号");
+    return true;
+}
+
+bool Test_Mesh_SetVerticesInvalidates() {
+    Mesh mesh(MakeBoxVertices(Vector3(-1, -1, -1), Vector3(1, 1, 1)), {});
+    mesh.CalculateBounds();
+    const uint64_t version = mesh.GetBoundsVersion();
+
+    mesh.SetVertices(MakeBoxVertices(Vector3(0, 0, 0), Vector3(4, 5, 6)));
+    TEST_ASSERT(mesh.GetBoundsVersion() != version, "SetVertices 应更新版本号");
+
+    AABB bounds = mesh.CalculateBounds();
+    TEST_ASSERT(NearlyEqual(bounds.max, Vector3(4, 5, 6)), "SetVertices 后应重新计算包围盒");
+
+    const uint64_t afterSet = mesh.GetBoundsVersion();
+    mesh.SetData(MakeBoxVertices(Vector3(-8, 0, 0), Vector3(0, 1, 1)), {});
+    TEST_ASSERT(mesh.GetBoundsVersion() != afterSet, "SetData 应更新版本号");
+    TEST_ASSERT(NearlyEqual(mesh.CalculateBounds().min, Vector3(-8, 0, 0)), "SetData 后应重新计算包围盒");
+    return true;
+}
+
+bool Test_Mesh_VersionsUniqueAcrossMeshes() {
+    Mesh a(MakeBoxVertices(Vector3::Zero(), Vector3::Ones()), {});
+    Mesh b(MakeBoxVertices(Vector3::Zero(), Vector3::Ones()), {});
+    TEST_ASSERT(a.GetBoundsVersion() != b.GetBoundsVersion(), "不同网格的版本号应不同");
+    return true;
+}
+
+// ============================================================================
+// WorldBoundsComponent
+// ============================================================================
+
+bool Test_WorldBounds_TranslationAndScale() {
+    auto mesh = std::make_shared<Mesh>(MakeBoxVertices(Vector3(-1, -1, -1), Vector3(1, 1, 1)),
+                                       std::vector<uint32_t>{});
+    Matrix4 world = Matrix4::Identity();
+    world(0, 0) = 2.0f;
+    world(1, 1) = 3.0f;
+    world(2, 2) = 1.0f;
+    world.block<3, 1>(0, 3) = Vector3(10, 0, -5);
+
+    WorldBoundsComponent bounds;
+    TEST_ASSERT(bounds.Refresh(mesh, world), "首次刷新应计算包围体");
+    TEST_ASSERT(bounds.valid, "非空网格的包围体应有效");
+    TEST_ASSERT(NearlyEqual(bounds.worldBounds.min, Vector3(8, -3, -6)), "世界 AABB 最小点应包含缩放与平移");
+    TEST_ASSERT(NearlyEqual(bounds.worldBounds.max, Vector3(12, 3, -4)), "世界 AABB 最大点应包含缩放与平移");
+    TEST_ASSERT(NearlyEqual(bounds.sphereCenter, Vector3(10, 0, -5)), "包围球球心应为变换后的中心");
+    TEST_ASSERT(std::abs(bounds.sphereRadius - std::sqrt(3.0f) * 3.0f) < 1e-4f, "包围球半径应乘以最大轴缩放");
+    return true;
+}
+
+bool Test_WorldBounds_Rotation() {
+    auto mesh = std::make_shared<Mesh>(MakeBoxVertices(Vector3(-2, -1, -1), Vector3(2, 1, 1)),
+                                       std::vector<uint32_t>{});
+    Matrix4 world = Matrix4::Identity();
+    world.block<3, 3>(0, 0) = Quaternion(Eigen::AngleAxisf(static_cast<float>(M_PI) * 0.5f,
+                                                           Vector3::UnitZ())).toRotationMatrix();
+
+    WorldBoundsComponent bounds;
+    bounds.Refresh(mesh, world);
+    TEST_ASSERT(NearlyEqual(bounds.worldBounds.min, Vector3(-1, -2, -1)), "旋转 90° 后 X/Y 半长应交换");
+    TEST_ASSERT(NearlyEqual(bounds.worldBounds.max, Vector3(1, 2, 1)), "旋转 90° 后 X/Y 半长应交换");
+    return true;
+}
+
+bool Test_WorldBounds_RefreshOnlyOnChange() {
+    auto mesh = std::make_shared<Mesh>(MakeBoxVertices(Vector3(-1, -1, -1), Vector3(1, 1, 1)),
+                                       std::vector<uint32_t>{});
+    Matrix4 world = Matrix4::Identity();
+
+    WorldBoundsComponent bounds;
+    TEST_ASSERT(bounds.Refresh(mesh, world), "首次刷新应计算包围体");
+    TEST_ASSERT(!bounds.Refresh(mesh, world), "变换与网格未变化时不应重新计算");
+
+    world.block<3, 1>(0, 3) = Vector3(0, 4, 0);
+    TEST_ASSERT(bounds.Refresh(mesh, world), "变换变化时应重新计算");
+    TEST_ASSERT(NearlyEqual(bounds.sphereCenter, Vector3(0, 4, 0)), "球心应跟随变换");
+
+    mesh->SetVertices(MakeBoxVertices(Vector3(0, 0, 0), Vector3(2, 2, 2)));
+    TEST_ASSERT(bounds.Refresh(mesh, world), "网格顶点变化时应重新计算");
+    TEST_ASSERT(NearlyEqual(bounds.sphereCenter, Vector3(1, 5, 1)), "球心应反映新的网格包围盒");
+
+    auto other = std::make_shared<Mesh>(MakeBoxVertices(Vector3(-1, -1, -1), Vector3(1, 1, 1)),
+                                        std::vector<uint32_t>{});
+    TEST_ASSERT(bounds.Refresh(other, world), "更换网格时应重新计算");
+    TEST_ASSERT(!bounds.Refresh(other, world), "更换后再次刷新不应重新计算");
+    return true;
+}
+
+bool Test_WorldBounds_EmptyMesh() {
+    auto mesh = std::make_shared<Mesh>();
+    WorldBoundsComponent bounds;
+    bounds.Refresh(mesh, Matrix4::Identity());
+    TEST_ASSERT(!bounds.valid, "空网格的包围体应无效");
+    TEST_ASSERT(!bounds.Refresh(mesh, Matrix4::Identity()), "空网格未变化时不应重复计算");
+    return true;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "包围盒缓存测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::cout << "\n--- Mesh 包围盒缓存 ---" << std::endl;
+    RUN_TEST(Test_Mesh_BoundsCached);
+    RUN_TEST(Test_Mesh_SetVerticesInvalidates);
+    RUN_TEST(Test_Mesh_VersionsUniqueAcrossMeshes);
+
+    std::cout << "\n--- WorldBoundsComponent 测试 ---" << std::endl;
+    RUN_TEST(Test_WorldBounds_TranslationAndScale);
+    RUN_TEST(Test_WorldBounds_Rotation);
+    RUN_TEST(Test_WorldBounds_RefreshOnlyOnChange);
+    RUN_TEST(Test_WorldBounds_EmptyMesh);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "测试完成" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "总测试数: " << g_testCount << std::endl;
+    std::cout << "通过: " << g_passedCount << " ✓" << std::endl;
+    std::cout << "失败: " << g_failedCount << " ✗" << std::endl;
+
+    if (g_failedCount == 0) {
+        std::cout << "\n🎉 所有测试通过！" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\n❌ 有测试失败！" << std::endl;
+        return 1;
+    }
+}